@@ -144,6 +144,38 @@ standard names. */
 
 /* USER CODE BEGIN Defines */   	      
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+
+/* Run time stats, stack high-water marks & context switch counters are collected
+by userCode/TaskStat/task_stat.c; the run time counter is the DWT cycle counter. */
+#define configGENERATE_RUN_TIME_STATS            1
+#define INCLUDE_xTaskGetIdleTaskHandle           1
+
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  extern void     TaskStat_TmrInit(void);
+  extern uint32_t TaskStat_TmrRd(void);
+  extern void     TaskStat_CtxSwHook(uint32_t task_nbr);
+#endif
+
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() TaskStat_TmrInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()         TaskStat_TmrRd()
+
+/* Kernel events are recorded by the event trace recorder in userCode/Trace/trace.c. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include "trace.h"
+#endif
+
+#define traceTASK_SWITCHED_IN()                  do { TaskStat_CtxSwHook((uint32_t)pxCurrentTCB->uxTCBNumber);   \
+                                                      Trace_TaskSwitchedIn((uint32_t)pxCurrentTCB->uxTCBNumber); \
+                                                 } while (0)
+#define traceTASK_CREATE(pxNewTCB)               Trace_NameAdd(TRACE_NAME_TYPE_TASK, (uint32_t)(pxNewTCB)->uxTCBNumber, (pxNewTCB)->pcTaskName)
+#define traceQUEUE_REGISTRY_ADD(xQueue, pcName)  Trace_NameAdd(TRACE_NAME_TYPE_OBJ, (uint32_t)(CPU_ADDR)(xQueue), (pcName))
+#define traceQUEUE_SEND(pxQueue)                 Trace_QEvt(TRACE_EVT_Q_SEND,        (pxQueue), (pxQueue)->ucQueueType)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)        Trace_QEvt(TRACE_EVT_Q_SEND_ISR,    (pxQueue), (pxQueue)->ucQueueType)
+#define traceQUEUE_SEND_FAILED(pxQueue)          Trace_QEvt(TRACE_EVT_Q_SEND_FAIL,   (pxQueue), (pxQueue)->ucQueueType)
+#define traceQUEUE_RECEIVE(pxQueue)              Trace_QEvt(TRACE_EVT_Q_RECV,        (pxQueue), (pxQueue)->ucQueueType)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)     Trace_QEvt(TRACE_EVT_Q_RECV_ISR,    (pxQueue), (pxQueue)->ucQueueType)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)  Trace_QEvt(TRACE_EVT_Q_RECV_BLOCK,  (pxQueue), (pxQueue)->ucQueueType)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue)       Trace_QEvt(TRACE_EVT_Q_RECV_FAIL,   (pxQueue), (pxQueue)->ucQueueType)
 /* USER CODE END Defines */ 
 
 #endif /* FREERTOS_CONFIG_H */
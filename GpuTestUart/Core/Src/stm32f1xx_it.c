@@ -27,6 +27,7 @@
 /* USER CODE BEGIN Includes */
 
 #include "app_cfg.h"
+#include "trace.h"
 
 
 /* USER CODE END Includes */
@@ -231,11 +232,11 @@ void TIM4_IRQHandler(void)
 void USART1_IRQHandler(void)
 {
   /* USER CODE BEGIN USART1_IRQn 0 */
-
+  TRACE_ISR_ENTER(USART1_IRQn);
   /* USER CODE END USART1_IRQn 0 */
   HAL_UART_IRQHandler(&huart1);
   /* USER CODE BEGIN USART1_IRQn 1 */
-
+  TRACE_ISR_EXIT(USART1_IRQn);
   /* USER CODE END USART1_IRQn 1 */
 }
 
@@ -247,11 +248,11 @@ void USART2_IRQHandler(void)
   /* USER CODE BEGIN USART2_IRQn 0 */
 
 //中断这里是调用的自己写的中断入口函数.
-
+  TRACE_ISR_ENTER(USART2_IRQn);
   /* USER CODE END USART2_IRQn 0 */
   user_UART_IRQHandler(&huart2);
   /* USER CODE BEGIN USART2_IRQn 1 */
-
+  TRACE_ISR_EXIT(USART2_IRQn);
   /* USER CODE END USART2_IRQn 1 */
 }
 
@@ -0,0 +1,249 @@
+/*
+*********************************************************************************************************
+*                                                uC/FS
+*                                      The Embedded File System
+*
+*                    Copyright 2008-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   NAND DRIVER CONFIGURATION FILE
+*
+*                                       HOST SIMULATION TARGET
+*
+* Filename : fs_dev_nand_cfg.h
+* Version  : V4.08.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                                 MODULE
+*********************************************************************************************************
+*/
+
+#ifndef  FS_NAND_CFG_H
+#define  FS_NAND_CFG_H
+
+
+/*
+*********************************************************************************************************
+*                                                INCLUDE
+*********************************************************************************************************
+*/
+
+#include <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                      NAND DRIVER CONFIGURATION
+*
+* Note(s) : (1) FS_NAND_CFG_MAX_CTRLR_IMPL determines the maximum number of registered NAND controller
+*               implementations. Each controller that will be used needs to be registered. Registering
+*               a controller implementation will invoke its 'Init()' function.
+
+*           (2) FS_NAND_CFG_AUTO_SYNC_EN determines if, for each operation on the device (i.e. each call
+*               to the device's API), the metadata should be synchronized. Synchronizing at the end of
+*               each operation is safer; it ensures the device can be remounted and appear exactly as it
+*               should. Disabling automatic synchronization will result in a large write speed increase,
+*               as the metadata won't be committed automatically, unless done in the application. If a
+*               power down occurs between a device operation and a sync operation, the device will appear
+*               as it was in a prior state when remounted. Device synchronization can be forced with a
+*               call to FSDev_Sync().
+*
+*               Note that using large write buffers will reduce the metadata synchronization performance
+*               hit as fewer calls to the device API will be needed.
+*
+*           (3) FS_NAND_CFG_UPDATE_BLK_META_CACHE_EN determines if, for each update block, the
+*               metadata will be cached. Enabling this will allow searching for a specific updated sector
+*               through data in RAM instead of accessing the device, which would require additional read
+*               page operations.
+*
+*               More RAM will be consumed if this option is enabled, but write/read speed will be improved.
+*
+*               RAM usage = (<Nbr update blks> x (log2(<Max associativity>) + log2(<Nbr secs per blk>)) /
+*                            8) octets (rounded up).
+*
+*           (4) FS_NAND_CFG_DIRTY_MAP_CACHE_EN determines if the dirty blocks map will be cached. With
+*               this feature enabled, a copy of the dirty blocks map on the device is cached. It is
+*               possible then to determine if the state "dirty" of a block is commited on the device
+*               without the need to actually read the device.
+*
+*               With this feature enabled, overall write and read speed should be improved. Also,
+*               robustness will be improved for specific cases. However, more RAM will be consumed.
+*
+*               RAM usage = (<Nbr of blks on device> / 8) octets (rounded up).
+*
+*           (5) FS_NAND_CFG_UPDATE_BLK_TBL_SUBSET_SIZE controls the size of the subsets of sectors pointed
+*               by each entry of the update block tables. The value must be a power of 2 (or 0).
+*
+*               If, for example, the value is 4, each time a specific updated sector is requested, the
+*               NAND translation layer must find the sector from a group of 4 sectors. Thus, if the cache
+*               is disabled, 4 sectors must be read from the device. Otherwise, the 4 entries will be
+*               searched from in the cache. If the value is set to 0, the table will be disabled
+*               completely, meaning that all sectors of the block might have to be be read before the
+*               specified sector is found. If the value is 1, the table completely specifies the location
+*               of the sector, and thus no search must be performed. In that case, enabling the update
+*               blocks metadata cache will yield no performance benefit.
+*
+*               RAM usage = (<Nbr update blks> x (log2(Nbr secs per blk>) - log2(<Subset size>) x
+*                            <Max associativity> / 8) octets (rounded up).
+*
+*           (6) FS_NAND_CFG_RSVD_AVAIL_BLK_CNT indicates the number of blocks in the available blocks
+*               table that are reserved for metadata block folding. Since this operation is critical
+*               and must be done before adding blocks to the available blocks table, the driver needs
+*               enough reserved blocks to make sure at least one of them is not bad so that the metadata
+*               can be folded successfully. When set to 3, probability for the metadata folding operation
+*               to fail is really low. This value should be sufficient for most applications.
+*
+*           (7) FS_NAND_CFG_MAX_RD_RETRIES indicates the maximum number of retries performed when a read
+*               operation fails. It is recommended by most manufacturers to retry reading a page if it
+*               fails, as successive read operations might be successful. This number should be at least
+*               set to 2 for smooth  operation, but might be set higher to improve reliability.
+*
+*           (8) FS_NAND_CFG_MAX_SUB_PCT indicates the maximum number of update blocks that can be
+*               sequential update blocks (SUB). This value is set as a percentage of the total number
+*               of update blocks.
+*
+*           (9) FS_NAND_CFG_BG_PROC_EN enables FS_NAND_BgProc(), which the application may call from a
+*               low-priority (idle) task to perform ahead of time the merge or erase that the next write
+*               would otherwise have to perform before completing. Blocks are never merged or erased
+*               earlier than that, so background processing does not add wear.
+*               Each call performs one short step & releases the device between steps.  'fs_bench -G'
+*               calls it between workload ops, to compare runs with & without background processing;
+*               it is enabled here for that purpose only (the template ships it disabled).
+*
+*          (10) FS_NAND_CFG_BG_UB_FREE_MIN is the number of empty update blocks below which background
+*               processing merges the update block the next allocation would have to merge, if no
+*               partially used update block can take the allocation instead. Only full random update
+*               blocks are merged this way, since they cannot absorb any more writes.
+*               FS_NAND_CFG_BG_SEC_PER_STEP is the maximum number of sectors copied by one step of a
+*               sequential update block merge; lower values shorten each step (and thus the delay seen
+*               by other tasks) at the cost of more steps.
+*
+*               RAM usage = (<Nbr of avail blk tbl entries> / 8) octets (rounded up).
+*
+*          (11) FS_NAND_CFG_MULTI_SEC_MAX is the maximum number of consecutive sectors transferred in a
+*               single controller operation, when the controller supports it (e.g. the generic controller
+*               with a part supporting cache program/read). Sequential writes to an update block and
+*               reads from a data block without update block are then grouped per page & pipelined.
+*               Setting this to 1 disables multi-sector operations.
+*
+*               RAM usage = (<OOS size> x FS_NAND_CFG_MULTI_SEC_MAX) octets.
+*
+*********************************************************************************************************
+*/
+
+                                                                /* Config max nbr of reg'd ctrlr layer impl.            */
+#define  FS_NAND_CFG_MAX_CTRLR_IMPL                       1u    /*                                     (see Note #1)  : */
+
+                                                                /* Config auto sync                    (see Note #2)  : */
+#define  FS_NAND_CFG_AUTO_SYNC_EN                DEF_ENABLED
+                                                                /*   DEF_DISABLED   auto sync of meta data disabled.    */
+                                                                /*   DEF_ENABLED    auto sync of meta data enabled.     */
+
+                                                                /* Config meta cache                   (see Note #3)  : */
+#define  FS_NAND_CFG_UB_META_CACHE_EN            DEF_ENABLED
+                                                                /*   DEF_DISABLED   meta cache NOT present.             */
+                                                                /*   DEF_ENABLED    meta cache     present.             */
+
+                                                                /* Config commited dirty map cache     (see Note #4)  : */
+#define  FS_NAND_CFG_DIRTY_MAP_CACHE_EN          DEF_ENABLED
+                                                                /*   DEF_DISABLED   dirty cache NOT present.            */
+                                                                /*   DEF_ENABLED    dirty cache     present.            */
+
+                                                                /* Config update blk tbl subset size   (see Note #5)  : */
+#define  FS_NAND_CFG_UB_TBL_SUBSET_SIZE                   1u
+
+                                                                /* Config cnt of rsvd avail blks       (see Note #6)  : */
+#define  FS_NAND_CFG_RSVD_AVAIL_BLK_CNT                   3u
+
+                                                                /* Config nbr retries after rd fail    (see Note #7)  : */
+#define  FS_NAND_CFG_MAX_RD_RETRIES                      10u
+
+                                                                /* Config max pct of UB that can be SUB(see Note #8)  : */
+#define  FS_NAND_CFG_MAX_SUB_PCT                         30
+
+                                                                /* Config bg processing                (see Note #9)  : */
+#define  FS_NAND_CFG_BG_PROC_EN                  DEF_ENABLED
+                                                                /*   DEF_DISABLED   FS_NAND_BgProc() NOT present.       */
+                                                                /*   DEF_ENABLED    FS_NAND_BgProc()     present.       */
+
+                                                                /* Config bg processing targets        (see Note #10) : */
+#define  FS_NAND_CFG_BG_UB_FREE_MIN                       1u
+#define  FS_NAND_CFG_BG_SEC_PER_STEP                      8u
+
+                                                                /* Config max secs per multi-sec op    (see Note #11) : */
+#define  FS_NAND_CFG_MULTI_SEC_MAX                       16u
+
+
+/*
+*********************************************************************************************************
+*                                   NAND DRIVER ADVANCED CONFIGURATION
+*
+* Note(s) : (1) We strongly recommend to leave default values to these configurations. These are advanced
+*               configurations that do not need to be modified.
+*
+*********************************************************************************************************
+*/
+
+                                                                /* ------------------ FTL TH CONFIG ------------------- */
+                                                                /* Config th (see FS_NAND_SecWrInUB() note #2).         */
+#define  FS_NAND_CFG_TH_PCT_MERGE_RUB_START_SUB          20
+#define  FS_NAND_CFG_TH_PCT_CONVERT_SUB_TO_RUB           10     /* See also FS_NAND_UB_Alloc() note #2b.                */
+#define  FS_NAND_CFG_TH_PCT_PAD_SUB                       5
+
+                                                                /* Config th (see FS_NAND_UB_Alloc() note #2).          */
+#define  FS_NAND_CFG_TH_PCT_MERGE_SUB                    10
+#define  FS_NAND_CFG_TH_SUB_MIN_IDLE_TO_FOLD              5
+
+
+/*
+*********************************************************************************************************
+*                                   NAND DRIVER DEBUG CONFIGURATION
+*
+* Note(s) : (1) We strongly recommend to leave default values to these configurations. These are advanced
+*               configurations that usually do not need to be modified.
+*
+*********************************************************************************************************
+*/
+
+#define  FS_NAND_CFG_DUMP_SUPPORT_EN           DEF_DISABLED
+
+
+/*
+*********************************************************************************************************
+*                             NAND DRIVER METADATA CORRUPTION CONFIGURATION
+*
+* Note(s) : (1) This configuration should only be enabled when there are issues with meta block corruption.
+*               This includes issues where devices can no longer be low level formatted.
+*
+*           (2) If the device is being configured for release this configuration should NOT be left ENABLED.
+*               It creates a large number of excessive writes and is recommended to be left DISABLED.
+*
+*********************************************************************************************************
+*/
+
+#define  FS_NAND_CFG_CLR_CORRUPT_METABLK     DEF_DISABLED
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
+
+
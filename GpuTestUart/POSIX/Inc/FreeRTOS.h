@@ -0,0 +1,80 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : FreeRTOS.h
+*
+* Note(s)  : (1) Minimal FreeRTOS API subset needed to build 'userCode' on a POSIX host.  Kernel
+*                services are mapped onto the POSIX KAL by 'sim_os.c'.
+*
+*            (2) The tick rate matches 'Core/Inc/FreeRTOSConfig.h' so that timeouts expressed in ticks
+*                keep their meaning (1 tick = 1 ms).
+*********************************************************************************************************
+*/
+
+#ifndef  INC_FREERTOS_H
+#define  INC_FREERTOS_H
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <stddef.h>
+#include  <stdint.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  configTICK_RATE_HZ                             1000u   /* See Note #2.                                         */
+#define  configMAX_TASK_NAME_LEN                          16u
+
+#define  pdFALSE                                ((BaseType_t)0)
+#define  pdTRUE                                 ((BaseType_t)1)
+#define  pdPASS                                           pdTRUE
+#define  pdFAIL                                          pdFALSE
+
+#define  portMAX_DELAY                          ((TickType_t)0xFFFFFFFFu)
+
+#define  pdMS_TO_TICKS(ms)                      ((TickType_t)(((TickType_t)(ms) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000u))
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  long           BaseType_t;
+typedef  unsigned long  UBaseType_t;
+typedef  uint32_t       TickType_t;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void  *pvPortMalloc       (size_t  size);
+
+void   vPortFree          (void   *p_mem);
+
+void   Sim_CriticalEnter  (void);                               /* See 'task.h'.                                        */
+
+void   Sim_CriticalExit   (void);
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
@@ -0,0 +1,41 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : crc_util.h
+*
+* Note(s)  : (1) Minimal uC/CRC utility API subset needed to build the uC/FS NAND driver on a POSIX host.
+*                uC/CRC is not part of this tree : the population count is mapped onto uC/CPU.
+*********************************************************************************************************
+*/
+
+#ifndef  CRC_UTIL_H
+#define  CRC_UTIL_H
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+
+
+/*
+*********************************************************************************************************
+*                                               MACROS
+*********************************************************************************************************
+*/
+
+#define  CRCUtil_PopCnt_32(value)                       CPU_PopCnt32((CPU_INT32U)(value))
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
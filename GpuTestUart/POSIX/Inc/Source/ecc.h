@@ -0,0 +1,53 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : ecc.h
+*
+* Note(s)  : (1) Minimal uC/CRC ECC API subset needed to build the uC/FS NAND generic controller on a POSIX
+*                host.  The simulated NAND is protected by the bench ECC extension ('sim_flash.c'), so no
+*                ECC module is provided.
+*********************************************************************************************************
+*/
+
+#ifndef  ECC_H
+#define  ECC_H
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  ECC_ERR_NONE                                      0u
+#define  ECC_ERR_CORRECTABLE                               1u
+#define  ECC_ERR_CRITICAL_CORRECTABLE                      2u
+#define  ECC_ERR_UNCORRECTABLE                             3u
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT08U  ECC_ERR;
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
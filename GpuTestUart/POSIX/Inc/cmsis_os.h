@@ -0,0 +1,127 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : cmsis_os.h
+*
+* Note(s)  : (1) CMSIS-RTOS2 API subset used by 'userCode', implemented over the POSIX KAL by
+*                'sim_os.c'.  Types & values follow 'cmsis_os2.h' so the application code builds
+*                unmodified.
+*
+*            (2) Thread priorities are passed through to the KAL but are only honoured when the
+*                simulator has real-time scheduling privileges (see POSIX 'KAL_TaskCreate()' Note #2).
+*********************************************************************************************************
+*/
+
+#ifndef  CMSIS_OS_H_
+#define  CMSIS_OS_H_
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <stddef.h>
+#include  <stdint.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  osWaitForever                          0xFFFFFFFFu
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  enum {
+    osOK                    =  0,
+    osError                 = -1,
+    osErrorTimeout          = -2,
+    osErrorResource         = -3,
+    osErrorParameter        = -4,
+    osErrorNoMemory         = -5,
+    osErrorISR              = -6,
+    osStatusReserved        = 0x7FFFFFFF
+} osStatus_t;
+
+typedef  enum {                                                 /* See Note #2.                                         */
+    osPriorityNone          =  0,
+    osPriorityIdle          =  1,
+    osPriorityLow           =  8,
+    osPriorityBelowNormal   = 16,
+    osPriorityNormal        = 24,
+    osPriorityAboveNormal   = 32,
+    osPriorityHigh          = 40,
+    osPriorityRealtime      = 48,
+    osPriorityISR           = 56,
+    osPriorityError         = -1,
+    osPriorityReserved      = 0x7FFFFFFF
+} osPriority_t;
+
+typedef  void  (*osThreadFunc_t)(void  *argument);
+
+typedef  void  *osThreadId_t;
+typedef  void  *osSemaphoreId_t;
+
+typedef  struct {
+    const  char    *name;
+    uint32_t        attr_bits;
+    void           *cb_mem;
+    uint32_t        cb_size;
+    void           *stack_mem;
+    uint32_t        stack_size;
+    osPriority_t    priority;
+    uint32_t        tz_module;
+    uint32_t        reserved;
+} osThreadAttr_t;
+
+typedef  struct {
+    const  char    *name;
+    uint32_t        attr_bits;
+    void           *cb_mem;
+    uint32_t        cb_size;
+} osSemaphoreAttr_t;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+osThreadId_t     osThreadNew          (osThreadFunc_t            func,
+                                       void                     *argument,
+                                       const  osThreadAttr_t    *attr);
+
+osStatus_t       osDelay              (uint32_t                  ticks);
+
+uint32_t         osKernelGetTickCount (void);
+
+osSemaphoreId_t  osSemaphoreNew       (uint32_t                  max_count,
+                                       uint32_t                  initial_count,
+                                       const  osSemaphoreAttr_t *attr);
+
+osStatus_t       osSemaphoreAcquire   (osSemaphoreId_t           semaphore_id,
+                                       uint32_t                  timeout);
+
+osStatus_t       osSemaphoreRelease   (osSemaphoreId_t           semaphore_id);
+
+uint32_t         osSemaphoreGetCount  (osSemaphoreId_t           semaphore_id);
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
@@ -0,0 +1,68 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : gpu_emu.h
+*
+* Note(s)  : (1) Emulates the GPU-TFT serial display attached to USART1 : every command terminated by
+*                "\r\n" is answered with "OK" after a configurable latency, unless the reply is dropped
+*                (configurable loss probability).  Used to measure GPU_tx_and_rx_hand() throughput &
+*                retry behaviour on the host.
+*********************************************************************************************************
+*/
+
+#ifndef  GPU_EMU_H
+#define  GPU_EMU_H
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  gpu_emu_cfg {
+    CPU_INT32U  LatencyUs;                                      /* Cmd processing time before reply, in us.             */
+    CPU_INT32U  JitterUs;                                       /* Max random latency added, in us.                     */
+    CPU_INT32U  LossPpm;                                        /* Reply drop probability, in parts per million.        */
+    CPU_INT32U  Baud;                                           /* Reply line rate (0 = instantaneous).                 */
+    CPU_INT32U  Seed;                                           /* Seed of the loss/jitter generator.                   */
+} GPU_EMU_CFG;
+
+typedef  struct  gpu_emu_stat {
+    CPU_INT32U  CmdCtr;                                         /* Nbr of cmds received.                                */
+    CPU_INT32U  ReplyCtr;                                       /* Nbr of "OK" replies sent.                            */
+    CPU_INT32U  DropCtr;                                        /* Nbr of replies dropped.                              */
+    CPU_INT32U  OctetCtr;                                       /* Nbr of octets received.                              */
+} GPU_EMU_STAT;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  GpuEmu_Start    (int            fd,
+                              GPU_EMU_CFG   *p_cfg);
+
+void         GpuEmu_StatGet  (GPU_EMU_STAT  *p_stat);
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
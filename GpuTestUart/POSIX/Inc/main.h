@@ -0,0 +1,28 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : main.h
+*
+* Note(s)  : (1) Replaces 'Core/Inc/main.h'; only the HAL definitions needed by 'userCode' are provided
+*                (see 'usart.h').
+*********************************************************************************************************
+*/
+
+#ifndef  __MAIN_H
+#define  __MAIN_H
+
+#include  <stdint.h>
+
+
+#define  UNUSED(x)                              ((void)(x))
+
+
+typedef  enum {
+    HAL_OK       = 0x00u,
+    HAL_ERROR    = 0x01u,
+    HAL_BUSY     = 0x02u,
+    HAL_TIMEOUT  = 0x03u
+} HAL_StatusTypeDef;
+
+#endif
@@ -0,0 +1,22 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : rtc.h
+*
+* Note(s)  : (1) Replaces 'Core/Inc/rtc.h' for 'uc-Micrium/Clk/Source/clk.c'.  The RTC second interrupt
+*                is not simulated; the clock is set from the host time by Clk_OS_Init() ('sim_clk.c').
+*********************************************************************************************************
+*/
+
+#ifndef  __RTC_H__
+#define  __RTC_H__
+
+#include  "main.h"
+
+
+typedef  struct {
+    void  *Instance;
+} RTC_HandleTypeDef;
+
+#endif
@@ -0,0 +1,16 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : semphr.h
+*
+* Note(s)  : (1) 'userCode' only uses the CMSIS-RTOS2 semaphore API (see 'cmsis_os.h').
+*********************************************************************************************************
+*/
+
+#ifndef  SEMAPHORE_H
+#define  SEMAPHORE_H
+
+#include  "FreeRTOS.h"
+
+#endif
@@ -0,0 +1,69 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim.h
+*
+* Note(s)  : (1) Services shared by the simulation modules : OS shim ('sim_os.c'), host trace backend
+*                ('sim_trace.c') & pty shell ('sim_shell.c').
+*********************************************************************************************************
+*/
+
+#ifndef  SIM_H
+#define  SIM_H
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  SIM_TRACE_TS_FREQ_HZ                        1000000u   /* Host trace timestamps are in us.                     */
+
+#define  SIM_TASK_STK_SIZE_MIN                         65536u   /* Min host thread stk size, in octets.                 */
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+                                                                /* --------------------- OS SHIM ---------------------- */
+CPU_BOOLEAN  Sim_OS_Init          (void);
+
+CPU_INT64U   Sim_TimeUsGet        (void);
+
+void         Sim_DlyUs            (CPU_INT32U    dly_us);
+
+CPU_INT08U   Sim_TaskNbrCur       (void);
+
+                                                                /* ------------------ TRACE BACKEND ------------------- */
+void         Sim_TraceInit        (void);
+
+CPU_INT32U   Sim_TraceEvtCtrGet   (CPU_INT08U    id);
+
+CPU_BOOLEAN  Sim_TraceFileSave    (const  char  *p_path);
+
+                                                                /* -------------------- PTY SHELL --------------------- */
+CPU_BOOLEAN  Sim_ShellStart       (void);
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
@@ -0,0 +1,120 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_flash.h
+*
+* Note(s)  : (1) Simulated NAND & NOR flash backed by a memory-mapped image file ('sim_flash.c'), on which
+*                the uC/FS NAND (generic controller, static part) & NOR drivers run unchanged.
+*
+*            (2) Only one flash is simulated at a time : Sim_NAND_Init() or Sim_NOR_Init() selects it.
+*********************************************************************************************************
+*/
+
+#ifndef  SIM_FLASH_H
+#define  SIM_FLASH_H
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <lib_def.h>
+#include  <Dev/NAND/fs_dev_nand.h>
+#include  <Dev/NAND/Ctrlr/fs_dev_nand_ctrlr_gen.h>
+#include  <Dev/NAND/Part/fs_dev_nand_part_static.h>
+#include  <Dev/NOR/fs_dev_nor.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  SIM_NAND_PG_SIZE                               2048u   /* Large pg NAND geometry.                              */
+#define  SIM_NAND_SPARE_SIZE                              64u
+#define  SIM_NAND_PG_PER_BLK                              64u
+#define  SIM_NAND_NBR_PGM_PER_PG                           4u   /* Partial pg pgms allowed per pg.                      */
+
+#define  SIM_NOR_BLK_SIZE                              65536u   /* NOR erase blk size.                                  */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  sim_flash_cfg {
+    const  char  *ImgPathPtr;                                   /* Image file, DEF_NULL for a tmp file.                 */
+    CPU_INT32U    Size;                                         /* Flash size, in octets (main area for NAND).          */
+    CPU_INT32U    BadBlkCnt;                                    /* Nbr of factory bad blks (NAND only).                 */
+    CPU_INT32U    Endurance;                                    /* Rated nbr of erase cycles per blk.                   */
+    CPU_INT32U    FlipPPM;                                      /* Bit flips per million pg rds, when new (NAND only).  */
+    unsigned  int Seed;
+} SIM_FLASH_CFG;
+
+typedef  struct  sim_flash_stat {
+    CPU_INT64U    TimeNs;                                       /* Simulated dev busy & transfer time.                  */
+    CPU_INT64U    RdOctets;                                     /* Octets transferred from dev.                         */
+    CPU_INT64U    PgmOctets;                                    /* Octets pgm'd (NAND : main area only).                */
+    CPU_INT32U    RdCtr;                                        /* Nbr of pg loads (NAND) or rds (NOR).                 */
+    CPU_INT32U    PgmCtr;                                       /* Nbr of pg pgms  (NAND) or wrs (NOR).                 */
+    CPU_INT32U    EraseCtr;
+    CPU_INT32U    CacheRdCtr;                                   /* Nbr of pgs loaded  by cache rd  cmds (NAND).         */
+    CPU_INT32U    CachePgmCtr;                                  /* Nbr of pgs pgm'd   by cache pgm cmds (NAND).         */
+    CPU_INT32U    FlipCtr;                                      /* Nbr of bits flipped in pg rds (NAND).                */
+    CPU_INT32U    CorrCtr;                                      /* Nbr of secs corrected by ECC  (NAND).                */
+    CPU_INT32U    UncorrCtr;                                    /* Nbr of uncorrectable secs     (NAND).                */
+    CPU_INT32U    PgmFailCtr;                                   /* Nbr of failed pgms.                                  */
+    CPU_INT32U    EraseFailCtr;                                 /* Nbr of failed erases.                                */
+    CPU_INT32U    PgmViolCtr;                                   /* Nbr of pgms over NOP (NAND) or setting bits (NOR).   */
+    CPU_INT32U    BlkCnt;
+    CPU_INT32U    BadBlkCnt;                                    /* Nbr of factory bad blks.                             */
+    CPU_INT32U   *EraseCntTbl;                                  /* Erase cnt of each blk.                               */
+} SIM_FLASH_STAT;
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+extern  FS_NAND_CTRLR_GEN_BSP_API  Sim_NAND_BSP;                /* Generic ctrlr BSP.                                   */
+
+extern  FS_NAND_CTRLR_GEN_EXT      Sim_NAND_ECC;                /* Generic ctrlr ext : 1-bit corr, 2-bit detect ECC.    */
+
+extern  FS_DEV_NOR_PHY_API         Sim_NOR_Phy;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN             Sim_NAND_Init     (const  SIM_FLASH_CFG            *p_cfg,
+                                                  FS_NAND_PART_STATIC_CFG  *p_part_cfg);
+
+CPU_BOOLEAN             Sim_NOR_Init      (const  SIM_FLASH_CFG            *p_cfg,
+                                                  FS_DEV_NOR_CFG           *p_nor_cfg);
+
+void                    Sim_FlashClose    (void);
+
+void                    Sim_FlashStatReset(void);
+
+const  SIM_FLASH_STAT  *Sim_FlashStatGet  (void);
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
@@ -0,0 +1,88 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_sd.h
+*
+* Note(s)  : (1) Simulated SD card in SPI mode ('sim_sd.c'), on which the uC/FS SD SPI driver
+*                ('fs_dev_sd_spi.c') runs unchanged.  It provides the SPI BSP (FSDev_SD_SPI_BSP_SPI) & the
+*                DMA BSP (FSDev_SD_SPI_BSP_DMA) of unit 0.
+*********************************************************************************************************
+*/
+
+#ifndef  SIM_SD_H
+#define  SIM_SD_H
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <lib_def.h>
+#include  <Dev/SD/SPI/fs_dev_sd_spi.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  SIM_SD_BLK_SIZE                                 512u
+#define  SIM_SD_SIZE_UNIT                             524288u   /* Card size unit (CSD v2.0 C_SIZE unit).               */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  sim_sd_cfg {
+    CPU_INT32U    Size;                                         /* Card size, in octets (rounded down to size unit).    */
+    CPU_INT32U    HostGapNs;                                    /* Host time between two driver accesses.               */
+} SIM_SD_CFG;
+
+typedef  struct  sim_sd_stat {
+    CPU_INT64U    TimeNs;                                       /* Simulated time, incl. host gaps.                     */
+    CPU_INT64U    CpuNs;                                        /* CPU time in SPI xfers & polling.                     */
+    CPU_INT64U    BusyNs;                                       /* Time card was busy programming.                      */
+    CPU_INT64U    BusyHiddenNs;                                 /* Busy time elapsed during host gaps.                  */
+    CPU_INT64U    RdOctets;                                     /* Data octets transferred from card.                   */
+    CPU_INT64U    WrOctets;                                     /* Data octets transferred to   card.                   */
+    CPU_INT32U    CmdCtr;
+    CPU_INT32U    RdBlkCtr;
+    CPU_INT32U    WrBlkCtr;
+    CPU_INT32U    RdMultiCtr;                                   /* Nbr of multi blk rds (CMD18).                        */
+    CPU_INT32U    WrMultiCtr;                                   /* Nbr of multi blk wrs (CMD25).                        */
+    CPU_INT32U    PreEraseCtr;                                  /* Nbr of multi blk wrs pre-erased by ACMD23.           */
+    CPU_INT32U    DMA_XferCtr;
+    CPU_INT32U    ViolCtr;                                      /* Nbr of cmds or tokens sent while busy.               */
+} SIM_SD_STAT;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN          Sim_SD_Init     (const  SIM_SD_CFG  *p_cfg);
+
+void                 Sim_SD_Close    (void);
+
+void                 Sim_SD_StatReset(void);
+
+const  SIM_SD_STAT  *Sim_SD_StatGet  (void);
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
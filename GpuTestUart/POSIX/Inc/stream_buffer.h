@@ -0,0 +1,20 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : stream_buffer.h
+*
+* Note(s)  : (1) Stream buffers are only used by the register-level USART2 shell driver
+*                ('userCode/shell_app.c'), which is replaced by a pty on the host (see 'sim_main.c').
+*                Only the handle type is provided.
+*********************************************************************************************************
+*/
+
+#ifndef  STREAM_BUFFER_H
+#define  STREAM_BUFFER_H
+
+#include  "FreeRTOS.h"
+
+typedef  void  *StreamBufferHandle_t;
+
+#endif
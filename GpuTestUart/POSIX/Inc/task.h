@@ -0,0 +1,28 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : task.h
+*
+* Note(s)  : (1) Critical sections are emulated with a process-wide recursive mutex.  Simulated ISRs
+*                ('sim_uart.c') do not take it, so code relying on a critical section to mask an ISR
+*                is NOT protected against it on the host.
+*********************************************************************************************************
+*/
+
+#ifndef  INC_TASK_H
+#define  INC_TASK_H
+
+#include  "FreeRTOS.h"
+
+
+#define  taskENTER_CRITICAL()                   Sim_CriticalEnter()     /* See Note #1.                                 */
+#define  taskEXIT_CRITICAL()                    Sim_CriticalExit()
+
+#define  taskENTER_CRITICAL_FROM_ISR()          (Sim_CriticalEnter(), 0u)
+#define  taskEXIT_CRITICAL_FROM_ISR(x)          ((void)(x), Sim_CriticalExit())
+
+
+void  vTaskDelay  (const  TickType_t  ticks);
+
+#endif
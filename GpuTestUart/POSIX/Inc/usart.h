@@ -0,0 +1,102 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : usart.h
+*
+* Note(s)  : (1) Replaces 'Core/Inc/usart.h'.  Each UART handle is bound to a file descriptor (socketpair
+*                or pty) by Sim_UART_Open(); DMA transfers & RX interrupts are emulated by one TX & one
+*                RX thread per UART, which invoke the HAL completion callbacks implemented by the
+*                application (see 'sim_uart.c').
+*********************************************************************************************************
+*/
+
+#ifndef  __USART_H__
+#define  __USART_H__
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "main.h"
+#include  <cpu.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  USART1                                 ((USART_TypeDef *)&Sim_USART_Tbl[0])
+#define  USART2                                 ((USART_TypeDef *)&Sim_USART_Tbl[1])
+
+#define  USART1_IRQn                                      37u   /* Same IRQ nbrs as STM32F103, for trace decoding.      */
+#define  USART2_IRQn                                      38u
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  usart_type_def {
+    CPU_INT08U  Nbr;
+} USART_TypeDef;
+
+typedef  struct  __UART_HandleTypeDef {
+    USART_TypeDef  *Instance;
+    void           *SimPtr;                                     /* Ptr to sim UART state (see 'sim_uart.c').            */
+} UART_HandleTypeDef;
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+extern  USART_TypeDef       Sim_USART_Tbl[2];
+
+extern  UART_HandleTypeDef  huart1;
+extern  UART_HandleTypeDef  huart2;
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+HAL_StatusTypeDef  HAL_UART_Transmit_DMA          (UART_HandleTypeDef  *huart,
+                                                   uint8_t             *pData,
+                                                   uint16_t             Size);
+
+HAL_StatusTypeDef  HAL_UART_Receive_IT            (UART_HandleTypeDef  *huart,
+                                                   uint8_t             *pData,
+                                                   uint16_t             Size);
+
+HAL_StatusTypeDef  HAL_UART_AbortReceive_IT       (UART_HandleTypeDef  *huart);
+
+                                                                /* Callbacks, implemented by the app.                   */
+void               HAL_UART_TxCpltCallback        (UART_HandleTypeDef  *huart);
+
+void               HAL_UART_RxCpltCallback        (UART_HandleTypeDef  *huart);
+
+void               HAL_UART_AbortReceiveCpltCallback(UART_HandleTypeDef *huart);
+
+                                                                /* ------------------- SIM CONTROL -------------------- */
+CPU_BOOLEAN        Sim_UART_Open                  (UART_HandleTypeDef  *huart,
+                                                   int                  fd,
+                                                   CPU_INT32U           baud);
+
+CPU_INT32U         Sim_UART_RxDropCtrGet          (UART_HandleTypeDef  *huart);
+
+CPU_INT32U         Sim_UART_ByteTimeUs            (CPU_INT32U           baud,
+                                                   CPU_INT32U           nbr_octets);
+
+#endif
@@ -0,0 +1,3541 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : fs_bench.c
+*
+* Note(s)  : (1) File system benchmark running uC/FS (FAT) on a RAM disk on the host, to measure the
+*                effect of volume cache & FAT driver changes :
+*
+*                    fs_bench -f 400 -d 8 -r 8 -c 16 -m b
+*
+*            (2) The workload is FAT-heavy : many small files spread over a few directories are, in
+*                random order, appended to, read back, stat'ed & deleted/re-created, & every directory
+*                is listed after each round.  File contents follow a known pattern & are verified on
+*                every read, after the cache is flushed & again after it is invalidated.
+*
+*            (3) Device accesses are counted through the FS device I/O hooks ('FS/fs_cfg.h').  Cache
+*                hit, miss & eviction counters are read with FSVol_Query().
+*
+*            (4) With '-w age', a background writer is simulated : every FS_BENCH_WR_BACK_PERIOD ops,
+*                FSVol_CacheWrBack() writes back the sectors dirty for 'age' periods or more.
+*
+*            (5) The exit status is 0 if every verification passed, 1 if any failed & 2 on usage or
+*                initialization error.
+*
+*            (6) With '-s kib', a file of 'kib' KiB is then written & read back sequentially, from the
+*                device, in FS_BENCH_STREAM_RD_SIZE octet reads, to measure sequential read ahead.  On NAND,
+*                the multi-sector controller operations & the cache program/read commands they issue are
+*                also reported, & counted as errors if the write or the read used none :
+*
+*                    fs_bench -t nand -D 16 -f 20 -r 1 -s 4096
+*
+*            (7) With '-x nbr', 'nbr' random seeks, each followed by a FS_BENCH_STREAM_RD_SIZE octet read,
+*                are then done in the file written by '-s', to measure seeking in a long cluster chain :
+*
+*                    fs_bench -D 100 -s 65536 -x 20000
+*
+*            (8) With '-F pct', the volume is then filled to 'pct' % with FS_BENCH_FILL_FILE_SIZE octet
+*                files, every other file is deleted & a large file is written in the holes left, to
+*                measure cluster allocation on a nearly full, fragmented volume.
+*
+*            (9) With '-M', the volume is then closed & re-opened, cleanly & after a simulated dirty
+*                shutdown, to measure mounting & the first FSVol_Query().  A RAM disk over 512 MiB is
+*                formatted as FAT32 :
+*
+*                    fs_bench -D 600 -M
+*
+*           (10) With '-L nbr', 'nbr' files are then created in one directory & looked up, to measure name
+*                lookups in a large directory; each is looked up once & as many missing names.  The long
+*                names begin alike, so creating them also measures the generation of unique SFNs.  The
+*                host build indexes directory names (see 'fs_cfg.h  FILE SYSTEM FAT CONFIGURATION  Note #7'),
+*                so lookups read only the sectors holding matching entries; rebuild without the index to
+*                compare :
+*
+*                    make fs_bench CFLAGS="-O2 -DFS_FAT_CFG_DIR_HASH_NBR=0u"
+*
+*           (11) With '-J', the journal is opened & started once the volume is formatted, so that the
+*                workload measures journaling.  Operations are committed in groups of
+*                FS_FAT_CFG_JOURNAL_GROUP_OP_MAX; rebuild with another value to compare :
+*
+*                    make fs_bench CFLAGS="-O2 -DFS_FAT_CFG_JOURNAL_GROUP_OP_MAX=16u"
+*
+*           (12) With '-P nbr', 'nbr' power cuts are then simulated : after a random nbr of device writes,
+*                up to FS_BENCH_PWR_WR_MAX, the RAM disk contents are saved while random operations go on
+*                (appends, some followed by fs_fflush(), re-creates, truncates, renames & directory
+*                creations).  The saved contents are then restored, the volume re-opened & the journal
+*                replayed.  The FAT & directories are checked for cross-linked, lost or invalid clusters
+*                & sizes not matching cluster chains, & every file untouched since the last commit is
+*                verified; the others are re-created.  The volume is used without cache :
+*
+*                    fs_bench -D 8 -f 100 -r 1 -P 500
+*
+*           (13) With '-t nand' or '-t nor', the volume is on a simulated NAND or NOR flash instead of the
+*                RAM disk (see 'sim_flash.c'), driven by the uC/FS NAND (generic controller, static part)
+*                or NOR driver.  The image may be kept in a file with '-i', so that wear accumulates
+*                across runs.  Once every test is done, the simulated device time since the volume was
+*                formatted, the throughput of sectors read & written by the volume over that time, the
+*                write amplification (octets programmed in the array per octet written by the volume) &
+*                the erase count distribution are reported.  '-M' & '-P' access the RAM disk contents &
+*                cannot be used :
+*
+*                    fs_bench -t nand -D 16 -f 200 -r 4 -B 1000
+*
+*                For NAND, '-G' calls FS_NAND_BgProc() between workload ops, as an idle task would, up to
+*                FS_BENCH_BG_STEP_MAX times or until it reports no more work, so that the merge or erase
+*                the next write would need is done ahead of it.  The SUB & RUB merges are reported, with
+*                & without '-G', along with the background merge steps & erases & the device time they
+*                took.  That time is spent while the application is idle : the throughput is also
+*                reported over the device time of the ops alone, so that both runs are compared on
+*                write amplification, throughput & wear :
+*
+*                    fs_bench -t nand -D 16 -f 200 -F 90 -G
+*
+*                For NOR, the device time of the low-level mount when the device was opened & of a
+*                low-level unmount & mount once every test is done are also reported.  A process that
+*                exits without unmounting leaves an image as if power were lost, so the next run with
+*                the same '-i' image mounts it as after an unclean power-off :
+*
+*                    fs_bench -t nor -D 4 -f 100 -i nor.img
+*
+*                For NOR, '-W' calls FSDev_NOR_WearLevel() after each round, as an idle task would, up to
+*                FS_BENCH_WEAR_LEVEL_STEP_MAX times or until it reports no more cold blocks.  The idle
+*                steps, the static wear leveling moves & the erase count spread from the first round to
+*                the end are reported :
+*
+*                    fs_bench -t nor -D 2 -f 40 -r 1500 -F 80 -E 2000 -W
+*
+*           (14) With '-t sd', the volume is on a simulated SD card in SPI mode (see 'sim_sd.c'), driven by
+*                the uC/FS SD SPI driver.  The simulated time since the volume was formatted, including
+*                FS_BENCH_SD_HOST_GAP_NS of host time before each driver access, the throughput of sectors
+*                read & written by the volume over that time, the CPU time spent in SPI transfers & busy
+*                polling & the time the card was busy programming (& how much of it was hidden in host
+*                time) are reported.  '-M' & '-P' cannot be used & '-i' is ignored.  The driver options
+*                in 'fs_cfg.h' are compared by rebuilding :
+*
+*                    make clean fs_bench CFLAGS="-O2 -DFS_DEV_SD_SPI_CFG_BUSY_DEFER_EN=DEF_DISABLED"
+*                    fs_bench -t sd -f 200 -r 4 -s 4096
+*
+*           (15) With '-O kib', a file of 'kib' KiB is then written & read back in FS_BENCH_DIRECT_XFER_SIZE
+*                octet requests, once through the volume cache & once opened with
+*                FS_FILE_ACCESS_MODE_DIRECT.  Before it is read back, FS_BENCH_DIRECT_PATCH_SIZE octets in
+*                the middle of the file are overwritten through the cache, so that a direct read must
+*                return sectors still dirty in a write back cache :
+*
+*                    fs_bench -t sd -f 100 -r 2 -O 4096
+*
+*           (16) With '-X kib', a file of 'kib' KiB is then written & walked with FSFile_Map(), its data
+*                being compared in place.  Extents are mapped from a RAM disk or the simulated NOR image;
+*                other devices cannot map & FS_BENCH_DIRECT_XFER_SIZE octet pieces are copied instead.
+*                The extents, octets mapped & copied & device read requests are reported :
+*
+*                    fs_bench -t nor -f 50 -r 1 -X 1024
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "sim.h"
+#include  "sim_flash.h"
+#include  "sim_sd.h"
+
+#include  <cpu_core.h>
+#include  <lib_mem.h>
+#include  <lib_str.h>
+#include  <Source/fs.h>
+#include  <Source/fs_api.h>
+#include  <Source/fs_dev.h>
+#include  <Source/fs_vol.h>
+#include  <Dev/RAMDisk/fs_dev_ramdisk.h>
+#include  <FAT/fs_fat.h>
+#include  <FAT/fs_fat_journal.h>
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <unistd.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  FS_BENCH_SEC_SIZE                               512u
+
+#define  FS_BENCH_DFLT_FILE_NBR                          400u
+#define  FS_BENCH_DFLT_DIR_NBR                             8u
+#define  FS_BENCH_DFLT_ROUND_NBR                           8u
+#define  FS_BENCH_DFLT_CACHE_KB                           16u
+#define  FS_BENCH_DFLT_DISK_MB                            32u
+#define  FS_BENCH_DFLT_BAD_BLK_NBR                         2u   /* Nbr of factory bad NAND blks (see Note #13).         */
+#define  FS_BENCH_DFLT_FLIP_PPM                          100u   /* Bit flips per million NAND pg rds.                   */
+#define  FS_BENCH_DFLT_ENDURANCE                      100000u   /* Rated erase cycles per flash blk.                    */
+#define  FS_BENCH_SD_HOST_GAP_NS                       20000u   /* Host time before each SD driver access (Note #14).   */
+
+#define  FS_BENCH_VOL_NAME                          "vol:0:"
+
+#define  FS_BENCH_DEV_RAM                                  0u   /* Dev types (see Note #13).                            */
+#define  FS_BENCH_DEV_NAND                                 1u
+#define  FS_BENCH_DEV_NOR                                  2u
+#define  FS_BENCH_DEV_SD                                   3u   /* See Note #14.                                        */
+
+#define  FS_BENCH_WEAR_HIST_NBR                            8u   /* Nbr of erase cnt histogram bins.                     */
+#define  FS_BENCH_WEAR_LEVEL_STEP_MAX                     16u   /* Max NOR wear level steps per round (see Note #13).   */
+#define  FS_BENCH_BG_STEP_MAX                             32u   /* Max NAND bg steps per op           (see Note #13).   */
+
+#define  FS_BENCH_APPEND_MAX                            2048u   /* Max nbr of octets appended at once.                  */
+#define  FS_BENCH_FILE_SIZE_MAX                        32768u   /* Files are re-created when they reach this size.      */
+
+#define  FS_BENCH_NAME_LEN_MAX                            48u
+
+#define  FS_BENCH_WR_BACK_PERIOD                          16u   /* Nbr of ops between background wr backs (see Note #4).*/
+
+#define  FS_BENCH_STREAM_RD_SIZE                         512u   /* Size of sequential rds (see Note #6).                */
+#define  FS_BENCH_STREAM_WR_SIZE                        4096u
+
+#define  FS_BENCH_FILL_FILE_SIZE                       16384u   /* Size of fill files (see Note #8).                    */
+#define  FS_BENCH_FILL_DIR_FILE_NBR                      128u   /* Nbr of fill files per dir.                           */
+#define  FS_BENCH_FILL_WR_SIZE          FS_BENCH_FILE_SIZE_MAX   /* Size of wrs & rds in holes.                          */
+
+#define  FS_BENCH_DIRECT_XFER_SIZE      FS_BENCH_FILE_SIZE_MAX   /* Size of direct I/O wrs & rds (see Note #15).         */
+#define  FS_BENCH_DIRECT_PATCH_SIZE                       64u   /* Size of patch wr through cache.                      */
+
+#define  FS_BENCH_MOUNT_SCAN_NBR                        4096u   /* Nbr of FAT entries per background step (Note #9).    */
+#define  FS_BENCH_FAT32_CLN_SHUT_BIT              0x08000000u   /* FAT[1] clean shutdown bit.                           */
+
+#define  FS_BENCH_PWR_WR_MAX                              64u   /* Max nbr of dev wrs before pwr cut (see Note #12).    */
+#define  FS_BENCH_PWR_OP_MAX                             256u   /* Max nbr of ops before pwr cut.                       */
+#define  FS_BENCH_PWR_DIR_NAME                FS_BENCH_VOL_NAME "\\PWR.DIR"
+
+#define  FS_BENCH_DIR_ENTRY_SIZE                          32u   /* Size of FAT dir entry.                               */
+#define  FS_BENCH_DIR_DEPTH_MAX                            8u   /* Max depth of dirs chk'd.                             */
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_bench_file {
+    CPU_INT32U  Size;                                           /* Expected file size, in octets.                       */
+    CPU_INT32U  Gen;                                            /* Nbr of times file was re-created (content seed).     */
+} FS_BENCH_FILE;
+
+typedef  struct  fs_bench_ctr {
+    CPU_INT32U  AppendCtr;
+    CPU_INT32U  RdCtr;
+    CPU_INT32U  RecreateCtr;
+    CPU_INT32U  StatCtr;
+    CPU_INT32U  DirWalkCtr;
+    CPU_INT32U  ErrCtr;                                         /* Nbr of failed ops or verifications.                  */
+} FS_BENCH_CTR;
+
+typedef  struct  fs_bench_fat_chk {                             /* Raw FAT chk (see Note #12).                          */
+    CPU_INT08U  *FAT_Ptr;                                       /* First FAT.                                           */
+    CPU_INT08U  *RootPtr;                                       /* Root dir of FAT12/16 vol.                            */
+    CPU_INT08U  *DataPtr;                                       /* Clus 2.                                              */
+    CPU_INT32U   RootEntryCnt;
+    CPU_INT32U   RootClus;                                      /* Root dir clus of FAT32 vol.                          */
+    CPU_INT32U   ClusSize;                                      /* Clus size, in octets.                                */
+    CPU_INT32U   ClusCnt;
+    CPU_INT32U   ClusEOC;                                       /* Min end of clus chain val.                           */
+    CPU_INT08U   FAT_Type;                                      /* 12, 16 or 32.                                        */
+    CPU_INT08U  *UsedTbl;                                       /* Clus found in a chain.                               */
+    CPU_INT32U   ErrCtr;
+} FS_BENCH_FAT_CHK;
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  FS_BENCH_FILE  *FS_Bench_FileTbl;
+static  CPU_INT32U      FS_Bench_FileNbr;
+static  CPU_INT32U      FS_Bench_DirNbr;
+static  FS_BENCH_CTR    FS_Bench_Ctr;
+static  unsigned  int   FS_Bench_Seed;
+static  CPU_INT32U      FS_Bench_WrBackAge;                     /* Max dirty age, 0 if no background writer.            */
+static  CPU_BOOLEAN     FS_Bench_BgProcEn;                      /* NAND bg processing between ops (see Note #13).       */
+static  CPU_INT64U      FS_Bench_BgTimeNs;                      /* Dev time spent in bg processing.                     */
+static  CPU_BOOLEAN     FS_Bench_WearLevelEn;                   /* NOR wear level between rounds (see Note #13).        */
+static  CPU_INT32U      FS_Bench_WearLevelStepCtr;              /* Nbr of wear level steps that did work.               */
+static  CPU_INT32U      FS_Bench_WearLevelStaticBase;           /* Static moves & spread before first round.            */
+static  CPU_INT32U      FS_Bench_WearLevelSpreadBase;
+
+static  CPU_INT32U      FS_Bench_DevRdCtr;                      /* Nbr of dev rd  requests.                             */
+static  CPU_INT32U      FS_Bench_DevRdSecCtr;                   /* Nbr of secs rd from dev.                             */
+static  CPU_INT32U      FS_Bench_DevWrCtr;
+static  CPU_INT32U      FS_Bench_DevWrSecCtr;
+
+static  CPU_INT08U      FS_Bench_DevType;                       /* See Note #13.                                        */
+static  const  char    *FS_Bench_DevNamePtr;
+static  SIM_FLASH_CFG   FS_Bench_FlashCfg;
+static  CPU_INT32U      FS_Bench_FlashRdSecBase;                /* Dev ctrs when flash stats were reset.                */
+static  CPU_INT32U      FS_Bench_FlashWrSecBase;
+static  CPU_INT64U      FS_Bench_FlashMountNs;                  /* Dev time of mount when dev was opened.               */
+
+static  CPU_INT08U     *FS_Bench_DiskPtr;                       /* RAM disk contents.                                   */
+static  CPU_INT32U      FS_Bench_DiskSize;                      /* RAM disk size, in octets.                            */
+
+static  CPU_INT08U     *FS_Bench_PwrCutDiskPtr;                 /* RAM disk contents at pwr cut.                        */
+static  CPU_INT32U      FS_Bench_PwrCutWrNbr;                   /* Dev wr after which pwr is cut, 0 if none.            */
+
+static  CPU_INT08U      FS_Bench_Buf[FS_BENCH_FILE_SIZE_MAX + FS_BENCH_APPEND_MAX];
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_Bench_Setup     (CPU_INT32U       disk_mb,
+                                         CPU_INT32U       cache_kb,
+                                         FS_FLAGS         cache_mode,
+                                         CPU_BOOLEAN      journal);
+
+static  CPU_BOOLEAN  FS_Bench_DevOpen   (CPU_INT32U       disk_mb);
+
+static  void         FS_Bench_Round     (void);
+
+static  void         FS_Bench_FileAppend(CPU_INT32U       file_ix);
+
+static  void         FS_Bench_FileRecreate(CPU_INT32U     file_ix);
+
+static  void         FS_Bench_FileVerify(CPU_INT32U       file_ix);
+
+static  void         FS_Bench_FileStat  (CPU_INT32U       file_ix);
+
+static  void         FS_Bench_DirWalk   (CPU_INT32U       dir_ix);
+
+static  void         FS_Bench_NameGet   (CPU_INT32U       file_ix,
+                                         char            *p_name);
+
+static  void         FS_Bench_PatternFill(CPU_INT32U      file_ix,
+                                          CPU_INT32U      pos,
+                                          CPU_INT08U     *p_buf,
+                                          CPU_INT32U      len);
+
+static  void         FS_Bench_Report    (CPU_INT64U       elapsed_us);
+
+static  void         FS_Bench_FlashReport(void);
+
+static  void         FS_Bench_SD_Report (void);
+
+static  void         FS_Bench_NOR_Remount(void);
+
+static  void         FS_Bench_NOR_WearLevel(void);
+
+static  void         FS_Bench_Stream    (CPU_INT32U       size_kb);
+
+static  void         FS_Bench_Seek      (CPU_INT32U       size_kb,
+                                         CPU_INT32U       seek_nbr);
+
+static  void         FS_Bench_Fill      (CPU_INT32U       pct);
+
+static  void         FS_Bench_Direct    (CPU_INT32U       size_kb);
+
+static  CPU_BOOLEAN  FS_Bench_DirectPass(CPU_INT32U       size,
+                                         CPU_BOOLEAN      direct);
+
+static  void         FS_Bench_Map       (CPU_INT32U       size_kb);
+
+static  void         FS_Bench_Mount     (void);
+
+static  CPU_BOOLEAN  FS_Bench_MountTime (CPU_BOOLEAN      dirty,
+                                         CPU_INT32U      *p_free_sec);
+
+static  CPU_BOOLEAN  FS_Bench_Remount   (CPU_BOOLEAN      dirty);
+
+static  void         FS_Bench_Lookup    (CPU_INT32U       nbr);
+
+static  void         FS_Bench_LookupNameGet(CPU_INT32U    file_ix,
+                                            CPU_BOOLEAN   upper,
+                                            char         *p_name);
+
+static  void         FS_Bench_StreamFill(CPU_INT32U       pos,
+                                         CPU_INT08U      *p_buf,
+                                         CPU_INT32U       len);
+
+static  void         FS_Bench_PwrCut    (CPU_INT32U       nbr);
+
+static  CPU_BOOLEAN  FS_Bench_PwrCutOp  (CPU_INT32U       file_ix);
+
+static  void         FS_Bench_PwrCutFileReset(CPU_INT32U  file_ix);
+
+static  CPU_BOOLEAN  FS_Bench_JournalOpen(void);
+
+static  CPU_INT32U   FS_Bench_FAT_Chk   (void);
+
+static  CPU_INT32U   FS_Bench_FAT_ChkEntryGet(FS_BENCH_FAT_CHK  *p_chk,
+                                              CPU_INT32U         clus);
+
+static  CPU_INT32U   FS_Bench_FAT_ChkChain(FS_BENCH_FAT_CHK    *p_chk,
+                                           CPU_INT32U           first_clus,
+                                           const  CPU_INT08U   *p_name);
+
+static  void         FS_Bench_FAT_ChkDir(FS_BENCH_FAT_CHK    *p_chk,
+                                         CPU_INT32U           first_clus,
+                                         CPU_INT32U           depth);
+
+static  CPU_BOOLEAN  FS_Bench_FAT_ChkDirEntries(FS_BENCH_FAT_CHK  *p_chk,
+                                                CPU_INT08U        *p_entry,
+                                                CPU_INT32U         entry_cnt,
+                                                CPU_INT32U         depth);
+
+static  void         FS_Bench_Usage     (const  char     *p_prog);
+
+
+/*
+*********************************************************************************************************
+*                                               main()
+*
+* Description : Parse the command line, format a RAM disk or flash & run the benchmark (see Note #2).
+*
+* Argument(s) : argc        Nbr of arguments.
+*
+*               argv        Array of arguments.
+*
+* Return(s)   : See Note #5.
+*
+* Caller(s)   : Host C runtime.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+int  main (int    argc,
+           char  *argv[])
+{
+    CPU_INT32U            round_nbr;
+    CPU_INT32U            cache_kb;
+    CPU_INT32U            disk_mb;
+    CPU_INT32U            stream_kb;
+    CPU_INT32U            seek_nbr;
+    CPU_INT32U            fill_pct;
+    CPU_INT32U            direct_kb;
+    CPU_INT32U            map_kb;
+    CPU_INT32U            lookup_nbr;
+    CPU_INT32U            pwr_cut_nbr;
+    CPU_BOOLEAN           mount;
+    CPU_BOOLEAN           journal;
+    CPU_INT32U            ix;
+    FS_FLAGS              cache_mode;
+    FS_DEV_NOR_WEAR_INFO  nor_wear;
+    CPU_INT64U            start_us;
+    CPU_INT64U            elapsed_us;
+    FS_ERR                err;
+    int                   opt;
+
+
+    FS_Bench_FileNbr = FS_BENCH_DFLT_FILE_NBR;
+    FS_Bench_DirNbr  = FS_BENCH_DFLT_DIR_NBR;
+    FS_Bench_Seed    = 1u;
+    round_nbr        = FS_BENCH_DFLT_ROUND_NBR;
+    cache_kb         = FS_BENCH_DFLT_CACHE_KB;
+    disk_mb          = FS_BENCH_DFLT_DISK_MB;
+    stream_kb        = 0u;
+    seek_nbr         = 0u;
+    fill_pct         = 0u;
+    direct_kb        = 0u;
+    map_kb           = 0u;
+    lookup_nbr       = 0u;
+    pwr_cut_nbr      = 0u;
+    mount            = DEF_NO;
+    journal          = DEF_NO;
+    cache_mode       = FS_VOL_CACHE_MODE_WR_BACK;
+
+    FS_Bench_DevType    = FS_BENCH_DEV_RAM;
+    FS_Bench_DevNamePtr = "ram:0:";
+    FS_Bench_BgProcEn   = DEF_NO;
+    FS_Bench_WearLevelEn = DEF_NO;
+    FS_Bench_FlashCfg.ImgPathPtr = DEF_NULL;
+    FS_Bench_FlashCfg.BadBlkCnt  = FS_BENCH_DFLT_BAD_BLK_NBR;
+    FS_Bench_FlashCfg.FlipPPM    = FS_BENCH_DFLT_FLIP_PPM;
+    FS_Bench_FlashCfg.Endurance  = FS_BENCH_DFLT_ENDURANCE;
+
+    while ((opt = getopt(argc, argv, "f:d:r:c:m:w:s:x:F:O:X:L:MJP:D:S:t:i:b:B:E:GWh")) != -1) {
+        switch (opt) {
+            case 'f': FS_Bench_FileNbr = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'd': FS_Bench_DirNbr  = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'r': round_nbr        = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'c': cache_kb         = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'w': FS_Bench_WrBackAge = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);           break;
+            case 's': stream_kb        = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'x': seek_nbr         = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'F': fill_pct         = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'O': direct_kb        = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'X': map_kb           = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'L': lookup_nbr       = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'M': mount            = DEF_YES;                                              break;
+            case 'J': journal          = DEF_YES;                                              break;
+            case 'P': pwr_cut_nbr      = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'D': disk_mb          = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);             break;
+            case 'S': FS_Bench_Seed    = (unsigned int)strtoul(optarg, DEF_NULL, 0);           break;
+            case 'i': FS_Bench_FlashCfg.ImgPathPtr = optarg;                                   break;
+            case 'b': FS_Bench_FlashCfg.BadBlkCnt  = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0); break;
+            case 'B': FS_Bench_FlashCfg.FlipPPM    = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0); break;
+            case 'E': FS_Bench_FlashCfg.Endurance  = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0); break;
+            case 'G': FS_Bench_BgProcEn            = DEF_YES;                                  break;
+            case 'W': FS_Bench_WearLevelEn         = DEF_YES;                                  break;
+            case 't':
+                 if (Str_Cmp((CPU_CHAR *)optarg, (CPU_CHAR *)"ram") == 0) {
+                     FS_Bench_DevType    = FS_BENCH_DEV_RAM;
+                     FS_Bench_DevNamePtr = "ram:0:";
+                 } else if (Str_Cmp((CPU_CHAR *)optarg, (CPU_CHAR *)"nand") == 0) {
+                     FS_Bench_DevType    = FS_BENCH_DEV_NAND;
+                     FS_Bench_DevNamePtr = "nand:0:";
+                 } else if (Str_Cmp((CPU_CHAR *)optarg, (CPU_CHAR *)"nor") == 0) {
+                     FS_Bench_DevType    = FS_BENCH_DEV_NOR;
+                     FS_Bench_DevNamePtr = "nor:0:";
+                 } else if (Str_Cmp((CPU_CHAR *)optarg, (CPU_CHAR *)"sd") == 0) {
+                     FS_Bench_DevType    = FS_BENCH_DEV_SD;
+                     FS_Bench_DevNamePtr = "sd:0:";
+                 } else {
+                     FS_Bench_Usage(argv[0]);
+                     return (2);
+                 }
+                 break;
+
+            case 'm':
+                 switch (optarg[0]) {
+                     case 'r': cache_mode = FS_VOL_CACHE_MODE_RD;                              break;
+                     case 't': cache_mode = FS_VOL_CACHE_MODE_WR_THROUGH;                      break;
+                     case 'b': cache_mode = FS_VOL_CACHE_MODE_WR_BACK;                         break;
+                     default:
+                          FS_Bench_Usage(argv[0]);
+                          return (2);
+                 }
+                 break;
+
+            case 'h':
+            default:
+                 FS_Bench_Usage(argv[0]);
+                 return ((opt == 'h') ? 0 : 2);
+        }
+    }
+    if ((FS_Bench_FileNbr == 0u) ||
+        (FS_Bench_DirNbr  == 0u) ||
+        (FS_Bench_DirNbr  >  100u) ||
+        (fill_pct         >  99u)) {
+        FS_Bench_Usage(argv[0]);
+        return (2);
+    }
+    if ((FS_Bench_DevType != FS_BENCH_DEV_RAM) &&               /* See Notes #13 & #14.                                 */
+        ((mount == DEF_YES) || (pwr_cut_nbr > 0u))) {
+        fprintf(stderr, "-M & -P need the RAM disk\n");
+        FS_Bench_Usage(argv[0]);
+        return (2);
+    }
+    if ((FS_Bench_DevType  != FS_BENCH_DEV_NAND) &&             /* See Note #13.                                        */
+        (FS_Bench_BgProcEn == DEF_YES)) {
+        fprintf(stderr, "-G needs the NAND\n");
+        FS_Bench_Usage(argv[0]);
+        return (2);
+    }
+    if ((FS_Bench_DevType     != FS_BENCH_DEV_NOR) &&           /* See Note #13.                                        */
+        (FS_Bench_WearLevelEn == DEF_YES)) {
+        fprintf(stderr, "-W needs the NOR\n");
+        FS_Bench_Usage(argv[0]);
+        return (2);
+    }
+    FS_Bench_FlashCfg.Size = disk_mb * 1024u * 1024u;
+    FS_Bench_FlashCfg.Seed = FS_Bench_Seed;
+
+    FS_Bench_FileTbl = (FS_BENCH_FILE *)calloc(FS_Bench_FileNbr, sizeof(FS_BENCH_FILE));
+    if (FS_Bench_FileTbl == DEF_NULL) {
+        fprintf(stderr, "out of memory\n");
+        return (2);
+    }
+
+                                                                /* ------------------- TARGET INIT -------------------- */
+    CPU_Init();
+    Mem_Init();
+    if (Sim_OS_Init() != DEF_OK) {
+        fprintf(stderr, "OS init failed\n");
+        return (2);
+    }
+    if (FS_Bench_Setup(disk_mb, cache_kb, cache_mode, journal) != DEF_OK) {
+        return (2);
+    }
+    if (FS_Bench_DevType != FS_BENCH_DEV_RAM) {                 /* Exclude low-level & vol fmt (see Note #13).          */
+        if (FS_Bench_DevType == FS_BENCH_DEV_SD) {
+            Sim_SD_StatReset();
+        } else {
+            Sim_FlashStatReset();
+        }
+        FS_Bench_FlashRdSecBase = FS_Bench_DevRdSecCtr;
+        FS_Bench_FlashWrSecBase = FS_Bench_DevWrSecCtr;
+    }
+    if (FS_Bench_WearLevelEn == DEF_YES) {                      /* Wear before first round (see Note #13).              */
+        FSDev_NOR_WearInfoGet((CPU_CHAR *)FS_Bench_DevNamePtr, &nor_wear, &err);
+        FS_Bench_WearLevelStaticBase = nor_wear.WearLevelStaticCnt;
+        FS_Bench_WearLevelSpreadBase = nor_wear.EraseCntSpread;
+    }
+
+                                                                /* --------------------- WORKLOAD --------------------- */
+    start_us = Sim_TimeUsGet();
+    for (ix = 0u; ix < FS_Bench_FileNbr; ix++) {                /* Create files.                                        */
+        FS_Bench_FileRecreate(ix);
+    }
+    for (ix = 0u; ix < round_nbr; ix++) {
+        FS_Bench_Round();
+        if (FS_Bench_WearLevelEn == DEF_YES) {
+            FS_Bench_NOR_WearLevel();
+        }
+    }
+    elapsed_us = Sim_TimeUsGet() - start_us;
+
+    FS_Bench_Report(elapsed_us);
+    if (journal == DEF_YES) {
+        printf("journal  : committed in groups of up to %u ops or %u octets\n",
+               (unsigned)FS_FAT_CFG_JOURNAL_GROUP_OP_MAX,
+               (unsigned)FS_FAT_CFG_JOURNAL_GROUP_SIZE);
+    }
+
+                                                                /* ---------------------- VERIFY ---------------------- */
+    if (cache_kb > 0u) {                                        /* Chk vol contents after flush ...                     */
+        FSVol_CacheFlush((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+        if (err != FS_ERR_NONE) {
+            FS_Bench_Ctr.ErrCtr++;
+        }
+    }
+    for (ix = 0u; ix < FS_Bench_FileNbr; ix++) {
+        FS_Bench_FileVerify(ix);
+    }
+    if (cache_kb > 0u) {                                        /* ... & when rd back from dev.                         */
+        FSVol_CacheInvalidate((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+        if (err != FS_ERR_NONE) {
+            FS_Bench_Ctr.ErrCtr++;
+        }
+    }
+    for (ix = 0u; ix < FS_Bench_FileNbr; ix++) {
+        FS_Bench_FileVerify(ix);
+    }
+
+    if (stream_kb > 0u) {                                       /* ------------------- STREAMING RD ------------------- */
+        FS_Bench_Stream(stream_kb);
+        if (seek_nbr > 0u) {                                    /* -------------------- RANDOM RD --------------------- */
+            FS_Bench_Seek(stream_kb, seek_nbr);
+        }
+    }
+
+    if (fill_pct > 0u) {                                        /* ----------------- NEARLY FULL VOL ------------------ */
+        FS_Bench_Fill(fill_pct);
+    }
+
+    if (direct_kb > 0u) {                                       /* -------------------- DIRECT I/O -------------------- */
+        FS_Bench_Direct(direct_kb);
+    }
+
+    if (map_kb > 0u) {                                          /* ------------------- MAPPED FILE -------------------- */
+        FS_Bench_Map(map_kb);
+    }
+
+    if (lookup_nbr > 0u) {                                      /* ------------------ LARGE DIR LOOKUP ---------------- */
+        FS_Bench_Lookup(lookup_nbr);
+    }
+
+    if (mount == DEF_YES) {                                     /* ---------------------- MOUNT ----------------------- */
+        FS_Bench_Mount();
+    }
+
+    if (pwr_cut_nbr > 0u) {                                     /* -------------------- POWER CUTS -------------------- */
+        FS_Bench_PwrCut(pwr_cut_nbr);
+    }
+
+    if (FS_Bench_DevType == FS_BENCH_DEV_SD) {                  /* ------------------------ SD ------------------------ */
+        FS_Bench_SD_Report();
+    } else if (FS_Bench_DevType != FS_BENCH_DEV_RAM) {          /* ---------------------- FLASH ----------------------- */
+        FS_Bench_FlashReport();
+        if (FS_Bench_DevType == FS_BENCH_DEV_NOR) {
+            FS_Bench_NOR_Remount();
+        }
+    }
+
+    printf("verify   : %s (%u errors)\n",
+           (FS_Bench_Ctr.ErrCtr == 0u) ? "ok" : "FAILED",
+           (unsigned)FS_Bench_Ctr.ErrCtr);
+
+    Sim_FlashClose();
+    Sim_SD_Close();
+
+    return ((FS_Bench_Ctr.ErrCtr == 0u) ? 0 : 1);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_Bench_DevIO_Hook()
+*
+* Description : Count device accesses (see Note #3).
+*
+* Argument(s) : wr          DEF_YES for a write, DEF_NO for a read.
+*
+*               cnt         Nbr of sectors accessed.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FSDev_RdLocked(), FSDev_WrLocked().
+*
+* Note(s)     : (1) Once the write after which power is cut has completed, the RAM disk contents are saved
+*                   (see 'FS_Bench_PwrCut()').
+*********************************************************************************************************
+*/
+
+void  FS_Bench_DevIO_Hook (CPU_BOOLEAN  wr,
+                           CPU_INT32U   cnt)
+{
+    if (wr == DEF_YES) {
+        FS_Bench_DevWrCtr++;
+        FS_Bench_DevWrSecCtr += cnt;
+        if ((FS_Bench_PwrCutWrNbr != 0u) &&                     /* See Note #1.                                         */
+            (FS_Bench_PwrCutWrNbr == FS_Bench_DevWrCtr)) {
+            Mem_Copy(FS_Bench_PwrCutDiskPtr, FS_Bench_DiskPtr, FS_Bench_DiskSize);
+            FS_Bench_PwrCutWrNbr = 0u;
+        }
+    } else {
+        FS_Bench_DevRdCtr++;
+        FS_Bench_DevRdSecCtr += cnt;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          FS_Bench_Setup()
+*
+* Description : Initialize uC/FS, open & format the device, assign the volume cache & create the
+*               directories.
+*
+* Argument(s) : disk_mb     RAM disk or flash size, in MiB.
+*
+*               cache_kb    Volume cache size, in KiB (0 for no cache).
+*
+*               cache_mode  Volume cache mode.
+*
+*               journal     DEF_YES to open & start the journal (see Note #11).
+*
+* Return(s)   : DEF_OK,   if the file system is ready.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_Bench_Setup (CPU_INT32U   disk_mb,
+                                     CPU_INT32U   cache_kb,
+                                     FS_FLAGS     cache_mode,
+                                     CPU_BOOLEAN  journal)
+{
+    static  FS_CFG   fs_cfg;
+    CPU_INT08U      *p_cache_mem;
+    char             name[FS_BENCH_NAME_LEN_MAX];
+    CPU_INT32U       ix;
+    FS_ERR           err;
+
+
+    fs_cfg.DevCnt     = 1u;
+    fs_cfg.VolCnt     = 1u;
+    fs_cfg.FileCnt    = 4u;
+    fs_cfg.DirCnt     = 2u;
+    fs_cfg.BufCnt     = 8u;
+    fs_cfg.DevDrvCnt  = 1u;
+    fs_cfg.MaxSecSize = FS_BENCH_SEC_SIZE;
+    err = FS_Init(&fs_cfg);
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "FS_Init() failed: %u\n", (unsigned)err);
+        return (DEF_FAIL);
+    }
+
+    if (FS_Bench_DevOpen(disk_mb) != DEF_OK) {
+        return (DEF_FAIL);
+    }
+    FSVol_Open((CPU_CHAR *)FS_BENCH_VOL_NAME, (CPU_CHAR *)FS_Bench_DevNamePtr, 0u, &err);
+    if ((err != FS_ERR_NONE) &&
+        (err != FS_ERR_PARTITION_NOT_FOUND)) {
+        fprintf(stderr, "FSVol_Open() failed: %u\n", (unsigned)err);
+        return (DEF_FAIL);
+    }
+    FSVol_Fmt((CPU_CHAR *)FS_BENCH_VOL_NAME, DEF_NULL, &err);   /* Blank disk : fmt with dflt FAT cfg.                  */
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "FSVol_Fmt() failed: %u\n", (unsigned)err);
+        return (DEF_FAIL);
+    }
+    if ((journal == DEF_YES) &&
+        (FS_Bench_JournalOpen() != DEF_OK)) {
+        return (DEF_FAIL);
+    }
+
+    if (cache_kb > 0u) {
+        p_cache_mem = (CPU_INT08U *)malloc(cache_kb * 1024u);
+        if (p_cache_mem == DEF_NULL) {
+            fprintf(stderr, "out of memory\n");
+            return (DEF_FAIL);
+        }
+        FSVol_CacheAssign((CPU_CHAR *)FS_BENCH_VOL_NAME,
+                          DEF_NULL,                             /* Dflt cache.                                          */
+                          p_cache_mem,
+                          cache_kb * 1024u,
+                          30u,                                  /* 30 % mgmt secs (FAT).                                */
+                          20u,                                  /* 20 % dir  secs.                                      */
+                          cache_mode,
+                         &err);
+        if (err != FS_ERR_NONE) {
+            fprintf(stderr, "FSVol_CacheAssign() failed: %u\n", (unsigned)err);
+            return (DEF_FAIL);
+        }
+    }
+
+    for (ix = 0u; ix < FS_Bench_DirNbr; ix++) {
+        (void)snprintf(name, sizeof(name), FS_BENCH_VOL_NAME "\\D%02u", (unsigned)ix);
+        if (fs_mkdir(name) != 0) {
+            fprintf(stderr, "cannot create '%s'\n", name);
+            return (DEF_FAIL);
+        }
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_Bench_DevOpen()
+*
+* Description : Add the device driver & open the RAM disk, simulated flash or SD card (see Notes #13 & #14).
+*
+* Argument(s) : disk_mb     RAM disk, flash or SD card size, in MiB.
+*
+* Return(s)   : DEF_OK,   if the device is open.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : FS_Bench_Setup().
+*
+* Note(s)     : (1) A new flash image has no low-level format : the device is low-level formatted, then
+*                   its volume is formatted like a blank RAM disk.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_Bench_DevOpen (CPU_INT32U  disk_mb)
+{
+    static  FS_DEV_RAM_CFG           ram_cfg;
+    static  FS_NAND_CFG              nand_cfg;
+    static  FS_NAND_CTRLR_GEN_CFG    nand_ctrlr_cfg;
+    static  FS_NAND_PART_STATIC_CFG  nand_part_cfg;
+    static  FS_DEV_NOR_CFG           nor_cfg;
+    SIM_SD_CFG                       sd_cfg;
+    const   FS_DEV_API              *p_dev_api;
+    void                            *p_dev_cfg;
+    FS_ERR                           err;
+
+
+    switch (FS_Bench_DevType) {
+        case FS_BENCH_DEV_NAND:
+             if (Sim_NAND_Init(&FS_Bench_FlashCfg, &nand_part_cfg) != DEF_OK) {
+                 return (DEF_FAIL);
+             }
+             nand_ctrlr_cfg          =  FS_NAND_CtrlrGen_DfltCfg;
+             nand_ctrlr_cfg.CtrlrExt = &Sim_NAND_ECC;
+             nand_cfg                =  FS_NAND_DfltCfg;
+             nand_cfg.BSPPtr         = &Sim_NAND_BSP;
+             nand_cfg.CtrlrPtr       = (FS_NAND_CTRLR_API *)&FS_NAND_CtrlrGen;
+             nand_cfg.CtrlrCfgPtr    = &nand_ctrlr_cfg;
+             nand_cfg.PartPtr        = (FS_NAND_PART_API  *)&FS_NAND_PartStatic;
+             nand_cfg.PartCfgPtr     = &nand_part_cfg;
+             nand_cfg.SecSize        =  FS_BENCH_SEC_SIZE;
+             nand_cfg.BlkCnt         =  nand_part_cfg.BlkCnt;
+             nand_cfg.BlkIxFirst     =  0u;
+             p_dev_api               = &FS_NAND;
+             p_dev_cfg               = &nand_cfg;
+             break;
+
+
+        case FS_BENCH_DEV_NOR:
+             if (Sim_NOR_Init(&FS_Bench_FlashCfg, &nor_cfg) != DEF_OK) {
+                 return (DEF_FAIL);
+             }
+             p_dev_api = &FSDev_NOR;
+             p_dev_cfg = &nor_cfg;
+             break;
+
+
+        case FS_BENCH_DEV_SD:
+             sd_cfg.Size      = disk_mb * 1024u * 1024u;
+             sd_cfg.HostGapNs = FS_BENCH_SD_HOST_GAP_NS;
+             if (Sim_SD_Init(&sd_cfg) != DEF_OK) {
+                 return (DEF_FAIL);
+             }
+             p_dev_api = &FSDev_SD_SPI;
+             p_dev_cfg =  DEF_NULL;                             /* SD SPI drv has no dev cfg.                           */
+             break;
+
+
+        case FS_BENCH_DEV_RAM:
+        default:
+             ram_cfg.SecSize = FS_BENCH_SEC_SIZE;
+             ram_cfg.Size    = (disk_mb * 1024u * 1024u) / FS_BENCH_SEC_SIZE;
+             ram_cfg.DiskPtr = calloc(ram_cfg.Size, FS_BENCH_SEC_SIZE);
+             if (ram_cfg.DiskPtr == DEF_NULL) {
+                 fprintf(stderr, "out of memory\n");
+                 return (DEF_FAIL);
+             }
+             FS_Bench_DiskPtr  = (CPU_INT08U *)ram_cfg.DiskPtr;
+             FS_Bench_DiskSize = ram_cfg.Size * FS_BENCH_SEC_SIZE;
+             p_dev_api         = &FSDev_RAM;
+             p_dev_cfg         = &ram_cfg;
+             break;
+    }
+
+    FS_DevDrvAdd((FS_DEV_API *)p_dev_api, &err);
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "FS_DevDrvAdd() failed: %u\n", (unsigned)err);
+        return (DEF_FAIL);
+    }
+
+    if ((FS_Bench_DevType == FS_BENCH_DEV_NAND) ||
+        (FS_Bench_DevType == FS_BENCH_DEV_NOR)) {
+        Sim_FlashStatReset();
+    }
+    FSDev_Open((CPU_CHAR *)FS_Bench_DevNamePtr, p_dev_cfg, &err);
+    if ((FS_Bench_DevType == FS_BENCH_DEV_NAND) ||              /* Dev time of low-level mount.                         */
+        (FS_Bench_DevType == FS_BENCH_DEV_NOR)) {
+        FS_Bench_FlashMountNs = Sim_FlashStatGet()->TimeNs;
+    }
+    if (err == FS_ERR_DEV_INVALID_LOW_FMT) {                    /* See Note #1.                                         */
+        if (FS_Bench_DevType == FS_BENCH_DEV_NAND) {
+            FS_NAND_LowFmt((CPU_CHAR *)FS_Bench_DevNamePtr, &err);
+        } else {
+            FSDev_NOR_LowFmt((CPU_CHAR *)FS_Bench_DevNamePtr, &err);
+        }
+        if (err != FS_ERR_NONE) {
+            fprintf(stderr, "low-level format failed: %u\n", (unsigned)err);
+            return (DEF_FAIL);
+        }
+    }
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "FSDev_Open() failed: %u\n", (unsigned)err);
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_Bench_Round()
+*
+* Description : Run one round of the workload (see Note #2).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) With '-G', NAND background processing is done before each op, up to FS_BENCH_BG_STEP_MAX
+*                   steps or until FS_NAND_BgProc() reports no more work (see Note #13).
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Round (void)
+{
+    CPU_INT32U   ix;
+    CPU_INT32U   file_ix;
+    CPU_INT32U   op;
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+    CPU_INT64U   bg_start_ns;
+    CPU_INT32U   step;
+    CPU_BOOLEAN  more;
+#endif
+    FS_ERR       err;
+
+
+    for (ix = 0u; ix < FS_Bench_FileNbr; ix++) {
+        if ((FS_Bench_WrBackAge > 0u) &&                        /* Background writer (see Note #4).                     */
+            ((ix % FS_BENCH_WR_BACK_PERIOD) == 0u)) {
+            FSVol_CacheWrBack((CPU_CHAR *)FS_BENCH_VOL_NAME, FS_Bench_WrBackAge, &err);
+            if ((err != FS_ERR_NONE) && (err != FS_ERR_VOL_NO_CACHE)) {
+                FS_Bench_Ctr.ErrCtr++;
+            }
+        }
+
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+        if (FS_Bench_BgProcEn == DEF_YES) {                     /* Idle task (see Note #1).                             */
+            bg_start_ns = Sim_FlashStatGet()->TimeNs;
+            more        = DEF_YES;
+            for (step = 0u; (step < FS_BENCH_BG_STEP_MAX) && (more == DEF_YES); step++) {
+                more = FS_NAND_BgProc((CPU_CHAR *)FS_Bench_DevNamePtr, &err);
+                if (err != FS_ERR_NONE) {
+                    FS_Bench_Ctr.ErrCtr++;
+                    more = DEF_NO;
+                }
+            }
+            FS_Bench_BgTimeNs += Sim_FlashStatGet()->TimeNs - bg_start_ns;
+        }
+#endif
+
+        file_ix = (CPU_INT32U)rand_r(&FS_Bench_Seed) % FS_Bench_FileNbr;
+        op      = (CPU_INT32U)rand_r(&FS_Bench_Seed) % 100u;
+        if (op < 40u) {
+            FS_Bench_FileAppend(file_ix);
+        } else if (op < 70u) {
+            FS_Bench_FileVerify(file_ix);
+        } else if (op < 80u) {
+            FS_Bench_FileRecreate(file_ix);
+        } else {
+            FS_Bench_FileStat(file_ix);
+        }
+    }
+
+    for (ix = 0u; ix < FS_Bench_DirNbr; ix++) {
+        FS_Bench_DirWalk(ix);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_Bench_FileAppend()
+*
+* Description : Append pattern data to a file.
+*
+* Argument(s) : file_ix     File index.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FS_Bench_Round().
+*
+* Note(s)     : (1) Files reaching FS_BENCH_FILE_SIZE_MAX are re-created instead.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_FileAppend (CPU_INT32U  file_ix)
+{
+    FS_BENCH_FILE  *p_file;
+    FS_FILE        *p_fs_file;
+    char            name[FS_BENCH_NAME_LEN_MAX];
+    CPU_INT32U      len;
+    fs_size_t       len_wr;
+
+
+    p_file = &FS_Bench_FileTbl[file_ix];
+    len    = 1u + ((CPU_INT32U)rand_r(&FS_Bench_Seed) % FS_BENCH_APPEND_MAX);
+    if (p_file->Size + len > FS_BENCH_FILE_SIZE_MAX) {          /* See Note #1.                                         */
+        FS_Bench_FileRecreate(file_ix);
+        return;
+    }
+
+    FS_Bench_NameGet(file_ix, name);
+    p_fs_file = fs_fopen(name, "a");
+    if (p_fs_file == DEF_NULL) {
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    FS_Bench_PatternFill(file_ix, p_file->Size, FS_Bench_Buf, len);
+    len_wr = fs_fwrite(FS_Bench_Buf, 1u, len, p_fs_file);
+    (void)fs_fclose(p_fs_file);
+
+    p_file->Size += (CPU_INT32U)len_wr;
+    if (len_wr != len) {
+        FS_Bench_Ctr.ErrCtr++;
+    }
+    FS_Bench_Ctr.AppendCtr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_Bench_FileRecreate()
+*
+* Description : Delete a file (if it exists) & create it again, empty, with a new content pattern.
+*
+* Argument(s) : file_ix     File index.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main(), FS_Bench_Round(), FS_Bench_FileAppend().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_FileRecreate (CPU_INT32U  file_ix)
+{
+    FS_BENCH_FILE  *p_file;
+    FS_FILE        *p_fs_file;
+    char            name[FS_BENCH_NAME_LEN_MAX];
+
+
+    p_file = &FS_Bench_FileTbl[file_ix];
+    FS_Bench_NameGet(file_ix, name);
+    if (p_file->Gen > 0u) {
+        if (fs_remove(name) != 0) {
+            FS_Bench_Ctr.ErrCtr++;
+        }
+    }
+
+    p_file->Gen++;
+    p_file->Size = 0u;
+    p_fs_file    = fs_fopen(name, "w");
+    if (p_fs_file == DEF_NULL) {
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    (void)fs_fclose(p_fs_file);
+    FS_Bench_Ctr.RecreateCtr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_Bench_FileVerify()
+*
+* Description : Read a file back & check its size & contents.
+*
+* Argument(s) : file_ix     File index.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main(), FS_Bench_Round().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_FileVerify (CPU_INT32U  file_ix)
+{
+    static  CPU_INT08U  exp_buf[FS_BENCH_FILE_SIZE_MAX];
+    FS_BENCH_FILE      *p_file;
+    FS_FILE            *p_fs_file;
+    char                name[FS_BENCH_NAME_LEN_MAX];
+    fs_size_t           len_rd;
+
+
+    p_file = &FS_Bench_FileTbl[file_ix];
+    FS_Bench_NameGet(file_ix, name);
+    p_fs_file = fs_fopen(name, "r");
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "%s: cannot open\n", name);
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    len_rd = fs_fread(FS_Bench_Buf, 1u, sizeof(FS_Bench_Buf), p_fs_file);
+    (void)fs_fclose(p_fs_file);
+
+    FS_Bench_PatternFill(file_ix, 0u, exp_buf, p_file->Size);
+    if ((len_rd != p_file->Size) ||
+        (Mem_Cmp(FS_Bench_Buf, exp_buf, p_file->Size) != DEF_YES)) {
+        fprintf(stderr, "%s: content mismatch (%u octets rd, %u expected)\n",
+                name, (unsigned)len_rd, (unsigned)p_file->Size);
+        FS_Bench_Ctr.ErrCtr++;
+    }
+    FS_Bench_Ctr.RdCtr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_Bench_FileStat()
+*
+* Description : Get information about a file & check its size.
+*
+* Argument(s) : file_ix     File index.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FS_Bench_Round().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_FileStat (CPU_INT32U  file_ix)
+{
+    struct  fs_stat  info;
+    char             name[FS_BENCH_NAME_LEN_MAX];
+
+
+    FS_Bench_NameGet(file_ix, name);
+    if ((fs_stat(name, &info) != 0) ||
+        ((CPU_INT32U)info.st_size != FS_Bench_FileTbl[file_ix].Size)) {
+        FS_Bench_Ctr.ErrCtr++;
+    }
+    FS_Bench_Ctr.StatCtr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_Bench_DirWalk()
+*
+* Description : List a directory & check its nbr of files.
+*
+* Argument(s) : dir_ix      Directory index.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FS_Bench_Round().
+*
+* Note(s)     : (1) File 'ix' is in directory 'ix % FS_Bench_DirNbr'.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_DirWalk (CPU_INT32U  dir_ix)
+{
+    struct  fs_dirent   dirent;
+    struct  fs_dirent  *p_result;
+    FS_DIR             *p_dir;
+    char                name[FS_BENCH_NAME_LEN_MAX];
+    CPU_INT32U          file_cnt;
+    CPU_INT32U          file_cnt_exp;
+
+
+    (void)snprintf(name, sizeof(name), FS_BENCH_VOL_NAME "\\D%02u", (unsigned)dir_ix);
+    p_dir = fs_opendir(name);
+    if (p_dir == DEF_NULL) {
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+
+    file_cnt = 0u;
+    while ((fs_readdir_r(p_dir, &dirent, &p_result) == 0) &&
+           (p_result != DEF_NULL)) {
+        if (dirent.Name[0] != '.') {
+            file_cnt++;
+        }
+    }
+    (void)fs_closedir(p_dir);
+
+    file_cnt_exp = FS_Bench_FileNbr / FS_Bench_DirNbr;          /* See Note #1.                                         */
+    if (dir_ix < FS_Bench_FileNbr % FS_Bench_DirNbr) {
+        file_cnt_exp++;
+    }
+    if (file_cnt != file_cnt_exp) {
+        fprintf(stderr, "%s: %u files listed, %u expected\n", name, (unsigned)file_cnt, (unsigned)file_cnt_exp);
+        FS_Bench_Ctr.ErrCtr++;
+    }
+    FS_Bench_Ctr.DirWalkCtr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_Bench_NameGet()
+*
+* Description : Get full name of a file.
+*
+* Argument(s) : file_ix     File index.
+*
+*               p_name      Pointer to buffer of FS_BENCH_NAME_LEN_MAX characters that will receive name.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Various.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_NameGet (CPU_INT32U   file_ix,
+                                char        *p_name)
+{
+    (void)snprintf(p_name, FS_BENCH_NAME_LEN_MAX, FS_BENCH_VOL_NAME "\\D%02u\\F%05u.DAT",
+                   (unsigned)(file_ix % FS_Bench_DirNbr),
+                   (unsigned)file_ix);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_Bench_PatternFill()
+*
+* Description : Generate expected file contents.
+*
+* Argument(s) : file_ix     File index.
+*
+*               pos         File position of first octet.
+*
+*               p_buf       Pointer to buffer that will receive contents.
+*
+*               len         Nbr of octets.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FS_Bench_FileAppend(), FS_Bench_FileVerify().
+*
+* Note(s)     : (1) Contents depend on the file index, its generation & the file position, so that data
+*                   written to the wrong file, sector or offset is detected.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_PatternFill (CPU_INT32U   file_ix,
+                                    CPU_INT32U   pos,
+                                    CPU_INT08U  *p_buf,
+                                    CPU_INT32U   len)
+{
+    CPU_INT32U  gen;
+    CPU_INT32U  ix;
+
+
+    gen = FS_Bench_FileTbl[file_ix].Gen;
+    for (ix = 0u; ix < len; ix++) {                             /* See Note #1.                                         */
+        p_buf[ix] = (CPU_INT08U)((file_ix * 131u) + (gen * 17u) + ((pos + ix) * 7u) + ((pos + ix) >> 9));
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_Bench_Report()
+*
+* Description : Print workload, device access & cache statistics.
+*
+* Argument(s) : elapsed_us  Workload duration, in us.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Report (CPU_INT64U  elapsed_us)
+{
+    static  const  char  *mode_name[] = { "none", "read", "write-through", "write-back" };
+    FS_VOL_INFO           vol_info;
+    CPU_INT32U            op_cnt;
+    CPU_INT32U            lookup_cnt;
+    FS_ERR                err;
+
+
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "FSVol_Query() failed: %u\n", (unsigned)err);
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+
+    op_cnt = FS_Bench_Ctr.AppendCtr + FS_Bench_Ctr.RdCtr + FS_Bench_Ctr.RecreateCtr
+           + FS_Bench_Ctr.StatCtr   + FS_Bench_Ctr.DirWalkCtr;
+
+    printf("workload : %u files in %u dirs; %u appends, %u reads, %u re-creates, %u stats, %u dir walks\n",
+           (unsigned)FS_Bench_FileNbr,        (unsigned)FS_Bench_DirNbr,
+           (unsigned)FS_Bench_Ctr.AppendCtr,  (unsigned)FS_Bench_Ctr.RdCtr,
+           (unsigned)FS_Bench_Ctr.RecreateCtr, (unsigned)FS_Bench_Ctr.StatCtr,
+           (unsigned)FS_Bench_Ctr.DirWalkCtr);
+    printf("elapsed  : %.1f ms (%.0f ops/s)\n",
+           (double)elapsed_us / 1000.0,
+           (elapsed_us > 0u) ? ((double)op_cnt * 1e6 / (double)elapsed_us) : 0.0);
+    printf("device   : %u rd reqs (%u secs), %u wr reqs (%u secs)\n",
+           (unsigned)FS_Bench_DevRdCtr, (unsigned)FS_Bench_DevRdSecCtr,
+           (unsigned)FS_Bench_DevWrCtr, (unsigned)FS_Bench_DevWrSecCtr);
+
+    if (vol_info.Cache.Mode == FS_VOL_CACHE_MODE_NONE) {
+        printf("cache    : none\n");
+        return;
+    }
+    lookup_cnt = vol_info.Cache.HitCtr + vol_info.Cache.MissCtr;
+    printf("cache    : %s, %u bufs (mgmt %u, dir %u, file %u)\n",
+           mode_name[vol_info.Cache.Mode & 3u],
+           (unsigned)vol_info.Cache.Size,
+           (unsigned)vol_info.Cache.SizeMgmt,
+           (unsigned)vol_info.Cache.SizeDir,
+           (unsigned)vol_info.Cache.SizeFile);
+    printf("           %u hits, %u misses (%.1f %% hit), %u evictions\n",
+           (unsigned)vol_info.Cache.HitCtr,
+           (unsigned)vol_info.Cache.MissCtr,
+           (lookup_cnt > 0u) ? ((double)vol_info.Cache.HitCtr * 100.0 / (double)lookup_cnt) : 0.0,
+           (unsigned)vol_info.Cache.EvictCtr);
+    printf("           %u secs rd ahead, %u then rd\n",
+           (unsigned)vol_info.Cache.RdAheadCtr,
+           (unsigned)vol_info.Cache.RdAheadHitCtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_Bench_FlashReport()
+*
+* Description : Print the simulated flash statistics (see Note #13).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) Throughput is the nbr of octets in sectors read & written by the volume per second of
+*                   simulated device time.  Write amplification is the nbr of octets programmed in the array
+*                   (data, metadata & copies by merges) per octet in sectors written by the volume.
+*
+*               (2) The erase count histogram has FS_BENCH_WEAR_HIST_NBR bins, from 0 to the highest count.
+*
+*               (3) For NOR, the spread & wear leveling moves are reported by the driver, whose erase counts
+*                   exclude the checkpoint blocks.
+*
+*               (4) For NAND, the SUB & RUB merges include those completed in the background; the merge
+*                   steps & erases done by FS_NAND_BgProc() (see 'FS_Bench_Round()  Note #1') are reported
+*                   on their own, with the device time they took & the throughput over the rest of the
+*                   device time.
+*
+*               (5) For NOR with '-W', the steps of FSDev_NOR_WearLevel() that did work are reported, with
+*                   the static moves & spread before the first round & now; the static moves include those
+*                   made in the write path.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_FlashReport (void)
+{
+    const  SIM_FLASH_STAT  *p_stat;
+    CPU_INT32U              hist[FS_BENCH_WEAR_HIST_NBR];
+    CPU_INT64U              host_rd;
+    CPU_INT64U              host_wr;
+    CPU_INT64U              erase_tot;
+    CPU_INT32U              erase_min;
+    CPU_INT32U              erase_max;
+    CPU_INT32U              erase_cnt;
+    CPU_INT32U              blk_ix;
+    CPU_INT32U              bin;
+    double                  time_s;
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+    double                  fg_time_s;
+#endif
+    FS_DEV_NOR_WEAR_INFO    nor_wear;
+    FS_ERR                  err;
+
+
+    p_stat  =  Sim_FlashStatGet();
+    host_rd = (CPU_INT64U)(FS_Bench_DevRdSecCtr - FS_Bench_FlashRdSecBase) * FS_BENCH_SEC_SIZE;
+    host_wr = (CPU_INT64U)(FS_Bench_DevWrSecCtr - FS_Bench_FlashWrSecBase) * FS_BENCH_SEC_SIZE;
+    time_s  = (double)p_stat->TimeNs / 1e9;
+
+    printf("flash    : %s, %u blks (%u factory bad), %.1f ms device time\n",
+           (FS_Bench_DevType == FS_BENCH_DEV_NAND) ? "NAND" : "NOR",
+           (unsigned)p_stat->BlkCnt,
+           (unsigned)p_stat->BadBlkCnt,
+           time_s * 1000.0);
+    printf("           %.2f MiB/s rd, %.2f MiB/s wr, write amplification %.2f\n",  /* See Note #1.                  */
+           (time_s  > 0.0) ? ((double)host_rd / time_s / (1024.0 * 1024.0)) : 0.0,
+           (time_s  > 0.0) ? ((double)host_wr / time_s / (1024.0 * 1024.0)) : 0.0,
+           (host_wr > 0u)  ? ((double)p_stat->PgmOctets / (double)host_wr)  : 0.0);
+    printf("           %u rds, %u pgms, %u erases; %u pgm & %u erase fails, %u pgm violations\n",
+           (unsigned)p_stat->RdCtr,
+           (unsigned)p_stat->PgmCtr,
+           (unsigned)p_stat->EraseCtr,
+           (unsigned)p_stat->PgmFailCtr,
+           (unsigned)p_stat->EraseFailCtr,
+           (unsigned)p_stat->PgmViolCtr);
+
+    if (FS_Bench_DevType == FS_BENCH_DEV_NAND) {
+        printf("           %u cache rds, %u cache pgms (ctrlr: %u multi rds, %u multi wrs, %u cache ops)\n",
+               (unsigned)p_stat->CacheRdCtr,
+               (unsigned)p_stat->CachePgmCtr,
+               (unsigned)FS_NAND_CtrlrGen_CtrsTbl[0]->StatRdMultiCtr,
+               (unsigned)FS_NAND_CtrlrGen_CtrsTbl[0]->StatWrMultiCtr,
+               (unsigned)FS_NAND_CtrlrGen_CtrsTbl[0]->StatCacheOpCtr);
+        printf("           %u bit flips, %u secs corrected, %u uncorrectable\n",
+               (unsigned)p_stat->FlipCtr,
+               (unsigned)p_stat->CorrCtr,
+               (unsigned)p_stat->UncorrCtr);
+        printf("           FTL: %u meta commits, %u SUB merges, %u RUB merges (%u partial), %u refreshes\n",
+               (unsigned)FS_NAND_CtrsTbl[0]->StatMetaSecCommitCtr,
+               (unsigned)FS_NAND_CtrsTbl[0]->StatSUB_MergeCtr,
+               (unsigned)FS_NAND_CtrsTbl[0]->StatRUB_MergeCtr,
+               (unsigned)FS_NAND_CtrsTbl[0]->StatRUB_PartialMergeCtr,
+               (unsigned)FS_NAND_CtrsTbl[0]->StatBlkRefreshCtr);
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+        printf("           bg : %s, %u merge steps, %u blks pre-erased\n",  /* See Note #4.                              */
+               (FS_Bench_BgProcEn == DEF_YES) ? "on" : "off",
+               (unsigned)FS_NAND_CtrsTbl[0]->StatBgMergeStepCtr,
+               (unsigned)FS_NAND_CtrsTbl[0]->StatBgEraseCtr);
+        if (FS_Bench_BgProcEn == DEF_YES) {
+            fg_time_s = (double)(p_stat->TimeNs - FS_Bench_BgTimeNs) / 1e9;
+            printf("                %.1f ms in bg; %.2f MiB/s rd, %.2f MiB/s wr over the rest\n",
+                   (double)FS_Bench_BgTimeNs / 1e6,
+                   (fg_time_s > 0.0) ? ((double)host_rd / fg_time_s / (1024.0 * 1024.0)) : 0.0,
+                   (fg_time_s > 0.0) ? ((double)host_wr / fg_time_s / (1024.0 * 1024.0)) : 0.0);
+        }
+#endif
+    } else {
+        FSDev_NOR_WearInfoGet((CPU_CHAR *)FS_Bench_DevNamePtr, &nor_wear, &err);
+        if (err == FS_ERR_NONE) {                               /* See Note #3.                                         */
+            printf("           FTL: erase cnt spread %u (th %u), %u static & %u active wear level moves, %u%% life left\n",
+                   (unsigned)nor_wear.EraseCntSpread,
+                   (unsigned)nor_wear.EraseCntTh,
+                   (unsigned)nor_wear.WearLevelStaticCnt,
+                   (unsigned)nor_wear.WearLevelActiveCnt,
+                   (unsigned)nor_wear.LifeRemPct);
+            if (FS_Bench_WearLevelEn == DEF_YES) {              /* See Note #5.                                         */
+                printf("           idle : %u wear level steps; static moves %u -> %u, spread %u -> %u\n",
+                       (unsigned)FS_Bench_WearLevelStepCtr,
+                       (unsigned)FS_Bench_WearLevelStaticBase,
+                       (unsigned)nor_wear.WearLevelStaticCnt,
+                       (unsigned)FS_Bench_WearLevelSpreadBase,
+                       (unsigned)nor_wear.EraseCntSpread);
+            }
+        }
+    }
+
+                                                                /* ------------------ ERASE CNT DIST ------------------ */
+    if (p_stat->BlkCnt == 0u) {
+        return;
+    }
+    erase_min = DEF_INT_32U_MAX_VAL;
+    erase_max = 0u;
+    erase_tot = 0u;
+    for (blk_ix = 0u; blk_ix < p_stat->BlkCnt; blk_ix++) {
+        erase_cnt  = p_stat->EraseCntTbl[blk_ix];
+        erase_min  = DEF_MIN(erase_min, erase_cnt);
+        erase_max  = DEF_MAX(erase_max, erase_cnt);
+        erase_tot += erase_cnt;
+    }
+
+    Mem_Clr(hist, sizeof(hist));                                /* See Note #2.                                         */
+    for (blk_ix = 0u; blk_ix < p_stat->BlkCnt; blk_ix++) {
+        bin = (erase_max > 0u) ? ((p_stat->EraseCntTbl[blk_ix] * (FS_BENCH_WEAR_HIST_NBR - 1u)) / erase_max) : 0u;
+        hist[bin]++;
+    }
+    printf("wear     : erase cnt min %u, avg %.1f, max %u; histogram",
+           (unsigned)erase_min,
+           (double)erase_tot / (double)p_stat->BlkCnt,
+           (unsigned)erase_max);
+    for (bin = 0u; bin < FS_BENCH_WEAR_HIST_NBR; bin++) {
+        printf(" %u", (unsigned)hist[bin]);
+    }
+    printf("\n");
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_Bench_SD_Report()
+*
+* Description : Print the simulated SD card statistics (see Note #14).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) Throughput is the nbr of octets in sectors read & written by the volume per second of
+*                   simulated time, which includes the host time between driver accesses.
+*
+*               (2) Hidden busy time elapsed while the host was not in the driver, so that no one waited
+*                   for it.  Violations are commands or tokens sent while the card was busy, which MUST
+*                   be 0.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_SD_Report (void)
+{
+    const  SIM_SD_STAT  *p_stat;
+    CPU_INT64U           host_rd;
+    CPU_INT64U           host_wr;
+    double               time_s;
+
+
+    p_stat  =  Sim_SD_StatGet();
+    host_rd = (CPU_INT64U)(FS_Bench_DevRdSecCtr - FS_Bench_FlashRdSecBase) * FS_BENCH_SEC_SIZE;
+    host_wr = (CPU_INT64U)(FS_Bench_DevWrSecCtr - FS_Bench_FlashWrSecBase) * FS_BENCH_SEC_SIZE;
+    time_s  = (double)p_stat->TimeNs / 1e9;
+
+    printf("sd       : DMA %s, pre-erase min %u blks, busy defer %s; %.1f ms simulated time\n",
+           (FS_DEV_SD_SPI_CFG_DMA_EN        == DEF_ENABLED) ? "on" : "off",
+           (unsigned)FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN,
+           (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED) ? "on" : "off",
+           time_s * 1000.0);
+    printf("           %.2f MiB/s rd, %.2f MiB/s wr; %.1f ms CPU in SPI xfers & polling (%.1f %%)\n",  /* See Note #1.   */
+           (time_s > 0.0) ? ((double)host_rd / time_s / (1024.0 * 1024.0)) : 0.0,
+           (time_s > 0.0) ? ((double)host_wr / time_s / (1024.0 * 1024.0)) : 0.0,
+           (double)p_stat->CpuNs / 1e6,
+           (p_stat->TimeNs > 0u) ? ((double)p_stat->CpuNs * 100.0 / (double)p_stat->TimeNs) : 0.0);
+    printf("           %u cmds, %u blk rds (%u multi), %u blk wrs (%u multi, %u pre-erased), %u DMA xfers\n",
+           (unsigned)p_stat->CmdCtr,
+           (unsigned)p_stat->RdBlkCtr,
+           (unsigned)p_stat->RdMultiCtr,
+           (unsigned)p_stat->WrBlkCtr,
+           (unsigned)p_stat->WrMultiCtr,
+           (unsigned)p_stat->PreEraseCtr,
+           (unsigned)p_stat->DMA_XferCtr);
+    printf("           %.1f ms busy, %.1f ms hidden in host time; %u violations\n",           /* See Note #2.           */
+           (double)p_stat->BusyNs       / 1e6,
+           (double)p_stat->BusyHiddenNs / 1e6,
+           (unsigned)p_stat->ViolCtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_Bench_NOR_Remount()
+*
+* Description : Time a low-level unmount & mount of the NOR, then verify every file (see Note #13).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) The unmount writes a checkpoint of the NOR L2P table, if enabled, from which the
+*                   following mount is done.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_NOR_Remount (void)
+{
+    CPU_INT64U  start_ns;
+    CPU_INT64U  unmount_ns;
+    CPU_INT64U  mount_ns;
+    CPU_INT32U  ix;
+    FS_ERR      err;
+
+
+    FSVol_CacheFlush((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+    if ((err != FS_ERR_NONE) &&
+        (err != FS_ERR_VOL_NO_CACHE)) {
+        FS_Bench_Ctr.ErrCtr++;
+    }
+
+    start_ns   = Sim_FlashStatGet()->TimeNs;                    /* Unmount (see Note #1).                               */
+    FSDev_NOR_LowUnmount((CPU_CHAR *)FS_Bench_DevNamePtr, &err);
+    unmount_ns = Sim_FlashStatGet()->TimeNs - start_ns;
+    if ((err != FS_ERR_NONE) &&                                 /* Refresh of unmounted dev finds no low fmt.           */
+        (err != FS_ERR_DEV_INVALID_LOW_FMT)) {
+        fprintf(stderr, "FSDev_NOR_LowUnmount() failed: %u\n", (unsigned)err);
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+
+    start_ns   = Sim_FlashStatGet()->TimeNs;
+    FSDev_NOR_LowMount((CPU_CHAR *)FS_Bench_DevNamePtr, &err);
+    mount_ns   = Sim_FlashStatGet()->TimeNs - start_ns;
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "FSDev_NOR_LowMount() failed: %u\n", (unsigned)err);
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+
+    printf("mount    : %.1f ms at open, %.1f ms after %.1f ms unmount (NOR device time)\n",
+           (double)FS_Bench_FlashMountNs / 1e6,
+           (double)mount_ns              / 1e6,
+           (double)unmount_ns            / 1e6);
+
+    FSVol_CacheInvalidate((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+    if ((err != FS_ERR_NONE) &&
+        (err != FS_ERR_VOL_NO_CACHE)) {
+        FS_Bench_Ctr.ErrCtr++;
+    }
+    for (ix = 0u; ix < FS_Bench_FileNbr; ix++) {
+        FS_Bench_FileVerify(ix);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_Bench_NOR_WearLevel()
+*
+* Description : Do NOR static wear leveling, as an idle task would between rounds (see Note #13).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) The steps per round are bounded by FS_BENCH_WEAR_LEVEL_STEP_MAX, as an idle task would
+*                   bound the time it spends between writes.
+*
+*               (2) The driver's static move count must not go down across the steps.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_NOR_WearLevel (void)
+{
+#if (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED)
+    FS_DEV_NOR_WEAR_INFO  wear_before;
+    FS_DEV_NOR_WEAR_INFO  wear_after;
+    CPU_INT32U            step;
+    CPU_BOOLEAN           more;
+    FS_ERR                err;
+
+
+    FSDev_NOR_WearInfoGet((CPU_CHAR *)FS_Bench_DevNamePtr, &wear_before, &err);
+    if (err != FS_ERR_NONE) {
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+
+    more = DEF_YES;
+    for (step = 0u; (step < FS_BENCH_WEAR_LEVEL_STEP_MAX) && (more == DEF_YES); step++) {
+        more = FSDev_NOR_WearLevel((CPU_CHAR *)FS_Bench_DevNamePtr, &err);
+        if (err != FS_ERR_NONE) {
+            fprintf(stderr, "NOR wear level failed (err %u)\n", (unsigned)err);
+            FS_Bench_Ctr.ErrCtr++;
+            return;
+        }
+        if (more == DEF_YES) {
+            FS_Bench_WearLevelStepCtr++;
+        }
+    }
+
+    FSDev_NOR_WearInfoGet((CPU_CHAR *)FS_Bench_DevNamePtr, &wear_after, &err);
+    if ((err                           != FS_ERR_NONE) ||   /* See Note #2.                                         */
+        (wear_after.WearLevelStaticCnt <  wear_before.WearLevelStaticCnt)) {
+        fprintf(stderr, "NOR wear info inconsistent after wear level\n");
+        FS_Bench_Ctr.ErrCtr++;
+    }
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_Bench_Stream()
+*
+* Description : Write a large file, then read it back sequentially from the device (see Note #6).
+*
+* Argument(s) : size_kb     File size, in KiB.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) The cache is flushed & invalidated before the file is read, so that every sector is
+*                   either read by the file read itself or read ahead.
+*
+*               (2) On NAND, sectors written or read sequentially through the cache reach the driver as
+*                   runs of consecutive sectors, which it transfers with multi-sector controller
+*                   operations & the controller with cache program/read commands (see 'fs_dev_nand.c
+*                   FS_NAND_RdV()  Note #3').  None being issued means runs are split again somewhere.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Stream (CPU_INT32U  size_kb)
+{
+    static  CPU_INT08U     exp_buf[FS_BENCH_STREAM_RD_SIZE];
+    const  SIM_FLASH_STAT  *p_stat;
+    FS_FILE               *p_fs_file;
+    FS_VOL_INFO            vol_info;
+    CPU_INT32U             size;
+    CPU_INT32U             pos;
+    CPU_INT32U             len;
+    CPU_INT32U             rd_ctr;
+    CPU_INT32U             rd_sec_ctr;
+    CPU_INT32U             ahead_ctr;
+    CPU_INT32U             ahead_hit_ctr;
+    CPU_INT32U             multi_wr_ctr;
+    CPU_INT32U             multi_rd_ctr;
+    CPU_INT32U             cache_pgm_ctr;
+    CPU_INT32U             cache_rd_ctr;
+    CPU_INT32U             cache_op_ctr;
+    CPU_INT64U             start_us;
+    CPU_INT64U             elapsed_us;
+    fs_size_t              len_xfer;
+    FS_ERR                 err;
+
+
+    p_stat        = Sim_FlashStatGet();
+    multi_wr_ctr  = 0u;
+    multi_rd_ctr  = 0u;
+    cache_pgm_ctr = 0u;
+    cache_rd_ctr  = 0u;
+    cache_op_ctr  = 0u;
+    if (FS_Bench_DevType == FS_BENCH_DEV_NAND) {                /* See Note #2.                                         */
+        multi_wr_ctr  = FS_NAND_CtrlrGen_CtrsTbl[0]->StatWrMultiCtr;
+        cache_pgm_ctr = p_stat->CachePgmCtr;
+        cache_op_ctr  = FS_NAND_CtrlrGen_CtrsTbl[0]->StatCacheOpCtr;
+    }
+
+    size      = size_kb * 1024u;
+    p_fs_file = fs_fopen(FS_BENCH_VOL_NAME "\\STREAM.BIN", "w");
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "STREAM.BIN: cannot create\n");
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    for (pos = 0u; pos < size; pos += len) {
+        len = DEF_MIN(size - pos, FS_BENCH_STREAM_WR_SIZE);
+        FS_Bench_StreamFill(pos, FS_Bench_Buf, len);
+        len_xfer = fs_fwrite(FS_Bench_Buf, 1u, len, p_fs_file);
+        if (len_xfer != len) {
+            fprintf(stderr, "STREAM.BIN: wr failed at %u\n", (unsigned)pos);
+            FS_Bench_Ctr.ErrCtr++;
+            (void)fs_fclose(p_fs_file);
+            return;
+        }
+    }
+    (void)fs_fclose(p_fs_file);
+
+    FSVol_CacheFlush((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);      /* See Note #1.                                         */
+    FSVol_CacheInvalidate((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    rd_ctr        = FS_Bench_DevRdCtr;
+    rd_sec_ctr    = FS_Bench_DevRdSecCtr;
+    ahead_ctr     = vol_info.Cache.RdAheadCtr;
+    ahead_hit_ctr = vol_info.Cache.RdAheadHitCtr;
+    if (FS_Bench_DevType == FS_BENCH_DEV_NAND) {
+        multi_wr_ctr  = FS_NAND_CtrlrGen_CtrsTbl[0]->StatWrMultiCtr - multi_wr_ctr;
+        cache_pgm_ctr = p_stat->CachePgmCtr                         - cache_pgm_ctr;
+        multi_rd_ctr  = FS_NAND_CtrlrGen_CtrsTbl[0]->StatRdMultiCtr;
+        cache_rd_ctr  = p_stat->CacheRdCtr;
+    }
+
+    start_us  = Sim_TimeUsGet();
+    p_fs_file = fs_fopen(FS_BENCH_VOL_NAME "\\STREAM.BIN", "r");
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "STREAM.BIN: cannot open\n");
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    for (pos = 0u; pos < size; pos += len) {
+        len      = DEF_MIN(size - pos, FS_BENCH_STREAM_RD_SIZE);
+        len_xfer = fs_fread(FS_Bench_Buf, 1u, len, p_fs_file);
+        FS_Bench_StreamFill(pos, exp_buf, len);
+        if ((len_xfer != len) ||
+            (Mem_Cmp(FS_Bench_Buf, exp_buf, len) != DEF_YES)) {
+            fprintf(stderr, "STREAM.BIN: content mismatch at %u\n", (unsigned)pos);
+            FS_Bench_Ctr.ErrCtr++;
+            break;
+        }
+    }
+    (void)fs_fclose(p_fs_file);
+    elapsed_us = Sim_TimeUsGet() - start_us;
+
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    rd_ctr        = FS_Bench_DevRdCtr    - rd_ctr;
+    rd_sec_ctr    = FS_Bench_DevRdSecCtr - rd_sec_ctr;
+    ahead_ctr     = vol_info.Cache.RdAheadCtr    - ahead_ctr;
+    ahead_hit_ctr = vol_info.Cache.RdAheadHitCtr - ahead_hit_ctr;
+
+    printf("stream   : %u KiB in %u octet rds, %.1f ms (%.1f MiB/s)\n",
+           (unsigned)size_kb,
+           (unsigned)FS_BENCH_STREAM_RD_SIZE,
+           (double)elapsed_us / 1000.0,
+           (elapsed_us > 0u) ? ((double)size / (double)elapsed_us * 1e6 / 1048576.0) : 0.0);
+    printf("           %u rd reqs (%u secs), %u secs rd ahead, %u then rd (%.1f %%)\n",
+           (unsigned)rd_ctr,
+           (unsigned)rd_sec_ctr,
+           (unsigned)ahead_ctr,
+           (unsigned)ahead_hit_ctr,
+           (ahead_ctr > 0u) ? ((double)ahead_hit_ctr * 100.0 / (double)ahead_ctr) : 0.0);
+
+    if (FS_Bench_DevType == FS_BENCH_DEV_NAND) {                /* See Note #2.                                         */
+        multi_rd_ctr = FS_NAND_CtrlrGen_CtrsTbl[0]->StatRdMultiCtr - multi_rd_ctr;
+        cache_rd_ctr = p_stat->CacheRdCtr                          - cache_rd_ctr;
+        cache_op_ctr = FS_NAND_CtrlrGen_CtrsTbl[0]->StatCacheOpCtr - cache_op_ctr;
+        printf("           NAND: wr %u multi wrs, %u cache pgms; rd %u multi rds, %u cache rds; %u cache ops\n",
+               (unsigned)multi_wr_ctr,
+               (unsigned)cache_pgm_ctr,
+               (unsigned)multi_rd_ctr,
+               (unsigned)cache_rd_ctr,
+               (unsigned)cache_op_ctr);
+        if ((multi_wr_ctr  == 0u) ||
+            (cache_pgm_ctr == 0u) ||
+            (multi_rd_ctr  == 0u) ||
+            (cache_rd_ctr  == 0u) ||
+            (cache_op_ctr  == 0u)) {
+            fprintf(stderr, "STREAM.BIN: no multi-sec or cache NAND ops\n");
+            FS_Bench_Ctr.ErrCtr++;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           FS_Bench_Seek()
+*
+* Description : Read the sequential read test file at random positions (see Note #7).
+*
+* Argument(s) : size_kb     File size, in KiB.
+*
+*               seek_nbr    Nbr of seek & reads.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) Cache lookups, rather than device reads, are counted : once the file's FAT sectors
+*                   are cached, following its cluster chain costs lookups but no device access.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Seek (CPU_INT32U  size_kb,
+                             CPU_INT32U  seek_nbr)
+{
+    static  CPU_INT08U  exp_buf[FS_BENCH_STREAM_RD_SIZE];
+    FS_FILE            *p_fs_file;
+    FS_VOL_INFO         vol_info;
+    CPU_INT32U          size;
+    CPU_INT32U          pos;
+    CPU_INT32U          len;
+    CPU_INT32U          ix;
+    CPU_INT32U          rd_ctr;
+    CPU_INT32U          lookup_ctr;
+    CPU_INT64U          start_us;
+    CPU_INT64U          elapsed_us;
+    fs_size_t           len_xfer;
+    FS_ERR              err;
+
+
+    size      = size_kb * 1024u;
+    p_fs_file = fs_fopen(FS_BENCH_VOL_NAME "\\STREAM.BIN", "r");
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "STREAM.BIN: cannot open\n");
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    rd_ctr     = FS_Bench_DevRdCtr;
+                                                                /* See Note #1.                                         */
+    lookup_ctr = vol_info.Cache.HitCtr + vol_info.Cache.MissCtr;
+
+    start_us = Sim_TimeUsGet();
+    for (ix = 0u; ix < seek_nbr; ix++) {
+        pos = (CPU_INT32U)rand_r(&FS_Bench_Seed) % size;
+        len = DEF_MIN(size - pos, FS_BENCH_STREAM_RD_SIZE);
+        if (fs_fseek(p_fs_file, (long)pos, SEEK_SET) != 0) {
+            fprintf(stderr, "STREAM.BIN: seek failed at %u\n", (unsigned)pos);
+            FS_Bench_Ctr.ErrCtr++;
+            break;
+        }
+        len_xfer = fs_fread(FS_Bench_Buf, 1u, len, p_fs_file);
+        FS_Bench_StreamFill(pos, exp_buf, len);
+        if ((len_xfer != len) ||
+            (Mem_Cmp(FS_Bench_Buf, exp_buf, len) != DEF_YES)) {
+            fprintf(stderr, "STREAM.BIN: content mismatch at %u\n", (unsigned)pos);
+            FS_Bench_Ctr.ErrCtr++;
+            break;
+        }
+    }
+    elapsed_us = Sim_TimeUsGet() - start_us;
+    (void)fs_fclose(p_fs_file);
+
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    rd_ctr     = FS_Bench_DevRdCtr - rd_ctr;
+    lookup_ctr = vol_info.Cache.HitCtr + vol_info.Cache.MissCtr - lookup_ctr;
+
+    printf("seek     : %u random seek & %u octet rds, %.1f ms (%.2f us/op)\n",
+           (unsigned)seek_nbr,
+           (unsigned)FS_BENCH_STREAM_RD_SIZE,
+           (double)elapsed_us / 1000.0,
+           (double)elapsed_us / (double)seek_nbr);
+    printf("           %u rd reqs, %u cache lookups (%.1f per op)\n",
+           (unsigned)rd_ctr,
+           (unsigned)lookup_ctr,
+           (double)lookup_ctr / (double)seek_nbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           FS_Bench_Fill()
+*
+* Description : Fill the volume, free every other file & write a large file in the holes (see Note #8).
+*
+* Argument(s) : pct         Percentage of volume to fill.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) The large file takes half the free space left & is written & read back in
+*                   FS_BENCH_FILL_WR_SIZE octet requests.  Its contents are verified, & device reads counted,
+*                   after the cache is flushed & invalidated.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Fill (CPU_INT32U  pct)
+{
+    static  CPU_INT08U  exp_buf[FS_BENCH_FILL_WR_SIZE];
+    char                name[FS_BENCH_NAME_LEN_MAX];
+    FS_FILE            *p_fs_file;
+    FS_VOL_INFO         vol_info;
+    CPU_INT32U          file_nbr;
+    CPU_INT32U          ix;
+    CPU_INT32U          size;
+    CPU_INT32U          pos;
+    CPU_INT32U          len;
+    CPU_INT32U          rd_ctr;
+    CPU_INT32U          rd_back_ctr;
+    CPU_INT32U          lookup_ctr;
+    CPU_INT64U          start_us;
+    CPU_INT64U          elapsed_us;
+    fs_size_t           len_xfer;
+    FS_ERR              err;
+
+
+                                                                /* -------------------- FILL VOL ---------------------- */
+    FS_Bench_StreamFill(0u, FS_Bench_Buf, FS_BENCH_FILL_FILE_SIZE);
+    file_nbr = 0u;
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    while ((err == FS_ERR_NONE) &&
+           ((CPU_INT64U)vol_info.VolFreeSecCnt * 100u > (CPU_INT64U)vol_info.VolTotSecCnt * (100u - pct))) {
+        if ((file_nbr % FS_BENCH_FILL_DIR_FILE_NBR) == 0u) {
+            (void)snprintf(name, sizeof(name), FS_BENCH_VOL_NAME "\\FILL%03u",
+                           (unsigned)(file_nbr / FS_BENCH_FILL_DIR_FILE_NBR));
+            if (fs_mkdir(name) != 0) {
+                break;
+            }
+        }
+        (void)snprintf(name, sizeof(name), FS_BENCH_VOL_NAME "\\FILL%03u\\F%05u.DAT",
+                       (unsigned)(file_nbr / FS_BENCH_FILL_DIR_FILE_NBR),
+                       (unsigned)file_nbr);
+        p_fs_file = fs_fopen(name, "w");
+        if (p_fs_file == DEF_NULL) {
+            break;
+        }
+        len_xfer = fs_fwrite(FS_Bench_Buf, 1u, FS_BENCH_FILL_FILE_SIZE, p_fs_file);
+        (void)fs_fclose(p_fs_file);
+        file_nbr++;
+        if (len_xfer != FS_BENCH_FILL_FILE_SIZE) {
+            break;
+        }
+        FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    }
+
+    for (ix = 0u; ix < file_nbr; ix += 2u) {                    /* ------------------ FREE HALF FILES ----------------- */
+        (void)snprintf(name, sizeof(name), FS_BENCH_VOL_NAME "\\FILL%03u\\F%05u.DAT",
+                       (unsigned)(ix / FS_BENCH_FILL_DIR_FILE_NBR),
+                       (unsigned)ix);
+        if (fs_remove(name) != 0) {
+            fprintf(stderr, "%s: cannot remove\n", name);
+            FS_Bench_Ctr.ErrCtr++;
+            return;
+        }
+    }
+
+                                                                /* --------------- WR LARGE FILE IN HOLES ------------- */
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    size = (CPU_INT32U)(((CPU_INT64U)vol_info.VolFreeSecCnt * FS_BENCH_SEC_SIZE / 2u) & ~(CPU_INT64U)(FS_BENCH_FILL_WR_SIZE - 1u));
+    rd_ctr     = FS_Bench_DevRdCtr;
+    lookup_ctr = vol_info.Cache.HitCtr + vol_info.Cache.MissCtr;
+
+    start_us  = Sim_TimeUsGet();
+    p_fs_file = fs_fopen(FS_BENCH_VOL_NAME "\\FILLED.BIN", "w");
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "FILLED.BIN: cannot create\n");
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    for (pos = 0u; pos < size; pos += len) {
+        len = DEF_MIN(size - pos, FS_BENCH_FILL_WR_SIZE);
+        FS_Bench_StreamFill(pos, FS_Bench_Buf, len);
+        len_xfer = fs_fwrite(FS_Bench_Buf, 1u, len, p_fs_file);
+        if (len_xfer != len) {
+            fprintf(stderr, "FILLED.BIN: wr failed at %u\n", (unsigned)pos);
+            FS_Bench_Ctr.ErrCtr++;
+            break;
+        }
+    }
+    (void)fs_fclose(p_fs_file);
+    elapsed_us = Sim_TimeUsGet() - start_us;
+
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    rd_ctr     = FS_Bench_DevRdCtr - rd_ctr;
+    lookup_ctr = vol_info.Cache.HitCtr + vol_info.Cache.MissCtr - lookup_ctr;
+
+    printf("fill     : %u %% full, %u of %u %u octet files freed\n",
+           (unsigned)pct,
+           (unsigned)((file_nbr + 1u) / 2u),
+           (unsigned)file_nbr,
+           (unsigned)FS_BENCH_FILL_FILE_SIZE);
+    printf("           %u KiB wr in holes, %.1f ms, %u rd reqs, %u cache lookups\n",
+           (unsigned)(size / 1024u),
+           (double)elapsed_us / 1000.0,
+           (unsigned)rd_ctr,
+           (unsigned)lookup_ctr);
+
+                                                                /* ------------------ VERIFY (Note #1) ---------------- */
+    FSVol_CacheFlush((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+    FSVol_CacheInvalidate((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+    rd_back_ctr = FS_Bench_DevRdCtr;
+    p_fs_file   = fs_fopen(FS_BENCH_VOL_NAME "\\FILLED.BIN", "r");
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "FILLED.BIN: cannot open\n");
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    for (pos = 0u; pos < size; pos += len) {
+        len      = DEF_MIN(size - pos, FS_BENCH_FILL_WR_SIZE);
+        len_xfer = fs_fread(FS_Bench_Buf, 1u, len, p_fs_file);
+        FS_Bench_StreamFill(pos, exp_buf, len);
+        if ((len_xfer != len) ||
+            (Mem_Cmp(FS_Bench_Buf, exp_buf, len) != DEF_YES)) {
+            fprintf(stderr, "FILLED.BIN: content mismatch at %u\n", (unsigned)pos);
+            FS_Bench_Ctr.ErrCtr++;
+            break;
+        }
+    }
+    (void)fs_fclose(p_fs_file);
+    rd_back_ctr = FS_Bench_DevRdCtr - rd_back_ctr;
+
+    printf("           rd back in %u octet rds : %u rd reqs\n",
+           (unsigned)FS_BENCH_FILL_WR_SIZE,
+           (unsigned)rd_back_ctr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_Bench_Direct()
+*
+* Description : Write & read back a large file through the volume cache, then in direct mode (see
+*               Note #15).
+*
+* Argument(s) : size_kb     File size, in KiB.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) Cache evictions & sectors transferred around the cache are read with FSVol_Query().
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Direct (CPU_INT32U  size_kb)
+{
+    FS_VOL_INFO   vol_info;
+    CPU_INT32U    size;
+    CPU_INT32U    pass;
+    CPU_INT32U    rd_ctr;
+    CPU_INT32U    wr_ctr;
+    CPU_INT32U    evict_ctr;
+    CPU_INT32U    direct_ctr;
+    CPU_INT64U    start_us;
+    CPU_INT64U    elapsed_us;
+    CPU_BOOLEAN   direct;
+    CPU_BOOLEAN   ok;
+    FS_ERR        err;
+
+
+    size = size_kb * 1024u;
+    if (size < FS_BENCH_DIRECT_PATCH_SIZE) {
+        size = FS_BENCH_DIRECT_PATCH_SIZE;
+    }
+    for (pass = 0u; pass < 2u; pass++) {
+        direct = (pass == 0u) ? DEF_NO : DEF_YES;
+
+        FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+        rd_ctr     = FS_Bench_DevRdCtr;
+        wr_ctr     = FS_Bench_DevWrCtr;
+        evict_ctr  = vol_info.Cache.EvictCtr;
+        direct_ctr = vol_info.Cache.DirectCtr;
+
+        start_us   = Sim_TimeUsGet();
+        ok         = FS_Bench_DirectPass(size, direct);
+        elapsed_us = Sim_TimeUsGet() - start_us;
+        if (ok != DEF_OK) {
+            FS_Bench_Ctr.ErrCtr++;
+            return;
+        }
+
+        FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+        printf("%s : %u KiB wr & rd in %u octet reqs, %.1f ms (%.1f MiB/s)\n",
+               (direct == DEF_YES) ? "direct  " : "cached  ",
+               (unsigned)size_kb,
+               (unsigned)FS_BENCH_DIRECT_XFER_SIZE,
+               (double)elapsed_us / 1000.0,
+               (elapsed_us > 0u) ? ((double)size * 2.0 / (double)elapsed_us * 1e6 / 1048576.0) : 0.0);
+        printf("           %u wr reqs, %u rd reqs, %u secs evicted, %u secs around cache\n",
+               (unsigned)(FS_Bench_DevWrCtr - wr_ctr),
+               (unsigned)(FS_Bench_DevRdCtr - rd_ctr),
+               (unsigned)(vol_info.Cache.EvictCtr  - evict_ctr),
+               (unsigned)(vol_info.Cache.DirectCtr - direct_ctr));
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_Bench_DirectPass()
+*
+* Description : Write, patch & read back the direct I/O test file.
+*
+* Argument(s) : size        File size, in octets.
+*
+*               direct      DEF_YES, if the file is written & read in direct mode.
+*                           DEF_NO,  otherwise.
+*
+* Return(s)   : DEF_OK,   if the file was written & read back correctly.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : FS_Bench_Direct().
+*
+* Note(s)     : (1) The patch is written through the cache; its octets are the complement of the pattern.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_Bench_DirectPass (CPU_INT32U   size,
+                                          CPU_BOOLEAN  direct)
+{
+    static  CPU_INT08U  exp_buf[FS_BENCH_DIRECT_XFER_SIZE];
+    FS_FILE            *p_fs_file;
+    FS_FLAGS            mode;
+    CPU_INT32U          pos;
+    CPU_INT32U          len;
+    CPU_INT32U          patch_pos;
+    CPU_INT32U          ix;
+    CPU_SIZE_T          len_xfer;
+    FS_ERR              err;
+
+
+    mode = (direct == DEF_YES) ? FS_FILE_ACCESS_MODE_DIRECT : FS_FILE_ACCESS_MODE_NONE;
+
+                                                                /* ---------------------- WR FILE --------------------- */
+    p_fs_file = FSFile_Open((CPU_CHAR *)FS_BENCH_VOL_NAME "\\DIRECT.BIN",
+                            FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_CREATE | FS_FILE_ACCESS_MODE_TRUNCATE | mode,
+                           &err);
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "DIRECT.BIN: cannot create\n");
+        return (DEF_FAIL);
+    }
+    for (pos = 0u; pos < size; pos += len) {
+        len = DEF_MIN(size - pos, FS_BENCH_DIRECT_XFER_SIZE);
+        FS_Bench_StreamFill(pos, FS_Bench_Buf, len);
+        len_xfer = FSFile_Wr(p_fs_file, FS_Bench_Buf, len, &err);
+        if ((err != FS_ERR_NONE) || (len_xfer != len)) {
+            fprintf(stderr, "DIRECT.BIN: wr failed at %u\n", (unsigned)pos);
+            FSFile_Close(p_fs_file, &err);
+            return (DEF_FAIL);
+        }
+    }
+    FSFile_Close(p_fs_file, &err);
+
+                                                                /* --------------------- PATCH FILE ------------------- */
+    patch_pos = DEF_MIN(size / 2u + 100u, size - FS_BENCH_DIRECT_PATCH_SIZE);
+    p_fs_file = fs_fopen(FS_BENCH_VOL_NAME "\\DIRECT.BIN", "r+");
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "DIRECT.BIN: cannot open\n");
+        return (DEF_FAIL);
+    }
+    FS_Bench_StreamFill(patch_pos, FS_Bench_Buf, FS_BENCH_DIRECT_PATCH_SIZE);
+    for (ix = 0u; ix < FS_BENCH_DIRECT_PATCH_SIZE; ix++) {      /* See Note #1.                                         */
+        FS_Bench_Buf[ix] = (CPU_INT08U)~FS_Bench_Buf[ix];
+    }
+    if ((fs_fseek(p_fs_file, (long)patch_pos, SEEK_SET) != 0) ||
+        (fs_fwrite(FS_Bench_Buf, 1u, FS_BENCH_DIRECT_PATCH_SIZE, p_fs_file) != FS_BENCH_DIRECT_PATCH_SIZE)) {
+        fprintf(stderr, "DIRECT.BIN: patch failed\n");
+        (void)fs_fclose(p_fs_file);
+        return (DEF_FAIL);
+    }
+    (void)fs_fclose(p_fs_file);
+
+                                                                /* ---------------------- RD FILE --------------------- */
+    p_fs_file = FSFile_Open((CPU_CHAR *)FS_BENCH_VOL_NAME "\\DIRECT.BIN",
+                            FS_FILE_ACCESS_MODE_RD | mode,
+                           &err);
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "DIRECT.BIN: cannot open\n");
+        return (DEF_FAIL);
+    }
+    for (pos = 0u; pos < size; pos += len) {
+        len      = DEF_MIN(size - pos, FS_BENCH_DIRECT_XFER_SIZE);
+        len_xfer = FSFile_Rd(p_fs_file, FS_Bench_Buf, len, &err);
+        FS_Bench_StreamFill(pos, exp_buf, len);
+        for (ix = 0u; ix < len; ix++) {
+            if ((pos + ix >= patch_pos) &&
+                (pos + ix <  patch_pos + FS_BENCH_DIRECT_PATCH_SIZE)) {
+                exp_buf[ix] = (CPU_INT08U)~exp_buf[ix];
+            }
+        }
+        if ((err      != FS_ERR_NONE) ||
+            (len_xfer != len)         ||
+            (Mem_Cmp(FS_Bench_Buf, exp_buf, len) != DEF_YES)) {
+            fprintf(stderr, "DIRECT.BIN: content mismatch at %u\n", (unsigned)pos);
+            FSFile_Close(p_fs_file, &err);
+            return (DEF_FAIL);
+        }
+    }
+    FSFile_Close(p_fs_file, &err);
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            FS_Bench_Map()
+*
+* Description : Write a file & walk it with FSFile_Map(), comparing the data in place (see Note #16).
+*
+* Argument(s) : size_kb     File size, in KiB.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) The file is written through the volume cache & not flushed : in a write back cache,
+*                   FSFile_Map() must write back its dirty sectors before mapping them.
+*
+*               (2) The whole file is requested, without a copy buffer, so that each call maps a whole
+*                   extent; the last call, at the end of the file, maps nothing & sets the EOF indicator.
+*                   If the device cannot map, the call is repeated with a copy buffer.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Map (CPU_INT32U  size_kb)
+{
+    static  CPU_INT08U  exp_buf[FS_BENCH_DIRECT_XFER_SIZE];
+    FS_FILE            *p_fs_file;
+    void               *p_data;
+    CPU_INT08U         *p_data_08;
+    CPU_INT32U          size;
+    CPU_INT32U          pos;
+    CPU_INT32U          len;
+    CPU_INT32U          off;
+    CPU_INT32U          cmp_len;
+    CPU_INT32U          extent_ctr;
+    CPU_INT32U          map_octets;
+    CPU_INT32U          copy_octets;
+    CPU_INT32U          rd_ctr;
+    CPU_INT64U          start_us;
+    CPU_INT64U          elapsed_us;
+    CPU_SIZE_T          len_xfer;
+    FS_ERR              err;
+
+
+    size = size_kb * 1024u;
+                                                                /* ------------- WR FILE (SEE NOTE #1) --------------- */
+    p_fs_file = FSFile_Open((CPU_CHAR *)FS_BENCH_VOL_NAME "\\MAP.BIN",
+                            FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_CREATE | FS_FILE_ACCESS_MODE_TRUNCATE,
+                           &err);
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "MAP.BIN: cannot create\n");
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    for (pos = 0u; pos < size; pos += len) {
+        len = DEF_MIN(size - pos, FS_BENCH_DIRECT_XFER_SIZE);
+        FS_Bench_StreamFill(pos, FS_Bench_Buf, len);
+        len_xfer = FSFile_Wr(p_fs_file, FS_Bench_Buf, len, &err);
+        if ((err != FS_ERR_NONE) || (len_xfer != len)) {
+            fprintf(stderr, "MAP.BIN: wr failed at %u\n", (unsigned)pos);
+            FSFile_Close(p_fs_file, &err);
+            FS_Bench_Ctr.ErrCtr++;
+            return;
+        }
+    }
+    FSFile_Close(p_fs_file, &err);
+
+                                                                /* ---------------------- MAP FILE -------------------- */
+    p_fs_file = FSFile_Open((CPU_CHAR *)FS_BENCH_VOL_NAME "\\MAP.BIN",
+                            FS_FILE_ACCESS_MODE_RD,
+                           &err);
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "MAP.BIN: cannot open\n");
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+
+    extent_ctr  = 0u;
+    map_octets  = 0u;
+    copy_octets = 0u;
+    rd_ctr      = FS_Bench_DevRdCtr;
+    start_us    = Sim_TimeUsGet();
+    pos         = 0u;
+    for (;;) {
+        len_xfer = FSFile_Map(p_fs_file, DEF_NULL, size, &p_data, &err);
+        if (err == FS_ERR_DEV_INVALID_IO_CTRL) {                /* See Note #2.                                         */
+            len_xfer = FSFile_Map(p_fs_file,
+                                  FS_Bench_Buf,
+                                  FS_BENCH_DIRECT_XFER_SIZE,
+                                 &p_data,
+                                 &err);
+            copy_octets += (CPU_INT32U)len_xfer;
+        } else {
+            map_octets  += (CPU_INT32U)len_xfer;
+            extent_ctr  += (len_xfer > 0u) ? 1u : 0u;
+        }
+        if ((err != FS_ERR_NONE) || (len_xfer == 0u)) {
+            break;
+        }
+
+        len       = (CPU_INT32U)len_xfer;
+        p_data_08 = (CPU_INT08U *)p_data;
+        for (off = 0u; off < len; off += cmp_len) {             /* Cmp data in place.                                   */
+            cmp_len = DEF_MIN(len - off, FS_BENCH_DIRECT_XFER_SIZE);
+            FS_Bench_StreamFill(pos + off, exp_buf, cmp_len);
+            if (Mem_Cmp(p_data_08 + off, exp_buf, cmp_len) != DEF_YES) {
+                fprintf(stderr, "MAP.BIN: content mismatch at %u\n", (unsigned)(pos + off));
+                FSFile_Close(p_fs_file, &err);
+                FS_Bench_Ctr.ErrCtr++;
+                return;
+            }
+        }
+        pos += len;
+    }
+    elapsed_us = Sim_TimeUsGet() - start_us;
+
+    if ((err != FS_ERR_NONE)                          ||
+        (pos != size)                                 ||
+        (FSFile_IsEOF(p_fs_file, &err) != DEF_YES)) {
+        fprintf(stderr, "MAP.BIN: map failed at %u (err %u)\n", (unsigned)pos, (unsigned)err);
+        FS_Bench_Ctr.ErrCtr++;
+    }
+    FSFile_Close(p_fs_file, &err);
+
+    printf("map      : %u KiB in %u extents, %.1f ms\n",
+           (unsigned)size_kb,
+           (unsigned)extent_ctr,
+           (double)elapsed_us / 1000.0);
+    printf("           %u octets mapped, %u copied, %u rd reqs\n",
+           (unsigned)map_octets,
+           (unsigned)copy_octets,
+           (unsigned)(FS_Bench_DevRdCtr - rd_ctr));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_Bench_Mount()
+*
+* Description : Re-open the volume after a clean close & after a simulated dirty shutdown, timing the mount
+*               & first volume query (see Note #9).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) A FAT12/16 volume has no FSINFO sector : its free clusters are counted after every mount.
+*
+*               (2) The free cluster count is then obtained in the background, FS_BENCH_MOUNT_SCAN_NBR FAT
+*                   entries at a time, a file being created & an older one deleted between steps.  Once
+*                   these files are deleted, the count must match the one found by the blocking query.
+*
+*               (3) The volume cache is deleted when the volume is closed : mounts are timed without it.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Mount (void)
+{
+    char          name[FS_BENCH_NAME_LEN_MAX];
+    FS_FILE      *p_fs_file;
+    FS_VOL_INFO   vol_info;
+    CPU_BOOLEAN   done;
+    CPU_INT32U    free_sec_clean;
+    CPU_INT32U    free_sec_dirty;
+    CPU_INT32U    step_nbr;
+    CPU_INT32U    ix;
+    CPU_INT64U    start_us;
+    CPU_INT64U    step_us;
+    CPU_INT64U    step_max_us;
+    FS_ERR        err;
+
+
+    printf("mount    : %s, no cache\n",
+           (MEM_VAL_GET_INT16U_LITTLE(FS_Bench_DiskPtr + 22u) == 0u) ? "FAT32" : "FAT12/16, no FSINFO");
+
+                                                                /* ------------------ CLEAN & DIRTY ------------------- */
+    if (FS_Bench_MountTime(DEF_NO,  &free_sec_clean) != DEF_OK) {
+        return;
+    }
+    if (FS_Bench_MountTime(DEF_YES, &free_sec_dirty) != DEF_OK) {
+        return;
+    }
+    if (free_sec_dirty != free_sec_clean) {
+        fprintf(stderr, "mount: free secs %u after clean close, %u counted\n",
+                (unsigned)free_sec_clean,
+                (unsigned)free_sec_dirty);
+        FS_Bench_Ctr.ErrCtr++;
+    }
+
+                                                                /* -------------- BACKGROUND FREE CNT ----------------- */
+    if (FS_Bench_Remount(DEF_YES) != DEF_OK) {
+        return;
+    }
+    FS_Bench_StreamFill(0u, FS_Bench_Buf, FS_BENCH_STREAM_WR_SIZE);
+    step_nbr    = 0u;
+    step_max_us = 0u;
+    done        = DEF_NO;
+    while (done == DEF_NO) {
+        start_us = Sim_TimeUsGet();
+        done     = FS_FAT_VolFreeCntScan((CPU_CHAR *)FS_BENCH_VOL_NAME, FS_BENCH_MOUNT_SCAN_NBR, &err);
+        step_us  = Sim_TimeUsGet() - start_us;
+        if (err != FS_ERR_NONE) {
+            fprintf(stderr, "FS_FAT_VolFreeCntScan() failed: %u\n", (unsigned)err);
+            FS_Bench_Ctr.ErrCtr++;
+            return;
+        }
+        step_max_us = DEF_MAX(step_max_us, step_us);
+        step_nbr++;
+                                                                /* File accesses between steps (see Note #2).           */
+        (void)snprintf(name, sizeof(name), FS_BENCH_VOL_NAME "\\SCAN%04u.TMP", (unsigned)step_nbr);
+        p_fs_file = fs_fopen(name, "w");
+        if (p_fs_file != DEF_NULL) {
+            (void)fs_fwrite(FS_Bench_Buf, 1u, FS_BENCH_STREAM_WR_SIZE, p_fs_file);
+            (void)fs_fclose(p_fs_file);
+        }
+        if (step_nbr > 2u) {
+            (void)snprintf(name, sizeof(name), FS_BENCH_VOL_NAME "\\SCAN%04u.TMP", (unsigned)(step_nbr - 2u));
+            (void)fs_remove(name);
+        }
+    }
+    for (ix = DEF_MAX(step_nbr, 2u) - 1u; ix <= step_nbr; ix++) {
+        (void)snprintf(name, sizeof(name), FS_BENCH_VOL_NAME "\\SCAN%04u.TMP", (unsigned)ix);
+        (void)fs_remove(name);
+    }
+
+    start_us = Sim_TimeUsGet();
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    step_us  = Sim_TimeUsGet() - start_us;
+    if ((err != FS_ERR_NONE) ||
+        (vol_info.VolFreeSecCnt != free_sec_clean)) {
+        fprintf(stderr, "mount: free secs %u after background count, %u expected\n",
+                (unsigned)vol_info.VolFreeSecCnt,
+                (unsigned)free_sec_clean);
+        FS_Bench_Ctr.ErrCtr++;
+    }
+
+    printf("           background : %u steps of %u entries, max %.2f ms per step, then query %.2f ms\n",
+           (unsigned)step_nbr,
+           (unsigned)FS_BENCH_MOUNT_SCAN_NBR,
+           (double)step_max_us / 1000.0,
+           (double)step_us     / 1000.0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_Bench_MountTime()
+*
+* Description : Close & re-open the volume, timing the mount & first volume query.
+*
+* Argument(s) : dirty           DEF_YES to simulate a dirty shutdown (see 'FS_Bench_Remount()').
+*
+*               p_free_sec      Pointer to variable that will receive the free sector count.
+*
+* Return(s)   : DEF_OK,   if the volume was re-opened & queried.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : FS_Bench_Mount().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_Bench_MountTime (CPU_BOOLEAN   dirty,
+                                         CPU_INT32U   *p_free_sec)
+{
+    FS_VOL_INFO   vol_info;
+    CPU_INT32U    rd_ctr;
+    CPU_INT64U    start_us;
+    CPU_INT64U    open_us;
+    CPU_INT64U    query_us;
+    FS_ERR        err;
+
+
+    rd_ctr   = FS_Bench_DevRdCtr;
+    start_us = Sim_TimeUsGet();
+    if (FS_Bench_Remount(dirty) != DEF_OK) {
+        return (DEF_FAIL);
+    }
+    open_us  = Sim_TimeUsGet() - start_us;
+
+    start_us = Sim_TimeUsGet();
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    query_us = Sim_TimeUsGet() - start_us;
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "FSVol_Query() failed: %u\n", (unsigned)err);
+        FS_Bench_Ctr.ErrCtr++;
+        return (DEF_FAIL);
+    }
+    rd_ctr = FS_Bench_DevRdCtr - rd_ctr;
+
+    printf("           %s : close & open %.2f ms, query %.2f ms, %u rd reqs\n",
+           (dirty == DEF_YES) ? "dirty" : "clean",
+           (double)open_us  / 1000.0,
+           (double)query_us / 1000.0,
+           (unsigned)rd_ctr);
+
+   *p_free_sec = (CPU_INT32U)vol_info.VolFreeSecCnt;
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_Bench_Remount()
+*
+* Description : Close & re-open the volume.
+*
+* Argument(s) : dirty       DEF_YES to simulate a dirty shutdown (see Note #1).
+*
+* Return(s)   : DEF_OK,   if the volume was re-opened.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : FS_Bench_Mount(),
+*               FS_Bench_MountTime().
+*
+* Note(s)     : (1) A dirty shutdown is simulated by clearing, in the RAM disk, the clean shutdown bit of
+*                   FAT[1] once the volume is closed, as if power had been lost after the volume was first
+*                   changed.  A FAT12/16 volume is left unchanged.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_Bench_Remount (CPU_BOOLEAN  dirty)
+{
+    CPU_INT08U  *p_fat1;
+    CPU_INT32U   val;
+    FS_ERR       err;
+
+
+    FSVol_Close((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "FSVol_Close() failed: %u\n", (unsigned)err);
+        FS_Bench_Ctr.ErrCtr++;
+        return (DEF_FAIL);
+    }
+
+    if ((dirty == DEF_YES) &&                                   /* See Note #1.                                         */
+        (MEM_VAL_GET_INT16U_LITTLE(FS_Bench_DiskPtr + 22u) == 0u)) {
+        p_fat1 = FS_Bench_DiskPtr + (MEM_VAL_GET_INT16U_LITTLE(FS_Bench_DiskPtr + 14u) * FS_BENCH_SEC_SIZE) + 4u;
+        val    = MEM_VAL_GET_INT32U_LITTLE(p_fat1);
+        DEF_BIT_CLR(val, FS_BENCH_FAT32_CLN_SHUT_BIT);
+        MEM_VAL_SET_INT32U_LITTLE(p_fat1, val);
+    }
+
+    FSVol_Open((CPU_CHAR *)FS_BENCH_VOL_NAME, (CPU_CHAR *)FS_Bench_DevNamePtr, 0u, &err);
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "FSVol_Open() failed: %u\n", (unsigned)err);
+        FS_Bench_Ctr.ErrCtr++;
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_Bench_Lookup()
+*
+* Description : Create files in one large directory & time looking them up (see Note #10).
+*
+* Argument(s) : nbr         Nbr of files.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) Even files have long names, odd files short names.  Every fourth long name is looked up
+*                   in upper case, to check that lookups ignore case.
+*
+*               (2) Then every third file is deleted & every third file renamed, & each name looked up again,
+*                   to check that the lookups follow directory changes.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Lookup (CPU_INT32U  nbr)
+{
+    struct  fs_stat  info;
+    char             name[FS_BENCH_NAME_LEN_MAX];
+    char             name_new[FS_BENCH_NAME_LEN_MAX];
+    FS_FILE         *p_fs_file;
+    FS_VOL_INFO      vol_info;
+    CPU_INT32U       ix;
+    CPU_INT32U       file_ix;
+    CPU_INT32U       rd_ctr;
+    CPU_INT32U       lookup_ctr;
+    CPU_INT32U       create_rd;
+    CPU_INT64U       start_us;
+    CPU_INT64U       create_us;
+    CPU_INT64U       hit_us;
+    CPU_INT64U       miss_us;
+    CPU_BOOLEAN      exists;
+    FS_ERR           err;
+
+
+                                                                /* ------------------- CREATE FILES ------------------- */
+    if (fs_mkdir(FS_BENCH_VOL_NAME "\\BIG") != 0) {
+        fprintf(stderr, "BIG: cannot create\n");
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    rd_ctr   = FS_Bench_DevRdCtr;
+    start_us = Sim_TimeUsGet();
+    for (ix = 0u; ix < nbr; ix++) {
+        FS_Bench_LookupNameGet(ix, DEF_NO, name);
+        p_fs_file = fs_fopen(name, "w");
+        if (p_fs_file == DEF_NULL) {
+            fprintf(stderr, "%s: cannot create\n", name);
+            FS_Bench_Ctr.ErrCtr++;
+            return;
+        }
+        (void)fs_fclose(p_fs_file);
+    }
+    create_us = Sim_TimeUsGet() - start_us;
+    create_rd = FS_Bench_DevRdCtr - rd_ctr;
+
+                                                                /* ---------------- LOOK UP (Note #1) ----------------- */
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    rd_ctr     = FS_Bench_DevRdCtr;
+    lookup_ctr = vol_info.Cache.HitCtr + vol_info.Cache.MissCtr;
+
+    start_us = Sim_TimeUsGet();
+    for (ix = 0u; ix < nbr; ix++) {
+        file_ix = (CPU_INT32U)rand_r(&FS_Bench_Seed) % nbr;
+        FS_Bench_LookupNameGet(file_ix, ((file_ix % 4u) == 0u) ? DEF_YES : DEF_NO, name);
+        if (fs_stat(name, &info) != 0) {
+            fprintf(stderr, "%s: not found\n", name);
+            FS_Bench_Ctr.ErrCtr++;
+        }
+    }
+    hit_us = Sim_TimeUsGet() - start_us;
+
+    start_us = Sim_TimeUsGet();
+    for (ix = 0u; ix < nbr; ix++) {
+        (void)snprintf(name, sizeof(name), FS_BENCH_VOL_NAME "\\BIG\\Missing file %05u.txt", (unsigned)ix);
+        if (fs_stat(name, &info) == 0) {
+            fprintf(stderr, "%s: found\n", name);
+            FS_Bench_Ctr.ErrCtr++;
+        }
+    }
+    miss_us = Sim_TimeUsGet() - start_us;
+
+    FSVol_Query((CPU_CHAR *)FS_BENCH_VOL_NAME, &vol_info, &err);
+    rd_ctr     = FS_Bench_DevRdCtr - rd_ctr;
+    lookup_ctr = vol_info.Cache.HitCtr + vol_info.Cache.MissCtr - lookup_ctr;
+
+    printf("lookup   : %u files in one dir, created in %.1f ms, %u rd reqs\n",
+           (unsigned)nbr,
+           (double)create_us / 1000.0,
+           (unsigned)create_rd);
+    printf("           %u hits %.1f ms, %u misses %.1f ms, %u rd reqs, %u cache lookups\n",
+           (unsigned)nbr,
+           (double)hit_us  / 1000.0,
+           (unsigned)nbr,
+           (double)miss_us / 1000.0,
+           (unsigned)rd_ctr,
+           (unsigned)lookup_ctr);
+
+                                                                /* -------------- DEL & RENAME (Note #2) -------------- */
+    for (ix = 0u; ix < nbr; ix += 3u) {
+        FS_Bench_LookupNameGet(ix, DEF_NO, name);
+        if (fs_remove(name) != 0) {
+            fprintf(stderr, "%s: cannot remove\n", name);
+            FS_Bench_Ctr.ErrCtr++;
+        }
+    }
+    for (ix = 1u; ix < nbr; ix += 3u) {
+        FS_Bench_LookupNameGet(ix, DEF_NO, name);
+        (void)snprintf(name_new, sizeof(name_new), FS_BENCH_VOL_NAME "\\BIG\\Renamed %05u.txt", (unsigned)ix);
+        if (fs_rename(name, name_new) != 0) {
+            fprintf(stderr, "%s: cannot rename\n", name);
+            FS_Bench_Ctr.ErrCtr++;
+        }
+    }
+
+    for (ix = 0u; ix < nbr; ix++) {
+        exists = ((ix % 3u) == 2u) ? DEF_YES : DEF_NO;
+        FS_Bench_LookupNameGet(ix, DEF_NO, name);
+        if ((fs_stat(name, &info) == 0) != (exists == DEF_YES)) {
+            fprintf(stderr, "%s: %s\n", name, (exists == DEF_YES) ? "not found" : "found");
+            FS_Bench_Ctr.ErrCtr++;
+        }
+        if ((ix % 3u) == 1u) {
+            (void)snprintf(name_new, sizeof(name_new), FS_BENCH_VOL_NAME "\\BIG\\Renamed %05u.txt", (unsigned)ix);
+            if (fs_stat(name_new, &info) != 0) {
+                fprintf(stderr, "%s: not found\n", name_new);
+                FS_Bench_Ctr.ErrCtr++;
+            }
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FS_Bench_LookupNameGet()
+*
+* Description : Get full name of a file of the lookup test.
+*
+* Argument(s) : file_ix     File index.
+*
+*               upper       DEF_YES to get a long name in upper case.
+*
+*               p_name      Pointer to buffer of FS_BENCH_NAME_LEN_MAX characters that will receive name.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FS_Bench_Lookup().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_LookupNameGet (CPU_INT32U    file_ix,
+                                      CPU_BOOLEAN   upper,
+                                      char         *p_name)
+{
+    if ((file_ix % 2u) != 0u) {
+        (void)snprintf(p_name, FS_BENCH_NAME_LEN_MAX, FS_BENCH_VOL_NAME "\\BIG\\S%05u.DAT", (unsigned)file_ix);
+    } else if (upper == DEF_YES) {
+        (void)snprintf(p_name, FS_BENCH_NAME_LEN_MAX, FS_BENCH_VOL_NAME "\\BIG\\LONG FILE NAME %05u.TXT", (unsigned)file_ix);
+    } else {
+        (void)snprintf(p_name, FS_BENCH_NAME_LEN_MAX, FS_BENCH_VOL_NAME "\\BIG\\Long file name %05u.txt", (unsigned)file_ix);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_Bench_StreamFill()
+*
+* Description : Generate expected contents of the sequential read test file.
+*
+* Argument(s) : pos         File position of first octet.
+*
+*               p_buf       Pointer to buffer that will receive contents.
+*
+*               len         Nbr of octets.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FS_Bench_Stream(),
+*               FS_Bench_Seek(),
+*               FS_Bench_Fill(),
+*               FS_Bench_Mount().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_StreamFill (CPU_INT32U   pos,
+                                   CPU_INT08U  *p_buf,
+                                   CPU_INT32U   len)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < len; ix++) {
+        p_buf[ix] = (CPU_INT08U)(((pos + ix) * 7u) + ((pos + ix) >> 9) + 0x5Au);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_Bench_PwrCut()
+*
+* Description : Simulate power cuts, replay the journal & check the volume after each (see Note #12).
+*
+* Argument(s) : nbr         Nbr of power cuts.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) The volume is re-opened first, which deletes its cache : with a write-back cache, the
+*                   order in which sectors reach the device is not the one the journal relies on.
+*
+*               (2) Each power cut starts from a commit.  Files touched after it may have any of the states
+*                   they went through; an fs_fflush() commits them as well.
+*
+*               (3) The operations after the write after which power is cut still run to completion,
+*                   so that no file is left open, but their writes are lost with the saved contents.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_PwrCut (CPU_INT32U  nbr)
+{
+    CPU_BOOLEAN  *p_touched;
+    CPU_INT32U    cut_ix;
+    CPU_INT32U    op_ix;
+    CPU_INT32U    file_ix;
+    CPU_INT32U    wr_start;
+    CPU_INT32U    wr_cnt;
+    CPU_INT32U    op_cnt;
+    CPU_INT32U    reset_cnt;
+    CPU_INT32U    chk_err_cnt;
+    CPU_INT32U    err_cnt;
+    CPU_BOOLEAN   commit;
+    FS_ERR        err;
+
+
+    p_touched              = (CPU_BOOLEAN *)calloc(FS_Bench_FileNbr, sizeof(CPU_BOOLEAN));
+    FS_Bench_PwrCutDiskPtr = (CPU_INT08U  *)malloc(FS_Bench_DiskSize);
+    if ((p_touched              == DEF_NULL) ||
+        (FS_Bench_PwrCutDiskPtr == DEF_NULL)) {
+        fprintf(stderr, "out of memory\n");
+        FS_Bench_Ctr.ErrCtr++;
+        free(p_touched);
+        return;
+    }
+
+    if ((FS_Bench_Remount(DEF_NO) != DEF_OK) ||                 /* See Note #1.                                         */
+        (FS_Bench_JournalOpen()   != DEF_OK)) {
+        free(p_touched);
+        return;
+    }
+
+    wr_cnt      = 0u;
+    op_cnt      = 0u;
+    reset_cnt   = 0u;
+    chk_err_cnt = 0u;
+    err_cnt     = FS_Bench_Ctr.ErrCtr;
+    for (cut_ix = 0u; cut_ix < nbr; cut_ix++) {
+                                                                /* ---------------- COMMIT (see Note #2) -------------- */
+        FS_FAT_JournalCommit((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+        if (err != FS_ERR_NONE) {
+            fprintf(stderr, "FS_FAT_JournalCommit() failed: %u\n", (unsigned)err);
+            FS_Bench_Ctr.ErrCtr++;
+            break;
+        }
+        Mem_Clr(p_touched, FS_Bench_FileNbr * sizeof(CPU_BOOLEAN));
+
+                                                                /* ------------------ OPS UNTIL CUT ------------------- */
+        wr_start             = FS_Bench_DevWrCtr;
+        FS_Bench_PwrCutWrNbr = wr_start + 1u + ((CPU_INT32U)rand_r(&FS_Bench_Seed) % FS_BENCH_PWR_WR_MAX);
+        for (op_ix = 0u; (op_ix < FS_BENCH_PWR_OP_MAX) && (FS_Bench_PwrCutWrNbr != 0u); op_ix++) {
+            file_ix            = (CPU_INT32U)rand_r(&FS_Bench_Seed) % FS_Bench_FileNbr;
+            p_touched[file_ix] = DEF_YES;
+            commit = FS_Bench_PwrCutOp(file_ix);
+            if ((commit               == DEF_YES) &&            /* If ops committed before pwr cut ...                  */
+                (FS_Bench_PwrCutWrNbr != 0u)) {
+                Mem_Clr(p_touched, FS_Bench_FileNbr * sizeof(CPU_BOOLEAN));
+            }
+            op_cnt++;
+        }
+        if (FS_Bench_PwrCutWrNbr != 0u) {                       /* Cut now if too few wrs.                              */
+            Mem_Copy(FS_Bench_PwrCutDiskPtr, FS_Bench_DiskPtr, FS_Bench_DiskSize);
+            FS_Bench_PwrCutWrNbr = 0u;
+        }
+        wr_cnt += FS_Bench_DevWrCtr - wr_start;
+
+                                                                /* ----------------- CUT PWR & REPLAY ----------------- */
+        FSVol_Close((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);       /* See Note #3.                                         */
+        Mem_Copy(FS_Bench_DiskPtr, FS_Bench_PwrCutDiskPtr, FS_Bench_DiskSize);
+        FSVol_Open((CPU_CHAR *)FS_BENCH_VOL_NAME, (CPU_CHAR *)FS_Bench_DevNamePtr, 0u, &err);
+        if (err != FS_ERR_NONE) {
+            fprintf(stderr, "FSVol_Open() failed after power cut: %u\n", (unsigned)err);
+            FS_Bench_Ctr.ErrCtr++;
+            break;
+        }
+        if (FS_Bench_JournalOpen() != DEF_OK) {
+            break;
+        }
+
+                                                                /* ----------------------- CHK ------------------------ */
+        chk_err_cnt += FS_Bench_FAT_Chk();
+        for (file_ix = 0u; file_ix < FS_Bench_FileNbr; file_ix++) {
+            if (p_touched[file_ix] == DEF_YES) {
+                FS_Bench_PwrCutFileReset(file_ix);
+                reset_cnt++;
+            } else {
+                FS_Bench_FileVerify(file_ix);
+            }
+        }
+        (void)fs_rmdir(FS_BENCH_PWR_DIR_NAME);
+    }
+
+    for (file_ix = 0u; file_ix < FS_Bench_DirNbr; file_ix++) {
+        FS_Bench_DirWalk(file_ix);
+    }
+    chk_err_cnt           += FS_Bench_FAT_Chk();
+    FS_Bench_Ctr.ErrCtr   += chk_err_cnt;
+
+    printf("pwr cut  : %u cuts, %u ops, %.1f dev wrs per cut; %u files touched since commit re-created\n",
+           (unsigned)cut_ix,
+           (unsigned)op_cnt,
+           (cut_ix > 0u) ? ((double)wr_cnt / (double)cut_ix) : 0.0,
+           (unsigned)reset_cnt);
+    printf("           %u FAT & dir errors, %u other errors\n",
+           (unsigned)chk_err_cnt,
+           (unsigned)(FS_Bench_Ctr.ErrCtr - err_cnt - chk_err_cnt));
+
+    free(p_touched);
+    free(FS_Bench_PwrCutDiskPtr);
+    FS_Bench_PwrCutDiskPtr = DEF_NULL;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_Bench_PwrCutOp()
+*
+* Description : Perform a random operation on a file, before a power cut.
+*
+* Argument(s) : file_ix     File index.
+*
+* Return(s)   : DEF_YES, if the operation committed the journal (see Note #1).
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : FS_Bench_PwrCut().
+*
+* Note(s)     : (1) An append is followed by fs_fflush() one time in four, which commits the operations
+*                   completed before it.
+*
+*               (2) The file is renamed & renamed back, & a directory created & deleted.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_Bench_PwrCutOp (CPU_INT32U  file_ix)
+{
+    FS_BENCH_FILE  *p_file;
+    FS_FILE        *p_fs_file;
+    char            name[FS_BENCH_NAME_LEN_MAX];
+    char            name_tmp[FS_BENCH_NAME_LEN_MAX];
+    CPU_INT32U      op;
+    CPU_INT32U      len;
+    fs_size_t       len_wr;
+    CPU_BOOLEAN     commit;
+
+
+    p_file = &FS_Bench_FileTbl[file_ix];
+    FS_Bench_NameGet(file_ix, name);
+    op     = (CPU_INT32U)rand_r(&FS_Bench_Seed) % 100u;
+    commit = DEF_NO;
+
+    if (op < 30u) {
+        FS_Bench_FileAppend(file_ix);
+
+    } else if (op < 40u) {                                      /* Append & flush (see Note #1).                        */
+        len = 1u + ((CPU_INT32U)rand_r(&FS_Bench_Seed) % FS_BENCH_APPEND_MAX);
+        if (p_file->Size + len > FS_BENCH_FILE_SIZE_MAX) {
+            FS_Bench_FileRecreate(file_ix);
+            return (DEF_NO);
+        }
+        p_fs_file = fs_fopen(name, "a");
+        if (p_fs_file == DEF_NULL) {
+            FS_Bench_Ctr.ErrCtr++;
+            return (DEF_NO);
+        }
+        FS_Bench_PatternFill(file_ix, p_file->Size, FS_Bench_Buf, len);
+        len_wr = fs_fwrite(FS_Bench_Buf, 1u, len, p_fs_file);
+        if (fs_fflush(p_fs_file) == 0) {
+            commit = DEF_YES;
+        } else {
+            FS_Bench_Ctr.ErrCtr++;
+        }
+        (void)fs_fclose(p_fs_file);
+
+        p_file->Size += (CPU_INT32U)len_wr;
+        if (len_wr != len) {
+            FS_Bench_Ctr.ErrCtr++;
+        }
+        FS_Bench_Ctr.AppendCtr++;
+
+    } else if (op < 55u) {
+        FS_Bench_FileRecreate(file_ix);
+
+    } else if (op < 75u) {                                      /* Truncate.                                            */
+        len       = (CPU_INT32U)rand_r(&FS_Bench_Seed) % (p_file->Size + 1u);
+        p_fs_file = fs_fopen(name, "r+");
+        if (p_fs_file == DEF_NULL) {
+            FS_Bench_Ctr.ErrCtr++;
+            return (DEF_NO);
+        }
+        if (fs_ftruncate(p_fs_file, (fs_off_t)len) != 0) {
+            FS_Bench_Ctr.ErrCtr++;
+        } else {
+            p_file->Size = len;
+        }
+        (void)fs_fclose(p_fs_file);
+
+    } else if (op < 90u) {                                      /* Rename (see Note #2).                                */
+        Str_Copy(name_tmp, name);
+        Str_Copy(&name_tmp[Str_Len(name_tmp) - 3u], "TMP");
+        if ((fs_rename(name,     name_tmp) != 0) ||
+            (fs_rename(name_tmp, name)     != 0)) {
+            FS_Bench_Ctr.ErrCtr++;
+        }
+
+    } else {                                                    /* Create dir (see Note #2).                            */
+        if ((fs_mkdir(FS_BENCH_PWR_DIR_NAME) != 0) ||
+            (fs_rmdir(FS_BENCH_PWR_DIR_NAME) != 0)) {
+            FS_Bench_Ctr.ErrCtr++;
+        }
+    }
+
+    return (commit);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FS_Bench_PwrCutFileReset()
+*
+* Description : Delete a file touched since the last commit, under either name, & create it again, empty.
+*
+* Argument(s) : file_ix     File index.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FS_Bench_PwrCut().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_PwrCutFileReset (CPU_INT32U  file_ix)
+{
+    FS_BENCH_FILE  *p_file;
+    FS_FILE        *p_fs_file;
+    char            name[FS_BENCH_NAME_LEN_MAX];
+
+
+    p_file = &FS_Bench_FileTbl[file_ix];
+    FS_Bench_NameGet(file_ix, name);
+    (void)fs_remove(name);
+    Str_Copy(&name[Str_Len(name) - 3u], "TMP");
+    (void)fs_remove(name);
+    FS_Bench_NameGet(file_ix, name);
+
+    p_file->Gen++;
+    p_file->Size = 0u;
+    p_fs_file    = fs_fopen(name, "w");
+    if (p_fs_file == DEF_NULL) {
+        fprintf(stderr, "%s: cannot create after power cut\n", name);
+        FS_Bench_Ctr.ErrCtr++;
+        return;
+    }
+    (void)fs_fclose(p_fs_file);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_Bench_JournalOpen()
+*
+* Description : Open the journal, replaying it, & start journaling.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_OK,   if journaling started.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : FS_Bench_Setup(), FS_Bench_PwrCut().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_Bench_JournalOpen (void)
+{
+    FS_ERR  err;
+
+
+    FS_FAT_JournalOpen((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+    if (err == FS_ERR_NONE) {
+        FS_FAT_JournalStart((CPU_CHAR *)FS_BENCH_VOL_NAME, &err);
+    }
+    if (err != FS_ERR_NONE) {
+        fprintf(stderr, "journal open & start failed: %u\n", (unsigned)err);
+        FS_Bench_Ctr.ErrCtr++;
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_Bench_FAT_Chk()
+*
+* Description : Check the FAT & directories of the RAM disk, as a host checker would.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Nbr of errors found.
+*
+* Caller(s)   : FS_Bench_PwrCut().
+*
+* Note(s)     : (1) Every cluster chain of a directory entry is followed : its clusters must be valid, end
+*                   with an end of chain mark & not belong to another chain, & a file's chain must hold
+*                   exactly its size.  Clusters allocated in the FAT but found in no chain are lost.
+*
+*               (2) Only the first FAT is checked; the RAM disk holds the volume without partition.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  FS_Bench_FAT_Chk (void)
+{
+    FS_BENCH_FAT_CHK  chk;
+    CPU_INT08U       *p_bpb;
+    CPU_INT32U        sec_size;
+    CPU_INT32U        rsvd_sec_cnt;
+    CPU_INT32U        fat_sec_cnt;
+    CPU_INT32U        root_sec_cnt;
+    CPU_INT32U        tot_sec_cnt;
+    CPU_INT32U        data_sec;
+    CPU_INT32U        clus;
+    CPU_INT32U        val;
+
+
+    p_bpb        = FS_Bench_DiskPtr;
+    sec_size     = MEM_VAL_GET_INT16U_LITTLE(p_bpb + 11u);
+    rsvd_sec_cnt = MEM_VAL_GET_INT16U_LITTLE(p_bpb + 14u);
+    fat_sec_cnt  = MEM_VAL_GET_INT16U_LITTLE(p_bpb + 22u);
+    if (fat_sec_cnt == 0u) {
+        fat_sec_cnt = MEM_VAL_GET_INT32U_LITTLE(p_bpb + 36u);
+    }
+    tot_sec_cnt  = MEM_VAL_GET_INT16U_LITTLE(p_bpb + 19u);
+    if (tot_sec_cnt == 0u) {
+        tot_sec_cnt = MEM_VAL_GET_INT32U_LITTLE(p_bpb + 32u);
+    }
+    chk.RootEntryCnt = MEM_VAL_GET_INT16U_LITTLE(p_bpb + 17u);
+    root_sec_cnt     = ((chk.RootEntryCnt * FS_BENCH_DIR_ENTRY_SIZE) + sec_size - 1u) / sec_size;
+    data_sec         = rsvd_sec_cnt + (p_bpb[16] * fat_sec_cnt) + root_sec_cnt;
+
+    chk.FAT_Ptr  = FS_Bench_DiskPtr + (rsvd_sec_cnt * sec_size);
+    chk.RootPtr  = FS_Bench_DiskPtr + ((data_sec - root_sec_cnt) * sec_size);
+    chk.DataPtr  = FS_Bench_DiskPtr + (data_sec * sec_size);
+    chk.ClusSize = p_bpb[13] * sec_size;
+    chk.ClusCnt  = (tot_sec_cnt - data_sec) / p_bpb[13];
+    chk.ErrCtr   = 0u;
+    if (chk.ClusCnt < 4085u) {
+        chk.FAT_Type = 12u;
+        chk.ClusEOC  = 0xFF8u;
+        chk.RootClus = 0u;
+    } else if (chk.ClusCnt < 65525u) {
+        chk.FAT_Type = 16u;
+        chk.ClusEOC  = 0xFFF8u;
+        chk.RootClus = 0u;
+    } else {
+        chk.FAT_Type = 32u;
+        chk.ClusEOC  = 0x0FFFFFF8u;
+        chk.RootClus = MEM_VAL_GET_INT32U_LITTLE(p_bpb + 44u);
+    }
+
+    chk.UsedTbl = (CPU_INT08U *)calloc(chk.ClusCnt + 2u, 1u);
+    if (chk.UsedTbl == DEF_NULL) {
+        fprintf(stderr, "out of memory\n");
+        return (1u);
+    }
+
+                                                                /* ------------------ FOLLOW CHAINS ------------------- */
+    if (chk.FAT_Type == 32u) {
+        (void)FS_Bench_FAT_ChkChain(&chk, chk.RootClus, (const CPU_INT08U *)"ROOT       ");
+    }
+    FS_Bench_FAT_ChkDir(&chk, chk.RootClus, 0u);
+
+                                                                /* ------------------- LOST CLUS ---------------------- */
+    for (clus = 2u; clus < chk.ClusCnt + 2u; clus++) {
+        val = FS_Bench_FAT_ChkEntryGet(&chk, clus);
+        if ((val != 0u) &&
+            (val != chk.ClusEOC - 1u) &&                        /* Bad clus.                                            */
+            (chk.UsedTbl[clus] == 0u)) {
+            fprintf(stderr, "chk: clus %u lost\n", (unsigned)clus);
+            chk.ErrCtr++;
+        }
+    }
+
+    free(chk.UsedTbl);
+    return (chk.ErrCtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FS_Bench_FAT_ChkEntryGet()
+*
+* Description : Get a FAT entry.
+*
+* Argument(s) : p_chk       Pointer to FAT chk.
+*
+*               clus        Cluster nbr.
+*
+* Return(s)   : FAT entry value.
+*
+* Caller(s)   : FS_Bench_FAT_Chk*().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  FS_Bench_FAT_ChkEntryGet (FS_BENCH_FAT_CHK  *p_chk,
+                                              CPU_INT32U         clus)
+{
+    CPU_INT32U  val;
+
+
+    switch (p_chk->FAT_Type) {
+        case 12u:
+             val = MEM_VAL_GET_INT16U_LITTLE(p_chk->FAT_Ptr + clus + (clus / 2u));
+             val = ((clus & 1u) != 0u) ? (val >> 4) : (val & 0x0FFFu);
+             break;
+
+        case 16u:
+             val = MEM_VAL_GET_INT16U_LITTLE(p_chk->FAT_Ptr + (clus * 2u));
+             break;
+
+        case 32u:
+        default:
+             val = MEM_VAL_GET_INT32U_LITTLE(p_chk->FAT_Ptr + (clus * 4u)) & 0x0FFFFFFFu;
+             break;
+    }
+
+    return (val);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FS_Bench_FAT_ChkChain()
+*
+* Description : Follow a cluster chain, marking its clusters used.
+*
+* Argument(s) : p_chk       Pointer to FAT chk.
+*
+*               first_clus  First cluster of chain.
+*
+*               p_name      Pointer to 8.3 name of entry owning the chain.
+*
+* Return(s)   : Nbr of clusters in chain, up to the first invalid or cross-linked cluster.
+*
+* Caller(s)   : FS_Bench_FAT_Chk(), FS_Bench_FAT_ChkDirEntries().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  FS_Bench_FAT_ChkChain (FS_BENCH_FAT_CHK    *p_chk,
+                                           CPU_INT32U           first_clus,
+                                           const  CPU_INT08U   *p_name)
+{
+    CPU_INT32U  clus;
+    CPU_INT32U  clus_cnt;
+
+
+    clus     = first_clus;
+    clus_cnt = 0u;
+    while (DEF_ON) {
+        if ((clus < 2u) || (clus >= p_chk->ClusCnt + 2u)) {
+            fprintf(stderr, "chk: %.11s: invalid clus %u in chain\n", p_name, (unsigned)clus);
+            p_chk->ErrCtr++;
+            return (clus_cnt);
+        }
+        if (p_chk->UsedTbl[clus] != 0u) {
+            fprintf(stderr, "chk: %.11s: clus %u cross-linked\n", p_name, (unsigned)clus);
+            p_chk->ErrCtr++;
+            return (clus_cnt);
+        }
+        p_chk->UsedTbl[clus] = 1u;
+        clus_cnt++;
+
+        clus = FS_Bench_FAT_ChkEntryGet(p_chk, clus);
+        if (clus >= p_chk->ClusEOC) {
+            return (clus_cnt);
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FS_Bench_FAT_ChkDir()
+*
+* Description : Check the entries of a directory.
+*
+* Argument(s) : p_chk       Pointer to FAT chk.
+*
+*               first_clus  First cluster of directory, 0 for the root directory of a FAT12/16 volume.
+*
+*               depth       Directory depth.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FS_Bench_FAT_Chk(), FS_Bench_FAT_ChkDirEntries().
+*
+* Note(s)     : (1) The directory's chain has been followed already : it is valid & ends with an end of
+*                   chain mark, or has been reported.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_FAT_ChkDir (FS_BENCH_FAT_CHK  *p_chk,
+                                   CPU_INT32U         first_clus,
+                                   CPU_INT32U         depth)
+{
+    CPU_INT32U   clus;
+    CPU_BOOLEAN  more;
+
+
+    if (first_clus == 0u) {
+        (void)FS_Bench_FAT_ChkDirEntries(p_chk, p_chk->RootPtr, p_chk->RootEntryCnt, depth);
+        return;
+    }
+
+    clus = first_clus;                                          /* See Note #1.                                         */
+    more = DEF_YES;
+    while ((more == DEF_YES) &&
+           (clus >= 2u) && (clus < p_chk->ClusCnt + 2u)) {
+        more = FS_Bench_FAT_ChkDirEntries(p_chk,
+                                          p_chk->DataPtr + ((clus - 2u) * p_chk->ClusSize),
+                                          p_chk->ClusSize / FS_BENCH_DIR_ENTRY_SIZE,
+                                          depth);
+        clus = FS_Bench_FAT_ChkEntryGet(p_chk, clus);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                    FS_Bench_FAT_ChkDirEntries()
+*
+* Description : Check directory entries, following their cluster chains.
+*
+* Argument(s) : p_chk       Pointer to FAT chk.
+*
+*               p_entry     Pointer to first entry.
+*
+*               entry_cnt   Nbr of entries.
+*
+*               depth       Directory depth.
+*
+* Return(s)   : DEF_YES, if the directory may hold further entries.
+*
+*               DEF_NO,  if its end was found.
+*
+* Caller(s)   : FS_Bench_FAT_ChkDir().
+*
+* Note(s)     : (1) A file's first cluster is 0 if & only if it is empty.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_Bench_FAT_ChkDirEntries (FS_BENCH_FAT_CHK  *p_chk,
+                                                 CPU_INT08U        *p_entry,
+                                                 CPU_INT32U         entry_cnt,
+                                                 CPU_INT32U         depth)
+{
+    CPU_INT32U  ix;
+    CPU_INT32U  first_clus;
+    CPU_INT32U  clus_cnt;
+    CPU_INT32U  clus_cnt_exp;
+    CPU_INT32U  size;
+    CPU_INT08U  attrib;
+
+
+    for (ix = 0u; ix < entry_cnt; ix++, p_entry += FS_BENCH_DIR_ENTRY_SIZE) {
+        if (p_entry[0] == 0x00u) {                              /* End of dir.                                          */
+            return (DEF_NO);
+        }
+        attrib = p_entry[11];
+        if ((p_entry[0] == 0xE5u) ||                            /* Deleted entry, ...                                   */
+            (p_entry[0] == (CPU_INT08U)'.') ||                  /* ... dot entry, ...                                   */
+            ((attrib & 0x0Fu) == 0x0Fu) ||                      /* ... LFN entry ...                                    */
+            ((attrib & 0x08u) != 0u)) {                         /* ... or vol label.                                    */
+            continue;
+        }
+
+        first_clus = MEM_VAL_GET_INT16U_LITTLE(p_entry + 26u);
+        if (p_chk->FAT_Type == 32u) {
+            first_clus |= (CPU_INT32U)MEM_VAL_GET_INT16U_LITTLE(p_entry + 20u) << 16;
+        }
+        size = MEM_VAL_GET_INT32U_LITTLE(p_entry + 28u);
+
+        if ((attrib & 0x10u) != 0u) {                           /* ----------------------- DIR ------------------------ */
+            if (first_clus == 0u) {
+                fprintf(stderr, "chk: %.11s: dir without clus\n", p_entry);
+                p_chk->ErrCtr++;
+                continue;
+            }
+            (void)FS_Bench_FAT_ChkChain(p_chk, first_clus, p_entry);
+            if (depth < FS_BENCH_DIR_DEPTH_MAX) {
+                FS_Bench_FAT_ChkDir(p_chk, first_clus, depth + 1u);
+            }
+
+        } else {                                                /* ----------------------- FILE ----------------------- */
+            clus_cnt_exp = (size + p_chk->ClusSize - 1u) / p_chk->ClusSize;
+            clus_cnt     = (first_clus != 0u) ? FS_Bench_FAT_ChkChain(p_chk, first_clus, p_entry) : 0u;
+            if (clus_cnt != clus_cnt_exp) {                     /* See Note #1.                                         */
+                fprintf(stderr, "chk: %.11s: %u octets in %u clus\n",
+                        p_entry, (unsigned)size, (unsigned)clus_cnt);
+                p_chk->ErrCtr++;
+            }
+        }
+    }
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_Bench_Usage()
+*
+* Description : Print command line usage.
+*
+* Argument(s) : p_prog      Program name.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_Bench_Usage (const  char  *p_prog)
+{
+    fprintf(stderr,
+            "usage: %s [-f files] [-d dirs] [-r rounds] [-c cache_kb] [-m r|t|b] [-w age] [-s kib] [-x nbr] [-F pct] [-O kib] [-X kib] [-L nbr] [-M] [-J] [-P nbr] [-D disk_mb] [-S seed]\n"
+            "       [-t ram|nand|nor|sd] [-i image] [-b bad_blks] [-B flip_ppm] [-E endurance] [-G] [-W]\n"
+            "  -f  nbr of files                      (default %u)\n"
+            "  -d  nbr of dirs, max 100              (default %u)\n"
+            "  -r  nbr of workload rounds            (default %u)\n"
+            "  -c  volume cache size in KiB, 0 = off (default %u)\n"
+            "  -m  cache mode: read, write-through, write-back (default b)\n"
+            "  -w  background write back, max dirty age in periods of %u ops (default off)\n"
+            "  -s  sequential rd test file size in KiB (default off)\n"
+            "  -x  nbr of random seek & rds in sequential rd test file (default off)\n"
+            "  -F  fill volume to pct %%, free every other file & write in the holes (default off)\n"
+            "  -O  write & read back a kib KiB file, cached & in direct mode (default off)\n"
+            "  -X  write a kib KiB file & walk it with FSFile_Map() (default off)\n"
+            "  -L  nbr of files created & looked up in one large dir (default off)\n"
+            "  -M  time re-mount & first query, after clean & dirty close (default off)\n"
+            "  -J  journal the workload          (default off)\n"
+            "  -P  nbr of simulated power cuts, each followed by journal replay & volume chk (default off)\n"
+            "  -D  RAM disk, flash or SD size in MiB (default %u)\n"
+            "  -S  random seed                       (default 1)\n"
+            "  -t  device: RAM disk, simulated NAND or NOR flash or SD card (default ram)\n"
+            "  -i  flash image file, kept across runs (default temporary)\n"
+            "  -b  nbr of factory bad NAND blks      (default %u)\n"
+            "  -B  NAND bit flips per million pg rds (default %u)\n"
+            "  -E  flash erase cycles per blk        (default %u)\n"
+            "  -G  NAND bg merges & erases between ops (default off)\n"
+            "  -W  NOR static wear leveling between rounds (default off)\n",
+            p_prog,
+            FS_BENCH_DFLT_FILE_NBR,
+            FS_BENCH_DFLT_DIR_NBR,
+            FS_BENCH_DFLT_ROUND_NBR,
+            FS_BENCH_DFLT_CACHE_KB,
+            FS_BENCH_WR_BACK_PERIOD,
+            FS_BENCH_DFLT_DISK_MB,
+            FS_BENCH_DFLT_BAD_BLK_NBR,
+            FS_BENCH_DFLT_FLIP_PPM,
+            FS_BENCH_DFLT_ENDURANCE);
+}
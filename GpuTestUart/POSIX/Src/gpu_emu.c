@@ -0,0 +1,274 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : gpu_emu.c
+*
+* Note(s)  : (1) See 'gpu_emu.h' Note #1.
+*
+*            (2) Command framing follows the GPU-TFT protocol : commands are ASCII & terminated by
+*                "\r\n".  Empty lines (e.g. the leading "\r\n" of the port test banner) & NUL octets
+*                (the application sends 'sizeof()' of its command strings) are ignored.
+*
+*            (3) The reply is written only after the latency has elapsed & the reply octets have been
+*                clocked out at the configured baud rate, so a reply that arrives after the
+*                application has given up is seen by the UART emulation as unsolicited data.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "gpu_emu.h"
+#include  "usart.h"
+#include  "sim.h"
+
+#include  <KAL/kal.h>
+
+#include  <errno.h>
+#include  <stdlib.h>
+#include  <unistd.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  GPU_EMU_TASK_STK_SIZE                         65536u
+#define  GPU_EMU_TASK_PRIO                                10u
+
+#define  GPU_EMU_RX_CHUNK_LEN                             64u
+
+#define  GPU_EMU_REPLY                                  "OK"
+#define  GPU_EMU_REPLY_LEN                                 2u
+
+#define  GPU_EMU_PPM_FULL                            1000000u
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  int           GpuEmu_Fd;
+static  GPU_EMU_CFG   GpuEmu_Cfg;
+static  unsigned int  GpuEmu_RandState;
+
+static  volatile  CPU_INT32U  GpuEmu_CmdCtr;
+static  volatile  CPU_INT32U  GpuEmu_ReplyCtr;
+static  volatile  CPU_INT32U  GpuEmu_DropCtr;
+static  volatile  CPU_INT32U  GpuEmu_OctetCtr;
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  GpuEmu_Task   (void  *p_arg);
+
+static  void  GpuEmu_CmdHnd (void);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           GpuEmu_Start()
+*
+* Description : Start the GPU-TFT emulator on a host file descriptor.
+*
+* Argument(s) : fd          Host file descriptor connected to the emulated USART1.
+*
+*               p_cfg       Pointer to emulator configuration.
+*
+* Return(s)   : DEF_OK,   if emulator started.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) Sim_OS_Init() MUST be called first.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  GpuEmu_Start (int            fd,
+                           GPU_EMU_CFG   *p_cfg)
+{
+    KAL_TASK_HANDLE  task_handle;
+    RTOS_ERR         err;
+
+
+    GpuEmu_Fd        =  fd;
+    GpuEmu_Cfg       = *p_cfg;
+    GpuEmu_RandState =  p_cfg->Seed;
+
+    task_handle = KAL_TaskAlloc((const CPU_CHAR *)"GPU emu",
+                                 DEF_NULL,
+                                 GPU_EMU_TASK_STK_SIZE / sizeof(CPU_DATA),
+                                 DEF_NULL,
+                                &err);
+    if (err != RTOS_ERR_NONE) {
+        return (DEF_FAIL);
+    }
+
+    KAL_TaskCreate(task_handle, GpuEmu_Task, DEF_NULL, GPU_EMU_TASK_PRIO, DEF_NULL, &err);
+
+    return ((err == RTOS_ERR_NONE) ? DEF_OK : DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          GpuEmu_StatGet()
+*
+* Description : Get the emulator statistics.
+*
+* Argument(s) : p_stat      Pointer to variable that will receive the statistics.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  GpuEmu_StatGet (GPU_EMU_STAT  *p_stat)
+{
+    p_stat->CmdCtr   = GpuEmu_CmdCtr;
+    p_stat->ReplyCtr = GpuEmu_ReplyCtr;
+    p_stat->DropCtr  = GpuEmu_DropCtr;
+    p_stat->OctetCtr = GpuEmu_OctetCtr;
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            GpuEmu_Task()
+*
+* Description : Receive commands from the emulated USART1 & reply to each of them (see Note #2).
+*
+* Argument(s) : p_arg       Unused.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : KAL task wrapper.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  GpuEmu_Task (void  *p_arg)
+{
+    CPU_INT08U   chunk[GPU_EMU_RX_CHUNK_LEN];
+    CPU_INT32U   cmd_len;
+    CPU_BOOLEAN  cr;
+    ssize_t      len;
+    ssize_t      ix;
+
+
+    (void)p_arg;
+
+    cmd_len = 0u;
+    cr      = DEF_NO;
+    for (;;) {
+        len = read(GpuEmu_Fd, chunk, sizeof(chunk));
+        if (len <= 0) {
+            if ((len < 0) && (errno == EINTR)) {
+                continue;
+            }
+            return;                                             /* Peer closed.                                         */
+        }
+        GpuEmu_OctetCtr += (CPU_INT32U)len;
+
+        for (ix = 0; ix < len; ix++) {
+            switch (chunk[ix]) {
+                case '\0':                                      /* See Note #2.                                         */
+                     break;
+
+                case '\r':
+                     cr = DEF_YES;
+                     break;
+
+                case '\n':
+                     if ((cr == DEF_YES) && (cmd_len > 0u)) {
+                         GpuEmu_CmdHnd();
+                     }
+                     cmd_len = 0u;
+                     cr      = DEF_NO;
+                     break;
+
+                default:
+                     cmd_len++;
+                     cr = DEF_NO;
+                     break;
+            }
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           GpuEmu_CmdHnd()
+*
+* Description : Process a complete command : wait for the processing latency, then send or drop the reply.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : GpuEmu_Task().
+*
+* Note(s)     : (1) Commands are processed one at a time, as by the display controller; commands received
+*                   meanwhile are buffered by the socket.
+*********************************************************************************************************
+*/
+
+static  void  GpuEmu_CmdHnd (void)
+{
+    CPU_INT32U  dly_us;
+    CPU_INT32U  draw;
+
+
+    GpuEmu_CmdCtr++;
+
+    dly_us = GpuEmu_Cfg.LatencyUs;
+    if (GpuEmu_Cfg.JitterUs > 0u) {
+        dly_us += (CPU_INT32U)rand_r(&GpuEmu_RandState) % (GpuEmu_Cfg.JitterUs + 1u);
+    }
+    dly_us += Sim_UART_ByteTimeUs(GpuEmu_Cfg.Baud, GPU_EMU_REPLY_LEN);
+    Sim_DlyUs(dly_us);
+
+    draw = (CPU_INT32U)rand_r(&GpuEmu_RandState) % GPU_EMU_PPM_FULL;
+    if (draw < GpuEmu_Cfg.LossPpm) {
+        GpuEmu_DropCtr++;
+        return;
+    }
+
+    if (write(GpuEmu_Fd, GPU_EMU_REPLY, GPU_EMU_REPLY_LEN) == (ssize_t)GPU_EMU_REPLY_LEN) {
+        GpuEmu_ReplyCtr++;
+    }
+}
@@ -0,0 +1,123 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_clk.c
+*
+* Note(s)  : (1) uC/Clk OS port for the host : the clock is set from the host time when initialized &
+*                then maintained by Clk_TaskHandler(), if the application runs it.
+*
+*            (2) FS_BSP_Dly_ms() is the uC/FS BSP delay (see 'fs.h').
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "sim.h"
+
+#include  <Source/clk.h>
+#include  <Source/fs.h>
+
+#include  <time.h>
+
+
+/*
+*********************************************************************************************************
+*                                           Clk_OS_Init()
+*
+* Description : Initialize the clock OS port & set the clock from the host time.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               CLK_OS_ERR_NONE     Clock OS port initialized.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Clk_Init().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Clk_OS_Init (CLK_ERR  *p_err)
+{
+    (void)Clk_SetTS_Unix((CLK_TS_SEC)time(DEF_NULL));
+
+   *p_err = CLK_OS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Clk_OS_Wait()
+*
+* Description : Wait for the next clock second.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               CLK_OS_ERR_NONE     One second elapsed.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Clk_TaskHandler().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Clk_OS_Wait (CLK_ERR  *p_err)
+{
+    Sim_DlyUs(1000000u);
+
+   *p_err = CLK_OS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Clk_OS_Signal()
+*
+* Description : Signal a clock second.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               CLK_OS_ERR_NONE     Clock signaled.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Clk_SignalClk().
+*
+* Note(s)     : (1) Seconds are timed by Clk_OS_Wait(); there is nothing to signal.
+*********************************************************************************************************
+*/
+
+void  Clk_OS_Signal (CLK_ERR  *p_err)
+{
+   *p_err = CLK_OS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FS_BSP_Dly_ms()
+*
+* Description : Delay for the specified time.
+*
+* Argument(s) : ms          Delay, in milliseconds.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : uC/FS device drivers.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  FS_BSP_Dly_ms (CPU_INT16U  ms)
+{
+    Sim_DlyUs((CPU_INT32U)ms * 1000u);
+}
@@ -0,0 +1,1781 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_flash.c
+*
+* Note(s)  : (1) Simulated NAND & NOR flash backed by a memory-mapped image file, so that the uC/FS NAND
+*                & NOR drivers ('fs_dev_nand.c', 'fs_dev_nor.c') run unchanged on the host :
+*
+*                (a) NAND : a BSP for the generic controller ('fs_dev_nand_ctrlr_gen.c') decodes the ONFI
+*                    command, address & data cycles of a large page device, with a data & a cache
+*                    register, so that cache read (31h/3Fh) & cache program (15h) are modeled.  Page
+*                    programs AND data into the array, as many times as SIM_NAND_NBR_PGM_PER_PG.
+*
+*                (b) NOR  : a physical-layer driver for a serial NOR with SIM_NOR_BLK_SIZE octet blocks.
+*                    Writes AND data into the array; writes that would set bits are counted.  Runs of
+*                    physically contiguous sectors are read as one strided burst (RdMulti()), as a
+*                    QSPI fast read with DMA would.
+*
+*            (2) Time is simulated, not measured : every operation advances a virtual clock by its
+*                typical datasheet latency (SIM_NAND_T_xxx, SIM_NOR_T_xxx) & every bus transfer by its
+*                cycle time.  With cache commands, the array operation of one page overlaps the transfer
+*                of the next one.
+*
+*            (3) The image holds the array (with the spare area of each page, for NAND) followed by the
+*                erase count of each block.  An existing image of the right size is re-used, so that
+*                wear accumulates across runs; otherwise it is erased & factory bad blocks are marked.
+*
+*            (4) NAND failure model :
+*
+*                (a) Factory bad blocks have spare octet 0 of their first page cleared & fail every
+*                    program & erase.
+*
+*                (b) Each block wears out after 75 to 125 % of the rated endurance : erases then fail
+*                    & programs of blocks past 90 % of it fail once in SIM_NAND_WORN_PGM_FAIL_RATE.
+*
+*                (c) Bits of the main area flip when a page is loaded in the data register, on average
+*                    'FlipPPM' times per million page loads on a new block & up to 4 times more on a worn
+*                    out one.  Flips are transient (not written back to the array).
+*
+*            (5) The ECC extension (Sim_NAND_ECC) stores, per sector, a SIM_NAND_ECC_SIZE octet single
+*                error correcting, double error detecting code over the sector & its OOS data : the XOR of
+*                the (1-based) index of every set bit, plus the parity of the set bits.  It is offset so
+*                that an erased sector has an erased code.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "sim_flash.h"
+
+#include  <cpu_core.h>
+#include  <lib_mem.h>
+
+#include  <fcntl.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <sys/mman.h>
+#include  <sys/stat.h>
+#include  <unistd.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+                                                                /* ------------------ NAND TIMINGS -------------------- */
+#define  SIM_NAND_T_R_NS                               25000u   /* Pg load.                                             */
+#define  SIM_NAND_T_PROG_NS                           200000u   /* Pg pgm.                                              */
+#define  SIM_NAND_T_BERS_NS                          1500000u   /* Blk erase.                                           */
+#define  SIM_NAND_T_CBSY_NS                             3000u   /* Cache reg busy, with cache cmds.                     */
+#define  SIM_NAND_T_CYCLE_NS                              25u   /* Cmd, addr or data octet bus cycle.                   */
+
+                                                                /* ------------------- NAND DEVICE -------------------- */
+#define  SIM_NAND_PG_STRIDE                 (SIM_NAND_PG_SIZE + SIM_NAND_SPARE_SIZE)
+#define  SIM_NAND_COL_ADDR_SIZE                            2u
+#define  SIM_NAND_ADDR_MAX_LEN                             5u
+
+#define  SIM_NAND_SR_WP                           DEF_BIT_07    /* Not write protected.                                 */
+#define  SIM_NAND_SR_RDY                          DEF_BIT_06    /* Cache reg rdy.                                       */
+#define  SIM_NAND_SR_ARDY                         DEF_BIT_05    /* Array rdy.                                           */
+#define  SIM_NAND_SR_CACHE_FAIL                   DEF_BIT_01
+#define  SIM_NAND_SR_FAIL                         DEF_BIT_00
+
+#define  SIM_NAND_OUT_DATA                                 0u   /* Data output modes.                                   */
+#define  SIM_NAND_OUT_STATUS                               1u
+#define  SIM_NAND_OUT_ID                                   2u
+
+#define  SIM_NAND_WORN_PGM_FAIL_RATE                     256u   /* See Note #4b.                                        */
+#define  SIM_NAND_FLIP_WEAR_FACTOR                         3u   /* See Note #4c.                                        */
+#define  SIM_NAND_FLIP_MAX                                 4u   /* Max nbr of flips per pg load.                        */
+
+#define  SIM_NAND_ECC_SIZE                                 2u   /* See Note #5.                                         */
+#define  SIM_NAND_ECC_PARITY_BIT                  DEF_BIT_15
+#define  SIM_NAND_ECC_IX_MASK                         0x7FFFu
+
+                                                                /* ------------------- NOR TIMINGS -------------------- */
+#define  SIM_NOR_T_RD_NS                                1000u   /* Rd cmd & addr.                                       */
+#define  SIM_NOR_T_RD_OCTET_NS                            10u
+#define  SIM_NOR_T_PP_NS                              400000u   /* Pg pgm.                                              */
+#define  SIM_NOR_T_BE_NS                           150000000u   /* Blk erase.                                           */
+#define  SIM_NOR_PG_SIZE                                 256u
+
+#define  SIM_FLASH_BLK_FACTORY_BAD                DEF_BIT_00    /* Blk flags.                                           */
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  sim_nand {
+    CPU_INT08U   RegData[SIM_NAND_PG_STRIDE];                   /* Data  reg (array side).                              */
+    CPU_INT08U   RegCache[SIM_NAND_PG_STRIDE];                  /* Cache reg (bus   side).                              */
+    CPU_INT32U   Col;
+    CPU_INT32U   Row;
+    CPU_INT32U   PgmMainOctets;                                 /* Main area octets loaded since pgm setup.             */
+    CPU_INT64U   RdyTimeNs;                                     /* Time at which cache reg is rdy.                      */
+    CPU_INT64U   ArrayRdyTimeNs;                                /* Time at which array     is rdy.                      */
+    CPU_INT08U   CmdLast;
+    CPU_INT08U   OutMode;
+    CPU_INT08U   IdIx;
+    CPU_INT08U   SR_Fail;                                       /* Fail bits of cur pgm or erase.                       */
+    CPU_BOOLEAN  CachePgmPend;                                  /* Cache pgm in progress.                               */
+    CPU_INT08U  *PgmCntTbl;                                     /* Nbr of pgms of each pg since erased.                 */
+} SIM_NAND;
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  const  CPU_INT08U  Sim_NAND_ID[] = { 0x2Cu, 0xDAu, 0x90u, 0x95u, 0x06u };
+
+static  const  FS_NAND_FREE_SPARE_DATA  Sim_NAND_FreeSpareMap[] = {
+    { 1u,                                    SIM_NAND_SPARE_SIZE - 1u             },   /* Octet 0 is the defect mark.      */
+    { (FS_NAND_PG_SIZE)-1,                   (FS_NAND_PG_SIZE)-1                  }
+};
+
+static  SIM_FLASH_STAT   Sim_FlashStat;
+static  CPU_INT08U      *Sim_FlashImgPtr;                       /* Mapped image (see Note #3).                          */
+static  CPU_SIZE_T       Sim_FlashImgSize;
+static  CPU_INT32U       Sim_FlashBlkSize;                      /* Size of blk in array, in octets.                     */
+static  CPU_INT08U      *Sim_FlashBlkFlagTbl;
+static  CPU_INT32U       Sim_FlashEndurance;
+static  CPU_INT32U       Sim_FlashFlipPPM;
+static  unsigned  int    Sim_FlashSeed;
+
+static  SIM_NAND         Sim_NAND;
+static  CPU_INT32U       Sim_NAND_ECC_Erased;                   /* Code of an erased sec (see Note #5).                 */
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Sim_FlashOpen          (const  SIM_FLASH_CFG  *p_cfg,
+                                             CPU_INT32U             blk_cnt,
+                                             CPU_INT32U             blk_size);
+
+static  CPU_INT32U   Sim_FlashBlkLimit      (CPU_INT32U             blk_ix);
+
+static  void         Sim_FlashWait          (CPU_INT64U             rdy_time_ns);
+
+                                                                /* ---------------------- NAND BSP ---------------------- */
+static  void         Sim_NAND_BSP_Open      (FS_ERR                *p_err);
+
+static  void         Sim_NAND_BSP_Close     (void);
+
+static  void         Sim_NAND_BSP_ChipSelEn (void);
+
+static  void         Sim_NAND_BSP_ChipSelDis(void);
+
+static  void         Sim_NAND_BSP_CmdWr     (CPU_INT08U            *p_cmd,
+                                             CPU_SIZE_T             cnt,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NAND_BSP_AddrWr    (CPU_INT08U            *p_addr,
+                                             CPU_SIZE_T             cnt,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NAND_BSP_DataWr    (void                  *p_src,
+                                             CPU_SIZE_T             cnt,
+                                             CPU_INT08U             width,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NAND_BSP_DataRd    (void                  *p_dest,
+                                             CPU_SIZE_T             cnt,
+                                             CPU_INT08U             width,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NAND_BSP_WaitWhileBusy(void               *poll_fcnt_arg,
+                                                CPU_BOOLEAN       (*poll_fcnt)(void  *arg),
+                                                CPU_INT32U          to_us,
+                                                FS_ERR             *p_err);
+
+static  void         Sim_NAND_Cmd           (CPU_INT08U             cmd);
+
+static  CPU_INT08U   Sim_NAND_StatusGet     (void);
+
+static  void         Sim_NAND_PgLoad        (void);
+
+static  void         Sim_NAND_PgPgm         (void);
+
+static  void         Sim_NAND_BlkErase      (void);
+
+                                                                /* ---------------------- NAND ECC ---------------------- */
+static  void         Sim_NAND_ECC_Init      (FS_ERR                *p_err);
+
+static  FS_NAND_PG_SIZE  Sim_NAND_ECC_Setup (FS_NAND_CTRLR_GEN_DATA  *p_ctrlr_data,
+                                             void                    *p_ext_data,
+                                             FS_ERR                  *p_err);
+
+static  void         Sim_NAND_ECC_Calc      (void                  *p_ext_data,
+                                             void                  *p_sec_buf,
+                                             void                  *p_oos_buf,
+                                             FS_NAND_PG_SIZE        oos_size,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NAND_ECC_Verify    (void                  *p_ext_data,
+                                             void                  *p_sec_buf,
+                                             void                  *p_oos_buf,
+                                             FS_NAND_PG_SIZE        oos_size,
+                                             FS_ERR                *p_err);
+
+static  void        *Sim_NAND_ECC_Open      (FS_NAND_CTRLR_GEN_DATA  *p_ctrlr_data,
+                                             void                    *p_ext_cfg,
+                                             FS_ERR                  *p_err);
+
+static  CPU_INT32U   Sim_NAND_ECC_CodeCalc  (CPU_INT08U            *p_sec_buf,
+                                             CPU_INT32U             sec_size,
+                                             CPU_INT08U            *p_oos_buf,
+                                             CPU_INT32U             oos_size);
+
+                                                                /* ---------------------- NOR PHY ----------------------- */
+static  void         Sim_NOR_Open           (FS_DEV_NOR_PHY_DATA   *p_phy_data,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NOR_Close          (FS_DEV_NOR_PHY_DATA   *p_phy_data);
+
+static  void         Sim_NOR_Rd             (FS_DEV_NOR_PHY_DATA   *p_phy_data,
+                                             void                  *p_dest,
+                                             CPU_INT32U             start,
+                                             CPU_INT32U             cnt,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NOR_Wr             (FS_DEV_NOR_PHY_DATA   *p_phy_data,
+                                             void                  *p_src,
+                                             CPU_INT32U             start,
+                                             CPU_INT32U             cnt,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NOR_EraseBlk       (FS_DEV_NOR_PHY_DATA   *p_phy_data,
+                                             CPU_INT32U             start,
+                                             CPU_INT32U             size,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NOR_IO_Ctrl        (FS_DEV_NOR_PHY_DATA   *p_phy_data,
+                                             CPU_INT08U             cmd,
+                                             void                  *p_buf,
+                                             FS_ERR                *p_err);
+
+static  void         Sim_NOR_RdMulti        (FS_DEV_NOR_PHY_DATA   *p_phy_data,
+                                             void                  *p_dest,
+                                             CPU_INT32U             start,
+                                             CPU_INT32U             cnt,
+                                             CPU_INT32U             stride,
+                                             CPU_INT32U             nbr,
+                                             FS_ERR                *p_err);
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+FS_NAND_CTRLR_GEN_BSP_API  Sim_NAND_BSP = {
+    Sim_NAND_BSP_Open,
+    Sim_NAND_BSP_Close,
+    Sim_NAND_BSP_ChipSelEn,
+    Sim_NAND_BSP_ChipSelDis,
+    Sim_NAND_BSP_CmdWr,
+    Sim_NAND_BSP_AddrWr,
+    Sim_NAND_BSP_DataWr,
+    Sim_NAND_BSP_DataRd,
+    Sim_NAND_BSP_WaitWhileBusy
+};
+
+FS_NAND_CTRLR_GEN_EXT  Sim_NAND_ECC = {
+    Sim_NAND_ECC_Init,                                          /* Init().                                              */
+    Sim_NAND_ECC_Open,                                          /* Open().                                              */
+    DEF_NULL,                                                   /* Close().                                             */
+    Sim_NAND_ECC_Setup,                                         /* Setup().                                             */
+    DEF_NULL,                                                   /* RdStatusChk() : allows cache rds.                    */
+    Sim_NAND_ECC_Calc,                                          /* ECC_Calc().                                          */
+    Sim_NAND_ECC_Verify                                         /* ECC_Verify().                                        */
+};
+
+FS_DEV_NOR_PHY_API  Sim_NOR_Phy = {
+    Sim_NOR_Open,
+    Sim_NOR_Close,
+    Sim_NOR_Rd,
+    Sim_NOR_Wr,
+    Sim_NOR_EraseBlk,
+    Sim_NOR_IO_Ctrl,
+    Sim_NOR_RdMulti
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Sim_NAND_Init()
+*
+* Description : Map the NAND image & get the configuration of the static part that describes it.
+*
+* Argument(s) : p_cfg       Pointer to simulated flash configuration.  'Size' is rounded down to whole blocks.
+*
+*               p_part_cfg  Pointer to variable that will receive the static part configuration.
+*
+* Return(s)   : DEF_OK,   if the image is mapped.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The part supports cache program & cache read, so that the multi-sector operations of the
+*                   generic controller are pipelined (see Note #1a).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Sim_NAND_Init (const  SIM_FLASH_CFG            *p_cfg,
+                                   FS_NAND_PART_STATIC_CFG  *p_part_cfg)
+{
+    CPU_INT32U   blk_cnt;
+    CPU_INT32U   blk_ix;
+    CPU_INT32U   bad_cnt;
+    CPU_INT08U  *p_spare;
+
+
+    blk_cnt = p_cfg->Size / (SIM_NAND_PG_SIZE * SIM_NAND_PG_PER_BLK);
+    if ((blk_cnt < 16u) ||
+        (p_cfg->BadBlkCnt > blk_cnt / 8u)) {
+        fprintf(stderr, "invalid NAND geometry: %u blks, %u bad\n", (unsigned)blk_cnt, (unsigned)p_cfg->BadBlkCnt);
+        return (DEF_FAIL);
+    }
+
+    Mem_Clr(&Sim_NAND, sizeof(Sim_NAND));
+    Sim_NAND.PgmCntTbl = (CPU_INT08U *)calloc(blk_cnt * SIM_NAND_PG_PER_BLK, sizeof(CPU_INT08U));
+    if (Sim_NAND.PgmCntTbl == DEF_NULL) {
+        fprintf(stderr, "out of memory\n");
+        return (DEF_FAIL);
+    }
+    if (Sim_FlashOpen(p_cfg, blk_cnt, SIM_NAND_PG_STRIDE * SIM_NAND_PG_PER_BLK) != DEF_OK) {
+        return (DEF_FAIL);
+    }
+
+                                                                /* ------------- MARK FACTORY BAD BLKS ---------------- */
+    if (Sim_FlashStat.EraseCtr != 0u) {                         /* New image (see Sim_FlashOpen() Note #1).             */
+        bad_cnt = 0u;
+        while (bad_cnt < p_cfg->BadBlkCnt) {
+            blk_ix  = 1u + ((CPU_INT32U)rand_r(&Sim_FlashSeed) % (blk_cnt - 1u));   /* Blk 0 is guaranteed good.        */
+            p_spare = Sim_FlashImgPtr + (blk_ix * Sim_FlashBlkSize) + SIM_NAND_PG_SIZE;
+            if (p_spare[0] != 0x00u) {
+                p_spare[0] = 0x00u;
+                bad_cnt++;
+            }
+        }
+    }
+    for (blk_ix = 0u; blk_ix < blk_cnt; blk_ix++) {
+        p_spare = Sim_FlashImgPtr + (blk_ix * Sim_FlashBlkSize) + SIM_NAND_PG_SIZE;
+        if (p_spare[0] == 0x00u) {
+            DEF_BIT_SET(Sim_FlashBlkFlagTbl[blk_ix], SIM_FLASH_BLK_FACTORY_BAD);
+            Sim_FlashStat.BadBlkCnt++;
+        }
+    }
+    Sim_FlashStat.EraseCtr = 0u;
+
+                                                                /* ------------------ PART CFG ------------------------ */
+   *p_part_cfg                  =  FS_NAND_PartStatic_DfltCfg;
+    p_part_cfg->BlkCnt          = (FS_NAND_BLK_QTY)blk_cnt;
+    p_part_cfg->PgPerBlk        =  SIM_NAND_PG_PER_BLK;
+    p_part_cfg->PgSize          =  SIM_NAND_PG_SIZE;
+    p_part_cfg->SpareSize       =  SIM_NAND_SPARE_SIZE;
+    p_part_cfg->NbrPgmPerPg     =  SIM_NAND_NBR_PGM_PER_PG;
+    p_part_cfg->BusWidth        =  8u;
+    p_part_cfg->ECC_NbrCorrBits =  1u;
+    p_part_cfg->ECC_CodewordSize=  512u;
+    p_part_cfg->DefectMarkType  =  DEFECT_SPARE_L_1_PG_1_OR_N_ALL_0;
+    p_part_cfg->MaxBadBlkCnt    = (FS_NAND_BLK_QTY)(Sim_FlashStat.BadBlkCnt + (blk_cnt / 32u));
+    p_part_cfg->MaxBlkErase     =  Sim_FlashEndurance;
+    p_part_cfg->FreeSpareMap    = (FS_NAND_FREE_SPARE_DATA *)Sim_NAND_FreeSpareMap;
+    p_part_cfg->OptCmdFlags     =  FS_NAND_PART_OPT_CMD_CACHE_PGM |
+                                   FS_NAND_PART_OPT_CMD_CACHE_RD;   /* See Note #1.                                     */
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Sim_NOR_Init()
+*
+* Description : Map the NOR image & get the NOR device configuration that describes it.
+*
+* Argument(s) : p_cfg       Pointer to simulated flash configuration.  'Size' is rounded down to whole blocks.
+*
+*               p_nor_cfg   Pointer to variable that will receive the NOR device configuration.
+*
+* Return(s)   : DEF_OK,   if the image is mapped.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Sim_NOR_Init (const  SIM_FLASH_CFG   *p_cfg,
+                                  FS_DEV_NOR_CFG  *p_nor_cfg)
+{
+    CPU_INT32U  blk_cnt;
+
+
+    blk_cnt = p_cfg->Size / SIM_NOR_BLK_SIZE;
+    if (blk_cnt < 8u) {
+        fprintf(stderr, "invalid NOR geometry: %u blks\n", (unsigned)blk_cnt);
+        return (DEF_FAIL);
+    }
+    if (Sim_FlashOpen(p_cfg, blk_cnt, SIM_NOR_BLK_SIZE) != DEF_OK) {
+        return (DEF_FAIL);
+    }
+    Sim_FlashStat.EraseCtr = 0u;
+
+    Mem_Clr(p_nor_cfg, sizeof(FS_DEV_NOR_CFG));
+    p_nor_cfg->AddrBase    =  0u;                               /* Serial flash.                                        */
+    p_nor_cfg->RegionNbr   =  0u;
+    p_nor_cfg->AddrStart   =  0u;
+    p_nor_cfg->DevSize     =  blk_cnt * SIM_NOR_BLK_SIZE;
+    p_nor_cfg->SecSize     =  512u;
+    p_nor_cfg->PhyPtr      = &Sim_NOR_Phy;
+    p_nor_cfg->BusWidth    =  8u;
+    p_nor_cfg->BusWidthMax =  8u;
+    p_nor_cfg->PhyDevCnt   =  1u;
+    p_nor_cfg->Endurance   =  p_cfg->Endurance;
+    p_nor_cfg->AddrMap     = (CPU_ADDR)Sim_FlashImgPtr;         /* Image is the XIP window.                             */
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_FlashClose()
+*
+* Description : Write back & unmap the flash image.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Sim_FlashClose (void)
+{
+    if (Sim_FlashImgPtr == DEF_NULL) {
+        return;
+    }
+    (void)msync(Sim_FlashImgPtr, Sim_FlashImgSize, MS_SYNC);
+    (void)munmap(Sim_FlashImgPtr, Sim_FlashImgSize);
+    Sim_FlashImgPtr           = DEF_NULL;
+    Sim_FlashStat.EraseCntTbl = DEF_NULL;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Sim_FlashStatReset()
+*
+* Description : Clear the statistics counters of the simulated flash.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The erase count of each block is part of the image & is kept.
+*********************************************************************************************************
+*/
+
+void  Sim_FlashStatReset (void)
+{
+    CPU_INT32U   blk_cnt;
+    CPU_INT32U   bad_blk_cnt;
+    CPU_INT32U  *p_erase_cnt_tbl;
+
+
+    blk_cnt         = Sim_FlashStat.BlkCnt;                     /* See Note #1.                                         */
+    bad_blk_cnt     = Sim_FlashStat.BadBlkCnt;
+    p_erase_cnt_tbl = Sim_FlashStat.EraseCntTbl;
+    Mem_Clr(&Sim_FlashStat, sizeof(Sim_FlashStat));
+    Sim_FlashStat.BlkCnt      = blk_cnt;
+    Sim_FlashStat.BadBlkCnt   = bad_blk_cnt;
+    Sim_FlashStat.EraseCntTbl = p_erase_cnt_tbl;
+    Sim_NAND.RdyTimeNs        = 0u;
+    Sim_NAND.ArrayRdyTimeNs   = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Sim_FlashStatGet()
+*
+* Description : Get the statistics of the simulated flash.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Pointer to statistics.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+const  SIM_FLASH_STAT  *Sim_FlashStatGet (void)
+{
+    return (&Sim_FlashStat);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Sim_FlashOpen()
+*
+* Description : Map the flash image (see Note #3).
+*
+* Argument(s) : p_cfg       Pointer to simulated flash configuration.
+*
+*               blk_cnt     Nbr of blocks.
+*
+*               blk_size    Size of each block in the image, in octets.
+*
+* Return(s)   : DEF_OK,   if the image is mapped.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Sim_NAND_Init(),
+*               Sim_NOR_Init().
+*
+* Note(s)     : (1) A new image is erased & 'EraseCtr' is set, to let the caller mark factory bad blocks.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Sim_FlashOpen (const  SIM_FLASH_CFG  *p_cfg,
+                                    CPU_INT32U             blk_cnt,
+                                    CPU_INT32U             blk_size)
+{
+    char         path[32];
+    struct stat  st;
+    CPU_BOOLEAN  new_img;
+    int          fd;
+
+
+    Sim_FlashClose();
+    Mem_Clr(&Sim_FlashStat, sizeof(Sim_FlashStat));
+    Sim_FlashBlkSize   = blk_size;
+    Sim_FlashEndurance = p_cfg->Endurance;
+    Sim_FlashFlipPPM   = p_cfg->FlipPPM;
+    Sim_FlashSeed      = p_cfg->Seed;
+    Sim_FlashImgSize   = ((CPU_SIZE_T)blk_cnt * blk_size) + (blk_cnt * sizeof(CPU_INT32U));
+
+    Sim_FlashBlkFlagTbl = (CPU_INT08U *)calloc(blk_cnt, sizeof(CPU_INT08U));
+    if (Sim_FlashBlkFlagTbl == DEF_NULL) {
+        fprintf(stderr, "out of memory\n");
+        return (DEF_FAIL);
+    }
+
+    if (p_cfg->ImgPathPtr == DEF_NULL) {                        /* Tmp image, deleted once mapped.                      */
+        (void)snprintf(path, sizeof(path), "/tmp/sim_flash.XXXXXX");
+        fd = mkstemp(path);
+        if (fd >= 0) {
+            (void)unlink(path);
+        }
+    } else {
+        fd = open(p_cfg->ImgPathPtr, O_RDWR | O_CREAT, 0644);
+    }
+    if (fd < 0) {
+        perror("flash image");
+        return (DEF_FAIL);
+    }
+
+    new_img = DEF_YES;
+    if ((fstat(fd, &st) == 0) &&
+        ((CPU_SIZE_T)st.st_size == Sim_FlashImgSize)) {
+        new_img = DEF_NO;
+    } else if (ftruncate(fd, (off_t)Sim_FlashImgSize) != 0) {
+        perror("flash image");
+        (void)close(fd);
+        return (DEF_FAIL);
+    }
+
+    Sim_FlashImgPtr = (CPU_INT08U *)mmap(DEF_NULL, Sim_FlashImgSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (Sim_FlashImgPtr == (CPU_INT08U *)MAP_FAILED) {
+        perror("flash image");
+        Sim_FlashImgPtr = DEF_NULL;
+        return (DEF_FAIL);
+    }
+
+    Sim_FlashStat.BlkCnt      =  blk_cnt;
+    Sim_FlashStat.EraseCntTbl = (CPU_INT32U *)(Sim_FlashImgPtr + ((CPU_SIZE_T)blk_cnt * blk_size));
+    if (new_img == DEF_YES) {                                   /* See Note #1.                                         */
+        Mem_Set(Sim_FlashImgPtr, 0xFFu, (CPU_SIZE_T)blk_cnt * blk_size);
+        Mem_Clr(Sim_FlashStat.EraseCntTbl, blk_cnt * sizeof(CPU_INT32U));
+        Sim_FlashStat.EraseCtr = 1u;
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Sim_FlashBlkLimit()
+*
+* Description : Get the nbr of erase cycles after which a block wears out (see Note #4b).
+*
+* Argument(s) : blk_ix      Block index.
+*
+* Return(s)   : Erase cycle limit.
+*
+* Caller(s)   : Sim_NAND_PgPgm(),
+*               Sim_NAND_BlkErase().
+*
+* Note(s)     : (1) The limit only depends on the block index & the seed, so that it is the same in every run.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Sim_FlashBlkLimit (CPU_INT32U  blk_ix)
+{
+    CPU_INT32U  hash;
+
+
+    hash  = (blk_ix + 1u) * 2654435761u;                        /* See Note #1.                                         */
+    hash ^= (CPU_INT32U)Sim_FlashSeed;
+    hash ^= hash >> 15;
+
+    return ((CPU_INT32U)(((CPU_INT64U)Sim_FlashEndurance * (75u + (hash % 51u))) / 100u));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_FlashWait()
+*
+* Description : Advance the simulated time until the specified time (see Note #2).
+*
+* Argument(s) : rdy_time_ns     Time at which the device is ready.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Various.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  Sim_FlashWait (CPU_INT64U  rdy_time_ns)
+{
+    if (Sim_FlashStat.TimeNs < rdy_time_ns) {
+        Sim_FlashStat.TimeNs = rdy_time_ns;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                      NAND GENERIC CONTROLLER BSP
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_BSP_Open (FS_ERR  *p_err)
+{
+    if (Sim_FlashImgPtr == DEF_NULL) {                          /* Sim_NAND_Init() not called.                          */
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
+    Sim_NAND_Cmd(0xFFu);
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+static  void  Sim_NAND_BSP_Close (void)
+{
+}
+
+
+static  void  Sim_NAND_BSP_ChipSelEn (void)
+{
+}
+
+
+static  void  Sim_NAND_BSP_ChipSelDis (void)
+{
+}
+
+
+static  void  Sim_NAND_BSP_CmdWr (CPU_INT08U  *p_cmd,
+                                  CPU_SIZE_T   cnt,
+                                  FS_ERR      *p_err)
+{
+    CPU_SIZE_T  ix;
+
+
+    for (ix = 0u; ix < cnt; ix++) {
+        Sim_FlashStat.TimeNs += SIM_NAND_T_CYCLE_NS;
+        Sim_NAND_Cmd(p_cmd[ix]);
+    }
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       Sim_NAND_BSP_AddrWr()
+*
+* Description : Write address cycles.
+*
+* Argument(s) : p_addr      Pointer to address octets, column first, least significant octet first.
+*
+*               cnt         Nbr of address octets.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE     Address written.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Generic controller (see 'fs_dev_nand_ctrlr_gen.c  AddrFmt()').
+*
+* Note(s)     : (1) The command before the address determines its format : column & row (00h, 80h), column
+*                   only (05h, 85h), row only (60h) or a single octet (90h).
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_BSP_AddrWr (CPU_INT08U  *p_addr,
+                                   CPU_SIZE_T   cnt,
+                                   FS_ERR      *p_err)
+{
+    CPU_INT32U  col;
+    CPU_INT32U  row;
+    CPU_SIZE_T  ix;
+
+
+    Sim_FlashStat.TimeNs += cnt * SIM_NAND_T_CYCLE_NS;
+   *p_err                 = FS_ERR_NONE;
+
+    col = 0u;
+    row = 0u;
+    switch (Sim_NAND.CmdLast) {                                 /* See Note #1.                                         */
+        case 0x00u:
+        case 0x80u:
+        case 0x05u:
+        case 0x85u:
+             for (ix = 0u; (ix < cnt) && (ix < SIM_NAND_COL_ADDR_SIZE); ix++) {
+                 col |= (CPU_INT32U)p_addr[ix] << (ix * DEF_OCTET_NBR_BITS);
+             }
+             for (ix = SIM_NAND_COL_ADDR_SIZE; ix < cnt; ix++) {
+                 row |= (CPU_INT32U)p_addr[ix] << ((ix - SIM_NAND_COL_ADDR_SIZE) * DEF_OCTET_NBR_BITS);
+             }
+             Sim_NAND.Col = col;
+             if (cnt > SIM_NAND_COL_ADDR_SIZE) {
+                 Sim_NAND.Row = row;
+             }
+             break;
+
+
+        case 0x60u:
+             for (ix = 0u; ix < cnt; ix++) {
+                 row |= (CPU_INT32U)p_addr[ix] << (ix * DEF_OCTET_NBR_BITS);
+             }
+             Sim_NAND.Row = row;
+             break;
+
+
+        case 0x90u:
+        default:
+             Sim_NAND.IdIx = 0u;
+             break;
+    }
+}
+
+
+static  void  Sim_NAND_BSP_DataWr (void        *p_src,
+                                   CPU_SIZE_T   cnt,
+                                   CPU_INT08U   width,
+                                   FS_ERR      *p_err)
+{
+    CPU_SIZE_T  len;
+
+
+    (void)width;
+    Sim_FlashStat.TimeNs += cnt * SIM_NAND_T_CYCLE_NS;
+   *p_err                 = FS_ERR_NONE;
+
+    if (Sim_NAND.Col >= SIM_NAND_PG_STRIDE) {
+        return;
+    }
+    len = DEF_MIN(cnt, SIM_NAND_PG_STRIDE - Sim_NAND.Col);
+    Mem_Copy(&Sim_NAND.RegCache[Sim_NAND.Col], p_src, len);
+    if (Sim_NAND.Col < SIM_NAND_PG_SIZE) {
+        Sim_NAND.PgmMainOctets += DEF_MIN(len, SIM_NAND_PG_SIZE - Sim_NAND.Col);
+    }
+    Sim_NAND.Col += (CPU_INT32U)len;
+}
+
+
+static  void  Sim_NAND_BSP_DataRd (void        *p_dest,
+                                   CPU_SIZE_T   cnt,
+                                   CPU_INT08U   width,
+                                   FS_ERR      *p_err)
+{
+    CPU_INT08U  *p_dest_08;
+    CPU_SIZE_T   ix;
+
+
+    (void)width;
+    p_dest_08              = (CPU_INT08U *)p_dest;
+    Sim_FlashStat.TimeNs  += cnt * SIM_NAND_T_CYCLE_NS;
+   *p_err                  = FS_ERR_NONE;
+
+    for (ix = 0u; ix < cnt; ix++) {
+        switch (Sim_NAND.OutMode) {
+            case SIM_NAND_OUT_STATUS:
+                 p_dest_08[ix] = Sim_NAND_StatusGet();
+                 break;
+
+
+            case SIM_NAND_OUT_ID:
+                 p_dest_08[ix] = (Sim_NAND.IdIx < sizeof(Sim_NAND_ID)) ? Sim_NAND_ID[Sim_NAND.IdIx] : 0xFFu;
+                 Sim_NAND.IdIx++;
+                 break;
+
+
+            case SIM_NAND_OUT_DATA:
+            default:
+                 p_dest_08[ix] = (Sim_NAND.Col < SIM_NAND_PG_STRIDE) ? Sim_NAND.RegCache[Sim_NAND.Col] : 0xFFu;
+                 Sim_NAND.Col++;
+                 Sim_FlashStat.RdOctets++;
+                 break;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                   Sim_NAND_BSP_WaitWhileBusy()
+*
+* Description : Wait until the cache register is ready.
+*
+* Argument(s) : poll_fcnt_arg   Argument of poll function.
+*
+*               poll_fcnt       Function that returns DEF_YES once the device is ready.
+*
+*               to_us           Timeout, in microseconds.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_DEV_TIMEOUT  Device not ready before timeout.
+*                                   FS_ERR_NONE         Device ready.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Generic controller.
+*
+* Note(s)     : (1) The simulated time jumps to the end of the busy period, then the status is polled once.
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_BSP_WaitWhileBusy (void          *poll_fcnt_arg,
+                                          CPU_BOOLEAN  (*poll_fcnt)(void  *arg),
+                                          CPU_INT32U     to_us,
+                                          FS_ERR        *p_err)
+{
+    CPU_INT64U  to_time_ns;
+
+
+    to_time_ns = Sim_FlashStat.TimeNs + ((CPU_INT64U)to_us * 1000u);
+    if (Sim_NAND.RdyTimeNs > to_time_ns) {
+        Sim_FlashWait(to_time_ns);
+       *p_err = FS_ERR_DEV_TIMEOUT;
+        return;
+    }
+
+    Sim_FlashWait(Sim_NAND.RdyTimeNs);                          /* See Note #1.                                         */
+    if (poll_fcnt(poll_fcnt_arg) != DEF_YES) {
+       *p_err = FS_ERR_DEV_TIMEOUT;
+        return;
+    }
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_NAND_Cmd()
+*
+* Description : Execute a NAND command cycle.
+*
+* Argument(s) : cmd         Command.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_NAND_BSP_Open(),
+*               Sim_NAND_BSP_CmdWr().
+*
+* Note(s)     : (1) An array operation waits for the previous one to complete.  With cache commands (31h,
+*                   3Fh, 15h), the cache register is ready shortly after, while the array operation goes
+*                   on (see Note #2).
+*
+*               (2) The fail bits of a cache program sequence are kept until its last program (10h) has
+*                   been checked.
+*
+*               (3) 00h alone switches the data output back from the status register.
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_Cmd (CPU_INT08U  cmd)
+{
+    switch (cmd) {
+        case 0xFFu:                                             /* Reset.                                               */
+             Sim_FlashWait(Sim_NAND.ArrayRdyTimeNs);
+             Sim_NAND.OutMode      = SIM_NAND_OUT_DATA;
+             Sim_NAND.SR_Fail      = 0u;
+             Sim_NAND.CachePgmPend = DEF_NO;
+             Sim_NAND.Col          = 0u;
+             break;
+
+
+        case 0x90u:                                             /* Rd ID.                                               */
+             Sim_NAND.OutMode = SIM_NAND_OUT_ID;
+             Sim_NAND.IdIx    = 0u;
+             break;
+
+
+        case 0x70u:                                             /* Rd status.                                           */
+             Sim_NAND.OutMode = SIM_NAND_OUT_STATUS;
+             break;
+
+
+        case 0x00u:                                             /* Rd setup (see Note #3).                              */
+        case 0x05u:                                             /* Change rd col.                                       */
+        case 0xE0u:
+             Sim_NAND.OutMode = SIM_NAND_OUT_DATA;
+             break;
+
+
+        case 0x30u:                                             /* Rd pg.                                               */
+             Sim_FlashWait(Sim_NAND.ArrayRdyTimeNs);
+             Sim_NAND_PgLoad();
+             Mem_Copy(Sim_NAND.RegCache, Sim_NAND.RegData, SIM_NAND_PG_STRIDE);
+             Sim_NAND.ArrayRdyTimeNs = Sim_FlashStat.TimeNs + SIM_NAND_T_R_NS;
+             Sim_NAND.RdyTimeNs      = Sim_NAND.ArrayRdyTimeNs;
+             Sim_NAND.SR_Fail        = 0u;
+             break;
+
+
+        case 0x31u:                                             /* Cache rd : output pg & load nxt (see Note #1).       */
+             Sim_FlashWait(Sim_NAND.ArrayRdyTimeNs);
+             Mem_Copy(Sim_NAND.RegCache, Sim_NAND.RegData, SIM_NAND_PG_STRIDE);
+             Sim_NAND.Row++;
+             Sim_NAND_PgLoad();
+             Sim_FlashStat.CacheRdCtr++;
+             Sim_NAND.ArrayRdyTimeNs = Sim_FlashStat.TimeNs + SIM_NAND_T_R_NS;
+             Sim_NAND.RdyTimeNs      = Sim_FlashStat.TimeNs + SIM_NAND_T_CBSY_NS;
+             Sim_NAND.Col            = 0u;
+             break;
+
+
+        case 0x3Fu:                                             /* Cache rd end.                                        */
+             Sim_FlashWait(Sim_NAND.ArrayRdyTimeNs);
+             Mem_Copy(Sim_NAND.RegCache, Sim_NAND.RegData, SIM_NAND_PG_STRIDE);
+             Sim_NAND.RdyTimeNs = Sim_FlashStat.TimeNs + SIM_NAND_T_CBSY_NS;
+             Sim_NAND.Col       = 0u;
+             break;
+
+
+        case 0x80u:                                             /* Pgm setup.                                           */
+             if (Sim_NAND.CachePgmPend == DEF_NO) {             /* See Note #2.                                         */
+                 Sim_NAND.SR_Fail = 0u;
+             }
+             Mem_Set(Sim_NAND.RegCache, 0xFFu, SIM_NAND_PG_STRIDE);
+             Sim_NAND.PgmMainOctets = 0u;
+             Sim_NAND.OutMode       = SIM_NAND_OUT_DATA;
+             break;
+
+
+        case 0x10u:                                             /* Pgm.                                                 */
+        case 0x15u:                                             /* Cache pgm.                                           */
+             Sim_FlashWait(Sim_NAND.ArrayRdyTimeNs);
+             Mem_Copy(Sim_NAND.RegData, Sim_NAND.RegCache, SIM_NAND_PG_STRIDE);
+             Sim_NAND_PgPgm();
+             Sim_NAND.ArrayRdyTimeNs = Sim_FlashStat.TimeNs + SIM_NAND_T_PROG_NS;
+             if (cmd == 0x15u) {
+                 Sim_FlashStat.CachePgmCtr++;
+                 Sim_NAND.RdyTimeNs    = Sim_FlashStat.TimeNs + SIM_NAND_T_CBSY_NS;
+                 Sim_NAND.CachePgmPend = DEF_YES;
+             } else {
+                 Sim_NAND.RdyTimeNs    = Sim_NAND.ArrayRdyTimeNs;
+                 Sim_NAND.CachePgmPend = DEF_NO;
+             }
+             break;
+
+
+        case 0x60u:                                             /* Erase setup.                                         */
+             Sim_NAND.SR_Fail      = 0u;
+             Sim_NAND.CachePgmPend = DEF_NO;
+             break;
+
+
+        case 0xD0u:                                             /* Erase.                                               */
+             Sim_FlashWait(Sim_NAND.ArrayRdyTimeNs);
+             Sim_NAND_BlkErase();
+             Sim_NAND.ArrayRdyTimeNs = Sim_FlashStat.TimeNs + SIM_NAND_T_BERS_NS;
+             Sim_NAND.RdyTimeNs      = Sim_NAND.ArrayRdyTimeNs;
+             break;
+
+
+        case 0x85u:                                             /* Change wr col.                                       */
+        default:
+             break;
+    }
+
+    Sim_NAND.CmdLast = cmd;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       Sim_NAND_StatusGet()
+*
+* Description : Get the status register value at the current simulated time.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Status register value.
+*
+* Caller(s)   : Sim_NAND_BSP_DataRd().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Sim_NAND_StatusGet (void)
+{
+    CPU_INT08U  sr;
+
+
+    sr = SIM_NAND_SR_WP | Sim_NAND.SR_Fail;
+    if (Sim_FlashStat.TimeNs >= Sim_NAND.RdyTimeNs) {
+        DEF_BIT_SET(sr, SIM_NAND_SR_RDY);
+    }
+    if (Sim_FlashStat.TimeNs >= Sim_NAND.ArrayRdyTimeNs) {
+        DEF_BIT_SET(sr, SIM_NAND_SR_ARDY);
+    }
+
+    return (sr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Sim_NAND_PgLoad()
+*
+* Description : Load the current row in the data register & flip bits (see Note #4c).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_NAND_Cmd().
+*
+* Note(s)     : (1) The probability is computed in flips per 10^6 loads, scaled up to
+*                   (1 + SIM_NAND_FLIP_WEAR_FACTOR) times as the block wears out.  Each further flip in
+*                   the same load has the same probability.
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_PgLoad (void)
+{
+    CPU_INT32U   blk_ix;
+    CPU_INT32U   erase_cnt;
+    CPU_INT64U   ppm;
+    CPU_INT32U   bit_ix;
+    CPU_INT32U   flip_cnt;
+
+
+    if (Sim_NAND.Row >= Sim_FlashStat.BlkCnt * SIM_NAND_PG_PER_BLK) {
+        Mem_Set(Sim_NAND.RegData, 0xFFu, SIM_NAND_PG_STRIDE);
+        return;
+    }
+
+    Mem_Copy(Sim_NAND.RegData,
+             Sim_FlashImgPtr + ((CPU_SIZE_T)Sim_NAND.Row * SIM_NAND_PG_STRIDE),
+             SIM_NAND_PG_STRIDE);
+    Sim_FlashStat.RdCtr++;
+
+    if (Sim_FlashFlipPPM == 0u) {
+        return;
+    }
+    blk_ix    = Sim_NAND.Row / SIM_NAND_PG_PER_BLK;             /* See Note #1.                                         */
+    erase_cnt = DEF_MIN(Sim_FlashStat.EraseCntTbl[blk_ix], Sim_FlashEndurance);
+    ppm       = (CPU_INT64U)Sim_FlashFlipPPM
+              + (((CPU_INT64U)Sim_FlashFlipPPM * SIM_NAND_FLIP_WEAR_FACTOR * erase_cnt) / DEF_MAX(Sim_FlashEndurance, 1u));
+    flip_cnt  = 0u;
+    while ((flip_cnt < SIM_NAND_FLIP_MAX) &&
+           ((CPU_INT64U)((CPU_INT32U)rand_r(&Sim_FlashSeed) % 1000000u) < ppm)) {
+        bit_ix = (CPU_INT32U)rand_r(&Sim_FlashSeed) % (SIM_NAND_PG_SIZE * DEF_OCTET_NBR_BITS);
+        Sim_NAND.RegData[bit_ix / DEF_OCTET_NBR_BITS] ^= (CPU_INT08U)(1u << (bit_ix % DEF_OCTET_NBR_BITS));
+        Sim_FlashStat.FlipCtr++;
+        flip_cnt++;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_NAND_PgPgm()
+*
+* Description : Program the data register in the current row (see Note #1a).
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_NAND_Cmd().
+*
+* Note(s)     : (1) A failed program (see Note #4) leaves the page unchanged & sets the fail bit; with cache
+*                   program, the previous page's status is reported as the cache program fail bit.
+*
+*               (2) Only programs that clear bits count towards the SIM_NAND_NBR_PGM_PER_PG partial page
+*                   programs : block copies by the FTL re-program unused sectors with erased data, which applies
+*                   no program pulse.
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_PgPgm (void)
+{
+    CPU_INT08U   *p_pg;
+    CPU_INT32U    blk_ix;
+    CPU_INT32U    limit;
+    CPU_INT32U    ix;
+    CPU_BOOLEAN   chngd;
+
+
+    if (Sim_NAND.SR_Fail != 0u) {                               /* See Note #1.                                         */
+        Sim_NAND.SR_Fail = SIM_NAND_SR_CACHE_FAIL;
+    }
+    if (Sim_NAND.Row >= Sim_FlashStat.BlkCnt * SIM_NAND_PG_PER_BLK) {
+        DEF_BIT_SET(Sim_NAND.SR_Fail, SIM_NAND_SR_FAIL);
+        return;
+    }
+
+    blk_ix = Sim_NAND.Row / SIM_NAND_PG_PER_BLK;
+    limit  = Sim_FlashBlkLimit(blk_ix);
+    Sim_FlashStat.PgmCtr++;
+    if ((DEF_BIT_IS_SET(Sim_FlashBlkFlagTbl[blk_ix], SIM_FLASH_BLK_FACTORY_BAD) == DEF_YES) ||
+        ((Sim_FlashStat.EraseCntTbl[blk_ix] * 10u >= limit * 9u) &&
+         (((CPU_INT32U)rand_r(&Sim_FlashSeed) % SIM_NAND_WORN_PGM_FAIL_RATE) == 0u))) {
+        DEF_BIT_SET(Sim_NAND.SR_Fail, SIM_NAND_SR_FAIL);
+        Sim_FlashStat.PgmFailCtr++;
+        return;
+    }
+
+    p_pg = Sim_FlashImgPtr + ((CPU_SIZE_T)Sim_NAND.Row * SIM_NAND_PG_STRIDE);
+    chngd = DEF_NO;
+    for (ix = 0u; ix < SIM_NAND_PG_STRIDE; ix++) {
+        if ((p_pg[ix] & Sim_NAND.RegData[ix]) != p_pg[ix]) {
+            p_pg[ix] &= Sim_NAND.RegData[ix];
+            chngd     = DEF_YES;
+        }
+    }
+    if (chngd == DEF_YES) {                                     /* See Note #2.                                         */
+        if (Sim_NAND.PgmCntTbl[Sim_NAND.Row] >= SIM_NAND_NBR_PGM_PER_PG) {
+            Sim_FlashStat.PgmViolCtr++;
+        } else {
+            Sim_NAND.PgmCntTbl[Sim_NAND.Row]++;
+        }
+        Sim_FlashStat.PgmOctets += Sim_NAND.PgmMainOctets;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Sim_NAND_BlkErase()
+*
+* Description : Erase the block of the current row.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_NAND_Cmd().
+*
+* Note(s)     : (1) Factory bad blocks & worn out blocks (see Note #4) fail to erase & are left unchanged.
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_BlkErase (void)
+{
+    CPU_INT32U  blk_ix;
+
+
+    blk_ix = Sim_NAND.Row / SIM_NAND_PG_PER_BLK;
+    if (blk_ix >= Sim_FlashStat.BlkCnt) {
+        DEF_BIT_SET(Sim_NAND.SR_Fail, SIM_NAND_SR_FAIL);
+        return;
+    }
+
+    Sim_FlashStat.EraseCtr++;
+    if ((DEF_BIT_IS_SET(Sim_FlashBlkFlagTbl[blk_ix], SIM_FLASH_BLK_FACTORY_BAD) == DEF_YES) ||
+        (Sim_FlashStat.EraseCntTbl[blk_ix] >= Sim_FlashBlkLimit(blk_ix))) {
+        DEF_BIT_SET(Sim_NAND.SR_Fail, SIM_NAND_SR_FAIL);        /* See Note #1.                                         */
+        Sim_FlashStat.EraseFailCtr++;
+        return;
+    }
+
+    Mem_Set(Sim_FlashImgPtr + ((CPU_SIZE_T)blk_ix * Sim_FlashBlkSize), 0xFFu, Sim_FlashBlkSize);
+    Mem_Clr(&Sim_NAND.PgmCntTbl[blk_ix * SIM_NAND_PG_PER_BLK], SIM_NAND_PG_PER_BLK);
+    Sim_FlashStat.EraseCntTbl[blk_ix]++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                     NAND GENERIC CONTROLLER ECC
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_ECC_Init (FS_ERR  *p_err)
+{
+   *p_err = FS_ERR_NONE;
+}
+
+
+static  void  *Sim_NAND_ECC_Open (FS_NAND_CTRLR_GEN_DATA  *p_ctrlr_data,
+                                  void                    *p_ext_cfg,
+                                  FS_ERR                  *p_err)
+{
+    (void)p_ext_cfg;
+
+   *p_err = FS_ERR_NONE;
+    return ((void *)p_ctrlr_data);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       Sim_NAND_ECC_Setup()
+*
+* Description : Reserve OOS space for the ECC & compute the code of an erased sector.
+*
+* Argument(s) : p_ctrlr_data    Pointer to NAND generic controller data.
+*
+*               p_ext_data      Pointer to extension data (unused).
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_DEV_INVALID_LOW_PARAMS   Sector too large for the ECC.
+*                                   FS_ERR_NONE                     ECC set up.
+*
+* Return(s)   : Nbr of octets of ECC per sector.
+*
+* Caller(s)   : Generic controller Setup().
+*
+* Note(s)     : (1) The code of an erased sector of N bits is the XOR of 1 to N, which is N, 1, N + 1 or 0
+*                   for N modulo 4 equal to 0, 1, 2 or 3, & the parity of N.
+*********************************************************************************************************
+*/
+
+static  FS_NAND_PG_SIZE  Sim_NAND_ECC_Setup (FS_NAND_CTRLR_GEN_DATA  *p_ctrlr_data,
+                                             void                    *p_ext_data,
+                                             FS_ERR                  *p_err)
+{
+    CPU_INT32U  bit_cnt;
+    CPU_INT32U  n_sec_per_pg;
+    CPU_INT32U  code;
+
+
+    (void)p_ext_data;
+
+    n_sec_per_pg = p_ctrlr_data->PartDataPtr->PgSize / p_ctrlr_data->SecSize;
+    bit_cnt      = (p_ctrlr_data->SecSize + (p_ctrlr_data->SpareTotalAvailSize / n_sec_per_pg)) * DEF_OCTET_NBR_BITS;
+    if (bit_cnt > SIM_NAND_ECC_IX_MASK) {
+       *p_err = FS_ERR_DEV_INVALID_LOW_PARAMS;
+        return (0u);
+    }
+
+    switch (bit_cnt % 4u) {                                     /* See Note #1.                                         */
+        case 0u:  code = bit_cnt;         break;
+        case 1u:  code = 1u;              break;
+        case 2u:  code = bit_cnt + 1u;    break;
+        default:  code = 0u;              break;
+    }
+    if ((bit_cnt % 2u) != 0u) {
+        DEF_BIT_SET(code, SIM_NAND_ECC_PARITY_BIT);
+    }
+    Sim_NAND_ECC_Erased = code;
+
+   *p_err = FS_ERR_NONE;
+    return (SIM_NAND_ECC_SIZE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Sim_NAND_ECC_Calc()
+*
+* Description : Compute the ECC of a sector & its OOS data & store it after the OOS data (see Note #5).
+*
+* Argument(s) : p_ext_data  Pointer to extension data (generic controller data).
+*
+*               p_sec_buf   Pointer to sector data.
+*
+*               p_oos_buf   Pointer to OOS data.
+*
+*               oos_size    Size of OOS data to protect in octets, excluding storage space for the ECC.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE     ECC computed.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Generic controller SecWr(), SecWrMulti().
+*
+* Note(s)     : (1) The ECC of a sector is only correct once the OOS size is the one the code of an erased
+*                   sector was computed for, i.e. the whole OOS of the sector.
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_ECC_Calc (void             *p_ext_data,
+                                 void             *p_sec_buf,
+                                 void             *p_oos_buf,
+                                 FS_NAND_PG_SIZE   oos_size,
+                                 FS_ERR           *p_err)
+{
+    FS_NAND_CTRLR_GEN_DATA  *p_ctrlr_data;
+    CPU_INT08U              *p_ecc;
+    CPU_INT32U               code;
+
+
+    p_ctrlr_data = (FS_NAND_CTRLR_GEN_DATA *)p_ext_data;
+    p_ecc        = (CPU_INT08U *)p_oos_buf + oos_size;
+
+    MEM_VAL_SET_INT16U_LITTLE(p_ecc, DEF_INT_16U_MAX_VAL);      /* See Sim_NAND_ECC_CodeCalc() Note #1.                 */
+    code  = Sim_NAND_ECC_CodeCalc((CPU_INT08U *)p_sec_buf,
+                                   p_ctrlr_data->SecSize,
+                                  (CPU_INT08U *)p_oos_buf,
+                                   oos_size + SIM_NAND_ECC_SIZE);
+    code ^= Sim_NAND_ECC_Erased ^ DEF_INT_16U_MAX_VAL;          /* See Note #5.                                         */
+    MEM_VAL_SET_INT16U_LITTLE(p_ecc, code);
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                       Sim_NAND_ECC_Verify()
+*
+* Description : Verify a sector & its OOS data against the ECC & correct a single bit error.
+*
+* Argument(s) : p_ext_data  Pointer to extension data (generic controller data).
+*
+*               p_sec_buf   Pointer to sector data.
+*
+*               p_oos_buf   Pointer to OOS data.
+*
+*               oos_size    Size of OOS data to protect in octets, excluding storage space for the ECC.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_ECC_CRITICAL_CORR    A bit error was corrected.
+*                               FS_ERR_ECC_UNCORR           Uncorrectable error.
+*                               FS_ERR_NONE                 No error.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Generic controller SecRd(), SecRdMulti().
+*
+* Note(s)     : (1) The ECC octets are covered by the code (as zeros, see Sim_NAND_ECC_CodeCalc()) so that
+*                   the code of an erased sector is that of its erased ECC.
+*
+*               (2) The syndrome is the XOR of the stored & computed codes : with the parity bit set, its
+*                   index part is the (1-based) index of the flipped bit.  An index of 0 means the parity bit
+*                   itself flipped.  Without the parity bit, an even number of bits flipped.
+*
+*               (3) The code corrects a single bit : a corrected sector should be refreshed.
+*********************************************************************************************************
+*/
+
+static  void  Sim_NAND_ECC_Verify (void             *p_ext_data,
+                                   void             *p_sec_buf,
+                                   void             *p_oos_buf,
+                                   FS_NAND_PG_SIZE   oos_size,
+                                   FS_ERR           *p_err)
+{
+    FS_NAND_CTRLR_GEN_DATA  *p_ctrlr_data;
+    CPU_INT08U              *p_ecc;
+    CPU_INT08U              *p_buf;
+    CPU_INT32U               sec_size;
+    CPU_INT32U               code;
+    CPU_INT32U               syndrome;
+    CPU_INT32U               bit_ix;
+    CPU_INT32U               octet_ix;
+
+
+    p_ctrlr_data = (FS_NAND_CTRLR_GEN_DATA *)p_ext_data;
+    sec_size     =  p_ctrlr_data->SecSize;
+    p_ecc        = (CPU_INT08U *)p_oos_buf + oos_size;
+
+    code      = MEM_VAL_GET_INT16U_LITTLE(p_ecc);               /* See Note #1.                                         */
+    MEM_VAL_SET_INT16U_LITTLE(p_ecc, DEF_INT_16U_MAX_VAL);
+    syndrome  = Sim_NAND_ECC_CodeCalc((CPU_INT08U *)p_sec_buf, sec_size, (CPU_INT08U *)p_oos_buf, oos_size + SIM_NAND_ECC_SIZE);
+    syndrome ^= Sim_NAND_ECC_Erased ^ DEF_INT_16U_MAX_VAL ^ code;
+    MEM_VAL_SET_INT16U_LITTLE(p_ecc, code);
+
+    if (syndrome == 0u) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    bit_ix = syndrome & SIM_NAND_ECC_IX_MASK;                   /* See Note #2.                                         */
+    if ((DEF_BIT_IS_CLR(syndrome, SIM_NAND_ECC_PARITY_BIT) == DEF_YES) ||
+        (bit_ix > (sec_size + oos_size) * DEF_OCTET_NBR_BITS)) {
+        Sim_FlashStat.UncorrCtr++;
+       *p_err = FS_ERR_ECC_UNCORR;
+        return;
+    }
+
+    if (bit_ix > 0u) {
+        bit_ix--;
+        octet_ix = bit_ix / DEF_OCTET_NBR_BITS;
+        p_buf    = (octet_ix < sec_size) ? &((CPU_INT08U *)p_sec_buf)[octet_ix]
+                                         : &((CPU_INT08U *)p_oos_buf)[octet_ix - sec_size];
+       *p_buf   ^= (CPU_INT08U)(1u << (bit_ix % DEF_OCTET_NBR_BITS));
+    }
+    Sim_FlashStat.CorrCtr++;
+   *p_err = FS_ERR_ECC_CRITICAL_CORR;                           /* See Note #3.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                      Sim_NAND_ECC_CodeCalc()
+*
+* Description : Compute the code of a sector & its OOS data (see Note #5).
+*
+* Argument(s) : p_sec_buf   Pointer to sector data.
+*
+*               sec_size    Size of sector, in octets.
+*
+*               p_oos_buf   Pointer to OOS data.
+*
+*               oos_size    Size of OOS data, in octets, ECC included.
+*
+* Return(s)   : Code, without the erased offset.
+*
+* Caller(s)   : Sim_NAND_ECC_Calc(),
+*               Sim_NAND_ECC_Verify().
+*
+* Note(s)     : (1) The ECC octets are set to FFh by the callers, so that the code does not depend on them.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Sim_NAND_ECC_CodeCalc (CPU_INT08U  *p_sec_buf,
+                                           CPU_INT32U   sec_size,
+                                           CPU_INT08U  *p_oos_buf,
+                                           CPU_INT32U   oos_size)
+{
+    CPU_INT08U  *p_buf;
+    CPU_INT32U   octet_ix;
+    CPU_INT32U   bit_ix;
+    CPU_INT32U   code;
+    CPU_INT32U   parity;
+    CPU_INT08U   octet;
+
+
+    code   = 0u;
+    parity = 0u;
+    bit_ix = 1u;
+    p_buf  = p_sec_buf;
+    for (octet_ix = 0u; octet_ix < sec_size + oos_size; octet_ix++) {
+        if (octet_ix == sec_size) {
+            p_buf = p_oos_buf - sec_size;
+        }
+        octet   = p_buf[octet_ix];
+        parity ^= octet;
+        while (octet != 0u) {
+            if (DEF_BIT_IS_SET(octet, DEF_BIT_00) == DEF_YES) {
+                code ^= bit_ix;
+            }
+            octet >>= 1;
+            bit_ix++;
+        }
+        bit_ix = ((octet_ix + 1u) * DEF_OCTET_NBR_BITS) + 1u;
+    }
+
+    if ((CPU_PopCnt32(parity) & 1u) != 0u) {
+        DEF_BIT_SET(code, SIM_NAND_ECC_PARITY_BIT);
+    }
+
+    return (code);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          NOR PHY DRIVER
+*********************************************************************************************************
+*/
+
+static  void  Sim_NOR_Open (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                            FS_ERR               *p_err)
+{
+    if (Sim_FlashImgPtr == DEF_NULL) {                          /* Sim_NOR_Init() not called.                           */
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
+
+    p_phy_data->BlkCnt          = (FS_SEC_QTY)Sim_FlashStat.BlkCnt;
+    p_phy_data->BlkSize         =  SIM_NOR_BLK_SIZE;
+    p_phy_data->AddrRegionStart =  p_phy_data->AddrBase;
+    p_phy_data->WrMultSize      =  1u;
+    p_phy_data->DataPtr         =  DEF_NULL;
+    DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_MULTI | FS_DEV_NOR_PHY_CAP_WR_BURST);
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+static  void  Sim_NOR_Close (FS_DEV_NOR_PHY_DATA  *p_phy_data)
+{
+    (void)p_phy_data;
+}
+
+
+static  void  Sim_NOR_Rd (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                          void                 *p_dest,
+                          CPU_INT32U            start,
+                          CPU_INT32U            cnt,
+                          FS_ERR               *p_err)
+{
+    if ((start       >  p_phy_data->BlkCnt * SIM_NOR_BLK_SIZE) ||
+        (cnt         >  p_phy_data->BlkCnt * SIM_NOR_BLK_SIZE - start)) {
+       *p_err = FS_ERR_DEV_INVALID_OP;
+        return;
+    }
+
+    Mem_Copy(p_dest, Sim_FlashImgPtr + start, cnt);
+    Sim_FlashStat.TimeNs   += SIM_NOR_T_RD_NS + ((CPU_INT64U)cnt * SIM_NOR_T_RD_OCTET_NS);
+    Sim_FlashStat.RdOctets += cnt;
+    Sim_FlashStat.RdCtr++;
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_NOR_RdMulti()
+*
+* Description : Read 'nbr' chunks of 'cnt' octets, 'stride' octets apart, with one command.
+*
+* Note(s)     : (1) The device streams the whole span, octets between chunks included; only the command
+*                   latency is saved over one read per chunk.
+*********************************************************************************************************
+*/
+
+static  void  Sim_NOR_RdMulti (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                               void                 *p_dest,
+                               CPU_INT32U            start,
+                               CPU_INT32U            cnt,
+                               CPU_INT32U            stride,
+                               CPU_INT32U            nbr,
+                               FS_ERR               *p_err)
+{
+    CPU_INT08U  *p_dest_08;
+    CPU_INT32U   span;
+    CPU_INT32U   ix;
+
+
+    if ((nbr    == 0u) ||
+        (stride <  cnt)) {
+       *p_err = FS_ERR_DEV_INVALID_OP;
+        return;
+    }
+
+    span = ((nbr - 1u) * stride) + cnt;
+    if ((start       >  p_phy_data->BlkCnt * SIM_NOR_BLK_SIZE) ||
+        (span        >  p_phy_data->BlkCnt * SIM_NOR_BLK_SIZE - start)) {
+       *p_err = FS_ERR_DEV_INVALID_OP;
+        return;
+    }
+
+    p_dest_08 = (CPU_INT08U *)p_dest;
+    for (ix = 0u; ix < nbr; ix++) {
+        Mem_Copy(p_dest_08, Sim_FlashImgPtr + start + (ix * stride), cnt);
+        p_dest_08 += cnt;
+    }
+                                                                /* One cmd for the whole span (see Note #1).            */
+    Sim_FlashStat.TimeNs   += SIM_NOR_T_RD_NS + ((CPU_INT64U)span * SIM_NOR_T_RD_OCTET_NS);
+    Sim_FlashStat.RdOctets += span;
+    Sim_FlashStat.RdCtr++;
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Sim_NOR_Wr()
+*
+* Description : Program data (see Note #1b).
+*
+* Argument(s) : p_phy_data  Pointer to NOR phy data.
+*
+*               p_src       Pointer to source buffer.
+*
+*               start       Start address of write (relative to start of device).
+*
+*               cnt         Number of octets to write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_DEV_INVALID_OP       Invalid address.
+*                               FS_ERR_NONE                 Data written.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : NOR driver.
+*
+* Note(s)     : (1) Each SIM_NOR_PG_SIZE octet page touched costs one page program.
+*
+*               (2) Octets in which a bit would go from 0 to 1 are counted once per write.
+*********************************************************************************************************
+*/
+
+static  void  Sim_NOR_Wr (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                          void                 *p_src,
+                          CPU_INT32U            start,
+                          CPU_INT32U            cnt,
+                          FS_ERR               *p_err)
+{
+    CPU_INT08U   *p_src_08;
+    CPU_INT08U   *p_dest_08;
+    CPU_INT32U    pg_cnt;
+    CPU_INT32U    ix;
+    CPU_BOOLEAN   viol;
+
+
+    if ((start       >  p_phy_data->BlkCnt * SIM_NOR_BLK_SIZE) ||
+        (cnt         >  p_phy_data->BlkCnt * SIM_NOR_BLK_SIZE - start)) {
+       *p_err = FS_ERR_DEV_INVALID_OP;
+        return;
+    }
+    if (cnt == 0u) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    p_src_08  = (CPU_INT08U *)p_src;
+    p_dest_08 =  Sim_FlashImgPtr + start;
+    viol      =  DEF_NO;
+    for (ix = 0u; ix < cnt; ix++) {
+        if ((p_src_08[ix] & ~p_dest_08[ix]) != 0u) {            /* See Note #2.                                         */
+            viol = DEF_YES;
+        }
+        p_dest_08[ix] &= p_src_08[ix];
+    }
+    if (viol == DEF_YES) {
+        Sim_FlashStat.PgmViolCtr++;
+    }
+
+    pg_cnt = ((start + cnt - 1u) / SIM_NOR_PG_SIZE) - (start / SIM_NOR_PG_SIZE) + 1u;  /* See Note #1.                 */
+    Sim_FlashStat.TimeNs    += ((CPU_INT64U)pg_cnt * SIM_NOR_T_PP_NS) + ((CPU_INT64U)cnt * SIM_NOR_T_RD_OCTET_NS);
+    Sim_FlashStat.PgmOctets += cnt;
+    Sim_FlashStat.PgmCtr++;
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+static  void  Sim_NOR_EraseBlk (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                                CPU_INT32U            start,
+                                CPU_INT32U            size,
+                                FS_ERR               *p_err)
+{
+    CPU_INT32U  blk_ix;
+
+
+    if ((size               != SIM_NOR_BLK_SIZE) ||
+        ((start % SIM_NOR_BLK_SIZE) != 0u) ||
+        (start / SIM_NOR_BLK_SIZE >= p_phy_data->BlkCnt)) {
+       *p_err = FS_ERR_DEV_INVALID_OP;
+        return;
+    }
+
+    blk_ix = start / SIM_NOR_BLK_SIZE;
+    Mem_Set(Sim_FlashImgPtr + start, 0xFFu, SIM_NOR_BLK_SIZE);
+    Sim_FlashStat.EraseCntTbl[blk_ix]++;
+    Sim_FlashStat.TimeNs += SIM_NOR_T_BE_NS;
+    Sim_FlashStat.EraseCtr++;
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+static  void  Sim_NOR_IO_Ctrl (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                               CPU_INT08U            cmd,
+                               void                 *p_buf,
+                               FS_ERR               *p_err)
+{
+    CPU_INT32U  blk_ix;
+
+
+    (void)p_buf;
+
+    switch (cmd) {
+        case FS_DEV_IO_CTRL_PHY_ERASE_CHIP:
+             for (blk_ix = 0u; blk_ix < p_phy_data->BlkCnt; blk_ix++) {
+                 Sim_NOR_EraseBlk(p_phy_data, blk_ix * SIM_NOR_BLK_SIZE, SIM_NOR_BLK_SIZE, p_err);
+             }
+             break;
+
+
+        default:
+            *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+             break;
+    }
+}
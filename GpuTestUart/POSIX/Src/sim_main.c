@@ -0,0 +1,452 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_main.c
+*
+* Note(s)  : (1) Runs the GPU-TFT link code ('userCode/GPU_Serial.c') on a POSIX host :
+*
+*                (a) USART1 is a socketpair; its far end is driven by the GPU-TFT emulator ('gpu_emu.c').
+*                (b) USART2 (shell) is a pty, when enabled with '-s' (see 'sim_shell.c').
+*                (c) Kernel services run on the POSIX KAL (see 'sim_os.c').
+*
+*            (2) The load test sends N drawing commands through GPU_tx_and_rx_hand() back to back &
+*                reports throughput, latency percentiles & retries.  The exit status is non-zero if more
+*                than the allowed nbr of commands failed, so the simulator can gate CI :
+*
+*                    gpu_sim -n 500 -l 2000 -j 1000 -p 1 -F 0 -t gpu.trace
+*
+*            (3) GPU_tx_and_rx_hand() returns the status of the last reception request, not of the
+*                command.  A command is therefore counted as failed when all of its attempts were
+*                retried, as seen from the TRACE_EVT_GPU_RETRY event counter.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "sim.h"
+#include  "gpu_emu.h"
+#include  "app_cfg.h"
+#include  "cmsis_os.h"
+#include  "trace.h"
+
+#include  <cpu_core.h>
+#include  <lib_mem.h>
+
+#include  <signal.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <sys/socket.h>
+#include  <unistd.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  SIM_GPU_ATTEMPT_NBR                               4u   /* Nbr of attempts made by GPU_tx_and_rx_hand().        */
+
+#define  SIM_LOAD_TASK_STK_SIZE                       131072u
+
+#define  SIM_DFLT_CMD_NBR                                200u
+#define  SIM_DFLT_LATENCY_US                            2000u
+#define  SIM_DFLT_BAUD                                115200u
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  sim_load_result {
+    CPU_INT32U   CmdNbr;
+    CPU_INT32U   FailCtr;
+    CPU_INT32U   RetryCtr;
+    CPU_INT64U   ElapsedUs;
+    CPU_INT32U  *LatencyTbl;                                    /* Per-cmd latency, in us.                              */
+} SIM_LOAD_RESULT;
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*
+* Note(s) : (1) Defined in 'Core/Src/freertos.c' on the target.
+*********************************************************************************************************
+*/
+
+osSemaphoreId_t  USART1_SendHandle;                             /* See Note #1.                                         */
+osSemaphoreId_t  USART1_RxHandle;
+
+extern  void  GPU_Serial_init(void);                            /* 'GPU_Serial.c'.                                      */
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+                                                                /* Same cmd as 'send_test.c', ASCII text only.          */
+static  const  char           Sim_GpuCmd[] = "DR2;CLS(0);DS24(4,0,'ERROR',1);BOS(0,30,319,130,11);\r\n";
+
+static  SIM_LOAD_RESULT       Sim_LoadResult;
+static  osSemaphoreId_t       Sim_LoadDoneSem;
+static  volatile  sig_atomic_t  Sim_ExitReq;
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  Sim_LoadTask   (void             *p_arg);
+
+static  void  Sim_LoadReport (SIM_LOAD_RESULT  *p_result);
+
+static  int   Sim_LatencyCmp (const  void      *p_a,
+                              const  void      *p_b);
+
+static  void  Sim_SigHandler (int               sig);
+
+static  void  Sim_Usage      (const  char      *p_prog);
+
+
+/*
+*********************************************************************************************************
+*                                               main()
+*
+* Description : Parse the command line, start the simulated target & run the load test (see Note #2).
+*
+* Argument(s) : argc        Nbr of arguments.
+*
+*               argv        Array of arguments.
+*
+* Return(s)   : 0, if the load test passed.
+*
+*               1, if more commands failed than allowed.
+*
+*               2, on usage or initialization error.
+*
+* Caller(s)   : Host C runtime.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+int  main (int    argc,
+           char  *argv[])
+{
+    static  const  osSemaphoreAttr_t  send_attr = { .name = "USART1_Send" };
+    static  const  osSemaphoreAttr_t  rx_attr   = { .name = "USART1_Rx"   };
+    static  const  osThreadAttr_t     load_attr = {
+        .name       = "GPU load",
+        .stack_size = SIM_LOAD_TASK_STK_SIZE,
+        .priority   = osPriorityNormal,
+    };
+    GPU_EMU_CFG    emu_cfg;
+    CPU_INT32U     cmd_nbr;
+    CPU_INT32U     fail_max;
+    CPU_INT32U     baud;
+    const  char   *p_trace_path;
+    CPU_BOOLEAN    shell_en;
+    CPU_BOOLEAN    ok;
+    int            sv[2];
+    int            opt;
+    int            rtn;
+
+
+    cmd_nbr            = SIM_DFLT_CMD_NBR;
+    fail_max           = 0u;
+    baud               = SIM_DFLT_BAUD;
+    p_trace_path       = DEF_NULL;
+    shell_en           = DEF_NO;
+    emu_cfg.LatencyUs  = SIM_DFLT_LATENCY_US;
+    emu_cfg.JitterUs   = 0u;
+    emu_cfg.LossPpm    = 0u;
+    emu_cfg.Seed       = 1u;
+
+    while ((opt = getopt(argc, argv, "n:l:j:p:b:S:F:t:sh")) != -1) {
+        switch (opt) {
+            case 'n': cmd_nbr           = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);            break;
+            case 'l': emu_cfg.LatencyUs = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);            break;
+            case 'j': emu_cfg.JitterUs  = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);            break;
+            case 'p': emu_cfg.LossPpm   = (CPU_INT32U)(strtod(optarg, DEF_NULL) * 10000.0);    break;
+            case 'b': baud              = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);            break;
+            case 'S': emu_cfg.Seed      = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);            break;
+            case 'F': fail_max          = (CPU_INT32U)strtoul(optarg, DEF_NULL, 0);            break;
+            case 't': p_trace_path      = optarg;                                              break;
+            case 's': shell_en          = DEF_YES;                                             break;
+            case 'h':
+            default:
+                 Sim_Usage(argv[0]);
+                 return ((opt == 'h') ? 0 : 2);
+        }
+    }
+    emu_cfg.Baud = baud;
+
+                                                                /* ------------------- TARGET INIT -------------------- */
+    CPU_Init();
+    Mem_Init();
+    if (Sim_OS_Init() != DEF_OK) {
+        fprintf(stderr, "OS init failed\n");
+        return (2);
+    }
+    Trace_Init();
+
+    USART1_SendHandle = osSemaphoreNew(1u, 1u, &send_attr);     /* As in 'freertos.c'.                                  */
+    USART1_RxHandle   = osSemaphoreNew(1u, 0u, &rx_attr);
+    Sim_LoadDoneSem   = osSemaphoreNew(1u, 0u, DEF_NULL);
+    if ((USART1_SendHandle == DEF_NULL) ||
+        (USART1_RxHandle   == DEF_NULL) ||
+        (Sim_LoadDoneSem   == DEF_NULL)) {
+        fprintf(stderr, "semaphore creation failed\n");
+        return (2);
+    }
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {         /* See Note #1a.                                        */
+        perror("socketpair");
+        return (2);
+    }
+    ok = Sim_UART_Open(&huart1, sv[0], baud);
+    if (ok == DEF_OK) {
+        ok = GpuEmu_Start(sv[1], &emu_cfg);
+    }
+    if (ok == DEF_OK) {
+        if (shell_en == DEF_YES) {
+            ok = Sim_ShellStart();
+        }
+    }
+    if (ok != DEF_OK) {
+        fprintf(stderr, "simulation start failed\n");
+        return (2);
+    }
+
+                                                                /* -------------------- LOAD TEST --------------------- */
+    rtn = 0;
+    if (cmd_nbr > 0u) {
+        Sim_LoadResult.CmdNbr     = cmd_nbr;
+        Sim_LoadResult.LatencyTbl = (CPU_INT32U *)calloc(cmd_nbr, sizeof(CPU_INT32U));
+        if (Sim_LoadResult.LatencyTbl == DEF_NULL) {
+            fprintf(stderr, "out of memory\n");
+            return (2);
+        }
+        if (osThreadNew(Sim_LoadTask, &Sim_LoadResult, &load_attr) == DEF_NULL) {
+            fprintf(stderr, "load task creation failed\n");
+            return (2);
+        }
+        (void)osSemaphoreAcquire(Sim_LoadDoneSem, osWaitForever);
+
+        Sim_LoadReport(&Sim_LoadResult);
+        if (Sim_LoadResult.FailCtr > fail_max) {
+            rtn = 1;
+        }
+    }
+
+    if (shell_en == DEF_YES) {                                  /* Keep shell running until interrupted.                */
+        (void)signal(SIGINT,  Sim_SigHandler);
+        (void)signal(SIGTERM, Sim_SigHandler);
+        while (Sim_ExitReq == 0) {
+            (void)osDelay(100u);
+        }
+    }
+
+    if (p_trace_path != DEF_NULL) {
+        Trace_Stop();
+        if (Sim_TraceFileSave(p_trace_path) != DEF_OK) {
+            fprintf(stderr, "cannot write trace file '%s'\n", p_trace_path);
+            rtn = 2;
+        }
+    }
+
+    return (rtn);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           Sim_LoadTask()
+*
+* Description : Send the load test commands, as the application task on the target would.
+*
+* Argument(s) : p_arg       Pointer to load test result.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : OS shim thread wrapper.
+*
+* Note(s)     : (1) See Note #3.
+*********************************************************************************************************
+*/
+
+static  void  Sim_LoadTask (void  *p_arg)
+{
+    SIM_LOAD_RESULT  *p_result;
+    CPU_INT32U        ix;
+    CPU_INT32U        retry_ctr;
+    CPU_INT64U        start_us;
+    CPU_INT64U        cmd_start_us;
+
+
+    p_result = (SIM_LOAD_RESULT *)p_arg;
+
+    GPU_Serial_init();                                          /* Port test banner, as at target start-up.             */
+
+    start_us = Sim_TimeUsGet();
+    for (ix = 0u; ix < p_result->CmdNbr; ix++) {
+        retry_ctr    = Sim_TraceEvtCtrGet(TRACE_EVT_GPU_RETRY);
+        cmd_start_us = Sim_TimeUsGet();
+
+        (void)GPU_tx_and_rx_hand((void *)Sim_GpuCmd, sizeof(Sim_GpuCmd));
+
+        p_result->LatencyTbl[ix] = (CPU_INT32U)(Sim_TimeUsGet() - cmd_start_us);
+        retry_ctr                =  Sim_TraceEvtCtrGet(TRACE_EVT_GPU_RETRY) - retry_ctr;
+        p_result->RetryCtr      +=  retry_ctr;
+        if (retry_ctr >= SIM_GPU_ATTEMPT_NBR) {                 /* See Note #1.                                         */
+            p_result->FailCtr++;
+        }
+    }
+    p_result->ElapsedUs = Sim_TimeUsGet() - start_us;
+
+    (void)osSemaphoreRelease(Sim_LoadDoneSem);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_LoadReport()
+*
+* Description : Print the load test results on stdout.
+*
+* Argument(s) : p_result    Pointer to load test result.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  Sim_LoadReport (SIM_LOAD_RESULT  *p_result)
+{
+    GPU_EMU_STAT  stat;
+    CPU_INT64U    sum;
+    CPU_INT32U    ix;
+    CPU_INT32U    nbr;
+    double        elapsed_s;
+
+
+    nbr = p_result->CmdNbr;
+    sum = 0u;
+    for (ix = 0u; ix < nbr; ix++) {
+        sum += p_result->LatencyTbl[ix];
+    }
+    qsort(p_result->LatencyTbl, nbr, sizeof(CPU_INT32U), Sim_LatencyCmp);
+    elapsed_s = (double)p_result->ElapsedUs / 1e6;
+
+    GpuEmu_StatGet(&stat);
+
+    printf("cmds        : %u sent, %u ok, %u failed\n",
+           (unsigned)nbr,
+           (unsigned)(nbr - p_result->FailCtr),
+           (unsigned)p_result->FailCtr);
+    printf("retries     : %u (%.2f per cmd)\n",
+           (unsigned)p_result->RetryCtr,
+           (double)p_result->RetryCtr / nbr);
+    printf("throughput  : %.1f cmd/s, %.1f octet/s\n",
+           nbr / elapsed_s,
+           (nbr * (double)sizeof(Sim_GpuCmd)) / elapsed_s);
+    printf("latency (ms): avg %.3f  p50 %.3f  p99 %.3f  max %.3f\n",
+           (double)sum / nbr / 1e3,
+           p_result->LatencyTbl[nbr / 2u] / 1e3,
+           p_result->LatencyTbl[(nbr * 99u) / 100u] / 1e3,
+           p_result->LatencyTbl[nbr - 1u] / 1e3);
+    printf("emulator    : %u cmds, %u replies, %u dropped; %u unsolicited octets at USART1\n",
+           (unsigned)stat.CmdCtr,
+           (unsigned)stat.ReplyCtr,
+           (unsigned)stat.DropCtr,
+           (unsigned)Sim_UART_RxDropCtrGet(&huart1));
+    fflush(stdout);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_LatencyCmp()
+*
+* Description : qsort() comparison function for latencies.
+*********************************************************************************************************
+*/
+
+static  int  Sim_LatencyCmp (const  void  *p_a,
+                             const  void  *p_b)
+{
+    CPU_INT32U  a;
+    CPU_INT32U  b;
+
+
+    a = *(const CPU_INT32U *)p_a;
+    b = *(const CPU_INT32U *)p_b;
+
+    return ((a > b) - (a < b));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_SigHandler()
+*
+* Description : Request simulator exit on SIGINT/SIGTERM.
+*********************************************************************************************************
+*/
+
+static  void  Sim_SigHandler (int  sig)
+{
+    (void)sig;
+
+    Sim_ExitReq = 1;
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Sim_Usage()
+*
+* Description : Print the command line usage.
+*********************************************************************************************************
+*/
+
+static  void  Sim_Usage (const  char  *p_prog)
+{
+    printf("usage: %s [options]\n"
+           "  -n <nbr>    load test commands (default %u, 0 = none)\n"
+           "  -l <us>     GPU reply latency (default %u)\n"
+           "  -j <us>     GPU reply latency jitter, uniform (default 0)\n"
+           "  -p <pct>    GPU reply loss probability, in %% (default 0)\n"
+           "  -b <baud>   USART1 baud rate, 0 = no line rate emulation (default %u)\n"
+           "  -S <seed>   loss/jitter generator seed (default 1)\n"
+           "  -F <nbr>    max failed commands before non-zero exit (default 0)\n"
+           "  -t <file>   save event trace to file (see Trace/Tools/trace2json.py)\n"
+           "  -s          start USART2 shell on a pty & run until interrupted\n",
+           p_prog,
+           (unsigned)SIM_DFLT_CMD_NBR,
+           (unsigned)SIM_DFLT_LATENCY_US,
+           (unsigned)SIM_DFLT_BAUD);
+}
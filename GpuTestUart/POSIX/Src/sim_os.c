@@ -0,0 +1,649 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_os.c
+*
+* Note(s)  : (1) Maps the FreeRTOS & CMSIS-RTOS2 services used by 'userCode' onto the POSIX KAL
+*                ('uc-Micrium/Common/KAL/POSIX/kal.c'), so the application runs unmodified as a set of
+*                host threads.
+*
+*            (2) CMSIS semaphores have a maximum count, KAL semaphores do not.  The count is mirrored in
+*                'SIM_SEM.Ctr' so that releasing a full binary semaphore fails with osErrorResource, as
+*                it does on the target.  The mirror is decremented after the KAL pend returns, so it may
+*                briefly over-estimate the count; it never under-estimates it.
+*
+*            (3) Semaphore gives & takes are recorded in the event trace with the same ids as the
+*                FreeRTOS trace macros in 'Core/Inc/FreeRTOSConfig.h'.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#define  _GNU_SOURCE
+
+#include  "FreeRTOS.h"
+#include  "task.h"
+#include  "cmsis_os.h"
+#include  "sim.h"
+#include  "trace.h"
+
+#include  <KAL/kal.h>
+#include  <lib_mem.h>
+
+#include  <errno.h>
+#include  <pthread.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  SIM_Q_TYPE_COUNTING_SEM                           2u   /* FreeRTOS queueQUEUE_TYPE_* values.                   */
+#define  SIM_Q_TYPE_BINARY_SEM                             3u
+
+#define  SIM_KAL_PRIO_BASE                                60u   /* KAL prio of osPriorityIdle.                          */
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  sim_sem {
+    KAL_SEM_HANDLE       Handle;
+    volatile CPU_INT32U  Ctr;                                   /* See Note #2.                                         */
+    CPU_INT32U           Max;
+} SIM_SEM;
+
+typedef  struct  sim_thread {
+    osThreadFunc_t       Fnct;
+    void                *ArgPtr;
+    CPU_INT08U           Nbr;
+} SIM_THREAD;
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  pthread_mutex_t       Sim_CriticalMutex;
+static  struct  timespec      Sim_TimeStart;
+static  volatile  CPU_INT32U  Sim_TaskNbrNext = 1u;             /* Task nbr 0 is the main thread.                       */
+static  __thread  CPU_INT08U  Sim_TaskNbr;
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void  Sim_ThreadWrapper(void  *p_arg);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            Sim_OS_Init()
+*
+* Description : Initialize the OS shim & the POSIX KAL.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_OK,   if initialization succeeded.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) Mem_Init() MUST be called first.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Sim_OS_Init (void)
+{
+    pthread_mutexattr_t  attr;
+    RTOS_ERR             err;
+
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &Sim_TimeStart);
+
+    if (pthread_mutexattr_init(&attr) != 0) {
+        return (DEF_FAIL);
+    }
+    (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    if (pthread_mutex_init(&Sim_CriticalMutex, &attr) != 0) {
+        return (DEF_FAIL);
+    }
+    (void)pthread_mutexattr_destroy(&attr);
+
+    KAL_Init(DEF_NULL, &err);
+    if (err != RTOS_ERR_NONE) {
+        return (DEF_FAIL);
+    }
+
+    Trace_NameAdd(TRACE_NAME_TYPE_TASK, 0u, "main");
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Sim_TimeUsGet()
+*
+* Description : Get the time elapsed since Sim_OS_Init(), in microseconds.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Elapsed time, in us.
+*
+* Caller(s)   : Application, simulation modules.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT64U  Sim_TimeUsGet (void)
+{
+    struct  timespec  now;
+
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((CPU_INT64U)((CPU_INT64S)(now.tv_sec  - Sim_TimeStart.tv_sec) * 1000000
+                       + (CPU_INT64S)(now.tv_nsec - Sim_TimeStart.tv_nsec) / 1000));
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Sim_DlyUs()
+*
+* Description : Delay the calling thread.
+*
+* Argument(s) : dly_us      Delay, in microseconds.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Simulation modules.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Sim_DlyUs (CPU_INT32U  dly_us)
+{
+    struct  timespec  dly;
+
+
+    if (dly_us == 0u) {
+        return;
+    }
+
+    dly.tv_sec  =  dly_us / 1000000u;
+    dly.tv_nsec = (dly_us % 1000000u) * 1000u;
+    while (nanosleep(&dly, &dly) == -1) {
+        if (errno != EINTR) {
+            break;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Sim_TaskNbrCur()
+*
+* Description : Get the number of the calling thread, as assigned by osThreadNew().
+*
+* Argument(s) : none.
+*
+* Return(s)   : Task nbr (0 for the main thread & threads not created through osThreadNew()).
+*
+* Caller(s)   : Trace backend.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  Sim_TaskNbrCur (void)
+{
+    return (Sim_TaskNbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      pvPortMalloc() / vPortFree()
+*
+* Description : FreeRTOS heap, mapped on the host heap.
+*********************************************************************************************************
+*/
+
+void  *pvPortMalloc (size_t  size)
+{
+    return (malloc(size));
+}
+
+
+void  vPortFree (void  *p_mem)
+{
+    free(p_mem);
+}
+
+
+/*
+*********************************************************************************************************
+*                                 Sim_CriticalEnter() / Sim_CriticalExit()
+*
+* Description : Enter/exit a critical section (see 'task.h' Note #1).
+*********************************************************************************************************
+*/
+
+void  Sim_CriticalEnter (void)
+{
+    (void)pthread_mutex_lock(&Sim_CriticalMutex);
+}
+
+
+void  Sim_CriticalExit (void)
+{
+    (void)pthread_mutex_unlock(&Sim_CriticalMutex);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       vTaskDelay() / osDelay()
+*
+* Description : Delay the calling task, in ticks.
+*********************************************************************************************************
+*/
+
+void  vTaskDelay (const  TickType_t  ticks)
+{
+    Sim_DlyUs((CPU_INT32U)(((CPU_INT64U)ticks * 1000000u) / configTICK_RATE_HZ));
+}
+
+
+osStatus_t  osDelay (uint32_t  ticks)
+{
+    vTaskDelay((TickType_t)ticks);
+
+    return (osOK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        osKernelGetTickCount()
+*
+* Description : Get the RTOS kernel tick count.
+*********************************************************************************************************
+*/
+
+uint32_t  osKernelGetTickCount (void)
+{
+    return ((uint32_t)((Sim_TimeUsGet() * configTICK_RATE_HZ) / 1000000u));
+}
+
+
+/*
+*********************************************************************************************************
+*                                            osThreadNew()
+*
+* Description : Create a thread.
+*
+* Argument(s) : func        Thread function.
+*
+*               argument    Argument passed to the thread function.
+*
+*               attr        Thread attributes, or NULL for defaults.
+*
+* Return(s)   : Thread id, if NO error(s).
+*
+*               NULL,      otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) Host threads need more stack than their target counterparts (libc, stdio); the stack
+*                   size is raised to at least SIM_TASK_STK_SIZE_MIN.
+*********************************************************************************************************
+*/
+
+osThreadId_t  osThreadNew (osThreadFunc_t            func,
+                           void                     *argument,
+                           const  osThreadAttr_t    *attr)
+{
+    SIM_THREAD       *p_thread;
+    KAL_TASK_HANDLE   task_handle;
+    CPU_SIZE_T        stk_size;
+    const  char      *p_name;
+    osPriority_t      prio;
+    RTOS_ERR          err;
+
+
+    if (func == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    p_name   = "thread";
+    stk_size =  0u;
+    prio     =  osPriorityNormal;
+    if (attr != DEF_NULL) {
+        if (attr->name != DEF_NULL) {
+            p_name = attr->name;
+        }
+        stk_size = attr->stack_size;
+        if (attr->priority != osPriorityNone) {
+            prio = attr->priority;
+        }
+    }
+    stk_size = DEF_MAX(stk_size, SIM_TASK_STK_SIZE_MIN);        /* See Note #1.                                         */
+
+    p_thread = (SIM_THREAD *)malloc(sizeof(SIM_THREAD));
+    if (p_thread == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    p_thread->Fnct   =  func;
+    p_thread->ArgPtr =  argument;
+    p_thread->Nbr    = (CPU_INT08U)__atomic_fetch_add(&Sim_TaskNbrNext, 1u, __ATOMIC_RELAXED);
+
+    Trace_NameAdd(TRACE_NAME_TYPE_TASK, p_thread->Nbr, p_name);
+
+    task_handle = KAL_TaskAlloc((const CPU_CHAR *)p_name,
+                                 DEF_NULL,
+                                 stk_size / sizeof(CPU_DATA),
+                                 DEF_NULL,
+                                &err);
+    if (err != RTOS_ERR_NONE) {
+        free(p_thread);
+        return (DEF_NULL);
+    }
+
+    KAL_TaskCreate(task_handle,
+                   Sim_ThreadWrapper,
+                   p_thread,
+                  (CPU_INT08U)(SIM_KAL_PRIO_BASE - (CPU_INT32U)prio),
+                   DEF_NULL,
+                  &err);
+    if (err != RTOS_ERR_NONE) {
+        free(p_thread);
+        return (DEF_NULL);
+    }
+
+    return ((osThreadId_t)task_handle.TaskObjPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          osSemaphoreNew()
+*
+* Description : Create a counting semaphore.
+*
+* Argument(s) : max_count       Maximum nbr of available tokens.
+*
+*               initial_count   Initial nbr of available tokens.
+*
+*               attr            Semaphore attributes, or NULL for defaults.
+*
+* Return(s)   : Semaphore id, if NO error(s).
+*
+*               NULL,         otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+osSemaphoreId_t  osSemaphoreNew (uint32_t                  max_count,
+                                 uint32_t                  initial_count,
+                                 const  osSemaphoreAttr_t *attr)
+{
+    SIM_SEM      *p_sem;
+    const  char  *p_name;
+    RTOS_ERR      err;
+
+
+    if ((max_count     == 0u) ||
+        (initial_count >  max_count)) {
+        return (DEF_NULL);
+    }
+
+    p_name = "sem";
+    if ((attr       != DEF_NULL) &&
+        (attr->name != DEF_NULL)) {
+        p_name = attr->name;
+    }
+
+    p_sem = (SIM_SEM *)malloc(sizeof(SIM_SEM));
+    if (p_sem == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    p_sem->Handle = KAL_SemCreate((const CPU_CHAR *)p_name, DEF_NULL, &err);
+    if (err != RTOS_ERR_NONE) {
+        free(p_sem);
+        return (DEF_NULL);
+    }
+    if (initial_count > 0u) {
+        KAL_SemSet(p_sem->Handle, (CPU_INT16U)initial_count, &err);
+    }
+    p_sem->Ctr = initial_count;
+    p_sem->Max = max_count;
+
+    Trace_NameAdd(TRACE_NAME_TYPE_OBJ, (uint32_t)(CPU_ADDR)p_sem, p_name);
+
+    return ((osSemaphoreId_t)p_sem);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        osSemaphoreAcquire()
+*
+* Description : Acquire a semaphore token.
+*
+* Argument(s) : semaphore_id    Semaphore id.
+*
+*               timeout         Timeout, in ticks (0 = no wait, osWaitForever = wait forever).
+*
+* Return(s)   : osOK,             if token acquired.
+*
+*               osErrorResource,  if no token available & 'timeout' is 0.
+*
+*               osErrorTimeout,   if no token became available in time.
+*
+*               osErrorParameter, if 'semaphore_id' is NULL.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+osStatus_t  osSemaphoreAcquire (osSemaphoreId_t  semaphore_id,
+                                uint32_t         timeout)
+{
+    SIM_SEM     *p_sem;
+    KAL_OPT      opt;
+    CPU_INT32U   timeout_ms;
+    CPU_INT08U   q_type;
+    RTOS_ERR     err;
+
+
+    p_sem = (SIM_SEM *)semaphore_id;
+    if (p_sem == DEF_NULL) {
+        return (osErrorParameter);
+    }
+    q_type = (p_sem->Max == 1u) ? SIM_Q_TYPE_BINARY_SEM : SIM_Q_TYPE_COUNTING_SEM;
+
+    opt        = KAL_OPT_PEND_BLOCKING;
+    timeout_ms = KAL_TIMEOUT_INFINITE;
+    if (timeout == 0u) {
+        opt = KAL_OPT_PEND_NON_BLOCKING;
+    } else if (timeout != osWaitForever) {
+        timeout_ms = (CPU_INT32U)(((CPU_INT64U)timeout * 1000u) / configTICK_RATE_HZ);
+        timeout_ms = DEF_MAX(timeout_ms, 1u);
+    }
+
+    KAL_SemPend(p_sem->Handle, opt, timeout_ms, &err);
+    switch (err) {
+        case RTOS_ERR_NONE:
+             (void)__atomic_fetch_sub(&p_sem->Ctr, 1u, __ATOMIC_RELAXED);
+             TRACE_EVT(TRACE_EVT_Q_RECV, q_type, (CPU_ADDR)p_sem);      /* See Note #3.                         */
+             return (osOK);
+
+        case RTOS_ERR_WOULD_BLOCK:
+             TRACE_EVT(TRACE_EVT_Q_RECV_FAIL, q_type, (CPU_ADDR)p_sem);
+             return (osErrorResource);
+
+        case RTOS_ERR_TIMEOUT:
+             TRACE_EVT(TRACE_EVT_Q_RECV_FAIL, q_type, (CPU_ADDR)p_sem);
+             return (osErrorTimeout);
+
+        default:
+             return (osError);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        osSemaphoreRelease()
+*
+* Description : Release a semaphore token.
+*
+* Argument(s) : semaphore_id    Semaphore id.
+*
+* Return(s)   : osOK,             if token released.
+*
+*               osErrorResource,  if the semaphore already holds its maximum nbr of tokens.
+*
+*               osErrorParameter, if 'semaphore_id' is NULL.
+*
+* Caller(s)   : Application, HAL callbacks.
+*
+* Note(s)     : (1) See Note #2.
+*********************************************************************************************************
+*/
+
+osStatus_t  osSemaphoreRelease (osSemaphoreId_t  semaphore_id)
+{
+    SIM_SEM     *p_sem;
+    CPU_INT32U   ctr;
+    CPU_INT08U   q_type;
+    RTOS_ERR     err;
+
+
+    p_sem = (SIM_SEM *)semaphore_id;
+    if (p_sem == DEF_NULL) {
+        return (osErrorParameter);
+    }
+    q_type = (p_sem->Max == 1u) ? SIM_Q_TYPE_BINARY_SEM : SIM_Q_TYPE_COUNTING_SEM;
+
+    ctr = __atomic_load_n(&p_sem->Ctr, __ATOMIC_RELAXED);       /* See Note #1.                                         */
+    do {
+        if (ctr >= p_sem->Max) {
+            TRACE_EVT(TRACE_EVT_Q_SEND_FAIL, q_type, (CPU_ADDR)p_sem);
+            return (osErrorResource);
+        }
+    } while (__atomic_compare_exchange_n(&p_sem->Ctr, &ctr, ctr + 1u, DEF_NO, __ATOMIC_RELAXED, __ATOMIC_RELAXED) == DEF_NO);
+
+    KAL_SemPost(p_sem->Handle, KAL_OPT_POST_NONE, &err);
+    if (err != RTOS_ERR_NONE) {
+        (void)__atomic_fetch_sub(&p_sem->Ctr, 1u, __ATOMIC_RELAXED);
+        return (osError);
+    }
+    TRACE_EVT(TRACE_EVT_Q_SEND, q_type, (CPU_ADDR)p_sem);
+
+    return (osOK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        osSemaphoreGetCount()
+*
+* Description : Get the current semaphore token count.
+*********************************************************************************************************
+*/
+
+uint32_t  osSemaphoreGetCount (osSemaphoreId_t  semaphore_id)
+{
+    SIM_SEM  *p_sem;
+
+
+    p_sem = (SIM_SEM *)semaphore_id;
+    if (p_sem == DEF_NULL) {
+        return (0u);
+    }
+
+    return (__atomic_load_n(&p_sem->Ctr, __ATOMIC_RELAXED));
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         Sim_ThreadWrapper()
+*
+* Description : Entry point of threads created by osThreadNew() : record the task nbr of the thread, then
+*               run the thread function.
+*
+*               Host threads run concurrently, so no 'task switched in' events are traced; each record
+*               is instead tagged with the task nbr of the thread that emitted it (see 'sim_trace.c').
+*
+* Argument(s) : p_arg       Pointer to thread info (see 'SIM_THREAD').
+*
+* Return(s)   : none.
+*
+* Caller(s)   : KAL task wrapper.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  Sim_ThreadWrapper (void  *p_arg)
+{
+    SIM_THREAD  *p_thread;
+    SIM_THREAD   thread;
+
+
+    p_thread = (SIM_THREAD *)p_arg;
+    thread   = *p_thread;
+    free(p_thread);
+
+    Sim_TaskNbr = thread.Nbr;
+
+    thread.Fnct(thread.ArgPtr);
+}
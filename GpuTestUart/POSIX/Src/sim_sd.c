@@ -0,0 +1,1206 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_sd.c
+*
+* Note(s)  : (1) Simulated SD card (v2.0, high capacity) in SPI mode, so that the uC/FS SD SPI driver
+*                ('fs_dev_sd_spi.c') runs unchanged on the host.  The BSP exchanges octets with the card
+*                model, which decodes command frames & sends R1/R3/R7 responses, data tokens & blocks,
+*                data response tokens & busy (DO held low) as the card does on the bus.  The card
+*                contents are held in RAM.
+*
+*            (2) Time is simulated, not measured : every octet advances a virtual clock by its transfer
+*                time at the clock frequency set by the driver, & the card reads blocks & programs them
+*                with the typical latencies SIM_SD_T_xxx :
+*
+*                (a) Polled transfers (FSDev_SD_SPI_BSP_SPI.Rd()/Wr()) cost a call overhead & a CPU gap
+*                    between octets, & are counted as CPU time, as is polling the card while it is busy.
+*
+*                (b) DMA transfers (FSDev_SD_SPI_BSP_DMA) cost a setup & a completion interrupt in CPU
+*                    time; the octets themselves run at the bus rate without CPU time.
+*
+*                (c) Each multiple block write pre-erased by ACMD23 has shorter busy periods.
+*
+*            (3) FSDev_SD_SPI_BSP_SPI.Lock() advances the clock by 'HostGapNs', the time the host spends
+*                in the file system & the application between two driver accesses.  Busy time that
+*                elapses during it is reported as hidden.
+*
+*            (4) A command or data token sent while the card is busy is ignored & counted as a
+*                violation : the card keeps DO low, so that the driver reads 0x00 as its response.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "sim_sd.h"
+
+#include  <cpu_core.h>
+#include  <lib_mem.h>
+
+#include  <stdio.h>
+#include  <stdlib.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+                                                                /* --------------------- TIMINGS ---------------------- */
+#define  SIM_SD_T_CALL_NS                                500u   /* BSP call, polled xfer (see Note #2a).                */
+#define  SIM_SD_T_POLL_GAP_NS                            160u   /* CPU gap between polled octets.                       */
+#define  SIM_SD_T_DMA_SETUP_NS                          2000u   /* DMA setup (see Note #2b).                            */
+#define  SIM_SD_T_DMA_IRQ_NS                            1500u   /* DMA completion ISR & task resume.                    */
+#define  SIM_SD_T_REG_NS                                5000u   /* CSD or CID rd access.                                */
+#define  SIM_SD_T_RD_ACCESS_NS                        250000u   /* First blk of a rd.                                   */
+#define  SIM_SD_T_RD_NEXT_NS                           20000u   /* Next  blk of a multi blk rd.                         */
+#define  SIM_SD_T_RD_STOP_NS                            2000u   /* Busy after CMD12.                                    */
+#define  SIM_SD_T_WR_BLK_NS                          1000000u   /* Busy after single blk wr.                            */
+#define  SIM_SD_T_WR_MULTI_BLK_NS                      80000u   /* Busy after blk of multi blk wr.                      */
+#define  SIM_SD_T_WR_PRE_BLK_NS                        30000u   /* Same, if pre-erased (see Note #2c).                  */
+#define  SIM_SD_T_WR_STOP_NS                          400000u   /* Busy after stop tran token.                          */
+#define  SIM_SD_T_WR_STOP_PRE_NS                      150000u   /* Same, if pre-erased.                                 */
+
+                                                                /* ---------------------- CARD ------------------------ */
+#define  SIM_SD_ST_IDLE                                    0u   /* Card states.                                         */
+#define  SIM_SD_ST_RD                                      1u   /* Sending data blk(s).                                 */
+#define  SIM_SD_ST_WR_TOKEN                                2u   /* Waiting for data token.                              */
+#define  SIM_SD_ST_WR_DATA                                 3u   /* Receiving data blk.                                  */
+
+#define  SIM_SD_R1_IDLE                           DEF_BIT_00
+#define  SIM_SD_R1_ILLEGAL_CMD                    DEF_BIT_02
+#define  SIM_SD_R1_ADDR_ERR                       DEF_BIT_05
+#define  SIM_SD_R1_PARAM_ERR                      DEF_BIT_06
+
+#define  SIM_SD_TOKEN_START_BLK                         0xFEu
+#define  SIM_SD_TOKEN_START_BLK_MULT                    0xFCu
+#define  SIM_SD_TOKEN_STOP_TRAN                         0xFDu
+#define  SIM_SD_TOKEN_DATA_ACCEPTED                     0x05u
+#define  SIM_SD_TOKEN_DATA_CRC_ERR                      0x0Bu
+#define  SIM_SD_TOKEN_DATA_WR_ERR                       0x0Du
+
+#define  SIM_SD_OCR_VDD                           0x00FF8000u   /* 2.7-3.6 V.                                           */
+#define  SIM_SD_PRE_ERASE_CNT_MASK                0x007FFFFFu
+#define  SIM_SD_CMD_LEN                                    6u
+#define  SIM_SD_REG_LEN                                   16u
+#define  SIM_SD_CRC16_POLY                            0x1021u
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  sim_sd {
+    CPU_INT08U         *ImgPtr;                                 /* Card contents.                                       */
+    CPU_INT32U          BlkCnt;
+    CPU_INT32U          OctetNs;                                /* Octet xfer time at cur clk freq.                     */
+    CPU_INT32U          HostGapNs;                              /* See Note #3.                                         */
+    CPU_INT08U          State;
+    CPU_BOOLEAN         Sel;                                    /* Chip sel'd.                                          */
+    CPU_BOOLEAN         Idle;                                   /* In idle state (not init'd by ACMD41).                */
+    CPU_BOOLEAN         AppCmd;                                 /* Next cmd is app cmd.                                 */
+    CPU_BOOLEAN         CRC_En;
+    CPU_BOOLEAN         DMA_Act;                                /* DMA xfer started & not waited for.                   */
+    CPU_BOOLEAN         Multi;                                  /* Cur rd or wr is multi blk.                           */
+    CPU_BOOLEAN         PreErased;                              /* Cur multi blk wr was pre-erased.                     */
+    CPU_INT08U          InitCtr;                                /* Nbr of ACMD41 since CMD0.                            */
+    CPU_INT08U          CmdBuf[SIM_SD_CMD_LEN];
+    CPU_INT08U          CmdLen;
+    CPU_INT08U          RespBuf[8];                             /* Resp octets to send.                                 */
+    CPU_INT08U          RespLen;
+    CPU_INT08U          RespIx;
+    const  CPU_INT08U  *DataPtr;                                /* Data blk being sent.                                 */
+    CPU_INT32U          DataLen;
+    CPU_INT32U          DataIx;                                 /* Ix in data pkt (token, data & CRC).                  */
+    CPU_INT16U          DataCRC;
+    CPU_INT32U          BlkIx;                                  /* Cur blk.                                             */
+    CPU_INT32U          PreEraseCnt;                            /* Blks to pre-erase for next CMD25 (ACMD23).           */
+    CPU_INT32U          PreEraseRem;                            /* Pre-erased blks left in cur CMD25.                   */
+    CPU_INT64U          RdyTimeNs;                              /* Time at which next data blk is rdy.                  */
+    CPU_INT64U          BusyTimeNs;                             /* Time at which card is no longer busy.                */
+    CPU_INT08U          WrBuf[SIM_SD_BLK_SIZE + 2u];            /* Rx'd data blk & CRC.                                 */
+    CPU_INT08U          CSD[SIM_SD_REG_LEN];
+    CPU_INT08U          CID[SIM_SD_REG_LEN];
+} SIM_SD;
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  const  CPU_INT08U  Sim_SD_CID[SIM_SD_REG_LEN] = {
+    0x1Bu, 'S', 'M', 'S', 'I', 'M', 'S', 'D', 0x10u, 0x12u, 0x34u, 0x56u, 0x78u, 0x01u, 0x6Au, 0x01u
+};
+
+static  SIM_SD_STAT  Sim_SD_Stat;
+static  SIM_SD       Sim_SD;
+static  CPU_INT16U   Sim_SD_CRC16_Tbl[256];
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Sim_SD_SPI_Open      (FS_QTY              unit_nbr);
+
+static  void         Sim_SD_SPI_Close     (FS_QTY              unit_nbr);
+
+static  void         Sim_SD_SPI_Lock      (FS_QTY              unit_nbr);
+
+static  void         Sim_SD_SPI_Unlock    (FS_QTY              unit_nbr);
+
+static  void         Sim_SD_SPI_Rd        (FS_QTY              unit_nbr,
+                                           void               *p_dest,
+                                           CPU_SIZE_T          cnt);
+
+static  void         Sim_SD_SPI_Wr        (FS_QTY              unit_nbr,
+                                           void               *p_src,
+                                           CPU_SIZE_T          cnt);
+
+static  void         Sim_SD_SPI_ChipSelEn (FS_QTY              unit_nbr);
+
+static  void         Sim_SD_SPI_ChipSelDis(FS_QTY              unit_nbr);
+
+static  void         Sim_SD_SPI_SetClkFreq(FS_QTY              unit_nbr,
+                                           CPU_INT32U          freq);
+
+static  void         Sim_SD_DMA_RdStart   (FS_QTY              unit_nbr,
+                                           void               *p_dest,
+                                           CPU_SIZE_T          cnt);
+
+static  void         Sim_SD_DMA_WrStart   (FS_QTY              unit_nbr,
+                                           void               *p_src,
+                                           CPU_SIZE_T          cnt);
+
+static  CPU_BOOLEAN  Sim_SD_DMA_Wait      (FS_QTY              unit_nbr);
+
+static  CPU_INT08U   Sim_SD_Xfer          (CPU_INT08U          octet_in);
+
+static  CPU_INT08U   Sim_SD_OctetOut      (void);
+
+static  void         Sim_SD_OctetIn       (CPU_INT08U          octet);
+
+static  void         Sim_SD_Cmd           (CPU_INT08U          cmd,
+                                           CPU_INT32U          arg);
+
+static  void         Sim_SD_AppCmd        (CPU_INT08U          cmd,
+                                           CPU_INT32U          arg);
+
+static  void         Sim_SD_RdStart       (const  CPU_INT08U  *p_data,
+                                           CPU_INT32U          len,
+                                           CPU_INT32U          access_ns);
+
+static  void         Sim_SD_RdNext        (void);
+
+static  void         Sim_SD_WrToken       (CPU_INT08U          token);
+
+static  void         Sim_SD_WrBlk         (void);
+
+static  void         Sim_SD_BusySet       (CPU_INT32U          busy_ns);
+
+static  CPU_INT16U   Sim_SD_CRC16         (const  CPU_INT08U  *p_data,
+                                           CPU_INT32U          len);
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+const  FS_DEV_SPI_API  FSDev_SD_SPI_BSP_SPI = {
+    Sim_SD_SPI_Open,
+    Sim_SD_SPI_Close,
+    Sim_SD_SPI_Lock,
+    Sim_SD_SPI_Unlock,
+    Sim_SD_SPI_Rd,
+    Sim_SD_SPI_Wr,
+    Sim_SD_SPI_ChipSelEn,
+    Sim_SD_SPI_ChipSelDis,
+    Sim_SD_SPI_SetClkFreq
+};
+
+const  FS_DEV_SD_SPI_DMA_API  FSDev_SD_SPI_BSP_DMA = {
+    Sim_SD_DMA_RdStart,
+    Sim_SD_DMA_WrStart,
+    Sim_SD_DMA_Wait
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           Sim_SD_Init()
+*
+* Description : Allocate the card contents & build the card registers.
+*
+* Argument(s) : p_cfg       Pointer to simulated SD card configuration.
+*
+* Return(s)   : DEF_OK,   if the card is allocated.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) The CSD is a version 2.0 CSD, with a 25 MHz maximum clock & a C_SIZE field that
+*                   gives the capacity in SIM_SD_SIZE_UNIT octet units, minus one.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Sim_SD_Init (const  SIM_SD_CFG  *p_cfg)
+{
+    CPU_INT32U  c_size;
+    CPU_INT32U  ix;
+    CPU_INT32U  bit;
+    CPU_INT16U  crc;
+
+
+    c_size = p_cfg->Size / SIM_SD_SIZE_UNIT;
+    if (c_size == 0u) {
+        fprintf(stderr, "invalid SD card size: %u octets\n", (unsigned)p_cfg->Size);
+        return (DEF_FAIL);
+    }
+
+    Mem_Clr(&Sim_SD, sizeof(Sim_SD));
+    Sim_SD.BlkCnt = c_size * (SIM_SD_SIZE_UNIT / SIM_SD_BLK_SIZE);
+    Sim_SD.ImgPtr = (CPU_INT08U *)calloc(Sim_SD.BlkCnt, SIM_SD_BLK_SIZE);
+    if (Sim_SD.ImgPtr == DEF_NULL) {
+        fprintf(stderr, "out of memory\n");
+        return (DEF_FAIL);
+    }
+    Sim_SD.HostGapNs = p_cfg->HostGapNs;
+    Sim_SD.Idle      = DEF_YES;
+
+                                                                /* -------------------- REGISTERS --------------------- */
+    c_size--;                                                   /* See Note #1.                                         */
+    Sim_SD.CSD[0]  = 0x40u;                                     /* CSD v2.0.                                            */
+    Sim_SD.CSD[1]  = 0x0Eu;                                     /* TAAC : 1 ms.                                         */
+    Sim_SD.CSD[3]  = 0x32u;                                     /* TRAN_SPEED : 25 MHz.                                 */
+    Sim_SD.CSD[4]  = 0x5Bu;                                     /* CCC & READ_BL_LEN (512).                             */
+    Sim_SD.CSD[5]  = 0x59u;
+    Sim_SD.CSD[7]  = (CPU_INT08U)((c_size >> 16) & 0x3Fu);
+    Sim_SD.CSD[8]  = (CPU_INT08U) (c_size >>  8);
+    Sim_SD.CSD[9]  = (CPU_INT08U)  c_size;
+    Sim_SD.CSD[10] = 0x7Fu;                                     /* ERASE_BLK_EN & SECTOR_SIZE.                          */
+    Sim_SD.CSD[11] = 0x80u;
+    Sim_SD.CSD[12] = 0x0Au;                                     /* WRITE_BL_LEN (512).                                  */
+    Sim_SD.CSD[13] = 0x40u;
+    Sim_SD.CSD[15] = 0x01u;
+    Mem_Copy(Sim_SD.CID, Sim_SD_CID, sizeof(Sim_SD.CID));
+
+    for (ix = 0u; ix < 256u; ix++) {                            /* CRC16 (CCITT) tbl.                                   */
+        crc = (CPU_INT16U)(ix << 8);
+        for (bit = 0u; bit < 8u; bit++) {
+            crc = ((crc & 0x8000u) != 0u) ? (CPU_INT16U)((crc << 1) ^ SIM_SD_CRC16_POLY)
+                                          : (CPU_INT16U) (crc << 1);
+        }
+        Sim_SD_CRC16_Tbl[ix] = crc;
+    }
+
+    Mem_Clr(&Sim_SD_Stat, sizeof(Sim_SD_Stat));
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Sim_SD_Close()
+*
+* Description : Free the card contents.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Sim_SD_Close (void)
+{
+    free(Sim_SD.ImgPtr);
+    Sim_SD.ImgPtr = DEF_NULL;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Sim_SD_StatReset()
+*
+* Description : Clear the statistics counters & the clock of the simulated card.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) A read access or busy period in progress keeps its remaining time.
+*********************************************************************************************************
+*/
+
+void  Sim_SD_StatReset (void)
+{
+    CPU_INT64U  time_ns;
+
+
+    time_ns           = Sim_SD_Stat.TimeNs;                     /* See Note #1.                                         */
+    Sim_SD.RdyTimeNs  = (Sim_SD.RdyTimeNs  > time_ns) ? (Sim_SD.RdyTimeNs  - time_ns) : 0u;
+    Sim_SD.BusyTimeNs = (Sim_SD.BusyTimeNs > time_ns) ? (Sim_SD.BusyTimeNs - time_ns) : 0u;
+    Mem_Clr(&Sim_SD_Stat, sizeof(Sim_SD_Stat));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_SD_StatGet()
+*
+* Description : Get the statistics of the simulated card.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Pointer to statistics.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+const  SIM_SD_STAT  *Sim_SD_StatGet (void)
+{
+    return (&Sim_SD_Stat);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            SD SPI BSP
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Sim_SD_SPI_Open (FS_QTY  unit_nbr)
+{
+    if ((unit_nbr      != 0u) ||                                /* Sim_SD_Init() not called.                            */
+        (Sim_SD.ImgPtr == DEF_NULL)) {
+        return (DEF_FAIL);
+    }
+    Sim_SD.Sel = DEF_NO;
+    Sim_SD_SPI_SetClkFreq(unit_nbr, FS_DEV_SD_DFLT_CLK_SPD);
+
+    return (DEF_OK);
+}
+
+
+static  void  Sim_SD_SPI_Close (FS_QTY  unit_nbr)
+{
+    (void)unit_nbr;
+}
+
+
+static  void  Sim_SD_SPI_Lock (FS_QTY  unit_nbr)
+{
+    CPU_INT64U  busy_ns;
+
+
+    (void)unit_nbr;
+                                                                /* See Note #3.                                         */
+    if (Sim_SD.BusyTimeNs > Sim_SD_Stat.TimeNs) {
+        busy_ns = Sim_SD.BusyTimeNs - Sim_SD_Stat.TimeNs;
+        Sim_SD_Stat.BusyHiddenNs += DEF_MIN(busy_ns, (CPU_INT64U)Sim_SD.HostGapNs);
+    }
+    Sim_SD_Stat.TimeNs += Sim_SD.HostGapNs;
+}
+
+
+static  void  Sim_SD_SPI_Unlock (FS_QTY  unit_nbr)
+{
+    (void)unit_nbr;
+}
+
+
+static  void  Sim_SD_SPI_Rd (FS_QTY       unit_nbr,
+                             void        *p_dest,
+                             CPU_SIZE_T   cnt)
+{
+    CPU_INT08U  *p_octet;
+
+
+    (void)unit_nbr;
+    if (Sim_SD.DMA_Act == DEF_YES) {                            /* DMA xfer not waited for.                             */
+        Sim_SD_Stat.ViolCtr++;
+    }
+    p_octet              = (CPU_INT08U *)p_dest;
+    Sim_SD_Stat.TimeNs  += SIM_SD_T_CALL_NS;                    /* See Note #2a.                                        */
+    Sim_SD_Stat.CpuNs   += SIM_SD_T_CALL_NS + ((CPU_INT64U)cnt * (Sim_SD.OctetNs + SIM_SD_T_POLL_GAP_NS));
+    while (cnt > 0u) {
+       *p_octet            = Sim_SD_Xfer(0xFFu);
+        Sim_SD_Stat.TimeNs += SIM_SD_T_POLL_GAP_NS;
+        p_octet++;
+        cnt--;
+    }
+}
+
+
+static  void  Sim_SD_SPI_Wr (FS_QTY       unit_nbr,
+                             void        *p_src,
+                             CPU_SIZE_T   cnt)
+{
+    CPU_INT08U  *p_octet;
+
+
+    (void)unit_nbr;
+    if (Sim_SD.DMA_Act == DEF_YES) {
+        Sim_SD_Stat.ViolCtr++;
+    }
+    p_octet              = (CPU_INT08U *)p_src;
+    Sim_SD_Stat.TimeNs  += SIM_SD_T_CALL_NS;
+    Sim_SD_Stat.CpuNs   += SIM_SD_T_CALL_NS + ((CPU_INT64U)cnt * (Sim_SD.OctetNs + SIM_SD_T_POLL_GAP_NS));
+    while (cnt > 0u) {
+        (void)Sim_SD_Xfer(*p_octet);
+        Sim_SD_Stat.TimeNs += SIM_SD_T_POLL_GAP_NS;
+        p_octet++;
+        cnt--;
+    }
+}
+
+
+static  void  Sim_SD_SPI_ChipSelEn (FS_QTY  unit_nbr)
+{
+    (void)unit_nbr;
+    Sim_SD.Sel = DEF_YES;
+}
+
+
+static  void  Sim_SD_SPI_ChipSelDis (FS_QTY  unit_nbr)
+{
+    (void)unit_nbr;
+    Sim_SD.Sel     = DEF_NO;
+    Sim_SD.CmdLen  = 0u;                                        /* Partial cmd & unread resp are lost.                  */
+    Sim_SD.RespLen = 0u;
+    Sim_SD.RespIx  = 0u;
+}
+
+
+static  void  Sim_SD_SPI_SetClkFreq (FS_QTY      unit_nbr,
+                                     CPU_INT32U  freq)
+{
+    (void)unit_nbr;
+    if (freq == 0u) {
+        return;
+    }
+    Sim_SD.OctetNs = (CPU_INT32U)((8000000000ull + freq - 1u) / freq);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            SD SPI DMA BSP
+*********************************************************************************************************
+*/
+
+static  void  Sim_SD_DMA_RdStart (FS_QTY       unit_nbr,
+                                  void        *p_dest,
+                                  CPU_SIZE_T   cnt)
+{
+    CPU_INT08U  *p_octet;
+
+
+    (void)unit_nbr;
+    p_octet              = (CPU_INT08U *)p_dest;
+    Sim_SD.DMA_Act       = DEF_YES;
+    Sim_SD_Stat.TimeNs  += SIM_SD_T_DMA_SETUP_NS;               /* See Note #2b.                                        */
+    Sim_SD_Stat.CpuNs   += SIM_SD_T_DMA_SETUP_NS;
+    Sim_SD_Stat.DMA_XferCtr++;
+    while (cnt > 0u) {
+       *p_octet = Sim_SD_Xfer(0xFFu);
+        p_octet++;
+        cnt--;
+    }
+}
+
+
+static  void  Sim_SD_DMA_WrStart (FS_QTY       unit_nbr,
+                                  void        *p_src,
+                                  CPU_SIZE_T   cnt)
+{
+    CPU_INT08U  *p_octet;
+
+
+    (void)unit_nbr;
+    p_octet              = (CPU_INT08U *)p_src;
+    Sim_SD.DMA_Act       = DEF_YES;
+    Sim_SD_Stat.TimeNs  += SIM_SD_T_DMA_SETUP_NS;
+    Sim_SD_Stat.CpuNs   += SIM_SD_T_DMA_SETUP_NS;
+    Sim_SD_Stat.DMA_XferCtr++;
+    while (cnt > 0u) {
+        (void)Sim_SD_Xfer(*p_octet);
+        p_octet++;
+        cnt--;
+    }
+}
+
+
+static  CPU_BOOLEAN  Sim_SD_DMA_Wait (FS_QTY  unit_nbr)
+{
+    (void)unit_nbr;
+    if (Sim_SD.DMA_Act == DEF_NO) {                             /* No xfer started.                                     */
+        Sim_SD_Stat.ViolCtr++;
+        return (DEF_FAIL);
+    }
+    Sim_SD.DMA_Act      = DEF_NO;
+    Sim_SD_Stat.CpuNs  += SIM_SD_T_DMA_IRQ_NS;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Sim_SD_Xfer()
+*
+* Description : Exchange one octet with the card.
+*
+* Argument(s) : octet_in    Octet sent to the card (on DI).
+*
+* Return(s)   : Octet received from the card (on DO).
+*
+* Caller(s)   : SD SPI BSP,
+*               SD SPI DMA BSP.
+*
+* Note(s)     : (1) The card drives DO from the state it is in when the octet starts.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Sim_SD_Xfer (CPU_INT08U  octet_in)
+{
+    CPU_INT08U  octet_out;
+
+
+    octet_out = 0xFFu;
+    if (Sim_SD.Sel == DEF_YES) {
+        octet_out = Sim_SD_OctetOut();                          /* See Note #1.                                         */
+        Sim_SD_OctetIn(octet_in);
+    }
+    Sim_SD_Stat.TimeNs += Sim_SD.OctetNs;
+
+    return (octet_out);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Sim_SD_OctetOut()
+*
+* Description : Get the octet the card drives on DO.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Pending response octet, 0x00 while busy, data packet octet or 0xFF.
+*
+* Caller(s)   : Sim_SD_Xfer().
+*
+* Note(s)     : (1) A data packet is the start block token, the data & its CRC16, sent once the read
+*                   access time has elapsed.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  Sim_SD_OctetOut (void)
+{
+    CPU_INT32U  ix;
+    CPU_INT08U  octet;
+
+
+    if (Sim_SD.RespIx < Sim_SD.RespLen) {
+        octet = Sim_SD.RespBuf[Sim_SD.RespIx];
+        Sim_SD.RespIx++;
+        return (octet);
+    }
+    if (Sim_SD_Stat.TimeNs < Sim_SD.BusyTimeNs) {
+        return (0x00u);
+    }
+    if ((Sim_SD.State        != SIM_SD_ST_RD) ||                /* See Note #1.                                         */
+        (Sim_SD_Stat.TimeNs  <  Sim_SD.RdyTimeNs)) {
+        return (0xFFu);
+    }
+
+    ix = Sim_SD.DataIx;
+    Sim_SD.DataIx++;
+    if (ix == 0u) {
+        return (SIM_SD_TOKEN_START_BLK);
+    }
+    if (ix <= Sim_SD.DataLen) {
+        return (Sim_SD.DataPtr[ix - 1u]);
+    }
+    if (ix == Sim_SD.DataLen + 1u) {
+        return ((CPU_INT08U)(Sim_SD.DataCRC >> 8));
+    }
+    octet = (CPU_INT08U)Sim_SD.DataCRC;
+    Sim_SD_RdNext();
+
+    return (octet);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_SD_OctetIn()
+*
+* Description : Process the octet the host sends on DI.
+*
+* Argument(s) : octet       Octet received.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_SD_Xfer().
+*
+* Note(s)     : (1) A command frame starts with '01' & is 6 octets long.  While a block is read, the host
+*                   may send CMD12.
+*********************************************************************************************************
+*/
+
+static  void  Sim_SD_OctetIn (CPU_INT08U  octet)
+{
+    CPU_INT32U  arg;
+
+
+    switch (Sim_SD.State) {
+        case SIM_SD_ST_WR_TOKEN:
+             Sim_SD_WrToken(octet);
+             return;
+
+
+        case SIM_SD_ST_WR_DATA:
+             Sim_SD.WrBuf[Sim_SD.DataIx] = octet;
+             Sim_SD.DataIx++;
+             if (Sim_SD.DataIx == sizeof(Sim_SD.WrBuf)) {
+                 Sim_SD_WrBlk();
+             }
+             return;
+
+
+        case SIM_SD_ST_IDLE:
+        case SIM_SD_ST_RD:
+        default:
+             break;
+    }
+
+    if ((Sim_SD.CmdLen == 0u) &&                                /* See Note #1.                                         */
+        ((octet & 0xC0u) != 0x40u)) {
+        return;
+    }
+    Sim_SD.CmdBuf[Sim_SD.CmdLen] = octet;
+    Sim_SD.CmdLen++;
+    if (Sim_SD.CmdLen < SIM_SD_CMD_LEN) {
+        return;
+    }
+
+    Sim_SD.CmdLen = 0u;
+    arg = ((CPU_INT32U)Sim_SD.CmdBuf[1] << 24) |
+          ((CPU_INT32U)Sim_SD.CmdBuf[2] << 16) |
+          ((CPU_INT32U)Sim_SD.CmdBuf[3] <<  8) |
+           (CPU_INT32U)Sim_SD.CmdBuf[4];
+    Sim_SD_Cmd(Sim_SD.CmdBuf[0] & 0x3Fu, arg);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Sim_SD_Cmd()
+*
+* Description : Execute a command & queue its response.
+*
+* Argument(s) : cmd         Command index.
+*
+*               arg         Command argument.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_SD_OctetIn().
+*
+* Note(s)     : (1) The response follows one NCR octet (0xFF).  CMD12 is also preceded by a stuff octet.
+*
+*               (2) The command frame CRC is not checked.
+*
+*               (3) A pre-erase count set by ACMD23 applies to the next command only, if it is CMD25.
+*********************************************************************************************************
+*/
+
+static  void  Sim_SD_Cmd (CPU_INT08U  cmd,
+                          CPU_INT32U  arg)
+{
+    CPU_INT08U   r1;
+    CPU_INT08U   r1_ix;
+    CPU_INT32U   ocr;
+    CPU_BOOLEAN  app_cmd;
+
+
+    Sim_SD_Stat.CmdCtr++;
+    if (Sim_SD_Stat.TimeNs < Sim_SD.BusyTimeNs) {               /* See 'sim_sd.c  Note #4'.                             */
+        Sim_SD_Stat.ViolCtr++;
+        return;
+    }
+
+    app_cmd       = Sim_SD.AppCmd;
+    Sim_SD.AppCmd = DEF_NO;
+    if (app_cmd == DEF_YES) {
+        Sim_SD_AppCmd(cmd, arg);
+        return;
+    }
+
+    r1                = (Sim_SD.Idle == DEF_YES) ? SIM_SD_R1_IDLE : 0x00u;
+    r1_ix             =  1u;
+    Sim_SD.RespBuf[0] =  0xFFu;                                 /* See Note #1.                                         */
+    Sim_SD.RespLen    =  2u;
+    Sim_SD.RespIx     =  0u;
+
+    switch (cmd) {
+        case FS_DEV_SD_CMD_GO_IDLE_STATE:
+             Sim_SD.State   = SIM_SD_ST_IDLE;
+             Sim_SD.Idle    = DEF_YES;
+             Sim_SD.InitCtr = 0u;
+             Sim_SD.CRC_En  = DEF_NO;
+             r1             = SIM_SD_R1_IDLE;
+             break;
+
+
+        case FS_DEV_SD_CMD_SEND_IF_COND:                        /* R7 : echo voltage & chk pattern.                     */
+             Sim_SD.RespBuf[2] = 0x00u;
+             Sim_SD.RespBuf[3] = 0x00u;
+             Sim_SD.RespBuf[4] = (CPU_INT08U)((arg >> 8) & 0x0Fu);
+             Sim_SD.RespBuf[5] = (CPU_INT08U) arg;
+             Sim_SD.RespLen    = 6u;
+             break;
+
+
+        case FS_DEV_SD_CMD_APP_CMD:
+             Sim_SD.AppCmd = DEF_YES;
+             break;
+
+
+        case FS_DEV_SD_CMD_READ_OCR:                            /* R3 : OCR, pwr up done once init'd, HC.               */
+             ocr = SIM_SD_OCR_VDD | FS_DEV_SD_OCR_CCS;
+             if (Sim_SD.Idle == DEF_NO) {
+                 ocr |= FS_DEV_SD_OCR_BUSY;
+             }
+             Sim_SD.RespBuf[2] = (CPU_INT08U)(ocr >> 24);
+             Sim_SD.RespBuf[3] = (CPU_INT08U)(ocr >> 16);
+             Sim_SD.RespBuf[4] = (CPU_INT08U)(ocr >>  8);
+             Sim_SD.RespBuf[5] = (CPU_INT08U) ocr;
+             Sim_SD.RespLen    = 6u;
+             break;
+
+
+        case FS_DEV_SD_CMD_CRC_ON_OFF:
+             Sim_SD.CRC_En = DEF_BIT_IS_SET(arg, DEF_BIT_00);
+             break;
+
+
+        case FS_DEV_SD_CMD_SET_BLOCKLEN:
+             if (arg != SIM_SD_BLK_SIZE) {
+                 r1 |= SIM_SD_R1_PARAM_ERR;
+             }
+             break;
+
+
+        case FS_DEV_SD_CMD_SEND_CSD:
+        case FS_DEV_SD_CMD_SEND_CID:
+             if (Sim_SD.Idle == DEF_YES) {
+                 r1 |= SIM_SD_R1_ILLEGAL_CMD;
+                 break;
+             }
+             Sim_SD.Multi = DEF_NO;
+             Sim_SD_RdStart((cmd == FS_DEV_SD_CMD_SEND_CSD) ? Sim_SD.CSD : Sim_SD.CID,
+                             SIM_SD_REG_LEN,
+                             SIM_SD_T_REG_NS);
+             break;
+
+
+        case FS_DEV_SD_CMD_READ_SINGLE_BLOCK:
+        case FS_DEV_SD_CMD_READ_MULTIPLE_BLOCK:
+             if (Sim_SD.Idle == DEF_YES) {
+                 r1 |= SIM_SD_R1_ILLEGAL_CMD;
+                 break;
+             }
+             if (arg >= Sim_SD.BlkCnt) {
+                 r1 |= SIM_SD_R1_ADDR_ERR;
+                 break;
+             }
+             Sim_SD.Multi = (cmd == FS_DEV_SD_CMD_READ_MULTIPLE_BLOCK) ? DEF_YES : DEF_NO;
+             Sim_SD.BlkIx =  arg;
+             if (Sim_SD.Multi == DEF_YES) {
+                 Sim_SD_Stat.RdMultiCtr++;
+             }
+             Sim_SD_RdStart(Sim_SD.ImgPtr + ((CPU_SIZE_T)arg * SIM_SD_BLK_SIZE),
+                            SIM_SD_BLK_SIZE,
+                            SIM_SD_T_RD_ACCESS_NS);
+             break;
+
+
+        case FS_DEV_SD_CMD_STOP_TRANSMISSION:
+             if (Sim_SD.State == SIM_SD_ST_RD) {
+                 Sim_SD.State = SIM_SD_ST_IDLE;
+                 Sim_SD_BusySet(SIM_SD_T_RD_STOP_NS);
+             }
+             Sim_SD.RespBuf[1] = 0xFFu;                         /* See Note #1.                                         */
+             Sim_SD.RespLen    = 3u;
+             r1_ix             = 2u;
+             break;
+
+
+        case FS_DEV_SD_CMD_WRITE_BLOCK:
+        case FS_DEV_SD_CMD_WRITE_MULTIPLE_BLOCK:
+             if (Sim_SD.Idle == DEF_YES) {
+                 r1 |= SIM_SD_R1_ILLEGAL_CMD;
+                 break;
+             }
+             if (arg >= Sim_SD.BlkCnt) {
+                 r1 |= SIM_SD_R1_ADDR_ERR;
+                 break;
+             }
+             Sim_SD.State       = SIM_SD_ST_WR_TOKEN;
+             Sim_SD.Multi       = (cmd == FS_DEV_SD_CMD_WRITE_MULTIPLE_BLOCK) ? DEF_YES : DEF_NO;
+             Sim_SD.BlkIx       =  arg;
+             Sim_SD.PreEraseRem =  0u;
+             Sim_SD.PreErased   =  DEF_NO;
+             if (Sim_SD.Multi == DEF_YES) {                     /* See Note #3.                                         */
+                 Sim_SD_Stat.WrMultiCtr++;
+                 if (Sim_SD.PreEraseCnt > 0u) {
+                     Sim_SD.PreEraseRem = Sim_SD.PreEraseCnt;
+                     Sim_SD.PreErased   = DEF_YES;
+                     Sim_SD_Stat.PreEraseCtr++;
+                 }
+             }
+             break;
+
+
+        case FS_DEV_SD_CMD_SEND_STATUS:                         /* R2.                                                  */
+             Sim_SD.RespBuf[2] = 0x00u;
+             Sim_SD.RespLen    = 3u;
+             break;
+
+
+        default:
+             r1 |= SIM_SD_R1_ILLEGAL_CMD;
+             break;
+    }
+
+    if (cmd != FS_DEV_SD_CMD_APP_CMD) {
+        Sim_SD.PreEraseCnt = 0u;
+    }
+    Sim_SD.RespBuf[r1_ix] = r1;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_SD_AppCmd()
+*
+* Description : Execute an application-specific command (preceded by CMD55) & queue its response.
+*
+* Argument(s) : cmd         Command index.
+*
+*               arg         Command argument.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_SD_Cmd().
+*
+* Note(s)     : (1) The card leaves the idle state on the second ACMD41 after CMD0.
+*********************************************************************************************************
+*/
+
+static  void  Sim_SD_AppCmd (CPU_INT08U  cmd,
+                             CPU_INT32U  arg)
+{
+    CPU_INT08U  r1;
+
+
+    r1 = 0x00u;
+    switch (cmd) {
+        case FS_DEV_SD_ACMD_SD_SEND_OP_COND:                    /* See Note #1.                                         */
+             if (Sim_SD.InitCtr > 0u) {
+                 Sim_SD.Idle = DEF_NO;
+             }
+             Sim_SD.InitCtr++;
+             break;
+
+
+        case FS_DEV_SD_ACMD_SET_WR_BLK_ERASE_COUNT:
+             Sim_SD.PreEraseCnt = arg & SIM_SD_PRE_ERASE_CNT_MASK;
+             break;
+
+
+        default:
+             r1 = SIM_SD_R1_ILLEGAL_CMD;
+             break;
+    }
+    if (Sim_SD.Idle == DEF_YES) {
+        r1 |= SIM_SD_R1_IDLE;
+    }
+
+    Sim_SD.RespBuf[0] = 0xFFu;
+    Sim_SD.RespBuf[1] = r1;
+    Sim_SD.RespLen    = 2u;
+    Sim_SD.RespIx     = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_SD_RdStart()
+*
+* Description : Start sending a data packet.
+*
+* Argument(s) : p_data      Pointer to data.
+*
+*               len         Length of data, in octets.
+*
+*               access_ns   Time before the start block token is sent.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_SD_Cmd(),
+*               Sim_SD_RdNext().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  Sim_SD_RdStart (const  CPU_INT08U  *p_data,
+                              CPU_INT32U          len,
+                              CPU_INT32U          access_ns)
+{
+    Sim_SD.State     = SIM_SD_ST_RD;
+    Sim_SD.DataPtr   = p_data;
+    Sim_SD.DataLen   = len;
+    Sim_SD.DataIx    = 0u;
+    Sim_SD.DataCRC   = Sim_SD_CRC16(p_data, len);
+    Sim_SD.RdyTimeNs = Sim_SD_Stat.TimeNs + Sim_SD.OctetNs + access_ns;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Sim_SD_RdNext()
+*
+* Description : End the data packet that was sent & start the next one of a multiple block read.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_SD_OctetOut().
+*
+* Note(s)     : (1) A multiple block read stops at the last block of the card.
+*********************************************************************************************************
+*/
+
+static  void  Sim_SD_RdNext (void)
+{
+    if (Sim_SD.DataLen == SIM_SD_BLK_SIZE) {                    /* Data blk (not reg).                                  */
+        Sim_SD_Stat.RdBlkCtr++;
+        Sim_SD_Stat.RdOctets += SIM_SD_BLK_SIZE;
+    }
+
+    Sim_SD.State = SIM_SD_ST_IDLE;
+    if (Sim_SD.Multi == DEF_NO) {
+        return;
+    }
+    Sim_SD.BlkIx++;
+    if (Sim_SD.BlkIx >= Sim_SD.BlkCnt) {                        /* See Note #1.                                         */
+        return;
+    }
+    Sim_SD_RdStart(Sim_SD.ImgPtr + ((CPU_SIZE_T)Sim_SD.BlkIx * SIM_SD_BLK_SIZE),
+                   SIM_SD_BLK_SIZE,
+                   SIM_SD_T_RD_NEXT_NS);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_SD_WrToken()
+*
+* Description : Process an octet sent while the card waits for a data token.
+*
+* Argument(s) : token       Octet received.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_SD_OctetIn().
+*
+* Note(s)     : (1) The stop transmission token ends a multiple block write; the card is then busy until
+*                   every block is programmed.
+*********************************************************************************************************
+*/
+
+static  void  Sim_SD_WrToken (CPU_INT08U  token)
+{
+    if (token == 0xFFu) {
+        return;
+    }
+    if (Sim_SD_Stat.TimeNs < Sim_SD.BusyTimeNs) {               /* See 'sim_sd.c  Note #4'.                             */
+        Sim_SD_Stat.ViolCtr++;
+        return;
+    }
+
+    if (token == ((Sim_SD.Multi == DEF_YES) ? SIM_SD_TOKEN_START_BLK_MULT : SIM_SD_TOKEN_START_BLK)) {
+        Sim_SD.State  = SIM_SD_ST_WR_DATA;
+        Sim_SD.DataIx = 0u;
+        return;
+    }
+
+    if ((Sim_SD.Multi == DEF_YES) &&                            /* See Note #1.                                         */
+        (token        == SIM_SD_TOKEN_STOP_TRAN)) {
+        Sim_SD.State = SIM_SD_ST_IDLE;
+        Sim_SD_BusySet((Sim_SD.PreErased == DEF_YES) ? SIM_SD_T_WR_STOP_PRE_NS : SIM_SD_T_WR_STOP_NS);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Sim_SD_WrBlk()
+*
+* Description : Program a received data block & queue its data response token.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Sim_SD_OctetIn().
+*
+* Note(s)     : (1) The CRC16 of the block is checked only once enabled by CMD59.
+*
+*               (2) A multiple block write past the last block of the card gets a write error.
+*********************************************************************************************************
+*/
+
+static  void  Sim_SD_WrBlk (void)
+{
+    CPU_INT16U  crc;
+    CPU_INT32U  busy_ns;
+
+
+    Sim_SD.State   = (Sim_SD.Multi == DEF_YES) ? SIM_SD_ST_WR_TOKEN : SIM_SD_ST_IDLE;
+    Sim_SD.RespLen = 1u;
+    Sim_SD.RespIx  = 0u;
+
+    if (Sim_SD.CRC_En == DEF_YES) {                             /* See Note #1.                                         */
+        crc = (CPU_INT16U)(((CPU_INT16U)Sim_SD.WrBuf[SIM_SD_BLK_SIZE] << 8) | Sim_SD.WrBuf[SIM_SD_BLK_SIZE + 1u]);
+        if (crc != Sim_SD_CRC16(Sim_SD.WrBuf, SIM_SD_BLK_SIZE)) {
+            Sim_SD.RespBuf[0] = SIM_SD_TOKEN_DATA_CRC_ERR;
+            return;
+        }
+    }
+    if (Sim_SD.BlkIx >= Sim_SD.BlkCnt) {                        /* See Note #2.                                         */
+        Sim_SD.RespBuf[0] = SIM_SD_TOKEN_DATA_WR_ERR;
+        return;
+    }
+
+    Mem_Copy(Sim_SD.ImgPtr + ((CPU_SIZE_T)Sim_SD.BlkIx * SIM_SD_BLK_SIZE), Sim_SD.WrBuf, SIM_SD_BLK_SIZE);
+    Sim_SD_Stat.WrBlkCtr++;
+    Sim_SD_Stat.WrOctets += SIM_SD_BLK_SIZE;
+    Sim_SD.RespBuf[0]     = SIM_SD_TOKEN_DATA_ACCEPTED;
+    Sim_SD.BlkIx++;
+
+    if (Sim_SD.Multi == DEF_NO) {
+        busy_ns = SIM_SD_T_WR_BLK_NS;
+    } else if (Sim_SD.PreEraseRem > 0u) {                       /* See 'sim_sd.c  Note #2c'.                            */
+        Sim_SD.PreEraseRem--;
+        busy_ns = SIM_SD_T_WR_PRE_BLK_NS;
+    } else {
+        busy_ns = SIM_SD_T_WR_MULTI_BLK_NS;
+    }
+    Sim_SD_BusySet(busy_ns);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_SD_BusySet()
+*
+* Description : Make the card busy once its pending response is sent.
+*
+* Argument(s) : busy_ns     Busy time.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Various.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  Sim_SD_BusySet (CPU_INT32U  busy_ns)
+{
+    Sim_SD.BusyTimeNs    = Sim_SD_Stat.TimeNs
+                         + ((CPU_INT64U)(Sim_SD.RespLen - Sim_SD.RespIx + 1u) * Sim_SD.OctetNs)
+                         +  busy_ns;
+    Sim_SD_Stat.BusyNs  += busy_ns;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Sim_SD_CRC16()
+*
+* Description : Calculate the CRC16 (CCITT, as used for SD data blocks) of data.
+*
+* Argument(s) : p_data      Pointer to data.
+*
+*               len         Length of data, in octets.
+*
+* Return(s)   : CRC16.
+*
+* Caller(s)   : Sim_SD_RdStart(),
+*               Sim_SD_WrBlk().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Sim_SD_CRC16 (const  CPU_INT08U  *p_data,
+                                  CPU_INT32U          len)
+{
+    CPU_INT16U  crc;
+
+
+    crc = 0u;
+    while (len > 0u) {
+        crc = (CPU_INT16U)((crc << 8) ^ Sim_SD_CRC16_Tbl[((crc >> 8) ^ *p_data) & 0xFFu]);
+        p_data++;
+        len--;
+    }
+
+    return (crc);
+}
@@ -0,0 +1,406 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_shell.c
+*
+* Note(s)  : (1) Replaces the USART2 terminal ('userCode/shell_app.c' & 'terminal_os.c') with a pseudo
+*                terminal : uC/Shell commands are read from the pty master & their output is written
+*                back to it.  Connect to the slave side with any terminal program, e.g.
+*
+*                    picocom /dev/pts/N      or      screen /dev/pts/N
+*
+*            (2) The 'gpu' command table drives the GPU-TFT link from the shell :
+*
+*                    gpu_send <cmd>      Send "<cmd>\r\n" through GPU_tx_and_rx_hand().
+*                    gpu_stat            Display GPU link & emulator statistics.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#define  _GNU_SOURCE
+
+#include  "sim.h"
+#include  "gpu_emu.h"
+#include  "app_cfg.h"
+#include  "cmsis_os.h"
+#include  "trace.h"
+
+#include  <lib_ascii.h>
+#include  <lib_str.h>
+
+#include  "shell.h"
+#include  "sh_shell.h"
+
+#include  <errno.h>
+#include  <fcntl.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <unistd.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  SIM_SHELL_LINE_LEN_MAX                          128u
+#define  SIM_SHELL_TASK_STK_SIZE                      131072u
+
+#define  SIM_SHELL_PROMPT                       (CPU_CHAR *)"\r\n> "
+#define  SIM_SHELL_NEW_LINE                     (CPU_CHAR *)"\r\n"
+
+#define  SIM_SHELL_GPU_CMD_LEN_MAX                        64u
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  int  Sim_ShellFd = -1;
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void        Sim_ShellTask   (void             *p_arg);
+
+static  CPU_INT16S  Sim_ShellOut    (CPU_CHAR         *p_buf,
+                                     CPU_INT16U        buf_len,
+                                     void             *p_opt);
+
+static  CPU_INT16S  Sim_GpuSendCmd  (CPU_INT16U        argc,
+                                     CPU_CHAR         *argv[],
+                                     SHELL_OUT_FNCT    out_fnct,
+                                     SHELL_CMD_PARAM  *pcmd_param);
+
+static  CPU_INT16S  Sim_GpuStatCmd  (CPU_INT16U        argc,
+                                     CPU_CHAR         *argv[],
+                                     SHELL_OUT_FNCT    out_fnct,
+                                     SHELL_CMD_PARAM  *pcmd_param);
+
+
+/*
+*********************************************************************************************************
+*                                            COMMAND TABLE
+*********************************************************************************************************
+*/
+
+static  SHELL_CMD  Sim_GpuCmdTbl[] = {
+    {"gpu_send", Sim_GpuSendCmd},
+    {"gpu_stat", Sim_GpuStatCmd},
+    {0,          0             }
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Sim_ShellStart()
+*
+* Description : Initialize uC/Shell, open the pty & start the shell task (see Note #1).
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_OK,   if shell started.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) The name of the pty slave is printed on stdout.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Sim_ShellStart (void)
+{
+    static  const  osThreadAttr_t  attr = {
+        .name       = "Shell",
+        .stack_size = SIM_SHELL_TASK_STK_SIZE,
+        .priority   = osPriorityNormal,
+    };
+    SHELL_ERR     err;
+    CPU_BOOLEAN   ok;
+
+
+    ok = Shell_Init();
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+    ok = ShShell_Init();
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+    Shell_CmdTblAdd((CPU_CHAR *)"gpu", Sim_GpuCmdTbl, &err);
+    if (err != SHELL_ERR_NONE) {
+        return (DEF_FAIL);
+    }
+
+    Sim_ShellFd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (Sim_ShellFd < 0) {
+        return (DEF_FAIL);
+    }
+    if ((grantpt(Sim_ShellFd)  != 0) ||
+        (unlockpt(Sim_ShellFd) != 0)) {
+        return (DEF_FAIL);
+    }
+    printf("USART2 shell on %s\n", ptsname(Sim_ShellFd));       /* See Note #1.                                         */
+    fflush(stdout);
+
+    if (osThreadNew(Sim_ShellTask, DEF_NULL, &attr) == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           Sim_ShellTask()
+*
+* Description : Read command lines from the pty, with echo & backspace handling, & execute them.
+*
+* Argument(s) : p_arg       Unused.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : OS shim thread wrapper.
+*
+* Note(s)     : (1) Reading fails with EIO while no terminal is attached to the slave side; the task polls
+*                   until one is.
+*********************************************************************************************************
+*/
+
+static  void  Sim_ShellTask (void  *p_arg)
+{
+    CPU_CHAR          line[SIM_SHELL_LINE_LEN_MAX];
+    CPU_SIZE_T        len;
+    CPU_CHAR          c;
+    ssize_t           rd_len;
+    CPU_BOOLEAN       session_active;
+    SHELL_CMD_PARAM   cmd_param;
+    SHELL_ERR         err;
+
+
+    (void)p_arg;
+
+    session_active             = DEF_YES;
+    cmd_param.pcur_working_dir = DEF_NULL;
+    cmd_param.pout_opt         = DEF_NULL;
+    cmd_param.psession_active  = &session_active;
+
+    len = 0u;
+    for (;;) {
+        rd_len = read(Sim_ShellFd, &c, 1u);
+        if (rd_len <= 0) {
+            if ((rd_len < 0) && (errno == EINTR)) {
+                continue;
+            }
+            osDelay(100u);                                      /* See Note #1.                                         */
+            continue;
+        }
+
+        switch (c) {
+            case ASCII_CHAR_CARRIAGE_RETURN:
+            case ASCII_CHAR_LINE_FEED:
+                 (void)Sim_ShellOut(SIM_SHELL_NEW_LINE, 2u, DEF_NULL);
+                 if (len > 0u) {
+                     line[len] = ASCII_CHAR_NULL;
+                     (void)Shell_Exec(line, Sim_ShellOut, &cmd_param, &err);
+                     if (err == SHELL_ERR_CMD_NOT_FOUND) {
+                         (void)Sim_ShellOut((CPU_CHAR *)"Command not found", 17u, DEF_NULL);
+                     }
+                 }
+                 (void)Sim_ShellOut(SIM_SHELL_PROMPT, 4u, DEF_NULL);
+                 len = 0u;
+                 break;
+
+            case ASCII_CHAR_BACKSPACE:
+            case ASCII_CHAR_DELETE:
+                 if (len > 0u) {
+                     len--;
+                     (void)Sim_ShellOut((CPU_CHAR *)"\b \b", 3u, DEF_NULL);
+                 }
+                 break;
+
+            default:
+                 if ((ASCII_IS_PRINT(c) == DEF_YES) &&
+                     (len < (SIM_SHELL_LINE_LEN_MAX - 1u))) {
+                     line[len++] = c;
+                     (void)Sim_ShellOut(&c, 1u, DEF_NULL);
+                 }
+                 break;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Sim_ShellOut()
+*
+* Description : uC/Shell output function : write to the pty.
+*
+* Argument(s) : p_buf       Pointer to data to output.
+*
+*               buf_len     Nbr of octets to output.
+*
+*               p_opt       Unused.
+*
+* Return(s)   : Nbr of octets written, or SHELL_OUT_ERR.
+*
+* Caller(s)   : uC/Shell commands.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16S  Sim_ShellOut (CPU_CHAR    *p_buf,
+                                  CPU_INT16U   buf_len,
+                                  void        *p_opt)
+{
+    ssize_t  len;
+
+
+    (void)p_opt;
+
+    len = write(Sim_ShellFd, p_buf, buf_len);
+
+    return ((len < 0) ? SHELL_OUT_ERR : (CPU_INT16S)len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_GpuSendCmd()
+*
+* Description : Send a GPU-TFT command & report the number of attempts it took (see Note #2).
+*
+* Argument(s) : argc            Nbr of arguments.
+*
+*               argv            Array of arguments.
+*
+*               out_fnct        Output function.
+*
+*               pcmd_param      Pointer to command parameters.
+*
+* Return(s)   : SHELL_ERR_NONE, if NO error(s).
+*
+*               SHELL_EXEC_ERR, otherwise.
+*
+* Caller(s)   : uC/Shell.
+*
+* Note(s)     : (1) Arguments are re-joined with single spaces, since uC/Shell splits the command line.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16S  Sim_GpuSendCmd (CPU_INT16U        argc,
+                                    CPU_CHAR         *argv[],
+                                    SHELL_OUT_FNCT    out_fnct,
+                                    SHELL_CMD_PARAM  *pcmd_param)
+{
+    CPU_CHAR    cmd[SIM_SHELL_GPU_CMD_LEN_MAX];
+    CPU_CHAR    str[64];
+    CPU_INT16U  ix;
+    CPU_INT32U  retry_ctr;
+
+
+    if (argc < 2u) {
+        (void)out_fnct((CPU_CHAR *)"usage: gpu_send <cmd>", 21u, pcmd_param->pout_opt);
+        return (SHELL_EXEC_ERR);
+    }
+
+    cmd[0] = ASCII_CHAR_NULL;
+    for (ix = 1u; ix < argc; ix++) {                            /* See Note #1.                                         */
+        if (ix > 1u) {
+            (void)Str_Cat_N(cmd, (CPU_CHAR *)" ", sizeof(cmd) - Str_Len(cmd) - 3u);
+        }
+        (void)Str_Cat_N(cmd, argv[ix], sizeof(cmd) - Str_Len(cmd) - 3u);
+    }
+    (void)Str_Cat(cmd, (CPU_CHAR *)"\r\n");
+
+    retry_ctr = Sim_TraceEvtCtrGet(TRACE_EVT_GPU_RETRY);
+    (void)GPU_tx_and_rx_hand(cmd, (uint16_t)Str_Len(cmd));
+    retry_ctr = Sim_TraceEvtCtrGet(TRACE_EVT_GPU_RETRY) - retry_ctr;
+
+    (void)snprintf((char *)str, sizeof(str), "%u retr%s", (unsigned)retry_ctr, (retry_ctr == 1u) ? "y" : "ies");
+    (void)out_fnct(str, (CPU_INT16U)Str_Len(str), pcmd_param->pout_opt);
+
+    return (SHELL_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_GpuStatCmd()
+*
+* Description : Display GPU link & emulator statistics (see Note #2).
+*
+* Argument(s) : argc            Nbr of arguments.
+*
+*               argv            Array of arguments.
+*
+*               out_fnct        Output function.
+*
+*               pcmd_param      Pointer to command parameters.
+*
+* Return(s)   : SHELL_ERR_NONE.
+*
+* Caller(s)   : uC/Shell.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16S  Sim_GpuStatCmd (CPU_INT16U        argc,
+                                    CPU_CHAR         *argv[],
+                                    SHELL_OUT_FNCT    out_fnct,
+                                    SHELL_CMD_PARAM  *pcmd_param)
+{
+    GPU_EMU_STAT  stat;
+    CPU_CHAR      str[160];
+
+
+    (void)argc;
+    (void)argv;
+
+    GpuEmu_StatGet(&stat);
+    (void)snprintf((char *)str, sizeof(str),
+                   "tx %u  retry %u  | emu cmd %u  reply %u  drop %u  | uart unsolicited %u",
+                   (unsigned)Sim_TraceEvtCtrGet(TRACE_EVT_GPU_TX),
+                   (unsigned)Sim_TraceEvtCtrGet(TRACE_EVT_GPU_RETRY),
+                   (unsigned)stat.CmdCtr,
+                   (unsigned)stat.ReplyCtr,
+                   (unsigned)stat.DropCtr,
+                   (unsigned)Sim_UART_RxDropCtrGet(&huart1));
+    (void)out_fnct(str, (CPU_INT16U)Str_Len(str), pcmd_param->pout_opt);
+
+    return (SHELL_ERR_NONE);
+}
@@ -0,0 +1,325 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_trace.c
+*
+* Note(s)  : (1) Host backend of the event trace API ('userCode/Trace/trace.h'), used in place of
+*                'trace.c', which relies on Cortex-M exclusive accesses & the DWT cycle counter.
+*
+*            (2) Records are appended to a host buffer under a mutex & time-stamped in microseconds since
+*                Sim_OS_Init().  The context byte of each record holds the task nbr of the emitting
+*                thread (see Sim_TaskNbrCur()).
+*
+*            (3) Sim_TraceFileSave() writes the same file format as Trace_FileSave(), so host traces are
+*                converted by 'userCode/Trace/Tools/trace2json.py' without options.
+*
+*            (4) Every event is also counted per id, regardless of buffer space, so that the load test
+*                can report e.g. GPU retries without parsing the trace.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "trace.h"
+#include  "sim.h"
+
+#include  <lib_mem.h>
+#include  <lib_str.h>
+
+#include  <pthread.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  SIM_TRACE_REC_NBR_INIT                         4096u
+#define  SIM_TRACE_REC_NBR_MAX                       1048576u   /* Max nbr of recs kept (12 MB).                        */
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+TRACE_NAME          Trace_NameTbl[TRACE_CFG_NAME_NBR];
+volatile  uint8_t   Trace_En;
+volatile  uint8_t   Trace_CtxCur;                               /* Unused on host (see Note #2).                        */
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  pthread_mutex_t       Sim_TraceMutex = PTHREAD_MUTEX_INITIALIZER;
+static  TRACE_REC            *Sim_TraceRecTbl;
+static  CPU_SIZE_T            Sim_TraceRecNbr;
+static  CPU_SIZE_T            Sim_TraceRecNbrAlloc;
+static  CPU_SIZE_T            Sim_TraceLostCtr;
+static  CPU_INT16U            Sim_TraceNameNbr;
+static  volatile  CPU_INT32U  Sim_TraceEvtCtrTbl[DEF_INT_08U_MAX_VAL + 1u];
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           Sim_TraceInit()
+*
+* Description : Initialize the host trace backend & start recording.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Sim_TraceInit (void)
+{
+    Trace_Clr();
+    Trace_Start();
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Sim_TraceEvtCtrGet()
+*
+* Description : Get the number of events recorded with a given id (see Note #4).
+*
+* Argument(s) : id          Event id.
+*
+* Return(s)   : Nbr of events.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  Sim_TraceEvtCtrGet (CPU_INT08U  id)
+{
+    return (__atomic_load_n(&Sim_TraceEvtCtrTbl[id], __ATOMIC_RELAXED));
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Sim_TraceFileSave()
+*
+* Description : Save the recorded events to a host file (see Note #3).
+*
+* Argument(s) : p_path      Path of file to create.
+*
+* Return(s)   : DEF_OK,   if file saved.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Sim_TraceFileSave (const  char  *p_path)
+{
+    TRACE_FILE_HDR  hdr;
+    FILE           *p_file;
+    CPU_BOOLEAN     ok;
+
+
+    p_file = fopen(p_path, "wb");
+    if (p_file == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    (void)pthread_mutex_lock(&Sim_TraceMutex);
+    hdr.Magic    =  TRACE_FILE_MAGIC;
+    hdr.Ver      =  TRACE_FILE_VER;
+    hdr.RecSize  =  sizeof(TRACE_REC);
+    hdr.TS_Freq  =  SIM_TRACE_TS_FREQ_HZ;
+    hdr.NameNbr  =  Sim_TraceNameNbr;
+    hdr.NameSize =  sizeof(TRACE_NAME);
+
+    ok = (fwrite(&hdr, sizeof(hdr), 1u, p_file) == 1u) ? DEF_OK : DEF_FAIL;
+    if ((ok               == DEF_OK) &&
+        (Sim_TraceNameNbr >  0u)) {
+        ok = (fwrite(Trace_NameTbl, sizeof(TRACE_NAME), Sim_TraceNameNbr, p_file) == Sim_TraceNameNbr) ? DEF_OK : DEF_FAIL;
+    }
+    if ((ok              == DEF_OK) &&
+        (Sim_TraceRecNbr >  0u)) {
+        ok = (fwrite(Sim_TraceRecTbl, sizeof(TRACE_REC), Sim_TraceRecNbr, p_file) == Sim_TraceRecNbr) ? DEF_OK : DEF_FAIL;
+    }
+    (void)pthread_mutex_unlock(&Sim_TraceMutex);
+
+    if (fclose(p_file) != 0) {
+        ok = DEF_FAIL;
+    }
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                  Trace_Init() / Trace_Start() / Trace_Stop()
+*
+* Description : Initialize, start & stop the recorder.
+*********************************************************************************************************
+*/
+
+void  Trace_Init (void)
+{
+    Sim_TraceInit();
+}
+
+
+void  Trace_Start (void)
+{
+    Trace_En = 1u;
+}
+
+
+void  Trace_Stop (void)
+{
+    Trace_En = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Trace_Clr()
+*
+* Description : Discard all recorded events & reset the event counters.
+*********************************************************************************************************
+*/
+
+void  Trace_Clr (void)
+{
+    (void)pthread_mutex_lock(&Sim_TraceMutex);
+    Sim_TraceRecNbr  = 0u;
+    Sim_TraceLostCtr = 0u;
+    Mem_Clr((void *)Sim_TraceEvtCtrTbl, sizeof(Sim_TraceEvtCtrTbl));
+    (void)pthread_mutex_unlock(&Sim_TraceMutex);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Trace_Evt()
+*
+* Description : Record an event.
+*
+* Argument(s) : id          Event id (see 'trace.h').
+*
+*               arg16       Event argument.
+*
+*               arg32       Event argument.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TRACE_EVT(), TRACE_ISR_ENTER(), TRACE_ISR_EXIT().
+*
+* Note(s)     : (1) The buffer grows geometrically up to SIM_TRACE_REC_NBR_MAX records; events past that
+*                   limit are counted but not recorded.
+*********************************************************************************************************
+*/
+
+void  Trace_Evt (uint8_t   id,
+                 uint16_t  arg16,
+                 uint32_t  arg32)
+{
+    TRACE_REC   *p_rec;
+    TRACE_REC   *p_tbl;
+    CPU_SIZE_T   nbr;
+
+
+    (void)__atomic_fetch_add(&Sim_TraceEvtCtrTbl[id], 1u, __ATOMIC_RELAXED);
+
+    (void)pthread_mutex_lock(&Sim_TraceMutex);
+    if (Sim_TraceRecNbr >= Sim_TraceRecNbrAlloc) {              /* See Note #1.                                         */
+        nbr   = (Sim_TraceRecNbrAlloc == 0u) ? SIM_TRACE_REC_NBR_INIT : (Sim_TraceRecNbrAlloc * 2u);
+        p_tbl = DEF_NULL;
+        if (nbr <= SIM_TRACE_REC_NBR_MAX) {
+            p_tbl = (TRACE_REC *)realloc(Sim_TraceRecTbl, nbr * sizeof(TRACE_REC));
+        }
+        if (p_tbl == DEF_NULL) {
+            Sim_TraceLostCtr++;
+            (void)pthread_mutex_unlock(&Sim_TraceMutex);
+            return;
+        }
+        Sim_TraceRecTbl      = p_tbl;
+        Sim_TraceRecNbrAlloc = nbr;
+    }
+
+    p_rec        = &Sim_TraceRecTbl[Sim_TraceRecNbr];
+    p_rec->TS    = (uint32_t)Sim_TimeUsGet();
+    p_rec->Id    =  id;
+    p_rec->Ctx   =  Sim_TaskNbrCur();
+    p_rec->Arg16 =  arg16;
+    p_rec->Arg32 =  arg32;
+    Sim_TraceRecNbr++;
+    (void)pthread_mutex_unlock(&Sim_TraceMutex);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Trace_NameAdd()
+*
+* Description : Record the name of a task or kernel object, for decoding.
+*
+* Argument(s) : type        Name type (see 'trace.h').
+*
+*               id          Task nbr or object address.
+*
+*               p_name      Name.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : OS shim.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Trace_NameAdd (uint8_t       type,
+                     uint32_t      id,
+                     const  char  *p_name)
+{
+    TRACE_NAME  *p_entry;
+
+
+    (void)pthread_mutex_lock(&Sim_TraceMutex);
+    if (Sim_TraceNameNbr < TRACE_CFG_NAME_NBR) {
+        p_entry       = &Trace_NameTbl[Sim_TraceNameNbr];
+        p_entry->Id   =  id;
+        p_entry->Type =  type;
+        Str_Copy_N((CPU_CHAR *)p_entry->Name, (const CPU_CHAR *)p_name, sizeof(p_entry->Name) - 1u);
+        p_entry->Name[sizeof(p_entry->Name) - 1u] = '\0';
+        Sim_TraceNameNbr++;
+    }
+    (void)pthread_mutex_unlock(&Sim_TraceMutex);
+}
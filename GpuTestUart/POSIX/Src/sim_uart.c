@@ -0,0 +1,561 @@
+/*
+*********************************************************************************************************
+*                                        HOST SIMULATION TARGET
+*
+* Filename : sim_uart.c
+*
+* Note(s)  : (1) Emulates the STM32 HAL UART driver in DMA (TX) & interrupt (RX) mode on top of a host
+*                file descriptor :
+*
+*                (a) HAL_UART_Transmit_DMA() hands the buffer to the UART TX thread, which holds it for
+*                    the time the frame takes on the wire at the configured baud rate, writes it to the
+*                    descriptor, then calls HAL_UART_TxCpltCallback(), as the DMA TC interrupt would.
+*
+*                (b) The UART RX thread reads the descriptor; octets are stored in the buffer armed by
+*                    HAL_UART_Receive_IT() & HAL_UART_RxCpltCallback() is called once it is full.
+*                    Octets received while no reception is armed are dropped & counted, like an
+*                    overrun on the target.
+*
+*            (2) Callbacks are traced as USARTx IRQs so the host trace shows the same ISR slices as the
+*                target trace.
+*
+*            (3) The 'USART_TypeDef' instances only serve as identities for 'huart->Instance == USARTx'
+*                comparisons in the application.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "usart.h"
+#include  "sim.h"
+#include  "trace.h"
+
+#include  <KAL/kal.h>
+#include  <lib_mem.h>
+
+#include  <errno.h>
+#include  <stdlib.h>
+#include  <unistd.h>
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  SIM_UART_TASK_STK_SIZE                        65536u
+#define  SIM_UART_TASK_PRIO                               10u
+
+#define  SIM_UART_RX_CHUNK_LEN                            64u
+
+#define  SIM_UART_BITS_PER_OCTET                          10u   /* 8N1 : start + 8 data + stop bits.                    */
+
+
+/*
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  sim_uart {
+    UART_HandleTypeDef   *HandlePtr;
+    int                   Fd;
+    CPU_INT32U            Baud;
+    CPU_INT08U            IRQ_Nbr;
+
+    KAL_SEM_HANDLE        TxSem;                                /* Posted when a TX DMA xfer is started.                */
+    const  CPU_INT08U    *TxBufPtr;
+    CPU_INT16U            TxLen;
+    volatile CPU_BOOLEAN  TxBusy;
+
+    KAL_LOCK_HANDLE       RxLock;                               /* Protects the RX state below.                         */
+    CPU_INT08U           *RxBufPtr;
+    CPU_INT16U            RxLen;
+    CPU_INT16U            RxCnt;
+    CPU_BOOLEAN           RxArmed;
+    volatile CPU_INT32U   RxDropCtr;                            /* Nbr of octets rx'd while no rx was armed.            */
+} SIM_UART;
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+USART_TypeDef       Sim_USART_Tbl[2] = { { 1u }, { 2u } };      /* See Note #3.                                         */
+
+UART_HandleTypeDef  huart1 = { USART1, DEF_NULL };
+UART_HandleTypeDef  huart2 = { USART2, DEF_NULL };
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void         Sim_UART_TxTask   (void        *p_arg);
+
+static  void         Sim_UART_RxTask   (void        *p_arg);
+
+static  CPU_BOOLEAN  Sim_UART_TaskStart(const  char *p_name,
+                                        void       (*p_fnct)(void *),
+                                        SIM_UART    *p_uart);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           Sim_UART_Open()
+*
+* Description : Bind a UART handle to a host file descriptor & start its TX & RX threads.
+*
+* Argument(s) : huart       Pointer to UART handle.
+*
+*               fd          Host file descriptor (socketpair end, pty master, ...).
+*
+*               baud        Emulated baud rate (0 = no line rate emulation).
+*
+* Return(s)   : DEF_OK,   if UART opened.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : main().
+*
+* Note(s)     : (1) Sim_OS_Init() MUST be called first.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Sim_UART_Open (UART_HandleTypeDef  *huart,
+                            int                  fd,
+                            CPU_INT32U           baud)
+{
+    SIM_UART     *p_uart;
+    CPU_BOOLEAN   ok;
+    RTOS_ERR      err;
+
+
+    p_uart = (SIM_UART *)calloc(1u, sizeof(SIM_UART));
+    if (p_uart == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    p_uart->HandlePtr = huart;
+    p_uart->Fd        = fd;
+    p_uart->Baud      = baud;
+    p_uart->IRQ_Nbr   = (huart->Instance == USART1) ? USART1_IRQn : USART2_IRQn;
+
+    p_uart->TxSem = KAL_SemCreate((const CPU_CHAR *)"UART TX", DEF_NULL, &err);
+    if (err != RTOS_ERR_NONE) {
+        free(p_uart);
+        return (DEF_FAIL);
+    }
+    p_uart->RxLock = KAL_LockCreate((const CPU_CHAR *)"UART RX", DEF_NULL, &err);
+    if (err != RTOS_ERR_NONE) {
+        free(p_uart);
+        return (DEF_FAIL);
+    }
+
+    huart->SimPtr = p_uart;
+
+    ok = Sim_UART_TaskStart("UART TX", Sim_UART_TxTask, p_uart);
+    if (ok == DEF_OK) {
+        ok = Sim_UART_TaskStart("UART RX", Sim_UART_RxTask, p_uart);
+    }
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       Sim_UART_RxDropCtrGet()
+*
+* Description : Get the number of octets dropped because no reception was armed (see Note #1b).
+*
+* Argument(s) : huart       Pointer to UART handle.
+*
+* Return(s)   : Nbr of dropped octets.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  Sim_UART_RxDropCtrGet (UART_HandleTypeDef  *huart)
+{
+    SIM_UART  *p_uart;
+
+
+    p_uart = (SIM_UART *)huart->SimPtr;
+    if (p_uart == DEF_NULL) {
+        return (0u);
+    }
+
+    return (p_uart->RxDropCtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Sim_UART_ByteTimeUs()
+*
+* Description : Get the time a number of octets takes on the wire.
+*
+* Argument(s) : baud        Baud rate (0 = infinite).
+*
+*               nbr_octets  Nbr of octets.
+*
+* Return(s)   : Transmission time, in us.
+*
+* Caller(s)   : Sim_UART_TxTask(), GPU emulator.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  Sim_UART_ByteTimeUs (CPU_INT32U  baud,
+                                 CPU_INT32U  nbr_octets)
+{
+    if (baud == 0u) {
+        return (0u);
+    }
+
+    return ((CPU_INT32U)(((CPU_INT64U)nbr_octets * SIM_UART_BITS_PER_OCTET * 1000000u) / baud));
+}
+
+
+/*
+*********************************************************************************************************
+*                                       HAL_UART_Transmit_DMA()
+*
+* Description : Start a DMA transmission (see Note #1a).
+*
+* Argument(s) : huart       Pointer to UART handle.
+*
+*               pData       Pointer to data to transmit; MUST stay valid until the TX complete callback.
+*
+*               Size        Nbr of octets to transmit.
+*
+* Return(s)   : HAL_OK,    if transmission started.
+*
+*               HAL_BUSY,  if a transmission is already in progress.
+*
+*               HAL_ERROR, if invalid argument or UART not opened.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+HAL_StatusTypeDef  HAL_UART_Transmit_DMA (UART_HandleTypeDef  *huart,
+                                          uint8_t             *pData,
+                                          uint16_t             Size)
+{
+    SIM_UART  *p_uart;
+    RTOS_ERR   err;
+
+
+    p_uart = (SIM_UART *)huart->SimPtr;
+    if ((p_uart == DEF_NULL) ||
+        (pData  == DEF_NULL) ||
+        (Size   == 0u)) {
+        return (HAL_ERROR);
+    }
+
+    if (__atomic_exchange_n(&p_uart->TxBusy, DEF_YES, __ATOMIC_ACQUIRE) == DEF_YES) {
+        return (HAL_BUSY);
+    }
+
+    p_uart->TxBufPtr = pData;
+    p_uart->TxLen    = Size;
+    KAL_SemPost(p_uart->TxSem, KAL_OPT_POST_NONE, &err);
+
+    return ((err == RTOS_ERR_NONE) ? HAL_OK : HAL_ERROR);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HAL_UART_Receive_IT()
+*
+* Description : Arm an interrupt-driven reception (see Note #1b).
+*
+* Argument(s) : huart       Pointer to UART handle.
+*
+*               pData       Pointer to receive buffer.
+*
+*               Size        Nbr of octets to receive.
+*
+* Return(s)   : HAL_OK,    if reception armed.
+*
+*               HAL_BUSY,  if a reception is already armed.
+*
+*               HAL_ERROR, if invalid argument or UART not opened.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+HAL_StatusTypeDef  HAL_UART_Receive_IT (UART_HandleTypeDef  *huart,
+                                        uint8_t             *pData,
+                                        uint16_t             Size)
+{
+    SIM_UART           *p_uart;
+    HAL_StatusTypeDef   status;
+    RTOS_ERR            err;
+
+
+    p_uart = (SIM_UART *)huart->SimPtr;
+    if ((p_uart == DEF_NULL) ||
+        (pData  == DEF_NULL) ||
+        (Size   == 0u)) {
+        return (HAL_ERROR);
+    }
+
+    KAL_LockAcquire(p_uart->RxLock, KAL_OPT_PEND_NONE, KAL_TIMEOUT_INFINITE, &err);
+    if (p_uart->RxArmed == DEF_YES) {
+        status = HAL_BUSY;
+    } else {
+        p_uart->RxBufPtr = pData;
+        p_uart->RxLen    = Size;
+        p_uart->RxCnt    = 0u;
+        p_uart->RxArmed  = DEF_YES;
+        status           = HAL_OK;
+    }
+    KAL_LockRelease(p_uart->RxLock, &err);
+
+    return (status);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      HAL_UART_AbortReceive_IT()
+*
+* Description : Abort an armed reception & call the abort complete callback.
+*
+* Argument(s) : huart       Pointer to UART handle.
+*
+* Return(s)   : HAL_OK,    if reception aborted.
+*
+*               HAL_ERROR, if UART not opened.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+HAL_StatusTypeDef  HAL_UART_AbortReceive_IT (UART_HandleTypeDef  *huart)
+{
+    SIM_UART  *p_uart;
+    RTOS_ERR   err;
+
+
+    p_uart = (SIM_UART *)huart->SimPtr;
+    if (p_uart == DEF_NULL) {
+        return (HAL_ERROR);
+    }
+
+    KAL_LockAcquire(p_uart->RxLock, KAL_OPT_PEND_NONE, KAL_TIMEOUT_INFINITE, &err);
+    p_uart->RxArmed = DEF_NO;
+    KAL_LockRelease(p_uart->RxLock, &err);
+
+    TRACE_ISR_ENTER(p_uart->IRQ_Nbr);
+    HAL_UART_AbortReceiveCpltCallback(huart);
+    TRACE_ISR_EXIT(p_uart->IRQ_Nbr);
+
+    return (HAL_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Sim_UART_TxTask()
+*
+* Description : Emulate the TX DMA channel & its transfer complete interrupt (see Note #1a).
+*
+* Argument(s) : p_arg       Pointer to sim UART.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : KAL task wrapper.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  Sim_UART_TxTask (void  *p_arg)
+{
+    SIM_UART           *p_uart;
+    const  CPU_INT08U  *p_buf;
+    CPU_SIZE_T          rem;
+    ssize_t             len;
+    RTOS_ERR            err;
+
+
+    p_uart = (SIM_UART *)p_arg;
+
+    for (;;) {
+        KAL_SemPend(p_uart->TxSem, KAL_OPT_PEND_BLOCKING, KAL_TIMEOUT_INFINITE, &err);
+        if (err != RTOS_ERR_NONE) {
+            continue;
+        }
+
+        Sim_DlyUs(Sim_UART_ByteTimeUs(p_uart->Baud, p_uart->TxLen));
+
+        p_buf = p_uart->TxBufPtr;
+        rem   = p_uart->TxLen;
+        while (rem > 0u) {
+            len = write(p_uart->Fd, p_buf, rem);
+            if (len < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;                                          /* Peer gone : data is lost, as on a disconnected line. */
+            }
+            p_buf += len;
+            rem   -= (CPU_SIZE_T)len;
+        }
+
+        __atomic_store_n(&p_uart->TxBusy, DEF_NO, __ATOMIC_RELEASE);
+
+        TRACE_ISR_ENTER(p_uart->IRQ_Nbr);
+        HAL_UART_TxCpltCallback(p_uart->HandlePtr);
+        TRACE_ISR_EXIT(p_uart->IRQ_Nbr);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Sim_UART_RxTask()
+*
+* Description : Emulate the RXNE interrupt (see Note #1b).
+*
+* Argument(s) : p_arg       Pointer to sim UART.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : KAL task wrapper.
+*
+* Note(s)     : (1) The RX complete callback is called with the RX lock released, so the application may
+*                   re-arm a reception from the callback.
+*********************************************************************************************************
+*/
+
+static  void  Sim_UART_RxTask (void  *p_arg)
+{
+    SIM_UART     *p_uart;
+    CPU_INT08U    chunk[SIM_UART_RX_CHUNK_LEN];
+    ssize_t       len;
+    ssize_t       ix;
+    CPU_BOOLEAN   cplt;
+    RTOS_ERR      err;
+
+
+    p_uart = (SIM_UART *)p_arg;
+
+    for (;;) {
+        len = read(p_uart->Fd, chunk, sizeof(chunk));
+        if (len <= 0) {
+            if ((len < 0) && (errno == EINTR)) {
+                continue;
+            }
+            return;                                             /* Peer closed.                                         */
+        }
+
+        for (ix = 0; ix < len; ix++) {
+            cplt = DEF_NO;
+            KAL_LockAcquire(p_uart->RxLock, KAL_OPT_PEND_NONE, KAL_TIMEOUT_INFINITE, &err);
+            if (p_uart->RxArmed == DEF_YES) {
+                p_uart->RxBufPtr[p_uart->RxCnt] = chunk[ix];
+                p_uart->RxCnt++;
+                if (p_uart->RxCnt >= p_uart->RxLen) {
+                    p_uart->RxArmed = DEF_NO;
+                    cplt            = DEF_YES;
+                }
+            } else {
+                p_uart->RxDropCtr++;
+            }
+            KAL_LockRelease(p_uart->RxLock, &err);
+
+            if (cplt == DEF_YES) {                              /* See Note #1.                                         */
+                TRACE_ISR_ENTER(p_uart->IRQ_Nbr);
+                HAL_UART_RxCpltCallback(p_uart->HandlePtr);
+                TRACE_ISR_EXIT(p_uart->IRQ_Nbr);
+            }
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Sim_UART_TaskStart()
+*
+* Description : Allocate & start a UART emulation thread.
+*
+* Argument(s) : p_name      Thread name.
+*
+*               p_fnct      Thread function.
+*
+*               p_uart      Pointer to sim UART.
+*
+* Return(s)   : DEF_OK,   if thread started.
+*
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Sim_UART_Open().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Sim_UART_TaskStart (const  char  *p_name,
+                                         void        (*p_fnct)(void *),
+                                         SIM_UART     *p_uart)
+{
+    KAL_TASK_HANDLE  task_handle;
+    RTOS_ERR         err;
+
+
+    task_handle = KAL_TaskAlloc((const CPU_CHAR *)p_name,
+                                 DEF_NULL,
+                                 SIM_UART_TASK_STK_SIZE / sizeof(CPU_DATA),
+                                 DEF_NULL,
+                                &err);
+    if (err != RTOS_ERR_NONE) {
+        return (DEF_FAIL);
+    }
+
+    KAL_TaskCreate(task_handle, p_fnct, p_uart, SIM_UART_TASK_PRIO, DEF_NULL, &err);
+
+    return ((err == RTOS_ERR_NONE) ? DEF_OK : DEF_FAIL);
+}
@@ -0,0 +1,651 @@
+/*
+*********************************************************************************************************
+*                                              uC/Common
+*                                 Common Features for Micrium Stacks
+*
+*                    Copyright 2013-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                         uC/Common - Kernel Abstraction Layer (KAL) Benchmark
+*                                            POSIX Threads
+*
+* Filename : kal_bench.c
+* Version  : V1.02.00
+*********************************************************************************************************
+* Notes    : (1) Host program measuring the cost of KAL locks, semaphores and message queues. It reports :
+*
+*                (a) The time, in ns, of an uncontended acquire/release (pend/post) pair.
+*                (b) The throughput and fairness of 1 to 64 threads contending for one object.
+*                (c) The throughput of a Q, with single or batch posts & pends, for one producer & one
+*                    consumer on a KAL_OPT_CREATE_Q_SPSC Q, and for several of each on a regular Q.
+*                    Every message is checked to be received once, in its producer's posting order.
+*                (d) The behaviour of a full Q & the timeout of a pend on an empty Q.
+*
+*                Any failed check prints a message & exits with EXIT_FAILURE.
+*
+*            (2) Build with 'make kal_bench' in 'GpuTestUart/POSIX', or from the repository root with,
+*                e.g. :
+*
+*                    gcc -O2 -pthread -D_XOPEN_SOURCE=600                                       \
+*                        -Iuc-Micrium/Lib -Iuc-Micrium/Lib/Cfg -Iuc-Micrium/CPU -Iuc-Micrium/CPU/Cfg \
+*                        -IMicrium-Probe-TargetCode-410/Micrium/Software/uC-CPU/Posix/GNU            \
+*                        -Iuc-Micrium/Common                                                         \
+*                        uc-Micrium/Common/KAL/POSIX/Bench/kal_bench.c                               \
+*                        uc-Micrium/Common/KAL/POSIX/kal.c                                           \
+*                        uc-Micrium/Lib/lib_mem.c uc-Micrium/Lib/lib_str.c                           \
+*                        uc-Micrium/Lib/lib_ascii.c uc-Micrium/Lib/lib_math.c                        \
+*                        uc-Micrium/CPU/cpu_core.c                                                   \
+*                        Micrium-Probe-TargetCode-410/Micrium/Software/uC-CPU/Posix/GNU/cpu_c.c      \
+*                        -o kal_bench
+*
+*            (3) Contending threads are created directly with pthreads rather than KAL_TaskCreate(),
+*                which requests SCHED_RR and therefore needs elevated privileges.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                             INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "../../kal.h"
+
+#include  <lib_def.h>
+#include  <lib_mem.h>
+
+#include  <pthread.h>
+#include  <sched.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+
+/*
+*********************************************************************************************************
+*                                             LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  KAL_BENCH_MEM_SEG_SIZE                 (64u * 1024u)
+
+#define  KAL_BENCH_UNCONTENDED_ITER             10000000u
+#define  KAL_BENCH_CONTENDED_ITER                 200000u
+#define  KAL_BENCH_THREAD_QTY_MAX                     64u
+
+#define  KAL_BENCH_Q_MSG_QTY                         256u       /* Q size for throughput tests.                         */
+#define  KAL_BENCH_Q_ITER                        1000000u       /* Msgs posted by each producer.                        */
+#define  KAL_BENCH_Q_BATCH_QTY                        16u       /* Msgs per batch post or pend.                         */
+#define  KAL_BENCH_Q_THREAD_QTY                        4u       /* Producers & consumers of the MPMC Q.                 */
+#define  KAL_BENCH_Q_FULL_MSG_QTY                      8u       /* Q size for full Q test.                              */
+#define  KAL_BENCH_Q_TIMEOUT_MS                       20u       /* Pend timeout tested on an empty Q.                   */
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  enum  kal_bench_obj {
+    KAL_BENCH_OBJ_LOCK = 0u,
+    KAL_BENCH_OBJ_SEM
+} KAL_BENCH_OBJ;
+
+typedef  struct  kal_bench_thread {
+    pthread_t        Thread;
+    KAL_BENCH_OBJ    Obj;
+    CPU_INT32U       IterQty;
+    CPU_INT64U       NsMax;                                     /* Longest single acquire observed by this thread.      */
+} KAL_BENCH_THREAD;
+
+typedef  struct  kal_bench_q_thread {
+    pthread_t        Thread;
+    KAL_Q_HANDLE     Q;
+    CPU_INT32U       ProducerIx;                                /* Ix of producer; unused by consumers.                 */
+    CPU_INT32U       MsgQty;                                    /* Nbr of msgs to post or pend.                         */
+    CPU_INT32U       BatchQty;                                  /* Msgs per call; 1 uses KAL_QPost() & KAL_QPend().     */
+    CPU_INT64U       Sum;                                       /* Sum of msg vals pended.                              */
+    CPU_BOOLEAN      OrderOk;                                   /* Msgs of each producer pended in posting order.       */
+} KAL_BENCH_Q_THREAD;
+
+
+/*
+*********************************************************************************************************
+*                                         LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U         KAL_Bench_MemSegData[KAL_BENCH_MEM_SEG_SIZE];
+static  MEM_SEG            KAL_Bench_MemSeg;
+
+static  KAL_LOCK_HANDLE    KAL_Bench_Lock;
+static  KAL_SEM_HANDLE     KAL_Bench_Sem;
+
+static  CPU_INT64U         KAL_Bench_SharedCtr;                 /* Protected by the object under test.                  */
+
+static  KAL_BENCH_THREAD   KAL_Bench_ThreadTbl[KAL_BENCH_THREAD_QTY_MAX];
+
+static  KAL_BENCH_Q_THREAD KAL_Bench_QThreadTbl[2u * KAL_BENCH_Q_THREAD_QTY];
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  CPU_INT64U   KAL_Bench_NsGet         (void);
+
+static  void         KAL_Bench_Acquire       (KAL_BENCH_OBJ   obj);
+
+static  void         KAL_Bench_Release       (KAL_BENCH_OBJ   obj);
+
+static  void         KAL_Bench_Uncontended   (KAL_BENCH_OBJ   obj);
+
+static  void         KAL_Bench_Contended     (KAL_BENCH_OBJ   obj,
+                                              CPU_INT32U      thread_qty);
+
+static  void        *KAL_Bench_ThreadFnct    (void           *p_arg);
+
+static  void         KAL_Bench_Q             (KAL_Q_HANDLE    q,
+                                              CPU_BOOLEAN     is_spsc,
+                                              CPU_INT32U      batch_qty);
+
+static  void         KAL_Bench_QLimits       (void);
+
+static  void        *KAL_Bench_QProducerFnct (void           *p_arg);
+
+static  void        *KAL_Bench_QConsumerFnct (void           *p_arg);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    KAL_CFG        cfg;
+    KAL_Q_EXT_CFG  q_cfg;
+    KAL_Q_HANDLE   q_spsc;
+    KAL_Q_HANDLE   q_mpmc;
+    RTOS_ERR       err;
+    LIB_ERR        err_lib;
+    CPU_INT32U     thread_qty;
+
+
+    Mem_Init();
+    Mem_SegCreate("KAL bench seg",
+                  &KAL_Bench_MemSeg,
+                  (CPU_ADDR)&KAL_Bench_MemSegData[0u],
+                   sizeof(KAL_Bench_MemSegData),
+                   LIB_MEM_PADDING_ALIGN_NONE,
+                  &err_lib);
+    if (err_lib != LIB_MEM_ERR_NONE) {
+        printf("Mem_SegCreate() failed (%u).\n", (unsigned)err_lib);
+        return (EXIT_FAILURE);
+    }
+
+    cfg.MemSegPtr = &KAL_Bench_MemSeg;
+    KAL_Init(&cfg, &err);
+    if (err != RTOS_ERR_NONE) {
+        printf("KAL_Init() failed (%u).\n", (unsigned)err);
+        return (EXIT_FAILURE);
+    }
+
+    KAL_Bench_Lock = KAL_LockCreate("KAL bench lock", DEF_NULL, &err);
+    if (err != RTOS_ERR_NONE) {
+        printf("KAL_LockCreate() failed (%u).\n", (unsigned)err);
+        return (EXIT_FAILURE);
+    }
+
+    KAL_Bench_Sem = KAL_SemCreate("KAL bench sem", DEF_NULL, &err);
+    if (err != RTOS_ERR_NONE) {
+        printf("KAL_SemCreate() failed (%u).\n", (unsigned)err);
+        return (EXIT_FAILURE);
+    }
+    KAL_SemPost(KAL_Bench_Sem, KAL_OPT_POST_NONE, &err);        /* Sem used as a binary lock.                           */
+
+    q_cfg.Opt = KAL_OPT_CREATE_Q_SPSC;
+    q_spsc    = KAL_QCreate("KAL bench SPSC Q", KAL_BENCH_Q_MSG_QTY, &q_cfg, &err);
+    if (err != RTOS_ERR_NONE) {
+        printf("KAL_QCreate() failed (%u).\n", (unsigned)err);
+        return (EXIT_FAILURE);
+    }
+
+    q_mpmc    = KAL_QCreate("KAL bench MPMC Q", KAL_BENCH_Q_MSG_QTY, DEF_NULL, &err);
+    if (err != RTOS_ERR_NONE) {
+        printf("KAL_QCreate() failed (%u).\n", (unsigned)err);
+        return (EXIT_FAILURE);
+    }
+
+                                                                /* ------------------- UNCONTENDED -------------------- */
+    KAL_Bench_Uncontended(KAL_BENCH_OBJ_LOCK);
+    KAL_Bench_Uncontended(KAL_BENCH_OBJ_SEM);
+
+                                                                /* -------------------- CONTENDED --------------------- */
+    printf("\n%-6s %8s %12s %12s %14s\n", "obj", "threads", "ns/op", "Mops/s", "max wait (us)");
+    for (thread_qty = 1u; thread_qty <= KAL_BENCH_THREAD_QTY_MAX; thread_qty *= 2u) {
+        KAL_Bench_Contended(KAL_BENCH_OBJ_LOCK, thread_qty);
+    }
+    for (thread_qty = 1u; thread_qty <= KAL_BENCH_THREAD_QTY_MAX; thread_qty *= 2u) {
+        KAL_Bench_Contended(KAL_BENCH_OBJ_SEM, thread_qty);
+    }
+
+                                                                /* ------------------------ QS ------------------------ */
+    printf("\n%-6s %8s %8s %12s %12s\n", "q", "threads", "batch", "ns/msg", "Mmsgs/s");
+    KAL_Bench_Q(q_spsc, DEF_YES, 1u);
+    KAL_Bench_Q(q_spsc, DEF_YES, KAL_BENCH_Q_BATCH_QTY);
+    KAL_Bench_Q(q_mpmc, DEF_NO,  1u);
+    KAL_Bench_Q(q_mpmc, DEF_NO,  KAL_BENCH_Q_BATCH_QTY);
+
+    KAL_Bench_QLimits();
+
+    return (EXIT_SUCCESS);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_INT64U  KAL_Bench_NsGet (void)
+{
+    struct timespec  ts;
+
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((CPU_INT64U)ts.tv_sec * 1000000000u + (CPU_INT64U)ts.tv_nsec);
+}
+
+
+static  void  KAL_Bench_Acquire (KAL_BENCH_OBJ  obj)
+{
+    RTOS_ERR  err;
+
+
+    if (obj == KAL_BENCH_OBJ_LOCK) {
+        KAL_LockAcquire(KAL_Bench_Lock, KAL_OPT_PEND_NONE, KAL_TIMEOUT_INFINITE, &err);
+    } else {
+        KAL_SemPend(KAL_Bench_Sem, KAL_OPT_PEND_NONE, KAL_TIMEOUT_INFINITE, &err);
+    }
+    if (err != RTOS_ERR_NONE) {
+        printf("Acquire failed (%u).\n", (unsigned)err);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+static  void  KAL_Bench_Release (KAL_BENCH_OBJ  obj)
+{
+    RTOS_ERR  err;
+
+
+    if (obj == KAL_BENCH_OBJ_LOCK) {
+        KAL_LockRelease(KAL_Bench_Lock, &err);
+    } else {
+        KAL_SemPost(KAL_Bench_Sem, KAL_OPT_POST_NONE, &err);
+    }
+    if (err != RTOS_ERR_NONE) {
+        printf("Release failed (%u).\n", (unsigned)err);
+        exit(EXIT_FAILURE);
+    }
+}
+
+
+static  void  KAL_Bench_Uncontended (KAL_BENCH_OBJ  obj)
+{
+    CPU_INT64U  ts_start;
+    CPU_INT64U  ts_end;
+    CPU_INT32U  iter;
+
+
+    ts_start = KAL_Bench_NsGet();
+    for (iter = 0u; iter < KAL_BENCH_UNCONTENDED_ITER; iter++) {
+        KAL_Bench_Acquire(obj);
+        KAL_Bench_Release(obj);
+    }
+    ts_end   = KAL_Bench_NsGet();
+
+    printf("%-6s uncontended %s: %.1f ns/pair\n",
+           (obj == KAL_BENCH_OBJ_LOCK) ? "lock" : "sem",
+           (obj == KAL_BENCH_OBJ_LOCK) ? "acquire+release" : "pend+post",
+           (double)(ts_end - ts_start) / (double)KAL_BENCH_UNCONTENDED_ITER);
+}
+
+
+static  void  KAL_Bench_Contended (KAL_BENCH_OBJ  obj,
+                                   CPU_INT32U     thread_qty)
+{
+    CPU_INT64U  ts_start;
+    CPU_INT64U  ts_end;
+    CPU_INT64U  ns_max;
+    CPU_INT64U  op_qty;
+    CPU_INT32U  ix;
+
+
+    KAL_Bench_SharedCtr = 0u;
+    ns_max              = 0u;
+    op_qty              = (CPU_INT64U)thread_qty * KAL_BENCH_CONTENDED_ITER;
+
+    ts_start = KAL_Bench_NsGet();
+    for (ix = 0u; ix < thread_qty; ix++) {
+        KAL_Bench_ThreadTbl[ix].Obj     = obj;
+        KAL_Bench_ThreadTbl[ix].IterQty = KAL_BENCH_CONTENDED_ITER;
+        KAL_Bench_ThreadTbl[ix].NsMax   = 0u;
+        if (pthread_create(&KAL_Bench_ThreadTbl[ix].Thread,
+                            DEF_NULL,
+                            KAL_Bench_ThreadFnct,
+                           &KAL_Bench_ThreadTbl[ix]) != 0) {
+            printf("pthread_create() failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (ix = 0u; ix < thread_qty; ix++) {
+        (void)pthread_join(KAL_Bench_ThreadTbl[ix].Thread, DEF_NULL);
+        ns_max = DEF_MAX(ns_max, KAL_Bench_ThreadTbl[ix].NsMax);
+    }
+    ts_end   = KAL_Bench_NsGet();
+
+    if (KAL_Bench_SharedCtr != op_qty) {                        /* Mutual exclusion violated.                           */
+        printf("%-6s %8u lost updates: %llu != %llu\n",
+               (obj == KAL_BENCH_OBJ_LOCK) ? "lock" : "sem",
+               (unsigned)thread_qty,
+               (unsigned long long)KAL_Bench_SharedCtr,
+               (unsigned long long)op_qty);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%-6s %8u %12.1f %12.2f %14.1f\n",
+           (obj == KAL_BENCH_OBJ_LOCK) ? "lock" : "sem",
+           (unsigned)thread_qty,
+           (double)(ts_end - ts_start) / (double)op_qty,
+           (double)op_qty * 1000.0 / (double)(ts_end - ts_start),
+           (double)ns_max / 1000.0);
+}
+
+
+static  void  *KAL_Bench_ThreadFnct (void  *p_arg)
+{
+    KAL_BENCH_THREAD  *p_thread;
+    CPU_INT64U         ts_start;
+    CPU_INT64U         ts_wait;
+    CPU_INT32U         iter;
+
+
+    p_thread = (KAL_BENCH_THREAD *)p_arg;
+
+    for (iter = 0u; iter < p_thread->IterQty; iter++) {
+        ts_start = KAL_Bench_NsGet();
+        KAL_Bench_Acquire(p_thread->Obj);
+        ts_wait  = KAL_Bench_NsGet() - ts_start;
+        KAL_Bench_SharedCtr++;
+        KAL_Bench_Release(p_thread->Obj);
+
+        p_thread->NsMax = DEF_MAX(p_thread->NsMax, ts_wait);
+    }
+
+    return (DEF_NULL);
+}
+
+
+static  void  KAL_Bench_Q (KAL_Q_HANDLE  q,
+                           CPU_BOOLEAN   is_spsc,
+                           CPU_INT32U    batch_qty)
+{
+    CPU_INT64U   ts_start;
+    CPU_INT64U   ts_end;
+    CPU_INT64U   sum;
+    CPU_INT64U   msg_qty;
+    CPU_INT32U   thread_qty;
+    CPU_INT32U   ix;
+    CPU_BOOLEAN  order_ok;
+
+
+    thread_qty = (is_spsc == DEF_YES) ? 1u : KAL_BENCH_Q_THREAD_QTY;
+    msg_qty    = (CPU_INT64U)thread_qty * KAL_BENCH_Q_ITER;
+
+    ts_start = KAL_Bench_NsGet();
+    for (ix = 0u; ix < 2u * thread_qty; ix++) {                 /* Consumers first, then producers.                     */
+        KAL_Bench_QThreadTbl[ix].Q          = q;
+        KAL_Bench_QThreadTbl[ix].ProducerIx = (ix < thread_qty) ? 0u : (ix - thread_qty);
+        KAL_Bench_QThreadTbl[ix].MsgQty     = KAL_BENCH_Q_ITER;
+        KAL_Bench_QThreadTbl[ix].BatchQty   = batch_qty;
+        KAL_Bench_QThreadTbl[ix].Sum        = 0u;
+        KAL_Bench_QThreadTbl[ix].OrderOk    = DEF_YES;
+        if (pthread_create(&KAL_Bench_QThreadTbl[ix].Thread,
+                            DEF_NULL,
+                           (ix < thread_qty) ? KAL_Bench_QConsumerFnct : KAL_Bench_QProducerFnct,
+                           &KAL_Bench_QThreadTbl[ix]) != 0) {
+            printf("pthread_create() failed.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    sum      = 0u;
+    order_ok = DEF_YES;
+    for (ix = 0u; ix < 2u * thread_qty; ix++) {
+        (void)pthread_join(KAL_Bench_QThreadTbl[ix].Thread, DEF_NULL);
+        sum += KAL_Bench_QThreadTbl[ix].Sum;
+        if (KAL_Bench_QThreadTbl[ix].OrderOk == DEF_NO) {
+            order_ok = DEF_NO;
+        }
+    }
+    ts_end   = KAL_Bench_NsGet();
+
+    if ((sum      != msg_qty * (msg_qty + 1u) / 2u) ||          /* Each msg val from 1 to msg_qty pended once.          */
+        (order_ok == DEF_NO)) {
+        printf("%-6s %8u %8u lost, duplicated or reordered msgs.\n",
+               (is_spsc == DEF_YES) ? "spsc" : "mpmc",
+               (unsigned)thread_qty,
+               (unsigned)batch_qty);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%-6s %8u %8u %12.1f %12.2f\n",
+           (is_spsc == DEF_YES) ? "spsc" : "mpmc",
+           (unsigned)thread_qty,
+           (unsigned)batch_qty,
+           (double)(ts_end - ts_start) / (double)msg_qty,
+           (double)msg_qty * 1000.0 / (double)(ts_end - ts_start));
+}
+
+
+static  void  KAL_Bench_QLimits (void)
+{
+    KAL_Q_HANDLE  q;
+    void         *msg_tbl[KAL_BENCH_Q_FULL_MSG_QTY + 4u];
+    void         *p_msg;
+    CPU_INT64U    ts_start;
+    CPU_INT64U    ts_wait;
+    KAL_MSG_QTY   qty;
+    CPU_INT32U    ix;
+    RTOS_ERR      err;
+
+
+    q = KAL_QCreate("KAL bench full Q", KAL_BENCH_Q_FULL_MSG_QTY, DEF_NULL, &err);
+    if (err != RTOS_ERR_NONE) {
+        printf("KAL_QCreate() failed (%u).\n", (unsigned)err);
+        exit(EXIT_FAILURE);
+    }
+
+                                                                /* ------------------- EMPTY Q ------------------------ */
+    (void)KAL_QPend(q, KAL_OPT_PEND_NON_BLOCKING, 0u, &err);
+    if (err != RTOS_ERR_WOULD_BLOCK) {
+        printf("q      non-blocking pend on empty Q: err %u.\n", (unsigned)err);
+        exit(EXIT_FAILURE);
+    }
+
+    ts_start = KAL_Bench_NsGet();
+    p_msg    = KAL_QPend(q, KAL_OPT_PEND_NONE, KAL_BENCH_Q_TIMEOUT_MS, &err);
+    ts_wait  = KAL_Bench_NsGet() - ts_start;
+    if ((err     != RTOS_ERR_TIMEOUT) ||
+        (p_msg   != DEF_NULL)         ||
+        (ts_wait <  (CPU_INT64U)KAL_BENCH_Q_TIMEOUT_MS * 1000000u)) {
+        printf("q      pend timeout: err %u after %.1f ms.\n", (unsigned)err, (double)ts_wait / 1000000.0);
+        exit(EXIT_FAILURE);
+    }
+    printf("\nq      pend timeout %u ms on empty Q: returned after %.1f ms\n",
+           (unsigned)KAL_BENCH_Q_TIMEOUT_MS,
+           (double)ts_wait / 1000000.0);
+
+                                                                /* -------------------- FULL Q ------------------------ */
+    for (ix = 0u; ix < KAL_BENCH_Q_FULL_MSG_QTY + 4u; ix++) {
+        msg_tbl[ix] = (void *)(CPU_ADDR)(ix + 1u);
+    }
+
+    qty = KAL_QPostBatch(q, &msg_tbl[0u], KAL_BENCH_Q_FULL_MSG_QTY + 4u, KAL_OPT_POST_NONE, &err);
+    if ((err != RTOS_ERR_NO_MORE_RSRC) ||
+        (qty != KAL_BENCH_Q_FULL_MSG_QTY)) {
+        printf("q      batch post on full Q: %u posted, err %u.\n", (unsigned)qty, (unsigned)err);
+        exit(EXIT_FAILURE);
+    }
+
+    KAL_QPost(q, msg_tbl[KAL_BENCH_Q_FULL_MSG_QTY], KAL_OPT_POST_NONE, &err);
+    if (err != RTOS_ERR_NO_MORE_RSRC) {
+        printf("q      single post on full Q: err %u.\n", (unsigned)err);
+        exit(EXIT_FAILURE);
+    }
+
+    for (ix = 0u; ix < KAL_BENCH_Q_FULL_MSG_QTY + 4u; ix++) {
+        msg_tbl[ix] = DEF_NULL;
+    }
+    qty = KAL_QPendBatch(q, &msg_tbl[0u], KAL_BENCH_Q_FULL_MSG_QTY + 4u, KAL_OPT_PEND_NONE, 0u, &err);
+    if ((err != RTOS_ERR_NONE) ||
+        (qty != KAL_BENCH_Q_FULL_MSG_QTY)) {
+        printf("q      batch pend on full Q: %u pended, err %u.\n", (unsigned)qty, (unsigned)err);
+        exit(EXIT_FAILURE);
+    }
+    for (ix = 0u; ix < KAL_BENCH_Q_FULL_MSG_QTY; ix++) {
+        if (msg_tbl[ix] != (void *)(CPU_ADDR)(ix + 1u)) {
+            printf("q      batch pend on full Q: msg %u out of order.\n", (unsigned)ix);
+            exit(EXIT_FAILURE);
+        }
+    }
+    printf("q      full Q of %u msgs: %u of %u posted in a batch, single post refused, all pended in order\n",
+           (unsigned)KAL_BENCH_Q_FULL_MSG_QTY,
+           (unsigned)KAL_BENCH_Q_FULL_MSG_QTY,
+           (unsigned)KAL_BENCH_Q_FULL_MSG_QTY + 4u);
+}
+
+
+static  void  *KAL_Bench_QProducerFnct (void  *p_arg)
+{
+    KAL_BENCH_Q_THREAD  *p_thread;
+    void                *msg_tbl[KAL_BENCH_Q_BATCH_QTY];
+    CPU_INT32U           seq;
+    CPU_INT32U           qty;
+    CPU_INT32U           qty_posted;
+    CPU_INT32U           ix;
+    RTOS_ERR             err;
+
+
+    p_thread = (KAL_BENCH_Q_THREAD *)p_arg;
+
+    seq = 0u;
+    while (seq < p_thread->MsgQty) {
+        qty = DEF_MIN(p_thread->BatchQty, p_thread->MsgQty - seq);
+        for (ix = 0u; ix < qty; ix++) {                         /* Msg vals 1.. unique across producers.                */
+            msg_tbl[ix] = (void *)(CPU_ADDR)((CPU_ADDR)p_thread->ProducerIx * p_thread->MsgQty + seq + ix + 1u);
+        }
+
+        qty_posted = 0u;
+        while (qty_posted < qty) {                              /* Retry the rest while the Q is full.                  */
+            if (p_thread->BatchQty == 1u) {
+                KAL_QPost(p_thread->Q, msg_tbl[0u], KAL_OPT_POST_NONE, &err);
+                qty_posted = (err == RTOS_ERR_NONE) ? 1u : 0u;
+            } else {
+                qty_posted += KAL_QPostBatch(p_thread->Q,
+                                            &msg_tbl[qty_posted],
+                                             qty - qty_posted,
+                                             KAL_OPT_POST_NONE,
+                                            &err);
+            }
+            if ((err != RTOS_ERR_NONE) &&
+                (err != RTOS_ERR_NO_MORE_RSRC)) {
+                printf("Q post failed (%u).\n", (unsigned)err);
+                exit(EXIT_FAILURE);
+            }
+            if (qty_posted < qty) {
+                (void)sched_yield();
+            }
+        }
+        seq += qty;
+    }
+
+    return (DEF_NULL);
+}
+
+
+static  void  *KAL_Bench_QConsumerFnct (void  *p_arg)
+{
+    KAL_BENCH_Q_THREAD  *p_thread;
+    void                *msg_tbl[KAL_BENCH_Q_BATCH_QTY];
+    CPU_ADDR             last_tbl[KAL_BENCH_Q_THREAD_QTY];
+    CPU_ADDR             val;
+    CPU_INT32U           qty_pended;
+    CPU_INT32U           qty;
+    CPU_INT32U           producer_ix;
+    CPU_INT32U           ix;
+    RTOS_ERR             err;
+
+
+    p_thread = (KAL_BENCH_Q_THREAD *)p_arg;
+    for (ix = 0u; ix < KAL_BENCH_Q_THREAD_QTY; ix++) {
+        last_tbl[ix] = 0u;
+    }
+
+    qty_pended = 0u;
+    while (qty_pended < p_thread->MsgQty) {
+        if (p_thread->BatchQty == 1u) {
+            msg_tbl[0u] = KAL_QPend(p_thread->Q, KAL_OPT_PEND_NONE, KAL_TIMEOUT_INFINITE, &err);
+            qty         = 1u;
+        } else {
+            qty = KAL_QPendBatch(p_thread->Q,
+                                &msg_tbl[0u],
+                                 DEF_MIN(p_thread->BatchQty, p_thread->MsgQty - qty_pended),
+                                 KAL_OPT_PEND_NONE,
+                                 KAL_TIMEOUT_INFINITE,
+                                &err);
+        }
+        if (err != RTOS_ERR_NONE) {
+            printf("Q pend failed (%u).\n", (unsigned)err);
+            exit(EXIT_FAILURE);
+        }
+
+        for (ix = 0u; ix < qty; ix++) {                         /* Chk posting order of each producer.                  */
+            val          = (CPU_ADDR)msg_tbl[ix];
+            producer_ix  = (CPU_INT32U)((val - 1u) / p_thread->MsgQty);
+            if ((producer_ix           >= KAL_BENCH_Q_THREAD_QTY) ||
+                (val                   <= last_tbl[producer_ix])) {
+                p_thread->OrderOk = DEF_NO;
+            } else {
+                last_tbl[producer_ix] = val;
+            }
+            p_thread->Sum += val;
+        }
+        qty_pended += qty;
+    }
+
+    return (DEF_NULL);
+}
@@ -25,7 +25,14 @@
 *********************************************************************************************************
 * Notes    : (1) Requires a Single UNIX Specification, Version 3 compliant operating environment.
 *                On Linux _XOPEN_SOURCE must be defined to at least 600, generally by passing the
-*                -D_XOPEN_SOURCE=600 command line option to GCC.
+*                -D_XOPEN_SOURCE=600 command line option to GCC. On Linux, _GNU_SOURCE is defined below
+*                to expose syscall(), used to reach the futex system call.
+*
+*            (2) Locks and semaphores are implemented on a single 32-bit state word manipulated with
+*                GCC '__atomic' built-ins. The uncontended acquire/release and pend/post paths are a
+*                single compare-and-swap and never enter the kernel. Contended callers sleep on the
+*                state word with the Linux futex system call; on other POSIX systems, they fall back
+*                to yielding the processor until the word changes or the timeout expires.
 *********************************************************************************************************
 */
 
@@ -35,6 +42,10 @@
 *********************************************************************************************************
 */
 
+#if  defined(__linux__) && !defined(_GNU_SOURCE)               /* See Note #1.                                         */
+#define   _GNU_SOURCE
+#endif
+
 #define   MICRIUM_SOURCE
 #define   KAL_MODULE
 
@@ -42,8 +53,17 @@
 
 #include  <lib_def.h>
 
+#include  <errno.h>
 #include  <pthread.h>
+#include  <sched.h>
 #include  <semaphore.h>
+#include  <time.h>
+
+#if defined(__linux__)
+#include  <linux/futex.h>
+#include  <sys/syscall.h>
+#include  <unistd.h>
+#endif
 
 
 /*
@@ -54,6 +74,17 @@
 
 #define KAL_CFG_ARG_CHK_EXT_EN  DEF_ENABLED
 
+#if defined(__linux__)                                          /* See Note #2.                                         */
+#define  KAL_FUTEX_EN                           DEF_ENABLED
+#else
+#define  KAL_FUTEX_EN                           DEF_DISABLED
+#endif
+
+                                                                /* ------------------ LOCK STATE WORD ----------------- */
+#define  KAL_LOCK_STATE_FREE                    0u              /* Lock is free.                                        */
+#define  KAL_LOCK_STATE_LOCKED                  1u              /* Lock is owned, no thread is sleeping on it.          */
+#define  KAL_LOCK_STATE_CONTENDED               2u              /* Lock is owned, threads may be sleeping on it.        */
+
 /*
 *********************************************************************************************************
 *                                            LOCAL CONSTANTS
@@ -83,15 +114,29 @@ typedef  struct  kal_data {
 } KAL_DATA;
 
 typedef  struct  kal_lock {
-    pthread_mutex_t      Mutex;
-    pthread_mutexattr_t  MutexAttr;
+    CPU_INT32U    State;                                        /* Lock state word, futex target.                       */
+    void         *OwnerPtr;                                     /* Id of owning thread (see KAL_ThreadId).              */
+    CPU_INT32U    NestCtr;                                      /* Nbr of nested acquires by owner.                     */
+    CPU_BOOLEAN   IsReentrant;                                  /* Indicates if lock may be re-acquired by its owner.   */
 } KAL_LOCK;
 
 
 typedef  struct  kal_sem {
-    sem_t      Sem;
+    CPU_INT32U    Ctr;                                          /* Sem cnt, futex target.                               */
+    CPU_INT32U    WaitCtr;                                      /* Nbr of threads sleeping on Ctr.                      */
 } KAL_SEM;
 
+typedef  struct  kal_q {
+    void        **MsgTbl;                                       /* Ring of msg ptrs.                                    */
+    CPU_INT32U    MsgQtyMax;                                    /* Max nbr of msgs in ring.                             */
+    CPU_INT32U    IxMask;                                       /* Ring size - 1, ring size being a power of 2.         */
+    CPU_INT32U    HeadIx;                                       /* Free-running ix of next msg to pend.                 */
+    CPU_INT32U    TailIx;                                       /* Free-running ix of next msg to post, futex target.   */
+    CPU_INT32U    WaitCtr;                                      /* Nbr of tasks sleeping on TailIx.                     */
+    CPU_INT32U    LockState;                                    /* Lock state word, unused by SPSC Qs.                  */
+    CPU_BOOLEAN   IsSPSC;                                       /* Indicates if Q has a single producer and consumer.   */
+} KAL_Q;
+
 typedef  struct  kal_task {
     pthread_t       Thread;
     pthread_attr_t  ThreadAttr;
@@ -119,6 +164,8 @@ typedef  struct  kal_task_fnct_info {
 
 static  KAL_DATA  *KAL_DataPtr = DEF_NULL;
 
+static  __thread  CPU_INT08U  KAL_ThreadId;                     /* Addr of this var uniquely identifies calling thread. */
+
 
 /*
 *********************************************************************************************************
@@ -128,6 +175,20 @@ static  KAL_DATA  *KAL_DataPtr = DEF_NULL;
 
 void  *KAL_TaskFnctWrapper(void  *p_arg);
 
+static  void         KAL_DeadlineGet   (      CPU_INT32U        timeout_ms,
+                                              struct timespec  *p_deadline);
+
+static  CPU_BOOLEAN  KAL_FutexWait     (      CPU_INT32U       *p_word,
+                                              CPU_INT32U        val,
+                                        const struct timespec  *p_deadline);
+
+static  void         KAL_FutexWake     (      CPU_INT32U       *p_word,
+                                              CPU_INT32U        nbr_wake);
+
+static  void         KAL_QLockAcquire  (      KAL_Q            *p_q);
+
+static  void         KAL_QLockRelease  (      KAL_Q            *p_q);
+
 
 /*
 *********************************************************************************************************
@@ -183,7 +244,7 @@ void  KAL_Init (KAL_CFG  *p_cfg,
                                                                 /* ------------------ ALLOC KAL DATA ------------------ */
     p_seg = DEF_NULL;
     if (p_cfg != DEF_NULL) {                                    /* Load cfg if given.                                   */
-        KAL_DataPtr->MemSegPtr = p_cfg->MemSegPtr;
+        p_seg = p_cfg->MemSegPtr;
     }
 
     KAL_DataPtr = (KAL_DATA *)Mem_SegAlloc("KAL internal data",
@@ -260,7 +321,17 @@ CPU_BOOLEAN  KAL_FeatureQuery (KAL_FEATURE  feature,
 {
     switch (feature) {
         case KAL_FEATURE_LOCK_CREATE:
+        case KAL_FEATURE_LOCK_ACQUIRE:
+        case KAL_FEATURE_LOCK_RELEASE:
         case KAL_FEATURE_LOCK_DEL:
+        case KAL_FEATURE_SEM_CREATE:
+        case KAL_FEATURE_SEM_PEND:
+        case KAL_FEATURE_SEM_POST:
+        case KAL_FEATURE_SEM_SET:
+        case KAL_FEATURE_SEM_DEL:
+        case KAL_FEATURE_Q_CREATE:
+        case KAL_FEATURE_Q_POST:
+        case KAL_FEATURE_Q_PEND:
              return (DEF_YES);
 
 
@@ -382,6 +453,10 @@ CPU_SIZE_T  KAL_TaskSizeGet (CPU_SIZE_T         stk_size_word,
 * Description : Create a task.
 *
 * Note(s)     : (1) The task must be allocated prior to this call using KAL_TaskAlloc().
+*
+*               (2) Real-time scheduling (SCHED_RR) requires CAP_SYS_NICE. When the process is not
+*                   privileged (e.g. host simulation in CI), the thread is created with the caller's
+*                   scheduling policy instead & the KAL priority is ignored.
 *********************************************************************************************************
 */
 
@@ -439,6 +514,13 @@ void  KAL_TaskCreate (KAL_TASK_HANDLE    task_handle,
                                  &p_task_data->ThreadAttr,
                                   KAL_TaskFnctWrapper,
                          (void *)&fnct_info);
+    if (pthread_err == EPERM) {                                 /* See Note #2.                                         */
+        (void)pthread_attr_setinheritsched(&p_task_data->ThreadAttr, PTHREAD_INHERIT_SCHED);
+        pthread_err = pthread_create(&p_task_data->Thread,
+                                     &p_task_data->ThreadAttr,
+                                      KAL_TaskFnctWrapper,
+                             (void *)&fnct_info);
+    }
     if (pthread_err != 0) {
        *p_err = KAL_ERR_CREATE;
         return;
@@ -477,14 +559,23 @@ void  KAL_TaskDel (KAL_TASK_HANDLE   task_handle,
 *********************************************************************************************************
 */
 
+/*
+*********************************************************************************************************
+*                                          KAL_LockCreate()
+*
+* Description : Create a lock.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
 KAL_LOCK_HANDLE  KAL_LockCreate (const  CPU_CHAR          *p_name,
                                         KAL_LOCK_EXT_CFG  *p_cfg,
                                         KAL_ERR           *p_err)
 {
     KAL_LOCK_HANDLE   handle = KAL_LockHandleNull;
-    KAL_LOCK    *p_lock_data;
+    KAL_LOCK         *p_lock_data;
     LIB_ERR           lib_err;
-    int               pthread_err;
 
 
 #if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
@@ -500,55 +591,28 @@ KAL_LOCK_HANDLE  KAL_LockCreate (const  CPU_CHAR          *p_name,
 #endif
 
     p_lock_data = (KAL_LOCK *)Mem_DynPoolBlkGet(&KAL_DataPtr->LockPool,
-                                                     &lib_err);
+                                                &lib_err);
     if (lib_err != LIB_MEM_ERR_NONE) {
        *p_err = KAL_ERR_MEM_ALLOC;
         return (handle);
     }
 
-                                                                /* ------------------ SET MUTEX ATTR ------------------ */
-    pthread_err = pthread_mutexattr_init(&p_lock_data->MutexAttr);
-    if (pthread_err != 0) {
-       *p_err = KAL_ERR_CREATE;
-        goto fail_release_blk;
-    }
+                                                                /* -------------------- INIT LOCK --------------------- */
+    p_lock_data->State       = KAL_LOCK_STATE_FREE;
+    p_lock_data->OwnerPtr    = DEF_NULL;
+    p_lock_data->NestCtr     = 0u;
+    p_lock_data->IsReentrant = DEF_NO;
 
     if (p_cfg != DEF_NULL) {                                    /* Set attr according to cfg.                           */
         if (DEF_BIT_IS_SET(p_cfg->Opt, KAL_OPT_CREATE_REENTRANT)) {
-            pthread_err = pthread_mutexattr_settype(&p_lock_data->MutexAttr, PTHREAD_MUTEX_RECURSIVE);
-            if (pthread_err != 0) {
-               *p_err = KAL_ERR_CREATE;
-                goto fail_release_attr;
-            }
+            p_lock_data->IsReentrant = DEF_YES;
         }
     }
 
-                                                                /* -------------------- INIT MUTEX -------------------- */
-    pthread_err = pthread_mutex_init(&p_lock_data->Mutex, &p_lock_data->MutexAttr);
-    if (pthread_err != 0) {
-       *p_err = KAL_ERR_CREATE;
-        goto fail_release_attr;
-    }
-
     handle.LockObjPtr = p_lock_data;
 
    *p_err = KAL_ERR_NONE;
     return (handle);
-
-
-fail_release_attr:
-    pthread_err = pthread_mutexattr_destroy(&p_lock_data->MutexAttr);
-    if (pthread_err != 0) {
-        CPU_SW_EXCEPTION(handle);
-    }
-
-fail_release_blk:
-    Mem_DynPoolBlkFree(&KAL_DataPtr->LockPool, (void *)p_lock_data, &lib_err);
-    if (lib_err != LIB_MEM_ERR_NONE) {
-        CPU_SW_EXCEPTION(handle);
-    }
-
-    return (handle);
 }
 
 
@@ -560,13 +624,32 @@ CPU_SIZE_T  KAL_LockSizeGet (KAL_LOCK_EXT_CFG  *p_cfg,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          KAL_LockAcquire()
+*
+* Description : Acquire a lock.
+*
+* Note(s)     : (1) The uncontended path is a single compare-and-swap of the state word from FREE to
+*                   LOCKED. On failure, the state word is exchanged to CONTENDED, so that the owner
+*                   knows it must wake a sleeping thread on release, and the caller sleeps on the
+*                   state word until it is able to exchange a FREE state for a CONTENDED one.
+*
+*               (2) A caller that times out leaves the state word CONTENDED; this only costs the owner
+*                   an unneeded wake on release.
+*********************************************************************************************************
+*/
+
 void  KAL_LockAcquire (KAL_LOCK_HANDLE   lock_handle,
                        KAL_OPT           opt,
                        CPU_INT32U        timeout,
                        KAL_ERR          *p_err)
 {
-    KAL_LOCK  *p_lock_data;
-    int             pthread_err;
+    KAL_LOCK         *p_lock_data;
+    void             *p_self;
+    CPU_INT32U        state;
+    CPU_BOOLEAN       is_avail;
+    struct timespec   deadline;
 
 
 #if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
@@ -579,43 +662,85 @@ void  KAL_LockAcquire (KAL_LOCK_HANDLE   lock_handle,
         return;
     }
 
-    if (opt != 0u) {                                            /* Chk for invalid opt flag.                            */
+    if ((opt & ~(KAL_OPT_PEND_NON_BLOCKING)) != 0u) {           /* Chk for invalid opt flag.                            */
        *p_err = KAL_ERR_INVALID_ARG;
         return;
     }
 #endif
 
     p_lock_data = (KAL_LOCK *)lock_handle.LockObjPtr;
+    p_self      = (void *)&KAL_ThreadId;
+
+    if (__atomic_load_n(&p_lock_data->OwnerPtr, __ATOMIC_RELAXED) == p_self) {
+        if (p_lock_data->IsReentrant == DEF_YES) {              /* Owner re-acquires a re-entrant lock.                 */
+            p_lock_data->NestCtr++;
+           *p_err = KAL_ERR_NONE;
+        } else {
+           *p_err = KAL_ERR_LOCK_OWNER;                         /* Non re-entrant lock would deadlock its owner.        */
+        }
+        return;
+    }
 
-    if (timeout == 0u) {
-        pthread_err = pthread_mutex_lock(&p_lock_data->Mutex);
-        if (pthread_err != 0) {
-           *p_err = KAL_ERR_OS;
+                                                                /* --------------------- FAST PATH -------------------- */
+    state    = KAL_LOCK_STATE_FREE;                             /* See Note #1.                                         */
+    is_avail = __atomic_compare_exchange_n(&p_lock_data->State,
+                                           &state,
+                                            KAL_LOCK_STATE_LOCKED,
+                                            DEF_NO,
+                                            __ATOMIC_ACQUIRE,
+                                            __ATOMIC_RELAXED);
+    if (is_avail == DEF_NO) {
+                                                                /* --------------------- SLOW PATH -------------------- */
+        if (DEF_BIT_IS_SET(opt, KAL_OPT_PEND_NON_BLOCKING) == DEF_YES) {
+           *p_err = KAL_ERR_WOULD_BLOCK;
             return;
         }
-    } else {
-        struct  timespec  ts_timeout;
 
+        KAL_DeadlineGet(timeout, &deadline);
 
-        ts_timeout.tv_sec  =  timeout / 1000u;
-        ts_timeout.tv_nsec = (timeout % 1000u) * 1000u;
+        if (state != KAL_LOCK_STATE_CONTENDED) {
+            state = __atomic_exchange_n(&p_lock_data->State,
+                                         KAL_LOCK_STATE_CONTENDED,
+                                         __ATOMIC_ACQUIRE);
+        }
 
-        pthread_err = pthread_mutex_timedlock(&p_lock_data->Mutex, &ts_timeout);
-        if (pthread_err != 0) {
-           *p_err = KAL_ERR_OS;
-            return;
+        while (state != KAL_LOCK_STATE_FREE) {
+            is_avail = KAL_FutexWait(&p_lock_data->State,
+                                      KAL_LOCK_STATE_CONTENDED,
+                                      (timeout == KAL_TIMEOUT_INFINITE) ? DEF_NULL : &deadline);
+            state    = __atomic_exchange_n(&p_lock_data->State,
+                                            KAL_LOCK_STATE_CONTENDED,
+                                            __ATOMIC_ACQUIRE);
+            if ((state    != KAL_LOCK_STATE_FREE) &&            /* See Note #2.                                         */
+                (is_avail == DEF_NO)) {
+               *p_err = KAL_ERR_TIMEOUT;
+                return;
+            }
         }
     }
 
+    p_lock_data->NestCtr = 1u;
+    __atomic_store_n(&p_lock_data->OwnerPtr, p_self, __ATOMIC_RELAXED);
+
    *p_err = KAL_ERR_NONE;
 }
 
 
+/*
+*********************************************************************************************************
+*                                          KAL_LockRelease()
+*
+* Description : Release a lock.
+*
+* Note(s)     : (1) A thread is woken only if the state word indicates that some may be sleeping on it.
+*********************************************************************************************************
+*/
+
 void  KAL_LockRelease (KAL_LOCK_HANDLE   lock_handle,
                        KAL_ERR          *p_err)
 {
-    KAL_LOCK  *p_lock_data;
-    int             pthread_err;
+    KAL_LOCK    *p_lock_data;
+    CPU_INT32U   state;
 
 
 #if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
@@ -631,22 +756,45 @@ void  KAL_LockRelease (KAL_LOCK_HANDLE   lock_handle,
 
     p_lock_data = (KAL_LOCK *)lock_handle.LockObjPtr;
 
-    pthread_err = pthread_mutex_unlock(&p_lock_data->Mutex);
-    if (pthread_err != 0) {
-       *p_err = KAL_ERR_OS;
+    if (__atomic_load_n(&p_lock_data->OwnerPtr, __ATOMIC_RELAXED) != (void *)&KAL_ThreadId) {
+       *p_err = KAL_ERR_LOCK_OWNER;
+        return;
+    }
+
+    p_lock_data->NestCtr--;
+    if (p_lock_data->NestCtr > 0u) {                            /* Re-entrant lock still held by owner.                 */
+       *p_err = KAL_ERR_NONE;
         return;
     }
 
+    __atomic_store_n(&p_lock_data->OwnerPtr, DEF_NULL, __ATOMIC_RELAXED);
+
+    state = __atomic_exchange_n(&p_lock_data->State,
+                                 KAL_LOCK_STATE_FREE,
+                                 __ATOMIC_RELEASE);
+    if (state == KAL_LOCK_STATE_CONTENDED) {                    /* See Note #1.                                         */
+        KAL_FutexWake(&p_lock_data->State, 1u);
+    }
+
    *p_err = KAL_ERR_NONE;
 }
 
 
+/*
+*********************************************************************************************************
+*                                            KAL_LockDel()
+*
+* Description : Delete a lock.
+*
+* Note(s)     : None.
+*********************************************************************************************************
+*/
+
 void  KAL_LockDel (KAL_LOCK_HANDLE   lock_handle,
                    KAL_ERR          *p_err)
 {
     KAL_LOCK  *p_lock_data;
-    int             pthread_err;
-    LIB_ERR         lib_err;
+    LIB_ERR    lib_err;
 
 
     p_lock_data = (KAL_LOCK *)lock_handle.LockObjPtr;
@@ -655,16 +803,6 @@ void  KAL_LockDel (KAL_LOCK_HANDLE   lock_handle,
         return;
     }
 
-    pthread_err = pthread_mutexattr_destroy(&p_lock_data->MutexAttr);
-    if (pthread_err != 0) {
-        CPU_SW_EXCEPTION(;);
-    }
-
-    pthread_err = pthread_mutex_destroy(&p_lock_data->Mutex);
-    if (pthread_err != 0) {
-        CPU_SW_EXCEPTION(;);
-    }
-
     Mem_DynPoolBlkFree(&KAL_DataPtr->LockPool, (void *)p_lock_data, &lib_err);
     if (lib_err != LIB_MEM_ERR_NONE) {
         CPU_SW_EXCEPTION(;);
@@ -695,9 +833,8 @@ KAL_SEM_HANDLE  KAL_SemCreate (const  CPU_CHAR         *p_name,
                                       KAL_ERR          *p_err)
 {
     KAL_SEM_HANDLE   handle = KAL_SemHandleNull;
-    KAL_SEM    *p_sem_data;
+    KAL_SEM         *p_sem_data;
     LIB_ERR          lib_err;
-    int              sem_err;
 
 
 #if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
@@ -712,22 +849,15 @@ KAL_SEM_HANDLE  KAL_SemCreate (const  CPU_CHAR         *p_name,
 #endif
 
     p_sem_data = (KAL_SEM *)Mem_DynPoolBlkGet(&KAL_DataPtr->SemPool,
-                                                   &lib_err);
+                                              &lib_err);
     if (lib_err != LIB_MEM_ERR_NONE) {
        *p_err = KAL_ERR_MEM_ALLOC;
         return (handle);
     }
 
                                                                 /* --------------------- INIT SEM --------------------- */
-    sem_err = sem_init(&p_sem_data->Sem, 0u, 0u);
-    if (sem_err != 0) {
-      *p_err = KAL_ERR_CREATE;
-       Mem_DynPoolBlkFree(&KAL_DataPtr->SemPool, (void *)p_sem_data, &lib_err);
-       if (lib_err != LIB_MEM_ERR_NONE) {
-           CPU_SW_EXCEPTION(handle);
-       }
-       return (handle);
-    }
+    p_sem_data->Ctr     = 0u;
+    p_sem_data->WaitCtr = 0u;
 
     handle.SemObjPtr = p_sem_data;
 
@@ -760,7 +890,12 @@ CPU_SIZE_T  KAL_SemSizeGet (KAL_SEM_EXT_CFG  *p_cfg,
 *
 * Description : Pend on a semaphore.
 *
-* Note(s)     : None.
+* Note(s)     : (1) The uncontended path is a single compare-and-swap decrementing a non-zero count.
+*
+*               (2) The waiter ctr is incremented before sleeping on a zero count, and KAL_SemPost()
+*                   increments the count before reading the waiter ctr. Since both use sequentially
+*                   consistent ordering, either the poster sees the waiter and wakes it, or the
+*                   futex wait sees the non-zero count and returns immediately.
 *********************************************************************************************************
 */
 
@@ -769,8 +904,11 @@ void  KAL_SemPend (KAL_SEM_HANDLE   sem_handle,
                    CPU_INT32U       timeout,
                    KAL_ERR         *p_err)
 {
-    KAL_SEM  *p_sem_data;
-    int            sem_err;
+    KAL_SEM          *p_sem_data;
+    CPU_INT32U        cnt;
+    CPU_BOOLEAN       is_deadline_set;
+    CPU_BOOLEAN       is_woken;
+    struct timespec   deadline;
 
 
 #if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
@@ -783,35 +921,53 @@ void  KAL_SemPend (KAL_SEM_HANDLE   sem_handle,
         return;
     }
 
-    if (opt != 0u) {                                            /* Chk for invalid opt flag.                            */
+    if ((opt & ~(KAL_OPT_PEND_NON_BLOCKING)) != 0u) {           /* Chk for invalid opt flag.                            */
        *p_err = KAL_ERR_INVALID_ARG;
         return;
     }
 #endif
 
-    p_sem_data = (KAL_SEM *)sem_handle.SemObjPtr;
+    p_sem_data      = (KAL_SEM *)sem_handle.SemObjPtr;
+    is_deadline_set =  DEF_NO;
+    cnt             = __atomic_load_n(&p_sem_data->Ctr, __ATOMIC_RELAXED);
+
+    for (;;) {
+        while (cnt > 0u) {                                      /* See Note #1.                                         */
+            if (__atomic_compare_exchange_n(&p_sem_data->Ctr,
+                                            &cnt,
+                                             cnt - 1u,
+                                             DEF_NO,
+                                             __ATOMIC_ACQUIRE,
+                                             __ATOMIC_RELAXED) == DEF_YES) {
+               *p_err = KAL_ERR_NONE;
+                return;
+            }
+        }
 
-    if (timeout == 0u) {
-        sem_err = sem_wait(&p_sem_data->Sem);
-        if (sem_err != 0) {
-           *p_err = KAL_ERR_OS;
+        if (DEF_BIT_IS_SET(opt, KAL_OPT_PEND_NON_BLOCKING) == DEF_YES) {
+           *p_err = KAL_ERR_WOULD_BLOCK;
             return;
         }
-    } else {
-        struct  timespec  ts_timeout;
 
-
-        ts_timeout.tv_sec  =  timeout / 1000u;
-        ts_timeout.tv_nsec = (timeout % 1000u) * 1000u;
-
-        sem_err = sem_timedwait(&p_sem_data->Sem, &ts_timeout);
-        if (sem_err != 0) {
-           *p_err = KAL_ERR_OS;
+        if ((timeout         != KAL_TIMEOUT_INFINITE) &&
+            (is_deadline_set == DEF_NO)) {
+            KAL_DeadlineGet(timeout, &deadline);
+            is_deadline_set = DEF_YES;
+        }
+                                                                /* See Note #2.                                         */
+        __atomic_fetch_add(&p_sem_data->WaitCtr, 1u, __ATOMIC_SEQ_CST);
+        is_woken = KAL_FutexWait(&p_sem_data->Ctr,
+                                  0u,
+                                  (is_deadline_set == DEF_YES) ? &deadline : DEF_NULL);
+        __atomic_fetch_sub(&p_sem_data->WaitCtr, 1u, __ATOMIC_SEQ_CST);
+
+        cnt = __atomic_load_n(&p_sem_data->Ctr, __ATOMIC_RELAXED);
+        if ((cnt      == 0u) &&
+            (is_woken == DEF_NO)) {
+           *p_err = KAL_ERR_TIMEOUT;
             return;
         }
     }
-
-   *p_err = KAL_ERR_NONE;
 }
 
 
@@ -821,7 +977,7 @@ void  KAL_SemPend (KAL_SEM_HANDLE   sem_handle,
 *
 * Description : Post a semaphore.
 *
-* Note(s)     : None.
+* Note(s)     : (1) See KAL_SemPend() Note #2.
 *********************************************************************************************************
 */
 
@@ -829,8 +985,8 @@ void  KAL_SemPost (KAL_SEM_HANDLE   sem_handle,
                    KAL_OPT          opt,
                    KAL_ERR         *p_err)
 {
-    KAL_SEM  *p_sem_data;
-    int            sem_err;
+    KAL_SEM     *p_sem_data;
+    CPU_INT32U   cnt;
 
 
 #if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
@@ -851,10 +1007,22 @@ void  KAL_SemPost (KAL_SEM_HANDLE   sem_handle,
 
     p_sem_data = (KAL_SEM *)sem_handle.SemObjPtr;
 
-    sem_err = sem_post(&p_sem_data->Sem);
-    if (sem_err != 0) {
-       *p_err = KAL_ERR_OS;
-        return;
+    cnt = __atomic_load_n(&p_sem_data->Ctr, __ATOMIC_RELAXED);
+    do {
+        if (cnt == DEF_INT_32U_MAX_VAL) {
+           *p_err = KAL_ERR_OVF;
+            return;
+        }
+    } while (__atomic_compare_exchange_n(&p_sem_data->Ctr,
+                                         &cnt,
+                                          cnt + 1u,
+                                          DEF_NO,
+                                          __ATOMIC_SEQ_CST,
+                                          __ATOMIC_RELAXED) == DEF_NO);
+
+                                                                /* See Note #1.                                         */
+    if (__atomic_load_n(&p_sem_data->WaitCtr, __ATOMIC_SEQ_CST) > 0u) {
+        KAL_FutexWake(&p_sem_data->Ctr, 1u);
     }
 
    *p_err = KAL_ERR_NONE;
@@ -892,7 +1060,30 @@ void  KAL_SemSet (KAL_SEM_HANDLE   sem_handle,
                   CPU_INT16U       count,
                   KAL_ERR         *p_err)
 {
-   *p_err = KAL_ERR_UNIMPLEMENTED;
+    KAL_SEM  *p_sem_data;
+
+
+#if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(DEF_NULL);
+    }
+
+    if (sem_handle.SemObjPtr == DEF_NULL) {                     /* Chk for NULL obj ptr.                                */
+       *p_err = KAL_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+    p_sem_data = (KAL_SEM *)sem_handle.SemObjPtr;
+
+    __atomic_store_n(&p_sem_data->Ctr, (CPU_INT32U)count, __ATOMIC_SEQ_CST);
+
+    if ((count > 0u) &&
+        (__atomic_load_n(&p_sem_data->WaitCtr, __ATOMIC_SEQ_CST) > 0u)) {
+        KAL_FutexWake(&p_sem_data->Ctr, count);
+    }
+
+   *p_err = KAL_ERR_NONE;
 }
 
 
@@ -910,17 +1101,11 @@ void  KAL_SemDel (KAL_SEM_HANDLE   sem_handle,
                   KAL_ERR         *p_err)
 {
     KAL_SEM  *p_sem_data;
-    int            sem_err;
-    LIB_ERR        err_lib;
+    LIB_ERR   err_lib;
 
 
     p_sem_data = (KAL_SEM *)sem_handle.SemObjPtr;
 
-    sem_err = sem_destroy(&p_sem_data->Sem);
-    if (sem_err != 0) {
-        CPU_SW_EXCEPTION(;);
-    }
-
     Mem_DynPoolBlkFree(&KAL_DataPtr->SemPool, (void *)p_sem_data, &err_lib);
     if (err_lib != LIB_MEM_ERR_NONE) {
         CPU_SW_EXCEPTION(;);
@@ -981,7 +1166,14 @@ void  KAL_TmrStart (KAL_TMR_HANDLE   tmr,
 *
 * Description : Create a message queue.
 *
-* Note(s)     : None.
+* Note(s)     : (1) The ring holds pointers only; messages are never copied (see 'kal.h  QS  Note #1').
+*                   Its size is rounded up to a power of 2 so that the free-running head and tail
+*                   indices are reduced with a mask, while 'max_msg_qty' still bounds its occupancy.
+*
+*               (2) A Q created with KAL_OPT_CREATE_Q_SPSC is accessed without taking its lock.
+*
+*               (3) The Q & its ring are allocated as one block, the ring following the Q, so that a
+*                   failed allocation leaves nothing behind & KAL_QSizeGet() matches the memory used.
 *********************************************************************************************************
 */
 
@@ -990,9 +1182,61 @@ KAL_Q_HANDLE  KAL_QCreate (const  CPU_CHAR       *p_name,
                                   KAL_Q_EXT_CFG  *p_cfg,
                                   KAL_ERR        *p_err)
 {
-    KAL_Q_HANDLE  handle = {DEF_NULL};
+    KAL_Q_HANDLE   handle = KAL_QHandleNull;
+    KAL_Q         *p_q;
+    CPU_INT32U     size;
+    LIB_ERR        lib_err;
+
+
+#if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(handle);
+    }
+
+    if (max_msg_qty == 0u) {
+       *p_err = KAL_ERR_INVALID_ARG;
+        return (handle);
+    }
+
+    if ((p_cfg != DEF_NULL) &&                                  /* Chk for invalid opt flags.                           */
+        ((p_cfg->Opt & ~(KAL_OPT_CREATE_Q_SPSC)) != 0u)) {
+       *p_err = KAL_ERR_INVALID_ARG;
+        return (handle);
+    }
+#endif
+
+    size = 1u;                                                  /* See Note #1.                                         */
+    while (size < max_msg_qty) {
+        size <<= 1u;
+    }
+
+    p_q = (KAL_Q *)Mem_SegAlloc("KAL Q",                        /* See Note #3.                                         */
+                                 KAL_DataPtr->MemSegPtr,
+                                 sizeof(KAL_Q) + (sizeof(void *) * size),
+                                &lib_err);
+    if (lib_err != LIB_MEM_ERR_NONE) {
+       *p_err = KAL_ERR_MEM_ALLOC;
+        return (handle);
+    }
+
+    p_q->MsgTbl    = (void **)(p_q + 1u);
+    p_q->MsgQtyMax = max_msg_qty;
+    p_q->IxMask    = size - 1u;
+    p_q->HeadIx    = 0u;
+    p_q->TailIx    = 0u;
+    p_q->WaitCtr   = 0u;
+    p_q->LockState = KAL_LOCK_STATE_FREE;
+    p_q->IsSPSC    = DEF_NO;
+
+    if (p_cfg != DEF_NULL) {                                    /* See Note #2.                                         */
+        if (DEF_BIT_IS_SET(p_cfg->Opt, KAL_OPT_CREATE_Q_SPSC)) {
+            p_q->IsSPSC = DEF_YES;
+        }
+    }
+
+    handle.QObjPtr = (void *)p_q;
+   *p_err          =  KAL_ERR_NONE;
 
-   *p_err = KAL_ERR_UNIMPLEMENTED;
     return (handle);
 }
 
@@ -1011,8 +1255,16 @@ CPU_SIZE_T  KAL_QSizeGet (KAL_MSG_QTY     max_msg_qty,
                           KAL_Q_EXT_CFG  *p_cfg,
                           KAL_ERR        *p_err)
 {
-   *p_err = KAL_ERR_UNIMPLEMENTED;
-    return (0);
+    CPU_INT32U  size;
+
+
+    size = 1u;
+    while (size < max_msg_qty) {
+        size <<= 1u;
+    }
+
+   *p_err = KAL_ERR_NONE;
+    return (sizeof(KAL_Q) + (sizeof(void *) * size));
 }
 
 
@@ -1031,7 +1283,11 @@ void  KAL_QPost (KAL_Q_HANDLE   q_handle,
                  KAL_OPT        opt,
                  KAL_ERR       *p_err)
 {
-   *p_err = KAL_ERR_UNIMPLEMENTED;
+    (void)KAL_QPostBatch(q_handle,
+                        &p_msg,
+                         1u,
+                         opt,
+                         p_err);
 }
 
 
@@ -1050,8 +1306,202 @@ void  *KAL_QPend (KAL_Q_HANDLE   q_handle,
                   CPU_INT32U     timeout,
                   KAL_ERR       *p_err)
 {
-   *p_err = KAL_ERR_UNIMPLEMENTED;
-    return (DEF_NULL);
+    void  *p_msg;
+
+
+    p_msg = DEF_NULL;
+    (void)KAL_QPendBatch(q_handle,
+                        &p_msg,
+                         1u,
+                         opt,
+                         timeout,
+                         p_err);
+
+    return (p_msg);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          KAL_QPostBatch()
+*
+* Description : Post several messages on queue at once.
+*
+* Note(s)     : (1) As many messages as fit are posted, in order. If some do not fit, the function
+*                   returns KAL_ERR_RSRC and the caller keeps ownership of the messages at and after the
+*                   returned index.
+*
+*               (2) The tail index is published once for the whole batch, so pending tasks see either
+*                   none or all of the batch, and at most one wake-up is issued per call.
+*********************************************************************************************************
+*/
+
+KAL_MSG_QTY  KAL_QPostBatch (KAL_Q_HANDLE    q_handle,
+                             void          **p_msg_tbl,
+                             KAL_MSG_QTY     msg_qty,
+                             KAL_OPT         opt,
+                             KAL_ERR        *p_err)
+{
+    KAL_Q        *p_q;
+    CPU_INT32U    head_ix;
+    CPU_INT32U    tail_ix;
+    CPU_INT32U    qty_free;
+    KAL_MSG_QTY   qty_post;
+    KAL_MSG_QTY   ix;
+
+
+#if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(0u);
+    }
+
+    if ((q_handle.QObjPtr == DEF_NULL) ||                       /* Chk for NULL obj ptr.                                */
+        (p_msg_tbl        == DEF_NULL)) {
+       *p_err = KAL_ERR_NULL_PTR;
+        return (0u);
+    }
+
+    if (opt != KAL_OPT_POST_NONE) {                             /* Chk for invalid opt flags.                           */
+       *p_err = KAL_ERR_INVALID_ARG;
+        return (0u);
+    }
+#endif
+
+    p_q = (KAL_Q *)q_handle.QObjPtr;
+
+    if (p_q->IsSPSC == DEF_NO) {
+        KAL_QLockAcquire(p_q);
+    }
+                                                                /* Only consumer(s) modify head ix.                     */
+    head_ix  = __atomic_load_n(&p_q->HeadIx, __ATOMIC_ACQUIRE);
+    tail_ix  = p_q->TailIx;
+    qty_free = p_q->MsgQtyMax - (tail_ix - head_ix);
+    qty_post = (KAL_MSG_QTY)DEF_MIN(qty_free, msg_qty);
+
+    for (ix = 0u; ix < qty_post; ix++) {
+        p_q->MsgTbl[(tail_ix + ix) & p_q->IxMask] = p_msg_tbl[ix];
+    }
+                                                                /* See Note #2.                                         */
+    __atomic_store_n(&p_q->TailIx, tail_ix + qty_post, __ATOMIC_SEQ_CST);
+
+    if (p_q->IsSPSC == DEF_NO) {
+        KAL_QLockRelease(p_q);
+    }
+
+    if ((qty_post > 0u) &&                                      /* See KAL_SemPend() Note #2.                           */
+        (__atomic_load_n(&p_q->WaitCtr, __ATOMIC_SEQ_CST) > 0u)) {
+        KAL_FutexWake(&p_q->TailIx, qty_post);
+    }
+
+    if (qty_post < msg_qty) {                                   /* See Note #1.                                         */
+       *p_err = KAL_ERR_RSRC;
+    } else {
+       *p_err = KAL_ERR_NONE;
+    }
+
+    return (qty_post);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          KAL_QPendBatch()
+*
+* Description : Pend on queue and get up to 'msg_qty_max' messages at once.
+*
+* Note(s)     : (1) The task blocks only while the queue is empty. As soon as one message is available,
+*                   every available message, up to 'msg_qty_max', is returned in posting order.
+*
+*               (2) Pending tasks sleep on the tail index, which only posts modify. The value seen
+*                   while the queue was found empty is the futex comparand, so a post occurring
+*                   between the check and the sleep makes the sleep return immediately.
+*********************************************************************************************************
+*/
+
+KAL_MSG_QTY  KAL_QPendBatch (KAL_Q_HANDLE    q_handle,
+                             void          **p_msg_tbl,
+                             KAL_MSG_QTY     msg_qty_max,
+                             KAL_OPT         opt,
+                             CPU_INT32U      timeout,
+                             KAL_ERR        *p_err)
+{
+    KAL_Q            *p_q;
+    CPU_INT32U        head_ix;
+    CPU_INT32U        tail_ix;
+    KAL_MSG_QTY       qty_pend;
+    KAL_MSG_QTY       ix;
+    CPU_BOOLEAN       is_deadline_set;
+    CPU_BOOLEAN       is_woken;
+    struct timespec   deadline;
+
+
+#if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                     /* ---------------- VALIDATE ARGUMENTS ---------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(0u);
+    }
+
+    if ((q_handle.QObjPtr == DEF_NULL) ||                       /* Chk for NULL obj ptr.                                */
+        (p_msg_tbl        == DEF_NULL)) {
+       *p_err = KAL_ERR_NULL_PTR;
+        return (0u);
+    }
+
+    if (((opt & ~(KAL_OPT_PEND_NON_BLOCKING)) != 0u) ||         /* Chk for invalid opt flag.                            */
+         (msg_qty_max                         == 0u)) {
+       *p_err = KAL_ERR_INVALID_ARG;
+        return (0u);
+    }
+#endif
+
+    p_q             = (KAL_Q *)q_handle.QObjPtr;
+    is_deadline_set =  DEF_NO;
+
+    for (;;) {
+        if (p_q->IsSPSC == DEF_NO) {
+            KAL_QLockAcquire(p_q);
+        }
+                                                                /* Only consumer(s) modify head ix.                     */
+        tail_ix  = __atomic_load_n(&p_q->TailIx, __ATOMIC_ACQUIRE);
+        head_ix  = p_q->HeadIx;
+        qty_pend = (KAL_MSG_QTY)DEF_MIN(tail_ix - head_ix, msg_qty_max);
+
+        for (ix = 0u; ix < qty_pend; ix++) {
+            p_msg_tbl[ix] = p_q->MsgTbl[(head_ix + ix) & p_q->IxMask];
+        }
+        __atomic_store_n(&p_q->HeadIx, head_ix + qty_pend, __ATOMIC_RELEASE);
+
+        if (p_q->IsSPSC == DEF_NO) {
+            KAL_QLockRelease(p_q);
+        }
+
+        if (qty_pend > 0u) {                                    /* See Note #1.                                         */
+           *p_err = KAL_ERR_NONE;
+            return (qty_pend);
+        }
+
+        if (DEF_BIT_IS_SET(opt, KAL_OPT_PEND_NON_BLOCKING) == DEF_YES) {
+           *p_err = KAL_ERR_WOULD_BLOCK;
+            return (0u);
+        }
+
+        if ((timeout         != KAL_TIMEOUT_INFINITE) &&
+            (is_deadline_set == DEF_NO)) {
+            KAL_DeadlineGet(timeout, &deadline);
+            is_deadline_set = DEF_YES;
+        }
+                                                                /* See Note #2.                                         */
+        __atomic_fetch_add(&p_q->WaitCtr, 1u, __ATOMIC_SEQ_CST);
+        is_woken = KAL_FutexWait(&p_q->TailIx,
+                                  tail_ix,
+                                  (is_deadline_set == DEF_YES) ? &deadline : DEF_NULL);
+        __atomic_fetch_sub(&p_q->WaitCtr, 1u, __ATOMIC_SEQ_CST);
+
+        if ((is_woken == DEF_NO) &&
+            (__atomic_load_n(&p_q->TailIx, __ATOMIC_ACQUIRE) == tail_ix)) {
+           *p_err = KAL_ERR_TIMEOUT;
+            return (0u);
+        }
+    }
 }
 
 
@@ -1173,3 +1623,198 @@ void  *KAL_TaskFnctWrapper(void  *p_arg)
 }
 
 
+
+/*
+*********************************************************************************************************
+*                                          KAL_DeadlineGet()
+*
+* Description : Convert a relative timeout to an absolute deadline on the monotonic clock.
+*
+* Argument(s) : timeout_ms      Timeout, in milliseconds.
+*
+*               p_deadline      Pointer to variable that will receive the deadline.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  KAL_DeadlineGet (CPU_INT32U        timeout_ms,
+                               struct timespec  *p_deadline)
+{
+    (void)clock_gettime(CLOCK_MONOTONIC, p_deadline);
+
+    p_deadline->tv_sec  +=  timeout_ms / 1000u;
+    p_deadline->tv_nsec += (timeout_ms % 1000u) * 1000000u;
+    if (p_deadline->tv_nsec >= 1000000000L) {
+        p_deadline->tv_sec  += 1;
+        p_deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          KAL_FutexWait()
+*
+* Description : Sleep on a state word while it holds the given value.
+*
+* Argument(s) : p_word          Pointer to state word.
+*
+*               val             Value the state word is expected to hold.
+*
+*               p_deadline      Pointer to absolute deadline on the monotonic clock, DEF_NULL to wait forever.
+*
+* Return(s)   : DEF_NO,  if the deadline expired.
+*
+*               DEF_YES, otherwise.
+*
+* Note(s)     : (1) The function may return spuriously; the caller MUST re-check the state word.
+*
+*               (2) Without futex support, the caller yields the processor instead of sleeping.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  KAL_FutexWait (      CPU_INT32U       *p_word,
+                                          CPU_INT32U        val,
+                                    const struct timespec  *p_deadline)
+{
+#if (KAL_FUTEX_EN == DEF_ENABLED)
+    long  res;
+
+
+    res = syscall(SYS_futex,
+                  p_word,
+                  FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+                  val,
+                  p_deadline,
+                  DEF_NULL,
+                  FUTEX_BITSET_MATCH_ANY);
+    if ((res   == -1) &&
+        (errno == ETIMEDOUT)) {
+        return (DEF_NO);
+    }
+
+    return (DEF_YES);
+#else
+    struct timespec  now;
+
+
+    if (__atomic_load_n(p_word, __ATOMIC_ACQUIRE) != val) {
+        return (DEF_YES);
+    }
+
+    (void)sched_yield();                                        /* See Note #2.                                         */
+
+    if (p_deadline == DEF_NULL) {
+        return (DEF_YES);
+    }
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    if ((now.tv_sec  >  p_deadline->tv_sec) ||
+       ((now.tv_sec  == p_deadline->tv_sec) &&
+        (now.tv_nsec >= p_deadline->tv_nsec))) {
+        return (DEF_NO);
+    }
+
+    return (DEF_YES);
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                          KAL_FutexWake()
+*
+* Description : Wake threads sleeping on a state word.
+*
+* Argument(s) : p_word          Pointer to state word.
+*
+*               nbr_wake        Maximum number of threads to wake.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  KAL_FutexWake (CPU_INT32U  *p_word,
+                             CPU_INT32U   nbr_wake)
+{
+#if (KAL_FUTEX_EN == DEF_ENABLED)
+    (void)syscall(SYS_futex,
+                  p_word,
+                  FUTEX_WAKE | FUTEX_PRIVATE_FLAG,
+                  nbr_wake,
+                  DEF_NULL,
+                  DEF_NULL,
+                  0);
+#else
+    (void)p_word;                                               /* Waiters poll the state word.                         */
+    (void)nbr_wake;
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                         KAL_QLockAcquire()
+*
+* Description : Acquire the internal lock of a multi-producer or multi-consumer queue.
+*
+* Argument(s) : p_q             Pointer to queue.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Same protocol as KAL_LockAcquire(), without timeout or ownership tracking. The lock is
+*                   only held while copying message pointers in or out of the ring.
+*********************************************************************************************************
+*/
+
+static  void  KAL_QLockAcquire (KAL_Q  *p_q)
+{
+    CPU_INT32U  state;
+
+
+    state = KAL_LOCK_STATE_FREE;
+    if (__atomic_compare_exchange_n(&p_q->LockState,
+                                    &state,
+                                     KAL_LOCK_STATE_LOCKED,
+                                     DEF_NO,
+                                     __ATOMIC_ACQUIRE,
+                                     __ATOMIC_RELAXED) == DEF_YES) {
+        return;
+    }
+
+    if (state != KAL_LOCK_STATE_CONTENDED) {
+        state = __atomic_exchange_n(&p_q->LockState, KAL_LOCK_STATE_CONTENDED, __ATOMIC_ACQUIRE);
+    }
+    while (state != KAL_LOCK_STATE_FREE) {
+        (void)KAL_FutexWait(&p_q->LockState, KAL_LOCK_STATE_CONTENDED, DEF_NULL);
+        state = __atomic_exchange_n(&p_q->LockState, KAL_LOCK_STATE_CONTENDED, __ATOMIC_ACQUIRE);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         KAL_QLockRelease()
+*
+* Description : Release the internal lock of a multi-producer or multi-consumer queue.
+*
+* Argument(s) : p_q             Pointer to queue.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  KAL_QLockRelease (KAL_Q  *p_q)
+{
+    if (__atomic_exchange_n(&p_q->LockState, KAL_LOCK_STATE_FREE, __ATOMIC_RELEASE) == KAL_LOCK_STATE_CONTENDED) {
+        KAL_FutexWake(&p_q->LockState, 1u);
+    }
+}
+
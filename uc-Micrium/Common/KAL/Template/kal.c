@@ -821,6 +821,83 @@ void  KAL_QPost (KAL_Q_HANDLE   q_handle,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          KAL_QPendBatch()
+*
+* Description : Pend on queue and get up to 'msg_qty_max' messages at once.
+*
+* Argument(s) : q_handle        Handle of the queue to pend on.
+*
+*               p_msg_tbl       Pointer to table that will receive the messages obtained.
+*
+*               msg_qty_max     Maximum number of messages to obtain.
+*
+*               opt             Options available:
+*                                   KAL_OPT_PEND_NONE:          block until timeout expires or message is available.
+*                                   KAL_OPT_PEND_BLOCKING:      block until timeout expires or message is available.
+*                                   KAL_OPT_PEND_NON_BLOCKING:  return immediately with or without message.
+*
+*               timeout_ms      Timeout, in milliseconds. A value of 0 will never timeout.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function:
+*
+*                                   RTOS_ERR_NOT_SUPPORTED      Function not implemented.
+*
+* Return(s)   : Number of messages obtained.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+KAL_MSG_QTY  KAL_QPendBatch (KAL_Q_HANDLE    q_handle,
+                             void          **p_msg_tbl,
+                             KAL_MSG_QTY     msg_qty_max,
+                             KAL_OPT         opt,
+                             CPU_INT32U      timeout_ms,
+                             RTOS_ERR       *p_err)
+{
+   *p_err = RTOS_ERR_NOT_SUPPORTED;
+    return (0u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          KAL_QPostBatch()
+*
+* Description : Post several messages on queue at once.
+*
+* Argument(s) : q_handle        Handle of the queue on which to post messages.
+*
+*               p_msg_tbl       Pointer to table of messages to post.
+*
+*               msg_qty         Number of messages to post.
+*
+*               opt             Options available:
+*                                   KAL_OPT_POST_NONE:     wake only the highest priority task pending on queue.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function:
+*
+*                                   RTOS_ERR_NOT_SUPPORTED      Function not implemented.
+*
+* Return(s)   : Number of messages posted.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+KAL_MSG_QTY  KAL_QPostBatch (KAL_Q_HANDLE    q_handle,
+                             void          **p_msg_tbl,
+                             KAL_MSG_QTY     msg_qty,
+                             KAL_OPT         opt,
+                             RTOS_ERR       *p_err)
+{
+   *p_err = RTOS_ERR_NOT_SUPPORTED;
+    return (0u);
+}
+
+
 /*
 *********************************************************************************************************
 *                                          DLY API FUNCTIONS
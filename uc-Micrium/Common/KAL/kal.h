@@ -112,6 +112,22 @@
 #define  KAL_OPT_CREATE_REENTRANT      (KAL_OPT)DEF_BIT_00      /* Create     re-entrant lock.                          */
 
 
+/*
+*********************************************************************************************************
+*                                         CREATE OPTS (Q ONLY)
+*
+* Note(s) : (1) KAL_OPT_CREATE_Q_SPSC declares that a single task posts to the queue and a single task
+*               pends on it. Ports MAY use a lock-free path for such queues; ports without one ignore the
+*               option. Using a Q created with this option from more than one producer or more than one
+*               consumer is undefined.
+*********************************************************************************************************
+*/
+
+#define  KAL_OPT_CREATE_Q_NONE         (KAL_OPT)KAL_OPT_NONE
+
+#define  KAL_OPT_CREATE_Q_SPSC         (KAL_OPT)DEF_BIT_00      /* Single producer, single consumer (see Note #1).      */
+
+
 /*
 *********************************************************************************************************
 *                                       PEND OPTS (LOCK, SEM, Q)
@@ -298,7 +314,7 @@ typedef  struct  kal_sem_ext_cfg {                              /* -------------
 } KAL_SEM_EXT_CFG;
 
 typedef  struct  kal_q_ext_cfg {                                /* --------------------- Q EXT CFG -------------------- */
-    CPU_INT32U   Rsvd;                                          /* Rsvd for future use.                                 */
+    KAL_OPT      Opt;                                           /* Opt passed to QCreate() funct.                       */
 } KAL_Q_EXT_CFG;
 
 typedef  struct  kal_tmr_ext_cfg {                              /* -------------------- TMR EXT CFG ------------------- */
@@ -497,6 +513,12 @@ void                  KAL_TmrStart     (      KAL_TMR_HANDLE          tmr_handle
 /*
 *********************************************************************************************************
 *                                                  QS
+*
+* Note(s) : (1) Posting a message transfers its ownership to the queue, and pending transfers it to the
+*               pending task. A producer may therefore hand off buffers obtained with Mem_DynPoolBlkGet()
+*               without copying them; the consumer returns each buffer to its pool with
+*               Mem_DynPoolBlkFree() once it is done with it. Messages that could not be posted remain
+*               owned by the caller.
 *********************************************************************************************************
 */
 
@@ -515,6 +537,19 @@ void                  KAL_QPost        (      KAL_Q_HANDLE            q_handle,
                                               KAL_OPT                 opt,
                                               RTOS_ERR               *p_err);
 
+KAL_MSG_QTY           KAL_QPendBatch   (      KAL_Q_HANDLE            q_handle,
+                                              void                  **p_msg_tbl,
+                                              KAL_MSG_QTY             msg_qty_max,
+                                              KAL_OPT                 opt,
+                                              CPU_INT32U              timeout,
+                                              RTOS_ERR               *p_err);
+
+KAL_MSG_QTY           KAL_QPostBatch   (      KAL_Q_HANDLE            q_handle,
+                                              void                  **p_msg_tbl,
+                                              KAL_MSG_QTY             msg_qty,
+                                              KAL_OPT                 opt,
+                                              RTOS_ERR               *p_err);
+
 
 /*
 *********************************************************************************************************
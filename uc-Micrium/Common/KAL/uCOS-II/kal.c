@@ -1929,7 +1929,7 @@ void  KAL_TmrStart (KAL_TMR_HANDLE   tmr_handle,
 *
 * Return(s)   : Created queue handle.
 *
-* Note(s)     : none.
+* Note(s)     : (1) KAL_OPT_CREATE_Q_SPSC is accepted as a hint; the OS Q is used regardless.
 *********************************************************************************************************
 */
 
@@ -1945,7 +1945,8 @@ KAL_Q_HANDLE  KAL_QCreate (const  CPU_CHAR       *p_name,
         if (p_err == DEF_NULL) {                                /* Validate err ptr.                                    */
             CPU_SW_EXCEPTION(handle);
         }
-        if (p_cfg != DEF_NULL) {                                /* Make sure no unsupported cfg recv.                   */
+        if ((p_cfg != DEF_NULL) &&                              /* Make sure no unsupported cfg recv.                   */
+            (DEF_BIT_IS_SET_ANY(p_cfg->Opt, ~(KAL_OPT_CREATE_Q_SPSC)) == DEF_YES)) {
            *p_err = RTOS_ERR_NOT_SUPPORTED;
             return (handle);
         }
@@ -2210,6 +2211,162 @@ void  KAL_QPost (KAL_Q_HANDLE   q_handle,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          KAL_QPendBatch()
+*
+* Description : Pend on queue and get up to 'msg_qty_max' messages at once.
+*
+* Argument(s) : q_handle        Handle of the queue to pend on.
+*
+*               p_msg_tbl       Pointer to table that will receive the messages obtained.
+*
+*               msg_qty_max     Maximum number of messages to obtain.
+*
+*               opt             Options available:
+*                                   KAL_OPT_PEND_NONE:          block until timeout expires or message is available.
+*                                   KAL_OPT_PEND_BLOCKING:      block until timeout expires or message is available.
+*                                   KAL_OPT_PEND_NON_BLOCKING:  return immediately with or without message.
+*
+*               timeout_ms      Timeout, in milliseconds. A value of 0 will never timeout.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function:
+*
+*                                   RTOS_ERR_NONE               No error.
+*                                   RTOS_ERR_NOT_AVAIL          Configuration does not allow operation.
+*                                   RTOS_ERR_NULL_PTR           Handle or 'p_msg_tbl' contains a NULL/invalid pointer.
+*                                   RTOS_ERR_INVALID_ARG        Handle, options or 'msg_qty_max' specified is invalid.
+*                                   RTOS_ERR_ABORT              Pend operation was aborted.
+*                                   RTOS_ERR_TIMEOUT            Operation timed-out.
+*                                   RTOS_ERR_ISR                Function was called from an ISR.
+*                                   RTOS_ERR_WOULD_BLOCK        KAL_OPT_PEND_NON_BLOCKING opt specified and no
+*                                                               message is available.
+*                                   RTOS_ERR_OS                 Generic OS error.
+*
+* Return(s)   : Number of messages obtained.
+*
+* Note(s)     : (1) The task blocks only for the first message. The messages already queued behind it
+*                   are then collected without blocking.
+*********************************************************************************************************
+*/
+
+KAL_MSG_QTY  KAL_QPendBatch (KAL_Q_HANDLE    q_handle,
+                             void          **p_msg_tbl,
+                             KAL_MSG_QTY     msg_qty_max,
+                             KAL_OPT         opt,
+                             CPU_INT32U      timeout_ms,
+                             RTOS_ERR       *p_err)
+{
+    KAL_MSG_QTY  msg_qty;
+    RTOS_ERR     err;
+
+
+    #if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                 /* ---------------- VALIDATE ARGUMENTS ---------------- */
+        if (p_err == DEF_NULL) {                                /* Validate err ptr.                                    */
+            CPU_SW_EXCEPTION(0u);
+        }
+
+        if (p_msg_tbl == DEF_NULL) {
+           *p_err = RTOS_ERR_NULL_PTR;
+            return (0u);
+        }
+
+        if (msg_qty_max == 0u) {
+           *p_err = RTOS_ERR_INVALID_ARG;
+            return (0u);
+        }
+    #endif
+
+    p_msg_tbl[0u] = KAL_QPend(q_handle,                         /* See Note #1.                                         */
+                              opt,
+                              timeout_ms,
+                              p_err);
+    if (*p_err != RTOS_ERR_NONE) {
+        return (0u);
+    }
+
+    msg_qty = 1u;
+    while (msg_qty < msg_qty_max) {
+        p_msg_tbl[msg_qty] = KAL_QPend(q_handle,
+                                       KAL_OPT_PEND_NON_BLOCKING,
+                                       KAL_TIMEOUT_INFINITE,
+                                      &err);
+        if (err != RTOS_ERR_NONE) {
+            break;
+        }
+        msg_qty++;
+    }
+
+    return (msg_qty);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          KAL_QPostBatch()
+*
+* Description : Post several messages on queue at once.
+*
+* Argument(s) : q_handle        Handle of the queue on which to post messages.
+*
+*               p_msg_tbl       Pointer to table of messages to post.
+*
+*               msg_qty         Number of messages to post.
+*
+*               opt             Options available:
+*                                   KAL_OPT_POST_NONE:     wake only the highest priority task pending on queue.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function:
+*
+*                                   RTOS_ERR_NONE               No error.
+*                                   RTOS_ERR_NOT_AVAIL          Configuration does not allow operation.
+*                                   RTOS_ERR_NULL_PTR           Handle or 'p_msg_tbl' contains a NULL/invalid pointer.
+*                                   RTOS_ERR_INVALID_ARG        Handle or options specified is invalid.
+*                                   RTOS_ERR_NO_MORE_RSRC       Queue cannot contain any more message,
+*                                                               no more message available.
+*
+* Return(s)   : Number of messages posted.
+*
+* Note(s)     : (1) Messages are posted in order until the queue is full. The caller keeps ownership of
+*                   the messages at and after the returned index (see 'kal.h  QS  Note #1').
+*********************************************************************************************************
+*/
+
+KAL_MSG_QTY  KAL_QPostBatch (KAL_Q_HANDLE    q_handle,
+                             void          **p_msg_tbl,
+                             KAL_MSG_QTY     msg_qty,
+                             KAL_OPT         opt,
+                             RTOS_ERR       *p_err)
+{
+    KAL_MSG_QTY  ix;
+
+
+    #if (KAL_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)                 /* ---------------- VALIDATE ARGUMENTS ---------------- */
+        if (p_err == DEF_NULL) {                                /* Validate err ptr.                                    */
+            CPU_SW_EXCEPTION(0u);
+        }
+
+        if (p_msg_tbl == DEF_NULL) {
+           *p_err = RTOS_ERR_NULL_PTR;
+            return (0u);
+        }
+    #endif
+
+   *p_err = RTOS_ERR_NONE;
+    for (ix = 0u; ix < msg_qty; ix++) {                         /* See Note #1.                                         */
+        KAL_QPost(q_handle,
+                  p_msg_tbl[ix],
+                  opt,
+                  p_err);
+        if (*p_err != RTOS_ERR_NONE) {
+            break;
+        }
+    }
+
+    return (ix);
+}
+
+
 /*
 *********************************************************************************************************
 *                                          DLY API FUNCTIONS
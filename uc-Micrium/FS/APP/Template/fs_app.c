@@ -613,6 +613,7 @@ static  CPU_BOOLEAN  App_FS_AddNOR (void)
     nor_cfg.BusWidthMax      =  APP_CFG_FS_NOR_BUS_WIDTH_MAX;
     nor_cfg.PhyDevCnt        =  APP_CFG_FS_NOR_PHY_DEV_CNT;
     nor_cfg.MaxClkFreq       =  APP_CFG_FS_NOR_MAX_CLK_FREQ;
+    nor_cfg.QSPI_BSP_Ptr     =  APP_CFG_FS_NOR_QSPI_BSP_PTR;
 
     FSDev_Open("nor:0:", (void *)&nor_cfg, &err);               /* Open device "nor:0:".                                */
     switch (err) {
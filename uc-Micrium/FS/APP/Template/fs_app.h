@@ -554,6 +554,11 @@ CPU_BOOLEAN  App_FS_Init(void);
                                                                 /* Maximum clock frequency.                             */
 #ifndef  APP_CFG_FS_NOR_MAX_CLK_FREQ
 #error  "APP_CFG_FS_NOR_MAX_CLK_FREQ              not #define'd in 'app_cfg.h'          "
+#endif
+
+                                                                /* QSPI BSP pointer (optional, serial flash only).      */
+#ifndef  APP_CFG_FS_NOR_QSPI_BSP_PTR
+#define  APP_CFG_FS_NOR_QSPI_BSP_PTR                DEF_NULL
 #endif
 #endif
 
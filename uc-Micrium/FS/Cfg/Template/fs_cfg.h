@@ -442,6 +442,22 @@
                                                                 /* Configure file system trace function (see Note #2) : */
 #define  FS_TRACE                           printf
 
+
+/*
+*********************************************************************************************************
+*                                      FILE SYSTEM DEVICE I/O HOOKS
+*
+* Note(s) : (1) Optionally #define FS_DEV_IO_HOOK_RD_START(), FS_DEV_IO_HOOK_RD_END(),
+*               FS_DEV_IO_HOOK_WR_START() & FS_DEV_IO_HOOK_WR_END() to observe device sector accesses.
+*               See 'fs.h  DEVICE I/O HOOKS'.  E.g., to feed the application's event trace recorder :
+*
+*                   #define  FS_DEV_IO_HOOK_RD_START(p_dev, start, cnt)       TRACE_EVT(TRACE_EVT_FS_DEV_RD_START, (cnt), (start))
+*                   #define  FS_DEV_IO_HOOK_RD_END(p_dev, start, cnt, err)    TRACE_EVT(TRACE_EVT_FS_DEV_RD_END,   (cnt), (err))
+*                   #define  FS_DEV_IO_HOOK_WR_START(p_dev, start, cnt)       TRACE_EVT(TRACE_EVT_FS_DEV_WR_START, (cnt), (start))
+*                   #define  FS_DEV_IO_HOOK_WR_END(p_dev, start, cnt, err)    TRACE_EVT(TRACE_EVT_FS_DEV_WR_END,   (cnt), (err))
+*********************************************************************************************************
+*/
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
@@ -116,6 +116,30 @@
 *               sequential update blocks (SUB). This value is set as a percentage of the total number
 *               of update blocks.
 *
+*           (9) FS_NAND_CFG_BG_PROC_EN enables FS_NAND_BgProc(), which the application may call from a
+*               low-priority (idle) task to perform ahead of time the merge or erase that the next write
+*               would otherwise have to perform before completing. Blocks are never merged or erased
+*               earlier than that, so background processing does not add wear.
+*               Each call performs one short step & releases the device between steps.
+*
+*          (10) FS_NAND_CFG_BG_UB_FREE_MIN is the number of empty update blocks below which background
+*               processing merges the update block the next allocation would have to merge, if no
+*               partially used update block can take the allocation instead. Only full random update
+*               blocks are merged this way, since they cannot absorb any more writes.
+*               FS_NAND_CFG_BG_SEC_PER_STEP is the maximum number of sectors copied by one step of a
+*               sequential update block merge; lower values shorten each step (and thus the delay seen
+*               by other tasks) at the cost of more steps.
+*
+*               RAM usage = (<Nbr of avail blk tbl entries> / 8) octets (rounded up).
+*
+*          (11) FS_NAND_CFG_MULTI_SEC_MAX is the maximum number of consecutive sectors transferred in a
+*               single controller operation, when the controller supports it (e.g. the generic controller
+*               with a part supporting cache program/read). Sequential writes to an update block and
+*               reads from a data block without update block are then grouped per page & pipelined.
+*               Setting this to 1 disables multi-sector operations.
+*
+*               RAM usage = (<OOS size> x FS_NAND_CFG_MULTI_SEC_MAX) octets.
+*
 *********************************************************************************************************
 */
 
@@ -149,6 +173,18 @@
                                                                 /* Config max pct of UB that can be SUB(see Note #8)  : */
 #define  FS_NAND_CFG_MAX_SUB_PCT                         30
 
+                                                                /* Config bg processing                (see Note #9)  : */
+#define  FS_NAND_CFG_BG_PROC_EN                 DEF_DISABLED
+                                                                /*   DEF_DISABLED   FS_NAND_BgProc() NOT present.       */
+                                                                /*   DEF_ENABLED    FS_NAND_BgProc()     present.       */
+
+                                                                /* Config bg processing targets        (see Note #10) : */
+#define  FS_NAND_CFG_BG_UB_FREE_MIN                       1u
+#define  FS_NAND_CFG_BG_SEC_PER_STEP                      8u
+
+                                                                /* Config max secs per multi-sec op    (see Note #11) : */
+#define  FS_NAND_CFG_MULTI_SEC_MAX                       16u
+
 
 /*
 *********************************************************************************************************
@@ -98,9 +98,12 @@ typedef  CPU_INT08U  FS_NAND_CTRLR_ADDR_FMT_FLAGS;
 #define  FS_NAND_CMD_RD_SETUP_ZONE_B                0x01u
 #define  FS_NAND_CMD_RD_SETUP_ZONE_C                0x50u
 #define  FS_NAND_CMD_RD_CONFIRM                     0x30u
+#define  FS_NAND_CMD_RD_CACHE_SEQ                   0x31u
+#define  FS_NAND_CMD_RD_CACHE_END                   0x3Fu
 
 #define  FS_NAND_CMD_PAGEPGM_SETUP                  0x80u
 #define  FS_NAND_CMD_PAGEPGM_CONFIRM                0x10u
+#define  FS_NAND_CMD_PAGEPGM_CACHE                  0x15u
 
 #define  FS_NAND_CMD_BLKERASE_SETUP                 0x60u
 #define  FS_NAND_CMD_BLKERASE_CONFIRM               0xD0u
@@ -249,6 +252,22 @@ static  void                IO_Ctrl    (void              *p_ctrlr_data_v,
                                         void              *p_arg,
                                         FS_ERR            *p_err);
 
+                                                                /* Read consecutive sectors from NAND device.           */
+static  FS_SEC_QTY          SecRdMulti (void              *p_ctrlr_data_v,
+                                        void              *p_dest,
+                                        void              *p_dest_oos,
+                                        FS_SEC_NBR         sec_ix_phy,
+                                        FS_SEC_QTY         sec_cnt,
+                                        FS_ERR            *p_err);
+
+                                                                /* Write consecutive sectors to NAND device.            */
+static  FS_SEC_QTY          SecWrMulti (void              *p_ctrlr_data_v,
+                                        void              *p_src,
+                                        void              *p_src_oos,
+                                        FS_SEC_NBR         sec_ix_phy,
+                                        FS_SEC_QTY         sec_cnt,
+                                        FS_ERR            *p_err);
+
 
 /*
 *********************************************************************************************************
@@ -315,7 +334,9 @@ const  FS_NAND_CTRLR_API  FS_NAND_CtrlrGen = {
     SpareRdRaw,                                                 /* Rd pg spare data from NAND dev without ECC.          */
     SecWr,                                                      /* Wr sec on NAND dev.                                  */
     BlkErase,                                                   /* Erase blk on NAND dev.                               */
-    IO_Ctrl                                                     /* Perform NAND dev I/O ctrl.                           */
+    IO_Ctrl,                                                    /* Perform NAND dev I/O ctrl.                           */
+    SecRdMulti,                                                 /* Rd consecutive secs from NAND dev.                   */
+    SecWrMulti                                                  /* Wr consecutive secs on NAND dev.                     */
 };
 
 
@@ -676,6 +697,9 @@ static  void  *Open (FS_NAND_PART_API  *p_part_api,
     p_ctrlr_data->Ctrs.StatEraseCtr           = 0u;
     p_ctrlr_data->Ctrs.StatSpareRdRawCtr      = 0u;
     p_ctrlr_data->Ctrs.StatOOSRdRawCtr        = 0u;
+    p_ctrlr_data->Ctrs.StatRdMultiCtr         = 0u;
+    p_ctrlr_data->Ctrs.StatWrMultiCtr         = 0u;
+    p_ctrlr_data->Ctrs.StatCacheOpCtr         = 0u;
 #endif
 
 #if (FS_CFG_CTR_ERR_EN == DEF_ENABLED)                          /* ------------------ INIT ERR CTRS ------------------- */
@@ -1550,6 +1574,578 @@ static  void  SecWr (void        *p_ctrlr_data_v,
 }
 
 
+/*
+*********************************************************************************************************
+*                                             SecRdMulti()
+*
+* Description : Read consecutive physical sectors located in the same block from a NAND device & store
+*               data in buffer.
+*
+* Argument(s) : p_ctrlr_data_v  Pointer to NAND controller data.
+*               --------------  Argument validated by caller.
+*
+*               p_dest          Pointer to destination buffer (sec_cnt sectors).
+*               ------          Argument validated by caller.
+*
+*               p_dest_oos      Pointer to destination OOS buffer (sec_cnt OOS areas, see Note #1).
+*               ----------      Argument validated by caller.
+*
+*               sec_ix_phy      Index of first sector to read.
+*
+*               sec_cnt         Number of sectors to read.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               -----           Argument validated by caller.
+*
+*                                   FS_ERR_DEV_TIMEOUT          Device timeout.
+*                                   FS_ERR_ECC_CRITICAL_CORR    A critical ECC error has been successfully
+*                                                               corrected in the first sector NOT read.
+*                                   FS_ERR_ECC_UNCORR           An uncorrectable ECC error occurred in the
+*                                                               first sector NOT read.
+*                                   FS_ERR_NONE                 Sectors read successfully.
+*
+*                                   ----------RETURNED BY p_ctrlr_data->CtrlrExtPtr->RdStatusChk()-----------
+*                                   See p_ctrlr_data->CtrlrExtPtr->RdStatusChk() for additional return error codes.
+*
+* Return(s)   : Number of sectors read successfully.
+*
+* Note(s)     : (1) The OOS area of each sector is stored in 'p_dest_oos' at a stride equal to the OOS size
+*                   returned by Setup().
+*
+*               (2) Each page is loaded in the page register once; all requested sectors of that page are
+*                   then transferred using the change read column command. If the part supports the read
+*                   cache commands (31h/3Fh), the next page is loaded in the data register while the
+*                   current one is transferred from the cache register. Cache reads are NOT used when the
+*                   controller extension checks the read status, since that status would then refer to
+*                   the page being loaded rather than to the page being transferred.
+*
+*               (3) Small page devices do not support change read column; sectors are read one at a time.
+*
+*               (4) The read stops at the first sector that returns an error other than a corrected ECC
+*                   error. The caller is responsible for handling that sector (e.g. by reading it again
+*                   with SecRd() & refreshing its block).
+*********************************************************************************************************
+*/
+
+static  FS_SEC_QTY  SecRdMulti (void        *p_ctrlr_data_v,
+                                void        *p_dest,
+                                void        *p_dest_oos,
+                                FS_SEC_NBR   sec_ix_phy,
+                                FS_SEC_QTY   sec_cnt,
+                                FS_ERR      *p_err)
+{
+    FS_NAND_CTRLR_GEN_DATA        *p_ctrlr_data;
+    FS_NAND_CTRLR_GEN_BSP_API     *p_bsp_api;
+    FS_NAND_PART_DATA             *p_part_data;
+    CPU_INT08U                    *p_dest_08;
+    CPU_INT08U                    *p_dest_oos_08;
+    FS_ERR                         err_pg;
+    FS_ERR                         err_sec;
+    FS_NAND_CTRLR_ADDR_FMT_FLAGS   addr_fmt_flags;
+    FS_NAND_PG_SIZE                sec_size;
+    FS_SEC_QTY                     rd_cnt;
+    FS_SEC_QTY                     pg_sec_cnt;
+    CPU_INT32U                     nbr_sec_per_pg;
+    CPU_INT32U                     sec_offset_pg;
+    CPU_INT32U                     pg_size;
+    CPU_INT32U                     row_addr;
+    CPU_INT08U                     addr[FS_NAND_CTRLR_GEN_ADDR_MAX_LEN];
+    CPU_INT08U                     cmd1;
+    CPU_INT08U                     cmd2;
+    CPU_BOOLEAN                    cache_en;
+    CPU_BOOLEAN                    cache_pend;
+
+
+    p_ctrlr_data      = (FS_NAND_CTRLR_GEN_DATA *)p_ctrlr_data_v;
+    p_part_data       =  p_ctrlr_data->PartDataPtr;
+    p_bsp_api         =  p_ctrlr_data->BSP_Ptr;
+    sec_size          =  p_ctrlr_data->SecSize;
+    pg_size           =  p_part_data->PgSize;
+    p_dest_08         = (CPU_INT08U *)p_dest;
+    p_dest_oos_08     = (CPU_INT08U *)p_dest_oos;
+    rd_cnt            =  0u;
+
+    FS_CTR_STAT_INC(p_ctrlr_data->Ctrs.StatRdMultiCtr);
+
+                                                                /* ------------------ SMALL PG DEV -------------------- */
+    if (pg_size == 512u) {                                      /* See Note #3.                                         */
+        while (rd_cnt < sec_cnt) {
+            SecRd(p_ctrlr_data_v,
+                  p_dest_08,
+                  p_ctrlr_data->SpareBufPtr,
+                  sec_ix_phy + rd_cnt,
+                  p_err);
+            if ((*p_err != FS_ERR_NONE) &&
+                (*p_err != FS_ERR_ECC_CORR)) {
+                return (rd_cnt);
+            }
+
+            Mem_Copy(p_dest_oos_08, p_ctrlr_data->SpareBufPtr, p_ctrlr_data->OOS_SizePerSec);
+
+            rd_cnt++;
+            p_dest_08     += sec_size;
+            p_dest_oos_08 += p_ctrlr_data->OOS_SizePerSec;
+        }
+
+       *p_err = FS_ERR_NONE;
+        return (rd_cnt);
+    }
+
+                                                                /* -------------------- ADDR CALC --------------------- */
+    nbr_sec_per_pg = pg_size    / sec_size;
+    sec_offset_pg  = sec_ix_phy % nbr_sec_per_pg;
+    row_addr       = sec_ix_phy / nbr_sec_per_pg;
+
+    cache_en       = DEF_NO;                                    /* See Note #2.                                         */
+    if ((sec_offset_pg + sec_cnt > nbr_sec_per_pg) &&
+        (DEF_BIT_IS_SET(p_part_data->OptCmdFlags, FS_NAND_PART_OPT_CMD_CACHE_RD) == DEF_YES) &&
+        (p_ctrlr_data->CtrlrExtPtr->RdStatusChk == DEF_NULL)) {
+        cache_en = DEF_YES;
+    }
+    cache_pend     = DEF_NO;
+
+
+    p_bsp_api->ChipSelEn();
+
+    while (rd_cnt < sec_cnt) {
+        pg_sec_cnt = DEF_MIN(nbr_sec_per_pg - sec_offset_pg, sec_cnt - rd_cnt);
+        err_pg     = FS_ERR_NONE;
+
+                                                                /* ------------------- LOAD NEXT PG ------------------- */
+        if ((rd_cnt   == 0u) ||
+            (cache_en == DEF_NO)) {
+            addr_fmt_flags = FS_NAND_CTRLR_ADDR_FMT_COL |
+                             FS_NAND_CTRLR_ADDR_FMT_ROW;
+
+            AddrFmt(p_ctrlr_data,
+                    row_addr,
+                    0u,
+                    addr_fmt_flags,
+                   &addr[0]);
+
+            cmd1 = FS_NAND_CMD_RD_SETUP;
+            cmd2 = FS_NAND_CMD_RD_CONFIRM;
+
+            FS_ERR_CHK_RTN(p_bsp_api->CmdWr (&cmd1,    1u, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->AddrWr(&addr[0], p_ctrlr_data->AddrSize, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->CmdWr (&cmd2,    1u, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+
+            p_bsp_api->WaitWhileBusy(p_ctrlr_data_v,            /* Wait until rdy.                                      */
+                                     FS_NAND_CtrlrGen_PollFnct,
+                                     FS_NAND_MAX_RD_us,
+                                     p_err);
+            if (*p_err != FS_ERR_NONE) {
+                p_bsp_api->ChipSelDis();
+                FS_TRACE_DBG(("(fs_nand_ctrlr_gen) SecRdMulti(): Timeout occurred when sending command.\r\n"));
+                return (rd_cnt);
+            }
+        }
+
+        if (cache_en == DEF_YES) {                              /* Move pg to cache reg & load nxt pg in data reg.      */
+            cmd1 = (rd_cnt + pg_sec_cnt < sec_cnt) ? FS_NAND_CMD_RD_CACHE_SEQ : FS_NAND_CMD_RD_CACHE_END;
+
+            FS_ERR_CHK_RTN(p_bsp_api->CmdWr(&cmd1, 1u, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+
+            p_bsp_api->WaitWhileBusy(p_ctrlr_data_v,            /* Wait until cache reg rdy.                            */
+                                     FS_NAND_CtrlrGen_PollFnct,
+                                     FS_NAND_MAX_RD_us,
+                                     p_err);
+            if (*p_err != FS_ERR_NONE) {
+                p_bsp_api->ChipSelDis();
+                FS_TRACE_DBG(("(fs_nand_ctrlr_gen) SecRdMulti(): Timeout occurred when sending command.\r\n"));
+                return (rd_cnt);
+            }
+
+            cache_pend = (cmd1 == FS_NAND_CMD_RD_CACHE_SEQ) ? DEF_YES : DEF_NO;
+            FS_CTR_STAT_INC(p_ctrlr_data->Ctrs.StatCacheOpCtr);
+        }
+
+                                                                /* Chk rd cmd status if needed.                         */
+        if (p_ctrlr_data->CtrlrExtPtr->RdStatusChk != DEF_NULL) {
+            p_ctrlr_data->CtrlrExtPtr->RdStatusChk(p_ctrlr_data->CtrlrExtData, &err_pg);
+            if ((err_pg != FS_ERR_NONE) &&
+                (err_pg != FS_ERR_ECC_CORR)) {
+                p_bsp_api->ChipSelDis();
+#if (FS_CFG_CTR_ERR_EN == DEF_ENABLED)
+                if (err_pg == FS_ERR_ECC_UNCORR) {
+                    FS_CTR_ERR_INC(p_ctrlr_data->Ctrs.ErrUncorrECC_Ctr);
+                }
+#endif
+               *p_err = err_pg;
+                return (rd_cnt);                                /* See Note #4.                                         */
+            }
+        }
+
+        cmd1 = FS_NAND_CMD_RD_SETUP;                            /* Switch back to rd mode (poll_fcnt might have rd sta).*/
+        FS_ERR_CHK_RTN(p_bsp_api->CmdWr(&cmd1, 1u, p_err),
+                       p_bsp_api->ChipSelDis(), rd_cnt);
+
+                                                                /* ----------------- RD SECS FROM PG ------------------ */
+        while (pg_sec_cnt > 0u) {
+            cmd1           = FS_NAND_CMD_CHNGRDCOL_SETUP;
+            cmd2           = FS_NAND_CMD_CHNGRDCOL_CONFIRM;
+            addr_fmt_flags = FS_NAND_CTRLR_ADDR_FMT_COL;
+                                                                /* Rd sec data.                                         */
+            AddrFmt(p_ctrlr_data,
+                    row_addr,
+                    sec_offset_pg * sec_size,
+                    addr_fmt_flags,
+                   &addr[0]);
+
+            FS_ERR_CHK_RTN(p_bsp_api->CmdWr (&cmd1,    1u, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->AddrWr(&addr[0], p_ctrlr_data->ColAddrSize, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->CmdWr (&cmd2,    1u, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->DataRd(p_dest_08, sec_size, p_part_data->BusWidth, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+
+                                                                /* Rd OOS data.                                         */
+            AddrFmt(p_ctrlr_data,
+                    row_addr,
+                    p_ctrlr_data->OOS_InfoTbl[sec_offset_pg].PgOffset,
+                    addr_fmt_flags,
+                   &addr[0]);
+
+            FS_ERR_CHK_RTN(p_bsp_api->CmdWr (&cmd1,    1u, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->AddrWr(&addr[0], p_ctrlr_data->ColAddrSize, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->CmdWr (&cmd2,    1u, p_err),
+                           p_bsp_api->ChipSelDis(), rd_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->DataRd(p_ctrlr_data->SpareBufPtr, p_ctrlr_data->OOS_InfoTbl[sec_offset_pg].Len,
+                                             p_part_data->BusWidth, p_err), p_bsp_api->ChipSelDis(), rd_cnt);
+
+            SpareUnpack(p_ctrlr_data, p_ctrlr_data->SpareBufPtr, sec_offset_pg);
+
+            FS_CTR_STAT_INC(p_ctrlr_data->Ctrs.StatRdCtr);
+
+                                                                /* Chk ECC.                                             */
+            err_sec = err_pg;
+            if (p_ctrlr_data->CtrlrExtPtr->ECC_Verify != DEF_NULL) {
+                p_ctrlr_data->CtrlrExtPtr->ECC_Verify(p_ctrlr_data->CtrlrExtData,
+                                                      p_dest_08,
+                                                      p_ctrlr_data->SpareBufPtr,
+                                                      p_ctrlr_data->OOS_SizePerSec,
+                                                     &err_sec);
+            }
+
+            switch (err_sec) {
+                case FS_ERR_ECC_CORR:
+                     FS_CTR_ERR_INC(p_ctrlr_data->Ctrs.ErrCorrECC_Ctr);
+                     break;
+
+
+                case FS_ERR_NONE:
+                     break;
+
+
+                default:                                        /* See Note #4.                                         */
+#if (FS_CFG_CTR_ERR_EN == DEF_ENABLED)
+                     if (err_sec == FS_ERR_ECC_UNCORR) {
+                         FS_CTR_ERR_INC(p_ctrlr_data->Ctrs.ErrUncorrECC_Ctr);
+                     } else if (err_sec == FS_ERR_ECC_CRITICAL_CORR) {
+                         FS_CTR_ERR_INC(p_ctrlr_data->Ctrs.ErrCriticalCorrECC_Ctr);
+                     } else {
+                         ;
+                     }
+#endif
+                     if (cache_pend == DEF_YES) {               /* End cache rd seq before releasing dev.               */
+                         cmd1 = FS_NAND_CMD_RD_CACHE_END;
+                         FS_ERR_CHK_RTN(p_bsp_api->CmdWr(&cmd1, 1u, p_err),
+                                        p_bsp_api->ChipSelDis(), rd_cnt);
+                         p_bsp_api->WaitWhileBusy(p_ctrlr_data_v,
+                                                  FS_NAND_CtrlrGen_PollFnct,
+                                                  FS_NAND_MAX_RD_us,
+                                                  p_err);
+                     }
+                     p_bsp_api->ChipSelDis();
+                    *p_err = err_sec;
+                     return (rd_cnt);
+            }
+
+            Mem_Copy(p_dest_oos_08, p_ctrlr_data->SpareBufPtr, p_ctrlr_data->OOS_SizePerSec);
+
+            rd_cnt++;
+            pg_sec_cnt--;
+            sec_offset_pg++;
+            p_dest_08     += sec_size;
+            p_dest_oos_08 += p_ctrlr_data->OOS_SizePerSec;
+        }
+
+        sec_offset_pg = 0u;
+        row_addr++;
+    }
+
+    p_bsp_api->ChipSelDis();
+   *p_err = FS_ERR_NONE;
+
+    return (rd_cnt);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             SecWrMulti()
+*
+* Description : Write consecutive physical sectors located in the same block to a NAND device.
+*
+* Argument(s) : p_ctrlr_data_v  Pointer to NAND controller data.
+*               --------------  Argument validated by caller.
+*
+*               p_src           Pointer to source data buffer (sec_cnt sectors).
+*               -----           Argument validated by caller.
+*
+*               p_src_oos       Pointer to source OOS buffer (sec_cnt OOS areas, see SecRdMulti() Note #1).
+*               ---------       Argument validated by caller.
+*
+*               sec_ix_phy      Index of first sector to write.
+*
+*               sec_cnt         Number of sectors to write.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               -----           Argument validated by caller.
+*
+*                                   FS_ERR_DEV_IO       Device I/O error.
+*                                   FS_ERR_DEV_TIMEOUT  Device timeout.
+*                                   FS_ERR_NONE         Sectors written successfully.
+*
+*                                   -RETURNED BY p_ctrlr_data->CtrlrExtPtr->ECC_Calc()-
+*                                   See p_ctrlr_data->CtrlrExtPtr->ECC_Calc() for additional return error codes.
+*
+* Return(s)   : Number of sectors whose programming has been confirmed by the device.
+*
+* Note(s)     : (1) All requested sectors of a page (data & OOS) are loaded in the page register using the
+*                   change write column command & programmed with a single program operation.
+*
+*               (2) If the part supports the cache program command (15h), each page but the last is
+*                   committed with that command, which returns as soon as the cache register is free; the
+*                   next page is then loaded while the previous one is programmed. The last page is
+*                   committed with the regular page program confirm command (10h), which returns once all
+*                   pages are programmed.
+*
+*               (3) When cache programming is used, a status register read following a cache program
+*                   command may report the failure of any of the two pages still in flight. Consequently,
+*                   a page is only considered programmed once the status of the 2 following pages has been
+*                   checked, or once the final program operation has completed successfully.
+*
+*               (4) Small page devices do not support change write column; sectors are written one at a
+*                   time.
+*********************************************************************************************************
+*/
+
+static  FS_SEC_QTY  SecWrMulti (void        *p_ctrlr_data_v,
+                                void        *p_src,
+                                void        *p_src_oos,
+                                FS_SEC_NBR   sec_ix_phy,
+                                FS_SEC_QTY   sec_cnt,
+                                FS_ERR      *p_err)
+{
+    FS_NAND_CTRLR_GEN_DATA        *p_ctrlr_data;
+    FS_NAND_CTRLR_GEN_BSP_API     *p_bsp_api;
+    FS_NAND_PART_DATA             *p_part_data;
+    CPU_INT08U                    *p_src_08;
+    CPU_INT08U                    *p_src_oos_08;
+    FS_NAND_CTRLR_ADDR_FMT_FLAGS   addr_fmt_flags;
+    FS_NAND_PG_SIZE                sec_size;
+    FS_SEC_QTY                     wr_cnt;
+    FS_SEC_QTY                     sec_rem;
+    FS_SEC_QTY                     pg_sec_cnt;
+    FS_SEC_QTY                     pg_sec_ix;
+    FS_SEC_QTY                     pend_cnt;
+    FS_SEC_QTY                     pend_cnt_prev;
+    CPU_INT32U                     nbr_sec_per_pg;
+    CPU_INT32U                     sec_offset_pg;
+    CPU_INT32U                     pg_size;
+    CPU_INT32U                     row_addr;
+    CPU_INT08U                     addr[FS_NAND_CTRLR_GEN_ADDR_MAX_LEN];
+    CPU_INT08U                     cmd;
+    CPU_INT08U                     sr;
+    CPU_BOOLEAN                    cache_en;
+
+
+    p_ctrlr_data      = (FS_NAND_CTRLR_GEN_DATA *)p_ctrlr_data_v;
+    p_part_data       =  p_ctrlr_data->PartDataPtr;
+    p_bsp_api         =  p_ctrlr_data->BSP_Ptr;
+    sec_size          =  p_ctrlr_data->SecSize;
+    pg_size           =  p_part_data->PgSize;
+    p_src_08          = (CPU_INT08U *)p_src;
+    p_src_oos_08      = (CPU_INT08U *)p_src_oos;
+    wr_cnt            =  0u;
+
+    FS_CTR_STAT_INC(p_ctrlr_data->Ctrs.StatWrMultiCtr);
+
+                                                                /* ------------------ SMALL PG DEV -------------------- */
+    if (pg_size == 512u) {                                      /* See Note #4.                                         */
+        while (wr_cnt < sec_cnt) {
+            Mem_Copy(p_ctrlr_data->SpareBufPtr, p_src_oos_08, p_ctrlr_data->OOS_SizePerSec);
+
+            SecWr(p_ctrlr_data_v,
+                  p_src_08,
+                  p_ctrlr_data->SpareBufPtr,
+                  sec_ix_phy + wr_cnt,
+                  p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return (wr_cnt);
+            }
+
+            wr_cnt++;
+            p_src_08     += sec_size;
+            p_src_oos_08 += p_ctrlr_data->OOS_SizePerSec;
+        }
+
+        return (wr_cnt);
+    }
+
+                                                                /* --------------- ADDRESS CALCULATION ---------------- */
+    nbr_sec_per_pg = pg_size    / sec_size;
+    sec_offset_pg  = sec_ix_phy % nbr_sec_per_pg;
+    row_addr       = sec_ix_phy / nbr_sec_per_pg;
+
+    cache_en       = DEF_BIT_IS_SET(p_part_data->OptCmdFlags, FS_NAND_PART_OPT_CMD_CACHE_PGM);
+    sec_rem        = sec_cnt;
+    pend_cnt       = 0u;
+    pend_cnt_prev  = 0u;
+
+
+    p_bsp_api->ChipSelEn();
+
+    while (sec_rem > 0u) {
+        pg_sec_cnt = DEF_MIN(nbr_sec_per_pg - sec_offset_pg, sec_rem);
+
+                                                                /* ------------- LOAD SECS IN PG REGISTER ------------- */
+        addr_fmt_flags = FS_NAND_CTRLR_ADDR_FMT_COL |
+                         FS_NAND_CTRLR_ADDR_FMT_ROW;
+
+        AddrFmt(p_ctrlr_data,
+                row_addr,
+                sec_offset_pg * sec_size,
+                addr_fmt_flags,
+               &addr[0]);
+
+        cmd = FS_NAND_CMD_PAGEPGM_SETUP;
+        FS_ERR_CHK_RTN(p_bsp_api->CmdWr (&cmd,     1u, p_err),
+                       p_bsp_api->ChipSelDis(), wr_cnt);
+        FS_ERR_CHK_RTN(p_bsp_api->AddrWr(&addr[0], p_ctrlr_data->AddrSize, p_err),
+                       p_bsp_api->ChipSelDis(), wr_cnt);
+
+        addr_fmt_flags = FS_NAND_CTRLR_ADDR_FMT_COL;
+        cmd            = FS_NAND_CMD_CHNGWRCOL;
+        for (pg_sec_ix = 0u; pg_sec_ix < pg_sec_cnt; pg_sec_ix++) {
+            if (pg_sec_ix != 0u) {                              /* Move to sec data col (see Note #1).                  */
+                AddrFmt(p_ctrlr_data,
+                        row_addr,
+                        sec_offset_pg * sec_size,
+                        addr_fmt_flags,
+                       &addr[0]);
+
+                FS_ERR_CHK_RTN(p_bsp_api->CmdWr (&cmd,     1u, p_err),
+                               p_bsp_api->ChipSelDis(), wr_cnt);
+                FS_ERR_CHK_RTN(p_bsp_api->AddrWr(&addr[0], p_ctrlr_data->ColAddrSize, p_err),
+                               p_bsp_api->ChipSelDis(), wr_cnt);
+            }
+                                                                /* Wr sec data.                                         */
+            FS_ERR_CHK_RTN(p_bsp_api->DataWr(p_src_08, sec_size, p_part_data->BusWidth, p_err),
+                           p_bsp_api->ChipSelDis(), wr_cnt);
+
+                                                                /* Calc ECC & pack OOS.                                 */
+            Mem_Copy(p_ctrlr_data->SpareBufPtr, p_src_oos_08, p_ctrlr_data->OOS_SizePerSec);
+
+            if (p_ctrlr_data->CtrlrExtPtr->ECC_Calc != DEF_NULL) {
+                p_ctrlr_data->CtrlrExtPtr->ECC_Calc(p_ctrlr_data->CtrlrExtData,
+                                                    p_src_08,
+                                                    p_ctrlr_data->SpareBufPtr,
+                                                    p_ctrlr_data->OOS_SizePerSec,
+                                                    p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    p_bsp_api->ChipSelDis();
+                    return (wr_cnt);
+                }
+            }
+
+            SparePack(p_ctrlr_data,
+                      p_ctrlr_data->SpareBufPtr,
+                      sec_offset_pg);
+
+                                                                /* Wr OOS data.                                         */
+            AddrFmt(p_ctrlr_data,
+                    row_addr,
+                    p_ctrlr_data->OOS_InfoTbl[sec_offset_pg].PgOffset,
+                    addr_fmt_flags,
+                   &addr[0]);
+
+            FS_ERR_CHK_RTN(p_bsp_api->CmdWr (&cmd,     1u, p_err),
+                           p_bsp_api->ChipSelDis(), wr_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->AddrWr(&addr[0], p_ctrlr_data->ColAddrSize, p_err),
+                           p_bsp_api->ChipSelDis(), wr_cnt);
+            FS_ERR_CHK_RTN(p_bsp_api->DataWr(p_ctrlr_data->SpareBufPtr, p_ctrlr_data->OOS_InfoTbl[sec_offset_pg].Len,
+                                             p_part_data->BusWidth, p_err), p_bsp_api->ChipSelDis(), wr_cnt);
+
+            FS_CTR_STAT_INC(p_ctrlr_data->Ctrs.StatWrCtr);
+
+            sec_offset_pg++;
+            p_src_08     += sec_size;
+            p_src_oos_08 += p_ctrlr_data->OOS_SizePerSec;
+        }
+
+        sec_rem -= pg_sec_cnt;
+
+                                                                /* -------------------- PGM PG ------------------------ */
+        cmd = FS_NAND_CMD_PAGEPGM_CONFIRM;                      /* See Note #2.                                         */
+        if ((cache_en == DEF_YES) &&
+            (sec_rem  >  0u)) {
+            cmd = FS_NAND_CMD_PAGEPGM_CACHE;
+        }
+
+        FS_ERR_CHK_RTN(p_bsp_api->CmdWr(&cmd, 1u, p_err),
+                       p_bsp_api->ChipSelDis(), wr_cnt);
+
+        p_bsp_api->WaitWhileBusy(p_ctrlr_data_v,                /* Wait until ready.                                    */
+                                 FS_NAND_CtrlrGen_PollFnct,
+                                 FS_NAND_MAX_PGM_us,
+                                 p_err);
+        if (*p_err != FS_ERR_NONE) {
+            p_bsp_api->ChipSelDis();
+            return (wr_cnt);
+        }
+
+                                                                /* ------------------ CHK OP STATUS ------------------- */
+        sr = StatusRd(p_ctrlr_data);
+        if ((DEF_BIT_IS_SET(sr, FS_NAND_SR_FAIL)         == DEF_YES) ||
+            (DEF_BIT_IS_SET(sr, FS_NAND_SR_CACHEPGMFAIL) == DEF_YES)) {
+            p_bsp_api->ChipSelDis();
+           *p_err = FS_ERR_DEV_IO;
+            FS_CTR_ERR_INC(p_ctrlr_data->Ctrs.ErrWrCtr);
+            return (wr_cnt);                                    /* See Note #3.                                         */
+        }
+
+        if (cmd == FS_NAND_CMD_PAGEPGM_CACHE) {
+            wr_cnt        += pend_cnt_prev;
+            pend_cnt_prev  = pend_cnt;
+            pend_cnt       = pg_sec_cnt;
+            FS_CTR_STAT_INC(p_ctrlr_data->Ctrs.StatCacheOpCtr);
+        } else {
+            wr_cnt        += pend_cnt_prev + pend_cnt + pg_sec_cnt;
+            pend_cnt_prev  = 0u;
+            pend_cnt       = 0u;
+        }
+
+        sec_offset_pg = 0u;
+        row_addr++;
+    }
+
+    p_bsp_api->ChipSelDis();
+   *p_err = FS_ERR_NONE;
+
+    return (wr_cnt);
+}
+
+
 /*
 *********************************************************************************************************
 *                                              BlkErase()
@@ -151,6 +151,9 @@ typedef  struct  fs_nand_ctrlr_gen_ctrs {
     FS_CTR                             StatEraseCtr;            /* Nbr of blk erase.                                    */
     FS_CTR                             StatSpareRdRawCtr;       /* Nbr of raw spare rd.                                 */
     FS_CTR                             StatOOSRdRawCtr;         /* Nbr of raw OOS rd.                                   */
+    FS_CTR                             StatRdMultiCtr;          /* Nbr of multi-sec rd ops.                             */
+    FS_CTR                             StatWrMultiCtr;          /* Nbr of multi-sec wr ops.                             */
+    FS_CTR                             StatCacheOpCtr;          /* Nbr of pgs rd or pgm'd with cache cmds.              */
 #endif
 
 #if (FS_CFG_CTR_ERR_EN == DEF_ENABLED)                          /* --------------------- ERR CTRS --------------------- */
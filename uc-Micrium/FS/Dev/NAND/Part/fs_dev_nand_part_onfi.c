@@ -71,6 +71,10 @@
 #define  FS_NAND_PART_ONFI_FEATURE_RNDM_PG_PGM          DEF_BIT_02
 #define  FS_NAND_PART_ONFI_FEATURE_BUS_16               DEF_BIT_00
 
+                                                                /* Supported ONFI optional cmds.                        */
+#define  FS_NAND_PART_ONFI_OPT_CMD_RD_CACHE             DEF_BIT_01
+#define  FS_NAND_PART_ONFI_OPT_CMD_PG_CACHE_PGM         DEF_BIT_00
+
                                                                 /* Last data byte of parameter page covered by CRC.     */
 #define  FS_NAND_PART_ONFI_PARAM_PAGE_LAST_DATA_BYTE    253u
 
@@ -551,6 +555,15 @@ static  void  FS_NAND_PartONFI_ParamPageParse (FS_NAND_PART_DATA  *p_part_data,
         FS_NAND_PartONFI_ParamPageCnt = 3u;
     }
 
+                                                                /* Optional cmds used by ctrlr multi-sec ops.           */
+    p_part_data->OptCmdFlags = 0u;
+    if (DEF_BIT_IS_SET(FS_NAND_PartONFI_ParamPg[8], FS_NAND_PART_ONFI_OPT_CMD_PG_CACHE_PGM) == DEF_YES) {
+        DEF_BIT_SET(p_part_data->OptCmdFlags, FS_NAND_PART_OPT_CMD_CACHE_PGM);
+    }
+    if (DEF_BIT_IS_SET(FS_NAND_PartONFI_ParamPg[8], FS_NAND_PART_ONFI_OPT_CMD_RD_CACHE) == DEF_YES) {
+        DEF_BIT_SET(p_part_data->OptCmdFlags, FS_NAND_PART_OPT_CMD_CACHE_RD);
+    }
+
 
                                                                 /* ----------- IDENTIFY MEMORY ORGANIZATION ----------- */
                                                                 /* Page size.                                           */
@@ -870,6 +883,7 @@ static  FS_NAND_PART_DATA  *FS_NAND_PartONFI_DataGet (void)
     p_nand_part_data->MaxBadBlkCnt     = 0;
     p_nand_part_data->MaxBlkErase      = 0;
     p_nand_part_data->FreeSpareMap     = 0;
+    p_nand_part_data->OptCmdFlags      = 0u;
 
 
     return (p_nand_part_data);
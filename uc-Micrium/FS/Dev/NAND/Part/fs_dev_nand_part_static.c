@@ -241,6 +241,7 @@ static  FS_NAND_PART_DATA  *FS_NAND_PartStatic_Open (const  FS_NAND_CTRLR_API  *
     p_part_data->MaxBadBlkCnt     = p_part_cfg->MaxBadBlkCnt;
     p_part_data->MaxBlkErase      = p_part_cfg->MaxBlkErase;
     p_part_data->FreeSpareMap     = p_part_cfg->FreeSpareMap;
+    p_part_data->OptCmdFlags      = p_part_cfg->OptCmdFlags;
 
     return (p_part_data);
 }
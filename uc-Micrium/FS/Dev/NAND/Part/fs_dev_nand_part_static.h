@@ -92,7 +92,8 @@
     FS_NAND_PART_STATIC_CFG_FIELD(FS_NAND_DEFECT_MARK_TYPE,  DefectMarkType  , DEFECT_SPARE_L_1_PG_1_OR_N_ALL_0/* Defect mark pos relative to spare area.              */) \
     FS_NAND_PART_STATIC_CFG_FIELD(FS_NAND_BLK_QTY         ,  MaxBadBlkCnt    , 65535u                          /* Max nbr of bad blk in dev.                           */) \
     FS_NAND_PART_STATIC_CFG_FIELD(CPU_INT32U              ,  MaxBlkErase     ,     1u                          /* Maximum number of erase operations per block.        */) \
-    FS_NAND_PART_STATIC_CFG_FIELD(FS_NAND_FREE_SPARE_DATA , *FreeSpareMap    , DEF_NULL                        /* Pointer to the map of available bytes in spare area. */)
+    FS_NAND_PART_STATIC_CFG_FIELD(FS_NAND_FREE_SPARE_DATA , *FreeSpareMap    , DEF_NULL                        /* Pointer to the map of available bytes in spare area. */) \
+    FS_NAND_PART_STATIC_CFG_FIELD(CPU_INT08U              ,  OptCmdFlags     ,     0u                          /* Optional cmds supported (FS_NAND_PART_OPT_CMD_xxx).  */)
 
 
 #define  FS_NAND_PART_STATIC_CFG_FIELD(type, name, dftl_val)  type name;
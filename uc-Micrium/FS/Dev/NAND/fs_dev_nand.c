@@ -265,6 +265,9 @@ struct  fs_nand_data {
     FS_NAND_BLK_QTY           AvailBlkTblEntryCntMax;           /* Nbr of entries in avail blk tbl.                     */
     CPU_INT08U               *AvailBlkMetaMap;                  /* Bitmap indicating blks that contain metadata.        */
     FS_NAND_META_ID          *AvailBlkMetaID_Tbl;               /* Available metadata block ID table.                   */
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+    CPU_INT08U               *AvailBlkErasedMap;                /* Bitmap indicating avail blks erased in bg.           */
+#endif
 
                                                                 /* ---------------- UNPACKED METADATA ----------------- */
     FS_NAND_BLK_QTY          *LogicalToPhyBlkMap;               /* Logical to phy blk ix map.                           */
@@ -287,6 +290,12 @@ struct  fs_nand_data {
                                                                 /* See FS_NAND_UB_Alloc() note #2.                      */
     FS_NAND_SEC_PER_BLK_QTY   ThSecRemCnt_MergeSUB;             /* Th to merge SUB instead of RUB.                      */
 
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+                                                                /* ---------------- BG PROCESSING INFO ---------------- */
+    FS_NAND_UB_QTY            BgSUB_Ix;                         /* Ix of SUB being merged in bg.                        */
+    FS_NAND_BLK_QTY           BgSUB_BlkIxLogical;               /* Logical blk assoc'd with SUB being merged in bg.     */
+    FS_NAND_SEC_PER_BLK_QTY   BgSUB_NextSecIx;                  /* Ix of next sec to merge in bg.                       */
+#endif
 
                                                                 /* -------------------- CTRLR INFO -------------------- */
     FS_NAND_CTRLR_API        *CtrlrPtr;                         /* Ptr to ctrlr api.                                    */
@@ -298,6 +307,9 @@ struct  fs_nand_data {
                                                                 /* ---------------------- BUFFERS --------------------- */
     void                     *BufPtr;                           /* Buffer for sec data.                                 */
     void                     *OOS_BufPtr;                       /* Buffer for OOS data.                                 */
+    void                     *OOS_MultiBufPtr;                  /* Buffer for OOS data of multi-sec ctrlr ops.          */
+    void                     *MultiBufPtr;                      /* Buffer gathering sec data of multi-sec ctrlr ops.    */
+    FS_NAND_PG_SIZE           OOS_Size;                         /* Size in octets of OOS data per sec.                  */
 
 #if ((FS_CFG_CTR_STAT_EN == DEF_ENABLED) || \
      (FS_CFG_CTR_ERR_EN  == DEF_ENABLED))
@@ -546,6 +558,22 @@ FS_NAND_INTERN  void                     FS_NAND_IO_Ctrl               (FS_DEV
                                                                         void                     *p_data,
                                                                         FS_ERR                   *p_err);
 
+                                                                /* Read from device into buf list.                      */
+FS_NAND_INTERN  void                     FS_NAND_RdV                   (FS_DEV                   *p_dev,
+                                                                        FS_DEV_IO_VEC            *p_vec_tbl,
+                                                                        FS_SEC_QTY                vec_cnt,
+                                                                        FS_SEC_NBR                sec_start,
+                                                                        FS_ERR                   *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+                                                                /* Write to device from buf list.                       */
+FS_NAND_INTERN  void                     FS_NAND_WrV                   (FS_DEV                   *p_dev,
+                                                                        FS_DEV_IO_VEC            *p_vec_tbl,
+                                                                        FS_SEC_QTY                vec_cnt,
+                                                                        FS_SEC_NBR                sec_start,
+                                                                        FS_ERR                   *p_err);
+#endif
+
 
                                                                 /* ----------------- LOCAL FUNCTIONS ------------------ */
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
@@ -574,6 +602,22 @@ FS_NAND_INTERN  void                     FS_NAND_DumpHandler           (FS_NAND_
                                                                         FS_ERR                   *p_err);
 #endif
 
+#if ((FS_CFG_RD_ONLY_EN     == DEF_DISABLED) && \
+     (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED))
+                                                                /* Perform one step of bg processing.                   */
+FS_NAND_INTERN  void                     FS_NAND_BgProcHandler         (FS_NAND_DATA             *p_nand_data,
+                                                                        CPU_BOOLEAN              *p_more,
+                                                                        FS_ERR                   *p_err);
+
+                                                                /* Perform one bg UB merge step.                        */
+FS_NAND_INTERN  CPU_BOOLEAN              FS_NAND_BgMergeStep           (FS_NAND_DATA             *p_nand_data,
+                                                                        FS_ERR                   *p_err);
+
+                                                                /* Perform one bg avail blk erase step.                 */
+FS_NAND_INTERN  CPU_BOOLEAN              FS_NAND_BgEraseStep           (FS_NAND_DATA             *p_nand_data,
+                                                                        FS_ERR                   *p_err);
+#endif
+
                                                                 /* Rd sec in logical blk.                               */
 FS_NAND_INTERN  void                     FS_NAND_SecRdHandler          (FS_NAND_DATA             *p_nand_data,
                                                                         void                     *p_dest,
@@ -590,6 +634,21 @@ FS_NAND_INTERN  void                     FS_NAND_SecRdPhyNoRefresh     (FS_NAND_
                                                                         FS_NAND_SEC_PER_BLK_QTY   sec_offset_phy,
                                                                         FS_ERR                   *p_err);
 
+                                                                /* Get run of buf list entries to gather.               */
+FS_NAND_INTERN  FS_SEC_QTY               FS_NAND_VecRunGet             (FS_NAND_DATA             *p_nand_data,
+                                                                        FS_DEV_IO_VEC            *p_vec_tbl,
+                                                                        FS_SEC_QTY                vec_cnt,
+                                                                        FS_SEC_QTY                vec_ix,
+                                                                        FS_SEC_QTY               *p_sec_cnt);
+
+                                                                /* Rd consecutive secs in logical blk.                  */
+FS_NAND_INTERN  FS_SEC_QTY               FS_NAND_SecRdMultiHandler     (FS_NAND_DATA             *p_nand_data,
+                                                                        void                     *p_dest,
+                                                                        FS_NAND_BLK_QTY           blk_ix_logical,
+                                                                        FS_NAND_SEC_PER_BLK_QTY   sec_offset_phy,
+                                                                        FS_SEC_QTY                sec_cnt,
+                                                                        FS_ERR                   *p_err);
+
                                                                 /* Rd 1 or more sec.                                    */
 FS_NAND_INTERN  FS_SEC_QTY               FS_NAND_SecRd                 (FS_NAND_DATA             *p_nand_data,
                                                                         void                     *p_dest,
@@ -606,6 +665,20 @@ FS_NAND_INTERN  void                     FS_NAND_SecWrHandler          (FS_NAND_
                                                                         FS_NAND_SEC_PER_BLK_QTY   sec_offset_phy,
                                                                         FS_ERR                   *p_err);
 
+                                                                /* Wr consecutive data secs.                            */
+FS_NAND_INTERN  FS_SEC_QTY               FS_NAND_SecWrMultiHandler     (FS_NAND_DATA             *p_nand_data,
+                                                                        void                     *p_src,
+                                                                        FS_NAND_BLK_QTY           blk_ix_logical_data,
+                                                                        FS_NAND_BLK_QTY           blk_ix_logical,
+                                                                        FS_NAND_SEC_PER_BLK_QTY   sec_offset_phy,
+                                                                        FS_SEC_QTY                sec_cnt,
+                                                                        FS_ERR                   *p_err);
+
+                                                                /* Handle data sec pgm failure.                         */
+FS_NAND_INTERN  void                     FS_NAND_SecWrErrHandler       (FS_NAND_DATA             *p_nand_data,
+                                                                        FS_NAND_BLK_QTY           blk_ix_phy,
+                                                                        FS_ERR                   *p_err);
+
                                                                 /* Wr meta sec.                                         */
 FS_NAND_INTERN  void                     FS_NAND_MetaSecWrHandler      (FS_NAND_DATA             *p_nand_data,
                                                                         void                     *p_src,
@@ -990,7 +1063,11 @@ const  FS_DEV_API  FS_NAND = {
                                  FS_NAND_Wr,                    /* Wr to dev.                                           */
 #endif
                                  FS_NAND_Query,                 /* Get dev info.                                        */
-                                 FS_NAND_IO_Ctrl                /* Perform dev I/O ctrl.                                */
+                                 FS_NAND_IO_Ctrl,               /* Perform dev I/O ctrl.                                */
+                                 FS_NAND_RdV,                   /* Rd from dev into buf list.                           */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+                                 FS_NAND_WrV                    /* Wr to dev from buf list.                             */
+#endif
 };
 #endif
 
@@ -1108,6 +1185,18 @@ const  FS_DEV_API  FS_NAND = {
 #error "FS_NAND_CFG_TH_SUB_MIN_IDLE_TO_FOLD must be positive"
 #endif
 
+#if    ((FS_NAND_CFG_BG_PROC_EN != DEF_DISABLED) && \
+        (FS_NAND_CFG_BG_PROC_EN != DEF_ENABLED ))
+#error  "FS_NAND_CFG_BG_PROC_EN                 illegally #define'd in 'fs_dev_nand_cfg.h'"
+#error  "                                       [MUST be  DEF_DISABLED]"
+#error  "                                       [     ||  DEF_ENABLED ]"
+
+#elif   (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+#if     (FS_NAND_CFG_BG_SEC_PER_STEP < 1u)
+#error  "FS_NAND_CFG_BG_SEC_PER_STEP must be greater than or equal to 1"
+#endif
+#endif
+
 #ifndef FS_NAND_CFG_CLR_CORRUPT_METABLK
 #error  "FS_NAND_CFG_CLR_CORRUPT_METABLK        not #define'd in 'fs_dev_nand_cfg.h'"
 #error  "                                       [MUST be  DEF_DISABLED]"
@@ -1358,6 +1447,96 @@ void  FS_NAND_LowUnmount (CPU_CHAR  *p_name_dev,
 }
 
 
+/*
+*********************************************************************************************************
+*                                           FS_NAND_BgProc()
+*
+* Description : Perform one step of background processing (garbage collection and pre-erase) on a NAND
+*               device.
+*
+* Argument(s) : p_name_dev  Device name (see Note #1).
+*
+*               p_err       Pointer to variable that will receive return the error code from this function :
+*
+*                               FS_ERR_DEV_INVALID              Argument 'name_dev' specifies an invalid device.
+*                               FS_ERR_NAME_NULL                Argument 'name_dev' passed a NULL pointer.
+*                               FS_ERR_NONE                     Step performed (or nothing to do).
+*
+*                               --------------------------RETURNED BY FSDev_IO_Ctrl()---------------------------
+*                               See FSDev_IO_Ctrl() for additional return error codes.
+*
+* Return(s)   : DEF_YES, if a step was performed & more work may remain,
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) The device MUST be a NAND device (e.g., "nand:0:").
+*
+*               (2) This function is meant to be called repeatedly from a low-priority (idle) task until
+*                   it returns DEF_NO, e.g. :
+*
+*                       while (FS_NAND_BgProc("nand:0:", &err) == DEF_YES) {
+*                           ;
+*                       }
+*
+*                   Each call performs ONE bounded step (see FS_NAND_BgProcHandler()) & holds the device
+*                   lock only for the duration of that step. A higher-priority task accessing the file
+*                   system is therefore delayed by at most one step, after which it gets the device.
+*
+*               (3) Background processing only anticipates the merge or erase that the write path would
+*                   otherwise do next, synchronously, so it does not add wear. It never changes which data
+*                   is stored on the device, and may be interrupted by a power loss at any point like any
+*                   other device operation.
+*********************************************************************************************************
+*/
+
+#if ((FS_CFG_RD_ONLY_EN     == DEF_DISABLED) && \
+     (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED))
+CPU_BOOLEAN  FS_NAND_BgProc (CPU_CHAR  *p_name_dev,
+                             FS_ERR    *p_err)
+{
+    CPU_BOOLEAN  more;
+    CPU_INT16S   cmp_val;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == DEF_NULL) {                                    /* Validate err  ptr.                                   */
+        CPU_SW_EXCEPTION(DEF_NO);
+    }
+
+    if (p_name_dev == DEF_NULL) {                               /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return (DEF_NO);
+    }
+#endif
+
+                                                                /* Validate name str (see Note #1).                     */
+    cmp_val = Str_Cmp_N(p_name_dev, (CPU_CHAR *)FS_NAND_DrvName, FS_NAND_DRV_NAME_LEN);
+    if (cmp_val != 0) {
+       *p_err = FS_ERR_DEV_INVALID;
+        return (DEF_NO);
+    }
+
+    if (p_name_dev[FS_NAND_DRV_NAME_LEN] != FS_CHAR_DEV_SEP) {
+       *p_err = FS_ERR_DEV_INVALID;
+        return (DEF_NO);
+    }
+
+
+                                                                /* ------------ PERFORM BG STEP (see Note #2) --------- */
+    more = DEF_NO;
+    FSDev_IO_Ctrl(p_name_dev,
+                  FS_DEV_IO_CTRL_NAND_BG_PROC,
+                 &more,
+                  p_err);
+
+    if (*p_err != FS_ERR_NONE) {
+        return (DEF_NO);
+    }
+
+    return (more);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -1734,6 +1913,7 @@ FS_NAND_INTERN  void  FS_NAND_Open (FS_DEV  *p_dev,
 
     oos_size_free           = OOS_info.Size;
     p_nand_data->OOS_BufPtr = OOS_info.BufPtr;
+    p_nand_data->OOS_Size   = OOS_info.Size;
 
                                                                 /* ----------------- CALC FTL PARAMS ------------------ */
     p_nand_data->AvailBlkTblEntryCntMax   = p_nand_cfg->AvailBlkTblEntryCntMax;
@@ -1917,6 +2097,8 @@ FS_NAND_INTERN  void  FS_NAND_Close (FS_DEV  *p_dev)
 *
 * Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
 *                   called when a device is open.
+*
+*               (2) The buffer is read as a list of one buffer (see 'FS_NAND_RdV()').
 *********************************************************************************************************
 */
 
@@ -1926,86 +2108,26 @@ FS_NAND_INTERN  void  FS_NAND_Rd (FS_DEV      *p_dev,
                                   FS_SEC_QTY   sec_cnt,
                                   FS_ERR      *p_err)
 {
-    FS_NAND_DATA  *p_nand_data;
-    CPU_SIZE_T     rd_cnt_iter;
-    CPU_SIZE_T     rd_cnt_total;
-    FS_SEC_QTY     sec_ix_logical;
+    FS_DEV_IO_VEC  vec;
 
 
 #if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
     if (p_err == DEF_NULL) {                                    /* Validate err  ptr.                                   */
         CPU_SW_EXCEPTION(;);
     }
-    if (p_dev == DEF_NULL) {                                    /* Validate dev  ptr.                                   */
-       *p_err  = FS_ERR_NULL_PTR;
-        return;
-    }
     if (p_dest == DEF_NULL) {                                   /* Validate dest ptr.                                   */
        *p_err   = FS_ERR_NULL_PTR;
         return;
     }
 #endif
 
-    p_nand_data = (FS_NAND_DATA *)p_dev->DataPtr;
-
-   *p_err = FS_ERR_NONE;
-
-    sec_ix_logical = sec_start;
-    rd_cnt_total   = 0u;
-
-    while ((rd_cnt_total <  sec_cnt)    &&
-           (*p_err       == FS_ERR_NONE)  ){
-                                                                /* Rd 1 or more sec.                                    */
-        rd_cnt_iter = FS_NAND_SecRd(p_nand_data,
-                                    p_dest,
-                                    sec_ix_logical,
-                                    sec_cnt,
-                                    p_err);
-
-        rd_cnt_total   += rd_cnt_iter;
-        sec_ix_logical += rd_cnt_iter;
-
-        FS_CTR_STAT_ADD(p_nand_data->Ctrs.StatRdCtr, rd_cnt_iter);
-
-                                                                /* Update dest data ptr.                                */
-        p_dest = (void *)((CPU_INT08U *)p_dest + (p_nand_data->SecSize * rd_cnt_iter));
-    }
-
-    if (*p_err == FS_ERR_DEV_NAND_NO_SUCH_SEC) {
-        *p_err = FS_ERR_NONE;
-    }
-
-    if (*p_err != FS_ERR_NONE) {
-        FS_NAND_TRACE_DBG(("FS_NAND_Rd(): Error reading %u sectors from index %u.\r\n",
-                            sec_cnt,
-                            sec_start));
-
-        return;
-    }
-
-
-
-                                                                /* ----- COMMIT METADATA (IN CASE OF REFRESH) ----- */
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-#if (FS_NAND_CFG_AUTO_SYNC_EN == DEF_ENABLED)
-    do {
-       *p_err = FS_ERR_NONE;
-
-        FS_NAND_MetaCommit(p_nand_data,
-                           DEF_NO,
-                           p_err);
-
-    } while ((*p_err != FS_ERR_NONE) &&
-             (*p_err != FS_ERR_DEV_NAND_NO_AVAIL_BLK));
-
-    if (*p_err != FS_ERR_NONE) {
-        FS_NAND_TRACE_DBG(("FS_NAND_Wr(): Error committing metadata.\r\n"));
-
-        return;
-    }
-#endif
-#endif
-
+    vec.BufPtr = p_dest;                                        /* See Note #2.                                         */
+    vec.Cnt    = sec_cnt;
+    FS_NAND_RdV( p_dev,
+                &vec,
+                 1u,
+                 sec_start,
+                 p_err);
 }
 
 
@@ -2042,6 +2164,8 @@ FS_NAND_INTERN  void  FS_NAND_Rd (FS_DEV      *p_dev,
 *
 * Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
 *                   called when a device is open.
+*
+*               (2) The buffer is written as a list of one buffer (see 'FS_NAND_WrV()').
 *********************************************************************************************************
 */
 
@@ -2052,80 +2176,26 @@ FS_NAND_INTERN  void  FS_NAND_Wr (FS_DEV      *p_dev,
                                   FS_SEC_QTY   sec_cnt,
                                   FS_ERR      *p_err)
 {
-    FS_NAND_DATA  *p_nand_data;
-    FS_SEC_QTY     sec_wr_cnt_total;
-    FS_SEC_QTY     sec_wr_cnt_iter;
-    FS_SEC_QTY     sec_ix_logical;
+    FS_DEV_IO_VEC  vec;
 
 
 #if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
     if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
         CPU_SW_EXCEPTION(;);
     }
-    if (p_dev == DEF_NULL) {                                    /* Validate dev ptr.                                    */
-       *p_err  = FS_ERR_NULL_PTR;
-        return;
-    }
     if (p_src == DEF_NULL) {                                    /* Validate src ptr.                                    */
        *p_err  = FS_ERR_NULL_PTR;
         return;
     }
 #endif
 
-
-    FS_NAND_TRACE_LOG(("FS_NAND_Wr: start=%u, cnt=%u.\r\n", sec_start, sec_cnt));
-
-    p_nand_data = (FS_NAND_DATA *)p_dev->DataPtr;
-
-
-   *p_err = FS_ERR_NONE;
-
-    sec_ix_logical   = sec_start;
-    sec_wr_cnt_total = 0u;
-
-    while (( sec_wr_cnt_total  < sec_cnt)    &&
-           (*p_err            == FS_ERR_NONE)  ) {
-                                                                /* Wr 1 or more sec.                                    */
-        sec_wr_cnt_iter = FS_NAND_SecWr(p_nand_data,
-                                        p_src,
-                                        sec_ix_logical,
-                                        sec_cnt - sec_wr_cnt_total,
-                                        p_err);
-
-        sec_wr_cnt_total += sec_wr_cnt_iter;
-        sec_ix_logical   += sec_wr_cnt_iter;
-
-        FS_CTR_STAT_ADD(p_nand_data->Ctrs.StatWrCtr, sec_wr_cnt_iter);
-
-                                                                /* Update src data ptr.                                 */
-        p_src = (void *)((CPU_INT08U *)p_src + (p_nand_data->SecSize * sec_wr_cnt_iter));
-
-    }
-
-    if (*p_err != FS_ERR_NONE) {
-        FS_NAND_TRACE_DBG(("FS_NAND_Wr(): Error writing sectors on device.\r\n"));
-        return;
-    }
-
-#if (FS_NAND_CFG_AUTO_SYNC_EN == DEF_ENABLED)
-                                                                /* ----------------- COMMIT METADATA ------------------ */
-    do {
-       *p_err = FS_ERR_NONE;
-
-        FS_NAND_MetaCommit(p_nand_data,
-                           DEF_NO,
-                           p_err);
-
-    } while ((*p_err != FS_ERR_NONE) &&
-             (*p_err != FS_ERR_DEV_NAND_NO_AVAIL_BLK));
-
-    if (*p_err != FS_ERR_NONE) {
-        FS_NAND_TRACE_DBG(("FS_NAND_Wr(): Error committing metadata.\r\n"));
-
-        return;
-    }
-#endif
-
+    vec.BufPtr = p_src;                                         /* See Note #2.                                         */
+    vec.Cnt    = sec_cnt;
+    FS_NAND_WrV( p_dev,
+                &vec,
+                 1u,
+                 sec_start,
+                 p_err);
 }
 #endif
 
@@ -2251,6 +2321,7 @@ FS_NAND_INTERN  void  FS_NAND_Query (FS_DEV       *p_dev,
 *                   (j) FS_DEV_IO_CTRL_PHY_RD_PAGE       Read  physical device page.
 *                   (k) FS_DEV_IO_CTRL_PHY_WR_PAGE       Write physical device page.
 *                   (l) FS_DEV_IO_CTRL_PHY_ERASE_BLK     Erase physical device block.
+*                   (m) FS_DEV_IO_CTRL_NAND_BG_PROC      Perform one step of background processing.
 *
 *                   Not all of these operations are valid for all devices.
 *********************************************************************************************************
@@ -2280,6 +2351,7 @@ FS_NAND_INTERN  void  FS_NAND_IO_Ctrl (FS_DEV      *p_dev,
         case FS_DEV_IO_CTRL_WR_SEC         :
         case FS_DEV_IO_CTRL_PHY_ERASE_BLK  :
         case FS_DEV_IO_CTRL_NAND_DUMP      :
+        case FS_DEV_IO_CTRL_NAND_BG_PROC   :
              if (p_data == DEF_NULL) {
                 *p_err = FS_ERR_NULL_PTR;
                  return;
@@ -2397,6 +2469,17 @@ FS_NAND_INTERN  void  FS_NAND_IO_Ctrl (FS_DEV      *p_dev,
 #endif
              break;
 
+        case FS_DEV_IO_CTRL_NAND_BG_PROC:                       /* Perform one bg processing step.                      */
+#if ((FS_CFG_RD_ONLY_EN     == DEF_DISABLED) && \
+     (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED))
+             FS_NAND_BgProcHandler(p_nand_data,
+                                   (CPU_BOOLEAN *)p_data,
+                                   p_err);
+#else
+            *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+#endif
+             break;
+
         case FS_DEV_IO_CTRL_PHY_RD:
         case FS_DEV_IO_CTRL_PHY_WR:
         case FS_DEV_IO_CTRL_LOW_COMPACT:
@@ -2418,47 +2501,383 @@ FS_NAND_INTERN  void  FS_NAND_IO_Ctrl (FS_DEV      *p_dev,
 
 /*
 *********************************************************************************************************
-*********************************************************************************************************
-*                                           LOCAL FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
-
-/*
-*********************************************************************************************************
-*                                             FS_NAND_HdrWr()
+*                                            FS_NAND_RdV()
 *
-* Description : Creates the NAND device header in specified block.
+* Description : Read from a device & store data in a list of buffers.
 *
-* Argument(s) : p_nand_data     Pointer to NAND data.
-*               -----------     Argument validated by caller.
+* Argument(s) : p_dev       Pointer to device to read from.
 *
-*               blk_ix_hdr      Block index of new header block.
+*               p_vec_tbl   Pointer to table of destination buffers.
 *
-*               p_err           Pointer to variable that will receive the return error code from this function :
-*               -----           Argument validated by caller.
+*               vec_cnt     Number of buffers in table.
 *
-*                                   FS_ERR_DEV_INVALID_LOW_FMT  Device formatted, but could NOT be mounted.
-*                                   FS_ERR_DEV_INVALID_OP       Device invalid operation.
-*                                   FS_ERR_DEV_IO               Device I/O error.
-*                                   FS_ERR_DEV_TIMEOUT          Device timeout.
-*                                   FS_ERR_NONE                 Device formatted/mounted.
+*               sec_start   Start sector of read.
 *
-*                                   -------------------RETURNED BY p_ctrlr_api->SecWr()--------------------
-*                                   See p_ctrlr_api->SecWr() for additional return error codes.
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NULL_PTR                 Argument 'p_dev'/'p_vec_tbl' passed a NULL pointer.
+*                               FS_ERR_NONE                     Sector(s) read.
+*
+*                               ---------------RETURNED BY FS_NAND_MetaCommit()---------------
+*                               See FS_NAND_MetaCommit() for additional return error codes.
+*
+*                               -----------------RETURNED BY FS_NAND_SecRd()------------------
+*                               See FS_NAND_SecRd() for additional return error codes.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
+*                   called when a device is open.
+*
+*               (2) The sectors are read consecutively from 'sec_start', filling each buffer in turn.
+*                   Metadata is committed once for the whole list, rather than once per buffer.
+*
+*               (3) Consecutive buffers smaller than a multi-sector controller operation (e.g., single
+*                   cache buffers) are read as one run into the multi-sector buffer & then copied to each
+*                   buffer, so that FS_NAND_SecRd() can read the run in a single controller operation
+*                   (see FS_NAND_VecRunGet()).
+*
+*               (4) A sector that was never written is skipped & its buffer is left unchanged.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-FS_NAND_INTERN  void  FS_NAND_HdrWr (FS_NAND_DATA     *p_nand_data,
-                                     FS_NAND_BLK_QTY   blk_ix_hdr,
-                                     FS_ERR           *p_err)
+FS_NAND_INTERN  void  FS_NAND_RdV (FS_DEV         *p_dev,
+                                   FS_DEV_IO_VEC  *p_vec_tbl,
+                                   FS_SEC_QTY      vec_cnt,
+                                   FS_SEC_NBR      sec_start,
+                                   FS_ERR         *p_err)
 {
-    FS_NAND_CTRLR_API                    *p_ctrlr_api;
+    FS_NAND_DATA  *p_nand_data;
+    CPU_INT08U    *p_dest;
+    CPU_INT08U    *p_run;
+    CPU_SIZE_T     rd_cnt_iter;
+    CPU_SIZE_T     rd_cnt_total;
+    FS_SEC_QTY     run_sec_cnt;
+    FS_SEC_QTY     run_vec_cnt;
+    FS_SEC_QTY     sec_ix_logical;
+    FS_SEC_QTY     sec_ix;
+    FS_SEC_QTY     vec_ix;
+    FS_SEC_QTY     vec_ix_run;
+    CPU_INT08U     no_sec_map[FS_UTIL_BIT_NBR_TO_OCTET_NBR(FS_NAND_CFG_MULTI_SEC_MAX)];
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == DEF_NULL) {                                    /* Validate err  ptr.                                   */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (p_dev == DEF_NULL) {                                    /* Validate dev  ptr.                                   */
+       *p_err  = FS_ERR_NULL_PTR;
+        return;
+    }
+    if (p_vec_tbl == DEF_NULL) {                                /* Validate vec tbl ptr.                                */
+       *p_err  = FS_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+    p_nand_data = (FS_NAND_DATA *)p_dev->DataPtr;
+
+   *p_err = FS_ERR_NONE;
+
+    sec_ix_logical = sec_start;
+    vec_ix         = 0u;
+
+    while ((vec_ix <  vec_cnt)     &&                           /* See Note #2.                                         */
+           (*p_err == FS_ERR_NONE)   ) {
+        run_vec_cnt = FS_NAND_VecRunGet( p_nand_data,
+                                         p_vec_tbl,
+                                         vec_cnt,
+                                         vec_ix,
+                                        &run_sec_cnt);
+        if (run_vec_cnt > 1u) {                                 /* Gather run in multi-sec buf (see Note #3).           */
+            p_run = (CPU_INT08U *)p_nand_data->MultiBufPtr;
+            Mem_Clr((void *)&no_sec_map[0], sizeof(no_sec_map));
+        } else {
+            p_run = (CPU_INT08U *)p_vec_tbl[vec_ix].BufPtr;
+        }
+
+        p_dest       = p_run;
+        rd_cnt_total = 0u;
+        while ((rd_cnt_total <  run_sec_cnt) &&
+               (*p_err       == FS_ERR_NONE)  ) {
+                                                                /* Rd 1 or more sec.                                    */
+            rd_cnt_iter = FS_NAND_SecRd(p_nand_data,
+                                        p_dest,
+                                        sec_ix_logical + rd_cnt_total,
+                                        run_sec_cnt    - rd_cnt_total,
+                                        p_err);
+
+            if (*p_err == FS_ERR_DEV_NAND_NO_SUCH_SEC) {        /* Skip sec never wr'en (see Note #4).                  */
+               *p_err = FS_ERR_NONE;
+                if (run_vec_cnt > 1u) {
+                    FSUtil_MapBitSet(&no_sec_map[0], rd_cnt_total);
+                }
+                rd_cnt_iter = 1u;
+            } else {
+                FS_CTR_STAT_ADD(p_nand_data->Ctrs.StatRdCtr, rd_cnt_iter);
+            }
+
+            rd_cnt_total += rd_cnt_iter;
+                                                                /* Update dest data ptr.                                */
+            p_dest += p_nand_data->SecSize * rd_cnt_iter;
+        }
+
+        if ((run_vec_cnt >  1u) &&                              /* Scatter run to bufs (see Note #3).                   */
+            (*p_err      == FS_ERR_NONE)) {
+            sec_ix = 0u;
+            for (vec_ix_run = vec_ix; vec_ix_run < vec_ix + run_vec_cnt; vec_ix_run++) {
+                p_dest = (CPU_INT08U *)p_vec_tbl[vec_ix_run].BufPtr;
+                for (rd_cnt_iter = 0u; rd_cnt_iter < p_vec_tbl[vec_ix_run].Cnt; rd_cnt_iter++) {
+                    if (FSUtil_MapBitIsSet(&no_sec_map[0], sec_ix) == DEF_NO) {
+                        Mem_Copy((void     *) p_dest,
+                                 (void     *)&p_run[p_nand_data->SecSize * sec_ix],
+                                 (CPU_SIZE_T) p_nand_data->SecSize);
+                    }
+                    p_dest += p_nand_data->SecSize;
+                    sec_ix++;
+                }
+            }
+        }
+
+        sec_ix_logical += run_sec_cnt;
+        vec_ix         += run_vec_cnt;
+    }
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_NAND_TRACE_DBG(("FS_NAND_RdV(): Error reading %u buffers from index %u.\r\n",
+                            vec_cnt,
+                            sec_start));
+
+        return;
+    }
+
+
+
+                                                                /* ----- COMMIT METADATA (IN CASE OF REFRESH) ----- */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+#if (FS_NAND_CFG_AUTO_SYNC_EN == DEF_ENABLED)
+    do {
+       *p_err = FS_ERR_NONE;
+
+        FS_NAND_MetaCommit(p_nand_data,
+                           DEF_NO,
+                           p_err);
+
+    } while ((*p_err != FS_ERR_NONE) &&
+             (*p_err != FS_ERR_DEV_NAND_NO_AVAIL_BLK));
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_NAND_TRACE_DBG(("FS_NAND_RdV(): Error committing metadata.\r\n"));
+
+        return;
+    }
+#endif
+#endif
+
+}
+
+
+/*
+*********************************************************************************************************
+*                                            FS_NAND_WrV()
+*
+* Description : Write data to a device from a list of buffers.
+*
+* Argument(s) : p_dev       Pointer to device to write to.
+*
+*               p_vec_tbl   Pointer to table of source buffers.
+*
+*               vec_cnt     Number of buffers in table.
+*
+*               sec_start   Start sector of write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NULL_PTR                 Argument 'p_dev'/'p_vec_tbl' passed a NULL pointer.
+*                               FS_ERR_NONE                     Sector(s) written.
+*
+*                               -----------------RETURNED BY FS_NAND_SecWr()------------------
+*                               See FS_NAND_SecWr() for additional return error codes.
+*
+*                               ---------------RETURNED BY FS_NAND_MetaCommit()---------------
+*                               See FS_NAND_MetaCommit() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
+*                   called when a device is open.
+*
+*               (2) The sectors are written consecutively from 'sec_start', taking each buffer in turn.
+*                   Metadata is committed once for the whole list, so a cache flush of N scattered
+*                   buffers costs one commit instead of N.
+*
+*               (3) Consecutive buffers smaller than a multi-sector controller operation (e.g., single
+*                   cache buffers) are copied into the multi-sector buffer & written as one run, so that
+*                   FS_NAND_SecWr() can program the run in a single controller operation (see
+*                   FS_NAND_VecRunGet()).
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+FS_NAND_INTERN  void  FS_NAND_WrV (FS_DEV         *p_dev,
+                                   FS_DEV_IO_VEC  *p_vec_tbl,
+                                   FS_SEC_QTY      vec_cnt,
+                                   FS_SEC_NBR      sec_start,
+                                   FS_ERR         *p_err)
+{
+    FS_NAND_DATA  *p_nand_data;
+    CPU_INT08U    *p_src;
+    CPU_INT08U    *p_run;
+    CPU_SIZE_T     len;
+    FS_SEC_QTY     sec_wr_cnt_total;
+    FS_SEC_QTY     sec_wr_cnt_iter;
+    FS_SEC_QTY     run_sec_cnt;
+    FS_SEC_QTY     run_vec_cnt;
+    FS_SEC_QTY     sec_ix_logical;
+    FS_SEC_QTY     vec_ix;
+    FS_SEC_QTY     vec_ix_run;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (p_dev == DEF_NULL) {                                    /* Validate dev ptr.                                    */
+       *p_err  = FS_ERR_NULL_PTR;
+        return;
+    }
+    if (p_vec_tbl == DEF_NULL) {                                /* Validate vec tbl ptr.                                */
+       *p_err  = FS_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+
+    FS_NAND_TRACE_LOG(("FS_NAND_WrV: start=%u, vec cnt=%u.\r\n", sec_start, vec_cnt));
+
+    p_nand_data = (FS_NAND_DATA *)p_dev->DataPtr;
+
+
+   *p_err = FS_ERR_NONE;
+
+    sec_ix_logical = sec_start;
+    vec_ix         = 0u;
+
+    while ((vec_ix <  vec_cnt)     &&                           /* See Note #2.                                         */
+           (*p_err == FS_ERR_NONE)   ) {
+        run_vec_cnt = FS_NAND_VecRunGet( p_nand_data,
+                                         p_vec_tbl,
+                                         vec_cnt,
+                                         vec_ix,
+                                        &run_sec_cnt);
+        if (run_vec_cnt > 1u) {                                 /* Gather run in multi-sec buf (see Note #3).           */
+            p_run = (CPU_INT08U *)p_nand_data->MultiBufPtr;
+            p_src =  p_run;
+            for (vec_ix_run = vec_ix; vec_ix_run < vec_ix + run_vec_cnt; vec_ix_run++) {
+                len = (CPU_SIZE_T)p_nand_data->SecSize * p_vec_tbl[vec_ix_run].Cnt;
+                Mem_Copy((void *)p_src,
+                         (void *)p_vec_tbl[vec_ix_run].BufPtr,
+                                 len);
+                p_src += len;
+            }
+        } else {
+            p_run = (CPU_INT08U *)p_vec_tbl[vec_ix].BufPtr;
+        }
+
+        p_src            = p_run;
+        sec_wr_cnt_total = 0u;
+        while (( sec_wr_cnt_total  < run_sec_cnt) &&
+               (*p_err            == FS_ERR_NONE)  ) {
+                                                                /* Wr 1 or more sec.                                    */
+            sec_wr_cnt_iter = FS_NAND_SecWr(p_nand_data,
+                                            p_src,
+                                            sec_ix_logical,
+                                            run_sec_cnt - sec_wr_cnt_total,
+                                            p_err);
+
+            sec_wr_cnt_total += sec_wr_cnt_iter;
+            sec_ix_logical   += sec_wr_cnt_iter;
+
+            FS_CTR_STAT_ADD(p_nand_data->Ctrs.StatWrCtr, sec_wr_cnt_iter);
+
+                                                                /* Update src data ptr.                                 */
+            p_src += p_nand_data->SecSize * sec_wr_cnt_iter;
+        }
+
+        vec_ix += run_vec_cnt;
+    }
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_NAND_TRACE_DBG(("FS_NAND_WrV(): Error writing sectors on device.\r\n"));
+        return;
+    }
+
+#if (FS_NAND_CFG_AUTO_SYNC_EN == DEF_ENABLED)
+                                                                /* ----------------- COMMIT METADATA ------------------ */
+    do {
+       *p_err = FS_ERR_NONE;
+
+        FS_NAND_MetaCommit(p_nand_data,
+                           DEF_NO,
+                           p_err);
+
+    } while ((*p_err != FS_ERR_NONE) &&
+             (*p_err != FS_ERR_DEV_NAND_NO_AVAIL_BLK));
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_NAND_TRACE_DBG(("FS_NAND_WrV(): Error committing metadata.\r\n"));
+
+        return;
+    }
+#endif
+
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                             FS_NAND_HdrWr()
+*
+* Description : Creates the NAND device header in specified block.
+*
+* Argument(s) : p_nand_data     Pointer to NAND data.
+*               -----------     Argument validated by caller.
+*
+*               blk_ix_hdr      Block index of new header block.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               -----           Argument validated by caller.
+*
+*                                   FS_ERR_DEV_INVALID_LOW_FMT  Device formatted, but could NOT be mounted.
+*                                   FS_ERR_DEV_INVALID_OP       Device invalid operation.
+*                                   FS_ERR_DEV_IO               Device I/O error.
+*                                   FS_ERR_DEV_TIMEOUT          Device timeout.
+*                                   FS_ERR_NONE                 Device formatted/mounted.
+*
+*                                   -------------------RETURNED BY p_ctrlr_api->SecWr()--------------------
+*                                   See p_ctrlr_api->SecWr() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+FS_NAND_INTERN  void  FS_NAND_HdrWr (FS_NAND_DATA     *p_nand_data,
+                                     FS_NAND_BLK_QTY   blk_ix_hdr,
+                                     FS_ERR           *p_err)
+{
+    FS_NAND_CTRLR_API                    *p_ctrlr_api;
     void                                 *p_ctrlr_data;
     CPU_INT08U                           *p_hdr_data;
     CPU_INT08U                           *p_oos_data;
@@ -6204,6 +6623,11 @@ FS_NAND_INTERN  void  FS_NAND_AvailBlkTblEntryWr (FS_NAND_DATA             *p_na
 
                                                                 /* Clear entry bit in avail blk tbl commit map.         */
     FSUtil_MapBitClr(p_nand_data->AvailBlkTblCommitMap, tbl_ix);
+
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+                                                                /* New entry not known to be erased.                    */
+    FSUtil_MapBitClr(p_nand_data->AvailBlkErasedMap, tbl_ix);
+#endif
 }
 #endif
 
@@ -9108,60 +9532,514 @@ FS_NAND_INTERN  void  FS_NAND_DumpHandler (FS_NAND_DATA   *p_nand_data,
 }
 #endif
 
-
 /*
 *********************************************************************************************************
-*                                        FS_NAND_SecRdHandler()
+*                                       FS_NAND_BgProcHandler()
 *
-* Description : (1) Read sector (using logical block index) from a NAND device & store data in buffer.
-*               (2) Handles some errors that may occur during read.
-*               (3) May refresh an unreadable block.
+* Description : Perform one step of background processing.
 *
 * Argument(s) : p_nand_data     Pointer to NAND data.
 *               -----------     Argument validated by caller.
 *
-*               p_dest          Pointer to destination buffer.
+*               p_more          Pointer to variable that will receive DEF_YES if a step was performed
+*               ------          (DEF_NO if there was nothing to do).
+*                               Argument validated by caller.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function.
 *               ------          Argument validated by caller.
 *
-*               p_dest_oos      Pointer to destination spare-area buffer.
-*               ----------      Argument validated by caller.
+*                                   FS_ERR_DEV_INVALID_LOW_FMT      Device is not low-level formatted.
+*                                   FS_ERR_NONE                     Step performed (or nothing to do).
 *
-*               blk_ix_logical  Logical index of the block to read from.
+*                                   -----------RETURNED BY FS_NAND_BgMergeStep()------------
+*                                   See FS_NAND_BgMergeStep() for additional return error codes.
 *
-*               sec_offset_phy  Physical offset of the sector to read.
+*                                   -----------RETURNED BY FS_NAND_BgEraseStep()------------
+*                                   See FS_NAND_BgEraseStep() for additional return error codes.
 *
-*               p_err           Pointer to variable that will receive return the error code from this function :
-*               -----           Argument validated by caller.
+*                                   ------------RETURNED BY FS_NAND_MetaCommit()------------
+*                                   See FS_NAND_MetaCommit() for additional return error codes.
 *
-*                                   FS_ERR_DEV_IO                   Device I/O error.
-*                                   FS_ERR_NONE                     Sector read successfully.
+* Return(s)   : none.
 *
-*                                   ------------RETURNED BY p_ctrlr_api->SecRd()-------------
-*                                   See p_ctrlr_api->SecRd() for additional return error codes.
+* Note(s)     : (1) A step is either :
 *
-*                                   ------------RETURNED BY FS_NAND_BlkRefresh()-------------
-*                                   FS_ERR_DEV_INVALID_METADATA     Metadata block could not be found.
-*                                   FS_ERR_ECC_UNCORR               Uncorrectable ECC error.
+*                   (a) One merge step, if the next update block allocation would have to merge (see
+*                       FS_NAND_BgMergeStep()); or
 *
-*                                   ------------RETURNED BY FS_NAND_BlkMarkBad()-------------
-*                                   FS_ERR_DEV_INVALID_OP           Bad blocks table is full.
+*                   (b) One erase step, if the next block taken from the available blocks table is not
+*                       known to be erased (see FS_NAND_BgEraseStep()).
 *
-* Return(s)   : none.
+*                   Merges come first, since a merge consumes an erased block & produces dirty blocks
+*                   that the erase step can then recycle.
 *
-* Note(s)     : none.
+*               (2) Metadata is committed after each merge step if FS_NAND_CFG_AUTO_SYNC_EN is enabled,
+*                   as after any write (see FS_NAND_Wr()). An erase step only updates the erased map, which
+*                   is kept in RAM (see FS_NAND_BgEraseStep() Note #1).
 *********************************************************************************************************
 */
 
-FS_NAND_INTERN  void  FS_NAND_SecRdHandler (FS_NAND_DATA             *p_nand_data,
-                                            void                     *p_dest,
-                                            void                     *p_dest_oos,
-                                            FS_NAND_BLK_QTY           blk_ix_logical,
-                                            FS_NAND_SEC_PER_BLK_QTY   sec_offset_phy,
-                                            FS_ERR                   *p_err)
+#if ((FS_CFG_RD_ONLY_EN     == DEF_DISABLED) && \
+     (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED))
+FS_NAND_INTERN  void  FS_NAND_BgProcHandler (FS_NAND_DATA  *p_nand_data,
+                                             CPU_BOOLEAN   *p_more,
+                                             FS_ERR        *p_err)
 {
-    FS_NAND_CTRLR_API  *p_ctrlr_api;
-    void               *p_ctrlr_data;
-    FS_NAND_BLK_QTY     blk_ix_phy;
+    CPU_BOOLEAN  done;
+
+
+   *p_more = DEF_NO;
+
+    if (p_nand_data->Fmtd != DEF_YES) {
+       *p_err = FS_ERR_DEV_INVALID_LOW_FMT;
+        return;
+    }
+
+                                                                /* --------------- STEP (see Note #1) ----------------- */
+    done = FS_NAND_BgMergeStep(p_nand_data, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        FS_NAND_TRACE_DBG(("FS_NAND_BgProcHandler(): Error during background merge step.\r\n"));
+        return;
+    }
+
+    if (done == DEF_NO) {                                       /* Erase step: no metadata to commit (see Note #2).     */
+       *p_more = FS_NAND_BgEraseStep(p_nand_data, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FS_NAND_TRACE_DBG(("FS_NAND_BgProcHandler(): Error during background erase step.\r\n"));
+        }
+        return;
+    }
+
+#if (FS_NAND_CFG_AUTO_SYNC_EN == DEF_ENABLED)
+                                                                /* -------- COMMIT METADATA (see Note #2) ------------- */
+    do {
+       *p_err = FS_ERR_NONE;
+
+        FS_NAND_MetaCommit(p_nand_data,
+                           DEF_NO,
+                           p_err);
+
+    } while ((*p_err != FS_ERR_NONE) &&
+             (*p_err != FS_ERR_DEV_NAND_NO_AVAIL_BLK));
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_NAND_TRACE_DBG(("FS_NAND_BgProcHandler(): Error committing metadata.\r\n"));
+        return;
+    }
+#endif
+
+   *p_more = DEF_YES;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_NAND_BgMergeStep()
+*
+* Description : Perform one background merge step, so that an empty update block is ready when the write
+*               path needs one.
+*
+* Argument(s) : p_nand_data     Pointer to NAND data.
+*               -----------     Argument validated by caller.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               -----           Argument validated by caller.
+*
+*                                   FS_ERR_NONE     Operation was successful.
+*
+*                                   -----------RETURNED BY FS_NAND_SUB_Merge()-------------
+*                                   See FS_NAND_SUB_Merge() for additional return error codes.
+*
+*                                   ---------RETURNED BY FS_NAND_SUB_MergeUntil()----------
+*                                   See FS_NAND_SUB_MergeUntil() for additional return error codes.
+*
+*                                   --------RETURNED BY FS_NAND_RUB_PartialMerge()---------
+*                                   See FS_NAND_RUB_PartialMerge() for additional return error codes.
+*
+* Return(s)   : DEF_YES, if a step was performed,
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) Background merges only anticipate a merge that FS_NAND_UB_Alloc() would otherwise have
+*                   to perform on the next allocation (see FS_NAND_UB_Alloc() Note #1). Merging earlier
+*                   than that only shortens the life of update blocks that could still absorb writes, &
+*                   raises write amplification & erase counts. Update blocks are therefore scanned the same
+*                   way as in FS_NAND_UB_Alloc() :
+*
+*                   (a) A full SUB is always merged, as FS_NAND_UB_Alloc() would do first: it frees a UB
+*                       without copying more than the foreground merge would.
+*
+*                   (b) Otherwise, nothing is done while at least FS_NAND_CFG_BG_UB_FREE_MIN UBs are empty,
+*                       or while the next random allocation could still use a RUB with k<K or an idle SUB
+*                       to convert (cases B & C of FS_NAND_UB_Alloc()).
+*
+*                   (c) Otherwise, the UB FS_NAND_UB_Alloc() would merge is merged: the fullest SUB if it
+*                       has few free sectors or if there is no RUB; else, the RUB with the highest merge
+*                       priority, but only if that RUB is full (see Note #3).
+*
+*               (2) A SUB merge is split in steps copying at most FS_NAND_CFG_BG_SEC_PER_STEP sectors
+*                   each (see FS_NAND_SUB_MergeUntil()). The SUB is tracked across steps & abandoned if
+*                   the write path merged, converted or reused it in the meantime.
+*
+*               (3) A RUB that still has free sectors may be written again before the write path needs
+*                   a UB, & merging it early then costs a merge the write path would never have done.
+*                   A full RUB must be merged anyway; its merge is split in partial merges, one
+*                   associated data block per step.
+*********************************************************************************************************
+*/
+
+#if ((FS_CFG_RD_ONLY_EN     == DEF_DISABLED) && \
+     (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED))
+FS_NAND_INTERN  CPU_BOOLEAN  FS_NAND_BgMergeStep (FS_NAND_DATA  *p_nand_data,
+                                                  FS_ERR        *p_err)
+{
+    FS_NAND_UB_EXTRA_DATA    ub_extra_data;
+    FS_NAND_UB_QTY           ub_ix;
+    FS_NAND_UB_QTY           ub_free_cnt;
+    FS_NAND_UB_QTY           ix_sub_full;
+    FS_NAND_UB_QTY           ix_sub_fullest;
+    FS_NAND_UB_QTY           ix_rub_priority;
+    CPU_BOOLEAN              ub_avail;
+    FS_NAND_SEC_PER_BLK_QTY  min_free_sec_cnt;
+    FS_NAND_SEC_PER_BLK_QTY  free_sec_cnt;
+    FS_NAND_SEC_PER_BLK_QTY  sec_end;
+    FS_NAND_ASSOC_BLK_QTY    assoc_ix;
+    CPU_INT16U               idle_val;
+    CPU_INT32U               rub_merge_prio;
+    CPU_INT32U               max_rub_merge_prio;
+
+
+    ub_free_cnt        = 0u;
+    ix_sub_full        = FS_NAND_UB_IX_INVALID;
+    ix_sub_fullest     = FS_NAND_UB_IX_INVALID;
+    ix_rub_priority    = FS_NAND_UB_IX_INVALID;
+    ub_avail           = DEF_NO;
+    min_free_sec_cnt   = FS_NAND_SEC_OFFSET_IX_INVALID;
+    max_rub_merge_prio = 0u;
+
+                                                                /* -------------- SCAN ALL UBs (see Note #1) ---------- */
+    for (ub_ix = 0u; ub_ix < p_nand_data->UB_CntMax; ub_ix++) {
+        ub_extra_data = p_nand_data->UB_ExtraDataTbl[ub_ix];
+
+        if (ub_extra_data.NextSecIx == 0u) {                    /* Empty UB.                                            */
+            ub_free_cnt++;
+            continue;
+        }
+                                                                /* Determine idle cnt.                                  */
+        if (ub_extra_data.ActivityCtr > p_nand_data->ActivityCtr) {
+            idle_val  = DEF_GET_U_MAX_VAL(idle_val) - ub_extra_data.ActivityCtr;
+            idle_val += p_nand_data->ActivityCtr;
+        } else {
+            idle_val  = p_nand_data->ActivityCtr - ub_extra_data.ActivityCtr;
+        }
+
+        free_sec_cnt = p_nand_data->NbrSecPerBlk - ub_extra_data.NextSecIx;
+
+        if (ub_extra_data.AssocLvl == 0u) {                     /* Blk is a SUB.                                        */
+            if (free_sec_cnt == 0u) {
+                ix_sub_full = ub_ix;
+            }
+
+            if (free_sec_cnt < min_free_sec_cnt) {
+                min_free_sec_cnt = free_sec_cnt;
+                ix_sub_fullest   = ub_ix;
+            }
+                                                                /* SUB the wr path could convert to RUB.                */
+            if ((free_sec_cnt <  p_nand_data->ThSecRemCnt_ConvertSUBToRUB) &&
+                (idle_val     >  FS_NAND_CFG_TH_SUB_MIN_IDLE_TO_FOLD)) {
+                ub_avail = DEF_YES;
+            }
+
+        } else {                                                /* Blk is a RUB.                                        */
+            if ((free_sec_cnt           != 0u) &&               /* RUB the wr path could associate further.             */
+                (ub_extra_data.AssocLvl <  p_nand_data->RUB_MaxAssoc)) {
+                ub_avail = DEF_YES;
+            }
+
+            if (ub_extra_data.NextSecIx - 1 >= p_nand_data->NbrSecPerBlk) {
+                rub_merge_prio  = DEF_GET_U_MAX_VAL(rub_merge_prio);
+            } else {
+                rub_merge_prio  = idle_val / p_nand_data->UB_CntMax;
+                rub_merge_prio += ub_extra_data.NextSecIx;
+            }
+
+            if (rub_merge_prio > max_rub_merge_prio) {
+                max_rub_merge_prio = rub_merge_prio;
+                ix_rub_priority    = ub_ix;
+            }
+        }
+    }
+
+                                                                /* ----------- FULL SUB AVAIL (see Note #1a) ---------- */
+    if (ix_sub_full != FS_NAND_UB_IX_INVALID) {
+        FS_CTR_STAT_INC(p_nand_data->Ctrs.StatBgMergeStepCtr);
+
+        FS_NAND_SUB_Merge(p_nand_data, ix_sub_full, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (DEF_NO);
+        }
+
+        if (ix_sub_full == p_nand_data->BgSUB_Ix) {
+            p_nand_data->BgSUB_Ix = FS_NAND_UB_IX_INVALID;
+        }
+        return (DEF_YES);
+    }
+
+                                                                /* ------------ NO MERGE NEEDED (see Note #1b) -------- */
+    if ((ub_free_cnt >= FS_NAND_CFG_BG_UB_FREE_MIN) ||
+        (ub_avail    == DEF_YES)) {
+        return (DEF_NO);
+    }
+
+                                                                /* ---------- RESUME SUB MERGE (see Note #2) ---------- */
+    if (p_nand_data->BgSUB_Ix != FS_NAND_UB_IX_INVALID) {
+        ub_extra_data = p_nand_data->UB_ExtraDataTbl[p_nand_data->BgSUB_Ix];
+        if ((ub_extra_data.NextSecIx              == 0u) ||
+            (ub_extra_data.AssocLvl               != 0u) ||
+            (ub_extra_data.AssocLogicalBlksTbl[0] != p_nand_data->BgSUB_BlkIxLogical)) {
+            p_nand_data->BgSUB_Ix = FS_NAND_UB_IX_INVALID;      /* SUB changed by wr path; abandon it.                  */
+        }
+    }
+
+                                                                /* ----------- SELECT UB TO MERGE (see Note #1c) ------ */
+    if ((p_nand_data->BgSUB_Ix == FS_NAND_UB_IX_INVALID) &&
+        (ix_sub_fullest        != FS_NAND_UB_IX_INVALID)) {
+        if ((min_free_sec_cnt < p_nand_data->ThSecRemCnt_MergeSUB) ||
+            (ix_rub_priority == FS_NAND_UB_IX_INVALID)) {
+            ub_extra_data                   = p_nand_data->UB_ExtraDataTbl[ix_sub_fullest];
+            p_nand_data->BgSUB_Ix           = ix_sub_fullest;
+            p_nand_data->BgSUB_BlkIxLogical = ub_extra_data.AssocLogicalBlksTbl[0];
+            p_nand_data->BgSUB_NextSecIx    = ub_extra_data.NextSecIx;
+        }
+    }
+
+                                                                /* ------------- SUB MERGE STEP (see Note #2) --------- */
+    if (p_nand_data->BgSUB_Ix != FS_NAND_UB_IX_INVALID) {
+        FS_CTR_STAT_INC(p_nand_data->Ctrs.StatBgMergeStepCtr);
+
+        ub_extra_data = p_nand_data->UB_ExtraDataTbl[p_nand_data->BgSUB_Ix];
+        sec_end       = DEF_MAX(p_nand_data->BgSUB_NextSecIx, ub_extra_data.NextSecIx);
+        free_sec_cnt  = p_nand_data->NbrSecPerBlk - sec_end;
+
+        if (free_sec_cnt <= FS_NAND_CFG_BG_SEC_PER_STEP) {
+            FS_NAND_SUB_Merge(p_nand_data,                      /* Last step: finish merge.                             */
+                              p_nand_data->BgSUB_Ix,
+                              p_err);
+
+            p_nand_data->BgSUB_Ix = FS_NAND_UB_IX_INVALID;
+        } else {
+            sec_end += FS_NAND_CFG_BG_SEC_PER_STEP;
+
+            FS_NAND_SUB_MergeUntil(p_nand_data,
+                                   p_nand_data->BgSUB_Ix,
+                                   sec_end - 1u,
+                                   p_err);
+
+            p_nand_data->BgSUB_NextSecIx = sec_end;
+        }
+
+        if (*p_err != FS_ERR_NONE) {
+            p_nand_data->BgSUB_Ix = FS_NAND_UB_IX_INVALID;
+            return (DEF_NO);
+        }
+        return (DEF_YES);
+    }
+
+                                                                /* ------------- RUB MERGE STEP (see Note #3) --------- */
+    if ((ix_rub_priority    != FS_NAND_UB_IX_INVALID) &&
+        (max_rub_merge_prio == DEF_GET_U_MAX_VAL(max_rub_merge_prio))) {
+        FS_CTR_STAT_INC(p_nand_data->Ctrs.StatBgMergeStepCtr);
+
+        ub_extra_data = p_nand_data->UB_ExtraDataTbl[ix_rub_priority];
+        for (assoc_ix = 0u; assoc_ix < p_nand_data->RUB_MaxAssoc; assoc_ix++) {
+            if (ub_extra_data.AssocLogicalBlksTbl[assoc_ix] != FS_NAND_BLK_IX_INVALID) {
+                FS_NAND_RUB_PartialMerge(p_nand_data,
+                                         ix_rub_priority,
+                                         ub_extra_data.AssocLogicalBlksTbl[assoc_ix],
+                                         p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    return (DEF_NO);
+                }
+                return (DEF_YES);
+            }
+        }
+    }
+
+    return (DEF_NO);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_NAND_BgEraseStep()
+*
+* Description : Perform one background erase step, so that the block the write path takes next from the
+*               available blocks table is already erased.
+*
+* Argument(s) : p_nand_data     Pointer to NAND data.
+*               -----------     Argument validated by caller.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               -----           Argument validated by caller.
+*
+*                                   FS_ERR_NONE     Operation was successful.
+*
+*                                   ---------RETURNED BY FS_NAND_BlkEnsureErased()---------
+*                                   See FS_NAND_BlkEnsureErased() for additional return error codes.
+*
+* Return(s)   : DEF_YES, if a step was performed,
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) Only the entry FS_NAND_BlkGetAvailFromTbl() would take next is erased (stale metadata
+*                   block first, then lowest erase count among committed entries), & only if that entry
+*                   is committed, so that its erase count survives a power loss. Blocks are not erased
+*                   further ahead of need. FS_NAND_BlkGetErased() still checks that the block it gets is
+*                   erased (see FS_NAND_BlkEnsureErased()), so the erased map is only a hint.
+*
+*               (2) If no more than FS_NAND_CFG_RSVD_AVAIL_BLK_CNT entries are committed, the next block
+*                   is taken from the entry FS_NAND_BlkGetErased() first adds to the table. That entry is
+*                   not added here: doing so ahead of the write path costs an extra metadata write (&
+*                   eventually extra metadata block erases) for each block pre-erased.
+*********************************************************************************************************
+*/
+
+#if ((FS_CFG_RD_ONLY_EN     == DEF_DISABLED) && \
+     (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED))
+FS_NAND_INTERN  CPU_BOOLEAN  FS_NAND_BgEraseStep (FS_NAND_DATA  *p_nand_data,
+                                                  FS_ERR        *p_err)
+{
+    FS_NAND_AVAIL_BLK_ENTRY  tbl_entry;
+    FS_NAND_BLK_QTY          tbl_ix;
+    FS_NAND_BLK_QTY          tbl_ix_committed;
+    FS_NAND_BLK_QTY          blk_ix_phy;
+    FS_NAND_BLK_QTY          nbr_entries_committed;
+    FS_NAND_ERASE_QTY        min_erase_cnt;
+    FS_NAND_ERASE_QTY        min_erase_cnt_committed;
+    CPU_BOOLEAN              is_entry_committed;
+    FS_NAND_META_ID          meta_id_delta;
+
+
+    nbr_entries_committed   = 0u;
+    tbl_ix_committed        = FS_NAND_BLK_IX_INVALID;
+    min_erase_cnt           = DEF_GET_U_MAX_VAL(min_erase_cnt);
+    min_erase_cnt_committed = DEF_GET_U_MAX_VAL(min_erase_cnt_committed);
+
+                                                                /* ----------- FIND NEXT BLK TAKEN (see Note #1) ------ */
+    for (tbl_ix = 0u; tbl_ix < p_nand_data->AvailBlkTblEntryCntMax; tbl_ix++) {
+        tbl_entry = FS_NAND_AvailBlkTblEntryRd(p_nand_data, tbl_ix);
+
+        if (tbl_entry.BlkIxPhy != FS_NAND_BLK_IX_INVALID) {
+            if (FSUtil_MapBitIsSet(p_nand_data->AvailBlkMetaMap, tbl_ix) == DEF_YES) {
+                meta_id_delta = p_nand_data->MetaBlkID - p_nand_data->AvailBlkMetaID_Tbl[tbl_ix];
+                if (meta_id_delta > FS_NAND_META_ID_STALE_THRESH) {
+                    tbl_entry.EraseCnt = 0u;                    /* Stale meta blk is taken first.                       */
+                }
+            }
+
+            is_entry_committed = FSUtil_MapBitIsSet(p_nand_data->AvailBlkTblCommitMap, tbl_ix);
+            if (is_entry_committed == DEF_YES) {
+                nbr_entries_committed++;
+                if (tbl_entry.EraseCnt < min_erase_cnt_committed) {
+                    min_erase_cnt_committed = tbl_entry.EraseCnt;
+                    tbl_ix_committed        = tbl_ix;
+                }
+            } else {
+                if (tbl_entry.EraseCnt < min_erase_cnt) {
+                    min_erase_cnt = tbl_entry.EraseCnt;
+                }
+            }
+        }
+    }
+
+    if ((nbr_entries_committed   <= FS_NAND_CFG_RSVD_AVAIL_BLK_CNT) ||
+        (min_erase_cnt_committed >= min_erase_cnt)) {           /* Next blk taken not a committed entry (see Note #2).  */
+        return (DEF_NO);
+    }
+
+    if (FSUtil_MapBitIsSet(p_nand_data->AvailBlkErasedMap, tbl_ix_committed) == DEF_YES) {
+        return (DEF_NO);                                        /* Next blk taken already erased.                       */
+    }
+
+                                                                /* -------------------- ERASE BLK --------------------- */
+    tbl_entry  = FS_NAND_AvailBlkTblEntryRd(p_nand_data, tbl_ix_committed);
+    blk_ix_phy = tbl_entry.BlkIxPhy;
+
+    FS_NAND_BlkEnsureErased(p_nand_data, blk_ix_phy, p_err);
+    switch (*p_err) {
+        case FS_ERR_NONE:
+             FSUtil_MapBitSet(p_nand_data->AvailBlkErasedMap, tbl_ix_committed);
+             FS_CTR_STAT_INC(p_nand_data->Ctrs.StatBgEraseCtr);
+             return (DEF_YES);
+
+
+        case FS_ERR_DEV_IO:                                     /* Blk could not be erased.                             */
+            *p_err     = FS_ERR_NONE;
+             tbl_entry = FS_NAND_AvailBlkTblEntryRd(p_nand_data, tbl_ix_committed);
+                                                                /* Progress only if blk was retired from tbl.           */
+             return ((tbl_entry.BlkIxPhy != blk_ix_phy) ? DEF_YES : DEF_NO);
+
+
+        default:
+             return (DEF_NO);
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_NAND_SecRdHandler()
+*
+* Description : (1) Read sector (using logical block index) from a NAND device & store data in buffer.
+*               (2) Handles some errors that may occur during read.
+*               (3) May refresh an unreadable block.
+*
+* Argument(s) : p_nand_data     Pointer to NAND data.
+*               -----------     Argument validated by caller.
+*
+*               p_dest          Pointer to destination buffer.
+*               ------          Argument validated by caller.
+*
+*               p_dest_oos      Pointer to destination spare-area buffer.
+*               ----------      Argument validated by caller.
+*
+*               blk_ix_logical  Logical index of the block to read from.
+*
+*               sec_offset_phy  Physical offset of the sector to read.
+*
+*               p_err           Pointer to variable that will receive return the error code from this function :
+*               -----           Argument validated by caller.
+*
+*                                   FS_ERR_DEV_IO                   Device I/O error.
+*                                   FS_ERR_NONE                     Sector read successfully.
+*
+*                                   ------------RETURNED BY p_ctrlr_api->SecRd()-------------
+*                                   See p_ctrlr_api->SecRd() for additional return error codes.
+*
+*                                   ------------RETURNED BY FS_NAND_BlkRefresh()-------------
+*                                   FS_ERR_DEV_INVALID_METADATA     Metadata block could not be found.
+*                                   FS_ERR_ECC_UNCORR               Uncorrectable ECC error.
+*
+*                                   ------------RETURNED BY FS_NAND_BlkMarkBad()-------------
+*                                   FS_ERR_DEV_INVALID_OP           Bad blocks table is full.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+FS_NAND_INTERN  void  FS_NAND_SecRdHandler (FS_NAND_DATA             *p_nand_data,
+                                            void                     *p_dest,
+                                            void                     *p_dest_oos,
+                                            FS_NAND_BLK_QTY           blk_ix_logical,
+                                            FS_NAND_SEC_PER_BLK_QTY   sec_offset_phy,
+                                            FS_ERR                   *p_err)
+{
+    FS_NAND_CTRLR_API  *p_ctrlr_api;
+    void               *p_ctrlr_data;
+    FS_NAND_BLK_QTY     blk_ix_phy;
     FS_SEC_QTY          sec_ix_phy;
 
 
@@ -9289,62 +10167,255 @@ FS_NAND_INTERN  void  FS_NAND_SecRdPhyNoRefresh(FS_NAND_DATA             *p_nand
 #endif
 
 
-    p_ctrlr_api    = p_nand_data->CtrlrPtr;
-    p_ctrlr_data   = p_nand_data->CtrlrDataPtr;
+    p_ctrlr_api    = p_nand_data->CtrlrPtr;
+    p_ctrlr_data   = p_nand_data->CtrlrDataPtr;
+
+
+    rd_retries   = 0u;
+    while (rd_retries < FS_NAND_CFG_MAX_RD_RETRIES) {           /* Loop until rd success or retry cnt exceeded.         */
+                                                                /* Calc sec ix phy.                                     */
+        sec_ix_phy  = FS_NAND_BLK_IX_TO_SEC_IX(p_nand_data, blk_ix_phy);
+        sec_ix_phy += sec_offset_phy;
+
+        p_ctrlr_api->SecRd(p_ctrlr_data,                        /* Rd sec.                                              */
+                           p_dest,
+                           p_dest_oos,
+                           sec_ix_phy,
+                           p_err);
+
+        if ((*p_err == FS_ERR_ECC_CORR) ||
+            (*p_err == FS_ERR_ECC_CRITICAL_CORR)) {
+           *p_err = FS_ERR_NONE;
+            return;
+        } else if (*p_err == FS_ERR_ECC_UNCORR) {               /* Retry on uncorrectable ecc err.                      */
+            CPU_INT32U  sec_used_mark;                          /* Chk used mark.                                       */
+            CPU_INT08U  set_bit_cnt;
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
+            if (sizeof(sec_used_mark) < p_nand_data->UsedMarkSize) {
+                FS_NAND_TRACE_DBG(("FS_NAND_SecRdPhyNoRefresh(): Local variable sec_used_mark is too small to contain an appropriate used mark.\r\n"));
+               *p_err = FS_ERR_DEV_INCOMPATIBLE_LOW_PARAMS;
+                return;
+            }
+#endif
+
+            sec_used_mark = 0u;
+            MEM_VAL_COPY_GET_INTU_LITTLE(&sec_used_mark,
+                              (CPU_CHAR *)p_dest_oos + FS_NAND_OOS_SEC_USED_OFFSET,
+                                          p_nand_data->UsedMarkSize);
+
+            set_bit_cnt = CRCUtil_PopCnt_32(sec_used_mark);
+
+            if (set_bit_cnt < (p_nand_data->UsedMarkSize * DEF_INT_08_NBR_BITS / 2u)) {
+                rd_retries++;                                   /* Sec is used, retry.                                  */
+               *p_err = FS_ERR_NONE;
+            } else {
+                return;                                         /* Sec isn't used, no need to retry.                    */
+            }
+
+        } else if (*p_err != FS_ERR_NONE) {                     /* Unhandled err.                                       */
+            return;
+        } else {                                                /* Success.                                             */
+            return;
+        }
+    }
+
+                                                                /* Max retry cnt reached.                               */
+   *p_err = FS_ERR_ECC_UNCORR;
+    return;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_NAND_VecRunGet()
+*
+* Description : Get the run of buffer list entries to read or write through the multi-sector buffer.
+*
+* Argument(s) : p_nand_data     Pointer to NAND data.
+*               -----------     Argument validated by caller.
+*
+*               p_vec_tbl       Pointer to table of buffers.
+*               ---------       Argument validated by caller.
+*
+*               vec_cnt         Number of buffers in table.
+*
+*               vec_ix          Index of the first buffer of the run.
+*
+*               p_sec_cnt       Pointer to variable that will receive the number of sectors of the run.
+*               ---------       Argument validated by caller.
+*
+* Return(s)   : Number of buffers in the run. If more than 1, the buffers must be gathered in (or scattered
+*               from) the multi-sector buffer.
+*
+* Caller(s)   : FS_NAND_RdV(),
+*               FS_NAND_WrV().
+*
+* Note(s)     : (1) Buffers are added to the run as long as the run fits in FS_NAND_CFG_MULTI_SEC_MAX
+*                   sectors; a buffer is never split.  A buffer that does not fit alone is read or
+*                   written in place, since FS_NAND_SecRd() & FS_NAND_SecWr() already run its sectors.
+*
+*               (2) The run is not clamped to the end of the block : FS_NAND_SecRd() & FS_NAND_SecWr()
+*                   stop at the end of the block & are called again for the rest of the run.
+*********************************************************************************************************
+*/
+
+FS_NAND_INTERN  FS_SEC_QTY  FS_NAND_VecRunGet (FS_NAND_DATA   *p_nand_data,
+                                               FS_DEV_IO_VEC  *p_vec_tbl,
+                                               FS_SEC_QTY      vec_cnt,
+                                               FS_SEC_QTY      vec_ix,
+                                               FS_SEC_QTY     *p_sec_cnt)
+{
+    FS_SEC_QTY  sec_cnt;
+    FS_SEC_QTY  run_vec_cnt;
+
+
+    sec_cnt     = p_vec_tbl[vec_ix].Cnt;
+    run_vec_cnt = 1u;
+
+    if (p_nand_data->MultiBufPtr != DEF_NULL) {                 /* See Note #1.                                         */
+        while ((vec_ix + run_vec_cnt < vec_cnt) &&
+               (sec_cnt + p_vec_tbl[vec_ix + run_vec_cnt].Cnt <= FS_NAND_CFG_MULTI_SEC_MAX)) {
+            sec_cnt += p_vec_tbl[vec_ix + run_vec_cnt].Cnt;
+            run_vec_cnt++;
+        }
+    }
+
+   *p_sec_cnt = sec_cnt;
+    return (run_vec_cnt);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FS_NAND_SecRdMultiHandler()
+*
+* Description : Read consecutive sectors of a logical block from a NAND device in a single controller
+*               operation & store data in buffer.
+*
+* Argument(s) : p_nand_data     Pointer to NAND data.
+*               -----------     Argument validated by caller.
+*
+*               p_dest          Pointer to destination buffer.
+*               ------          Argument validated by caller.
+*
+*               blk_ix_logical  Block's logical index.
+*
+*               sec_offset_phy  Physical offset of the first sector to read.
+*
+*               sec_cnt         Number of sectors requested by caller.
+*
+*               p_err           Pointer to variable that will receive return the error code from this function :
+*               -----           Argument validated by caller.
+*
+*                                   FS_ERR_NONE     Sector(s) read successfully, or multi-sector read skipped.
+*
+*                                   -------------RETURNED BY p_ctrlr_api->SecRdMulti()--------------
+*                                   See p_ctrlr_api->SecRdMulti() for additional return error codes.
+*
+* Return(s)   : Number of sectors read, 0 if the caller must read the first sector with FS_NAND_SecRdHandler().
+*
+* Note(s)     : (1) The run is limited to the end of the block & to FS_NAND_CFG_MULTI_SEC_MAX sectors. Runs
+*                   of less than 2 sectors are left to FS_NAND_SecRdHandler().
+*
+*               (2) ECC errors are NOT handled here : the controller stops at the first sector that needs
+*                   attention & that sector is left to FS_NAND_SecRdHandler(), which refreshes the block if
+*                   needed, on the caller's next iteration.
+*
+*               (3) The run ends at the first sector that is unused or that is a dummy sector, so that the
+*                   caller reports it exactly as it would have for a single sector read.
+*********************************************************************************************************
+*/
+
+FS_NAND_INTERN  FS_SEC_QTY  FS_NAND_SecRdMultiHandler (FS_NAND_DATA             *p_nand_data,
+                                                      void                     *p_dest,
+                                                      FS_NAND_BLK_QTY           blk_ix_logical,
+                                                      FS_NAND_SEC_PER_BLK_QTY   sec_offset_phy,
+                                                      FS_SEC_QTY                sec_cnt,
+                                                      FS_ERR                   *p_err)
+{
+    FS_NAND_CTRLR_API        *p_ctrlr_api;
+    CPU_INT08U               *p_oos_buf;
+    FS_NAND_BLK_QTY           blk_ix_phy;
+    FS_SEC_QTY                sec_ix_phy;
+    FS_SEC_QTY                rd_cnt;
+    FS_SEC_QTY                sec_ix;
+    FS_NAND_SEC_PER_BLK_QTY   sec_offset_logical_rd;
+    CPU_INT32U                sec_used_mark;
+    CPU_INT08U                set_bit_cnt;
+    CPU_BOOLEAN               sec_valid;
+
+
+    p_ctrlr_api = p_nand_data->CtrlrPtr;
 
+    if ((p_nand_data->OOS_MultiBufPtr == DEF_NULL) ||
+        (p_ctrlr_api->SecRdMulti      == DEF_NULL)) {
+        return (0u);
+    }
 
-    rd_retries   = 0u;
-    while (rd_retries < FS_NAND_CFG_MAX_RD_RETRIES) {           /* Loop until rd success or retry cnt exceeded.         */
-                                                                /* Calc sec ix phy.                                     */
-        sec_ix_phy  = FS_NAND_BLK_IX_TO_SEC_IX(p_nand_data, blk_ix_phy);
-        sec_ix_phy += sec_offset_phy;
+                                                                /* Clamp run len (see Note #1).                         */
+    sec_cnt = DEF_MIN(sec_cnt, (FS_SEC_QTY)(p_nand_data->NbrSecPerBlk - sec_offset_phy));
+    sec_cnt = DEF_MIN(sec_cnt, FS_NAND_CFG_MULTI_SEC_MAX);
+    if (sec_cnt < 2u) {
+        return (0u);
+    }
 
-        p_ctrlr_api->SecRd(p_ctrlr_data,                        /* Rd sec.                                              */
-                           p_dest,
-                           p_dest_oos,
-                           sec_ix_phy,
-                           p_err);
+    blk_ix_phy = FS_NAND_BlkIxPhyGet(p_nand_data, blk_ix_logical);
+    if (blk_ix_phy == FS_NAND_BLK_IX_INVALID) {
+        return (0u);
+    }
 
-        if ((*p_err == FS_ERR_ECC_CORR) ||
-            (*p_err == FS_ERR_ECC_CRITICAL_CORR)) {
-           *p_err = FS_ERR_NONE;
-            return;
-        } else if (*p_err == FS_ERR_ECC_UNCORR) {               /* Retry on uncorrectable ecc err.                      */
-            CPU_INT32U  sec_used_mark;                          /* Chk used mark.                                       */
-            CPU_INT08U  set_bit_cnt;
+    sec_ix_phy  = FS_NAND_BLK_IX_TO_SEC_IX(p_nand_data, blk_ix_phy);
+    sec_ix_phy += sec_offset_phy;
 
-#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
-            if (sizeof(sec_used_mark) < p_nand_data->UsedMarkSize) {
-                FS_NAND_TRACE_DBG(("FS_NAND_SecRdPhyNoRefresh(): Local variable sec_used_mark is too small to contain an appropriate used mark.\r\n"));
-               *p_err = FS_ERR_DEV_INCOMPATIBLE_LOW_PARAMS;
-                return;
-            }
-#endif
+                                                                /* ------------------- RD SECS RUN -------------------- */
+    rd_cnt = p_ctrlr_api->SecRdMulti(p_nand_data->CtrlrDataPtr,
+                                     p_dest,
+                                     p_nand_data->OOS_MultiBufPtr,
+                                     sec_ix_phy,
+                                     sec_cnt,
+                                     p_err);
+    switch (*p_err) {
+        case FS_ERR_ECC_CRITICAL_CORR:                          /* See Note #2.                                         */
+        case FS_ERR_ECC_UNCORR:
+            *p_err = FS_ERR_NONE;
+             break;
 
-            sec_used_mark = 0u;
-            MEM_VAL_COPY_GET_INTU_LITTLE(&sec_used_mark,
-                              (CPU_CHAR *)p_dest_oos + FS_NAND_OOS_SEC_USED_OFFSET,
-                                          p_nand_data->UsedMarkSize);
 
-            set_bit_cnt = CRCUtil_PopCnt_32(sec_used_mark);
+        case FS_ERR_NONE:
+             break;
 
-            if (set_bit_cnt < (p_nand_data->UsedMarkSize * DEF_INT_08_NBR_BITS / 2u)) {
-                rd_retries++;                                   /* Sec is used, retry.                                  */
-               *p_err = FS_ERR_NONE;
-            } else {
-                return;                                         /* Sec isn't used, no need to retry.                    */
-            }
 
-        } else if (*p_err != FS_ERR_NONE) {                     /* Unhandled err.                                       */
-            return;
-        } else {                                                /* Success.                                             */
-            return;
+        default:
+             return (0u);
+    }
+
+                                                                /* ------------------- CHK SECS RD -------------------- */
+    p_oos_buf = (CPU_INT08U *)p_nand_data->OOS_MultiBufPtr;     /* See Note #3.                                         */
+    sec_ix    =  0u;
+    sec_valid =  DEF_YES;
+    while ((sec_ix    <  rd_cnt) &&
+           (sec_valid == DEF_YES)) {
+        sec_used_mark = 0u;
+        MEM_VAL_COPY_GET_INTU_LITTLE(&sec_used_mark,
+                                     &p_oos_buf[FS_NAND_OOS_SEC_USED_OFFSET],
+                                      p_nand_data->UsedMarkSize);
+
+        MEM_VAL_COPY_GET_INTU_LITTLE(&sec_offset_logical_rd,
+                                     &p_oos_buf[FS_NAND_OOS_STO_BLK_SEC_IX_OFFSET],
+                                      sizeof(FS_NAND_SEC_PER_BLK_QTY));
+
+        set_bit_cnt = CRCUtil_PopCnt_32(sec_used_mark);
+        if ((set_bit_cnt           >= (p_nand_data->UsedMarkSize * DEF_INT_08_NBR_BITS / 2u)) ||
+            (sec_offset_logical_rd ==  FS_NAND_SEC_OFFSET_IX_INVALID)) {
+            sec_valid = DEF_NO;                                 /* Sec unused or dummy.                                 */
+        } else {
+            sec_ix++;
+            p_oos_buf += p_nand_data->OOS_Size;
         }
     }
 
-                                                                /* Max retry cnt reached.                               */
-   *p_err = FS_ERR_ECC_UNCORR;
-    return;
+    return (sec_ix);
 }
 
 
@@ -9382,13 +10453,18 @@ FS_NAND_INTERN  void  FS_NAND_SecRdPhyNoRefresh(FS_NAND_DATA             *p_nand
 *                                   -------RETURNED BY FS_NAND_SecRdHandler()--------
 *                                   See FS_NAND_SecRdHandler() for additional return error codes.
 *
+*                                   ----RETURNED BY FS_NAND_SecRdMultiHandler()------
+*                                   See FS_NAND_SecRdMultiHandler() for additional return error codes.
+*
 * Return(s)   : Number of sectors read from device.
 *
 * Note(s)     : (1) The function must search for the sector(s) in the UB (update blocks) before searching
 *                   data blocks to make sure to get the latest version of the sector written on the device.
 *
-*               (2) For the moment, the parameter 'sec_cnt' is not used, and only one sector is read for
-*                   each call. However, the parameter is left for future implementation.
+*               (2) When no UB is associated with the logical block, every sector of the block is read from
+*                   the data block, so up to 'sec_cnt' consecutive sectors are read in a single controller
+*                   operation (see FS_NAND_SecRdMultiHandler()). Otherwise, only one sector is read for
+*                   each call.
 *********************************************************************************************************
 */
 
@@ -9406,12 +10482,13 @@ FS_NAND_INTERN  FS_SEC_QTY  FS_NAND_SecRd (FS_NAND_DATA  *p_nand_data,
     FS_NAND_UB_DATA           ub_data;
     FS_SEC_QTY                sec_ix_phy;
     FS_NAND_BLK_QTY           blk_ix_phy;
+    FS_SEC_QTY                rd_cnt;
+    CPU_BOOLEAN               has_ub;
     CPU_BOOLEAN               is_sec_in_ub;
     CPU_BOOLEAN               is_sec_used;
     CPU_BOOLEAN              *p_dest_oos;
 
 
-    (void)sec_cnt;
     p_dest_oos = (CPU_INT08U *)p_nand_data->OOS_BufPtr;
 
     blk_ix_logical     = FS_NAND_SEC_IX_TO_BLK_IX(p_nand_data, sec_ix_logical);
@@ -9423,7 +10500,8 @@ FS_NAND_INTERN  FS_SEC_QTY  FS_NAND_SecRd (FS_NAND_DATA  *p_nand_data,
     ub_sec_data  = FS_NAND_UB_Find(p_nand_data,
                                    blk_ix_logical);
 
-    if (ub_sec_data.UB_Ix != FS_NAND_UB_IX_INVALID) {
+    has_ub       = (ub_sec_data.UB_Ix != FS_NAND_UB_IX_INVALID) ? DEF_YES : DEF_NO;
+    if (has_ub == DEF_YES) {
                                                                 /* Find sec in UB.                                      */
         ub_sec_data = FS_NAND_UB_SecFind(p_nand_data,
                                          ub_sec_data,
@@ -9487,6 +10565,28 @@ FS_NAND_INTERN  FS_SEC_QTY  FS_NAND_SecRd (FS_NAND_DATA  *p_nand_data,
 
 
                                                                 /* ------------------ PERFORM SEC RD ------------------ */
+    if ((has_ub  == DEF_NO) &&                                  /* Rd run of secs from data blk (see Note #2).          */
+        (sec_cnt >  1u)) {
+        rd_cnt = FS_NAND_SecRdMultiHandler(p_nand_data,
+                                           p_dest,
+                                           blk_ix_logical,
+                                           sec_offset_phy,
+                                           sec_cnt,
+                                           p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FS_NAND_TRACE_DBG(("FS_NAND_SecRd(): Error reading %u sectors from offset %u in logical block %u.\r\n",
+                                sec_cnt,
+                                sec_offset_phy,
+                                blk_ix_logical));
+
+            return (0u);
+        }
+
+        if (rd_cnt != 0u) {
+            return (rd_cnt);
+        }
+    }
+
     FS_NAND_SecRdHandler(p_nand_data,
                          p_dest,
                          p_nand_data->OOS_BufPtr,
@@ -9602,33 +10702,184 @@ FS_NAND_INTERN  void  FS_NAND_SecWrHandler (FS_NAND_DATA             *p_nand_dat
                        sec_ix_phy,
                        p_err);
     if (*p_err == FS_ERR_DEV_IO) {                              /* ------------------- HANDLE ERRS -------------------- */
-       *p_err = FS_ERR_NONE;
+        FS_NAND_SecWrErrHandler(p_nand_data, blk_ix_phy, p_err);
+    }
+}
+#endif
 
-        FS_NAND_BlkRefresh(p_nand_data, blk_ix_phy, p_err);     /* Refresh blk.                                         */
 
-        switch (*p_err) {
-            case FS_ERR_ECC_UNCORR:                             /* Ignore uncorrectable ECC err.                        */
-                *p_err = FS_ERR_NONE;
-                 break;
+/*
+*********************************************************************************************************
+*                                     FS_NAND_SecWrMultiHandler()
+*
+* Description : Write consecutive data sectors and their out of sector data to a NAND device in a single
+*               controller operation.
+*
+* Argument(s) : p_nand_data             Pointer to NAND data.
+*               -----------             Argument validated by caller.
+*
+*               p_src                   Pointer to source buffer.
+*               -----                   Argument validated by caller.
+*
+*               blk_ix_logical_data     Logical block index associated with data sectors.
+*
+*               blk_ix_logical          Logical index of the block that will store the data sectors.
+*
+*               sec_offset_phy          Physical offset of the first sector to write.
+*
+*               sec_cnt                 Number of sectors to write (see Note #1).
+*
+*               p_err                   Pointer to variable that will receive return the error code from this function :
+*               -----                   Argument validated by caller.
+*
+*                                           FS_ERR_NONE                     Sectors written successfully.
+*
+*                                           ------------RETURNED BY FS_NAND_SecWrErrHandler()------------
+*                                           See FS_NAND_SecWrErrHandler() for additional return error codes.
+*
+*                                           ------------RETURNED BY p_ctrlr_api->SecWrMulti()------------
+*                                           See p_ctrlr_api->SecWrMulti() for additional return error codes.
+*
+* Return(s)   : Number of sectors written, either 'sec_cnt' or 0 (see Note #2).
+*
+* Note(s)     : (1) The caller must ensure that 'sec_cnt' does not exceed FS_NAND_CFG_MULTI_SEC_MAX nor the end
+*                   of the block, and that the multi-sector controller operation is available.
+*
+*               (2) When a programming error occurs, the whole run is considered lost even if the controller
+*                   confirmed some of its sectors : those sectors are not yet recorded in the update block
+*                   metadata & would not be copied by FS_NAND_BlkRefresh(). The block is refreshed and marked
+*                   bad as in FS_NAND_SecWrHandler(), and the caller must retry the whole run.
+*********************************************************************************************************
+*/
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+FS_NAND_INTERN  FS_SEC_QTY  FS_NAND_SecWrMultiHandler (FS_NAND_DATA             *p_nand_data,
+                                                      void                     *p_src,
+                                                      FS_NAND_BLK_QTY           blk_ix_logical_data,
+                                                      FS_NAND_BLK_QTY           blk_ix_logical,
+                                                      FS_NAND_SEC_PER_BLK_QTY   sec_offset_phy,
+                                                      FS_SEC_QTY                sec_cnt,
+                                                      FS_ERR                   *p_err)
+{
+    FS_NAND_CTRLR_API        *p_ctrlr_api;
+    CPU_INT08U               *p_oos_buf;
+    FS_NAND_BLK_QTY           blk_ix_phy;
+    FS_SEC_QTY                sec_ix_phy;
+    FS_SEC_QTY                sec_ix;
+    FS_SEC_QTY                wr_cnt;
 
-            case FS_ERR_NONE:
-                 break;
 
+    p_ctrlr_api = p_nand_data->CtrlrPtr;
 
-            default:
-                 return;
-        }
+                                                                /* ------------------ CALC SEC PHY IX ----------------- */
+    blk_ix_phy  = FS_NAND_BlkIxPhyGet(p_nand_data, blk_ix_logical);
+#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
+    if (blk_ix_phy == FS_NAND_BLK_IX_INVALID) {
+        FS_NAND_TRACE_DBG(("FS_NAND_SecWrMultiHandler(): Index of physical block (blk_ix_phy) is invalid.\r\n"));
+       *p_err = FS_ERR_DEV_IO;
+        return (0u);
+    }
+#endif
+    sec_ix_phy  = FS_NAND_BLK_IX_TO_SEC_IX(p_nand_data, blk_ix_phy);
+    sec_ix_phy += sec_offset_phy;
 
-        FS_NAND_BlkMarkBad(p_nand_data, blk_ix_phy, p_err);     /* Mark blk bad.                                        */
+                                                                /* ------------------ CALC OOS DATA ------------------- */
+    p_oos_buf = (CPU_INT08U *)p_nand_data->OOS_MultiBufPtr;
+    for (sec_ix = 0u; sec_ix < sec_cnt; sec_ix++) {
+        Mem_Set(p_oos_buf, 0xFFu, p_nand_data->OOS_Size);
+        FS_NAND_OOSGenSto(p_nand_data,
+                          p_oos_buf,
+                          blk_ix_logical_data,
+                          blk_ix_phy,
+                          sec_offset_phy + sec_ix,
+                          sec_offset_phy + sec_ix,
+                          p_err);
         if (*p_err != FS_ERR_NONE) {
-            FS_NAND_TRACE_DBG(("FS_NAND_SecWrHandler(): Failed to mark failing block %u as bad.\r\n",
-                                blk_ix_phy));
-            return;
+            return (0u);
         }
+        p_oos_buf += p_nand_data->OOS_Size;
+    }
+
+                                                                /* ------------------ WR SECS TO DEV ------------------ */
+    wr_cnt = p_ctrlr_api->SecWrMulti(p_nand_data->CtrlrDataPtr,
+                                     p_src,
+                                     p_nand_data->OOS_MultiBufPtr,
+                                     sec_ix_phy,
+                                     sec_cnt,
+                                     p_err);
+    if (*p_err == FS_ERR_DEV_IO) {                              /* ------------------- HANDLE ERRS -------------------- */
+        FS_NAND_SecWrErrHandler(p_nand_data, blk_ix_phy, p_err);
+        return (0u);                                            /* See Note #2.                                         */
+    }
+
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+    return (wr_cnt);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_NAND_SecWrErrHandler()
+*
+* Description : Handle a programming error on a block holding data sectors.
+*
+* Argument(s) : p_nand_data     Pointer to NAND data.
+*               -----------     Argument validated by caller.
+*
+*               blk_ix_phy      Physical index of the failing block.
+*
+*               p_err           Pointer to variable that will receive return the error code from this function :
+*               -----           Argument validated by caller.
+*
+*                                   FS_ERR_DEV_OP_ABORTED           Block was refreshed & marked bad successfully.
+*
+*                                   -----------------------------RETURNED BY FS_NAND_BlkRefresh()-----------------------------
+*                                   FS_ERR_DEV_INVALID_METADATA     Metadata block could not be found.
+*
+*                                   -----------------------------RETURNED BY FS_NAND_BlkMarkBad()-----------------------------
+*                                   FS_ERR_DEV_INVALID_OP           Bad blocks table is full.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See FS_NAND_SecWrHandler() Note #1.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+FS_NAND_INTERN  void  FS_NAND_SecWrErrHandler (FS_NAND_DATA     *p_nand_data,
+                                               FS_NAND_BLK_QTY   blk_ix_phy,
+                                               FS_ERR           *p_err)
+{
+   *p_err = FS_ERR_NONE;
+
+    FS_NAND_BlkRefresh(p_nand_data, blk_ix_phy, p_err);         /* Refresh blk.                                         */
+
+    switch (*p_err) {
+        case FS_ERR_ECC_UNCORR:                                 /* Ignore uncorrectable ECC err.                        */
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+        case FS_ERR_NONE:
+             break;
+
+
+        default:
+             return;
+    }
 
-       *p_err = FS_ERR_DEV_OP_ABORTED;                          /* Notify caller op has failed.                         */
+    FS_NAND_BlkMarkBad(p_nand_data, blk_ix_phy, p_err);         /* Mark blk bad.                                        */
+    if (*p_err != FS_ERR_NONE) {
+        FS_NAND_TRACE_DBG(("FS_NAND_SecWrErrHandler(): Failed to mark failing block %u as bad.\r\n",
+                            blk_ix_phy));
+        return;
     }
+
+   *p_err = FS_ERR_DEV_OP_ABORTED;                              /* Notify caller op has failed.                         */
 }
 #endif
 
@@ -10731,9 +11982,15 @@ FS_NAND_INTERN  FS_SEC_QTY  FS_NAND_SecWrInRUB (FS_NAND_DATA     *p_nand_data,
 *                                   --------------RETURNED BY FS_NAND_OOSGenSto()---------------
 *                                   See FS_NAND_OOSGenSto() for additional return error codes.
 *
+*                                   ----------RETURNED BY FS_NAND_SecWrMultiHandler()-----------
+*                                   See FS_NAND_SecWrMultiHandler() for additional return error codes.
+*
 * Return(s)   : Number of sectors written. Might not be equal to sec_cnt.
 *
-* Note(s)     : none.
+* Note(s)     : (1) Since sectors are written at consecutive offsets of a SUB, runs of up to
+*                   FS_NAND_CFG_MULTI_SEC_MAX sectors are programmed in a single controller operation when
+*                   the controller provides one (see FS_NAND_SecWrMultiHandler()). The metadata is then
+*                   updated for each sector of the run.
 *********************************************************************************************************
 */
 
@@ -10749,6 +12006,8 @@ FS_NAND_INTERN  FS_SEC_QTY  FS_NAND_SecWrInSUB (FS_NAND_DATA    *p_nand_data,
     FS_NAND_BLK_QTY                 ub_ix_logical;
     FS_NAND_SEC_PER_BLK_QTY         sec_offset_phy;
     FS_SEC_QTY                      wr_cnt;
+    FS_SEC_QTY                      run_cnt;
+    FS_SEC_QTY                      run_wr_cnt;
     FS_NAND_UB_DATA                 p_data;
     FS_NAND_UB_EXTRA_DATA          *p_extra_data;
     FS_NAND_BLK_QTY                 blk_ix_phy;
@@ -10774,92 +12033,111 @@ FS_NAND_INTERN  FS_SEC_QTY  FS_NAND_SecWrInSUB (FS_NAND_DATA    *p_nand_data,
                             ub_ix,
                             sec_offset_phy));
 
+        run_cnt = 1u;                                           /* Calc run len (see Note #1).                          */
+        if ((p_nand_data->OOS_MultiBufPtr          != DEF_NULL) &&
+            (p_nand_data->CtrlrPtr->SecWrMulti     != DEF_NULL)) {
+            run_cnt = DEF_MIN(sec_cnt - wr_cnt, (FS_SEC_QTY)(p_nand_data->NbrSecPerBlk - sec_offset_phy));
+            run_cnt = DEF_MIN(run_cnt, FS_NAND_CFG_MULTI_SEC_MAX);
+        }
+
 
-        do {                                                    /* Until sec wr'en successfully.                        */
+        do {                                                    /* Until sec(s) wr'en successfully.                     */
+            ub_ix_logical = FS_NAND_UB_IX_TO_LOG_BLK_IX(p_nand_data, ub_ix);
+            if (run_cnt > 1u) {                                 /* --------------------- WR SECS ---------------------- */
+                run_wr_cnt = FS_NAND_SecWrMultiHandler(p_nand_data,
+                                                       p_src,
+                                                       data_blk_ix_logical,
+                                                       ub_ix_logical,
+                                                       sec_offset_phy,
+                                                       run_cnt,
+                                                       p_err);
+            } else {
                                                                 /* ------------------ CALC OOS DATA ------------------- */
-            blk_ix_phy = FS_NAND_UB_IX_TO_LOG_BLK_IX(p_nand_data, ub_ix);
-            blk_ix_phy = FS_NAND_BlkIxPhyGet(p_nand_data, blk_ix_phy);
+                blk_ix_phy = FS_NAND_BlkIxPhyGet(p_nand_data, ub_ix_logical);
 #if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
-            if (blk_ix_phy == FS_NAND_BLK_IX_INVALID) {
-                FS_NAND_TRACE_DBG(("FS_NAND_SecWrInSUB(): Index of physical block (blk_ix_phy) is invalid.\r\n"));
-               *p_err = FS_ERR_DEV_IO;
-                return (0u);
-            }
+                if (blk_ix_phy == FS_NAND_BLK_IX_INVALID) {
+                    FS_NAND_TRACE_DBG(("FS_NAND_SecWrInSUB(): Index of physical block (blk_ix_phy) is invalid.\r\n"));
+                   *p_err = FS_ERR_DEV_IO;
+                    return (0u);
+                }
 #endif
-            FS_NAND_OOSGenSto(p_nand_data,
-                              p_nand_data->OOS_BufPtr,
-                              data_blk_ix_logical,
-                              blk_ix_phy,
-                              sec_offset_phy,
-                              sec_offset_phy,
-                              p_err);
-            if (*p_err != FS_ERR_NONE) {
-                return (0u);
-            }
+                FS_NAND_OOSGenSto(p_nand_data,
+                                  p_nand_data->OOS_BufPtr,
+                                  data_blk_ix_logical,
+                                  blk_ix_phy,
+                                  sec_offset_phy,
+                                  sec_offset_phy,
+                                  p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    return (0u);
+                }
 
                                                                 /* ---------------------- WR SEC ---------------------- */
-            ub_ix_logical = FS_NAND_UB_IX_TO_LOG_BLK_IX(p_nand_data, ub_ix);
-            FS_NAND_SecWrHandler(p_nand_data,
-                                 p_src,
-                                 p_nand_data->OOS_BufPtr,
-                                 ub_ix_logical,
-                                 sec_offset_phy,
-                                 p_err);
+                FS_NAND_SecWrHandler(p_nand_data,
+                                     p_src,
+                                     p_nand_data->OOS_BufPtr,
+                                     ub_ix_logical,
+                                     sec_offset_phy,
+                                     p_err);
+                run_wr_cnt = 1u;
+            }
         } while (*p_err == FS_ERR_DEV_OP_ABORTED);
 
         if (*p_err != FS_ERR_NONE) {
             return (wr_cnt);
         }
+
+        while (run_wr_cnt > 0u) {
                                                                 /* ----------------- UPDATE METADATA ------------------ */
                                                                 /* Update sec valid map.                                */
-        p_data = FS_NAND_UB_TblEntryRd(p_nand_data,
-                                       ub_ix);
+            p_data = FS_NAND_UB_TblEntryRd(p_nand_data,
+                                           ub_ix);
 
-        FSUtil_MapBitSet(p_data.SecValidBitMap, sec_offset_phy);
+            FSUtil_MapBitSet(p_data.SecValidBitMap, sec_offset_phy);
 
-        FS_NAND_UB_TblInvalidate(p_nand_data);
+            FS_NAND_UB_TblInvalidate(p_nand_data);
 
 #if (FS_NAND_CFG_UB_TBL_SUBSET_SIZE != 0)
                                                                 /* Update UB mapping tbl.                               */
-        pos_bit_array = sec_offset_phy * p_nand_data->UB_SecMapNbrBits;
+            pos_bit_array = sec_offset_phy * p_nand_data->UB_SecMapNbrBits;
 
-        FS_UTIL_BITMAP_LOC_GET(pos_bit_array, loc_octet_array, loc_bit_octet);
+            FS_UTIL_BITMAP_LOC_GET(pos_bit_array, loc_octet_array, loc_bit_octet);
 
-        sec_subset_ix = sec_offset_phy / FS_NAND_CFG_UB_TBL_SUBSET_SIZE;
+            sec_subset_ix = sec_offset_phy / FS_NAND_CFG_UB_TBL_SUBSET_SIZE;
 
-        FSUtil_ValPack32(p_extra_data->LogicalToPhySecMap,
-                        &loc_octet_array,
-                        &loc_bit_octet,
-                         sec_subset_ix,
-                         p_nand_data->UB_SecMapNbrBits);
+            FSUtil_ValPack32(p_extra_data->LogicalToPhySecMap,
+                            &loc_octet_array,
+                            &loc_bit_octet,
+                             sec_subset_ix,
+                             p_nand_data->UB_SecMapNbrBits);
 #endif
 
 #if (FS_NAND_CFG_UB_META_CACHE_EN == DEF_ENABLED)
                                                                 /* Update UB meta cache.                                */
-        pos_bit_array = sec_offset_phy * (p_nand_data->RUB_MaxAssocLog2 + p_nand_data->NbrSecPerBlkLog2);
+            pos_bit_array = sec_offset_phy * (p_nand_data->RUB_MaxAssocLog2 + p_nand_data->NbrSecPerBlkLog2);
 
-        FS_UTIL_BITMAP_LOC_GET(pos_bit_array, loc_octet_array, loc_bit_octet);
+            FS_UTIL_BITMAP_LOC_GET(pos_bit_array, loc_octet_array, loc_bit_octet);
 
-        FSUtil_ValPack32(p_extra_data->MetaCachePtr,
-                        &loc_octet_array,
-                        &loc_bit_octet,
-                         sec_offset_phy,
-                         p_nand_data->NbrSecPerBlkLog2);
+            FSUtil_ValPack32(p_extra_data->MetaCachePtr,
+                            &loc_octet_array,
+                            &loc_bit_octet,
+                             sec_offset_phy,
+                             p_nand_data->NbrSecPerBlkLog2);
 
-        FSUtil_ValPack32(p_extra_data->MetaCachePtr,
-                        &loc_octet_array,
-                        &loc_bit_octet,
-                         0u,
-                         p_nand_data->RUB_MaxAssocLog2);
+            FSUtil_ValPack32(p_extra_data->MetaCachePtr,
+                            &loc_octet_array,
+                            &loc_bit_octet,
+                             0u,
+                             p_nand_data->RUB_MaxAssocLog2);
 #endif
 
-        sec_offset_phy++;
-        p_extra_data->NextSecIx = sec_offset_phy;
-
-        wr_cnt++;
-        p_src = (void *)((CPU_INT08U *)p_src + p_nand_data->SecSize);
-
+            sec_offset_phy++;
+            p_extra_data->NextSecIx = sec_offset_phy;
 
+            wr_cnt++;
+            p_src = (void *)((CPU_INT08U *)p_src + p_nand_data->SecSize);
+            run_wr_cnt--;
+        }
     }
 
     p_extra_data->ActivityCtr = p_nand_data->ActivityCtr;       /* Assign current activity ctr to UB.                   */
@@ -11228,6 +12506,12 @@ FS_NAND_INTERN  void  FS_NAND_CalcDevInfo (FS_NAND_DATA  *p_nand_data,
 *                   (b) The available blocks table must be located at the beginning of the metadata and
 *                       its size restricted to one sector to make the search for it trivial : it will
 *                       always be contained in the first sector of metadata.
+*
+*               (2) The multi-sector OOS buffer holds the OOS data of up to FS_NAND_CFG_MULTI_SEC_MAX
+*                   sectors. It is only allocated if the controller implements at least one of the optional
+*                   multi-sector operations; multi-sector reads & writes are disabled otherwise.  The
+*                   multi-sector data buffer, allocated with it, gathers the sectors of buffer lists (see
+*                   FS_NAND_RdV() Note #3).
 *********************************************************************************************************
 */
 
@@ -11357,6 +12641,19 @@ FS_NAND_INTERN  void  FS_NAND_AllocDevData (FS_NAND_DATA  *p_nand_data,
     }
 
 
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+    p_nand_data->AvailBlkErasedMap = (CPU_INT08U *)Mem_HeapAlloc(FS_UTIL_BIT_NBR_TO_OCTET_NBR(p_nand_data->AvailBlkTblEntryCntMax),
+                                                                 sizeof(CPU_INT08U),
+                                                                 &octets_reqd,
+                                                                 &alloc_err);
+    if (p_nand_data->AvailBlkErasedMap == DEF_NULL) {
+        FS_NAND_TRACE_DBG(("FS_NAND_AllocDevData(): Could not alloc mem for available blocks erased map: %d octets req'd.\r\n", octets_reqd));
+       *p_err = FS_ERR_MEM_ALLOC;
+        return;
+    }
+#endif
+
+
     p_nand_data->AvailBlkMetaID_Tbl = (FS_NAND_META_ID *)Mem_HeapAlloc(p_nand_data->AvailBlkTblEntryCntMax * sizeof(FS_NAND_META_ID),
                                                                        sizeof(FS_NAND_META_ID),
                                                                        &octets_reqd,
@@ -11396,6 +12693,34 @@ FS_NAND_INTERN  void  FS_NAND_AllocDevData (FS_NAND_DATA  *p_nand_data,
     }
 
 
+                                                                /* ------------- ALLOC MULTI-SEC OOS BUF -------------- */
+    p_nand_data->OOS_MultiBufPtr = DEF_NULL;                    /* See Note #2.                                         */
+    p_nand_data->MultiBufPtr     = DEF_NULL;
+    if ((FS_NAND_CFG_MULTI_SEC_MAX > 1u) &&
+        ((p_nand_data->CtrlrPtr->SecRdMulti != DEF_NULL) ||
+         (p_nand_data->CtrlrPtr->SecWrMulti != DEF_NULL))) {
+        p_nand_data->OOS_MultiBufPtr = Mem_HeapAlloc(sizeof(CPU_INT08U) * p_nand_data->OOS_Size * FS_NAND_CFG_MULTI_SEC_MAX,
+                                                     sizeof(CPU_DATA),
+                                                    &octets_reqd,
+                                                    &alloc_err);
+        if (p_nand_data->OOS_MultiBufPtr == DEF_NULL) {
+            FS_NAND_TRACE_DBG(("FS_NAND_AllocDevData(): Could not alloc mem for multi-sec OOS buf: %d octets req'd.\r\n", octets_reqd));
+           *p_err = FS_ERR_MEM_ALLOC;
+            return;
+        }
+
+        p_nand_data->MultiBufPtr = Mem_HeapAlloc(sizeof(CPU_INT08U) * p_nand_data->SecSize * FS_NAND_CFG_MULTI_SEC_MAX,
+                                                 FS_CFG_BUF_ALIGN_OCTETS,
+                                                &octets_reqd,
+                                                &alloc_err);
+        if (p_nand_data->MultiBufPtr == DEF_NULL) {
+            FS_NAND_TRACE_DBG(("FS_NAND_AllocDevData(): Could not alloc mem for multi-sec data buf: %d octets req'd.\r\n", octets_reqd));
+           *p_err = FS_ERR_MEM_ALLOC;
+            return;
+        }
+    }
+
+
                                                                 /* ------------- ALLOC UB EXTRA DATA TBL -------------- */
     p_nand_data->UB_ExtraDataTbl = (FS_NAND_UB_EXTRA_DATA *)Mem_HeapAlloc(sizeof(FS_NAND_UB_EXTRA_DATA) * p_nand_data->UB_CntMax,
                                                                           sizeof(CPU_DATA),
@@ -11594,6 +12919,15 @@ FS_NAND_INTERN  void  FS_NAND_InitDevData (FS_NAND_DATA  *p_nand_data)
 
                                                                 /* See Note #1.                                         */
     Mem_Set(p_nand_data->AvailBlkMetaMap, 0xFF, FS_UTIL_BIT_NBR_TO_OCTET_NBR(p_nand_data->AvailBlkTblEntryCntMax));
+
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+                                                                /* --------------- INIT BG PROCESSING ----------------- */
+    Mem_Clr(p_nand_data->AvailBlkErasedMap, FS_UTIL_BIT_NBR_TO_OCTET_NBR(p_nand_data->AvailBlkTblEntryCntMax));
+
+    p_nand_data->BgSUB_Ix           = FS_NAND_UB_IX_INVALID;
+    p_nand_data->BgSUB_BlkIxLogical = FS_NAND_BLK_IX_INVALID;
+    p_nand_data->BgSUB_NextSecIx    = 0u;
+#endif
 }
 
 /*
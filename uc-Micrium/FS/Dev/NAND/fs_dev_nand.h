@@ -86,6 +86,22 @@
 *********************************************************************************************************
 */
 
+#ifndef  FS_NAND_CFG_BG_PROC_EN                                 /* Background GC & pre-erase (see FS_NAND_BgProc()).    */
+#define  FS_NAND_CFG_BG_PROC_EN                 DEF_DISABLED
+#endif
+
+#ifndef  FS_NAND_CFG_BG_UB_FREE_MIN                             /* Min nbr of empty UBs kept by bg merges.              */
+#define  FS_NAND_CFG_BG_UB_FREE_MIN                       1u
+#endif
+
+#ifndef  FS_NAND_CFG_BG_SEC_PER_STEP                            /* Max nbr of secs copied per bg SUB merge step.        */
+#define  FS_NAND_CFG_BG_SEC_PER_STEP                      8u
+#endif
+
+#ifndef  FS_NAND_CFG_MULTI_SEC_MAX                              /* Max nbr of secs per multi-sec ctrlr rd/wr op.        */
+#define  FS_NAND_CFG_MULTI_SEC_MAX                       16u
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -99,6 +115,10 @@
 
 #define  FS_NAND_PART_ONFI_PARAM_PAGE_LEN                   256u/* Len of param pg.                                     */
 
+                                                                /* Optional cmds supported by part (ONFI pp bytes 8-9). */
+#define  FS_NAND_PART_OPT_CMD_CACHE_PGM              DEF_BIT_00 /* Page cache program (80h-15h).                        */
+#define  FS_NAND_PART_OPT_CMD_CACHE_RD               DEF_BIT_01 /* Read cache (31h/3Fh).                                */
+
 #define  FS_NAND_CTRS_TBL_SIZE                                4u/* Max nbr of ctrs structs in global tbl.               */
 
 
@@ -173,6 +193,7 @@ struct  fs_nand_part_data {
     FS_NAND_BLK_QTY           MaxBadBlkCnt;                     /* Max nbr of bad blk in dev.                           */
     CPU_INT32U                MaxBlkErase;                      /* Maximum number of erase operations per block.        */
     FS_NAND_FREE_SPARE_DATA  *FreeSpareMap;                     /* Pointer to the map of available bytes in spare area. */
+    CPU_INT08U                OptCmdFlags;                      /* Optional cmds supported (FS_NAND_PART_OPT_CMD_xxx).  */
 
 
     FS_NAND_PART_DATA        *NextPtr;
@@ -244,6 +265,21 @@ typedef  struct  fs_nand_ctrlr_api {
                                         CPU_INT08U         cmd,
                                         void              *p_buf,
                                         FS_ERR            *p_err);
+
+                                                                            /* ------- OPTIONAL MULTI-SEC OPS --------- */
+    FS_SEC_QTY          (*SecRdMulti)  (void              *p_ctrlr_data,    /* Read consecutive secs in same blk.       */
+                                        void              *p_dest,
+                                        void              *p_dest_oos,
+                                        FS_SEC_NBR         sec_ix_phy,
+                                        FS_SEC_QTY         sec_cnt,
+                                        FS_ERR            *p_err);
+
+    FS_SEC_QTY          (*SecWrMulti)  (void              *p_ctrlr_data,    /* Write consecutive secs in same blk.      */
+                                        void              *p_src,
+                                        void              *p_src_oos,
+                                        FS_SEC_NBR         sec_ix_phy,
+                                        FS_SEC_QTY         sec_cnt,
+                                        FS_ERR            *p_err);
 } FS_NAND_CTRLR_API;
 
 
@@ -324,6 +360,9 @@ typedef  struct  fs_nand_ctrs {
     FS_CTR                    StatRUB_PartialMergeCtr;          /* Nbr of RUB partial merges done.                      */
 
     FS_CTR                    StatBlkRefreshCtr;                /* Nbr of blk refreshes done.                           */
+
+    FS_CTR                    StatBgMergeStepCtr;               /* Nbr of bg merge steps done.                          */
+    FS_CTR                    StatBgEraseCtr;                   /* Nbr of avail blks pre-erased in bg.                  */
 #endif
 
 #if (FS_CFG_CTR_ERR_EN == DEF_ENABLED)                          /* --------------------- ERR CTRS --------------------- */
@@ -427,6 +466,11 @@ void         FS_NAND_LowMount  (CPU_CHAR  *p_name_dev,          /* Low-level mou
 void         FS_NAND_LowUnmount(CPU_CHAR  *p_name_dev,          /* Low-level unmount device.                            */
                                 FS_ERR    *p_err);
 
+#if (FS_NAND_CFG_BG_PROC_EN == DEF_ENABLED)
+CPU_BOOLEAN  FS_NAND_BgProc    (CPU_CHAR  *p_name_dev,          /* Perform one step of background processing.           */
+                                FS_ERR    *p_err);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -26,6 +26,9 @@
 * Filename : bsp_fs_dev_nor.c
 * Version  : V4.08.00
 *********************************************************************************************************
+* Note(s)  : (1) 'FSDev_NOR_BSP_QSPI' is optional.  It is used only if the application points the NOR
+*                configuration's 'QSPI_BSP_Ptr' to it; otherwise, it may be removed.
+*********************************************************************************************************
 */
 
 /*
@@ -132,6 +135,21 @@ static  void         FSDev_BSP_SPI_ChipSelDis(FS_QTY       unit_nbr);   /* Dis f
 static  void         FSDev_BSP_SPI_SetClkFreq(FS_QTY       unit_nbr,    /* Set SPI clk freq.                            */
                                               CPU_INT32U   freq);
 
+                                                                        /* -------------- QSPI API FNCTS -------------- */
+static  CPU_INT08U   FSDev_BSP_QSPI_LinesMax (FS_QTY                      unit_nbr);    /* Get nbr of data lines.   */
+
+static  CPU_BOOLEAN  FSDev_BSP_QSPI_Rd       (FS_QTY                      unit_nbr,     /* Rd from QSPI.            */
+                                              const  FS_DEV_NOR_QSPI_CMD *p_cmd,
+                                              void                       *p_dest,
+                                              CPU_SIZE_T                  cnt,
+                                              CPU_SIZE_T                  stride,
+                                              CPU_SIZE_T                  nbr);
+
+static  CPU_BOOLEAN  FSDev_BSP_QSPI_Wr       (FS_QTY                      unit_nbr,     /* Wr to QSPI.              */
+                                              const  FS_DEV_NOR_QSPI_CMD *p_cmd,
+                                              void                       *p_src,
+                                              CPU_SIZE_T                  cnt);
+
 
 /*
 *********************************************************************************************************
@@ -164,6 +182,12 @@ const  FS_DEV_SPI_API  FSDev_NOR_BSP_SPI = {
     FSDev_BSP_SPI_SetClkFreq
 };
 
+const  FS_DEV_NOR_QSPI_API  FSDev_NOR_BSP_QSPI = {              /* See Note #1.                                         */
+    FSDev_BSP_QSPI_LinesMax,
+    FSDev_BSP_QSPI_Rd,
+    FSDev_BSP_QSPI_Wr
+};
+
 
 /*
 *********************************************************************************************************
@@ -431,6 +455,120 @@ static  void  FSDev_BSP_SPI_SetClkFreq (FS_QTY      unit_nbr,
 }
 
 
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                    FILE SYSTEM NOR QSPI FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                      FSDev_BSP_QSPI_LinesMax()
+*
+* Description : Get number of data lines wired between MCU & serial flash.
+*
+* Argument(s) : unit_nbr  Unit number of NOR.
+*
+* Return(s)   : Number of data lines (1, 2 or 4).
+*
+* Note(s)     : (1) The QSPI controller is configured in FSDev_BSP_SPI_Open(); the SPI & QSPI functions
+*                   share the chip select, lock & clock frequency of the unit.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  FSDev_BSP_QSPI_LinesMax (FS_QTY  unit_nbr)
+{
+    (void)unit_nbr;
+
+    return (1u);                                                /* $$$$ RTN NBR OF DATA LINES WIRED.                    */
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FSDev_BSP_QSPI_Rd()
+*
+* Description : Issue command & read strided chunks from QSPI.
+*
+* Argument(s) : unit_nbr  Unit number of NOR.
+*
+*               p_cmd     Pointer to command description.
+*
+*               p_dest    Pointer to destination memory buffer.
+*
+*               cnt       Number of octets in each chunk.
+*
+*               stride    Distance between the start of consecutive chunks on the flash, in octets.
+*
+*               nbr       Number of chunks.
+*
+* Return(s)   : DEF_OK,   if the transfer completed.
+*               DEF_FAIL, otherwise.
+*
+* Note(s)     : (1) The whole transfer MUST be one transaction, with the chip select asserted from the
+*                   instruction to the last octet of the last chunk.  The 'stride - cnt' octets between
+*                   chunks are clocked in & discarded, e.g., with a scatter-gather DMA descriptor per
+*                   chunk or a dummy descriptor.  See 'fs_dev_nor.h  NOR FLASH DEVICE QSPI BSP API DATA
+*                   TYPES  Note #3b'.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FSDev_BSP_QSPI_Rd (FS_QTY                      unit_nbr,
+                                        const  FS_DEV_NOR_QSPI_CMD *p_cmd,
+                                        void                       *p_dest,
+                                        CPU_SIZE_T                  cnt,
+                                        CPU_SIZE_T                  stride,
+                                        CPU_SIZE_T                  nbr)
+{
+    (void)unit_nbr;
+    (void)p_cmd;
+    (void)p_dest;
+    (void)cnt;
+    (void)stride;
+    (void)nbr;
+
+    return (DEF_FAIL);                                          /* $$$$ ISSUE CMD & START DMA RX.                       */
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FSDev_BSP_QSPI_Wr()
+*
+* Description : Issue command & write data to QSPI.
+*
+* Argument(s) : unit_nbr  Unit number of NOR.
+*
+*               p_cmd     Pointer to command description.
+*
+*               p_src     Pointer to source memory buffer.
+*
+*               cnt       Number of octets to write.
+*
+* Return(s)   : DEF_OK,   if the transfer completed.
+*               DEF_FAIL, otherwise.
+*
+* Note(s)     : (1) The data phase should be handed to the QSPI controller or a DMA channel as a single
+*                   burst.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FSDev_BSP_QSPI_Wr (FS_QTY                      unit_nbr,
+                                        const  FS_DEV_NOR_QSPI_CMD *p_cmd,
+                                        void                       *p_src,
+                                        CPU_SIZE_T                  cnt)
+{
+    (void)unit_nbr;
+    (void)p_cmd;
+    (void)p_src;
+    (void)cnt;
+
+    return (DEF_FAIL);                                          /* $$$$ ISSUE CMD & START DMA TX.                       */
+}
+
+
 /*
 *********************************************************************************************************
 *                                    FSDev_NOR_BSP_SPI_WaitWhileBusy()
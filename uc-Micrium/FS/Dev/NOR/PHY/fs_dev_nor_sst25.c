@@ -55,6 +55,12 @@
 *                (b) Revision B devices can also be erased on 64 kB block basis.
 *
 *                (c) Revision B devices support a command to read a JEDEC-compatible ID.
+*
+*            (3) If a QSPI BSP is configured (see 'fs_dev_nor.h  NOR FLASH DEVICE CONFIGURATION DATA TYPE
+*                Note #1j'), each read is issued as one BSP burst.  SST25VF064C devices also program
+*                each page with one burst &, if wired with 2 or more lines, use dual output fast read
+*                (3Bh) & dual input page program (A2h).  AAI programming (revision A & B devices) sends
+*                a command for every byte or word & is left on the SPI BSP.
 *********************************************************************************************************
 */
 
@@ -113,6 +119,8 @@
 #define  FS_DEV_NOR_PHY_MAX_FREQ_NORMAL             25000000uL
 #define  FS_DEV_NOR_PHY_MAX_FREQ_FAST               50000000uL
 
+#define  FS_DEV_NOR_PHY_FAST_RD_DUMMY_CYCLES               8u   /* Dummy clks after addr of FAST_RD & FAST_RD_DUAL_OUT. */
+
 
                                                                 /* ------------------- DEVICE FAMILY ------------------ */
 #define  FS_DEV_NOR_PHY_FAMILY_NONE                        0u
@@ -302,6 +310,14 @@ static  void         FSDev_NOR_PHY_IO_Ctrl  (FS_DEV_NOR_PHY_DATA  *p_phy_data,
                                              void                 *p_data,
                                              FS_ERR               *p_err);
 
+static  void         FSDev_NOR_PHY_RdMulti  (FS_DEV_NOR_PHY_DATA  *p_phy_data,      /* Rd strided chunks from NOR dev.  */
+                                             void                 *p_dest,
+                                             CPU_INT32U            start,
+                                             CPU_INT32U            cnt,
+                                             CPU_INT32U            stride,
+                                             CPU_INT32U            nbr,
+                                             FS_ERR               *p_err);
+
 
                                                                                     /* ---------- LOCAL FNCTS --------- */
 static  void         FSDev_NOR_PHY_EraseChip(FS_DEV_NOR_PHY_DATA  *p_phy_data,      /* Erase NOR device.                */
@@ -325,6 +341,11 @@ static  void         FSDev_NOR_PHY_WrBuf    (FS_DEV_NOR_PHY_DATA  *p_phy_data,
                                              CPU_INT32U            cnt,
                                              FS_ERR               *p_err);
 
+static  CPU_BOOLEAN  FSDev_NOR_PHY_PgmPage  (FS_DEV_NOR_PHY_DATA  *p_phy_data,      /* Issue page pgm cmd & data.       */
+                                             void                 *p_src,
+                                             CPU_INT32U            addr,
+                                             CPU_INT32U            cnt);
+
 static  CPU_BOOLEAN  FSDev_NOR_PHY_WaitErase(FS_DEV_NOR_PHY_DATA  *p_phy_data);     /* Wait while dev erase.            */
 
 static  CPU_BOOLEAN  FSDev_NOR_PHY_WaitWr   (FS_DEV_NOR_PHY_DATA  *p_phy_data);     /* Wait while dev wr.               */
@@ -343,7 +364,8 @@ const  FS_DEV_NOR_PHY_API  FSDev_NOR_SST25 = {
     FSDev_NOR_PHY_Rd,
     FSDev_NOR_PHY_Wr,
     FSDev_NOR_PHY_EraseBlk,
-    FSDev_NOR_PHY_IO_Ctrl
+    FSDev_NOR_PHY_IO_Ctrl,
+    FSDev_NOR_PHY_RdMulti
 };
 
 
@@ -393,6 +415,9 @@ const  FS_DEV_NOR_PHY_API  FSDev_NOR_SST25 = {
 *                   (d) 'UnitNbr' is the unit number of the NOR device.
 *
 *                   (e) 'MaxClkFreq' specifies the maximum SPI clock frequency.
+*
+*                   (f) 'QSPI_BSP_Ptr' MAY point to a QSPI BSP; 'Caps' MUST then be assigned the
+*                       capabilities available with the lines wired.  See 'fs_dev_nor_sst25.c  Note #3'.
 *********************************************************************************************************
 */
 
@@ -405,6 +430,7 @@ static  void  FSDev_NOR_PHY_Open (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     CPU_INT08U   id_manuf;
     CPU_INT16U   id_dev;
     CPU_INT08U   instr[4];
+    CPU_INT08U   lines;
     CPU_BOOLEAN  ok;
 
 
@@ -500,6 +526,20 @@ static  void  FSDev_NOR_PHY_Open (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     p_phy_data->BlkSize         =  FSDev_NOR_PHY_DevTbl[desc_nbr].BlkSize;
     p_phy_data->AddrRegionStart =  0u;
     p_phy_data->DataPtr         = (void *)&FSDev_NOR_PHY_DevTbl[desc_nbr];          /* Save SST SST25 desc.             */
+
+
+                                                                /* ------------------- GET PHY CAPS ------------------- */
+    if (p_phy_data->QSPI_BSP_Ptr != DEF_NULL) {                 /* See Note #1f.                                        */
+        DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_MULTI);
+        if (FSDev_NOR_PHY_DevTbl[desc_nbr].Family == FS_DEV_NOR_PHY_FAMILY_SST25C) {
+            lines = p_phy_data->QSPI_BSP_Ptr->LinesMax(p_phy_data->UnitNbr);
+            DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_WR_BURST);
+            if (lines >= 2u) {
+                DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_DUAL | FS_DEV_NOR_PHY_CAP_WR_DUAL);
+            }
+        }
+    }
+
    *p_err = FS_ERR_NONE;
 }
 
@@ -547,7 +587,7 @@ static  void  FSDev_NOR_PHY_Close (FS_DEV_NOR_PHY_DATA  *p_phy_data)
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) With a QSPI BSP, the read is issued as a single chunk by FSDev_NOR_PHY_RdMulti().
 *********************************************************************************************************
 */
 
@@ -560,6 +600,11 @@ static  void  FSDev_NOR_PHY_Rd (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     CPU_INT08U  instr[5];
 
 
+    if (p_phy_data->QSPI_BSP_Ptr != DEF_NULL) {                 /* See Note #1.                                         */
+        FSDev_NOR_PHY_RdMulti(p_phy_data, p_dest, start, cnt, cnt, 1u, p_err);
+        return;
+    }
+
                                                                 /* ---------------------- RD DEV ---------------------- */
     instr[0] =  FS_DEV_NOR_PHY_INSTR_FAST_RD;
     instr[1] = (CPU_INT08U)((start >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
@@ -780,6 +825,75 @@ static  void  FSDev_NOR_PHY_IO_Ctrl (FS_DEV_NOR_PHY_DATA  *p_phy_data,
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FSDev_NOR_PHY_RdMulti()
+*
+* Description : Read strided chunks from a NOR device & store them contiguously in buffer.
+*
+* Argument(s) : p_phy_data  Pointer to NOR phy data.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               start       Start address of first chunk (relative to start of device).
+*
+*               cnt         Number of octets in each chunk.
+*
+*               stride      Distance between the start addresses of consecutive chunks, in octets.
+*
+*               nbr         Number of chunks to read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE           Octets read successfully.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Only called if a QSPI BSP is configured (FS_DEV_NOR_PHY_CAP_RD_MULTI set).
+*
+*               (2) The device streams data from consecutive addresses as long as the clock runs, so the
+*                   whole run is read with one command; the BSP discards the octets between chunks.
+*********************************************************************************************************
+*/
+
+static  void  FSDev_NOR_PHY_RdMulti (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                                     void                 *p_dest,
+                                     CPU_INT32U            start,
+                                     CPU_INT32U            cnt,
+                                     CPU_INT32U            stride,
+                                     CPU_INT32U            nbr,
+                                     FS_ERR               *p_err)
+{
+    FS_DEV_NOR_QSPI_CMD  cmd;
+    CPU_BOOLEAN          ok;
+
+
+                                                                /* ------------------ SEL FAST RD CMD ----------------- */
+    if (DEF_BIT_IS_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_DUAL) == DEF_YES) {
+        cmd.Instr     = FS_DEV_NOR_PHY_INSTR_FAST_RD_DUAL_OUT;
+        cmd.DataLines = 2u;
+    } else {
+        cmd.Instr     = FS_DEV_NOR_PHY_INSTR_FAST_RD;
+        cmd.DataLines = 1u;
+    }
+    cmd.AddrLen     = 3u;
+    cmd.AddrLines   = 1u;
+    cmd.DummyCycles = FS_DEV_NOR_PHY_FAST_RD_DUMMY_CYCLES;
+    cmd.Addr        = start;
+
+                                                                /* ---------------------- RD DEV ---------------------- */
+    ok = p_phy_data->QSPI_BSP_Ptr->Rd(p_phy_data->UnitNbr,      /* See Note #2.                                         */
+                                      &cmd,
+                                      p_dest,
+                                      (CPU_SIZE_T)cnt,
+                                      (CPU_SIZE_T)stride,
+                                      (CPU_SIZE_T)nbr);
+
+   *p_err = (ok == DEF_OK) ? FS_ERR_NONE : FS_ERR_DEV_IO;
+}
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -1065,7 +1179,7 @@ static  void  FSDev_NOR_PHY_WrWord (FS_DEV_NOR_PHY_DATA  *p_phy_data,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) Each page program is issued by FSDev_NOR_PHY_PgmPage().
 *********************************************************************************************************
 */
 
@@ -1079,9 +1193,9 @@ static  void  FSDev_NOR_PHY_WrBuf (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     CPU_INT32U   start_page_byte_nbr;
     CPU_INT32U   addr;
     CPU_INT08U  *p_src_08;
-    CPU_INT08U   instr[4];
     CPU_INT08U   cmd;
     CPU_BOOLEAN  busy;
+    CPU_BOOLEAN  ok;
 
 
                                                                 /* ------------------ START PGM PAGE ------------------ */
@@ -1097,20 +1211,14 @@ static  void  FSDev_NOR_PHY_WrBuf (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     cmd = FS_DEV_NOR_PHY_INSTR_WREN;
     FS_DEV_NOR_PHY_CMD(p_phy_data, &cmd, 1u);
 
-                                                                /* Gather cmd & start addr.                             */
-    instr[0]  =  FS_DEV_NOR_PHY_INSTR_PAGE_PGM;
-    instr[1]  = (CPU_INT08U)((addr >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-    instr[2]  = (CPU_INT08U)((addr >> (1u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-    instr[3]  = (CPU_INT08U)((addr >> (0u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-
-                                                                /* Wr cmd & start addr.                                 */
-    FSDev_NOR_BSP_SPI.ChipSelEn(p_phy_data->UnitNbr);
-    FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, instr, 4u);
                                                                 /* --------------- WR FIRST PARTIAL PAGE -------------- */
-
-                                                                /* Wr data to first page.                               */
-    FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, p_src_08, start_page_byte_nbr);
-    FSDev_NOR_BSP_SPI.ChipSelDis(p_phy_data->UnitNbr);
+    ok = FSDev_NOR_PHY_PgmPage(p_phy_data, p_src_08, addr, start_page_byte_nbr);
+    if (ok != DEF_OK) {
+        cmd = FS_DEV_NOR_PHY_INSTR_WRDI;
+        FS_DEV_NOR_PHY_CMD(p_phy_data, &cmd, 1u);
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
 
     busy = FSDev_NOR_PHY_WaitWr(p_phy_data);                    /* Wait during wr        ...                            */
     if (busy == DEF_YES) {                                      /* ... if dev still busy ...                            */
@@ -1124,21 +1232,17 @@ static  void  FSDev_NOR_PHY_WrBuf (FS_DEV_NOR_PHY_DATA  *p_phy_data,
 
                                                                 /* -------------- WR FOLLOWING FULL PAGES ------------- */
     while (cnt >= 256){
-                                                                /* Fmt addr.                                            */
-        instr[1]  = (CPU_INT08U)((addr >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-        instr[2]  = (CPU_INT08U)((addr >> (1u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-        instr[3]  = (CPU_INT08U)((addr >> (0u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-
                                                                 /* Wr en.                                               */
         cmd = FS_DEV_NOR_PHY_INSTR_WREN;
         FS_DEV_NOR_PHY_CMD(p_phy_data, &cmd, 1u);
-
-                                                                /* Wr cmd & addr.                                       */
-        FSDev_NOR_BSP_SPI.ChipSelEn(p_phy_data->UnitNbr);
-        FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, instr, 4u);
                                                                 /* Wr 256 bytes.                                        */
-        FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, p_src_08, 256u);
-        FSDev_NOR_BSP_SPI.ChipSelDis(p_phy_data->UnitNbr);
+        ok = FSDev_NOR_PHY_PgmPage(p_phy_data, p_src_08, addr, 256u);
+        if (ok != DEF_OK) {
+            cmd = FS_DEV_NOR_PHY_INSTR_WRDI;
+            FS_DEV_NOR_PHY_CMD(p_phy_data, &cmd, 1u);
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
 
         busy = FSDev_NOR_PHY_WaitWr(p_phy_data);                /* Wait during wr        ...                            */
         if (busy == DEF_YES) {                                  /* ... if dev still busy ...                            */
@@ -1152,21 +1256,17 @@ static  void  FSDev_NOR_PHY_WrBuf (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     }
                                                                 /* --------------- WR FINAL PARTIAL PAGE -------------- */
     if (cnt > 0)
-    {                                                           /* Fmt addr.                                            */
-        instr[1]  = (CPU_INT08U)((addr >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-        instr[2]  = (CPU_INT08U)((addr >> (1u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-        instr[3]  = (CPU_INT08U)((addr >> (0u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-
-                                                                /* Wr en.                                               */
+    {                                                           /* Wr en.                                               */
         cmd = FS_DEV_NOR_PHY_INSTR_WREN;
         FS_DEV_NOR_PHY_CMD(p_phy_data, &cmd, 1u);
-
-                                                                /* Wr cmd & addr.                                       */
-        FSDev_NOR_BSP_SPI.ChipSelEn(p_phy_data->UnitNbr);
-        FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, instr, 4u);
                                                                 /* Wr rem bytes.                                        */
-        FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, p_src_08, cnt);
-        FSDev_NOR_BSP_SPI.ChipSelDis(p_phy_data->UnitNbr);
+        ok = FSDev_NOR_PHY_PgmPage(p_phy_data, p_src_08, addr, cnt);
+        if (ok != DEF_OK) {
+            cmd = FS_DEV_NOR_PHY_INSTR_WRDI;
+            FS_DEV_NOR_PHY_CMD(p_phy_data, &cmd, 1u);
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
 
         busy = FSDev_NOR_PHY_WaitWr(p_phy_data);                /* Wait during wr        ...                            */
         if (busy == DEF_YES) {                                  /* ... if dev still busy ...                            */
@@ -1183,6 +1283,74 @@ static  void  FSDev_NOR_PHY_WrBuf (FS_DEV_NOR_PHY_DATA  *p_phy_data,
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FSDev_NOR_PHY_PgmPage()
+*
+* Description : Issue page program command, address & data to a NOR device.
+*
+* Argument(s) : p_phy_data  Pointer to NOR phy data.
+*
+*               p_src       Pointer to source buffer.
+*
+*               addr        Start address of program (relative to start of device).
+*
+*               cnt         Number of octets to program (MUST NOT cross a page boundary).
+*
+* Return(s)   : DEF_OK,   if the program was issued.
+*               DEF_FAIL, otherwise.
+*
+* Note(s)     : (1) With a QSPI BSP, the instruction & the data are issued as one burst, with dual input
+*                   page program (A2h) if available.  See 'fs_dev_nor_sst25.c  Note #3'.
+*
+*               (2) The caller MUST have enabled writes & MUST wait for the program to complete.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FSDev_NOR_PHY_PgmPage (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                                            void                 *p_src,
+                                            CPU_INT32U            addr,
+                                            CPU_INT32U            cnt)
+{
+    FS_DEV_NOR_QSPI_CMD  cmd_qspi;
+    CPU_INT08U           instr[4];
+    CPU_BOOLEAN          ok;
+
+
+    if (p_phy_data->QSPI_BSP_Ptr != DEF_NULL) {                 /* See Note #1.                                         */
+        if (DEF_BIT_IS_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_WR_DUAL) == DEF_YES) {
+            cmd_qspi.Instr     = FS_DEV_NOR_PHY_INSTR_DUAL_IN_PAGE_PGM;
+            cmd_qspi.DataLines = 2u;
+        } else {
+            cmd_qspi.Instr     = FS_DEV_NOR_PHY_INSTR_PAGE_PGM;
+            cmd_qspi.DataLines = 1u;
+        }
+        cmd_qspi.AddrLen     = 3u;
+        cmd_qspi.AddrLines   = 1u;
+        cmd_qspi.DummyCycles = 0u;
+        cmd_qspi.Addr        = addr;
+
+        ok = p_phy_data->QSPI_BSP_Ptr->Wr(p_phy_data->UnitNbr, &cmd_qspi, p_src, (CPU_SIZE_T)cnt);
+        return (ok);
+    }
+
+                                                                /* Gather cmd & start addr.                             */
+    instr[0]  =  FS_DEV_NOR_PHY_INSTR_PAGE_PGM;
+    instr[1]  = (CPU_INT08U)((addr >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
+    instr[2]  = (CPU_INT08U)((addr >> (1u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
+    instr[3]  = (CPU_INT08U)((addr >> (0u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
+
+                                                                /* Wr cmd & start addr.                                 */
+    FSDev_NOR_BSP_SPI.ChipSelEn(p_phy_data->UnitNbr);
+    FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, instr, 4u);
+                                                                /* Wr data.                                             */
+    FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, p_src, cnt);
+    FSDev_NOR_BSP_SPI.ChipSelDis(p_phy_data->UnitNbr);
+
+    return (DEF_OK);
+}
+
+
 /*
 *********************************************************************************************************
 *                                       FSDev_NOR_PHY_WaitWr()
@@ -55,6 +55,11 @@
 *
 *                (d) M45PE-series devices are programmed on a page (256 B) basis & erased on a sector
 *                    (64 KB) basis.
+*
+*            (3) If a QSPI BSP is configured (see 'fs_dev_nor.h  NOR FLASH DEVICE CONFIGURATION DATA TYPE
+*                Note #1j'), each read & each page program is issued as one BSP burst.  M25PX-series
+*                devices wired with 2 or more lines then use dual output fast read (3Bh) & dual input
+*                fast program (A2h).
 *********************************************************************************************************
 */
 
@@ -114,6 +119,8 @@
 
 #define  FS_DEV_NOR_PHY_MAX_FREQ_NORMAL             25000000uL
 
+#define  FS_DEV_NOR_PHY_FAST_READ_DUMMY_CYCLES             8u   /* Dummy clks after addr of FAST_READ & DOFR.           */
+
 
                                                                 /* ------------------- DEVICE FAMILY ------------------ */
 #define  FS_DEV_NOR_PHY_FAMILY_NONE                        0u
@@ -307,6 +314,14 @@ static  void  FSDev_NOR_PHY_IO_Ctrl  (FS_DEV_NOR_PHY_DATA  *p_phy_data,     /* P
                                       void                 *p_data,
                                       FS_ERR               *p_err);
 
+static  void  FSDev_NOR_PHY_RdMulti  (FS_DEV_NOR_PHY_DATA  *p_phy_data,     /* Read strided chunks from NOR device.     */
+                                      void                 *p_dest,
+                                      CPU_INT32U            start,
+                                      CPU_INT32U            cnt,
+                                      CPU_INT32U            stride,
+                                      CPU_INT32U            nbr,
+                                      FS_ERR               *p_err);
+
 
                                                                             /* -------------- LOCAL FNCTS ------------- */
 static  void  FSDev_NOR_PHY_EraseChip(FS_DEV_NOR_PHY_DATA  *p_phy_data,     /* Erase NOR device.                        */
@@ -330,7 +345,8 @@ const  FS_DEV_NOR_PHY_API  FSDev_NOR_STM25 = {
     FSDev_NOR_PHY_Rd,
     FSDev_NOR_PHY_Wr,
     FSDev_NOR_PHY_EraseBlk,
-    FSDev_NOR_PHY_IO_Ctrl
+    FSDev_NOR_PHY_IO_Ctrl,
+    FSDev_NOR_PHY_RdMulti
 };
 
 
@@ -380,6 +396,9 @@ const  FS_DEV_NOR_PHY_API  FSDev_NOR_STM25 = {
 *                   (d) 'UnitNbr' is the unit number of the NOR device.
 *
 *                   (e) 'MaxClkFreq' specifies the maximum SPI clock frequency.
+*
+*                   (f) 'QSPI_BSP_Ptr' MAY point to a QSPI BSP; 'Caps' MUST then be assigned the
+*                       capabilities available with the lines wired.  See 'fs_dev_nor_stm25.c  Note #3'.
 *********************************************************************************************************
 */
 
@@ -392,6 +411,7 @@ static  void  FSDev_NOR_PHY_Open (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     CPU_INT08U   id_manuf;
     CPU_INT16U   id_dev;
     CPU_INT08U   instr;
+    CPU_INT08U   lines;
     CPU_BOOLEAN  ok;
 
 
@@ -469,6 +489,18 @@ static  void  FSDev_NOR_PHY_Open (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     p_phy_data->BlkSize         =  FSDev_NOR_PHY_DevTbl[desc_nbr].BlkSize;
     p_phy_data->AddrRegionStart =  0u;
     p_phy_data->DataPtr         = (void *)&FSDev_NOR_PHY_DevTbl[desc_nbr];      /* Save ST M25 desc.                    */
+
+
+                                                                /* ------------------- GET PHY CAPS ------------------- */
+    if (p_phy_data->QSPI_BSP_Ptr != DEF_NULL) {                 /* See Note #1f.                                        */
+        lines = p_phy_data->QSPI_BSP_Ptr->LinesMax(p_phy_data->UnitNbr);
+        DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_MULTI | FS_DEV_NOR_PHY_CAP_WR_BURST);
+        if ((lines                                >= 2u) &&
+            (FSDev_NOR_PHY_DevTbl[desc_nbr].Family == FS_DEV_NOR_PHY_FAMILY_M25PX)) {
+            DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_DUAL | FS_DEV_NOR_PHY_CAP_WR_DUAL);
+        }
+    }
+
    *p_err = FS_ERR_NONE;
 }
 
@@ -516,7 +548,7 @@ static  void  FSDev_NOR_PHY_Close (FS_DEV_NOR_PHY_DATA  *p_phy_data)
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) With a QSPI BSP, the read is issued as a single chunk by FSDev_NOR_PHY_RdMulti().
 *********************************************************************************************************
 */
 
@@ -529,6 +561,11 @@ static  void  FSDev_NOR_PHY_Rd (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     CPU_INT08U  instr[5];
 
 
+    if (p_phy_data->QSPI_BSP_Ptr != DEF_NULL) {                 /* See Note #1.                                         */
+        FSDev_NOR_PHY_RdMulti(p_phy_data, p_dest, start, cnt, cnt, 1u, p_err);
+        return;
+    }
+
                                                                 /* ---------------------- RD DEV ---------------------- */
     instr[0] =  FS_DEV_NOR_PHY_INSTR_FAST_READ;
     instr[1] = (CPU_INT08U)((start >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
@@ -812,6 +849,75 @@ static  void  FSDev_NOR_PHY_IO_Ctrl (FS_DEV_NOR_PHY_DATA  *p_phy_data,
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FSDev_NOR_PHY_RdMulti()
+*
+* Description : Read strided chunks from a NOR device & store them contiguously in buffer.
+*
+* Argument(s) : p_phy_data  Pointer to NOR phy data.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               start       Start address of first chunk (relative to start of device).
+*
+*               cnt         Number of octets in each chunk.
+*
+*               stride      Distance between the start addresses of consecutive chunks, in octets.
+*
+*               nbr         Number of chunks to read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE           Octets read successfully.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Only called if a QSPI BSP is configured (FS_DEV_NOR_PHY_CAP_RD_MULTI set).
+*
+*               (2) The device streams data from consecutive addresses as long as the clock runs, so the
+*                   whole run is read with one command; the BSP discards the octets between chunks.
+*********************************************************************************************************
+*/
+
+static  void  FSDev_NOR_PHY_RdMulti (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                                     void                 *p_dest,
+                                     CPU_INT32U            start,
+                                     CPU_INT32U            cnt,
+                                     CPU_INT32U            stride,
+                                     CPU_INT32U            nbr,
+                                     FS_ERR               *p_err)
+{
+    FS_DEV_NOR_QSPI_CMD  cmd;
+    CPU_BOOLEAN          ok;
+
+
+                                                                /* ------------------ SEL FAST RD CMD ----------------- */
+    if (DEF_BIT_IS_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_DUAL) == DEF_YES) {
+        cmd.Instr     = FS_DEV_NOR_PHY_INSTR_DOFR;
+        cmd.DataLines = 2u;
+    } else {
+        cmd.Instr     = FS_DEV_NOR_PHY_INSTR_FAST_READ;
+        cmd.DataLines = 1u;
+    }
+    cmd.AddrLen     = 3u;
+    cmd.AddrLines   = 1u;
+    cmd.DummyCycles = FS_DEV_NOR_PHY_FAST_READ_DUMMY_CYCLES;
+    cmd.Addr        = start;
+
+                                                                /* ---------------------- RD DEV ---------------------- */
+    ok = p_phy_data->QSPI_BSP_Ptr->Rd(p_phy_data->UnitNbr,      /* See Note #2.                                         */
+                                      &cmd,
+                                      p_dest,
+                                      (CPU_SIZE_T)cnt,
+                                      (CPU_SIZE_T)stride,
+                                      (CPU_SIZE_T)nbr);
+
+   *p_err = (ok == DEF_OK) ? FS_ERR_NONE : FS_ERR_DEV_IO;
+}
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -931,7 +1037,8 @@ static  void  FSDev_NOR_PHY_EraseChip (FS_DEV_NOR_PHY_DATA  *p_phy_data,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) With a QSPI BSP, the instruction & the data are issued as one burst, with dual input
+*                   fast program (A2h) if available.  See 'fs_dev_nor_stm25.c  Note #3'.
 *********************************************************************************************************
 */
 
@@ -941,10 +1048,12 @@ static  void  FSDev_NOR_PHY_WrPage (FS_DEV_NOR_PHY_DATA  *p_phy_data,
                                     CPU_INT32U            cnt,
                                     FS_ERR               *p_err)
 {
-    CPU_INT08U   instr[4];
-    CPU_INT08U   sr;
-    CPU_INT32U   timeout;
-    CPU_BOOLEAN  done;
+    CPU_INT08U           instr[4];
+    CPU_INT08U           sr;
+    CPU_INT32U           timeout;
+    CPU_BOOLEAN          done;
+    FS_DEV_NOR_QSPI_CMD  cmd_qspi;
+    CPU_BOOLEAN          ok;
 
 
 
@@ -965,15 +1074,37 @@ static  void  FSDev_NOR_PHY_WrPage (FS_DEV_NOR_PHY_DATA  *p_phy_data,
 
 
                                                                 /* ---------------------- WR DEV ---------------------- */
-    instr[0] =  FS_DEV_NOR_PHY_INSTR_PP;
-    instr[1] = (CPU_INT08U)((start >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-    instr[2] = (CPU_INT08U)((start >> (1u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-    instr[3] = (CPU_INT08U)((start >> (0u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-
-    FSDev_NOR_BSP_SPI.ChipSelEn(p_phy_data->UnitNbr);           /* En chip sel.                                         */
-    FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, &instr[0], 4u);   /* Wr cmd.                                              */
-    FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr,  p_src, cnt);     /* Wr data.                                             */
-    FSDev_NOR_BSP_SPI.ChipSelDis(p_phy_data->UnitNbr);          /* Dis chip sel.                                        */
+    if (p_phy_data->QSPI_BSP_Ptr != DEF_NULL) {                 /* See Note #1.                                         */
+        if (DEF_BIT_IS_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_WR_DUAL) == DEF_YES) {
+            cmd_qspi.Instr     = FS_DEV_NOR_PHY_INSTR_DIFP;
+            cmd_qspi.DataLines = 2u;
+        } else {
+            cmd_qspi.Instr     = FS_DEV_NOR_PHY_INSTR_PP;
+            cmd_qspi.DataLines = 1u;
+        }
+        cmd_qspi.AddrLen     = 3u;
+        cmd_qspi.AddrLines   = 1u;
+        cmd_qspi.DummyCycles = 0u;
+        cmd_qspi.Addr        = start;
+
+        ok = p_phy_data->QSPI_BSP_Ptr->Wr(p_phy_data->UnitNbr, &cmd_qspi, p_src, (CPU_SIZE_T)cnt);
+        if (ok != DEF_OK) {
+            instr[0] = FS_DEV_NOR_PHY_INSTR_WRDI;
+            FS_DEV_NOR_PHY_CMD(p_phy_data, &instr[0], 1u);      /* Wr cmd.                                              */
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
+    } else {
+        instr[0] =  FS_DEV_NOR_PHY_INSTR_PP;
+        instr[1] = (CPU_INT08U)((start >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
+        instr[2] = (CPU_INT08U)((start >> (1u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
+        instr[3] = (CPU_INT08U)((start >> (0u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
+
+        FSDev_NOR_BSP_SPI.ChipSelEn(p_phy_data->UnitNbr);                           /* En chip sel.                     */
+        FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, &instr[0], 4u);                   /* Wr cmd.                          */
+        FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr,  p_src, cnt);                     /* Wr data.                         */
+        FSDev_NOR_BSP_SPI.ChipSelDis(p_phy_data->UnitNbr);                          /* Dis chip sel.                    */
+    }
 
 
 
@@ -30,6 +30,12 @@
 *
 *                    Winbond W25Q80BL/DL/DV
 *                    Winbond W25Q16JV
+*
+*            (2) If a QSPI BSP is configured (see 'fs_dev_nor.h  NOR FLASH DEVICE CONFIGURATION DATA TYPE
+*                Note #1j'), reads use the widest fast read wired (6Bh on 4 lines, 3Bh on 2 lines, 0Bh
+*                otherwise) & page programs use Quad Input Page Program (32h) on 4 lines, each issued
+*                as one BSP burst.  The Quad Enable bit (QE) of status register 2 is then set upon open,
+*                which disables the /WP & /HOLD functions of IO2 & IO3.
 *********************************************************************************************************
 */
 
@@ -83,6 +89,7 @@
 #define  FS_DEV_NOR_PHY_MAX_CHIP_ERASE_ms              6000u
 
 #define  FS_DEV_NOR_W25Q_DUMMY_BYTE                    0xA5u    /* See Note #2                                          */
+#define  FS_DEV_NOR_W25Q_DUMMY_CYCLES                     8u    /* See Note #2                                          */
 
 #define  FS_DEV_NOR_PHY_BLK_SIZE_32K             ( 32u * 1024u)
 #define  FS_DEV_NOR_PHY_BLK_SIZE_64K             ( 64u * 1024u)
@@ -97,11 +104,14 @@
 */
                                                                 /* ------------------ READ COMMANDS ------------------- */
 #define  FS_DEV_NOR_PHY_CMD_FAST_READ                   0x0Bu   /* Fast Read                                            */
+#define  FS_DEV_NOR_PHY_CMD_FAST_READ_DUAL_OUT          0x3Bu   /* Fast Read Dual Output                                */
+#define  FS_DEV_NOR_PHY_CMD_FAST_READ_QUAD_OUT          0x6Bu   /* Fast Read Quad Output                                */
                                                                 /* ------------- PROGRAM & ERASE COMMANDS ------------- */
 #define  FS_DEV_NOR_PHY_CMD_BLK_ERASE_32K               0x52u   /* Block Erase (32-KBytes).                             */
 #define  FS_DEV_NOR_PHY_CMD_BLK_ERASE_64K               0xD8u   /* Block Erase (64-KBytes).                             */
 #define  FS_DEV_NOR_PHY_CMD_CHIP_ERASE                  0xC7u   /* Chip erase cmd 2.                                    */
 #define  FS_DEV_NOR_PHY_CMD_PAGE_PGM                    0x02u   /* Byte/Page program (1 - 256 bytes).                   */
+#define  FS_DEV_NOR_PHY_CMD_QUAD_PAGE_PGM               0x32u   /* Quad Input Page program (1 - 256 bytes).             */
                                                                 /* ---------------- PROTECTION COMMANDS --------------- */
 #define  FS_DEV_NOR_PHY_CMD_WRITE_EN                    0x06u   /* Write enable.                                        */
 #define  FS_DEV_NOR_PHY_CMD_WRITE_DIS                   0x04u   /* Write disable.                                       */
@@ -109,6 +119,7 @@
                                                                 /* ------------- STATUS REGISTER COMMANDS ------------- */
 #define  FS_DEV_NOR_PHY_CMD_STATUS_REG_READ             0x05u   /* Read status register.                                */
 #define  FS_DEV_NOR_PHY_CMD_STATUS_REG_WRITE            0x01u   /* Write status register byte 1.                        */
+#define  FS_DEV_NOR_PHY_CMD_STATUS_REG2_READ            0x35u   /* Read status register 2.                              */
                                                                 /* -------------- MISCELLANEOUS COMMANDS -------------- */
 #define  FS_DEV_NOR_PHY_CMD_RD_JEDEC_ID                 0x9Fu   /* Manufacturer and Device ID Read.                     */
 
@@ -126,6 +137,8 @@
 #define  FS_DEV_NOR_PHY_SR_SEC            DEF_BIT_06            /* Sector protect status.                               */
 #define  FS_DEV_NOR_PHY_SR_SRP            DEF_BIT_07            /* Status register protect status.                      */
 
+#define  FS_DEV_NOR_PHY_SR2_QE            DEF_BIT_01            /* Quad enable.                                         */
+
                                                                 /* -------------- AVAILABLE WITH W25Q16JV ------------- */
 #define  FS_NOR_PHY_STATUS_REG3_DRV1      DEF_BIT_06            /* Output driver strength for read operations.          */
 #define  FS_NOR_PHY_STATUS_REG3_DRV2      DEF_BIT_05            /* Output driver strength for read operations.          */
@@ -229,6 +242,14 @@ static  void  FSDev_NOR_PHY_IO_Ctrl  (FS_DEV_NOR_PHY_DATA  *p_phy_data,     /* P
                                       void                 *p_data,
                                       FS_ERR               *p_err);
 
+static  void  FSDev_NOR_PHY_RdMulti  (FS_DEV_NOR_PHY_DATA  *p_phy_data,     /* Read strided chunks from NOR device.     */
+                                      void                 *p_dest,
+                                      CPU_INT32U            start,
+                                      CPU_INT32U            cnt,
+                                      CPU_INT32U            stride,
+                                      CPU_INT32U            nbr,
+                                      FS_ERR               *p_err);
+
 
                                                                             /* -------------- LOCAL FNCTS ------------- */
 static  void  FSDev_NOR_PHY_EraseChip(FS_DEV_NOR_PHY_DATA  *p_phy_data,     /* Erase NOR device.                        */
@@ -259,7 +280,8 @@ const  FS_DEV_NOR_PHY_API  FSDev_NOR_W25Q = {
     FSDev_NOR_PHY_Rd,
     FSDev_NOR_PHY_Wr,
     FSDev_NOR_PHY_EraseBlk,
-    FSDev_NOR_PHY_IO_Ctrl
+    FSDev_NOR_PHY_IO_Ctrl,
+    FSDev_NOR_PHY_RdMulti
 };
 
 
@@ -314,6 +336,9 @@ const  FS_DEV_NOR_PHY_API  FSDev_NOR_W25Q = {
 *
 *                       (2) 'BusWidth', 'BusWidthMax' & 'PhyDevCnt' specify the bus configuration.
 *                           'AddrBase' specifies the base address of the NOR flash memory.
+*
+*                   (f) 'QSPI_BSP_Ptr' MAY point to a QSPI BSP; 'Caps' MUST then be assigned the
+*                       capabilities available with the lines wired.  See 'fs_dev_nor_w25q.c  Note #2'.
 *********************************************************************************************************
 */
 
@@ -327,6 +352,7 @@ static  void  FSDev_NOR_PHY_Open (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     CPU_INT16U   id_dev;
     CPU_INT08U   cmd[3u];
     CPU_INT08U   sr;
+    CPU_INT08U   lines;
     CPU_BOOLEAN  ok;
 
     if (p_phy_data->AddrBase != 0u) {
@@ -404,6 +430,20 @@ static  void  FSDev_NOR_PHY_Open (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     p_phy_data->DataPtr         = (void *)&FSDev_NOR_PHY_DevTbl[desc_nbr];      /* Save GEN desc.                      */
 
 
+                                                                /* ------------------- GET PHY CAPS ------------------- */
+    if (p_phy_data->QSPI_BSP_Ptr != DEF_NULL) {                 /* See Note #1f.                                        */
+        lines = p_phy_data->QSPI_BSP_Ptr->LinesMax(p_phy_data->UnitNbr);
+        DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_MULTI | FS_DEV_NOR_PHY_CAP_WR_BURST);
+        if (lines >= 4u) {
+            DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_QUAD | FS_DEV_NOR_PHY_CAP_WR_QUAD);
+        } else if (lines >= 2u) {
+            DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_DUAL);
+        } else {
+            ;
+        }
+    }
+
+
                                                                 /* --------------- GLOBAL SEC UNPROTECT --------------- */
                                                                 /* ----------------------- EN WR ---------------------- */
     FSDev_NOR_PHY_WrEn(p_phy_data->UnitNbr, p_err);
@@ -415,6 +455,9 @@ static  void  FSDev_NOR_PHY_Open (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     cmd[0] = FS_DEV_NOR_PHY_CMD_STATUS_REG_WRITE;               /* Only non-volatile bits are affected.                 */
     cmd[1] = 0u;                                                /* Status register 1 value                              */
     cmd[2] = 0u;                                                /* Status register 2 value                              */
+    if (DEF_BIT_IS_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_QUAD) == DEF_YES) {
+        cmd[2] = FS_DEV_NOR_PHY_SR2_QE;                         /* En quad IO (see 'fs_dev_nor_w25q.c  Note #2').       */
+    }
     FS_DEV_NOR_PHY_CMD(p_phy_data, &cmd[0], sizeof(cmd))        /* Wr cmd.                                              */
 
     FS_OS_Dly_ms(20u);                                          /* Device write status reg requires at least 10-15 ms   */
@@ -430,6 +473,20 @@ static  void  FSDev_NOR_PHY_Open (FS_DEV_NOR_PHY_DATA  *p_phy_data,
         return;
     }
 
+    if (DEF_BIT_IS_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_QUAD) == DEF_YES) {
+        cmd[0] = FS_DEV_NOR_PHY_CMD_STATUS_REG2_READ;
+        FSDev_NOR_BSP_SPI.ChipSelEn(p_phy_data->UnitNbr);       /* En chip sel.                                         */
+        FSDev_NOR_BSP_SPI.Wr(p_phy_data->UnitNbr, &cmd[0], 1u); /* Wr cmd.                                              */
+        FSDev_NOR_BSP_SPI.Rd(p_phy_data->UnitNbr, &sr, 1u);     /* Rd status reg 2.                                     */
+        FSDev_NOR_BSP_SPI.ChipSelDis(p_phy_data->UnitNbr);      /* Dis chip sel.                                        */
+
+        if (DEF_BIT_IS_CLR(sr, FS_DEV_NOR_PHY_SR2_QE) == DEF_YES) {
+            FS_TRACE_INFO(("NOR PHY W25Q: Could not set QE bit; using dual output rd.\r\n"));
+            DEF_BIT_CLR(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_QUAD | FS_DEV_NOR_PHY_CAP_WR_QUAD);
+            DEF_BIT_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_DUAL);
+        }
+    }
+
    *p_err = FS_ERR_NONE;
 }
 
@@ -482,6 +539,8 @@ static  void  FSDev_NOR_PHY_Close (FS_DEV_NOR_PHY_DATA  *p_phy_data)
 *                   internal circuits additional time for setting up the initial address. The input data
 *                   during the dummy clocks is "don't care". However, the IO0 pin should be high-impedance
 *                   prior to the falling edge of the first data out clock.
+*
+*               (2) With a QSPI BSP, the read is issued as a single chunk by FSDev_NOR_PHY_RdMulti().
 *********************************************************************************************************
 */
 
@@ -494,6 +553,11 @@ static  void  FSDev_NOR_PHY_Rd (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     CPU_INT08U  cmd[5u];
 
 
+    if (p_phy_data->QSPI_BSP_Ptr != DEF_NULL) {                 /* See Note #2.                                         */
+        FSDev_NOR_PHY_RdMulti(p_phy_data, p_dest, start, cnt, cnt, 1u, p_err);
+        return;
+    }
+
                                                                 /* ---------------------- RD DEV ---------------------- */
     cmd[0u] = FS_DEV_NOR_PHY_CMD_FAST_READ;
                                                                 /* Cfg. 3-Byte address[A23-A0].Sending MSB first        */
@@ -711,6 +775,81 @@ static  void  FSDev_NOR_PHY_IO_Ctrl (FS_DEV_NOR_PHY_DATA  *p_phy_data,
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FSDev_NOR_PHY_RdMulti()
+*
+* Description : Read strided chunks from a NOR device & store them contiguously in buffer.
+*
+* Argument(s) : p_phy_data  Pointer to NOR phy data.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               start       Start address of first chunk (relative to start of device).
+*
+*               cnt         Number of octets in each chunk.
+*
+*               stride      Distance between the start addresses of consecutive chunks, in octets.
+*
+*               nbr         Number of chunks to read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE           Octets read successfully.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Only called if a QSPI BSP is configured (FS_DEV_NOR_PHY_CAP_RD_MULTI set).
+*
+*               (2) The device streams data from consecutive addresses as long as the clock runs, so the
+*                   whole run is read with one command; the BSP discards the octets between chunks.
+*
+*               (3) The address is sent on one line for each of 0Bh, 3Bh & 6Bh, each followed by eight
+*                   dummy clocks.  See 'LOCAL DEFINES  Note #2'.
+*********************************************************************************************************
+*/
+
+static  void  FSDev_NOR_PHY_RdMulti (FS_DEV_NOR_PHY_DATA  *p_phy_data,
+                                     void                 *p_dest,
+                                     CPU_INT32U            start,
+                                     CPU_INT32U            cnt,
+                                     CPU_INT32U            stride,
+                                     CPU_INT32U            nbr,
+                                     FS_ERR               *p_err)
+{
+    FS_DEV_NOR_QSPI_CMD  cmd;
+    CPU_BOOLEAN          ok;
+
+
+                                                                /* ------------------ SEL FAST RD CMD ----------------- */
+    if (DEF_BIT_IS_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_QUAD) == DEF_YES) {
+        cmd.Instr     = FS_DEV_NOR_PHY_CMD_FAST_READ_QUAD_OUT;
+        cmd.DataLines = 4u;
+    } else if (DEF_BIT_IS_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_RD_DUAL) == DEF_YES) {
+        cmd.Instr     = FS_DEV_NOR_PHY_CMD_FAST_READ_DUAL_OUT;
+        cmd.DataLines = 2u;
+    } else {
+        cmd.Instr     = FS_DEV_NOR_PHY_CMD_FAST_READ;
+        cmd.DataLines = 1u;
+    }
+    cmd.AddrLen     = 3u;                                       /* See Note #3.                                         */
+    cmd.AddrLines   = 1u;
+    cmd.DummyCycles = FS_DEV_NOR_W25Q_DUMMY_CYCLES;
+    cmd.Addr        = start;
+
+                                                                /* ---------------------- RD DEV ---------------------- */
+    ok = p_phy_data->QSPI_BSP_Ptr->Rd(p_phy_data->UnitNbr,      /* See Note #2.                                         */
+                                      &cmd,
+                                      p_dest,
+                                      (CPU_SIZE_T)cnt,
+                                      (CPU_SIZE_T)stride,
+                                      (CPU_SIZE_T)nbr);
+
+   *p_err = (ok == DEF_OK) ? FS_ERR_NONE : FS_ERR_DEV_IO;
+}
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -786,7 +925,8 @@ static  void  FSDev_NOR_PHY_EraseChip (FS_DEV_NOR_PHY_DATA  *p_phy_data,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) With a QSPI BSP, the command & the data are issued as one burst, with Quad Input Page
+*                   Program (32h) if 4 lines are wired.
 *********************************************************************************************************
 */
 static  void  FSDev_NOR_PHY_WrPage (FS_DEV_NOR_PHY_DATA  *p_phy_data,
@@ -795,7 +935,9 @@ static  void  FSDev_NOR_PHY_WrPage (FS_DEV_NOR_PHY_DATA  *p_phy_data,
                                     CPU_INT32U            cnt,
                                     FS_ERR               *p_err)
 {
-    CPU_INT08U  cmd[4u];
+    CPU_INT08U           cmd[4u];
+    FS_DEV_NOR_QSPI_CMD  cmd_qspi;
+    CPU_BOOLEAN          ok;
 
 
                                                                 /* ----------------------- EN WR ---------------------- */
@@ -805,20 +947,40 @@ static  void  FSDev_NOR_PHY_WrPage (FS_DEV_NOR_PHY_DATA  *p_phy_data,
     }
 
                                                                 /* ---------------------- WR DEV ---------------------- */
-    cmd[0u] = FS_DEV_NOR_PHY_CMD_PAGE_PGM;
+    if (p_phy_data->QSPI_BSP_Ptr != DEF_NULL) {                 /* See Note #1.                                         */
+        if (DEF_BIT_IS_SET(p_phy_data->Caps, FS_DEV_NOR_PHY_CAP_WR_QUAD) == DEF_YES) {
+            cmd_qspi.Instr     = FS_DEV_NOR_PHY_CMD_QUAD_PAGE_PGM;
+            cmd_qspi.DataLines = 4u;
+        } else {
+            cmd_qspi.Instr     = FS_DEV_NOR_PHY_CMD_PAGE_PGM;
+            cmd_qspi.DataLines = 1u;
+        }
+        cmd_qspi.AddrLen     = 3u;
+        cmd_qspi.AddrLines   = 1u;
+        cmd_qspi.DummyCycles = 0u;
+        cmd_qspi.Addr        = start;
+
+        ok = p_phy_data->QSPI_BSP_Ptr->Wr(p_phy_data->UnitNbr, &cmd_qspi, p_src, (CPU_SIZE_T)cnt);
+        if (ok != DEF_OK) {
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
+    } else {
+        cmd[0u] = FS_DEV_NOR_PHY_CMD_PAGE_PGM;
                                                                 /* Cfg. 3-Byte address[A23-A0].Sending MSB first        */
-    cmd[1u] = (CPU_INT08U)((start >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-    cmd[2u] = (CPU_INT08U)((start >> (1u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-    cmd[3u] = (CPU_INT08U)((start >> (0u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
-
-    FSDev_NOR_BSP_SPI.ChipSelEn(p_phy_data->UnitNbr);           /* En chip sel.                                         */
-    FSDev_NOR_BSP_SPI.Wr((FS_QTY    )p_phy_data->UnitNbr,       /* Wr cmd.                                              */
-                         (void     *)&cmd[0u],
-                         (CPU_SIZE_T)sizeof(cmd));
-    FSDev_NOR_BSP_SPI.Wr((FS_QTY    )p_phy_data->UnitNbr,       /* Wr data.                                             */
-                         (void     *)p_src,
-                         (CPU_SIZE_T)cnt);
-    FSDev_NOR_BSP_SPI.ChipSelDis(p_phy_data->UnitNbr);          /* Dis chip sel.                                        */
+        cmd[1u] = (CPU_INT08U)((start >> (2u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
+        cmd[2u] = (CPU_INT08U)((start >> (1u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
+        cmd[3u] = (CPU_INT08U)((start >> (0u * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK);
+
+        FSDev_NOR_BSP_SPI.ChipSelEn(p_phy_data->UnitNbr);       /* En chip sel.                                         */
+        FSDev_NOR_BSP_SPI.Wr((FS_QTY    )p_phy_data->UnitNbr,   /* Wr cmd.                                              */
+                             (void     *)&cmd[0u],
+                             (CPU_SIZE_T)sizeof(cmd));
+        FSDev_NOR_BSP_SPI.Wr((FS_QTY    )p_phy_data->UnitNbr,   /* Wr data.                                             */
+                             (void     *)p_src,
+                             (CPU_SIZE_T)cnt);
+        FSDev_NOR_BSP_SPI.ChipSelDis(p_phy_data->UnitNbr);      /* Dis chip sel.                                        */
+    }
 
 
                                                                 /* ----------------- WAIT WHILE WR'ING ---------------- */
@@ -55,6 +55,14 @@
 *                 as a single block by the physical-layer driver.
 *
 *             (5) #### Improve allocation of L2P table by packing bits of entries.
+*
+*             (6) If FS_DEV_NOR_CFG_CKPT_EN is enabled, the last blocks of the file system area hold two
+*                 checkpoint slots, written in turn.  A checkpoint is a copy of the L2P table, with the
+*                 erase count & next unwritten sector of each block; the header's status word is only
+*                 programmed once the rest is written.  The device is then mounted from the most recent
+*                 checkpoint, scanning only the blocks erased or written since (see 'FSDev_NOR_CkptLoad()').
+*                 The checkpoint area is part of the low-level format : enabling or disabling checkpoints
+*                 requires the device to be low-level formatted again.
 *********************************************************************************************************
 */
 
@@ -119,6 +127,25 @@
 
 #define  FS_DEV_NOR_SEC_NBR_INVALID       DEF_INT_32U_MAX_VAL   /* Logical sector number (invalid).                     */
 
+                                                                /* --------------------- CKPT SLOT -------------------- */
+#define  FS_DEV_NOR_CKPT_SLOT_CNT                          2u   /* Nbr of ckpt slots.                                   */
+#define  FS_DEV_NOR_CKPT_HDR_LEN                          32u
+#define  FS_DEV_NOR_CKPT_BLK_INFO_LEN                      8u
+
+#define  FS_DEV_NOR_CKPT_HDR_OFFSET_MARK1                  0u   /* Marker word 1 offset.                                */
+#define  FS_DEV_NOR_CKPT_HDR_OFFSET_MARK2                  4u   /* Marker word 2 offset.                                */
+#define  FS_DEV_NOR_CKPT_HDR_OFFSET_SEQ                    8u   /* Ckpt seq nbr offset.                                 */
+#define  FS_DEV_NOR_CKPT_HDR_OFFSET_VER                   12u   /* Format version offset.                               */
+#define  FS_DEV_NOR_CKPT_HDR_OFFSET_SEC_SIZE              14u   /* Sec size offset.                                     */
+#define  FS_DEV_NOR_CKPT_HDR_OFFSET_BLK_CNT               16u   /* Blk cnt  offset.                                     */
+#define  FS_DEV_NOR_CKPT_HDR_OFFSET_SIZE                  20u   /* Disk size offset.                                    */
+#define  FS_DEV_NOR_CKPT_HDR_OFFSET_STATUS                24u   /* Status of ckpt offset.                               */
+
+#define  FS_DEV_NOR_CKPT_HDR_MARK_WORD_2          0x54504B43u   /* Marker word 2 ("CKPT").                              */
+
+#define  FS_DEV_NOR_CKPT_BLK_INFO_OFFSET_ERASE_CNT         0u   /* Erase cnt of blk offset.                             */
+#define  FS_DEV_NOR_CKPT_BLK_INFO_OFFSET_SEC_IX_NEXT       4u   /* Next unwritten sec in blk offset.                    */
+
 
 /*
 *********************************************************************************************************
@@ -144,6 +171,10 @@ struct  fs_dev_nor_data {
     CPU_INT08U            SecSizeLog;                           /* Base-2 log of sec size.                              */
     FS_SEC_QTY            BlkSecCnts;                           /* Cnt of secs in each blk.                             */
     FS_SEC_QTY            AB_Cnt;                               /* Active blk cnt.                                      */
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)
+    FS_SEC_QTY            CkptBlkCnt;                           /* Cnt of blks in each ckpt slot.                       */
+    CPU_INT32U            CkptTblSize;                          /* Size of L2P tbl in ckpt, in octets.                  */
+#endif
 
 
                                                                 /* ------------------- DEV OPEN DATA ------------------ */
@@ -167,6 +198,18 @@ struct  fs_dev_nor_data {
     CPU_INT32U            EraseCntMax;                          /* Max erase cnt.                                       */
     CPU_BOOLEAN           Mounted;                              /* Low-level mounted.                                   */
 
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)                     /* --------------------- CKPT INFO -------------------- */
+    CPU_INT08U            CkptSlotCur;                          /* Slot of most recent ckpt.                            */
+    CPU_INT32U            CkptSeq;                              /* Seq nbr  of most recent ckpt.                        */
+    CPU_BOOLEAN           CkptValid;                            /* Most recent ckpt marked valid on dev.                */
+    CPU_INT32U            CkptEraseCtr;                         /* Blks erased since most recent ckpt.                  */
+#endif
+
+#if (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED)        /* ----------------- STATIC WEAR LEVEL ---------------- */
+    CPU_INT32U            WearLevelEraseCtr;                    /* Blks erased since most recent static wear level.     */
+    CPU_INT32U            WearLevelPeriod;                      /* Blk erases between static wear level steps.          */
+#endif
+
 
                                                                 /* --------------------- CFG INFO --------------------- */
     CPU_ADDR              AddrStart;                            /* Start addr of data within flash.                     */
@@ -174,6 +217,8 @@ struct  fs_dev_nor_data {
     FS_SEC_SIZE           SecSize;                              /* Sec size of low-level formatted flash.               */
     CPU_INT08U            PctRsvd;                              /* Pct of device area rsvd.                             */
     CPU_INT16U            EraseCntDiffTh;                       /* Erase count difference threshold.                    */
+    CPU_INT32U            Endurance;                            /* Rated erase cycles per blk.                          */
+    CPU_ADDR              AddrMap;                              /* Addr of flash in CPU addr space, 0 if not mapped.    */
 
 
                                                                 /* --------------------- PHY INFO --------------------- */
@@ -190,6 +235,8 @@ struct  fs_dev_nor_data {
     FS_CTR                StatWrOctetCtr;                       /* Octets wr.                                           */
     FS_CTR                StatEraseBlkCtr;                      /* Blks erased.                                         */
     FS_CTR                StatInvalidBlkCtr;                    /* Blks invalidated.                                    */
+    FS_CTR                StatWearLevelStaticCtr;               /* Cold blks moved by static wear leveling.             */
+    FS_CTR                StatWearLevelActiveCtr;               /* Blks erased by active wear leveling.                 */
 #endif
 
 
@@ -300,12 +347,34 @@ static  void              FSDev_NOR_LowDefragHandler   (FS_DEV_NOR_DATA  *p_nor_
                                                         FS_ERR           *p_err);
 #endif
 
+static  void              FSDev_NOR_WearInfoHandler    (FS_DEV_NOR_DATA       *p_nor_data,  /* Get wear info.           */
+                                                        FS_DEV_NOR_WEAR_INFO  *p_info,
+                                                        FS_ERR                *p_err);
+
+#if ((FS_CFG_RD_ONLY_EN                   == DEF_DISABLED) && \
+     (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED))
+static  CPU_BOOLEAN       FSDev_NOR_WearLevelHandler   (FS_DEV_NOR_DATA  *p_nor_data,   /* Move one cold blk.           */
+                                                        FS_ERR           *p_err);
+
+static  FS_SEC_NBR        FSDev_NOR_FindBlkCold        (FS_DEV_NOR_DATA  *p_nor_data,   /* Find cold blk to move.       */
+                                                        CPU_INT32U        th,
+                                                        FS_ERR           *p_err);
+#endif
+
 static  void              FSDev_NOR_PhyRdHandler       (FS_DEV_NOR_DATA  *p_nor_data,   /* Rd octets.                   */
                                                         void             *p_dest,
                                                         CPU_INT32U        start,
                                                         CPU_INT32U        cnt,
                                                         FS_ERR           *p_err);
 
+static  void              FSDev_NOR_PhyRdMultiHandler  (FS_DEV_NOR_DATA  *p_nor_data,   /* Rd strided octet chunks.     */
+                                                        void             *p_dest,
+                                                        CPU_INT32U        start,
+                                                        CPU_INT32U        cnt,
+                                                        CPU_INT32U        stride,
+                                                        CPU_INT32U        nbr,
+                                                        FS_ERR           *p_err);
+
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
 static  void              FSDev_NOR_PhyWrHandler       (FS_DEV_NOR_DATA  *p_nor_data,   /* Wr octets.                   */
                                                         void             *p_src,
@@ -340,6 +409,16 @@ static  void              FSDev_NOR_RdSecLogical       (FS_DEV_NOR_DATA  *p_nor_
                                                         FS_SEC_NBR        sec_nbr_logical,
                                                         FS_ERR           *p_err);
 
+static  FS_SEC_QTY        FSDev_NOR_RdSecLogicalMulti  (FS_DEV_NOR_DATA  *p_nor_data,   /* Rd run of logical secs.      */
+                                                        void             *p_dest,
+                                                        FS_SEC_NBR        sec_nbr_logical,
+                                                        FS_SEC_QTY        cnt,
+                                                        FS_ERR           *p_err);
+
+static  void              FSDev_NOR_SecMapHandler      (FS_DEV_NOR_DATA  *p_nor_data,   /* Get addr of logical sec.     */
+                                                        FS_DEV_SEC_MAP   *p_sec_map,
+                                                        FS_ERR           *p_err);
+
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
 static  void              FSDev_NOR_WrSecLogical       (FS_DEV_NOR_DATA  *p_nor_data,   /* Wr logical sec.              */
                                                         void             *p_src,
@@ -370,6 +449,26 @@ static  FS_SEC_NBR        FSDev_NOR_FindEraseBlkWear   (FS_DEV_NOR_DATA  *p_nor_
 static  FS_SEC_NBR        FSDev_NOR_FindErasedBlk      (FS_DEV_NOR_DATA  *p_nor_data);  /* Find blk that is erased.     */
 #endif
 
+#if ((FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED) && \
+     (FS_CFG_RD_ONLY_EN      == DEF_DISABLED))
+static  void              FSDev_NOR_CkptFind           (FS_DEV_NOR_DATA  *p_nor_data,   /* Find most recent ckpt.       */
+                                                        FS_ERR           *p_err);
+
+static  CPU_BOOLEAN       FSDev_NOR_CkptLoad           (FS_DEV_NOR_DATA  *p_nor_data,   /* Mount from ckpt.             */
+                                                        FS_SEC_QTY       *p_blk_cnt_valid,
+                                                        FS_SEC_QTY       *p_blk_cnt_erased,
+                                                        FS_ERR           *p_err);
+
+static  void              FSDev_NOR_CkptWr             (FS_DEV_NOR_DATA  *p_nor_data,   /* Wr ckpt.                     */
+                                                        FS_ERR           *p_err);
+
+static  void              FSDev_NOR_CkptInvalidate     (FS_DEV_NOR_DATA  *p_nor_data,   /* Invalidate ckpt.             */
+                                                        FS_ERR           *p_err);
+
+static  CPU_INT32U        FSDev_NOR_CkptSlotAddr       (FS_DEV_NOR_DATA  *p_nor_data,   /* Get addr of ckpt slot.       */
+                                                        CPU_INT08U        slot);
+#endif
+
 
 static  void              FSDev_NOR_AB_ClrAll         (FS_DEV_NOR_DATA  *p_nor_data);   /* Clr AB data.                 */
 
@@ -832,6 +931,176 @@ void  FSDev_NOR_LowDefrag (CPU_CHAR  *name_dev,
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FSDev_NOR_WearInfoGet()
+*
+* Description : Get wear information of a NOR device : erase count statistics, histogram & projected
+*               remaining lifetime.
+*
+* Argument(s) : name_dev    Device name (see Note #1).
+*
+*               p_info      Pointer to structure that will receive wear information.
+*
+*               p_err       Pointer to variable that will receive return the error code from this function :
+*
+*                               FS_ERR_NONE                   Wear information obtained.
+*                               FS_ERR_NAME_NULL              Argument 'name_dev' passed a NULL pointer.
+*                               FS_ERR_NULL_PTR               Argument 'p_info' passed a NULL pointer.
+*                               FS_ERR_DEV_INVALID            Argument 'name_dev' specifies an invalid device.
+*
+*                                                             --------- RETURNED BY FSDev_IO_Ctrl() ---------
+*                               FS_ERR_DEV_NOT_OPEN           Device is not open.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The device MUST be a NOR device (e.g., "nor:0:").
+*
+*               (2) The header of every block is read; the device is locked meanwhile.  This function is
+*                   meant for periodic monitoring, not for every file system access.
+*
+*               (3) See 'fs_dev_nor.h  NOR WEAR INFORMATION DATA TYPE' for the reported fields.
+*********************************************************************************************************
+*/
+
+void  FSDev_NOR_WearInfoGet (CPU_CHAR              *name_dev,
+                             FS_DEV_NOR_WEAR_INFO  *p_info,
+                             FS_ERR                *p_err)
+{
+    CPU_INT16S  cmp_val;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_dev == (CPU_CHAR *)0) {                            /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+    if (p_info == (FS_DEV_NOR_WEAR_INFO *)0) {                  /* Validate info ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return;
+    }
+#endif
+
+                                                                /* Validate name str (see Note #1).                     */
+    cmp_val = Str_Cmp_N(name_dev, (CPU_CHAR *)FSDev_NOR_Name, FS_DEV_NOR_NAME_LEN);
+    if (cmp_val != 0) {
+       *p_err = FS_ERR_DEV_INVALID;
+        return;
+    }
+
+    if (name_dev[FS_DEV_NOR_NAME_LEN] != FS_CHAR_DEV_SEP) {
+       *p_err = FS_ERR_DEV_INVALID;
+        return;
+    }
+
+
+                                                                /* ------------------- GET WEAR INFO ------------------ */
+    FSDev_IO_Ctrl(        name_dev,
+                          FS_DEV_IO_CTRL_NOR_WEAR_INFO,
+                  (void *)p_info,
+                          p_err);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FSDev_NOR_WearLevel()
+*
+* Description : Perform one step of static wear leveling on a NOR device : migrate the data of one cold
+*               block, if the erase count spread warrants it.
+*
+* Argument(s) : name_dev    Device name (see Note #1).
+*
+*               p_err       Pointer to variable that will receive return the error code from this function :
+*
+*                               FS_ERR_NONE                   Step performed (or nothing to do).
+*                               FS_ERR_NAME_NULL              Argument 'name_dev' passed a NULL pointer.
+*                               FS_ERR_DEV_INVALID            Argument 'name_dev' specifies an invalid device.
+*
+*                                                             --------- RETURNED BY FSDev_IO_Ctrl() ---------
+*                               FS_ERR_DEV_NOT_OPEN           Device is not open.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout.
+*
+* Return(s)   : DEF_YES, if a cold block was migrated (more cold blocks may remain),
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) The device MUST be a NOR device (e.g., "nor:0:").
+*
+*               (2) The driver already migrates cold blocks from the write path, at most one every few
+*                   block erases (see 'FSDev_NOR_Wr()  Note #3').  This function lets the application do
+*                   this work from a low-priority (idle) task instead, e.g. :
+*
+*                       for (step = 0u; step < WEAR_LEVEL_STEP_MAX; step++) {
+*                           moved = FSDev_NOR_WearLevel("nor:0:", &err);
+*                           if ((err != FS_ERR_NONE) || (moved == DEF_NO)) {
+*                               break;
+*                           }
+*                       }
+*
+*                   Each call moves at most one block & holds the device lock only for that step.  Since
+*                   every step that returns DEF_YES erases a block, the number of steps per idle period
+*                   should be bounded.
+*********************************************************************************************************
+*/
+
+#if ((FS_CFG_RD_ONLY_EN                   == DEF_DISABLED) && \
+     (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED))
+CPU_BOOLEAN  FSDev_NOR_WearLevel (CPU_CHAR  *name_dev,
+                                  FS_ERR    *p_err)
+{
+    CPU_BOOLEAN  more;
+    CPU_INT16S   cmp_val;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(DEF_NO);
+    }
+    if (name_dev == (CPU_CHAR *)0) {                            /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return (DEF_NO);
+    }
+#endif
+
+                                                                /* Validate name str (see Note #1).                     */
+    cmp_val = Str_Cmp_N(name_dev, (CPU_CHAR *)FSDev_NOR_Name, FS_DEV_NOR_NAME_LEN);
+    if (cmp_val != 0) {
+       *p_err = FS_ERR_DEV_INVALID;
+        return (DEF_NO);
+    }
+
+    if (name_dev[FS_DEV_NOR_NAME_LEN] != FS_CHAR_DEV_SEP) {
+       *p_err = FS_ERR_DEV_INVALID;
+        return (DEF_NO);
+    }
+
+
+                                                                /* ------------- WEAR LEVEL (see Note #2) ------------- */
+    more = DEF_NO;
+    FSDev_IO_Ctrl(name_dev,
+                  FS_DEV_IO_CTRL_NOR_WEAR_LEVEL,
+                 &more,
+                  p_err);
+
+    if (*p_err != FS_ERR_NONE) {
+        return (DEF_NO);
+    }
+
+    return (more);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                          FSDev_NOR_PhyRd()
@@ -1333,6 +1602,8 @@ static  void  FSDev_NOR_Open (FS_DEV  *p_dev,
     p_nor_data->SecSize          =  p_nor_cfg->SecSize;
     p_nor_data->PctRsvd          = (p_nor_cfg->PctRsvd          ==  0u) ? FS_DEV_NOR_PCT_RSVD_DFLT           : p_nor_cfg->PctRsvd;
     p_nor_data->EraseCntDiffTh   = (p_nor_cfg->EraseCntDiffTh   ==  0u) ? FS_DEV_NOR_ERASE_CNT_DIFF_TH_DFLT  : p_nor_cfg->EraseCntDiffTh;
+    p_nor_data->Endurance        = (p_nor_cfg->Endurance        ==  0u) ? FS_DEV_NOR_ENDURANCE_DFLT          : p_nor_cfg->Endurance;
+    p_nor_data->AddrMap          =  p_nor_cfg->AddrMap;
 
     p_nor_data->PhyPtr           =  p_nor_cfg->PhyPtr;
 
@@ -1348,6 +1619,8 @@ static  void  FSDev_NOR_Open (FS_DEV  *p_dev,
     p_phy_data->BusWidthMax      =  p_nor_cfg->BusWidthMax;
     p_phy_data->PhyDevCnt        =  p_nor_cfg->PhyDevCnt;
     p_phy_data->MaxClkFreq       =  p_nor_cfg->MaxClkFreq;
+    p_phy_data->QSPI_BSP_Ptr     =  p_nor_cfg->QSPI_BSP_Ptr;
+    p_phy_data->Caps             =  FS_DEV_NOR_PHY_CAP_NONE;    /* Set by phy on open.                                  */
 
     p_dev->DataPtr               = (void *)p_nor_data;
 
@@ -1459,6 +1732,9 @@ static  void  FSDev_NOR_Close (FS_DEV  *p_dev)
 *
 * Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
 *                   called when a device is open.
+*
+*               (2) If the physical-layer driver supports multi-chunk reads, runs of logical sectors that
+*                   are stored in consecutive physical sectors are read with a single device command.
 *********************************************************************************************************
 */
 
@@ -1472,6 +1748,8 @@ static  void  FSDev_NOR_Rd (FS_DEV      *p_dev,
     FS_SEC_NBR        sec_nbr_logical;
     CPU_INT08U       *p_dest_08;
     FS_SEC_QTY        cnt_rem;
+    FS_SEC_QTY        cnt_rd;
+    CPU_BOOLEAN       multi_en;
 
 
 #if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
@@ -1492,19 +1770,32 @@ static  void  FSDev_NOR_Rd (FS_DEV      *p_dev,
     sec_nbr_logical =  start;
     p_dest_08       = (CPU_INT08U *)p_dest;
     cnt_rem         =  cnt;
+    multi_en        =  DEF_NO;
+    if (p_nor_data->PhyPtr->RdMulti != DEF_NULL) {
+        multi_en    =  DEF_BIT_IS_SET(p_nor_data->PhyDataPtr->Caps, FS_DEV_NOR_PHY_CAP_RD_MULTI);
+    }
 
     while (cnt_rem > 0u) {
-        FSDev_NOR_RdSecLogical(p_nor_data,
-                               p_dest_08,
-                               sec_nbr_logical,
-                               p_err);
+        if (multi_en == DEF_YES) {                              /* Rd run of phy contiguous secs (see Note #2).         */
+            cnt_rd = FSDev_NOR_RdSecLogicalMulti(p_nor_data,
+                                                 p_dest_08,
+                                                 sec_nbr_logical,
+                                                 cnt_rem,
+                                                 p_err);
+        } else {
+            FSDev_NOR_RdSecLogical(p_nor_data,
+                                   p_dest_08,
+                                   sec_nbr_logical,
+                                   p_err);
+            cnt_rd = 1u;
+        }
         if (*p_err != FS_ERR_NONE) {
             return;
         }
 
-        cnt_rem--;
-        sec_nbr_logical++;
-        p_dest_08 += p_nor_data->SecSize;
+        cnt_rem         -= cnt_rd;
+        sec_nbr_logical += cnt_rd;
+        p_dest_08       += (CPU_SIZE_T)cnt_rd * p_nor_data->SecSize;
     }
 
     FS_CTR_STAT_ADD(p_nor_data->StatRdCtr, (FS_CTR)cnt);
@@ -1539,6 +1830,12 @@ static  void  FSDev_NOR_Rd (FS_DEV      *p_dev,
 *
 * Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
 *                   called when a device is open.
+*
+*               (2) If checkpoints are enabled, a checkpoint is written once FS_DEV_NOR_CFG_CKPT_PERIOD
+*                   blocks have been erased since the previous one, bounding the blocks scanned upon mount.
+*
+*               (3) If static wear leveling is enabled, at most one cold block is moved once 'WearLevelPeriod'
+*                   blocks have been erased since the previous step (see 'FSDev_NOR_WearLevelHandler()  Note #2').
 *********************************************************************************************************
 */
 
@@ -1588,6 +1885,26 @@ static  void  FSDev_NOR_Wr (FS_DEV      *p_dev,
         p_src_08 += p_nor_data->SecSize;
     }
 
+#if (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED)
+                                                                /* Move cold blk (see Note #3).                         */
+    if (p_nor_data->WearLevelEraseCtr >= p_nor_data->WearLevelPeriod) {
+        (void)FSDev_NOR_WearLevelHandler(p_nor_data, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+    }
+#endif
+
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)
+                                                                /* Wr ckpt (see Note #2).                               */
+    if (p_nor_data->CkptEraseCtr >= FS_DEV_NOR_CFG_CKPT_PERIOD) {
+        FSDev_NOR_CkptWr(p_nor_data, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+    }
+#endif
+
     FS_CTR_STAT_ADD(p_nor_data->StatWrCtr, (FS_CTR)cnt);
    *p_err = FS_ERR_NONE;
 }
@@ -1693,6 +2010,9 @@ static  void  FSDev_NOR_Query (FS_DEV       *p_dev,
 *                   (k) FS_DEV_IO_CTRL_PHY_WR_PAGE       Write physical device page.   [*]
 *                   (l) FS_DEV_IO_CTRL_PHY_ERASE_BLK     Erase physical device block.  [**]
 *                   (;) FS_DEV_IO_CTRL_PHY_ERASE_CHIP    Erase physical device.        [**]
+*                   (m) FS_DEV_IO_CTRL_NOR_WEAR_INFO     Get wear information.         [**]
+*                   (n) FS_DEV_IO_CTRL_NOR_WEAR_LEVEL    Move one cold block.          [**]
+*                   (o) FS_DEV_IO_CTRL_SEC_MAP           Get address of sectors.
 *
 *                           [*] NOT SUPPORTED
 *                          [**] OCCUR VIA APPLICATION CALLS TO NOR DRIVER INTERFACE FUNCTIONS :
@@ -1707,6 +2027,12 @@ static  void  FSDev_NOR_Query (FS_DEV       *p_dev,
 *                                   FSDev_NOR_PhyWr()
 *                                   FSDev_NOR_PhyEraseBlk()
 *                                   FSDev_NOR_PhyEraseChip()
+*
+*                                   FSDev_NOR_WearInfoGet()
+*                                   FSDev_NOR_WearLevel()
+*
+*               (3) A sector released since the most recent checkpoint is mapped again if the device is
+*                   next mounted from that checkpoint (see 'FSDev_NOR_CkptLoad()  Note #5').
 *********************************************************************************************************
 */
 
@@ -1795,7 +2121,7 @@ static  void  FSDev_NOR_IO_Ctrl (FS_DEV      *p_dev,
                  FSDev_NOR_L2P_SetEntry(p_nor_data,
                                         sec_nbr_logical,
                                         FS_DEV_NOR_SEC_NBR_INVALID);
-                 FS_CTR_STAT_INC(p_nor_data->StatReleaseCtr);
+                 FS_CTR_STAT_INC(p_nor_data->StatReleaseCtr);   /* See Note #3.                                         */
              } else {
                 *p_err = FS_ERR_NONE;
              }
@@ -1865,6 +2191,52 @@ static  void  FSDev_NOR_IO_Ctrl (FS_DEV      *p_dev,
              break;
 #endif
 
+
+
+        case FS_DEV_IO_CTRL_NOR_WEAR_INFO:                      /* ------------------- GET WEAR INFO ------------------ */
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
+             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
+                *p_err = FS_ERR_NULL_PTR;
+                 return;
+             }
+#endif
+
+             FSDev_NOR_WearInfoHandler(p_nor_data,
+                                       (FS_DEV_NOR_WEAR_INFO *)p_data,
+                                       p_err);
+             break;
+
+
+
+#if ((FS_CFG_RD_ONLY_EN                   == DEF_DISABLED) && \
+     (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED))
+        case FS_DEV_IO_CTRL_NOR_WEAR_LEVEL:                     /* ----------------- STATIC WEAR LEVEL ---------------- */
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
+             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
+                *p_err = FS_ERR_NULL_PTR;
+                 return;
+             }
+#endif
+
+            *(CPU_BOOLEAN *)p_data = FSDev_NOR_WearLevelHandler(p_nor_data, p_err);
+             break;
+#endif
+
+
+        case FS_DEV_IO_CTRL_SEC_MAP:                            /* --------------------- MAP SECs --------------------- */
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
+             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
+                *p_err = FS_ERR_NULL_PTR;
+                 return;
+             }
+#endif
+
+             FSDev_NOR_SecMapHandler(p_nor_data,
+                                     (FS_DEV_SEC_MAP *)p_data,
+                                     p_err);
+             break;
+
+
         case FS_DEV_IO_CTRL_PHY_RD_PAGE:                        /* --------------- UNSUPPORTED I/O CTRL --------------- */
         case FS_DEV_IO_CTRL_PHY_WR_PAGE:
         default:
@@ -1905,6 +2277,9 @@ static  void  FSDev_NOR_IO_Ctrl (FS_DEV      *p_dev,
 *                   mounted until the low-level mount completes.
 *
 *               (2) #### Preserve erase counts from previous format by reading block headers.
+*
+*               (3) The checkpoint slots are erased, so that a checkpoint of the previous format is never
+*                   loaded.
 *********************************************************************************************************
 */
 
@@ -1915,6 +2290,9 @@ static  void  FSDev_NOR_LowFmtHandler (FS_DEV_NOR_DATA  *p_nor_data,
     CPU_INT08U  blk_hdr[FS_DEV_NOR_BLK_HDR_LEN];
     FS_SEC_NBR  blk_ix;
     CPU_INT32U  blk_addr;
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)
+    FS_SEC_NBR  blk_ix_end;
+#endif
 
 
     if (p_nor_data->Mounted == DEF_YES) {
@@ -1971,6 +2349,30 @@ static  void  FSDev_NOR_LowFmtHandler (FS_DEV_NOR_DATA  *p_nor_data,
     }
 
 
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)                     /* ------------- ERASE CKPT (see Note #3) ------------- */
+    blk_ix_end = p_nor_data->BlkCntUsed + (p_nor_data->CkptBlkCnt * FS_DEV_NOR_CKPT_SLOT_CNT);
+    while (blk_ix < blk_ix_end) {
+        blk_addr = FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix);
+        FSDev_NOR_PhyEraseBlkHandler(p_nor_data,
+                                     blk_addr,
+                                     p_nor_data->PhyDataPtr->BlkSize,
+                                     p_err);
+
+        if (*p_err != FS_ERR_NONE) {
+            FS_TRACE_DBG(("FSDev_NOR_LowFmtHandler(): Failed to erase ckpt blk %d (0x%08X).\r\n", p_nor_data->BlkNbrFirst + blk_ix, blk_addr));
+            return;
+        }
+
+        blk_ix++;
+    }
+
+    p_nor_data->CkptSlotCur  = FS_DEV_NOR_CKPT_SLOT_CNT - 1u;
+    p_nor_data->CkptSeq      = 0u;
+    p_nor_data->CkptValid    = DEF_NO;
+    p_nor_data->CkptEraseCtr = 0u;
+#endif
+
+
                                                                 /* ---------------- UPDATE INFO & MOUNT --------------- */
     FS_TRACE_DBG(("FSDev_NOR_LowFmtHandler(): Low-level fmt'ing complete.\r\n"));
 
@@ -2044,6 +2446,16 @@ static  void  FSDev_NOR_LowFmtHandler (FS_DEV_NOR_DATA  *p_nor_data,
 *                   was interrupted before copying all sectors.  Since only one block will be selected as
 *                   the active block, the erased sectors at the end of any other block MUST be classified
 *                   as invalid.
+*
+*               (7) If checkpoints are enabled (see 'fs_dev_nor.c  Note #6') :
+*
+*                   (a) The L2P table & block information are loaded from the most recent valid checkpoint,
+*                       & only the blocks erased or written since are scanned.  Every block is scanned if
+*                       no valid checkpoint is found.
+*
+*                   (b) The checkpoint is invalidated if an invalid block is found.  The erase count of
+*                       that block is lost, so the count in its new header may match the one recorded in
+*                       the checkpoint, though the block was erased.
 *********************************************************************************************************
 */
 
@@ -2059,6 +2471,7 @@ static  void  FSDev_NOR_LowMountHandler (FS_DEV_NOR_DATA  *p_nor_data,
     FS_SEC_QTY   blk_cnt_valid;
     FS_SEC_NBR   blk_ix;
     FS_SEC_NBR   blk_ix_invalid;
+    CPU_BOOLEAN  ckpt_loaded;
     CPU_BOOLEAN  erased;
     CPU_INT32U   erase_cnt;
     CPU_INT32U   erase_cnt_min;
@@ -2142,185 +2555,212 @@ static  void  FSDev_NOR_LowMountHandler (FS_DEV_NOR_DATA  *p_nor_data,
     p_nor_data->SecCntErased  = 0u;
     p_nor_data->SecCntInvalid = 0u;
 
-    blk_ix         = 0u;
-    sec_nbr_phy    = 0u;
     blk_cnt_valid  = 0u;
     blk_cnt_erased = 0u;
 
-    while (blk_ix < p_nor_data->BlkCntUsed) {
-#if (FS_TRACE_LEVEL >= TRACE_LEVEL_DBG)
-        FSDev_NOR_RdBlkHdr(p_nor_data, &blk_hdr[0], blk_ix, p_err);
+#if ((FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED) && \
+     (FS_CFG_RD_ONLY_EN      == DEF_DISABLED))
+    FSDev_NOR_CkptFind(p_nor_data, p_err);                      /* Find most recent ckpt.                               */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    if (blk_ix_invalid != FS_DEV_NOR_SEC_NBR_INVALID) {         /* If blk invalid, ckpt unusable (see Note #7b).        */
+        FSDev_NOR_CkptInvalidate(p_nor_data, p_err);
         if (*p_err != FS_ERR_NONE) {
             return;
         }
-        erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT]);
-#endif
-
+    }
 
-        if (blk_ix == blk_ix_invalid) {                         /* If blk invalid, all secs invalid & should be erased. */
-            p_nor_data->SecCntInvalid += p_nor_data->BlkSecCnts;
-            sec_nbr_phy               += p_nor_data->BlkSecCnts;
-            FS_TRACE_LOG(("FSDev_NOR_LowMountHandler(): Invalid blk found %d.\r\n", p_nor_data->BlkNbrFirst + blk_ix));
-            sec_cnt_valid = 0u;
+    ckpt_loaded = FSDev_NOR_CkptLoad( p_nor_data,               /* Mount from ckpt (see Note #7a).                      */
+                                     &blk_cnt_valid,
+                                     &blk_cnt_erased,
+                                      p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+#else
+    ckpt_loaded = DEF_NO;
+#endif
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-            blk_addr = FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix);
-
-            Mem_Clr(&blk_hdr[0], FS_DEV_NOR_BLK_HDR_LEN);
-            MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_MARK1],     FS_DEV_NOR_BLK_HDR_MARK_WORD_1);
-            MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_MARK2],     FS_DEV_NOR_BLK_HDR_MARK_WORD_2);
-            MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT], erase_cnt_max);
-            MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_VER],       FS_DEV_NOR_BLK_HDR_VER);
-            MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_SEC_SIZE],  p_nor_data->SecSize);
-            MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_BLK_CNT],   p_nor_data->BlkCntUsed);
-
-            FSDev_NOR_PhyEraseBlkHandler(p_nor_data,            /* Erase blk ...                                        */
-                                         blk_addr,
-                                         p_nor_data->PhyDataPtr->BlkSize,
-                                         p_err);
-
-            FSDev_NOR_PhyWrHandler( p_nor_data,                 /* ... & wr hdr (see Note #3).                          */
-                                   &blk_hdr[0],
-                                    blk_addr,
-                                    FS_DEV_NOR_BLK_HDR_LEN,
-                                    p_err);
-
-            erased = DEF_YES;
-#else
-            erased = DEF_NO;
+    if (ckpt_loaded == DEF_NO) {                                /* Scan every blk.                                      */
+        blk_ix      = 0u;
+        sec_nbr_phy = 0u;
+        while (blk_ix < p_nor_data->BlkCntUsed) {
+#if (FS_TRACE_LEVEL >= TRACE_LEVEL_DBG)
+            FSDev_NOR_RdBlkHdr(p_nor_data, &blk_hdr[0], blk_ix, p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+            erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT]);
 #endif
 
 
-        } else {
-            blk_addr        = FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix);
-            blk_addr       += FS_DEV_NOR_BLK_HDR_LEN;
+            if (blk_ix == blk_ix_invalid) {                     /* If blk invalid, all secs invalid & should be erased. */
+                p_nor_data->SecCntInvalid += p_nor_data->BlkSecCnts;
+                sec_nbr_phy               += p_nor_data->BlkSecCnts;
+                FS_TRACE_LOG(("FSDev_NOR_LowMountHandler(): Invalid blk found %d.\r\n", p_nor_data->BlkNbrFirst + blk_ix));
+                sec_cnt_valid = 0u;
 
-                                                                /* Chk hdr of each sec.                                 */
-            sec_ix          = 0u;
-            sec_ix_next     = 0u;
-            sec_valid       = DEF_NO;
-            sec_cnt_erased  = 0u;
-            sec_cnt_valid   = 0u;
-            sec_cnt_invalid = 0u;
-            while (sec_ix < p_nor_data->BlkSecCnts) {
-                FSDev_NOR_PhyRdHandler( p_nor_data,
-                                       &sec_hdr[0],
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+                blk_addr = FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix);
+
+                Mem_Clr(&blk_hdr[0], FS_DEV_NOR_BLK_HDR_LEN);
+                MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_MARK1],     FS_DEV_NOR_BLK_HDR_MARK_WORD_1);
+                MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_MARK2],     FS_DEV_NOR_BLK_HDR_MARK_WORD_2);
+                MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT], erase_cnt_max);
+                MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_VER],       FS_DEV_NOR_BLK_HDR_VER);
+                MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_SEC_SIZE],  p_nor_data->SecSize);
+                MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_BLK_CNT],   p_nor_data->BlkCntUsed);
+
+                FSDev_NOR_PhyEraseBlkHandler(p_nor_data,        /* Erase blk ...                                        */
+                                             blk_addr,
+                                             p_nor_data->PhyDataPtr->BlkSize,
+                                             p_err);
+
+                FSDev_NOR_PhyWrHandler( p_nor_data,             /* ... & wr hdr (see Note #3).                          */
+                                       &blk_hdr[0],
                                         blk_addr,
-                                        FS_DEV_NOR_SEC_HDR_LEN,
+                                        FS_DEV_NOR_BLK_HDR_LEN,
                                         p_err);
-                if (*p_err != FS_ERR_NONE) {
-                    return;
-                }
-                sec_nbr_logical = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_SEC_NBR]);
-                status          = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS]);
 
-                switch (status) {
-                    case FS_DEV_NOR_STATUS_SEC_ERASED:
-                         sec_cnt_erased++;
-                         break;
+                erased = DEF_YES;
+#else
+                erased = DEF_NO;
+#endif
 
-                    case FS_DEV_NOR_STATUS_SEC_VALID:
-                         if (sec_nbr_logical < p_nor_data->Size) {
-                             sec_nbr_phy_old = FSDev_NOR_L2P_GetEntry(p_nor_data,
-                                                                      sec_nbr_logical);
-                             if (sec_nbr_phy_old == FS_DEV_NOR_SEC_NBR_INVALID) {
-                                 FSDev_NOR_L2P_SetEntry(p_nor_data,
-                                                        sec_nbr_logical,
-                                                        sec_nbr_phy);
-                                 sec_cnt_valid++;
-                                 sec_valid = DEF_YES;           /* Blk has valid data.                                  */
 
+            } else {
+                blk_addr        = FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix);
+                blk_addr       += FS_DEV_NOR_BLK_HDR_LEN;
 
-                             } else {                           /* Duplicate entry (see Note #4).                       */
+                                                                /* Chk hdr of each sec.                                 */
+                sec_ix          = 0u;
+                sec_ix_next     = 0u;
+                sec_valid       = DEF_NO;
+                sec_cnt_erased  = 0u;
+                sec_cnt_valid   = 0u;
+                sec_cnt_invalid = 0u;
+                while (sec_ix < p_nor_data->BlkSecCnts) {
+                    FSDev_NOR_PhyRdHandler( p_nor_data,
+                                           &sec_hdr[0],
+                                            blk_addr,
+                                            FS_DEV_NOR_SEC_HDR_LEN,
+                                            p_err);
+                    if (*p_err != FS_ERR_NONE) {
+                        return;
+                    }
+                    sec_nbr_logical = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_SEC_NBR]);
+                    status          = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS]);
+
+                    switch (status) {
+                        case FS_DEV_NOR_STATUS_SEC_ERASED:
+                             sec_cnt_erased++;
+                             break;
+
+                        case FS_DEV_NOR_STATUS_SEC_VALID:
+                             if (sec_nbr_logical < p_nor_data->Size) {
+                                 sec_nbr_phy_old = FSDev_NOR_L2P_GetEntry(p_nor_data,
+                                                                          sec_nbr_logical);
+                                 if (sec_nbr_phy_old == FS_DEV_NOR_SEC_NBR_INVALID) {
+                                     FSDev_NOR_L2P_SetEntry(p_nor_data,
+                                                            sec_nbr_logical,
+                                                            sec_nbr_phy);
+                                     sec_cnt_valid++;
+                                     sec_valid = DEF_YES;       /* Blk has valid data.                                  */
+
+
+                                 } else {                       /* Duplicate entry (see Note #4).                       */
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-                                 MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS], FS_DEV_NOR_STATUS_SEC_INVALID);
+                                     MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS], FS_DEV_NOR_STATUS_SEC_INVALID);
                                                                 /* Mark sec as 'invalid'.                               */
-                                 FSDev_NOR_PhyWrHandler( p_nor_data,
-                                                        &sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],
-                                                         blk_addr + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS,
-                                                         4u,
-                                                         p_err);
+                                     FSDev_NOR_PhyWrHandler( p_nor_data,
+                                                            &sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],
+                                                             blk_addr + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS,
+                                                             4u,
+                                                             p_err);
 #endif
 
-                                 FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Logical sec %d already assigned to phy sec %d before %d.\r\n", sec_nbr_logical, sec_nbr_phy_old, sec_nbr_phy));
+                                     FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Logical sec %d already assigned to phy sec %d before %d.\r\n", sec_nbr_logical, sec_nbr_phy_old, sec_nbr_phy));
+                                     sec_cnt_invalid++;
+                                 }
+
+                             } else {
                                  sec_cnt_invalid++;
                              }
+                             sec_cnt_invalid += sec_cnt_erased; /* No erased secs precede valid secs.                   */
+                             sec_cnt_erased   = 0u;
+                             sec_ix_next      = sec_ix + 1u;    /* Set next potentially erased sec.                     */
+                             break;
+
+                        case FS_DEV_NOR_STATUS_SEC_WRITING:     /* No erased secs precede invalid secs.                 */
+                        case FS_DEV_NOR_STATUS_SEC_INVALID:
+                        default:
+                             sec_cnt_invalid += sec_cnt_erased + 1u;
+                             sec_cnt_erased   = 0u;
+                             sec_ix_next      = sec_ix + 1u;    /* Set next potentially erased sec.                     */
+                             break;
+                    }
 
-                         } else {
-                             sec_cnt_invalid++;
-                         }
-                         sec_cnt_invalid += sec_cnt_erased;     /* No erased secs precede valid secs.                   */
-                         sec_cnt_erased   = 0u;
-                         sec_ix_next      = sec_ix + 1u;        /* Set next potentially erased sec.                     */
-                         break;
-
-                    case FS_DEV_NOR_STATUS_SEC_WRITING:         /* No erased secs precede invalid secs.                 */
-                    case FS_DEV_NOR_STATUS_SEC_INVALID:
-                    default:
-                         sec_cnt_invalid += sec_cnt_erased + 1u;
-                         sec_cnt_erased   = 0u;
-                         sec_ix_next      = sec_ix + 1u;        /* Set next potentially erased sec.                     */
-                         break;
+                    blk_addr += p_nor_data->SecSize + FS_DEV_NOR_SEC_HDR_LEN;
+                    sec_ix++;
+                    sec_nbr_phy++;
                 }
 
-                blk_addr += p_nor_data->SecSize + FS_DEV_NOR_SEC_HDR_LEN;
-                sec_ix++;
-                sec_nbr_phy++;
-            }
-
-            if ((sec_ix_next == p_nor_data->BlkSecCnts) &&      /* If final sec is invalid     ...                      */
-                (sec_valid   == DEF_NO)) {                      /* ... & blk has no valid data ...                      */
+                if ((sec_ix_next == p_nor_data->BlkSecCnts) &&  /* If final sec is invalid     ...                      */
+                    (sec_valid   == DEF_NO)) {                  /* ... & blk has no valid data ...                      */
                                                                 /* ... add blk to erase q.                              */
-                erased = DEF_NO;
-                FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Valid blk found % 4d w/ erase cnt % 4d; blk should be erased.\r\n", p_nor_data->BlkNbrFirst + blk_ix, erase_cnt));
+                    erased = DEF_NO;
+                    FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Valid blk found % 4d w/ erase cnt % 4d; blk should be erased.\r\n", p_nor_data->BlkNbrFirst + blk_ix, erase_cnt));
 
 
-            } else if (sec_ix_next == 0u) {
-                erased = DEF_YES;
-                blk_cnt_erased++;
-                FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Valid blk found % 4d w/ erase cnt % 4d; blk is erased.\r\n", p_nor_data->BlkNbrFirst + blk_ix, erase_cnt));
+                } else if (sec_ix_next == 0u) {
+                    erased = DEF_YES;
+                    blk_cnt_erased++;
+                    FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Valid blk found % 4d w/ erase cnt % 4d; blk is erased.\r\n", p_nor_data->BlkNbrFirst + blk_ix, erase_cnt));
 
 
-            } else {
-                erased = DEF_NO;
+                } else {
+                    erased = DEF_NO;
 
-                if (sec_cnt_erased > 0u) {
-                    active = FSDev_NOR_AB_Add(p_nor_data,       /* Try to add to list of active blks ...                */
-                                              blk_ix,
-                                              sec_ix_next);
-                    if (active != DEF_OK) {                     /* ... if it could NOT be added      ...                */
-                        FS_TRACE_LOG(("FSDev_NOR_LowMountHandler(): Could not make blk %d active blk; reclassifying %d erased secs as invalid.\r\n", blk_ix, sec_cnt_erased));
-                        sec_cnt_invalid += sec_cnt_erased;      /* ... reclassify secs as invalid.                      */
-                        sec_cnt_erased   = 0u;
+                    if (sec_cnt_erased > 0u) {
+                        active = FSDev_NOR_AB_Add(p_nor_data,   /* Try to add to list of active blks ...                */
+                                                  blk_ix,
+                                                  sec_ix_next);
+                        if (active != DEF_OK) {                 /* ... if it could NOT be added      ...                */
+                            FS_TRACE_LOG(("FSDev_NOR_LowMountHandler(): Could not make blk %d active blk; reclassifying %d erased secs as invalid.\r\n", blk_ix, sec_cnt_erased));
+                            sec_cnt_invalid += sec_cnt_erased;  /* ... reclassify secs as invalid.                      */
+                            sec_cnt_erased   = 0u;
+                        }
                     }
-                }
 
-                if ((sec_cnt_erased != 0u) || (sec_cnt_valid != 0u)) {
-                    blk_cnt_valid++;
-                    FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Valid blk found % 4d w/ erase cnt % 4d; blk has % 4d valid, % 4d erased secs.\r\n", p_nor_data->BlkNbrFirst + blk_ix, erase_cnt, sec_cnt_valid, (sec_ix_next == FS_DEV_NOR_SEC_NBR_INVALID) ? 0u : (p_nor_data->BlkSecCnts - sec_ix_next)));
+                    if ((sec_cnt_erased != 0u) || (sec_cnt_valid != 0u)) {
+                        blk_cnt_valid++;
+                        FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Valid blk found % 4d w/ erase cnt % 4d; blk has % 4d valid, % 4d erased secs.\r\n", p_nor_data->BlkNbrFirst + blk_ix, erase_cnt, sec_cnt_valid, (sec_ix_next == FS_DEV_NOR_SEC_NBR_INVALID) ? 0u : (p_nor_data->BlkSecCnts - sec_ix_next)));
 
-                }
+                    }
 #if (FS_TRACE_LEVEL >= TRACE_LEVEL_DBG)
-                  else {
-                    FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Valid blk found % 4d w/ erase cnt % 4d; blk should be erased.\r\n", p_nor_data->BlkNbrFirst + blk_ix, erase_cnt));
-                }
+                      else {
+                        FS_TRACE_DBG(("FSDev_NOR_LowMountHandler(): Valid blk found % 4d w/ erase cnt % 4d; blk should be erased.\r\n", p_nor_data->BlkNbrFirst + blk_ix, erase_cnt));
+                    }
 #endif
-            }
+                }
 
-            p_nor_data->SecCntErased  += sec_cnt_erased;
-            p_nor_data->SecCntValid   += sec_cnt_valid;
-            p_nor_data->SecCntInvalid += sec_cnt_invalid;
-        }
+                p_nor_data->SecCntErased  += sec_cnt_erased;
+                p_nor_data->SecCntValid   += sec_cnt_valid;
+                p_nor_data->SecCntInvalid += sec_cnt_invalid;
+            }
 
-        FSDev_NOR_SetBlkErased(p_nor_data,                      /* Update erase map.                                    */
-                               blk_ix,
-                               erased);
+            FSDev_NOR_SetBlkErased(p_nor_data,                  /* Update erase map.                                    */
+                                   blk_ix,
+                                   erased);
 
-        FSDev_NOR_SetBlkSecCntValid(p_nor_data,                 /* Update sec cnt valid tbl.                            */
-                                    blk_ix,
-                                    sec_cnt_valid);
+            FSDev_NOR_SetBlkSecCntValid(p_nor_data,             /* Update sec cnt valid tbl.                            */
+                                        blk_ix,
+                                        sec_cnt_valid);
 
-        blk_ix++;
+            blk_ix++;
+        }
     }
 
 
@@ -2397,11 +2837,15 @@ static  void  FSDev_NOR_LowMountHandler (FS_DEV_NOR_DATA  *p_nor_data,
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
-*                               FS_ERR_NONE    Device unmounted.
+*                               FS_ERR_NONE           Device unmounted.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) If checkpoints are enabled, a mounted device is checkpointed before being unmounted,
+*                   unless no block was erased since the most recent checkpoint.  The next mount then
+*                   scans at most the sectors written since in the active blocks.
 *********************************************************************************************************
 */
 
@@ -2412,6 +2856,21 @@ static  void  FSDev_NOR_LowUnmountHandler (FS_DEV_NOR_DATA  *p_nor_data,
     FS_SEC_NBR  sec_nbr_logical;
 
 
+#if ((FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED) && \
+     (FS_CFG_RD_ONLY_EN      == DEF_DISABLED))
+                                                                /* ---------------------- WR CKPT --------------------- */
+    if (p_nor_data->Mounted == DEF_YES) {                       /* See Note #1.                                         */
+        if ((p_nor_data->CkptValid    == DEF_NO) ||
+            (p_nor_data->CkptEraseCtr >  0u)) {
+            FSDev_NOR_CkptWr(p_nor_data, p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+        }
+    }
+#endif
+
+
                                                                 /* ------------------- CLR BLK INFO ------------------- */
     blk_ix = 0u;
     while (blk_ix < p_nor_data->BlkCntUsed) {
@@ -2457,6 +2916,11 @@ static  void  FSDev_NOR_LowUnmountHandler (FS_DEV_NOR_DATA  *p_nor_data,
     p_nor_data->EraseCntMin       = 0u;
     p_nor_data->EraseCntMax       = 0u;
 
+#if (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED)
+    p_nor_data->WearLevelEraseCtr = 0u;
+    p_nor_data->WearLevelPeriod   = FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD;
+#endif
+
     p_nor_data->Mounted           = DEF_NO;
 
    *p_err = FS_ERR_NONE;
@@ -2616,284 +3080,415 @@ static  void  FSDev_NOR_LowDefragHandler (FS_DEV_NOR_DATA  *p_nor_data,
 
 /*
 *********************************************************************************************************
-*                                      FSDev_NOR_PhyRdHandler()
+*                                     FSDev_NOR_WearInfoHandler()
 *
-* Description : Read data octets from NOR.
+* Description : Get wear information of NOR.
 *
 * Argument(s) : p_nor_data  Pointer to NOR data.
 *               ----------  Argument validated by caller.
 *
-*               p_dest      Pointer to destination buffer.
+*               p_info      Pointer to structure that will receive wear information.
 *               ----------  Argument validated by caller.
 *
-*               start       Start address of read (relative to start of device).
-*
-*               cnt         Number of octets to read.
-*
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
-*                               FS_ERR_NONE           Octets read successfully.
-*                               FS_ERR_DEV_IO         Device I/O error.
-*                               FS_ERR_DEV_TIMEOUT    Device timeout.
+*                               FS_ERR_NONE                   Wear information obtained.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The block headers are read twice : first to find the erase count range, then to fill
+*                   the histogram, whose bins span that range.  The sum of erase counts is accumulated
+*                   relative to the minimum, so that it cannot overflow.
+*
+*               (2) The minimum erase count is refreshed (see 'FSDev_NOR_FindEraseBlkWear()  Note #1a').
 *********************************************************************************************************
 */
 
-static  void  FSDev_NOR_PhyRdHandler (FS_DEV_NOR_DATA  *p_nor_data,
-                                      void             *p_dest,
-                                      CPU_INT32U        start,
-                                      CPU_INT32U        cnt,
-                                      FS_ERR           *p_err)
+static  void  FSDev_NOR_WearInfoHandler (FS_DEV_NOR_DATA       *p_nor_data,
+                                         FS_DEV_NOR_WEAR_INFO  *p_info,
+                                         FS_ERR                *p_err)
 {
-                                                                /* ---------------------- RD DATA --------------------- */
-    p_nor_data->PhyPtr->Rd(p_nor_data->PhyDataPtr,
-                           p_dest,
-                           start,
-                           cnt,
-                           p_err);
+    CPU_INT08U  blk_hdr[FS_DEV_NOR_BLK_HDR_LEN];
+    FS_SEC_QTY  blk_cnt;
+    FS_SEC_NBR  blk_ix;
+    CPU_INT32U  bin_ix;
+    CPU_INT32U  bin_width;
+    CPU_INT32U  endurance;
+    CPU_INT32U  erase_cnt;
+    CPU_INT32U  erase_cnt_max;
+    CPU_INT32U  erase_cnt_min;
+    CPU_INT32U  erase_cnt_rem;
+    CPU_INT32U  erase_cnt_sum;
+    CPU_INT32U  pct;
 
-    if (*p_err != FS_ERR_NONE) {
-        FS_CTR_ERR_INC(p_nor_data->ErrRdCtr);
+
+    if (p_nor_data->Mounted == DEF_NO) {
+       *p_err = FS_ERR_DEV_INVALID_LOW_FMT;
         return;
     }
 
-#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)                         /* Update rd ctrs.                                      */
-    if (cnt == p_nor_data->SecSize) {
-        FS_CTR_STAT_INC(p_nor_data->StatRdCtr);
+    Mem_Clr((void *)p_info, sizeof(FS_DEV_NOR_WEAR_INFO));
+
+
+
+                                                                /* -------- FIND ERASE CNT RANGE (see Note #1) -------- */
+    blk_cnt       = 0u;
+    erase_cnt_min = DEF_INT_32U_MAX_VAL;
+    erase_cnt_max = 0u;
+    blk_ix        = 0u;
+    while (blk_ix < p_nor_data->BlkCntUsed) {
+        FSDev_NOR_RdBlkHdr( p_nor_data,
+                           &blk_hdr[0],
+                            blk_ix,
+                            p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+
+        erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT]);
+        if (erase_cnt != FS_DEV_NOR_BLK_HDR_ERASE_CNT_INVALID) {
+            erase_cnt_min = DEF_MIN(erase_cnt_min, erase_cnt);
+            erase_cnt_max = DEF_MAX(erase_cnt_max, erase_cnt);
+            blk_cnt++;
+        }
+
+        blk_ix++;
+    }
+
+    if (blk_cnt == 0u) {
+        erase_cnt_min = 0u;
     } else {
-        FS_CTR_STAT_ADD(p_nor_data->StatRdOctetCtr, cnt);
+        p_nor_data->EraseCntMin = erase_cnt_min;                /* See Note #2.                                         */
+    }
+
+
+
+                                                                /* -------------- FILL HIST (see Note #1) ------------- */
+    bin_width     = ((erase_cnt_max - erase_cnt_min) / FS_DEV_NOR_WEAR_HIST_BIN_NBR) + 1u;
+    erase_cnt_sum = 0u;
+    blk_ix        = 0u;
+    while ((blk_ix  < p_nor_data->BlkCntUsed) &&
+           (blk_cnt > 0u)) {
+        FSDev_NOR_RdBlkHdr( p_nor_data,
+                           &blk_hdr[0],
+                            blk_ix,
+                            p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+
+        erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT]);
+        if ((erase_cnt != FS_DEV_NOR_BLK_HDR_ERASE_CNT_INVALID) &&
+            (erase_cnt >= erase_cnt_min)) {
+            bin_ix         = (erase_cnt - erase_cnt_min) / bin_width;
+            bin_ix         =  DEF_MIN(bin_ix, FS_DEV_NOR_WEAR_HIST_BIN_NBR - 1u);
+            p_info->Hist[bin_ix]++;
+            erase_cnt_sum += erase_cnt - erase_cnt_min;
+        }
+
+        blk_ix++;
+    }
+
+
+
+                                                                /* ------------------- CALC LIFE REM ------------------ */
+    endurance     = p_nor_data->Endurance;
+    erase_cnt_rem = (erase_cnt_max < endurance) ? (endurance - erase_cnt_max) : 0u;
+    if (endurance > (DEF_INT_32U_MAX_VAL / 100u)) {
+        pct = erase_cnt_rem / (endurance / 100u);
+    } else {
+        pct = (erase_cnt_rem * 100u) / endurance;
     }
+
+
+
+                                                                /* --------------------- RTN INFO --------------------- */
+    p_info->BlkCnt         = blk_cnt;
+    p_info->EraseCntMin    = erase_cnt_min;
+    p_info->EraseCntMax    = erase_cnt_max;
+    p_info->EraseCntAvg    = (blk_cnt == 0u) ? 0u : (erase_cnt_min + (erase_cnt_sum / blk_cnt));
+    p_info->EraseCntSpread = erase_cnt_max - erase_cnt_min;
+    p_info->EraseCntTh     = p_nor_data->EraseCntDiffTh;
+    p_info->HistBinWidth   = bin_width;
+    p_info->Endurance      = endurance;
+    p_info->EraseCntRem    = erase_cnt_rem;
+    p_info->LifeRemPct     = (CPU_INT08U)DEF_MIN(pct, 100u);
+#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
+    p_info->WearLevelStaticCnt = p_nor_data->StatWearLevelStaticCtr;
+    p_info->WearLevelActiveCnt = p_nor_data->StatWearLevelActiveCtr;
 #endif
+
+   *p_err = FS_ERR_NONE;
 }
 
 
 /*
 *********************************************************************************************************
-*                                      FSDev_NOR_PhyWrHandler()
+*                                    FSDev_NOR_WearLevelHandler()
 *
-* Description : Write data octets to NOR.
+* Description : Perform one step of static wear leveling : migrate the data of one cold block.
 *
 * Argument(s) : p_nor_data  Pointer to NOR data.
 *               ----------  Argument validated by caller.
 *
-*               p_src       Pointer to source buffer.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
-*               start       Start address of write (relative to start of device).
+*                               FS_ERR_NONE                   Step performed (or nothing to do).
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout.
 *
-*               cnt         Number of octets to write.
+* Return(s)   : DEF_YES, if a block was migrated,
+*               DEF_NO,  otherwise.
 *
-*               p_err       Pointer to variable that will receive the return error code from this function :
-*               ----------  Argument validated by caller.
+* Note(s)     : (1) Active wear leveling (see 'FSDev_NOR_FindEraseBlkWear()  Note #1') only moves a cold
+*                   block once the erase count spread reaches 'EraseCntDiffTh', & then does so for every
+*                   such block at once, from within a sector write.  Static wear leveling starts earlier,
+*                   at FS_DEV_NOR_CFG_WEAR_LEVEL_TH_PCT percent of that threshold, & moves one block per
+*                   step, so that the spread seldom reaches the active threshold.
 *
-*                               FS_ERR_NONE           Octets written successfully.
-*                               FS_ERR_DEV_IO         Device I/O error.
-*                               FS_ERR_DEV_TIMEOUT    Device timeout.
+*                   (a) The least-erased block is selected.  Once its data is moved & it is erased, it is
+*                       the first erased block to become active (see 'FSDev_NOR_FindErasedBlk()  Note #1'),
+*                       so that it then receives frequently-rewritten data.
 *
-* Return(s)   : none.
+*               (2) The period between steps triggered from the write path is halved for each erase cycle
+*                   by which the spread exceeds the static threshold 'th' (see Note #1) :
 *
-* Note(s)     : (1) A program operation can only change a '1' bit to a '0' bit.  Other program operations
-*                   may cause low-level driver errors, or the program operation may fail.  A write
-*                   that attempts to change a '0' bit to a '1' bit indicates improper driver function.
+*                       'WearLevelPeriod'  =  FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD >> (spread - th)
 *
-*               (2) The success of high-level write operations can be checked by volume write check
-*                   functionality.  The check here covers write operations for low-level data (e.g.,
-*                   block & sector headers).
+*                   At the threshold, one block is moved every FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD block erases,
+*                   bounding the extra write latency.  If much data is static, the cold blocks must be moved
+*                   about as often as the others are erased to keep the spread bounded; the period then
+*                   falls to one erase within a few cycles above the threshold.
+*
+*               (3) The move needs an erased block (see 'FSDev_NOR_EraseBlkPrepare()  Note #3'), which is
+*                   reclaimed first, exactly as before a sector write.  This may itself erase the selected
+*                   block through active wear leveling; another cold block is then selected, so that
+*                   DEF_YES is only returned once a cold block has actually been moved.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  void  FSDev_NOR_PhyWrHandler (FS_DEV_NOR_DATA  *p_nor_data,
-                                      void             *p_src,
-                                      CPU_INT32U        start,
-                                      CPU_INT32U        cnt,
-                                      FS_ERR           *p_err)
+#if ((FS_CFG_RD_ONLY_EN                   == DEF_DISABLED) && \
+     (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED))
+static  CPU_BOOLEAN  FSDev_NOR_WearLevelHandler (FS_DEV_NOR_DATA  *p_nor_data,
+                                                 FS_ERR           *p_err)
 {
-#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)
-    CPU_INT08U   data_rd[2];
-    CPU_INT08U   data_wr_01;
-    CPU_INT08U   data_wr_02;
-    CPU_INT08U  *p_src_08;
-    CPU_INT32U   addr;
-    CPU_INT32U   cnt_rem;
-#endif
+    CPU_BOOLEAN  active;
+    FS_SEC_NBR   blk_ix;
+    FS_SEC_NBR   blk_ix_cold;
+    CPU_BOOLEAN  erased;
+    CPU_INT32U   period;
+    FS_SEC_QTY   sec_cnt_valid;
+    CPU_INT32U   spread;
+    CPU_INT32U   th;
 
 
-#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)                   /* ------------------- CHK PGM VALID ------------------ */
-    p_src_08 = (CPU_INT08U *)p_src;
-    addr     =  start;
-    cnt_rem  =  cnt;
-    while (cnt_rem >= 2u) {
-        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* Rd cur data.                                         */
-                               &data_rd[0],
-                                addr,
-                                2u,
-                                p_err);
+    if (p_nor_data->Mounted == DEF_NO) {
+       *p_err = FS_ERR_DEV_INVALID_LOW_FMT;
+        return (DEF_NO);
+    }
 
-        data_wr_01 = *p_src_08++;
-        data_wr_02 = *p_src_08++;
-                                                                /* Chk bits (see Note #1).                              */
-        if ((((CPU_INT08U)(data_wr_01 ^ data_rd[0]) & (CPU_INT08U)~data_rd[0]) != 0x00u) ||
-            (((CPU_INT08U)(data_wr_02 ^ data_rd[1]) & (CPU_INT08U)~data_rd[1]) != 0x00u)) {
-            FS_CTR_ERR_INC(p_nor_data->ErrWrFailCtr);
-            FS_TRACE_DBG(("FSDev_NOR_PhyWrHandler(): Trying to write 0x%02X%02X over 0x%02X%02X.\r\n", data_wr_01, data_wr_02, data_rd[0], data_rd[1]));
-           *p_err = FS_ERR_DEV_IO;
-            return;
-        }
+    p_nor_data->WearLevelEraseCtr = 0u;
+    p_nor_data->WearLevelPeriod   = FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD;
 
-        addr    += 2u;
-        cnt_rem -= 2u;
-    }
-#endif
+    th = ((CPU_INT32U)p_nor_data->EraseCntDiffTh * FS_DEV_NOR_CFG_WEAR_LEVEL_TH_PCT) / 100u;
+    th =   DEF_MAX(th, 1u);
 
 
-                                                                /* ---------------------- WR DATA --------------------- */
-    p_nor_data->PhyPtr->Wr(p_nor_data->PhyDataPtr,
-                           p_src,
-                           start,
-                           cnt,
-                           p_err);
 
+                                                                /* ------------ FIND COLD BLK (see Note #1) ----------- */
+    if (p_nor_data->EraseCntMax < p_nor_data->EraseCntMin + th) {
+       *p_err = FS_ERR_NONE;
+        return (DEF_NO);
+    }
+
+    blk_ix_cold = FSDev_NOR_FindBlkCold(p_nor_data, th, p_err);
     if (*p_err != FS_ERR_NONE) {
-        FS_CTR_ERR_INC(p_nor_data->ErrWrCtr);
-        return;
+        return (DEF_NO);
     }
 
-#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)                   /* ------------------ CHK PGM SUCCESS ----------------- */
-    p_src_08 = (CPU_INT08U *)p_src;
-    addr     =  start;
-    cnt_rem  =  cnt;
-    while (cnt_rem >= 2u) {
-        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* Rd new data.                                         */
-                               &data_rd[0],
-                                addr,
-                                2u,
-                                p_err);
+    spread = p_nor_data->EraseCntMax - p_nor_data->EraseCntMin; /* Min refreshed by FSDev_NOR_FindBlkCold().            */
+    if (spread >= th) {                                         /* Adapt period (see Note #2).                          */
+        period = FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD >> DEF_MIN(spread - th, 31u);
+        p_nor_data->WearLevelPeriod = DEF_MAX(period, 1u);
+    }
 
-        data_wr_01 = *p_src_08++;
-        data_wr_02 = *p_src_08++;
+    if (blk_ix_cold == FS_DEV_NOR_SEC_NBR_INVALID) {
+       *p_err = FS_ERR_NONE;
+        return (DEF_NO);
+    }
 
-        if ((data_wr_01 != data_rd[0]) ||                       /* Cmp to intended data.                                */
-            (data_wr_02 != data_rd[1])) {
-            FS_CTR_ERR_INC(p_nor_data->ErrWrFailCtr);
-            FS_TRACE_DBG(("FSDev_NOR_PhyWrHandler(): Data compare failed 0x%02X%02X != 0x%02X%02X.\r\n", data_wr_01, data_wr_02, data_rd[0], data_rd[1]));
-           *p_err = FS_ERR_DEV_IO;
-            return;
-        }
 
-        addr    += 2u;
-        cnt_rem -= 2u;
-    }
-#endif
 
-#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)                         /* Update wr ctrs.                                      */
-    if (cnt == p_nor_data->SecSize) {
-        FS_CTR_STAT_INC(p_nor_data->StatWrCtr);
-    } else {
-        FS_CTR_STAT_ADD(p_nor_data->StatWrOctetCtr, cnt);
+                                                                /* -------------- FREE BLK (see Note #3) -------------- */
+    blk_ix = FSDev_NOR_FindEraseBlk(p_nor_data);
+    while (blk_ix != FS_DEV_NOR_SEC_NBR_INVALID) {
+        FSDev_NOR_EraseBlkPrepare(p_nor_data, blk_ix, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (DEF_NO);
+        }
+        blk_ix = FSDev_NOR_FindEraseBlk(p_nor_data);
     }
-#endif
+
+
+
+                                                                /* ------------------- MOVE COLD BLK ------------------ */
+    FSDev_NOR_GetBlkInfo( p_nor_data,
+                          blk_ix_cold,
+                         &erased,
+                         &sec_cnt_valid);
+    active = FSDev_NOR_IsAB(p_nor_data, blk_ix_cold);
+    if ((erased == DEF_YES) ||                                  /* If blk erased or active (see Note #3) ...            */
+        (active == DEF_YES)) {
+                                                                /* ... sel another cold blk.                            */
+        blk_ix_cold = FSDev_NOR_FindBlkCold(p_nor_data, th, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (DEF_NO);
+        }
+        if (blk_ix_cold == FS_DEV_NOR_SEC_NBR_INVALID) {
+            return (DEF_NO);
+        }
+        FSDev_NOR_GetBlkInfo( p_nor_data,
+                              blk_ix_cold,
+                             &erased,
+                             &sec_cnt_valid);
+    }
+
+    FS_TRACE_LOG(("FSDev_NOR_WearLevelHandler(): Moving cold blk %d (%d valid secs).\r\n", blk_ix_cold, sec_cnt_valid));
+    FSDev_NOR_EraseBlkPrepare(p_nor_data, blk_ix_cold, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (DEF_NO);
+    }
+
+    FS_CTR_STAT_INC(p_nor_data->StatWearLevelStaticCtr);
+    return (DEF_YES);
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*                                   FSDev_NOR_PhyEraseBlkHandler()
+*                                       FSDev_NOR_FindBlkCold()
 *
-* Description : Erase block.
+* Description : Find cold block to migrate (for static wear leveling).
 *
 * Argument(s) : p_nor_data  Pointer to NOR data.
 *               ----------  Argument validated by caller.
 *
-*               start       Start address of block (relative to start of device).
-*
-*               size        Size of block, in octets.
+*               th          Erase count difference from maximum above which a block is cold.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
-*                               FS_ERR_NONE           Block erased successfully.
+*                               FS_ERR_NONE           Search performed.
 *                               FS_ERR_DEV_IO         Device I/O error.
 *                               FS_ERR_DEV_TIMEOUT    Device timeout.
 *
-* Return(s)   : none.
+* Return(s)   : Block index,                if    cold block found.
+*               FS_DEV_NOR_SEC_NBR_INVALID, if NO cold block found.
 *
-* Note(s)     : (1) #### Read back block data to check erase success.
+* Note(s)     : (1) Of the blocks holding data, neither erased nor active, with the lowest erase count,
+*                   the one with the most valid sectors is selected : it most likely holds static data,
+*                   which the write path would otherwise never move.
+*
+*               (2) The minimum erase count is refreshed (see 'FSDev_NOR_FindEraseBlkWear()  Note #1a').
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  void  FSDev_NOR_PhyEraseBlkHandler (FS_DEV_NOR_DATA  *p_nor_data,
-                                            CPU_INT32U        start,
-                                            CPU_INT32U        size,
-                                            FS_ERR           *p_err)
+#if ((FS_CFG_RD_ONLY_EN                   == DEF_DISABLED) && \
+     (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED))
+static  FS_SEC_NBR  FSDev_NOR_FindBlkCold (FS_DEV_NOR_DATA  *p_nor_data,
+                                           CPU_INT32U        th,
+                                           FS_ERR           *p_err)
 {
-#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)
-    CPU_INT32U  addr;
-    CPU_INT32U  cnt_rem;
-    CPU_INT08U  data_rd[16];
-    CPU_INT32U  i;
-#endif
-
+    CPU_BOOLEAN  active;
+    CPU_INT08U   blk_hdr[FS_DEV_NOR_BLK_HDR_LEN];
+    FS_SEC_NBR   blk_ix;
+    FS_SEC_NBR   blk_ix_cold;
+    CPU_BOOLEAN  erased;
+    CPU_INT32U   erase_cnt;
+    CPU_INT32U   erase_cnt_cold;
+    CPU_INT32U   erase_cnt_min;
+    FS_SEC_QTY   sec_cnt_valid;
+    FS_SEC_QTY   sec_cnt_valid_cold;
 
-    p_nor_data->PhyPtr->EraseBlk(p_nor_data->PhyDataPtr,
-                                 start,
-                                 size,
-                                 p_err);
 
-    if (*p_err != FS_ERR_NONE) {
-         FS_CTR_ERR_INC(p_nor_data->ErrEraseCtr);
-         return;
-    }
+    blk_ix             = 0u;
+    blk_ix_cold        = FS_DEV_NOR_SEC_NBR_INVALID;
+    erase_cnt_cold     = DEF_INT_32U_MAX_VAL;
+    erase_cnt_min      = DEF_INT_32U_MAX_VAL;
+    sec_cnt_valid_cold = 0u;
+    while (blk_ix < p_nor_data->BlkCntUsed) {
+        FSDev_NOR_RdBlkHdr( p_nor_data,
+                           &blk_hdr[0],
+                            blk_ix,
+                            p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (FS_DEV_NOR_SEC_NBR_INVALID);
+        }
 
-#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)
-    addr    = start;
-    cnt_rem = size;
-    while (cnt_rem >= sizeof(data_rd)) {
-        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* Rd new data.                                         */
-                               &data_rd[0],
-                                addr,
-                                sizeof(data_rd),
-                                p_err);
+        erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT]);
+        if (erase_cnt != FS_DEV_NOR_BLK_HDR_ERASE_CNT_INVALID) {
+            erase_cnt_min = DEF_MIN(erase_cnt_min, erase_cnt);
 
-        for (i = 0; i < sizeof(data_rd); i++) {
-            if (data_rd[i] != 0xFFu) {                          /* Cmp to erased data.                                  */
-                FS_CTR_ERR_INC(p_nor_data->ErrEraseFailCtr);
-                FS_TRACE_DBG(("FSDev_NOR_PhyEraseBlkHandler(): Data compare failed 0x02X != 0x%02X at 0x%08X.\r\n", data_rd[i], 0xFFu, addr + i));
-               *p_err = FS_ERR_DEV_IO;
-                return;
+            FSDev_NOR_GetBlkInfo( p_nor_data,
+                                  blk_ix,
+                                 &erased,
+                                 &sec_cnt_valid);
+            active = FSDev_NOR_IsAB(p_nor_data, blk_ix);
+                                                                /* If blk holds data & is cold ...                      */
+            if ((erased        == DEF_NO) &&
+                (active        == DEF_NO) &&
+                (sec_cnt_valid >  0u)     &&
+                (p_nor_data->EraseCntMax >= erase_cnt + th)) {
+                                                                /* ... & is colder (see Note #1) ...                    */
+                if ((erase_cnt_cold >  erase_cnt) ||
+                   ((erase_cnt_cold == erase_cnt) && (sec_cnt_valid_cold < sec_cnt_valid))) {
+                    erase_cnt_cold     = erase_cnt;             /* ... sel blk.                                         */
+                    sec_cnt_valid_cold = sec_cnt_valid;
+                    blk_ix_cold        = blk_ix;
+                }
             }
         }
 
-        addr    += sizeof(data_rd);
-        cnt_rem -= sizeof(data_rd);
+        blk_ix++;
     }
-#endif
 
-    FS_CTR_STAT_INC(p_nor_data->StatEraseBlkCtr);
+    if (erase_cnt_min != DEF_INT_32U_MAX_VAL) {
+        p_nor_data->EraseCntMin = erase_cnt_min;                /* See Note #2.                                         */
+    }
+
+   *p_err = FS_ERR_NONE;
+    return (blk_ix_cold);
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*                                   FSDev_NOR_PhyEraseChipHandler()
+*                                      FSDev_NOR_PhyRdHandler()
 *
-* Description : Erase chip.
+* Description : Read data octets from NOR.
 *
 * Argument(s) : p_nor_data  Pointer to NOR data.
 *               ----------  Argument validated by caller.
 *
+*               p_dest      Pointer to destination buffer.
+*               ----------  Argument validated by caller.
+*
+*               start       Start address of read (relative to start of device).
+*
+*               cnt         Number of octets to read.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
-*                               FS_ERR_NONE           Block erased successfully.
+*                               FS_ERR_NONE           Octets read successfully.
 *                               FS_ERR_DEV_IO         Device I/O error.
 *                               FS_ERR_DEV_TIMEOUT    Device timeout.
 *
@@ -2903,101 +3498,436 @@ static  void  FSDev_NOR_PhyEraseBlkHandler (FS_DEV_NOR_DATA  *p_nor_data,
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  void  FSDev_NOR_PhyEraseChipHandler(FS_DEV_NOR_DATA  *p_nor_data,
-                                            FS_ERR           *p_err)
+static  void  FSDev_NOR_PhyRdHandler (FS_DEV_NOR_DATA  *p_nor_data,
+                                      void             *p_dest,
+                                      CPU_INT32U        start,
+                                      CPU_INT32U        cnt,
+                                      FS_ERR           *p_err)
 {
-    p_nor_data->PhyPtr->IO_Ctrl(p_nor_data->PhyDataPtr,
-                                FS_DEV_IO_CTRL_PHY_ERASE_CHIP,
-                                DEF_NULL,
-                                p_err);
-}
+                                                                /* ---------------------- RD DATA --------------------- */
+    p_nor_data->PhyPtr->Rd(p_nor_data->PhyDataPtr,
+                           p_dest,
+                           start,
+                           cnt,
+                           p_err);
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_CTR_ERR_INC(p_nor_data->ErrRdCtr);
+        return;
+    }
+
+#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)                         /* Update rd ctrs.                                      */
+    if (cnt == p_nor_data->SecSize) {
+        FS_CTR_STAT_INC(p_nor_data->StatRdCtr);
+    } else {
+        FS_CTR_STAT_ADD(p_nor_data->StatRdOctetCtr, cnt);
+    }
 #endif
+}
 
 
 /*
 *********************************************************************************************************
-*                                       FSDev_NOR_CalcDevInfo()
+*                                    FSDev_NOR_PhyRdMultiHandler()
 *
-* Description : Calculate NOR device info.
+* Description : Read strided chunks of data octets from NOR with a single command.
 *
 * Argument(s) : p_nor_data  Pointer to NOR data.
 *               ----------  Argument validated by caller.
 *
+*               p_dest      Pointer to destination buffer.
+*               ----------  Argument validated by caller.
+*
+*               start       Start address of first chunk (relative to start of device).
+*
+*               cnt         Number of octets in each chunk.
+*
+*               stride      Distance between the start addresses of consecutive chunks, in octets.
+*
+*               nbr         Number of chunks to read.
+*
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
-*                               FS_ERR_NONE                      Device info calculated.
-*                               FS_ERR_DEV_INVALID_CFG           Device configuration specified invalid.
-*                               FS_ERR_DEV_INVALID_LOW_PARAMS    Device low-level parameters invalid.
-*                               FS_ERR_DEV_IO                    Device I/O error.
-*                               FS_ERR_DEV_TIMEOUT               Device timeout.
+*                               FS_ERR_NONE           Octets read successfully.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) Block & block region information supplied by the phy driver are strictly checked :
-*                   (a) As least one block must exist.
-*                   (b) All blocks must be large enough for at least one data sector.
-*                   (c) The configured data region start must lie within the block region.
-*
-*               (2) At least one block's worth of sectors MUST be reserved.
+* Note(s)     : (1) Chunks are stored in consecutive locations of 'p_dest'.  See 'fs_dev_nor.h  NOR FLASH
+*                   DEVICE PHYSICAL DRIVER API DATA TYPE  Note #1'.
 *********************************************************************************************************
 */
 
-static  void  FSDev_NOR_CalcDevInfo (FS_DEV_NOR_DATA  *p_nor_data,
-                                     FS_ERR           *p_err)
+static  void  FSDev_NOR_PhyRdMultiHandler (FS_DEV_NOR_DATA  *p_nor_data,
+                                           void             *p_dest,
+                                           CPU_INT32U        start,
+                                           CPU_INT32U        cnt,
+                                           CPU_INT32U        stride,
+                                           CPU_INT32U        nbr,
+                                           FS_ERR           *p_err)
 {
-    FS_SEC_QTY   ab_cnt;
-    CPU_ADDR     blk_addr;
-    FS_SEC_QTY   blk_cnt;
-    FS_SEC_NBR   blk_nbr;
-    FS_SEC_SIZE  data_size_blk;
-    FS_SEC_QTY   sec_cnt_blk;
-    FS_SEC_QTY   sec_cnt_tot;
-    FS_SEC_QTY   sec_cnt_rsvd;
-    FS_SEC_QTY   sec_cnt_data;
-
-
-                                                                /* ------------ CHK PHY INFO (see Note #1) ------------ */
-    if (p_nor_data->PhyDataPtr->BlkCnt == 0u) {                 /* Validate blk cnt.                                    */
-        FS_TRACE_DBG(("FSDev_NOR_CalcDevInfo(): Phy info invalid: BlkCnt == 0.\r\n"));
-       *p_err = FS_ERR_DEV_INVALID_LOW_PARAMS;
-        return;
-    }
-                                                                /* Validate blk size.                                   */
-    if (p_nor_data->PhyDataPtr->BlkSize < p_nor_data->SecSize + FS_DEV_NOR_BLK_HDR_LEN + FS_DEV_NOR_SEC_HDR_LEN) {
-        FS_TRACE_DBG(("FSDev_NOR_CalcDevInfo(): Phy info invalid: BlkSize = %d < %d.\r\n", p_nor_data->PhyDataPtr->BlkSize, p_nor_data->SecSize + FS_DEV_NOR_BLK_HDR_LEN + FS_DEV_NOR_SEC_HDR_LEN));
-       *p_err = FS_ERR_DEV_INVALID_LOW_PARAMS;
-        return;
-    }
+                                                                /* ---------------------- RD DATA --------------------- */
+    p_nor_data->PhyPtr->RdMulti(p_nor_data->PhyDataPtr,
+                                p_dest,
+                                start,
+                                cnt,
+                                stride,
+                                nbr,
+                                p_err);
 
-    if (p_nor_data->PhyDataPtr->AddrRegionStart < p_nor_data->PhyDataPtr->AddrBase) {
-        FS_TRACE_DBG(("FSDev_NOR_CalcDevInfo(): Phy info invalid: AddrRegionStart = %d < %d.\r\n", p_nor_data->PhyDataPtr->AddrRegionStart, p_nor_data->PhyDataPtr->AddrBase));
-       *p_err = FS_ERR_DEV_INVALID_LOW_PARAMS;
+    if (*p_err != FS_ERR_NONE) {
+        FS_CTR_ERR_INC(p_nor_data->ErrRdCtr);
         return;
     }
 
-
-
-                                                                /* ------------ FIND 1ST BLK OF FILE SYSTEM ----------- */
-    blk_nbr  = 0u;
-    blk_addr = p_nor_data->PhyDataPtr->AddrRegionStart;
-    while ((blk_addr < p_nor_data->AddrStart) &&                /* While addr of blk before start of file system ...    */
-           (blk_nbr  < p_nor_data->PhyDataPtr->BlkCnt)) {       /* ... & more blocks rem                         ...    */
-                                                                /* ... get start addr of next blk.                      */
-        blk_addr += (CPU_ADDR)p_nor_data->PhyDataPtr->BlkSize;
-        blk_nbr++;
-    }
-
-    if (blk_addr < p_nor_data->AddrStart) {                     /* Start addr after last blk in dev.                    */
-        FS_TRACE_DBG(("FSDev_NOR_InfoCalc(): Start address of file system (0x%08X) after last blk in dev region.\r\n", p_nor_data->AddrStart));
-       *p_err = FS_ERR_DEV_INVALID_CFG;
-        return;
+#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)                         /* Update rd ctrs.                                      */
+    if (cnt == p_nor_data->SecSize) {
+        FS_CTR_STAT_ADD(p_nor_data->StatRdCtr, (FS_CTR)nbr);
+    } else {
+        FS_CTR_STAT_ADD(p_nor_data->StatRdOctetCtr, cnt * nbr);
     }
+#endif
+}
 
 
+/*
+*********************************************************************************************************
+*                                      FSDev_NOR_PhyWrHandler()
+*
+* Description : Write data octets to NOR.
+*
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------  Argument validated by caller.
+*
+*               p_src       Pointer to source buffer.
+*               ----------  Argument validated by caller.
+*
+*               start       Start address of write (relative to start of device).
+*
+*               cnt         Number of octets to write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE           Octets written successfully.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) A program operation can only change a '1' bit to a '0' bit.  Other program operations
+*                   may cause low-level driver errors, or the program operation may fail.  A write
+*                   that attempts to change a '0' bit to a '1' bit indicates improper driver function.
+*
+*               (2) The success of high-level write operations can be checked by volume write check
+*                   functionality.  The check here covers write operations for low-level data (e.g.,
+*                   block & sector headers).
+*********************************************************************************************************
+*/
 
-                                                                /* ------------------- CALC SEC QTY ------------------- */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSDev_NOR_PhyWrHandler (FS_DEV_NOR_DATA  *p_nor_data,
+                                      void             *p_src,
+                                      CPU_INT32U        start,
+                                      CPU_INT32U        cnt,
+                                      FS_ERR           *p_err)
+{
+#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)
+    CPU_INT08U   data_rd[2];
+    CPU_INT08U   data_wr_01;
+    CPU_INT08U   data_wr_02;
+    CPU_INT08U  *p_src_08;
+    CPU_INT32U   addr;
+    CPU_INT32U   cnt_rem;
+#endif
+
+
+#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)                   /* ------------------- CHK PGM VALID ------------------ */
+    p_src_08 = (CPU_INT08U *)p_src;
+    addr     =  start;
+    cnt_rem  =  cnt;
+    while (cnt_rem >= 2u) {
+        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* Rd cur data.                                         */
+                               &data_rd[0],
+                                addr,
+                                2u,
+                                p_err);
+
+        data_wr_01 = *p_src_08++;
+        data_wr_02 = *p_src_08++;
+                                                                /* Chk bits (see Note #1).                              */
+        if ((((CPU_INT08U)(data_wr_01 ^ data_rd[0]) & (CPU_INT08U)~data_rd[0]) != 0x00u) ||
+            (((CPU_INT08U)(data_wr_02 ^ data_rd[1]) & (CPU_INT08U)~data_rd[1]) != 0x00u)) {
+            FS_CTR_ERR_INC(p_nor_data->ErrWrFailCtr);
+            FS_TRACE_DBG(("FSDev_NOR_PhyWrHandler(): Trying to write 0x%02X%02X over 0x%02X%02X.\r\n", data_wr_01, data_wr_02, data_rd[0], data_rd[1]));
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
+
+        addr    += 2u;
+        cnt_rem -= 2u;
+    }
+#endif
+
+
+                                                                /* ---------------------- WR DATA --------------------- */
+    p_nor_data->PhyPtr->Wr(p_nor_data->PhyDataPtr,
+                           p_src,
+                           start,
+                           cnt,
+                           p_err);
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_CTR_ERR_INC(p_nor_data->ErrWrCtr);
+        return;
+    }
+
+#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)                   /* ------------------ CHK PGM SUCCESS ----------------- */
+    p_src_08 = (CPU_INT08U *)p_src;
+    addr     =  start;
+    cnt_rem  =  cnt;
+    while (cnt_rem >= 2u) {
+        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* Rd new data.                                         */
+                               &data_rd[0],
+                                addr,
+                                2u,
+                                p_err);
+
+        data_wr_01 = *p_src_08++;
+        data_wr_02 = *p_src_08++;
+
+        if ((data_wr_01 != data_rd[0]) ||                       /* Cmp to intended data.                                */
+            (data_wr_02 != data_rd[1])) {
+            FS_CTR_ERR_INC(p_nor_data->ErrWrFailCtr);
+            FS_TRACE_DBG(("FSDev_NOR_PhyWrHandler(): Data compare failed 0x%02X%02X != 0x%02X%02X.\r\n", data_wr_01, data_wr_02, data_rd[0], data_rd[1]));
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
+
+        addr    += 2u;
+        cnt_rem -= 2u;
+    }
+#endif
+
+#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)                         /* Update wr ctrs.                                      */
+    if (cnt == p_nor_data->SecSize) {
+        FS_CTR_STAT_INC(p_nor_data->StatWrCtr);
+    } else {
+        FS_CTR_STAT_ADD(p_nor_data->StatWrOctetCtr, cnt);
+    }
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   FSDev_NOR_PhyEraseBlkHandler()
+*
+* Description : Erase block.
+*
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------  Argument validated by caller.
+*
+*               start       Start address of block (relative to start of device).
+*
+*               size        Size of block, in octets.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE           Block erased successfully.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) #### Read back block data to check erase success.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSDev_NOR_PhyEraseBlkHandler (FS_DEV_NOR_DATA  *p_nor_data,
+                                            CPU_INT32U        start,
+                                            CPU_INT32U        size,
+                                            FS_ERR           *p_err)
+{
+#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)
+    CPU_INT32U  addr;
+    CPU_INT32U  cnt_rem;
+    CPU_INT08U  data_rd[16];
+    CPU_INT32U  i;
+#endif
+
+
+    p_nor_data->PhyPtr->EraseBlk(p_nor_data->PhyDataPtr,
+                                 start,
+                                 size,
+                                 p_err);
+
+    if (*p_err != FS_ERR_NONE) {
+         FS_CTR_ERR_INC(p_nor_data->ErrEraseCtr);
+         return;
+    }
+
+#if (FS_DEV_NOR_CFG_WR_CHK_EN == DEF_ENABLED)
+    addr    = start;
+    cnt_rem = size;
+    while (cnt_rem >= sizeof(data_rd)) {
+        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* Rd new data.                                         */
+                               &data_rd[0],
+                                addr,
+                                sizeof(data_rd),
+                                p_err);
+
+        for (i = 0; i < sizeof(data_rd); i++) {
+            if (data_rd[i] != 0xFFu) {                          /* Cmp to erased data.                                  */
+                FS_CTR_ERR_INC(p_nor_data->ErrEraseFailCtr);
+                FS_TRACE_DBG(("FSDev_NOR_PhyEraseBlkHandler(): Data compare failed 0x02X != 0x%02X at 0x%08X.\r\n", data_rd[i], 0xFFu, addr + i));
+               *p_err = FS_ERR_DEV_IO;
+                return;
+            }
+        }
+
+        addr    += sizeof(data_rd);
+        cnt_rem -= sizeof(data_rd);
+    }
+#endif
+
+    FS_CTR_STAT_INC(p_nor_data->StatEraseBlkCtr);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   FSDev_NOR_PhyEraseChipHandler()
+*
+* Description : Erase chip.
+*
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------  Argument validated by caller.
+*
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE           Block erased successfully.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSDev_NOR_PhyEraseChipHandler(FS_DEV_NOR_DATA  *p_nor_data,
+                                            FS_ERR           *p_err)
+{
+    p_nor_data->PhyPtr->IO_Ctrl(p_nor_data->PhyDataPtr,
+                                FS_DEV_IO_CTRL_PHY_ERASE_CHIP,
+                                DEF_NULL,
+                                p_err);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FSDev_NOR_CalcDevInfo()
+*
+* Description : Calculate NOR device info.
+*
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                      Device info calculated.
+*                               FS_ERR_DEV_INVALID_CFG           Device configuration specified invalid.
+*                               FS_ERR_DEV_INVALID_LOW_PARAMS    Device low-level parameters invalid.
+*                               FS_ERR_DEV_IO                    Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT               Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Block & block region information supplied by the phy driver are strictly checked :
+*                   (a) As least one block must exist.
+*                   (b) All blocks must be large enough for at least one data sector.
+*                   (c) The configured data region start must lie within the block region.
+*
+*               (2) At least one block's worth of sectors MUST be reserved.
+*
+*               (3) The checkpoint slots are taken from the end of the file system area (see 'fs_dev_nor.c
+*                   Note #6').  A slot must hold the checkpoint header, the L2P table & the information of
+*                   each block; it is sized for an L2P table covering every sector of the area, which
+*                   exceeds the final table.
+*********************************************************************************************************
+*/
+
+static  void  FSDev_NOR_CalcDevInfo (FS_DEV_NOR_DATA  *p_nor_data,
+                                     FS_ERR           *p_err)
+{
+    FS_SEC_QTY   ab_cnt;
+    CPU_ADDR     blk_addr;
+    FS_SEC_QTY   blk_cnt;
+    FS_SEC_NBR   blk_nbr;
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)
+    FS_SEC_QTY   ckpt_blk_cnt;
+    CPU_INT32U   ckpt_size;
+#endif
+    FS_SEC_SIZE  data_size_blk;
+    FS_SEC_QTY   sec_cnt_blk;
+    FS_SEC_QTY   sec_cnt_tot;
+    FS_SEC_QTY   sec_cnt_rsvd;
+    FS_SEC_QTY   sec_cnt_data;
+
+
+                                                                /* ------------ CHK PHY INFO (see Note #1) ------------ */
+    if (p_nor_data->PhyDataPtr->BlkCnt == 0u) {                 /* Validate blk cnt.                                    */
+        FS_TRACE_DBG(("FSDev_NOR_CalcDevInfo(): Phy info invalid: BlkCnt == 0.\r\n"));
+       *p_err = FS_ERR_DEV_INVALID_LOW_PARAMS;
+        return;
+    }
+                                                                /* Validate blk size.                                   */
+    if (p_nor_data->PhyDataPtr->BlkSize < p_nor_data->SecSize + FS_DEV_NOR_BLK_HDR_LEN + FS_DEV_NOR_SEC_HDR_LEN) {
+        FS_TRACE_DBG(("FSDev_NOR_CalcDevInfo(): Phy info invalid: BlkSize = %d < %d.\r\n", p_nor_data->PhyDataPtr->BlkSize, p_nor_data->SecSize + FS_DEV_NOR_BLK_HDR_LEN + FS_DEV_NOR_SEC_HDR_LEN));
+       *p_err = FS_ERR_DEV_INVALID_LOW_PARAMS;
+        return;
+    }
+
+    if (p_nor_data->PhyDataPtr->AddrRegionStart < p_nor_data->PhyDataPtr->AddrBase) {
+        FS_TRACE_DBG(("FSDev_NOR_CalcDevInfo(): Phy info invalid: AddrRegionStart = %d < %d.\r\n", p_nor_data->PhyDataPtr->AddrRegionStart, p_nor_data->PhyDataPtr->AddrBase));
+       *p_err = FS_ERR_DEV_INVALID_LOW_PARAMS;
+        return;
+    }
+
+
+
+                                                                /* ------------ FIND 1ST BLK OF FILE SYSTEM ----------- */
+    blk_nbr  = 0u;
+    blk_addr = p_nor_data->PhyDataPtr->AddrRegionStart;
+    while ((blk_addr < p_nor_data->AddrStart) &&                /* While addr of blk before start of file system ...    */
+           (blk_nbr  < p_nor_data->PhyDataPtr->BlkCnt)) {       /* ... & more blocks rem                         ...    */
+                                                                /* ... get start addr of next blk.                      */
+        blk_addr += (CPU_ADDR)p_nor_data->PhyDataPtr->BlkSize;
+        blk_nbr++;
+    }
+
+    if (blk_addr < p_nor_data->AddrStart) {                     /* Start addr after last blk in dev.                    */
+        FS_TRACE_DBG(("FSDev_NOR_InfoCalc(): Start address of file system (0x%08X) after last blk in dev region.\r\n", p_nor_data->AddrStart));
+       *p_err = FS_ERR_DEV_INVALID_CFG;
+        return;
+    }
+
+
+
+                                                                /* ------------------- CALC SEC QTY ------------------- */
     p_nor_data->BlkSizeLog = FSUtil_Log2(p_nor_data->PhyDataPtr->BlkSize);
     p_nor_data->SecSizeLog = FSUtil_Log2(p_nor_data->SecSize);
 
@@ -3016,6 +3946,21 @@ static  void  FSDev_NOR_CalcDevInfo (FS_DEV_NOR_DATA  *p_nor_data,
         sec_cnt_blk--;
     }
 
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)                     /* Rsvd ckpt slots (see Note #3).                       */
+    sec_cnt_tot  =  sec_cnt_blk * blk_cnt;
+    ckpt_size    =  FS_DEV_NOR_CKPT_HDR_LEN
+                 + ((sec_cnt_tot * FSUtil_Log2(sec_cnt_tot) + DEF_OCTET_NBR_BITS - 1u) / DEF_OCTET_NBR_BITS)
+                 +  (blk_cnt * FS_DEV_NOR_CKPT_BLK_INFO_LEN);
+    ckpt_blk_cnt = (FS_SEC_QTY)((ckpt_size + p_nor_data->PhyDataPtr->BlkSize - 1u) >> p_nor_data->BlkSizeLog);
+    if (blk_cnt <= (ckpt_blk_cnt * FS_DEV_NOR_CKPT_SLOT_CNT) + 1u) {
+        FS_TRACE_DBG(("FSDev_NOR_CalcDevInfo(): Too few blks (%d) for %d ckpt blks.\r\n", blk_cnt, ckpt_blk_cnt * FS_DEV_NOR_CKPT_SLOT_CNT));
+       *p_err = FS_ERR_DEV_INVALID_LOW_PARAMS;
+        return;
+    }
+    blk_cnt                -= ckpt_blk_cnt * FS_DEV_NOR_CKPT_SLOT_CNT;
+    p_nor_data->CkptBlkCnt  = ckpt_blk_cnt;
+#endif
+
     sec_cnt_tot = sec_cnt_blk * blk_cnt;
 
 
@@ -3038,6 +3983,10 @@ static  void  FSDev_NOR_CalcDevInfo (FS_DEV_NOR_DATA  *p_nor_data,
 
     p_nor_data->Size         =   sec_cnt_data;
 
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)
+    p_nor_data->CkptTblSize  = ((CPU_INT32U)sec_cnt_data * (CPU_INT32U)p_nor_data->SecCntTotLog + DEF_OCTET_NBR_BITS - 1u) / DEF_OCTET_NBR_BITS;
+#endif
+
    *p_err = FS_ERR_NONE;
 }
 
@@ -3268,32 +4217,197 @@ static  void  FSDev_NOR_RdSecLogical (FS_DEV_NOR_DATA  *p_nor_data,
     FS_SEC_NBR  sec_nbr_phy;
 
 
-    sec_nbr_phy = FSDev_NOR_L2P_GetEntry(p_nor_data,            /* Look up phy sec nbr (see Note #1a).                  */
-                                         sec_nbr_logical);
-    if (sec_nbr_phy == FS_DEV_NOR_SEC_NBR_INVALID) {
-        Mem_Set(p_dest, 0xFFu, p_nor_data->SecSize);
+    sec_nbr_phy = FSDev_NOR_L2P_GetEntry(p_nor_data,            /* Look up phy sec nbr (see Note #1a).                  */
+                                         sec_nbr_logical);
+    if (sec_nbr_phy == FS_DEV_NOR_SEC_NBR_INVALID) {
+        Mem_Set(p_dest, 0xFFu, p_nor_data->SecSize);
+
+       *p_err = FS_ERR_NONE;
+    } else {
+                                                                /* Get sec addr (see Note #1b).                         */
+        sec_addr = FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy);
+        if (sec_addr == (CPU_INT32U)DEF_INT_32U_MAX_VAL) {
+            FS_TRACE_DBG(("FSDev_NOR_RdSecLogical(): Failed to get sec addr %d.\r\n", sec_nbr_phy));
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
+
+        FSDev_NOR_PhyRdHandler(p_nor_data,                      /* Rd sec (see Note #1c).                               */
+                               p_dest,
+                               sec_addr + FS_DEV_NOR_SEC_HDR_LEN,
+                               p_nor_data->SecSize,
+                               p_err);
+
+        if (*p_err != FS_ERR_NONE) {
+            FS_TRACE_DBG(("FSDev_NOR_RdSecLogical(): Failed to rd sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
+            return;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                    FSDev_NOR_RdSecLogicalMulti()
+*
+* Description : Read run of sectors stored in consecutive physical sectors.
+*
+* Argument(s) : p_nor_data          Pointer to NOR data.
+*               ----------          Argument validated by caller.
+*
+*               p_dest              Pointer to destination buffer.
+*               ----------          Argument validated by caller.
+*
+*               sec_nbr_logical     Logical sector number of first sector.
+*
+*               cnt                 Maximum number of sectors to read.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*               ----------          Argument validated by caller.
+*
+*                                       FS_ERR_NONE           Sector(s) read successfully.
+*                                       FS_ERR_DEV_IO         Device I/O error.
+*                                       FS_ERR_DEV_TIMEOUT    Device timeout.
+*
+* Return(s)   : Number of sectors read.
+*
+* Note(s)     : (1) The run extends while the L2P table maps the next logical sector to the next physical
+*                   sector of the same block.  Since sectors are written in order into an active block,
+*                   a file written sequentially generally yields long runs.
+*
+*               (2) Consecutive physical sectors are separated by their sector headers, so the run is read
+*                   as chunks of 'SecSize' octets, 'SecSize' + FS_DEV_NOR_SEC_HDR_LEN octets apart.
+*
+*               (3) An unmapped sector, or a run of a single sector, is read by FSDev_NOR_RdSecLogical().
+*********************************************************************************************************
+*/
+
+static  FS_SEC_QTY  FSDev_NOR_RdSecLogicalMulti (FS_DEV_NOR_DATA  *p_nor_data,
+                                                 void             *p_dest,
+                                                 FS_SEC_NBR        sec_nbr_logical,
+                                                 FS_SEC_QTY        cnt,
+                                                 FS_ERR           *p_err)
+{
+    CPU_INT32U  sec_addr;
+    FS_SEC_NBR  sec_nbr_phy;
+    FS_SEC_NBR  sec_nbr_phy_next;
+    FS_SEC_QTY  run_cnt;
+
+
+                                                                /* ------------------- FIND SEC RUN ------------------- */
+    sec_nbr_phy = FSDev_NOR_L2P_GetEntry(p_nor_data, sec_nbr_logical);
+    run_cnt     = 1u;
+    if (sec_nbr_phy != FS_DEV_NOR_SEC_NBR_INVALID) {
+        sec_nbr_phy_next = sec_nbr_phy + 1u;
+        while ((run_cnt < cnt) &&                               /* See Note #1.                                         */
+               ((sec_nbr_phy_next % p_nor_data->BlkSecCnts) != 0u)) {
+            if (FSDev_NOR_L2P_GetEntry(p_nor_data, sec_nbr_logical + run_cnt) != sec_nbr_phy_next) {
+                break;
+            }
+            run_cnt++;
+            sec_nbr_phy_next++;
+        }
+    }
+
+    if (run_cnt == 1u) {                                        /* See Note #3.                                         */
+        FSDev_NOR_RdSecLogical(p_nor_data,
+                               p_dest,
+                               sec_nbr_logical,
+                               p_err);
+        return (1u);
+    }
+
+
+
+                                                                /* --------------------- RD SEC RUN ------------------- */
+    sec_addr = FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy);
+    FSDev_NOR_PhyRdMultiHandler(p_nor_data,                     /* See Note #2.                                         */
+                                p_dest,
+                                sec_addr + FS_DEV_NOR_SEC_HDR_LEN,
+                                p_nor_data->SecSize,
+                                p_nor_data->SecSize + FS_DEV_NOR_SEC_HDR_LEN,
+                                run_cnt,
+                                p_err);
+    if (*p_err != FS_ERR_NONE) {
+        FS_TRACE_DBG(("FSDev_NOR_RdSecLogicalMulti(): Failed to rd %d secs from sec %d (0x%08X).\r\n", run_cnt, sec_nbr_phy, sec_addr));
+    }
+
+    return (run_cnt);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FSDev_NOR_SecMapHandler()
+*
+* Description : Get address of logical sector in CPU address space.
+*
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------  Argument validated by caller.
+*
+*               p_sec_map   Pointer to sector map (see 'fs_dev.h  DEVICE SECTOR MAP DATA TYPE').
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Sector mapped, or not mappable.
+*                               FS_ERR_DEV_INVALID_IO_CTRL    Flash not mapped (see Note #1).
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device is not low-level mounted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The flash is read in place only if 'AddrMap' was configured (see 'fs_dev_nor.h  NOR FLASH
+*                   DEVICE CONFIGURATION DATA TYPE  Note #1l').
+*
+*               (2) Consecutive physical sectors are separated by their sector headers, so only one sector
+*                   is mapped at a time.
+*
+*               (3) An unmapped logical sector reads as erased data that is not stored on the flash, so it
+*                   cannot be mapped.
+*
+*               (4) The sector may be moved by the next write to the device, even of another sector, since
+*                   a write may trigger a block erase or wear leveling.
+*********************************************************************************************************
+*/
+
+static  void  FSDev_NOR_SecMapHandler (FS_DEV_NOR_DATA  *p_nor_data,
+                                       FS_DEV_SEC_MAP   *p_sec_map,
+                                       FS_ERR           *p_err)
+{
+    CPU_INT32U  sec_addr;
+    FS_SEC_NBR  sec_nbr_phy;
+
+
+    if (p_nor_data->AddrMap == 0u) {                            /* See Note #1.                                         */
+       *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+        return;
+    }
 
-       *p_err = FS_ERR_NONE;
-    } else {
-                                                                /* Get sec addr (see Note #1b).                         */
-        sec_addr = FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy);
-        if (sec_addr == (CPU_INT32U)DEF_INT_32U_MAX_VAL) {
-            FS_TRACE_DBG(("FSDev_NOR_RdSecLogical(): Failed to get sec addr %d.\r\n", sec_nbr_phy));
-           *p_err = FS_ERR_DEV_IO;
-            return;
-        }
+    if (p_nor_data->Mounted == DEF_NO) {
+       *p_err = FS_ERR_DEV_INVALID_LOW_FMT;
+        return;
+    }
 
-        FSDev_NOR_PhyRdHandler(p_nor_data,                      /* Rd sec (see Note #1c).                               */
-                               p_dest,
-                               sec_addr + FS_DEV_NOR_SEC_HDR_LEN,
-                               p_nor_data->SecSize,
-                               p_err);
+    sec_nbr_phy = FSDev_NOR_L2P_GetEntry(p_nor_data, p_sec_map->Start);
+    if (sec_nbr_phy == FS_DEV_NOR_SEC_NBR_INVALID) {            /* See Note #3.                                         */
+        p_sec_map->Cnt     =  0u;
+        p_sec_map->AddrPtr = (void *)0;
+       *p_err              =  FS_ERR_NONE;
+        return;
+    }
 
-        if (*p_err != FS_ERR_NONE) {
-            FS_TRACE_DBG(("FSDev_NOR_RdSecLogical(): Failed to rd sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
-            return;
-        }
+    sec_addr = FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy);
+    if (sec_addr == (CPU_INT32U)DEF_INT_32U_MAX_VAL) {
+        FS_TRACE_DBG(("FSDev_NOR_SecMapHandler(): Failed to get sec addr %d.\r\n", sec_nbr_phy));
+       *p_err = FS_ERR_DEV_IO;
+        return;
     }
+
+    p_sec_map->Cnt     =  1u;                                   /* See Note #2.                                         */
+    p_sec_map->AddrPtr = (void *)(p_nor_data->AddrMap + sec_addr + FS_DEV_NOR_SEC_HDR_LEN);
+   *p_err              =  FS_ERR_NONE;
 }
 
 
@@ -3406,84 +4520,400 @@ static  void  FSDev_NOR_WrSecLogical (FS_DEV_NOR_DATA  *p_nor_data,
 *                                       FS_ERR_DEV_IO         Device I/O error.
 *                                       FS_ERR_DEV_TIMEOUT    Device timeout.
 *
-* Return(s)   : none.
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FSDev_NOR_WrSecLogical()  Note #1c'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSDev_NOR_WrSecLogicalHandler (FS_DEV_NOR_DATA  *p_nor_data,
+                                             void             *p_src,
+                                             FS_SEC_NBR        sec_nbr_logical,
+                                             FS_ERR           *p_err)
+{
+    CPU_INT32U  sec_addr;
+    FS_SEC_NBR  sec_nbr_phy;
+    CPU_INT08U  sec_hdr[FS_DEV_NOR_SEC_HDR_LEN];
+
+
+                                                                /* ----------------- FIND NEW PHY SEC ----------------- */
+    sec_nbr_phy = FSDev_NOR_AB_SecFind(p_nor_data,              /* Find active blk sec.                                 */
+                                       sec_nbr_logical);
+    if (sec_nbr_phy == FS_DEV_NOR_SEC_NBR_INVALID) {
+        FS_TRACE_DBG(("FSDev_NOR_WrSecLogicalHandler(): Failed to get sec.\r\n"));
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
+
+    sec_addr = FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy);
+
+
+
+                                                                /* -------------------- WR NEW DATA ------------------- */
+    MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],  FS_DEV_NOR_STATUS_SEC_WRITING);
+
+    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Mark sec as 'writing'.                               */
+                           &sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],
+                           (sec_addr + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS),
+                            4u,
+                            p_err);
+    if (*p_err != FS_ERR_NONE) {
+        p_nor_data->SecCntInvalid++;
+        FS_TRACE_DBG(("FSDev_NOR_WrSecLogicalHandler(): Failed to wr hdr of sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
+        return;
+    }
+
+    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Wr sec.                                              */
+                            p_src,
+                           (sec_addr + FS_DEV_NOR_SEC_HDR_LEN),
+                            p_nor_data->SecSize,
+                            p_err);
+    if (*p_err != FS_ERR_NONE) {
+        p_nor_data->SecCntInvalid++;
+        FS_TRACE_DBG(("FSDev_NOR_WrSecLogicalHandler(): Failed to wr sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
+        return;
+    }
+
+    MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_SEC_NBR], sec_nbr_logical);
+    MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],  FS_DEV_NOR_STATUS_SEC_VALID);
+
+
+
+                                                                /* --------------- VALIDATE NEW PHY SEC --------------- */
+    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Mark sec as 'written'.                               */
+                           &sec_hdr[0],
+                            sec_addr,
+                            FS_DEV_NOR_SEC_HDR_LEN,
+                            p_err);
+    if (*p_err != FS_ERR_NONE) {
+        p_nor_data->SecCntInvalid++;
+        FS_TRACE_DBG(("FSDev_NOR_WrSecLogicalHandler(): Failed to wr hdr of sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
+        return;
+    }
+
+    FSDev_NOR_L2P_SetEntry(p_nor_data,                          /* Update L2P tbl.                                      */
+                           sec_nbr_logical,
+                           sec_nbr_phy);
+    p_nor_data->SecCntValid++;                                  /* Wr sec is now valid.                                 */
+
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FSDev_NOR_InvalidateSec()
+*
+* Description : Invalidate sector.
+*
+* Argument(s) : p_nor_data      Pointer to NOR data.
+*               ----------      Argument validated by caller.
+*
+*               sec_nbr_phy     Physical sector number.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               ----------      Argument validated by caller.
+*
+*                                   FS_ERR_NONE           Sector invalidated successfully.
+*                                   FS_ERR_DEV_IO         Device I/O error.
+*                                   FS_ERR_DEV_TIMEOUT    Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSDev_NOR_InvalidateSec (FS_DEV_NOR_DATA  *p_nor_data,
+                                       FS_SEC_NBR        sec_nbr_phy,
+                                       FS_ERR           *p_err)
+{
+    CPU_BOOLEAN  active;
+    FS_SEC_NBR   blk_ix;
+    CPU_BOOLEAN  erased;
+    CPU_INT32U   sec_addr;
+    FS_SEC_QTY   sec_cnt_valid;
+    CPU_INT08U   sec_hdr[FS_DEV_NOR_SEC_HDR_LEN];
+
+
+                                                                /* ---------------- MARK SEC AS INVALID --------------- */
+    sec_addr = FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy);
+#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
+    if (sec_addr == DEF_INT_32U_MAX_VAL) {
+        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): Failed to get addr of sec %d.\r\n", sec_nbr_phy));
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
+#endif
+    MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS], FS_DEV_NOR_STATUS_SEC_INVALID);
+
+    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Mark sec as 'invalid'.                               */
+                           &sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],
+                           (sec_addr + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS),
+                            4u,
+                            p_err);
+
+    if (*p_err != FS_ERR_NONE) {
+        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): Failed to wr hdr of sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
+        return;
+    }
+
+
+
+                                                                /* ------------------ UPDATE BLK INFO ----------------- */
+    blk_ix = FSDev_NOR_SecNbrPhy_to_BlkIx(p_nor_data, sec_nbr_phy);
+    if (blk_ix == (FS_SEC_QTY)FS_DEV_NOR_SEC_NBR_INVALID) {
+        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): Failed to get ix of blk containing sec %d.\r\n", sec_nbr_phy));
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
+
+
+    FSDev_NOR_GetBlkInfo( p_nor_data,                           /* Get blk valid sec cnt.                               */
+                          blk_ix,
+                         &erased,
+                         &sec_cnt_valid);
+
+#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
+    if (erased == DEF_YES) {
+        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): L2P sec corrupted: blk %d erased.\r\n", blk_ix));
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
+    if (sec_cnt_valid == 0u) {
+        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): L2P sec corrupted: blk %d has no valid secs.\r\n", blk_ix));
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
+#endif
+
+    FSDev_NOR_DecBlkSecCntValid(p_nor_data, blk_ix);            /* Dec blk valid sec cnt.                               */
+    sec_cnt_valid--;
+
+    if (sec_cnt_valid == 0u) {                                  /* If no more valid secs in blk ...                     */
+        active = FSDev_NOR_IsAB(p_nor_data, blk_ix);
+        if (active == DEF_NO) {                                 /* ... & blk is NOT active blk  ...                     */
+            FS_TRACE_LOG(("FSDev_NOR_InvalidateSec(): Blk %d invalidated.\r\n", blk_ix));
+            p_nor_data->BlkCntInvalid++;
+            FS_CTR_STAT_INC(p_nor_data->StatInvalidBlkCtr);
+#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
+            if (p_nor_data->BlkCntValid == 0u) {
+                FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): Valid blk cnt == 0 upon invalidation of blk %d.\r\n", blk_ix));
+               *p_err = FS_ERR_DEV_IO;
+                return;
+            }
+#endif
+            p_nor_data->BlkCntValid--;                          /* ... erase.                                           */
+        }
+    }
+    p_nor_data->SecCntValid--;
+    p_nor_data->SecCntInvalid++;
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FSDev_NOR_EraseBlkPrepare()
+*
+* Description : Prepare & erase block.
+*
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------  Argument validated by caller.
+*
+*               blk_ix      Block index.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE           Block erased successfully.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) A block move, if interrupted by power failure, will be resumed by 'FSDev_NOR_LowMountHandler()'
+*                   upon mount if the target block (i.e., the active block) was the only erased block.
+*                   See also 'FSDev_NOR_LowMountHandler()  Note #5'.
+*
+*               (2) If there were NO valid sectors in the source block, it MUST have been considered
+*                   invalid already.
 *
-* Note(s)     : (1) See 'FSDev_NOR_WrSecLogical()  Note #1c'.
+*               (3) The driver is responsible for maintaining an erased block to receive data sectors
+*                   during this move.  See also 'FSDev_NOR_FindEraseBlk()  Note #1a2'.
+*
+*               (4) If the erase of the former active block is interrupted, multiple blocks may be found
+*                   upon mount with valid or invalid sectors AND erased sectors.  The sectors in all but
+*                   one of those will be classified as invalid upon mount (see 'FSDev_NOR_LowMountHandler()  Note #6').
 *********************************************************************************************************
 */
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  void  FSDev_NOR_WrSecLogicalHandler (FS_DEV_NOR_DATA  *p_nor_data,
-                                             void             *p_src,
-                                             FS_SEC_NBR        sec_nbr_logical,
-                                             FS_ERR           *p_err)
+static  void  FSDev_NOR_EraseBlkPrepare (FS_DEV_NOR_DATA  *p_nor_data,
+                                         FS_SEC_NBR        blk_ix,
+                                         FS_ERR           *p_err)
 {
-    CPU_INT32U  sec_addr;
-    FS_SEC_NBR  sec_nbr_phy;
-    CPU_INT08U  sec_hdr[FS_DEV_NOR_SEC_HDR_LEN];
+    CPU_BOOLEAN  active;
+    CPU_INT32U   blk_addr;
+    CPU_BOOLEAN  erased;
+    CPU_INT32U   sec_addr;
+    FS_SEC_QTY   sec_cnt;
+    FS_SEC_QTY   sec_cnt_valid;
+    CPU_INT08U   sec_hdr[FS_DEV_NOR_SEC_HDR_LEN];
+    FS_SEC_NBR   sec_ix;
+    FS_SEC_NBR   sec_nbr_logical;
+    FS_SEC_NBR   sec_nbr_phy;
+    CPU_INT32U   status;
 
 
-                                                                /* ----------------- FIND NEW PHY SEC ----------------- */
-    sec_nbr_phy = FSDev_NOR_AB_SecFind(p_nor_data,              /* Find active blk sec.                                 */
-                                       sec_nbr_logical);
-    if (sec_nbr_phy == FS_DEV_NOR_SEC_NBR_INVALID) {
-        FS_TRACE_DBG(("FSDev_NOR_WrSecLogicalHandler(): Failed to get sec.\r\n"));
-       *p_err = FS_ERR_DEV_IO;
-        return;
+                                                                /* ---------------- INVALIDATE BLK INFO --------------- */
+    active = FSDev_NOR_IsAB(p_nor_data, blk_ix);
+    if (active == DEF_YES) {                                    /* If blk to erase if active blk ... (see Note #4)      */
+        FSDev_NOR_AB_Remove(p_nor_data, blk_ix);                /* ... invalidate blk.                                  */
     }
 
-    sec_addr = FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy);
 
 
+                                                                /* ----------------- MOVE DATA IN BLK ----------------- */
+    FSDev_NOR_GetBlkInfo( p_nor_data,
+                          blk_ix,
+                         &erased,
+                         &sec_cnt_valid);
 
-                                                                /* -------------------- WR NEW DATA ------------------- */
-    MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],  FS_DEV_NOR_STATUS_SEC_WRITING);
+    if (sec_cnt_valid != 0u) {
+        FS_TRACE_LOG(("FSDev_NOR_EraseBlkPrepare(): Moving from blk %d, secs (%d) prior to erase.\r\n", blk_ix, sec_cnt_valid));
 
-    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Mark sec as 'writing'.                               */
-                           &sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],
-                           (sec_addr + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS),
-                            4u,
-                            p_err);
-    if (*p_err != FS_ERR_NONE) {
-        p_nor_data->SecCntInvalid++;
-        FS_TRACE_DBG(("FSDev_NOR_WrSecLogicalHandler(): Failed to wr hdr of sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
-        return;
-    }
+        sec_cnt       = p_nor_data->BlkSecCnts;
+        blk_addr      = FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix);
+        sec_nbr_phy   = FSDev_NOR_BlkIx_to_SecNbrPhy(p_nor_data, blk_ix);
+        sec_addr      = blk_addr + FS_DEV_NOR_BLK_HDR_LEN;
 
-    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Wr sec.                                              */
-                            p_src,
-                           (sec_addr + FS_DEV_NOR_SEC_HDR_LEN),
-                            p_nor_data->SecSize,
-                            p_err);
-    if (*p_err != FS_ERR_NONE) {
-        p_nor_data->SecCntInvalid++;
-        FS_TRACE_DBG(("FSDev_NOR_WrSecLogicalHandler(): Failed to wr sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
-        return;
+#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
+        if (blk_addr == DEF_INT_32U_MAX_VAL) {
+            FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Failed to get addr of blk ix %d.\r\n", blk_ix));
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
+#endif
+
+        sec_ix = 0u;
+        while (sec_ix < sec_cnt) {
+            FSDev_NOR_PhyRdHandler( p_nor_data,                 /* Rd blk hdr.                                          */
+                                   &sec_hdr[0],
+                                    sec_addr,
+                                    FS_DEV_NOR_SEC_HDR_LEN,
+                                    p_err);
+            if (*p_err != FS_ERR_NONE) {
+                FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Failed to rd sec hdr %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
+                return;
+            }
+
+            sec_nbr_logical = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_SEC_NBR]);
+            status          = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS]);
+
+
+                                                                /* ----------------- MOVE DATA IN SEC ----------------- */
+            if ((status          == FS_DEV_NOR_STATUS_SEC_VALID) && /* If sec valid                ...                  */
+                (sec_nbr_logical <  p_nor_data->Size)) {            /* ... & logical sec nbr valid ...                  */
+                                                                    /* ... rd sec                  ...                  */
+                FSDev_NOR_PhyRdHandler( p_nor_data,
+                                        p_nor_data->BufPtr,
+                                       (sec_addr + FS_DEV_NOR_SEC_HDR_LEN),
+                                        p_nor_data->SecSize,
+                                        p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Failed to rd sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
+                    return;
+                }
+                                                                    /* ... & wr to free sec       ... (see Note #3)     */
+                FSDev_NOR_WrSecLogicalHandler(p_nor_data,
+                                              p_nor_data->BufPtr,
+                                              sec_nbr_logical,
+                                              p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    return;
+                }
+
+                MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS], FS_DEV_NOR_STATUS_SEC_INVALID);
+
+                FSDev_NOR_PhyWrHandler( p_nor_data,             /* Mark sec as 'invalid'.                               */
+                                       &sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],
+                                        sec_addr + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS,
+                                        4u,
+                                        p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Failed to wr hdr of sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
+                    return;
+                }
+
+#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
+                if (sec_cnt_valid == 0u) {
+                    FSDev_NOR_IncBlkSecCntValid(p_nor_data, blk_ix);
+                    FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Too many valid secs found in blk ix %d.\r\n", blk_ix));
+                   *p_err = FS_ERR_DEV_IO;
+                    return;
+                }
+#endif
+                FSDev_NOR_DecBlkSecCntValid(p_nor_data, blk_ix);
+                sec_cnt_valid--;
+#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
+                if (p_nor_data->SecCntValid < 1u) {
+                    FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Unexpectedly few valid secs (%d) exist in NOR.\r\n", p_nor_data->SecCntValid));
+                   *p_err = FS_ERR_DEV_IO;
+                    return;
+                }
+#endif
+                p_nor_data->SecCntValid--;
+                p_nor_data->SecCntInvalid++;
+                FS_CTR_STAT_INC(p_nor_data->StatCopyCtr);
+            }
+
+            sec_addr += p_nor_data->SecSize + FS_DEV_NOR_SEC_HDR_LEN;
+            sec_ix++;
+            sec_nbr_phy++;
+        }
+
+#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
+        if (sec_cnt_valid != 0u) {
+            FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Too few valid secs (%d more expected) found in blk ix %d.\r\n", sec_cnt_valid));
+
+#if (FS_TRACE_LEVEL >= TRACE_LEVEL_DBG)
+            if (p_nor_data->SecCntValid < sec_cnt_valid) {
+                FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Unexpectedly few valid secs (%d) exist in NOR.\r\n", p_nor_data->SecCntValid));
+            }
+#endif
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
+#endif
+
+#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
+        if (p_nor_data->BlkCntValid < 1u) {
+            FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Unexpectedly few valid blks (%d) exist in NOR.\r\n", p_nor_data->BlkCntValid));
+           *p_err = FS_ERR_DEV_IO;
+            return;
+        }
+#endif
+        p_nor_data->BlkCntValid--;                              /* One fewer valid blks (see Note #2).                  */
+        p_nor_data->BlkCntInvalid++;
     }
 
-    MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_SEC_NBR], sec_nbr_logical);
-    MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],  FS_DEV_NOR_STATUS_SEC_VALID);
 
 
 
-                                                                /* --------------- VALIDATE NEW PHY SEC --------------- */
-    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Mark sec as 'written'.                               */
-                           &sec_hdr[0],
-                            sec_addr,
-                            FS_DEV_NOR_SEC_HDR_LEN,
-                            p_err);
+
+                                                                /* --------------------- ERASE BLK -------------------- */
+    FSDev_NOR_EraseBlkEmptyFmt(p_nor_data, blk_ix, p_err);
     if (*p_err != FS_ERR_NONE) {
-        p_nor_data->SecCntInvalid++;
-        FS_TRACE_DBG(("FSDev_NOR_WrSecLogicalHandler(): Failed to wr hdr of sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
         return;
     }
 
-    FSDev_NOR_L2P_SetEntry(p_nor_data,                          /* Update L2P tbl.                                      */
-                           sec_nbr_logical,
-                           sec_nbr_phy);
-    p_nor_data->SecCntValid++;                                  /* Wr sec is now valid.                                 */
-
-
    *p_err = FS_ERR_NONE;
 }
 #endif
@@ -3491,113 +4921,134 @@ static  void  FSDev_NOR_WrSecLogicalHandler (FS_DEV_NOR_DATA  *p_nor_data,
 
 /*
 *********************************************************************************************************
-*                                      FSDev_NOR_InvalidateSec()
+*                                    FSDev_NOR_EraseBlkEmptyFmt()
 *
-* Description : Invalidate sector.
+* Description : Erase empty block.
 *
-* Argument(s) : p_nor_data      Pointer to NOR data.
-*               ----------      Argument validated by caller.
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------  Argument validated by caller.
 *
-*               sec_nbr_phy     Physical sector number.
+*               blk_ix      Block index.
 *
-*               p_err           Pointer to variable that will receive the return error code from this function :
-*               ----------      Argument validated by caller.
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
 *
-*                                   FS_ERR_NONE           Sector invalidated successfully.
-*                                   FS_ERR_DEV_IO         Device I/O error.
-*                                   FS_ERR_DEV_TIMEOUT    Device timeout.
+*                               FS_ERR_NONE           Block erased successfully.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) To erase a block :
+*                   (a) Find/calculation location of block.
+*                   (b) Erase block.
+*                   (c) Write block header.
+*
+*               (2) A block may lose its erase count if the block erase is interrupted, or if the block
+*                   header is not completely written.  The block is assumed to have the maximum erase
+*                   count upon restart.  Wear-leveling erased block approximately uniformly, so this
+*                   should be close to true block count.
 *********************************************************************************************************
 */
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  void  FSDev_NOR_InvalidateSec (FS_DEV_NOR_DATA  *p_nor_data,
-                                       FS_SEC_NBR        sec_nbr_phy,
-                                       FS_ERR           *p_err)
+static  void  FSDev_NOR_EraseBlkEmptyFmt (FS_DEV_NOR_DATA  *p_nor_data,
+                                          FS_SEC_NBR        blk_ix,
+                                          FS_ERR           *p_err)
 {
-    CPU_BOOLEAN  active;
-    FS_SEC_NBR   blk_ix;
-    CPU_BOOLEAN  erased;
-    CPU_INT32U   sec_addr;
-    FS_SEC_QTY   sec_cnt_valid;
-    CPU_INT08U   sec_hdr[FS_DEV_NOR_SEC_HDR_LEN];
+    CPU_INT32U  blk_addr;
+    CPU_INT32U  erase_cnt;
+    CPU_INT08U  blk_hdr[FS_DEV_NOR_BLK_HDR_LEN];
+    CPU_INT08U  erase_cnt_octets[4];
 
 
-                                                                /* ---------------- MARK SEC AS INVALID --------------- */
-    sec_addr = FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy);
+                                                                /* --------------------- ERASE BLK -------------------- */
+    blk_addr      = FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix);
 #if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-    if (sec_addr == DEF_INT_32U_MAX_VAL) {
-        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): Failed to get addr of sec %d.\r\n", sec_nbr_phy));
+    if (blk_addr == DEF_INT_32U_MAX_VAL) {
+        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Failed to get addr of blk ix %d.\r\n", blk_ix));
        *p_err = FS_ERR_DEV_IO;
         return;
     }
 #endif
-    MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS], FS_DEV_NOR_STATUS_SEC_INVALID);
 
-    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Mark sec as 'invalid'.                               */
-                           &sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],
-                           (sec_addr + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS),
+    FSDev_NOR_PhyRdHandler( p_nor_data,                         /* Rd erase cnt.                                        */
+                           &erase_cnt_octets[0],
+                           (blk_addr + FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT),
                             4u,
                             p_err);
-
     if (*p_err != FS_ERR_NONE) {
-        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): Failed to wr hdr of sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
+        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Failed to rd erase cnts of blk %d (0x%08X).\r\n", blk_ix, blk_addr));
         return;
     }
 
 
+    erase_cnt = MEM_VAL_GET_INT32U((void *)&erase_cnt_octets[0]);
+    if (erase_cnt == FS_DEV_NOR_BLK_HDR_ERASE_CNT_INVALID) {
+        erase_cnt  = p_nor_data->EraseCntMax;                   /* If erase cnt invalid, set to max cnt (see Note #2).  */
+    } else {
+        erase_cnt++;
+        if (p_nor_data->EraseCntMax < erase_cnt) {
+            FS_TRACE_LOG(("FSDev_NOR_EraseBlkEmptyFmt(): Max erase cnt now %d (prev was %d).\r\n", erase_cnt, p_nor_data->EraseCntMax));
+            p_nor_data->EraseCntMax = erase_cnt;
+        }
+    }
+
+    FSDev_NOR_PhyEraseBlkHandler(p_nor_data,                    /* Erase blk.                                           */
+                                 blk_addr,
+                                 p_nor_data->PhyDataPtr->BlkSize,
+                                 p_err);
 
-                                                                /* ------------------ UPDATE BLK INFO ----------------- */
-    blk_ix = FSDev_NOR_SecNbrPhy_to_BlkIx(p_nor_data, sec_nbr_phy);
-    if (blk_ix == (FS_SEC_QTY)FS_DEV_NOR_SEC_NBR_INVALID) {
-        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): Failed to get ix of blk containing sec %d.\r\n", sec_nbr_phy));
-       *p_err = FS_ERR_DEV_IO;
+    if (*p_err != FS_ERR_NONE) {
+        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Failed to erase blk ix %d (0x%08X).\r\n", blk_ix, blk_addr));
         return;
     }
 
+    FS_TRACE_LOG(("FSDev_NOR_EraseBlkEmptyFmt(): Erased blk %d (0x%08X) w/erase cnt %d.\r\n", blk_ix, blk_addr, erase_cnt));
 
-    FSDev_NOR_GetBlkInfo( p_nor_data,                           /* Get blk valid sec cnt.                               */
-                          blk_ix,
-                         &erased,
-                         &sec_cnt_valid);
 
-#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-    if (erased == DEF_YES) {
-        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): L2P sec corrupted: blk %d erased.\r\n", blk_ix));
-       *p_err = FS_ERR_DEV_IO;
+                                                                /* --------------------- WR BLK HDR ------------------- */
+    MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_MARK1],     FS_DEV_NOR_BLK_HDR_MARK_WORD_1);
+    MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_MARK2],     FS_DEV_NOR_BLK_HDR_MARK_WORD_2);
+    MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT], erase_cnt);
+    MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_VER],       FS_DEV_NOR_BLK_HDR_VER);
+    MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_SEC_SIZE],  p_nor_data->SecSize);
+    MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_BLK_CNT],   p_nor_data->BlkCntUsed);
+
+    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Wr hdr.                                              */
+                           &blk_hdr[0],
+                            blk_addr,
+                            FS_DEV_NOR_BLK_HDR_LEN,
+                            p_err);
+    if (*p_err != FS_ERR_NONE) {
+        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Failed to wr blk hdr ix %d (0x%08X).\r\n", blk_ix, blk_addr));
         return;
     }
-    if (sec_cnt_valid == 0u) {
-        FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): L2P sec corrupted: blk %d has no valid secs.\r\n", blk_ix));
+
+
+                                                                /* -------------------- UPDATE INFO ------------------- */
+    p_nor_data->BlkCntErased++;                                 /* Another erased blk.                                  */
+#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
+    if (p_nor_data->BlkCntInvalid == 0u) {
+        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Invalid blk cnt == 0 upon erase of blk %d.\r\n", blk_ix));
        *p_err = FS_ERR_DEV_IO;
         return;
     }
 #endif
+    p_nor_data->BlkCntInvalid--;                                /* One fewer invalid blks.                              */
+    p_nor_data->SecCntErased  += p_nor_data->BlkSecCnts;        /* More erased secs.                                    */
+    p_nor_data->SecCntInvalid -= p_nor_data->BlkSecCnts;        /* Fewer invalid secs.                                  */
 
-    FSDev_NOR_DecBlkSecCntValid(p_nor_data, blk_ix);            /* Dec blk valid sec cnt.                               */
-    sec_cnt_valid--;
+    FSDev_NOR_SetBlkErased(p_nor_data,                          /* Blk is erased.                                       */
+                           blk_ix,
+                           DEF_YES);
 
-    if (sec_cnt_valid == 0u) {                                  /* If no more valid secs in blk ...                     */
-        active = FSDev_NOR_IsAB(p_nor_data, blk_ix);
-        if (active == DEF_NO) {                                 /* ... & blk is NOT active blk  ...                     */
-            FS_TRACE_LOG(("FSDev_NOR_InvalidateSec(): Blk %d invalidated.\r\n", blk_ix));
-            p_nor_data->BlkCntInvalid++;
-            FS_CTR_STAT_INC(p_nor_data->StatInvalidBlkCtr);
-#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-            if (p_nor_data->BlkCntValid == 0u) {
-                FS_TRACE_DBG(("FSDev_NOR_InvalidateSec(): Valid blk cnt == 0 upon invalidation of blk %d.\r\n", blk_ix));
-               *p_err = FS_ERR_DEV_IO;
-                return;
-            }
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)
+    p_nor_data->CkptEraseCtr++;                                 /* See 'FSDev_NOR_Wr()  Note #2'.                       */
+#endif
+#if (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED)
+    p_nor_data->WearLevelEraseCtr++;                            /* See 'FSDev_NOR_Wr()  Note #3'.                       */
 #endif
-            p_nor_data->BlkCntValid--;                          /* ... erase.                                           */
-        }
-    }
-    p_nor_data->SecCntValid--;
-    p_nor_data->SecCntInvalid++;
 
    *p_err = FS_ERR_NONE;
 }
@@ -3606,646 +5057,1033 @@ static  void  FSDev_NOR_InvalidateSec (FS_DEV_NOR_DATA  *p_nor_data,
 
 /*
 *********************************************************************************************************
-*                                     FSDev_NOR_EraseBlkPrepare()
+*                                       FSDev_NOR_FindEraseBlk()
 *
-* Description : Prepare & erase block.
+* Description : Find block that needs to be erased.
 *
 * Argument(s) : p_nor_data  Pointer to NOR data.
 *               ----------  Argument validated by caller.
 *
-*               blk_ix      Block index.
-*
-*               p_err       Pointer to variable that will receive the return error code from this function :
-*               ----------  Argument validated by caller.
-*
-*                               FS_ERR_NONE           Block erased successfully.
-*                               FS_ERR_DEV_IO         Device I/O error.
-*                               FS_ERR_DEV_TIMEOUT    Device timeout.
-*
-* Return(s)   : none.
+* Return(s)   : Block index,                if    block found that needs to be erased.
+*               FS_DEV_NOR_SEC_NBR_INVALID, if NO block            needs to be erased.
 *
-* Note(s)     : (1) A block move, if interrupted by power failure, will be resumed by 'FSDev_NOR_LowMountHandler()'
-*                   upon mount if the target block (i.e., the active block) was the only erased block.
-*                   See also 'FSDev_NOR_LowMountHandler()  Note #5'.
+* Note(s)     : (1) (a) Blocks may be erased under one of two conditions :
+*                       (1) The erase count difference threshold is exceeded, i.e., a block exists that
+*                           has been erased 'EraseCntDiffTh' fewer times than the most often
+*                           erased block.
+*                       (2) Fewer block exist than ...
+*                           (A) ... 1, if there is an active block assigned;
+*                           (B) ... 2, if there is NO active block assigned.
 *
-*               (2) If there were NO valid sectors in the source block, it MUST have been considered
-*                   invalid already.
+*                           This maintains the minimum number erase blocks required by the driver (see also
+*                           'FSDev_NOR_EraseBlkPrepare()  Note #3').
 *
-*               (3) The driver is responsible for maintaining an erased block to receive data sectors
-*                   during this move.  See also 'FSDev_NOR_FindEraseBlk()  Note #1a2'.
+*                   (b) The block chosen for erasure is either :
+*                       (1) The block with the lowest erase count.
+*                       (2) The block with the fewest valid sectors.
+*                       The former is chosen if the difference between the block's erase count & the
+*                       maximum is greater than some maximum value; the default maximum is 100 erasures.
 *
-*               (4) If the erase of the former active block is interrupted, multiple blocks may be found
-*                   upon mount with valid or invalid sectors AND erased sectors.  The sectors in all but
-*                   one of those will be classified as invalid upon mount (see 'FSDev_NOR_LowMountHandler()  Note #6').
+*                   (c) Blocks are erased until no more block such as #1a1 exist, & until enough
+*                       sectors (#1a2) are unoccupied.
 *********************************************************************************************************
 */
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  void  FSDev_NOR_EraseBlkPrepare (FS_DEV_NOR_DATA  *p_nor_data,
-                                         FS_SEC_NBR        blk_ix,
-                                         FS_ERR           *p_err)
+static  FS_SEC_NBR  FSDev_NOR_FindEraseBlk (FS_DEV_NOR_DATA  *p_nor_data)
 {
     CPU_BOOLEAN  active;
-    CPU_INT32U   blk_addr;
+    FS_SEC_QTY   active_blk_cnt;
+    FS_SEC_NBR   blk_ix;
+    FS_SEC_NBR   blk_ix_min;
+    CPU_BOOLEAN  empty;
     CPU_BOOLEAN  erased;
-    CPU_INT32U   sec_addr;
-    FS_SEC_QTY   sec_cnt;
+    FS_SEC_QTY   sec_cnt_valid_min;
     FS_SEC_QTY   sec_cnt_valid;
-    CPU_INT08U   sec_hdr[FS_DEV_NOR_SEC_HDR_LEN];
-    FS_SEC_NBR   sec_ix;
-    FS_SEC_NBR   sec_nbr_logical;
-    FS_SEC_NBR   sec_nbr_phy;
-    CPU_INT32U   status;
 
 
-                                                                /* ---------------- INVALIDATE BLK INFO --------------- */
-    active = FSDev_NOR_IsAB(p_nor_data, blk_ix);
-    if (active == DEF_YES) {                                    /* If blk to erase if active blk ... (see Note #4)      */
-        FSDev_NOR_AB_Remove(p_nor_data, blk_ix);                /* ... invalidate blk.                                  */
+                                                                /* ----------------- CHK FOR ERASE TH ----------------- */
+                                                                /* If enough blks erased                 ...            */
+    active_blk_cnt = FSDev_NOR_GetAB_Cnt(p_nor_data);
+    if (p_nor_data->BlkCntErased >= 1u) {
+                                                                /* ... & erase cnt diff th satisfied  OR ...            */
+        if ((p_nor_data->EraseCntMax       < p_nor_data->EraseCntMin + p_nor_data->EraseCntDiffTh) ||
+                                                                /* ...   erased wear-level blk exists OR ...            */
+            (p_nor_data->BlkWearLevelAvail == DEF_YES)                                             ||
+                                                                /* ...   sufficient blks erased       OR ...            */
+            (p_nor_data->BlkCntErased      >= 2u)                                                  ||
+                                                                /* ...   at least one blk active         ...            */
+            (active_blk_cnt                >  0u)) {
+            return (FS_DEV_NOR_SEC_NBR_INVALID);                /* ... do not erase a blk yet.                          */
+        }
     }
 
 
 
-                                                                /* ----------------- MOVE DATA IN BLK ----------------- */
-    FSDev_NOR_GetBlkInfo( p_nor_data,
-                          blk_ix,
-                         &erased,
-                         &sec_cnt_valid);
+                                                                /* ----------------- ACTIVE WEAR-LEVEL ---------------- */
+    blk_ix_min = FSDev_NOR_FindEraseBlkWear(p_nor_data);
+    if (blk_ix_min == FS_DEV_NOR_SEC_NBR_INVALID) {             /* If NO minimally-erased blk    ...                    */
+                                                                /* ... but if enough blks erased ...                    */
+        if ( (p_nor_data->BlkCntErased >= 2u) ||
+            ((p_nor_data->BlkCntErased >= 1u) && (active_blk_cnt > 0u))) {
+            return (FS_DEV_NOR_SEC_NBR_INVALID);                /* ... do not erase a blk yet.                          */
+        }
 
-    if (sec_cnt_valid != 0u) {
-        FS_TRACE_LOG(("FSDev_NOR_EraseBlkPrepare(): Moving from blk %d, secs (%d) prior to erase.\r\n", blk_ix, sec_cnt_valid));
 
-        sec_cnt       = p_nor_data->BlkSecCnts;
-        blk_addr      = FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix);
-        sec_nbr_phy   = FSDev_NOR_BlkIx_to_SecNbrPhy(p_nor_data, blk_ix);
-        sec_addr      = blk_addr + FS_DEV_NOR_BLK_HDR_LEN;
+    } else {                                                    /* If active wear level req'd ...                       */
+        FS_TRACE_LOG(("FSDev_NOR_FindEraseBlk(): Wear level performed: Blk %d erased.\r\n", blk_ix_min));
+        p_nor_data->BlkWearLevelAvail = DEF_YES;
+        FS_CTR_STAT_INC(p_nor_data->StatWearLevelActiveCtr);
+        return (blk_ix_min);                                    /* ... rtn blk.                                         */
+    }
 
-#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-        if (blk_addr == DEF_INT_32U_MAX_VAL) {
-            FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Failed to get addr of blk ix %d.\r\n", blk_ix));
-           *p_err = FS_ERR_DEV_IO;
-            return;
+
+
+                                                                /* ---------------- CHK FOR PARTIAL BLK --------------- */
+    blk_ix            = 0u;
+    sec_cnt_valid_min = p_nor_data->BlkSecCnts;
+    blk_ix_min        = FS_DEV_NOR_SEC_NBR_INVALID;
+    empty             = DEF_NO;
+    while ((blk_ix <  p_nor_data->BlkCntUsed) &&                /* Probe each block ...                                 */
+           (empty  == DEF_NO)) {                                /* while NO empty blk is found.                         */
+
+        FSDev_NOR_GetBlkInfo( p_nor_data,
+                              blk_ix,
+                             &erased,
+                             &sec_cnt_valid);
+
+        if (erased == DEF_NO) {
+            active = FSDev_NOR_IsAB(p_nor_data, blk_ix);
+            if (active == DEF_YES) {                                                /* If blk is active blk ...         */
+                sec_cnt_valid += FSDev_NOR_AB_SecCntErased(p_nor_data, blk_ix);     /* ... add erased secs.             */
+            }
+
+            if (sec_cnt_valid_min > sec_cnt_valid) {            /* Update min sec cnt.                                  */
+                sec_cnt_valid_min = sec_cnt_valid;
+                blk_ix_min        = blk_ix;
+
+                if (sec_cnt_valid == 0u) {                      /* If blk is empty ...                                  */
+                    empty = DEF_YES;                            /* ... brk from loop.                                   */
+                }
+            }
         }
+
+        blk_ix++;
+    }
+
+
+
+                                                                /* ----------------- RTN MIN VALID BLK ---------------- */
+    return (blk_ix_min);
+}
 #endif
 
-        sec_ix = 0u;
-        while (sec_ix < sec_cnt) {
-            FSDev_NOR_PhyRdHandler( p_nor_data,                 /* Rd blk hdr.                                          */
-                                   &sec_hdr[0],
-                                    sec_addr,
-                                    FS_DEV_NOR_SEC_HDR_LEN,
-                                    p_err);
-            if (*p_err != FS_ERR_NONE) {
-                FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Failed to rd sec hdr %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
-                return;
-            }
 
-            sec_nbr_logical = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_SEC_NBR]);
-            status          = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS]);
+/*
+*********************************************************************************************************
+*                                     FSDev_NOR_FindEraseBlkWear()
+*
+* Description : Find block that needs to be erased (for active wear leveling).
+*
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------          Argument validated by caller.
+*
+* Return(s)   : Block index,                if    block found that needs to be erased.
+*               FS_DEV_NOR_SEC_NBR_INVALID, if NO block            needs to be erased.
+*
+* Note(s)     : (1) Blocks with seldom-changed data will NOT be erased as often as other blocks with pure
+*                   passive wear leveling.  Active wear-leveling purposefully copies data from such blocks
+*                   to new (& more often erased) blocks.  The burden of erasures will subsequently fall
+*                   more heavily upon these old blocks, evening the erase counts.
+*
+*                   (a) The minimum erase count MAY not be accurate, since the minimally-erased block(s)
+*                       may have been erased; since more than one minimally-erased block may exist, the
+*                       minimum erase count is NEVER updated upon erase.
+*
+*               (2) If all minimally-erased blocks are erased, then no block will be found.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  FS_SEC_NBR  FSDev_NOR_FindEraseBlkWear (FS_DEV_NOR_DATA  *p_nor_data)
+{
+    CPU_BOOLEAN  active;
+    CPU_INT08U   blk_hdr[FS_DEV_NOR_BLK_HDR_LEN];
+    FS_SEC_NBR   blk_ix;
+    FS_SEC_NBR   blk_ix_min;
+    CPU_BOOLEAN  erased;
+    CPU_INT32U   erase_cnt;
+    CPU_INT32U   erase_cnt_min;
+    FS_SEC_QTY   sec_cnt_valid_min;
+    FS_SEC_QTY   sec_cnt_valid;
+    FS_ERR       err;
 
 
-                                                                /* ----------------- MOVE DATA IN SEC ----------------- */
-            if ((status          == FS_DEV_NOR_STATUS_SEC_VALID) && /* If sec valid                ...                  */
-                (sec_nbr_logical <  p_nor_data->Size)) {            /* ... & logical sec nbr valid ...                  */
-                                                                    /* ... rd sec                  ...                  */
-                FSDev_NOR_PhyRdHandler( p_nor_data,
-                                        p_nor_data->BufPtr,
-                                       (sec_addr + FS_DEV_NOR_SEC_HDR_LEN),
-                                        p_nor_data->SecSize,
-                                        p_err);
-                if (*p_err != FS_ERR_NONE) {
-                    FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Failed to rd sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
-                    return;
-                }
-                                                                    /* ... & wr to free sec       ... (see Note #3)     */
-                FSDev_NOR_WrSecLogicalHandler(p_nor_data,
-                                              p_nor_data->BufPtr,
-                                              sec_nbr_logical,
-                                              p_err);
-                if (*p_err != FS_ERR_NONE) {
-                    return;
-                }
+                                                                /* ---------- ACTIVE WEAR-LEVEL (see Note #1) --------- */
+                                                                /* If erase cnt th exceeded ...                         */
+    if (p_nor_data->EraseCntMax >= p_nor_data->EraseCntMin + p_nor_data->EraseCntDiffTh) {
+                                                                /* ... find blk with min erase cnt & valid secs.        */
+        blk_ix            = 0u;
+        erase_cnt_min     = p_nor_data->EraseCntMax + 1u;
+	    sec_cnt_valid_min = DEF_MIN(p_nor_data->SecCntErased, p_nor_data->BlkSecCnts);
+        blk_ix_min        = FS_DEV_NOR_SEC_NBR_INVALID;
+        while (blk_ix < p_nor_data->BlkCntUsed) {
+            FSDev_NOR_GetBlkInfo( p_nor_data,
+                                  blk_ix,
+                                 &erased,
+                                 &sec_cnt_valid);
 
-                MEM_VAL_SET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS], FS_DEV_NOR_STATUS_SEC_INVALID);
+            FSDev_NOR_RdBlkHdr( p_nor_data,
+                               &blk_hdr[0],
+                                blk_ix,
+                               &err);
+            if (err != FS_ERR_NONE) {
+                return (FS_DEV_NOR_SEC_NBR_INVALID);            /* #### Add rtn err val.                                */
+            }
 
-                FSDev_NOR_PhyWrHandler( p_nor_data,             /* Mark sec as 'invalid'.                               */
-                                       &sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS],
-                                        sec_addr + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS,
-                                        4u,
-                                        p_err);
-                if (*p_err != FS_ERR_NONE) {
-                    FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Failed to wr hdr of sec %d (0x%08X).\r\n", sec_nbr_phy, sec_addr));
-                    return;
-                }
+            erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT]);
+            if (erase_cnt_min > erase_cnt) {                    /* Update min erase cnt.                                */
+                erase_cnt_min = erase_cnt;
+            }
 
-#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-                if (sec_cnt_valid == 0u) {
-                    FSDev_NOR_IncBlkSecCntValid(p_nor_data, blk_ix);
-                    FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Too many valid secs found in blk ix %d.\r\n", blk_ix));
-                   *p_err = FS_ERR_DEV_IO;
-                    return;
-                }
-#endif
-                FSDev_NOR_DecBlkSecCntValid(p_nor_data, blk_ix);
-                sec_cnt_valid--;
-#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-                if (p_nor_data->SecCntValid < 1u) {
-                    FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Unexpectedly few valid secs (%d) exist in NOR.\r\n", p_nor_data->SecCntValid));
-                   *p_err = FS_ERR_DEV_IO;
-                    return;
+            if (erased == DEF_NO) {                             /* If blk is NOT erased        ...                      */
+                active = FSDev_NOR_IsAB(p_nor_data, blk_ix);
+                if (active == DEF_NO) {                         /* ... & blk is NOT active blk ...                      */
+                                                                /* ... & erase cnt below th    ...                      */
+                    if (p_nor_data->EraseCntMax >= erase_cnt + p_nor_data->EraseCntDiffTh) {
+                        if (sec_cnt_valid_min > sec_cnt_valid) {/* ... & fewer valid secs      ...                      */
+                            sec_cnt_valid_min = sec_cnt_valid;
+                            blk_ix_min        = blk_ix;         /* ... sel blk.                                         */
+                        }
+                    }
                 }
-#endif
-                p_nor_data->SecCntValid--;
-                p_nor_data->SecCntInvalid++;
-                FS_CTR_STAT_INC(p_nor_data->StatCopyCtr);
             }
 
-            sec_addr += p_nor_data->SecSize + FS_DEV_NOR_SEC_HDR_LEN;
-            sec_ix++;
-            sec_nbr_phy++;
+            blk_ix++;
         }
 
-#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-        if (sec_cnt_valid != 0u) {
-            FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Too few valid secs (%d more expected) found in blk ix %d.\r\n", sec_cnt_valid));
+        p_nor_data->EraseCntMin = erase_cnt_min;                /* Update cnt min w/actual erase cnt min.               */
 
-#if (FS_TRACE_LEVEL >= TRACE_LEVEL_DBG)
-            if (p_nor_data->SecCntValid < sec_cnt_valid) {
-                FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Unexpectedly few valid secs (%d) exist in NOR.\r\n", p_nor_data->SecCntValid));
-            }
-#endif
-           *p_err = FS_ERR_DEV_IO;
-            return;
+        if (blk_ix_min == FS_DEV_NOR_SEC_NBR_INVALID) {         /* Verify blk ix min (see Note #2).                     */
+            return (FS_DEV_NOR_SEC_NBR_INVALID);
         }
-#endif
 
-#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-        if (p_nor_data->BlkCntValid < 1u) {
-            FS_TRACE_DBG(("FSDev_NOR_EraseBlkPrepare(): Unexpectedly few valid blks (%d) exist in NOR.\r\n", p_nor_data->BlkCntValid));
-           *p_err = FS_ERR_DEV_IO;
-            return;
+#if (FS_TRACE_LEVEL >= TRACE_LEVEL_LOG)
+        if (p_nor_data->EraseCntMin < erase_cnt_min) {
+            FS_TRACE_LOG(("FSDev_NOR_FindEraseBlkWear(): Min erase cnt now %d (prev was %d).\r\n", erase_cnt_min, p_nor_data->EraseCntMin));
         }
 #endif
-        p_nor_data->BlkCntValid--;                              /* One fewer valid blks (see Note #2).                  */
-        p_nor_data->BlkCntInvalid++;
-    }
-
 
 
+                                                                /* If erase cnt th still exceeded (see Note #1a) ...    */
+        if (p_nor_data->EraseCntMax >= p_nor_data->EraseCntMin + p_nor_data->EraseCntDiffTh) {
+            return (blk_ix_min);                                /* ... erase blk.                                       */
+        }
+    }
 
 
-                                                                /* --------------------- ERASE BLK -------------------- */
-    FSDev_NOR_EraseBlkEmptyFmt(p_nor_data, blk_ix, p_err);
-    if (*p_err != FS_ERR_NONE) {
-        return;
-    }
 
-   *p_err = FS_ERR_NONE;
+                                                                /* -------------------- RTN NO BLK -------------------- */
+    return (FS_DEV_NOR_SEC_NBR_INVALID);
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*                                    FSDev_NOR_EraseBlkEmptyFmt()
+*                                      FSDev_NOR_FindErasedBlk()
 *
-* Description : Erase empty block.
+* Description : Find block that is erased.
 *
 * Argument(s) : p_nor_data  Pointer to NOR data.
 *               ----------  Argument validated by caller.
 *
-*               blk_ix      Block index.
-*
-*               p_err       Pointer to variable that will receive the return error code from this function :
-*               ----------  Argument validated by caller.
-*
-*                               FS_ERR_NONE           Block erased successfully.
-*                               FS_ERR_DEV_IO         Device I/O error.
-*                               FS_ERR_DEV_TIMEOUT    Device timeout.
+* Return(s)   : Block index,                if    erased block found.
+*               FS_DEV_NOR_SEC_NBR_INVALID, if NO erased block found.
 *
-* Return(s)   : none.
+* Note(s)     : (1) The erased block with the lowest erase count is selected.
 *
-* Note(s)     : (1) To erase a block :
-*                   (a) Find/calculation location of block.
-*                   (b) Erase block.
-*                   (c) Write block header.
+*                   (a) #### Optimize for cases with one erased blk OR no large erase count differences.
 *
-*               (2) A block may lose its erase count if the block erase is interrupted, or if the block
-*                   header is not completely written.  The block is assumed to have the maximum erase
-*                   count upon restart.  Wear-leveling erased block approximately uniformly, so this
-*                   should be close to true block count.
+*               (2) There may be no block with erase count as low as 'EraseCntMin' (see
+*                   'FSDev_NOR_FindEraseBlkWear()  Note #1a').
 *********************************************************************************************************
 */
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  void  FSDev_NOR_EraseBlkEmptyFmt (FS_DEV_NOR_DATA  *p_nor_data,
-                                          FS_SEC_NBR        blk_ix,
-                                          FS_ERR           *p_err)
+static  FS_SEC_NBR  FSDev_NOR_FindErasedBlk (FS_DEV_NOR_DATA  *p_nor_data)
 {
-    CPU_INT32U  blk_addr;
-    CPU_INT32U  erase_cnt;
-    CPU_INT08U  blk_hdr[FS_DEV_NOR_BLK_HDR_LEN];
-    CPU_INT08U  erase_cnt_octets[4];
+    CPU_INT08U   blk_hdr[FS_DEV_NOR_BLK_HDR_LEN];
+    FS_SEC_QTY   blk_cnt_erased;
+    FS_SEC_NBR   blk_ix;
+    FS_SEC_NBR   blk_ix_erased;
+    CPU_BOOLEAN  erased;
+    CPU_INT32U   erase_cnt;
+    CPU_INT32U   erase_cnt_min;
+    CPU_BOOLEAN  found;
+    FS_SEC_QTY   sec_cnt_valid;
+    FS_ERR       err;
 
 
-                                                                /* --------------------- ERASE BLK -------------------- */
-    blk_addr      = FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix);
-#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-    if (blk_addr == DEF_INT_32U_MAX_VAL) {
-        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Failed to get addr of blk ix %d.\r\n", blk_ix));
-       *p_err = FS_ERR_DEV_IO;
-        return;
-    }
-#endif
+    blk_cnt_erased = 0u;
+    blk_ix         = 0u;
+    blk_ix_erased  = FS_DEV_NOR_SEC_NBR_INVALID;
+    erase_cnt_min  = p_nor_data->EraseCntMax + 1u;
+    found          = DEF_NO;
+    while ((found  == DEF_NO) &&
+           (blk_ix <  p_nor_data->BlkCntUsed)) {
+        FSDev_NOR_GetBlkInfo( p_nor_data,
+                              blk_ix,
+                             &erased,
+                             &sec_cnt_valid);
+        if (erased == DEF_YES) {
+            blk_cnt_erased++;
 
-    FSDev_NOR_PhyRdHandler( p_nor_data,                         /* Rd erase cnt.                                        */
-                           &erase_cnt_octets[0],
-                           (blk_addr + FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT),
-                            4u,
-                            p_err);
-    if (*p_err != FS_ERR_NONE) {
-        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Failed to rd erase cnts of blk %d (0x%08X).\r\n", blk_ix, blk_addr));
-        return;
-    }
+            FSDev_NOR_RdBlkHdr( p_nor_data,
+                               &blk_hdr[0],
+                                blk_ix,
+                               &err);
+            if (err != FS_ERR_NONE) {                               /* If hdr could NOT be rd ...                       */
+                return (FS_DEV_NOR_SEC_NBR_INVALID);                /* ... rtn invalid blk ix.                          */
+            }
 
+            erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT]);
+            if (erase_cnt_min > erase_cnt) {                        /* If lower erase cnt (see Note #1) ...             */
+                erase_cnt_min = erase_cnt;
+                blk_ix_erased = blk_ix;                             /* ... sel this blk.                                */
 
-    erase_cnt = MEM_VAL_GET_INT32U((void *)&erase_cnt_octets[0]);
-    if (erase_cnt == FS_DEV_NOR_BLK_HDR_ERASE_CNT_INVALID) {
-        erase_cnt  = p_nor_data->EraseCntMax;                   /* If erase cnt invalid, set to max cnt (see Note #2).  */
-    } else {
-        erase_cnt++;
-        if (p_nor_data->EraseCntMax < erase_cnt) {
-            FS_TRACE_LOG(("FSDev_NOR_EraseBlkEmptyFmt(): Max erase cnt now %d (prev was %d).\r\n", erase_cnt, p_nor_data->EraseCntMax));
-            p_nor_data->EraseCntMax = erase_cnt;
+
+                if (erase_cnt_min == p_nor_data->EraseCntMin) {     /* If least erased blk (see Note #2) ...            */
+                    found = DEF_YES;                                /* ... stop srch.                                   */
+                }
+                if (blk_cnt_erased >= p_nor_data->BlkCntErased) {   /* If no more erased blks exist ...                 */
+                    found = DEF_YES;                                /* ... stop srch.                                   */
+                }
+            }
         }
-    }
-
-    FSDev_NOR_PhyEraseBlkHandler(p_nor_data,                    /* Erase blk.                                           */
-                                 blk_addr,
-                                 p_nor_data->PhyDataPtr->BlkSize,
-                                 p_err);
 
-    if (*p_err != FS_ERR_NONE) {
-        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Failed to erase blk ix %d (0x%08X).\r\n", blk_ix, blk_addr));
-        return;
+        blk_ix++;
     }
 
-    FS_TRACE_LOG(("FSDev_NOR_EraseBlkEmptyFmt(): Erased blk %d (0x%08X) w/erase cnt %d.\r\n", blk_ix, blk_addr, erase_cnt));
+    p_nor_data->BlkWearLevelAvail = DEF_NO;
 
+    return (blk_ix_erased);
+}
+#endif
 
-                                                                /* --------------------- WR BLK HDR ------------------- */
-    MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_MARK1],     FS_DEV_NOR_BLK_HDR_MARK_WORD_1);
-    MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_MARK2],     FS_DEV_NOR_BLK_HDR_MARK_WORD_2);
-    MEM_VAL_SET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT], erase_cnt);
-    MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_VER],       FS_DEV_NOR_BLK_HDR_VER);
-    MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_SEC_SIZE],  p_nor_data->SecSize);
-    MEM_VAL_SET_INT16U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_BLK_CNT],   p_nor_data->BlkCntUsed);
 
-    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* Wr hdr.                                              */
-                           &blk_hdr[0],
-                            blk_addr,
-                            FS_DEV_NOR_BLK_HDR_LEN,
-                            p_err);
-    if (*p_err != FS_ERR_NONE) {
-        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Failed to wr blk hdr ix %d (0x%08X).\r\n", blk_ix, blk_addr));
-        return;
-    }
+/*
+*********************************************************************************************************
+*                                        FSDev_NOR_CkptFind()
+*
+* Description : Find most recent checkpoint.
+*
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE           Checkpoint slots read.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Among the slots holding a valid checkpoint of this format, the one with the highest
+*                   sequence number is current.  A slot whose status was never programmed holds an
+*                   incomplete checkpoint (see 'FSDev_NOR_CkptWr()  Note #1') & is ignored.
+*
+*                   If no checkpoint is found, the next is written to slot 0 with sequence number 1.
+*
+*               (2) Sequence numbers are compared modulo 2^32.
+*********************************************************************************************************
+*/
 
+#if ((FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED) && \
+     (FS_CFG_RD_ONLY_EN      == DEF_DISABLED))
+static  void  FSDev_NOR_CkptFind (FS_DEV_NOR_DATA  *p_nor_data,
+                                  FS_ERR           *p_err)
+{
+    CPU_INT08U  ckpt_hdr[FS_DEV_NOR_CKPT_HDR_LEN];
+    CPU_INT32U  mark1;
+    CPU_INT32U  mark2;
+    CPU_INT32U  seq;
+    CPU_INT16U  ver;
+    CPU_INT16U  sec_size;
+    CPU_INT16U  blk_cnt;
+    CPU_INT32U  size;
+    CPU_INT32U  status;
+    CPU_INT08U  slot;
+
+
+    p_nor_data->CkptSlotCur  = FS_DEV_NOR_CKPT_SLOT_CNT - 1u;
+    p_nor_data->CkptSeq      = 0u;
+    p_nor_data->CkptValid    = DEF_NO;
+    p_nor_data->CkptEraseCtr = 0u;
+
+    slot = 0u;
+    while (slot < FS_DEV_NOR_CKPT_SLOT_CNT) {
+        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* Rd ckpt hdr.                                         */
+                               &ckpt_hdr[0],
+                                FSDev_NOR_CkptSlotAddr(p_nor_data, slot),
+                                FS_DEV_NOR_CKPT_HDR_LEN,
+                                p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
 
-                                                                /* -------------------- UPDATE INFO ------------------- */
-    p_nor_data->BlkCntErased++;                                 /* Another erased blk.                                  */
-#if (FS_DEV_NOR_CFG_DBG_CHK_EN == DEF_ENABLED)
-    if (p_nor_data->BlkCntInvalid == 0u) {
-        FS_TRACE_DBG(("FSDev_NOR_EraseBlkEmptyFmt(): Invalid blk cnt == 0 upon erase of blk %d.\r\n", blk_ix));
-       *p_err = FS_ERR_DEV_IO;
-        return;
-    }
-#endif
-    p_nor_data->BlkCntInvalid--;                                /* One fewer invalid blks.                              */
-    p_nor_data->SecCntErased  += p_nor_data->BlkSecCnts;        /* More erased secs.                                    */
-    p_nor_data->SecCntInvalid -= p_nor_data->BlkSecCnts;        /* Fewer invalid secs.                                  */
+        mark1    = MEM_VAL_GET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_MARK1]);
+        mark2    = MEM_VAL_GET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_MARK2]);
+        seq      = MEM_VAL_GET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_SEQ]);
+        ver      = MEM_VAL_GET_INT16U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_VER]);
+        sec_size = MEM_VAL_GET_INT16U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_SEC_SIZE]);
+        blk_cnt  = MEM_VAL_GET_INT16U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_BLK_CNT]);
+        size     = MEM_VAL_GET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_SIZE]);
+        status   = MEM_VAL_GET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_STATUS]);
+
+        if ((mark1    == FS_DEV_NOR_BLK_HDR_MARK_WORD_1)  &&    /* If slot holds valid ckpt of this fmt ...             */
+            (mark2    == FS_DEV_NOR_CKPT_HDR_MARK_WORD_2) &&
+            (ver      == FS_DEV_NOR_BLK_HDR_VER)          &&
+            (sec_size == p_nor_data->SecSize)             &&
+            (blk_cnt  == p_nor_data->BlkCntUsed)          &&
+            (size     == p_nor_data->Size)                &&
+            (status   == FS_DEV_NOR_STATUS_SEC_VALID)) {
+                                                                /* ... & more recent (see Note #2)  ...                 */
+            if ((p_nor_data->CkptValid == DEF_NO) ||
+                ((CPU_INT32S)(seq - p_nor_data->CkptSeq) > 0)) {
+                p_nor_data->CkptSlotCur = slot;                 /* ... sel slot.                                        */
+                p_nor_data->CkptSeq     = seq;
+                p_nor_data->CkptValid   = DEF_YES;
+            }
+        }
 
-    FSDev_NOR_SetBlkErased(p_nor_data,                          /* Blk is erased.                                       */
-                           blk_ix,
-                           DEF_YES);
+        slot++;
+    }
 
-   *p_err = FS_ERR_NONE;
+    if (p_nor_data->CkptValid == DEF_YES) {
+        FS_TRACE_LOG(("FSDev_NOR_CkptFind(): Ckpt %d found in slot %d.\r\n", p_nor_data->CkptSeq, p_nor_data->CkptSlotCur));
+    } else {
+        FS_TRACE_LOG(("FSDev_NOR_CkptFind(): No valid ckpt found.\r\n"));
+    }
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*                                       FSDev_NOR_FindEraseBlk()
+*                                        FSDev_NOR_CkptLoad()
 *
-* Description : Find block that needs to be erased.
+* Description : Mount device from the current checkpoint.
 *
-* Argument(s) : p_nor_data  Pointer to NOR data.
-*               ----------  Argument validated by caller.
+* Argument(s) : p_nor_data          Pointer to NOR data.
+*               ----------          Argument validated by caller.
 *
-* Return(s)   : Block index,                if    block found that needs to be erased.
-*               FS_DEV_NOR_SEC_NBR_INVALID, if NO block            needs to be erased.
+*               p_blk_cnt_valid     Pointer to variable that will receive the number of blocks with valid data.
+*               ---------------     Argument validated by caller.
 *
-* Note(s)     : (1) (a) Blocks may be erased under one of two conditions :
-*                       (1) The erase count difference threshold is exceeded, i.e., a block exists that
-*                           has been erased 'EraseCntDiffTh' fewer times than the most often
-*                           erased block.
-*                       (2) Fewer block exist than ...
-*                           (A) ... 1, if there is an active block assigned;
-*                           (B) ... 2, if there is NO active block assigned.
+*               p_blk_cnt_erased    Pointer to variable that will receive the number of erased blocks.
+*               ----------------    Argument validated by caller.
 *
-*                           This maintains the minimum number erase blocks required by the driver (see also
-*                           'FSDev_NOR_EraseBlkPrepare()  Note #3').
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*               ----------          Argument validated by caller.
 *
-*                   (b) The block chosen for erasure is either :
-*                       (1) The block with the lowest erase count.
-*                       (2) The block with the fewest valid sectors.
-*                       The former is chosen if the difference between the block's erase count & the
-*                       maximum is greater than some maximum value; the default maximum is 100 erasures.
+*                                       FS_ERR_NONE           Checkpoint loaded, or NO valid checkpoint.
+*                                       FS_ERR_DEV_IO         Device I/O error.
+*                                       FS_ERR_DEV_TIMEOUT    Device timeout.
 *
-*                   (c) Blocks are erased until no more block such as #1a1 exist, & until enough
-*                       sectors (#1a2) are unoccupied.
+* Return(s)   : DEF_YES, if the device was mounted from the checkpoint.
+*               DEF_NO,  otherwise; every block must be scanned.
+*
+* Caller(s)   : FSDev_NOR_LowMountHandler().
+*
+* Note(s)     : (1) The L2P table is restored from the checkpoint.  Then :
+*
+*                   (a) A block whose erase count differs from the recorded one was erased since the
+*                       checkpoint was written.  Its valid sectors were copied before the erase, so the
+*                       L2P entries restored into it are cleared, & it is scanned from its first sector.
+*                       The erase map marks these blocks until they are scanned.
+*
+*                   (b) Sectors are written in order, from the next unwritten sector of an active block.
+*                       Every other block is scanned from its next unwritten sector as recorded, unless
+*                       that sector is still erased, in which case the block was NOT written since.
+*
+*               (2) A valid sector found in a scan was written after the checkpoint, so it supersedes the
+*                   L2P entry.  If the write that produced it was interrupted, the sector it replaces may
+*                   still be valid; that sector is then marked invalid, as it would have been.
+*
+*               (3) Valid sector counts are recounted from the L2P table, & blocks are classified as by
+*                   'FSDev_NOR_LowMountHandler()'.  The erased sectors of a block that CANNOT be added to
+*                   the active blocks are classified as invalid.
+*
+*               (4) A checkpoint that is inconsistent with the blocks (an L2P entry beyond the device or
+*                   in erased sectors, or a next unwritten sector beyond its block) is invalidated & the
+*                   device information is cleared, so that every block is scanned.
+*
+*               (5) Releasing a sector does NOT write a checkpoint.  A sector released since the checkpoint
+*                   keeps the L2P entry restored from it, as if power had been lost before the release :
+*                   its stale contents are read back, & its copy is moved when its block is erased, until
+*                   the sector is next written or released.  If its block was erased since, the entry is
+*                   cleared (see Note #1a).
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  FS_SEC_NBR  FSDev_NOR_FindEraseBlk (FS_DEV_NOR_DATA  *p_nor_data)
+#if ((FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED) && \
+     (FS_CFG_RD_ONLY_EN      == DEF_DISABLED))
+static  CPU_BOOLEAN  FSDev_NOR_CkptLoad (FS_DEV_NOR_DATA  *p_nor_data,
+                                         FS_SEC_QTY       *p_blk_cnt_valid,
+                                         FS_SEC_QTY       *p_blk_cnt_erased,
+                                         FS_ERR           *p_err)
 {
+    CPU_INT08U   blk_info[FS_DEV_NOR_CKPT_BLK_INFO_LEN];
+    CPU_INT08U   sec_hdr[FS_DEV_NOR_SEC_HDR_LEN];
+    CPU_INT08U   erase_cnt_octets[4];
+    CPU_INT08U   status_octets[4];
     CPU_BOOLEAN  active;
-    FS_SEC_QTY   active_blk_cnt;
+    CPU_INT32U   blk_addr;
+    FS_SEC_QTY   blk_cnt_erased;
+    FS_SEC_QTY   blk_cnt_valid;
     FS_SEC_NBR   blk_ix;
-    FS_SEC_NBR   blk_ix_min;
-    CPU_BOOLEAN  empty;
+    CPU_INT32U   blk_info_addr;
+    CPU_BOOLEAN  consistent;
     CPU_BOOLEAN  erased;
-    FS_SEC_QTY   sec_cnt_valid_min;
+    CPU_INT32U   erase_cnt;
+    FS_SEC_QTY   sec_cnt_erased;
     FS_SEC_QTY   sec_cnt_valid;
+    CPU_BOOLEAN  scan;
+    FS_SEC_NBR   sec_ix;
+    FS_SEC_NBR   sec_ix_next;
+    FS_SEC_NBR   sec_ix_start;
+    FS_SEC_NBR   sec_nbr_logical;
+    FS_SEC_NBR   sec_nbr_phy;
+    FS_SEC_NBR   sec_nbr_phy_old;
+    CPU_INT32U   slot_addr;
+    CPU_INT32U   status;
 
 
-                                                                /* ----------------- CHK FOR ERASE TH ----------------- */
-                                                                /* If enough blks erased                 ...            */
-    active_blk_cnt = FSDev_NOR_GetAB_Cnt(p_nor_data);
-    if (p_nor_data->BlkCntErased >= 1u) {
-                                                                /* ... & erase cnt diff th satisfied  OR ...            */
-        if ((p_nor_data->EraseCntMax       < p_nor_data->EraseCntMin + p_nor_data->EraseCntDiffTh) ||
-                                                                /* ...   erased wear-level blk exists OR ...            */
-            (p_nor_data->BlkWearLevelAvail == DEF_YES)                                             ||
-                                                                /* ...   sufficient blks erased       OR ...            */
-            (p_nor_data->BlkCntErased      >= 2u)                                                  ||
-                                                                /* ...   at least one blk active         ...            */
-            (active_blk_cnt                >  0u)) {
-            return (FS_DEV_NOR_SEC_NBR_INVALID);                /* ... do not erase a blk yet.                          */
+   *p_blk_cnt_valid  = 0u;
+   *p_blk_cnt_erased = 0u;
+
+    if (p_nor_data->CkptValid == DEF_NO) {                      /* If no valid ckpt, scan every blk.                    */
+       *p_err = FS_ERR_NONE;
+        return (DEF_NO);
+    }
+
+    slot_addr     = FSDev_NOR_CkptSlotAddr(p_nor_data, p_nor_data->CkptSlotCur);
+    blk_info_addr = slot_addr + FS_DEV_NOR_CKPT_HDR_LEN + p_nor_data->CkptTblSize;
+
+
+
+                                                                /* -------------------- RD L2P TBL -------------------- */
+    FSDev_NOR_PhyRdHandler(p_nor_data,
+                           p_nor_data->L2P_Tbl,
+                           slot_addr + FS_DEV_NOR_CKPT_HDR_LEN,
+                           p_nor_data->CkptTblSize,
+                           p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (DEF_NO);
+    }
+
+
+
+                                                                /* ------------ FIND ERASED BLKS (see Note #1a) ------- */
+    blk_ix = 0u;
+    while (blk_ix < p_nor_data->BlkCntUsed) {
+        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* Rd recorded erase cnt ...                            */
+                               &blk_info[0],
+                                blk_info_addr + (blk_ix * FS_DEV_NOR_CKPT_BLK_INFO_LEN),
+                                FS_DEV_NOR_CKPT_BLK_INFO_LEN,
+                                p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (DEF_NO);
+        }
+
+        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* ... & cur erase cnt.                                 */
+                               &erase_cnt_octets[0],
+                                FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix) + FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT,
+                                4u,
+                                p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (DEF_NO);
+        }
+
+        erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_info[FS_DEV_NOR_CKPT_BLK_INFO_OFFSET_ERASE_CNT]);
+        erased    = (MEM_VAL_GET_INT32U((void *)&erase_cnt_octets[0]) != erase_cnt) ? DEF_YES : DEF_NO;
+        FSDev_NOR_SetBlkErased(p_nor_data, blk_ix, erased);
+
+        blk_ix++;
+    }
+
+    consistent      = DEF_YES;
+    sec_nbr_logical = 0u;
+    while ((sec_nbr_logical <  p_nor_data->Size) &&
+           (consistent      == DEF_YES)) {
+        sec_nbr_phy = FSDev_NOR_L2P_GetEntry(p_nor_data, sec_nbr_logical);
+        if (sec_nbr_phy != FS_DEV_NOR_SEC_NBR_INVALID) {
+            if (sec_nbr_phy >= p_nor_data->SecCntTot) {         /* See Note #4.                                         */
+                consistent = DEF_NO;
+            } else {
+                blk_ix = FSDev_NOR_SecNbrPhy_to_BlkIx(p_nor_data, sec_nbr_phy);
+                FSDev_NOR_GetBlkInfo( p_nor_data,
+                                      blk_ix,
+                                     &erased,
+                                     &sec_cnt_valid);
+                if (erased == DEF_YES) {                        /* Clr entries in erased blks (see Note #1a).           */
+                    FSDev_NOR_L2P_SetEntry(p_nor_data,
+                                           sec_nbr_logical,
+                                           FS_DEV_NOR_SEC_NBR_INVALID);
+                }
+            }
         }
+        sec_nbr_logical++;
     }
 
 
 
-                                                                /* ----------------- ACTIVE WEAR-LEVEL ---------------- */
-    blk_ix_min = FSDev_NOR_FindEraseBlkWear(p_nor_data);
-    if (blk_ix_min == FS_DEV_NOR_SEC_NBR_INVALID) {             /* If NO minimally-erased blk    ...                    */
-                                                                /* ... but if enough blks erased ...                    */
-        if ( (p_nor_data->BlkCntErased >= 2u) ||
-            ((p_nor_data->BlkCntErased >= 1u) && (active_blk_cnt > 0u))) {
-            return (FS_DEV_NOR_SEC_NBR_INVALID);                /* ... do not erase a blk yet.                          */
+                                                                /* ------------ SCAN WR'N SECS (see Note #1b) --------- */
+    blk_ix = 0u;
+    while ((blk_ix     <  p_nor_data->BlkCntUsed) &&
+           (consistent == DEF_YES)) {
+        FSDev_NOR_GetBlkInfo( p_nor_data,
+                              blk_ix,
+                             &erased,
+                             &sec_cnt_valid);
+        if (erased == DEF_YES) {                                /* If blk erased since ckpt, scan from 1st sec.         */
+            sec_ix = 0u;
+        } else {
+            FSDev_NOR_PhyRdHandler( p_nor_data,
+                                   &blk_info[0],
+                                    blk_info_addr + (blk_ix * FS_DEV_NOR_CKPT_BLK_INFO_LEN),
+                                    FS_DEV_NOR_CKPT_BLK_INFO_LEN,
+                                    p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return (DEF_NO);
+            }
+            sec_ix = MEM_VAL_GET_INT32U((void *)&blk_info[FS_DEV_NOR_CKPT_BLK_INFO_OFFSET_SEC_IX_NEXT]);
         }
 
+        if (sec_ix > p_nor_data->BlkSecCnts) {                  /* See Note #4.                                         */
+            consistent = DEF_NO;
+        } else {
+            scan         = DEF_YES;
+            sec_ix_start = sec_ix;
+            sec_ix_next  = sec_ix;
+            sec_nbr_phy  = FSDev_NOR_BlkIx_to_SecNbrPhy(p_nor_data, blk_ix) + sec_ix;
+            blk_addr     = FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy);
+            while ((sec_ix <  p_nor_data->BlkSecCnts) &&
+                   (scan   == DEF_YES)) {
+                FSDev_NOR_PhyRdHandler( p_nor_data,
+                                       &sec_hdr[0],
+                                        blk_addr,
+                                        FS_DEV_NOR_SEC_HDR_LEN,
+                                        p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    return (DEF_NO);
+                }
+                sec_nbr_logical = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_SEC_NBR]);
+                status          = MEM_VAL_GET_INT32U((void *)&sec_hdr[FS_DEV_NOR_SEC_HDR_OFFSET_STATUS]);
+
+                if (status != FS_DEV_NOR_STATUS_SEC_ERASED) {
+                    sec_ix_next = sec_ix + 1u;                  /* Set next potentially erased sec.                     */
+
+                    if ((status          == FS_DEV_NOR_STATUS_SEC_VALID) &&
+                        (sec_nbr_logical <  p_nor_data->Size)) {
+                        sec_nbr_phy_old = FSDev_NOR_L2P_GetEntry(p_nor_data, sec_nbr_logical);
+                        if (sec_nbr_phy_old != FS_DEV_NOR_SEC_NBR_INVALID) {
+                            FSDev_NOR_PhyRdHandler( p_nor_data, /* Rd status of replaced sec (see Note #2).             */
+                                                   &status_octets[0],
+                                                    FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy_old) + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS,
+                                                    4u,
+                                                    p_err);
+                            if (*p_err != FS_ERR_NONE) {
+                                return (DEF_NO);
+                            }
+
+                            if (MEM_VAL_GET_INT32U((void *)&status_octets[0]) == FS_DEV_NOR_STATUS_SEC_VALID) {
+                                MEM_VAL_SET_INT32U((void *)&status_octets[0], FS_DEV_NOR_STATUS_SEC_INVALID);
+                                FSDev_NOR_PhyWrHandler( p_nor_data,
+                                                       &status_octets[0],
+                                                        FSDev_NOR_SecNbrPhy_to_Addr(p_nor_data, sec_nbr_phy_old) + FS_DEV_NOR_SEC_HDR_OFFSET_STATUS,
+                                                        4u,
+                                                        p_err);
+                                if (*p_err != FS_ERR_NONE) {
+                                    return (DEF_NO);
+                                }
+                                FS_TRACE_DBG(("FSDev_NOR_CkptLoad(): Logical sec %d assigned to phy sec %d; invalidating %d.\r\n", sec_nbr_logical, sec_nbr_phy, sec_nbr_phy_old));
+                            }
+                        }
 
-    } else {                                                    /* If active wear level req'd ...                       */
-        FS_TRACE_LOG(("FSDev_NOR_FindEraseBlk(): Wear level performed: Blk %d erased.\r\n", blk_ix_min));
-        p_nor_data->BlkWearLevelAvail = DEF_YES;
-        return (blk_ix_min);                                    /* ... rtn blk.                                         */
+                        FSDev_NOR_L2P_SetEntry(p_nor_data,
+                                               sec_nbr_logical,
+                                               sec_nbr_phy);
+                    }
+
+                } else if (sec_ix == sec_ix_start) {            /* If next unwritten sec still erased ...               */
+                    scan = DEF_NO;                              /* ... blk NOT wr'n since ckpt.                         */
+                }
+
+                blk_addr += p_nor_data->SecSize + FS_DEV_NOR_SEC_HDR_LEN;
+                sec_ix++;
+                sec_nbr_phy++;
+            }
+
+            erased = (sec_ix_next == 0u) ? DEF_YES : DEF_NO;
+            FSDev_NOR_SetBlkErased(p_nor_data, blk_ix, erased);
+
+            if ((sec_ix_next >  0u) &&                          /* If blk has erased secs ...                           */
+                (sec_ix_next <  p_nor_data->BlkSecCnts)) {
+                active = FSDev_NOR_AB_Add(p_nor_data,           /* ... try to add to list of active blks.               */
+                                          blk_ix,
+                                          sec_ix_next);
+                if (active != DEF_OK) {
+                    FS_TRACE_LOG(("FSDev_NOR_CkptLoad(): Could not make blk %d active blk; reclassifying %d erased secs as invalid.\r\n", blk_ix, p_nor_data->BlkSecCnts - sec_ix_next));
+                }
+            }
+        }
+
+        blk_ix++;
     }
 
 
 
-                                                                /* ---------------- CHK FOR PARTIAL BLK --------------- */
-    blk_ix            = 0u;
-    sec_cnt_valid_min = p_nor_data->BlkSecCnts;
-    blk_ix_min        = FS_DEV_NOR_SEC_NBR_INVALID;
-    empty             = DEF_NO;
-    while ((blk_ix <  p_nor_data->BlkCntUsed) &&                /* Probe each block ...                                 */
-           (empty  == DEF_NO)) {                                /* while NO empty blk is found.                         */
+                                                                /* ------------ CNT VALID SECS (see Note #3) ---------- */
+    blk_ix = 0u;
+    while (blk_ix < p_nor_data->BlkCntUsed) {
+        FSDev_NOR_SetBlkSecCntValid(p_nor_data, blk_ix, 0u);
+        blk_ix++;
+    }
+
+    sec_nbr_logical = 0u;
+    while ((sec_nbr_logical <  p_nor_data->Size) &&
+           (consistent      == DEF_YES)) {
+        sec_nbr_phy = FSDev_NOR_L2P_GetEntry(p_nor_data, sec_nbr_logical);
+        if (sec_nbr_phy != FS_DEV_NOR_SEC_NBR_INVALID) {
+            blk_ix = FSDev_NOR_SecNbrPhy_to_BlkIx(p_nor_data, sec_nbr_phy);
+            FSDev_NOR_GetBlkInfo( p_nor_data,
+                                  blk_ix,
+                                 &erased,
+                                 &sec_cnt_valid);
+            sec_cnt_erased = FSDev_NOR_AB_SecCntErased(p_nor_data, blk_ix);
+            sec_ix         = sec_nbr_phy - FSDev_NOR_BlkIx_to_SecNbrPhy(p_nor_data, blk_ix);
+            if ((erased == DEF_YES) ||                          /* See Note #4.                                         */
+                (sec_ix >= p_nor_data->BlkSecCnts - sec_cnt_erased)) {
+                consistent = DEF_NO;
+            } else {
+                FSDev_NOR_IncBlkSecCntValid(p_nor_data, blk_ix);
+                p_nor_data->SecCntValid++;
+            }
+        }
+        sec_nbr_logical++;
+    }
 
+    if (consistent == DEF_NO) {                                 /* If ckpt inconsistent (see Note #4) ...               */
+        FS_TRACE_DBG(("FSDev_NOR_CkptLoad(): Ckpt %d inconsistent; scanning all blks.\r\n", p_nor_data->CkptSeq));
+        FSDev_NOR_CkptInvalidate(p_nor_data, p_err);            /* ... invalidate ckpt ...                              */
+        if (*p_err != FS_ERR_NONE) {
+            return (DEF_NO);
+        }
+        FSDev_NOR_LowUnmountHandler(p_nor_data, p_err);         /* ... & clr dev info.                                  */
+        return (DEF_NO);
+    }
+
+
+
+                                                                /* -------------------- CLASSIFY BLKS ----------------- */
+    blk_cnt_valid  = 0u;
+    blk_cnt_erased = 0u;
+    blk_ix         = 0u;
+    while (blk_ix < p_nor_data->BlkCntUsed) {
         FSDev_NOR_GetBlkInfo( p_nor_data,
                               blk_ix,
                              &erased,
                              &sec_cnt_valid);
-
-        if (erased == DEF_NO) {
-            active = FSDev_NOR_IsAB(p_nor_data, blk_ix);
-            if (active == DEF_YES) {                                                /* If blk is active blk ...         */
-                sec_cnt_valid += FSDev_NOR_AB_SecCntErased(p_nor_data, blk_ix);     /* ... add erased secs.             */
-            }
-
-            if (sec_cnt_valid_min > sec_cnt_valid) {            /* Update min sec cnt.                                  */
-                sec_cnt_valid_min = sec_cnt_valid;
-                blk_ix_min        = blk_ix;
-
-                if (sec_cnt_valid == 0u) {                      /* If blk is empty ...                                  */
-                    empty = DEF_YES;                            /* ... brk from loop.                                   */
-                }
+        if (erased == DEF_YES) {
+            blk_cnt_erased++;
+            p_nor_data->SecCntErased  += p_nor_data->BlkSecCnts;
+        } else {
+            sec_cnt_erased             = FSDev_NOR_AB_SecCntErased(p_nor_data, blk_ix);
+            p_nor_data->SecCntErased  += sec_cnt_erased;
+            p_nor_data->SecCntInvalid += (p_nor_data->BlkSecCnts - sec_cnt_valid) - sec_cnt_erased;
+            if ((sec_cnt_valid  != 0u) ||
+                (sec_cnt_erased != 0u)) {
+                blk_cnt_valid++;
             }
         }
-
         blk_ix++;
     }
 
+   *p_blk_cnt_valid  = blk_cnt_valid;
+   *p_blk_cnt_erased = blk_cnt_erased;
 
-
-                                                                /* ----------------- RTN MIN VALID BLK ---------------- */
-    return (blk_ix_min);
+    FS_TRACE_LOG(("FSDev_NOR_CkptLoad(): Mounted from ckpt %d in slot %d.\r\n", p_nor_data->CkptSeq, p_nor_data->CkptSlotCur));
+    return (DEF_YES);
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*                                     FSDev_NOR_FindEraseBlkWear()
+*                                         FSDev_NOR_CkptWr()
 *
-* Description : Find block that needs to be erased (for active wear leveling).
+* Description : Write checkpoint of the L2P table & block information.
 *
 * Argument(s) : p_nor_data  Pointer to NOR data.
-*               ----------          Argument validated by caller.
+*               ----------  Argument validated by caller.
 *
-* Return(s)   : Block index,                if    block found that needs to be erased.
-*               FS_DEV_NOR_SEC_NBR_INVALID, if NO block            needs to be erased.
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
 *
-* Note(s)     : (1) Blocks with seldom-changed data will NOT be erased as often as other blocks with pure
-*                   passive wear leveling.  Active wear-leveling purposefully copies data from such blocks
-*                   to new (& more often erased) blocks.  The burden of erasures will subsequently fall
-*                   more heavily upon these old blocks, evening the erase counts.
+*                               FS_ERR_NONE           Checkpoint written.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
 *
-*                   (a) The minimum erase count MAY not be accurate, since the minimally-erased block(s)
-*                       may have been erased; since more than one minimally-erased block may exist, the
-*                       minimum erase count is NEVER updated upon erase.
+* Return(s)   : none.
 *
-*               (2) If all minimally-erased blocks are erased, then no block will be found.
+* Caller(s)   : FSDev_NOR_Wr(),
+*               FSDev_NOR_LowUnmountHandler().
+*
+* Note(s)     : (1) The checkpoint is written to the slot NOT holding the current checkpoint, which remains
+*                   valid until the status of the new checkpoint is programmed.  A checkpoint whose write
+*                   is interrupted is ignored upon mount.
+*
+*               (2) The next unwritten sector is recorded for each block :
+*
+*                   (a) 0,                               for an erased block;
+*                   (b) The next sector to allocate,     for an active block;
+*                   (c) The number of sectors per block, for any other block, which will NOT be written
+*                                                        until erased.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  FS_SEC_NBR  FSDev_NOR_FindEraseBlkWear (FS_DEV_NOR_DATA  *p_nor_data)
+#if ((FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED) && \
+     (FS_CFG_RD_ONLY_EN      == DEF_DISABLED))
+static  void  FSDev_NOR_CkptWr (FS_DEV_NOR_DATA  *p_nor_data,
+                                FS_ERR           *p_err)
 {
-    CPU_BOOLEAN  active;
-    CPU_INT08U   blk_hdr[FS_DEV_NOR_BLK_HDR_LEN];
-    FS_SEC_NBR   blk_ix;
-    FS_SEC_NBR   blk_ix_min;
-    CPU_BOOLEAN  erased;
-    CPU_INT32U   erase_cnt;
-    CPU_INT32U   erase_cnt_min;
-    FS_SEC_QTY   sec_cnt_valid_min;
-    FS_SEC_QTY   sec_cnt_valid;
-    FS_ERR       err;
-
+    CPU_INT08U    ckpt_hdr[FS_DEV_NOR_CKPT_HDR_LEN];
+    CPU_INT08U    erase_cnt_octets[4];
+    CPU_INT08U   *p_buf;
+    CPU_INT32U    addr;
+    CPU_INT32U    blk_addr;
+    FS_SEC_NBR    blk_ix;
+    CPU_INT32U    buf_ix;
+    CPU_BOOLEAN   erased;
+    FS_SEC_QTY    ix;
+    FS_SEC_QTY    sec_cnt_valid;
+    FS_SEC_NBR    sec_ix_next;
+    CPU_INT08U    slot;
+    CPU_INT32U    slot_addr;
 
-                                                                /* ---------- ACTIVE WEAR-LEVEL (see Note #1) --------- */
-                                                                /* If erase cnt th exceeded ...                         */
-    if (p_nor_data->EraseCntMax >= p_nor_data->EraseCntMin + p_nor_data->EraseCntDiffTh) {
-                                                                /* ... find blk with min erase cnt & valid secs.        */
-        blk_ix            = 0u;
-        erase_cnt_min     = p_nor_data->EraseCntMax + 1u;
-	    sec_cnt_valid_min = DEF_MIN(p_nor_data->SecCntErased, p_nor_data->BlkSecCnts);
-        blk_ix_min        = FS_DEV_NOR_SEC_NBR_INVALID;
-        while (blk_ix < p_nor_data->BlkCntUsed) {
-            FSDev_NOR_GetBlkInfo( p_nor_data,
-                                  blk_ix,
-                                 &erased,
-                                 &sec_cnt_valid);
 
-            FSDev_NOR_RdBlkHdr( p_nor_data,
-                               &blk_hdr[0],
-                                blk_ix,
-                               &err);
-            if (err != FS_ERR_NONE) {
-                return (FS_DEV_NOR_SEC_NBR_INVALID);            /* #### Add rtn err val.                                */
-            }
+    slot      = (p_nor_data->CkptSlotCur + 1u) % FS_DEV_NOR_CKPT_SLOT_CNT;
+    slot_addr =  FSDev_NOR_CkptSlotAddr(p_nor_data, slot);
 
-            erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT]);
-            if (erase_cnt_min > erase_cnt) {                    /* Update min erase cnt.                                */
-                erase_cnt_min = erase_cnt;
-            }
 
-            if (erased == DEF_NO) {                             /* If blk is NOT erased        ...                      */
-                active = FSDev_NOR_IsAB(p_nor_data, blk_ix);
-                if (active == DEF_NO) {                         /* ... & blk is NOT active blk ...                      */
-                                                                /* ... & erase cnt below th    ...                      */
-                    if (p_nor_data->EraseCntMax >= erase_cnt + p_nor_data->EraseCntDiffTh) {
-                        if (sec_cnt_valid_min > sec_cnt_valid) {/* ... & fewer valid secs      ...                      */
-                            sec_cnt_valid_min = sec_cnt_valid;
-                            blk_ix_min        = blk_ix;         /* ... sel blk.                                         */
-                        }
-                    }
-                }
-            }
 
-            blk_ix++;
+                                                                /* --------------------- ERASE SLOT ------------------- */
+    blk_addr = slot_addr;
+    ix       = 0u;
+    while (ix < p_nor_data->CkptBlkCnt) {
+        FSDev_NOR_PhyEraseBlkHandler(p_nor_data,
+                                     blk_addr,
+                                     p_nor_data->PhyDataPtr->BlkSize,
+                                     p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
         }
+        blk_addr += p_nor_data->PhyDataPtr->BlkSize;
+        ix++;
+    }
 
-        p_nor_data->EraseCntMin = erase_cnt_min;                /* Update cnt min w/actual erase cnt min.               */
 
-        if (blk_ix_min == FS_DEV_NOR_SEC_NBR_INVALID) {         /* Verify blk ix min (see Note #2).                     */
-            return (FS_DEV_NOR_SEC_NBR_INVALID);
+
+                                                                /* -------------------- WR L2P TBL -------------------- */
+    FSDev_NOR_PhyWrHandler(p_nor_data,
+                           p_nor_data->L2P_Tbl,
+                           slot_addr + FS_DEV_NOR_CKPT_HDR_LEN,
+                           p_nor_data->CkptTblSize,
+                           p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+
+
+                                                                /* ------------ WR BLK INFO (see Note #2) ------------- */
+    p_buf  = (CPU_INT08U *)p_nor_data->BufPtr;
+    addr   =  slot_addr + FS_DEV_NOR_CKPT_HDR_LEN + p_nor_data->CkptTblSize;
+    buf_ix =  0u;
+    blk_ix =  0u;
+    while (blk_ix < p_nor_data->BlkCntUsed) {
+        FSDev_NOR_PhyRdHandler( p_nor_data,                     /* Rd erase cnt.                                        */
+                               &erase_cnt_octets[0],
+                                FSDev_NOR_BlkIx_to_Addr(p_nor_data, blk_ix) + FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT,
+                                4u,
+                                p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
         }
 
-#if (FS_TRACE_LEVEL >= TRACE_LEVEL_LOG)
-        if (p_nor_data->EraseCntMin < erase_cnt_min) {
-            FS_TRACE_LOG(("FSDev_NOR_FindEraseBlkWear(): Min erase cnt now %d (prev was %d).\r\n", erase_cnt_min, p_nor_data->EraseCntMin));
+        FSDev_NOR_GetBlkInfo( p_nor_data,
+                              blk_ix,
+                             &erased,
+                             &sec_cnt_valid);
+        if (erased == DEF_YES) {
+            sec_ix_next = 0u;
+        } else {
+            sec_ix_next = p_nor_data->BlkSecCnts - FSDev_NOR_AB_SecCntErased(p_nor_data, blk_ix);
         }
-#endif
 
+        MEM_VAL_SET_INT32U((void *)&p_buf[buf_ix + FS_DEV_NOR_CKPT_BLK_INFO_OFFSET_ERASE_CNT],   MEM_VAL_GET_INT32U((void *)&erase_cnt_octets[0]));
+        MEM_VAL_SET_INT32U((void *)&p_buf[buf_ix + FS_DEV_NOR_CKPT_BLK_INFO_OFFSET_SEC_IX_NEXT], sec_ix_next);
+        buf_ix += FS_DEV_NOR_CKPT_BLK_INFO_LEN;
+        blk_ix++;
 
-                                                                /* If erase cnt th still exceeded (see Note #1a) ...    */
-        if (p_nor_data->EraseCntMax >= p_nor_data->EraseCntMin + p_nor_data->EraseCntDiffTh) {
-            return (blk_ix_min);                                /* ... erase blk.                                       */
+        if ((buf_ix + FS_DEV_NOR_CKPT_BLK_INFO_LEN >  p_nor_data->SecSize) ||
+            (blk_ix                                == p_nor_data->BlkCntUsed)) {
+            FSDev_NOR_PhyWrHandler(p_nor_data,                  /* Wr buf when full.                                    */
+                                   p_buf,
+                                   addr,
+                                   buf_ix,
+                                   p_err);
+            if (*p_err != FS_ERR_NONE) {
+                return;
+            }
+            addr   += buf_ix;
+            buf_ix  = 0u;
         }
     }
 
 
 
-                                                                /* -------------------- RTN NO BLK -------------------- */
-    return (FS_DEV_NOR_SEC_NBR_INVALID);
+                                                                /* ---------------------- WR HDR ---------------------- */
+    Mem_Clr(&ckpt_hdr[0], FS_DEV_NOR_CKPT_HDR_LEN);
+    MEM_VAL_SET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_MARK1],    FS_DEV_NOR_BLK_HDR_MARK_WORD_1);
+    MEM_VAL_SET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_MARK2],    FS_DEV_NOR_CKPT_HDR_MARK_WORD_2);
+    MEM_VAL_SET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_SEQ],      p_nor_data->CkptSeq + 1u);
+    MEM_VAL_SET_INT16U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_VER],      FS_DEV_NOR_BLK_HDR_VER);
+    MEM_VAL_SET_INT16U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_SEC_SIZE], p_nor_data->SecSize);
+    MEM_VAL_SET_INT16U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_BLK_CNT],  p_nor_data->BlkCntUsed);
+    MEM_VAL_SET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_SIZE],     p_nor_data->Size);
+    MEM_VAL_SET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_STATUS],   FS_DEV_NOR_STATUS_SEC_ERASED);
+
+    FSDev_NOR_PhyWrHandler( p_nor_data,
+                           &ckpt_hdr[0],
+                            slot_addr,
+                            FS_DEV_NOR_CKPT_HDR_LEN,
+                            p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+
+
+                                                                /* ------------ VALIDATE CKPT (see Note #1) ----------- */
+    MEM_VAL_SET_INT32U((void *)&ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_STATUS], FS_DEV_NOR_STATUS_SEC_VALID);
+    FSDev_NOR_PhyWrHandler( p_nor_data,
+                           &ckpt_hdr[FS_DEV_NOR_CKPT_HDR_OFFSET_STATUS],
+                            slot_addr + FS_DEV_NOR_CKPT_HDR_OFFSET_STATUS,
+                            4u,
+                            p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    FSDev_NOR_CkptInvalidate(p_nor_data, p_err);                /* Invalidate prev ckpt.                                */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    p_nor_data->CkptSlotCur  = slot;
+    p_nor_data->CkptSeq++;
+    p_nor_data->CkptValid    = DEF_YES;
+    p_nor_data->CkptEraseCtr = 0u;
+
+    FS_TRACE_LOG(("FSDev_NOR_CkptWr(): Ckpt %d wr'n to slot %d.\r\n", p_nor_data->CkptSeq, slot));
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*                                      FSDev_NOR_FindErasedBlk()
+*                                      FSDev_NOR_CkptInvalidate()
 *
-* Description : Find block that is erased.
+* Description : Invalidate current checkpoint.
 *
 * Argument(s) : p_nor_data  Pointer to NOR data.
 *               ----------  Argument validated by caller.
 *
-* Return(s)   : Block index,                if    erased block found.
-*               FS_DEV_NOR_SEC_NBR_INVALID, if NO erased block found.
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
 *
-* Note(s)     : (1) The erased block with the lowest erase count is selected.
+*                               FS_ERR_NONE           Checkpoint invalidated, or NO valid checkpoint.
+*                               FS_ERR_DEV_IO         Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT    Device timeout.
 *
-*                   (a) #### Optimize for cases with one erased blk OR no large erase count differences.
+* Return(s)   : none.
 *
-*               (2) There may be no block with erase count as low as 'EraseCntMin' (see
-*                   'FSDev_NOR_FindEraseBlkWear()  Note #1a').
+* Note(s)     : (1) The checkpoint status is programmed to 'invalid' so that the checkpoint is NOT used by
+*                   a later mount, even if power is lost before another checkpoint is written.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  FS_SEC_NBR  FSDev_NOR_FindErasedBlk (FS_DEV_NOR_DATA  *p_nor_data)
+#if ((FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED) && \
+     (FS_CFG_RD_ONLY_EN      == DEF_DISABLED))
+static  void  FSDev_NOR_CkptInvalidate (FS_DEV_NOR_DATA  *p_nor_data,
+                                        FS_ERR           *p_err)
 {
-    CPU_INT08U   blk_hdr[FS_DEV_NOR_BLK_HDR_LEN];
-    FS_SEC_QTY   blk_cnt_erased;
-    FS_SEC_NBR   blk_ix;
-    FS_SEC_NBR   blk_ix_erased;
-    CPU_BOOLEAN  erased;
-    CPU_INT32U   erase_cnt;
-    CPU_INT32U   erase_cnt_min;
-    CPU_BOOLEAN  found;
-    FS_SEC_QTY   sec_cnt_valid;
-    FS_ERR       err;
+    CPU_INT08U  status_octets[4];
 
 
-    blk_cnt_erased = 0u;
-    blk_ix         = 0u;
-    blk_ix_erased  = FS_DEV_NOR_SEC_NBR_INVALID;
-    erase_cnt_min  = p_nor_data->EraseCntMax + 1u;
-    found          = DEF_NO;
-    while ((found  == DEF_NO) &&
-           (blk_ix <  p_nor_data->BlkCntUsed)) {
-        FSDev_NOR_GetBlkInfo( p_nor_data,
-                              blk_ix,
-                             &erased,
-                             &sec_cnt_valid);
-        if (erased == DEF_YES) {
-            blk_cnt_erased++;
+    if (p_nor_data->CkptValid == DEF_NO) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
 
-            FSDev_NOR_RdBlkHdr( p_nor_data,
-                               &blk_hdr[0],
-                                blk_ix,
-                               &err);
-            if (err != FS_ERR_NONE) {                               /* If hdr could NOT be rd ...                       */
-                return (FS_DEV_NOR_SEC_NBR_INVALID);                /* ... rtn invalid blk ix.                          */
-            }
+    MEM_VAL_SET_INT32U((void *)&status_octets[0], FS_DEV_NOR_STATUS_SEC_INVALID);
+    FSDev_NOR_PhyWrHandler( p_nor_data,                         /* See Note #1.                                         */
+                           &status_octets[0],
+                            FSDev_NOR_CkptSlotAddr(p_nor_data, p_nor_data->CkptSlotCur) + FS_DEV_NOR_CKPT_HDR_OFFSET_STATUS,
+                            4u,
+                            p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
 
-            erase_cnt = MEM_VAL_GET_INT32U((void *)&blk_hdr[FS_DEV_NOR_BLK_HDR_OFFSET_ERASE_CNT]);
-            if (erase_cnt_min > erase_cnt) {                        /* If lower erase cnt (see Note #1) ...             */
-                erase_cnt_min = erase_cnt;
-                blk_ix_erased = blk_ix;                             /* ... sel this blk.                                */
+    p_nor_data->CkptValid = DEF_NO;
+}
+#endif
 
 
-                if (erase_cnt_min == p_nor_data->EraseCntMin) {     /* If least erased blk (see Note #2) ...            */
-                    found = DEF_YES;                                /* ... stop srch.                                   */
-                }
-                if (blk_cnt_erased >= p_nor_data->BlkCntErased) {   /* If no more erased blks exist ...                 */
-                    found = DEF_YES;                                /* ... stop srch.                                   */
-                }
-            }
-        }
+/*
+*********************************************************************************************************
+*                                      FSDev_NOR_CkptSlotAddr()
+*
+* Description : Get address of checkpoint slot.
+*
+* Argument(s) : p_nor_data  Pointer to NOR data.
+*               ----------  Argument validated by caller.
+*
+*               slot        Checkpoint slot.
+*
+* Return(s)   : Address of first block of slot, in octets.
+*
+* Note(s)     : (1) The checkpoint slots follow the blocks used by the file system (see
+*                   'FSDev_NOR_CalcDevInfo()  Note #3').
+*********************************************************************************************************
+*/
 
-        blk_ix++;
-    }
+#if ((FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED) && \
+     (FS_CFG_RD_ONLY_EN      == DEF_DISABLED))
+static  CPU_INT32U  FSDev_NOR_CkptSlotAddr (FS_DEV_NOR_DATA  *p_nor_data,
+                                            CPU_INT08U        slot)
+{
+    CPU_INT32U  slot_addr;
 
-    p_nor_data->BlkWearLevelAvail = DEF_NO;
 
-    return (blk_ix_erased);
+    slot_addr = FSDev_NOR_BlkIx_to_Addr(p_nor_data,
+                                        p_nor_data->BlkCntUsed + ((FS_SEC_NBR)slot * p_nor_data->CkptBlkCnt));
+    return (slot_addr);
 }
 #endif
 
@@ -5304,6 +7142,10 @@ static  FS_DEV_NOR_DATA  *FSDev_NOR_DataGet (void)
     p_nor_data->SecSizeLog        =  0u;
     p_nor_data->BlkSecCnts        =  0u;
     p_nor_data->AB_Cnt            =  0u;
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)
+    p_nor_data->CkptBlkCnt        =  0u;
+    p_nor_data->CkptTblSize       =  0u;
+#endif
 
                                                                 /* Clr dev open data ptrs.                              */
     p_nor_data->BufPtr            = (void *)0;
@@ -5325,12 +7167,26 @@ static  FS_DEV_NOR_DATA  *FSDev_NOR_DataGet (void)
     p_nor_data->EraseCntMax       =  0u;
     p_nor_data->Mounted           =  DEF_NO;
 
+#if (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)                     /* Clr ckpt info.                                       */
+    p_nor_data->CkptSlotCur       =  FS_DEV_NOR_CKPT_SLOT_CNT - 1u;
+    p_nor_data->CkptSeq           =  0u;
+    p_nor_data->CkptValid         =  DEF_NO;
+    p_nor_data->CkptEraseCtr      =  0u;
+#endif
+
+#if (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED)        /* Clr static wear level info.                          */
+    p_nor_data->WearLevelEraseCtr =  0u;
+    p_nor_data->WearLevelPeriod   =  FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD;
+#endif
+
                                                                 /* Clr cfg info.                                        */
     p_nor_data->AddrStart         =  0u;
     p_nor_data->DevSize           =  0u;
     p_nor_data->SecSize           =  0u;
     p_nor_data->PctRsvd           =  0u;
     p_nor_data->EraseCntDiffTh    =  0u;
+    p_nor_data->Endurance         =  0u;
+    p_nor_data->AddrMap           =  0u;
 
                                                                 /* Clr/set phy info.                                    */
     p_nor_data->PhyPtr            = (FS_DEV_NOR_PHY_API *)0;
@@ -5345,6 +7201,8 @@ static  FS_DEV_NOR_DATA  *FSDev_NOR_DataGet (void)
     p_nor_data->StatWrOctetCtr    =  0u;
     p_nor_data->StatEraseBlkCtr   =  0u;
     p_nor_data->StatInvalidBlkCtr =  0u;
+    p_nor_data->StatWearLevelStaticCtr = 0u;
+    p_nor_data->StatWearLevelActiveCtr = 0u;
 #endif
 
 #if (FS_CFG_CTR_ERR_EN            == DEF_ENABLED)               /* Clr err ctrs.                                        */
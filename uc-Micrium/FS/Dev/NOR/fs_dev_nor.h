@@ -96,6 +96,28 @@
 #define  FS_DEV_NOR_CFG_DBG_CHK_EN                  DEF_DISABLED
 #endif
 
+                                                                /* Persist L2P tbl & blk info in rsvd ckpt blks.        */
+#ifndef  FS_DEV_NOR_CFG_CKPT_EN
+#define  FS_DEV_NOR_CFG_CKPT_EN                     DEF_DISABLED
+#endif
+
+#ifndef  FS_DEV_NOR_CFG_CKPT_PERIOD                             /* Nbr of blk erases between ckpts.                     */
+#define  FS_DEV_NOR_CFG_CKPT_PERIOD                         32u
+#endif
+
+                                                                /* Migrate cold blks when erase cnt spread grows.       */
+#ifndef  FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN
+#define  FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN        DEF_DISABLED
+#endif
+
+#ifndef  FS_DEV_NOR_CFG_WEAR_LEVEL_TH_PCT                       /* Static th, in % of erase cnt diff th.                */
+#define  FS_DEV_NOR_CFG_WEAR_LEVEL_TH_PCT                   50u
+#endif
+
+#ifndef  FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD                       /* Nbr of blk erases between cold blk migrations.       */
+#define  FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD                   16u
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -113,6 +135,18 @@
 
 #define  FS_DEV_NOR_PCT_RSVD_SEC_ACTIVE_MAX               90u
 
+#define  FS_DEV_NOR_ENDURANCE_DFLT                    100000u   /* Rated erase cycles per blk, if unspecified.          */
+#define  FS_DEV_NOR_WEAR_HIST_BIN_NBR                      8u   /* Nbr of erase cnt histogram bins.                     */
+
+                                                                /* -------------- PHY CAPABILITY FLAGS ---------------- */
+#define  FS_DEV_NOR_PHY_CAP_NONE                DEF_BIT_NONE
+#define  FS_DEV_NOR_PHY_CAP_RD_MULTI            DEF_BIT_00      /* Multi-chunk burst rd via 'RdMulti()'.                */
+#define  FS_DEV_NOR_PHY_CAP_RD_DUAL             DEF_BIT_01      /* Dual-output fast rd (3Bh).                           */
+#define  FS_DEV_NOR_PHY_CAP_RD_QUAD             DEF_BIT_02      /* Quad-output fast rd (6Bh).                           */
+#define  FS_DEV_NOR_PHY_CAP_WR_BURST            DEF_BIT_03      /* Page pgm data phase issued as one burst.             */
+#define  FS_DEV_NOR_PHY_CAP_WR_DUAL             DEF_BIT_04      /* Dual-input page pgm (A2h).                           */
+#define  FS_DEV_NOR_PHY_CAP_WR_QUAD             DEF_BIT_05      /* Quad-input page pgm (32h).                           */
+
 
 /*
 *********************************************************************************************************
@@ -120,6 +154,61 @@
 *********************************************************************************************************
 */
 
+/*
+*********************************************************************************************************
+*                               NOR FLASH DEVICE QSPI BSP API DATA TYPES
+*
+* Note(s) : (1) A serial physical-layer driver MAY issue commands through an optional QSPI BSP, in addition
+*               to 'FSDev_NOR_BSP_SPI'.  Each call performs one complete transaction (chip select,
+*               instruction, address, dummy cycles & data), so that the BSP can hand the data phase of a
+*               whole sector or page to a QSPI controller or a DMA channel as a single burst.
+*
+*           (2) 'FS_DEV_NOR_QSPI_CMD' describes the phases of a transaction :
+*               (a) 'Instr' is sent on a single line.
+*               (b) The 'AddrLen' least significant octets of 'Addr' are sent MSB first, on 'AddrLines'
+*                   lines.  'AddrLen' is 0 for an instruction without address.
+*               (c) 'DummyCycles' clock cycles are inserted before the data phase.
+*               (d) The data phase is transferred on 'DataLines' lines (1, 2 or 4).
+*
+*           (3) (a) 'LinesMax()' returns the number of data lines wired between the MCU & the flash (1, 2
+*                   or 4).
+*
+*               (b) 'Rd()' reads 'nbr' chunks of 'cnt' octets into consecutive locations of 'p_dest'.
+*                   Each chunk starts 'stride' octets after the previous one on the flash; the octets
+*                   between two chunks are clocked in but discarded (e.g., by a scatter-gather DMA
+*                   descriptor).  A plain read has 'nbr' equal to 1 & 'stride' equal to 'cnt'.
+*
+*               (c) 'Wr()' writes 'cnt' octets from 'p_src' in the data phase.
+*
+*               (d) 'Rd()' & 'Wr()' return DEF_OK if the transfer completed, DEF_FAIL otherwise.
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_dev_nor_qspi_cmd {
+    CPU_INT08U           Instr;                                 /* Instruction.                                         */
+    CPU_INT08U           AddrLen;                               /* Nbr of addr octets.                                  */
+    CPU_INT08U           AddrLines;                             /* Nbr of lines for addr phase.                         */
+    CPU_INT08U           DummyCycles;                           /* Nbr of dummy clk cycles.                             */
+    CPU_INT08U           DataLines;                             /* Nbr of lines for data phase.                         */
+    CPU_INT32U           Addr;                                  /* Addr.                                                */
+} FS_DEV_NOR_QSPI_CMD;
+
+typedef  struct  fs_dev_nor_qspi_api {
+    CPU_INT08U   (*LinesMax)(FS_QTY                      unit_nbr);
+
+    CPU_BOOLEAN  (*Rd)      (FS_QTY                      unit_nbr,
+                             const  FS_DEV_NOR_QSPI_CMD *p_cmd,
+                             void                       *p_dest,
+                             CPU_SIZE_T                  cnt,
+                             CPU_SIZE_T                  stride,
+                             CPU_SIZE_T                  nbr);
+
+    CPU_BOOLEAN  (*Wr)      (FS_QTY                      unit_nbr,
+                             const  FS_DEV_NOR_QSPI_CMD *p_cmd,
+                             void                       *p_src,
+                             CPU_SIZE_T                  cnt);
+} FS_DEV_NOR_QSPI_API;
+
 /*
 *********************************************************************************************************
 *                              NOR FLASH DEVICE PHYSICAL DATA DATA TYPE
@@ -144,6 +233,13 @@
 *               (d) Physical-layer driver populates 'BlkCnt', 'BlkSize' & 'AddrRegionStart', which describe
 *                   the block region 'RegionNbr' to be accessed.  It MAY assign a pointer to physical-
 *                   layer driver-specific information to 'DataPtr'.
+*
+*               (e) Application/NOR driver populates 'QSPI_BSP_Ptr'.  See 'NOR FLASH DEVICE CONFIGURATION
+*                   DATA TYPE  Note #1j'.
+*
+*               (f) NOR driver clears 'Caps' before opening the device; the physical-layer driver MAY then
+*                   set FS_DEV_NOR_PHY_CAP_xxx flags for the operations it supports on this device & bus.
+*                   The NOR driver only calls 'RdMulti()' if FS_DEV_NOR_PHY_CAP_RD_MULTI is set.
 *********************************************************************************************************
 */
 
@@ -164,11 +260,19 @@ typedef  struct  fs_dev_nor_phy_data {
     void                *DataPtr;                               /* Pointer to phy-specific data.                        */
 
     CPU_INT32U           WrMultSize;                            /* Flash write multiple size.                           */
+
+    const  FS_DEV_NOR_QSPI_API  *QSPI_BSP_Ptr;                  /* Pointer to QSPI BSP (see Note #2e).                  */
+    CPU_INT08U           Caps;                                  /* Phy capabilities (see Note #2f).                     */
 } FS_DEV_NOR_PHY_DATA;
 
 /*
 *********************************************************************************************************
 *                           NOR FLASH DEVICE PHYSICAL DRIVER API DATA TYPE
+*
+* Note(s) : (1) 'RdMulti()' is optional & may be DEF_NULL.  It reads 'nbr' chunks of 'cnt' octets, the
+*               first at 'start' & each subsequent one 'stride' octets after the previous, into consecutive
+*               locations of 'p_dest', as a single device command.  The NOR driver uses it to read runs
+*               of physically contiguous sectors, skipping the sector headers between them.
 *********************************************************************************************************
 */
 
@@ -198,6 +302,15 @@ typedef  struct  fs_dev_nor_phy_api {
     void  (*IO_Ctrl)  (FS_DEV_NOR_PHY_DATA  *p_phy_data,
                        CPU_INT08U            cmd,
                        void                 *p_buf,
+                       FS_ERR               *p_err);
+
+                                                                /* ----------- OPTIONAL MULTI-CHUNK RD ------------ */
+    void  (*RdMulti)  (FS_DEV_NOR_PHY_DATA  *p_phy_data,        /* See Note #1.                                         */
+                       void                 *p_dest,
+                       CPU_INT32U            start,
+                       CPU_INT32U            cnt,
+                       CPU_INT32U            stride,
+                       CPU_INT32U            nbr,
                        FS_ERR               *p_err);
 } FS_DEV_NOR_PHY_API;
 
@@ -272,6 +385,25 @@ typedef  struct  fs_dev_nor_phy_api {
 *
 *                   (2) For a serial flash, the serial configuration is specified via 'MaxClkFreq'.
 *                       'MaxClkFreq' is the maximum clock frequency of the serial flash.
+*
+*               (j) 'QSPI_BSP_Ptr' MAY point to a QSPI BSP (see 'NOR FLASH DEVICE QSPI BSP API DATA TYPES'),
+*                   for a serial flash.  Physical-layer drivers that support it then read whole sectors
+*                   with dual- or quad-output fast read commands, if wired, & program whole pages, in
+*                   single bursts.  It MUST be DEF_NULL otherwise; 'FSDev_NOR_BSP_SPI' is then used alone.
+*
+*               (k) 'Endurance' MAY specify the rated number of erase cycles per block, as given in the
+*                   flash datasheet.  It is used only to project the remaining lifetime of the device (see
+*                   'FSDev_NOR_WearInfoGet()').  If 0, FS_DEV_NOR_ENDURANCE_DFLT is assumed.
+*
+*               (l) 'AddrMap' MAY specify the address at which the CPU reads the flash in place (the address
+*                   that flash offset 0 relative to 'AddrBase' is mapped to) :
+*                   (1) ... usually 'AddrBase', for a parallel flash on the memory bus.
+*                   (2) ... the base of the memory-mapped (XIP) window of the QSPI controller, for a serial
+*                           flash.
+*
+*                   Files may then be read in place (see 'FSFile_Map()').  It MUST be 0 if the flash cannot
+*                   be read in place, or if the CPU may then read it through a data cache that is not
+*                   invalidated when the flash is programmed or erased.
 *********************************************************************************************************
 */
 
@@ -291,6 +423,10 @@ typedef  struct  fs_dev_nor_cfg {
     CPU_INT08U           BusWidthMax;                           /* Maximum bus width of flash.                          */
     CPU_INT08U           PhyDevCnt;                             /* Number of flash devices interleaved.                 */
     CPU_INT32U           MaxClkFreq;                            /* Maximum clock frequency of serial flash.             */
+
+    const  FS_DEV_NOR_QSPI_API  *QSPI_BSP_Ptr;                  /* Pointer to QSPI BSP (see Note #1j).                  */
+    CPU_INT32U           Endurance;                             /* Rated erase cycles per blk (see Note #1k).           */
+    CPU_ADDR             AddrMap;                               /* Addr of flash in CPU addr space (see Note #1l).      */
 } FS_DEV_NOR_CFG;
 
 
@@ -307,6 +443,41 @@ typedef  struct  fs_dev_nor_io_ctrl_data {
 } FS_DEV_NOR_IO_CTRL_DATA;
 
 
+/*
+*********************************************************************************************************
+*                                    NOR WEAR INFORMATION DATA TYPE
+*
+* Note(s) : (1) Erase counts are read from the headers of all blocks; blocks with an invalid erase count
+*               (e.g., interrupted erase) are excluded.
+*
+*           (2) 'Hist[i]' holds the number of blocks with an erase count in
+*
+*                   [EraseCntMin + (i * HistBinWidth), EraseCntMin + ((i + 1) * HistBinWidth) - 1]
+*
+*           (3) 'EraseCntRem' is the number of erase cycles left to the most-worn block before it reaches
+*               'Endurance'.  Provided the spread is bounded by wear leveling, the device can absorb about
+*               'EraseCntRem * BlkCnt' more block erases; divided by an observed erase rate, this gives the
+*               remaining lifetime.  'LifeRemPct' is 'EraseCntRem' as a percentage of 'Endurance'.
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_dev_nor_wear_info {
+    CPU_INT32U            BlkCnt;                               /* Nbr of blks with valid erase cnt (see Note #1).      */
+    CPU_INT32U            EraseCntMin;                          /* Min erase cnt.                                       */
+    CPU_INT32U            EraseCntMax;                          /* Max erase cnt.                                       */
+    CPU_INT32U            EraseCntAvg;                          /* Avg erase cnt.                                       */
+    CPU_INT32U            EraseCntSpread;                       /* Max - min erase cnt.                                 */
+    CPU_INT32U            EraseCntTh;                           /* Erase cnt diff th (active wear leveling).            */
+    CPU_INT32U            HistBinWidth;                         /* Width of histogram bins, in erase cycles.            */
+    CPU_INT32U            Hist[FS_DEV_NOR_WEAR_HIST_BIN_NBR];   /* Erase cnt histogram (see Note #2).                   */
+    CPU_INT32U            Endurance;                            /* Rated erase cycles per blk.                          */
+    CPU_INT32U            EraseCntRem;                          /* Erase cycles left to most-worn blk (see Note #3).    */
+    CPU_INT08U            LifeRemPct;                           /* Remaining life, in % (see Note #3).                  */
+    CPU_INT32U            WearLevelStaticCnt;                   /* Nbr of cold blks migrated (static wear leveling).    */
+    CPU_INT32U            WearLevelActiveCnt;                   /* Nbr of blks erased by active wear leveling.          */
+} FS_DEV_NOR_WEAR_INFO;
+
+
 /*
 *********************************************************************************************************
 *                                          GLOBAL VARIABLES
@@ -370,6 +541,17 @@ void         FSDev_NOR_LowCompact           (CPU_CHAR              *name_dev,
 void         FSDev_NOR_LowDefrag            (CPU_CHAR              *name_dev,   /* Low-level defrag  device.            */
                                              FS_ERR                *p_err);
 
+                                                                                /* ----------- WEAR FNCTS ------------- */
+void         FSDev_NOR_WearInfoGet          (CPU_CHAR              *name_dev,   /* Get wear info.                       */
+                                             FS_DEV_NOR_WEAR_INFO  *p_info,
+                                             FS_ERR                *p_err);
+
+#if ((FS_CFG_RD_ONLY_EN                   == DEF_DISABLED) && \
+     (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED))
+CPU_BOOLEAN  FSDev_NOR_WearLevel            (CPU_CHAR              *name_dev,   /* Migrate one cold blk.                */
+                                             FS_ERR                *p_err);
+#endif
+
                                                                                 /* ---------- PHYSICAL FNCTS ---------- */
 void         FSDev_NOR_PhyRd                (CPU_CHAR              *name_dev,   /* Read data from physical device.      */
                                              void                  *p_dest,
@@ -477,6 +659,51 @@ extern  const  FS_DEV_SPI_API  FSDev_NOR_BSP_SPI;
 #endif
 
 
+#ifndef  FS_DEV_NOR_CFG_CKPT_EN
+#error  "FS_DEV_NOR_CFG_CKPT_EN            not #define'd in 'app_cfg.h'"
+#error  "                            [MUST be  DEF_DISABLED]           "
+#error  "                            [     ||  DEF_ENABLED ]           "
+
+#elif  ((FS_DEV_NOR_CFG_CKPT_EN != DEF_DISABLED) && \
+        (FS_DEV_NOR_CFG_CKPT_EN != DEF_ENABLED ))
+#error  "FS_DEV_NOR_CFG_CKPT_EN      illegally #define'd in 'app_cfg.h'"
+#error  "                            [MUST be  DEF_DISABLED]           "
+#error  "                            [     ||  DEF_ENABLED ]           "
+
+#elif   (FS_DEV_NOR_CFG_CKPT_EN == DEF_ENABLED)
+#if     (FS_DEV_NOR_CFG_CKPT_PERIOD < 1u)
+#error  "FS_DEV_NOR_CFG_CKPT_PERIOD  illegally #define'd in 'app_cfg.h'"
+#error  "                            [MUST be  >= 1]                   "
+#endif
+#endif
+
+
+#ifndef  FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN
+#error  "FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN not #define'd in 'app_cfg.h'"
+#error  "                            [MUST be  DEF_DISABLED]           "
+#error  "                            [     ||  DEF_ENABLED ]           "
+
+#elif  ((FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN != DEF_DISABLED) && \
+        (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN != DEF_ENABLED ))
+#error  "FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN illegally #define'd in 'app_cfg.h'"
+#error  "                            [MUST be  DEF_DISABLED]           "
+#error  "                            [     ||  DEF_ENABLED ]           "
+
+#elif   (FS_DEV_NOR_CFG_WEAR_LEVEL_STATIC_EN == DEF_ENABLED)
+#if    ((FS_DEV_NOR_CFG_WEAR_LEVEL_TH_PCT < 1u) || \
+        (FS_DEV_NOR_CFG_WEAR_LEVEL_TH_PCT > 100u))
+#error  "FS_DEV_NOR_CFG_WEAR_LEVEL_TH_PCT illegally #define'd in 'app_cfg.h'"
+#error  "                            [MUST be  >= 1]                   "
+#error  "                            [     &&  <= 100]                 "
+#endif
+
+#if     (FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD < 1u)
+#error  "FS_DEV_NOR_CFG_WEAR_LEVEL_PERIOD illegally #define'd in 'app_cfg.h'"
+#error  "                            [MUST be  >= 1]                   "
+#endif
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
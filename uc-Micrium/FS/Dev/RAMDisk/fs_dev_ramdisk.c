@@ -156,6 +156,20 @@ static  void              FSDev_RAM_IO_Ctrl (FS_DEV           *p_dev,       /* P
                                              void             *p_data,
                                              FS_ERR           *p_err);
 
+static  void              FSDev_RAM_RdV     (FS_DEV           *p_dev,       /* Read from device into buf list.          */
+                                             FS_DEV_IO_VEC    *p_vec_tbl,
+                                             FS_SEC_QTY        vec_cnt,
+                                             FS_SEC_NBR        start,
+                                             FS_ERR           *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void              FSDev_RAM_WrV     (FS_DEV           *p_dev,       /* Write to device from buf list.           */
+                                             FS_DEV_IO_VEC    *p_vec_tbl,
+                                             FS_SEC_QTY        vec_cnt,
+                                             FS_SEC_NBR        start,
+                                             FS_ERR           *p_err);
+#endif
+
                                                                             /* -------------- LOCAL FNCTS ------------- */
 static  void              FSDev_RAM_DataFree(FS_DEV_RAM_DATA  *p_ram_data); /* Free RAM data.                           */
 
@@ -177,7 +191,11 @@ const  FS_DEV_API  FSDev_RAM = {
     FSDev_RAM_Wr,
 #endif
     FSDev_RAM_Query,
-    FSDev_RAM_IO_Ctrl
+    FSDev_RAM_IO_Ctrl,
+    FSDev_RAM_RdV,
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    FSDev_RAM_WrV
+#endif
 };
 
 
@@ -609,8 +627,11 @@ static  void  FSDev_RAM_Query (FS_DEV       *p_dev,
 *                   (k) FS_DEV_IO_CTRL_PHY_WR_PAGE       Write physical device page.   [*]
 *                   (l) FS_DEV_IO_CTRL_PHY_ERASE_BLK     Erase physical device block.  [*]
 *                   (m) FS_DEV_IO_CTRL_PHY_ERASE_CHIP    Erase physical device.        [*]
+*                   (n) FS_DEV_IO_CTRL_SEC_MAP           Get address of sectors.
 *
 *                           [*] NOT SUPPORTED
+*
+*               (3) All sectors are stored contiguously in the disk memory, so any run of sectors is mapped.
 *********************************************************************************************************
 */
 
@@ -619,16 +640,133 @@ static  void  FSDev_RAM_IO_Ctrl (FS_DEV      *p_dev,
                                  void        *p_data,
                                  FS_ERR      *p_err)
 {
-   (void)p_dev;                                                 /*lint --e{550} Suppress "Symbol not accessed".         */
-   (void)opt;
-   (void)p_data;
+    FS_DEV_RAM_DATA  *p_ram_data;
+    FS_DEV_SEC_MAP   *p_sec_map;
 
 
                                                                 /* ------------------ PERFORM I/O CTL ----------------- */
-   *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+    switch (opt) {
+        case FS_DEV_IO_CTRL_SEC_MAP:                            /* --------------------- MAP SECs --------------------- */
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)
+             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
+                *p_err = FS_ERR_NULL_PTR;
+                 return;
+             }
+#endif
+             p_ram_data         = (FS_DEV_RAM_DATA *)p_dev->DataPtr;
+             p_sec_map          = (FS_DEV_SEC_MAP  *)p_data;
+             p_sec_map->AddrPtr = (void *)((CPU_INT08U *)p_ram_data->DiskPtr + (p_sec_map->Start * p_ram_data->SecSize));
+            *p_err              =  FS_ERR_NONE;                 /* See Note #3.                                         */
+             break;
+
+
+        default:
+            *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+             break;
+    }
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSDev_RAM_RdV()
+*
+* Description : Read consecutive sectors from a device into a list of buffers.
+*
+* Argument(s) : p_dev       Pointer to device to read from.
+*               ----------  Argument validated by caller.
+*
+*               p_vec_tbl   Pointer to table of buffers.
+*               ----------  Argument validated by caller.
+*
+*               vec_cnt     Number of buffers in table.
+*
+*               start       Start sector of read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Sector(s) read.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSDev_RAM_RdV (FS_DEV         *p_dev,
+                             FS_DEV_IO_VEC  *p_vec_tbl,
+                             FS_SEC_QTY      vec_cnt,
+                             FS_SEC_NBR      start,
+                             FS_ERR         *p_err)
+{
+    FS_SEC_QTY  vec_ix;
+
+
+    for (vec_ix = 0u; vec_ix < vec_cnt; vec_ix++) {
+        FSDev_RAM_Rd(p_dev,
+                     p_vec_tbl[vec_ix].BufPtr,
+                     start,
+                     p_vec_tbl[vec_ix].Cnt,
+                     p_err);
+        start += p_vec_tbl[vec_ix].Cnt;
+    }
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FSDev_RAM_WrV()
+*
+* Description : Write consecutive sectors to a device from a list of buffers.
+*
+* Argument(s) : p_dev       Pointer to device to write to.
+*               ----------  Argument validated by caller.
+*
+*               p_vec_tbl   Pointer to table of buffers.
+*               ----------  Argument validated by caller.
+*
+*               vec_cnt     Number of buffers in table.
+*
+*               start       Start sector of write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Sector(s) written.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSDev_RAM_WrV (FS_DEV         *p_dev,
+                             FS_DEV_IO_VEC  *p_vec_tbl,
+                             FS_SEC_QTY      vec_cnt,
+                             FS_SEC_NBR      start,
+                             FS_ERR         *p_err)
+{
+    FS_SEC_QTY  vec_ix;
+
+
+    for (vec_ix = 0u; vec_ix < vec_cnt; vec_ix++) {
+        FSDev_RAM_Wr(p_dev,
+                     p_vec_tbl[vec_ix].BufPtr,
+                     start,
+                     p_vec_tbl[vec_ix].Cnt,
+                     p_err);
+        start += p_vec_tbl[vec_ix].Cnt;
+    }
+
+   *p_err = FS_ERR_NONE;
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -175,6 +175,10 @@ const  FS_DEV_SPI_API  FSDev_SD_SPI_BSP_SPI = {
 *********************************************************************************************************
 */
 
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)                   /* SPI is bit-banged : no DMA.                          */
+#error  "FS_DEV_SD_SPI_CFG_DMA_EN          illegally #define'd in 'fs_cfg.h'"
+#error  "                                  [MUST be  DEF_DISABLED]          "
+#endif
 
 /*
 *********************************************************************************************************
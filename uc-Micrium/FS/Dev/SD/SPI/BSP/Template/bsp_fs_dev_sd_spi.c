@@ -144,6 +144,22 @@ static  void         FSDev_BSP_SPI_ChipSelDis        (FS_QTY         unit_nbr);
 static  void         FSDev_BSP_SPI_SetClkFreq        (FS_QTY         unit_nbr,
                                                       CPU_INT32U     freq);
 
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)
+                                                                /* ------------------ DMA API FNCTS ------------------- */
+                                                                /* Start DMA rd from SPI.                               */
+static  void         FSDev_BSP_DMA_RdStart           (FS_QTY         unit_nbr,
+                                                      void          *p_dest,
+                                                      CPU_SIZE_T     cnt);
+
+                                                                /* Start DMA wr to SPI.                                 */
+static  void         FSDev_BSP_DMA_WrStart           (FS_QTY         unit_nbr,
+                                                      void          *p_src,
+                                                      CPU_SIZE_T     cnt);
+
+                                                                /* Wait for end of DMA xfer.                            */
+static  CPU_BOOLEAN  FSDev_BSP_DMA_Wait              (FS_QTY         unit_nbr);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -163,6 +179,14 @@ const  FS_DEV_SPI_API  FSDev_SD_SPI_BSP_SPI = {
     FSDev_BSP_SPI_SetClkFreq,
 };
 
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)
+const  FS_DEV_SD_SPI_DMA_API  FSDev_SD_SPI_BSP_DMA = {
+    FSDev_BSP_DMA_RdStart,
+    FSDev_BSP_DMA_WrStart,
+    FSDev_BSP_DMA_Wait,
+};
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -427,3 +451,99 @@ static  void  FSDev_BSP_SPI_SetClkFreq (FS_QTY      unit_nbr,
     (void)unit_nbr;
     (void)freq;
 }
+
+
+/*
+*********************************************************************************************************
+*                                       FSDev_BSP_DMA_RdStart()
+*
+* Description : Start DMA read from SPI.
+*
+* Argument(s) : unit_nbr  Unit number of SD/MMC card.
+*
+*               p_dest    Pointer to destination memory buffer.
+*
+*               cnt       Number of octets to read.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) This function should configure a receive DMA stream into 'p_dest' & a transmit DMA
+*                   stream of 'cnt' 0xFF octets (e.g., from a one-octet source without increment), start
+*                   both & return without waiting.  The chip select is already enabled.
+*
+*               (2) 'p_dest' is a file system sector buffer.  If the CPU has a data cache, the buffer
+*                   should be invalidated once the transfer is complete (see 'FSDev_BSP_DMA_Wait()').
+*********************************************************************************************************
+*/
+
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)
+static  void  FSDev_BSP_DMA_RdStart (FS_QTY       unit_nbr,
+                                     void        *p_dest,
+                                     CPU_SIZE_T   cnt)
+{
+    (void)unit_nbr;
+    (void)p_dest;
+    (void)cnt;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FSDev_BSP_DMA_WrStart()
+*
+* Description : Start DMA write to SPI.
+*
+* Argument(s) : unit_nbr  Unit number of SD/MMC card.
+*
+*               p_src     Pointer to source memory buffer.
+*
+*               cnt       Number of octets to write.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) This function should configure a transmit DMA stream from 'p_src', start it & return
+*                   without waiting.  Octets received meanwhile should be discarded; the receive overrun
+*                   flag should be cleared before the next SPI access.
+*
+*               (2) If the CPU has a data cache, 'p_src' should be cleaned before the transfer is started.
+*********************************************************************************************************
+*/
+
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)
+static  void  FSDev_BSP_DMA_WrStart (FS_QTY       unit_nbr,
+                                     void        *p_src,
+                                     CPU_SIZE_T   cnt)
+{
+    (void)unit_nbr;
+    (void)p_src;
+    (void)cnt;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FSDev_BSP_DMA_Wait()
+*
+* Description : Wait for end of DMA transfer.
+*
+* Argument(s) : unit_nbr  Unit number of SD/MMC card.
+*
+* Return(s)   : DEF_OK,   if the transfer completed.
+*               DEF_FAIL, if it failed or timed out.
+*
+* Note(s)     : (1) With an OS, this function should pend on a semaphore posted by the DMA transfer
+*                   complete interrupt, so that other tasks run during the transfer.  For a write, it
+*                   should also wait until the SPI is no longer busy transmitting the last octet.
+*********************************************************************************************************
+*/
+
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  FSDev_BSP_DMA_Wait (FS_QTY  unit_nbr)
+{
+    (void)unit_nbr;
+
+    return (DEF_OK);
+}
+#endif
@@ -98,6 +98,8 @@
 
 #define  FS_DEV_SD_SPI_RESP_EMPTY                       0xFFu
 
+#define  FS_DEV_SD_SPI_PRE_ERASE_CNT_MAX          0x007FFFFFu   /* Max nbr of blks pre-erased by ACMD23.                */
+
                                                                 /* ---------- DATA RESPONSE TOKENS (7.3.3.1) ---------- */
 #define  FS_DEV_SD_SPI_TOKEN_RESP_ACCEPTED              0x05u
 #define  FS_DEV_SD_SPI_TOKEN_RESP_CRC_REJECTED          0x0Bu
@@ -172,9 +174,18 @@ struct  fs_dev_sd_spi_data {
     FS_QTY               UnitNbr;
     CPU_BOOLEAN          Init;
 
+#if (FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN > 0u)
+    CPU_BOOLEAN          PreEraseEn;                            /* Card accepts ACMD23.                                 */
+#endif
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED)
+    CPU_BOOLEAN          BusyPend;                              /* Card may be busy pgm'ing last wr.                    */
+#endif
+
 #if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
     FS_CTR               StatRdCtr;
     FS_CTR               StatWrCtr;
+    FS_CTR               StatPreEraseCtr;                       /* Nbr of multi-blk wrs pre-erased.                     */
+    FS_CTR               StatBusyDeferCtr;                      /* Nbr of wrs rtn'd while card busy.                    */
 #endif
 
 #if (FS_CFG_CTR_ERR_EN == DEF_ENABLED)
@@ -257,6 +268,8 @@ static  FS_DEV_SD_SPI_DATA  *FSDev_SD_SPI_ListFreePtr;
 
 #define  FS_DEV_SD_SPI_STAT_RD_CTR_INC(p_sd_spi_data)                    {  FS_CTR_STAT_INC((p_sd_spi_data)->StatRdCtr);                }
 #define  FS_DEV_SD_SPI_STAT_WR_CTR_INC(p_sd_spi_data)                    {  FS_CTR_STAT_INC((p_sd_spi_data)->StatWrCtr);                }
+#define  FS_DEV_SD_SPI_STAT_PRE_ERASE_CTR_INC(p_sd_spi_data)             {  FS_CTR_STAT_INC((p_sd_spi_data)->StatPreEraseCtr);          }
+#define  FS_DEV_SD_SPI_STAT_BUSY_DEFER_CTR_INC(p_sd_spi_data)            {  FS_CTR_STAT_INC((p_sd_spi_data)->StatBusyDeferCtr);         }
 
 #define  FS_DEV_SD_SPI_STAT_RD_CTR_ADD(p_sd_spi_data, val)               {  FS_CTR_STAT_ADD((p_sd_spi_data)->StatRdCtr, (FS_CTR)(val)); }
 #define  FS_DEV_SD_SPI_STAT_WR_CTR_ADD(p_sd_spi_data, val)               {  FS_CTR_STAT_ADD((p_sd_spi_data)->StatWrCtr, (FS_CTR)(val)); }
@@ -265,6 +278,8 @@ static  FS_DEV_SD_SPI_DATA  *FSDev_SD_SPI_ListFreePtr;
 
 #define  FS_DEV_SD_SPI_STAT_RD_CTR_INC(p_sd_spi_data)
 #define  FS_DEV_SD_SPI_STAT_WR_CTR_INC(p_sd_spi_data)
+#define  FS_DEV_SD_SPI_STAT_PRE_ERASE_CTR_INC(p_sd_spi_data)
+#define  FS_DEV_SD_SPI_STAT_BUSY_DEFER_CTR_INC(p_sd_spi_data)
 
 #define  FS_DEV_SD_SPI_STAT_RD_CTR_ADD(p_sd_spi_data, val)
 #define  FS_DEV_SD_SPI_STAT_WR_CTR_ADD(p_sd_spi_data, val)
@@ -349,6 +364,22 @@ static  void                 FSDev_SD_SPI_IO_Ctrl          (FS_DEV
                                                             void                         *p_data,
                                                             FS_ERR                       *p_err);
 
+                                                                /* Read from device into buf list.                      */
+static  void                 FSDev_SD_SPI_RdV              (FS_DEV                       *p_dev,
+                                                            FS_DEV_IO_VEC                *p_vec_tbl,
+                                                            FS_SEC_QTY                    vec_cnt,
+                                                            FS_SEC_NBR                    start,
+                                                            FS_ERR                       *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+                                                                /* Write to device from buf list.                       */
+static  void                 FSDev_SD_SPI_WrV              (FS_DEV                       *p_dev,
+                                                            FS_DEV_IO_VEC                *p_vec_tbl,
+                                                            FS_SEC_QTY                    vec_cnt,
+                                                            FS_SEC_NBR                    start,
+                                                            FS_ERR                       *p_err);
+#endif
+
                                                                 /* ------------------- LOCAL FNCTS -------------------- */
                                                                 /* Refresh dev.                                         */
 static  CPU_BOOLEAN          FSDev_SD_SPI_Refresh          (FS_DEV_SD_SPI_DATA           *p_sd_spi_data,
@@ -391,7 +422,7 @@ static  CPU_BOOLEAN          FSDev_SD_SPI_RdData           (FS_DEV_SD_SPI_DATA
 static  CPU_BOOLEAN          FSDev_SD_SPI_RdDataMulti      (FS_DEV_SD_SPI_DATA           *p_sd_spi_data,
                                                             CPU_INT08U                    cmd,
                                                             CPU_INT32U                    arg,
-                                                            CPU_INT08U                   *p_dest,
+                                                            FS_DEV_IO_VEC                *p_vec_tbl,
                                                             CPU_INT32U                    size,
                                                             CPU_INT32U                    cnt);
 
@@ -407,9 +438,15 @@ static  CPU_BOOLEAN          FSDev_SD_SPI_WrData           (FS_DEV_SD_SPI_DATA
 static  CPU_BOOLEAN          FSDev_SD_SPI_WrDataMulti      (FS_DEV_SD_SPI_DATA           *p_sd_spi_data,
                                                             CPU_INT08U                    cmd,
                                                             CPU_INT32U                    arg,
-                                                            CPU_INT08U                   *p_src,
+                                                            FS_DEV_IO_VEC                *p_vec_tbl,
                                                             CPU_INT32U                    size,
                                                             CPU_INT32U                    cnt);
+
+#if (FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN > 0u)
+                                                                /* Set nbr of wr blks to pre-erase.                     */
+static  void                 FSDev_SD_SPI_PreErase         (FS_DEV_SD_SPI_DATA           *p_sd_spi_data,
+                                                            CPU_INT32U                    cnt);
+#endif
 #endif
 
 
@@ -436,6 +473,26 @@ static  CPU_INT08U           FSDev_SD_SPI_WaitForStart     (FS_QTY
                                                                 /* Wait while card rtns busy token.                     */
 static  CPU_INT08U           FSDev_SD_SPI_WaitWhileBusy    (FS_QTY                        unit_nbr);
 
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED)
+                                                                /* Wait while card busy with prev wr.                   */
+static  CPU_BOOLEAN          FSDev_SD_SPI_WaitBusyPend     (FS_DEV_SD_SPI_DATA           *p_sd_spi_data);
+#endif
+
+                                                                /* Start rd of data blk.                                */
+static  void                 FSDev_SD_SPI_DataRdStart      (FS_QTY                        unit_nbr,
+                                                            CPU_INT08U                   *p_dest,
+                                                            CPU_INT32U                    size);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+                                                                /* Start wr of data blk.                                */
+static  void                 FSDev_SD_SPI_DataWrStart      (FS_QTY                        unit_nbr,
+                                                            CPU_INT08U                   *p_src,
+                                                            CPU_INT32U                    size);
+#endif
+
+                                                                /* Wait for end of data blk xfer.                       */
+static  CPU_BOOLEAN          FSDev_SD_SPI_DataWait         (FS_QTY                        unit_nbr);
+
 
                                                                 /* Free SD SPI data.                                    */
 static  void                 FSDev_SD_SPI_DataFree         (FS_DEV_SD_SPI_DATA           *p_sd_spi_data);
@@ -459,7 +516,11 @@ const  FS_DEV_API  FSDev_SD_SPI = {
     FSDev_SD_SPI_Wr,
 #endif
     FSDev_SD_SPI_Query,
-    FSDev_SD_SPI_IO_Ctrl
+    FSDev_SD_SPI_IO_Ctrl,
+    FSDev_SD_SPI_RdV,
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    FSDev_SD_SPI_WrV
+#endif
 };
 
 
@@ -824,6 +885,9 @@ static  void  FSDev_SD_SPI_Open (FS_DEV  *p_dev,
 *                   called when a device is open.
 *
 *               (2) This function will be called EVERY time the device is closed.
+*
+*               (3) If the wait while the card is busy after the last write was deferred, it is done before
+*                   the SPI is closed (see 'fs_dev_sd_spi.h  Note #2c').
 *********************************************************************************************************
 */
 
@@ -834,6 +898,15 @@ static  void  FSDev_SD_SPI_Close (FS_DEV  *p_dev)
 
     p_sd_spi_data = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
     if (p_sd_spi_data->Init == DEF_YES) {
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED)
+        if (p_sd_spi_data->BusyPend == DEF_YES) {               /* See Note #3.                                         */
+            FSDev_SD_SPI_BSP_SPI.Lock(p_sd_spi_data->UnitNbr);
+            FS_DEV_SD_SPI_ENTER(p_sd_spi_data->UnitNbr);
+            (void)FSDev_SD_SPI_WaitBusyPend(p_sd_spi_data);
+            FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);
+            FSDev_SD_SPI_BSP_SPI.Unlock(p_sd_spi_data->UnitNbr);
+        }
+#endif
         FSDev_SD_SPI_BSP_SPI.Close(p_sd_spi_data->UnitNbr);
     }
     FSDev_SD_SPI_DataFree(p_sd_spi_data);
@@ -865,13 +938,7 @@ static  void  FSDev_SD_SPI_Close (FS_DEV  *p_dev)
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
-*                   called when a device is open.
-*
-*               (2) Standard-capacity devices receive the start byte address as the argument of the read
-*                   command, limiting device access to 4-GB (the range of a 32-bit variable).  To solve
-*                   that problem, high-capacity devices (like SDHC cards) receive the block number as the
-*                   argument of the read command.
+* Note(s)     : (1) The buffer is read as a list of one buffer (see 'FSDev_SD_SPI_RdV()').
 *********************************************************************************************************
 */
 
@@ -881,60 +948,16 @@ static  void  FSDev_SD_SPI_Rd (FS_DEV      *p_dev,
                                FS_SEC_QTY   cnt,
                                FS_ERR      *p_err)
 {
-    CPU_BOOLEAN          ok;
-    CPU_INT32U           start_addr;
-    CPU_INT08U          *p_dest_08;
-    FS_DEV_SD_INFO      *p_sd_info;
-    FS_DEV_SD_SPI_DATA  *p_sd_spi_data;
-    FS_QTY               unit_nbr;
+    FS_DEV_IO_VEC  vec;
 
 
-                                                                /* ------------------ PREPARE FOR RD ------------------ */
-    unit_nbr      =  p_dev->UnitNbr;
-    p_dest_08     = (CPU_INT08U         *)p_dest;
-    p_sd_spi_data = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
-    p_sd_info     = &p_sd_spi_data->Info;
-                                                                /* See Note #2.                                         */
-    start_addr    = (p_sd_info->HighCapacity == DEF_YES) ? start : (start * FS_DEV_SD_BLK_SIZE);
-
-    FSDev_SD_SPI_BSP_SPI.Lock(unit_nbr);
-
-
-    if (cnt > 1u) {                                             /* ---------------- PERFORM MULTIPLE RD --------------- */
-        ok = FSDev_SD_SPI_RdDataMulti(p_sd_spi_data,            /* Rd data.                                             */
-                                      FS_DEV_SD_CMD_READ_MULTIPLE_BLOCK,
-                                      start_addr,
-                                      p_dest_08,
-                                      FS_DEV_SD_BLK_SIZE,
-                                      cnt);
-
-
-
-    } else {                                                    /* ----------------- PERFORM SINGLE RD ---------------- */
-        ok = FSDev_SD_SPI_RdData(p_sd_spi_data,                 /* Rd data.                                             */
-                                 FS_DEV_SD_CMD_READ_SINGLE_BLOCK,
-                                 start_addr,
-                                 p_dest_08,
-                                 FS_DEV_SD_BLK_SIZE);
-    }
-
-
-
-    if (ok != DEF_OK) {                                         /* ---------------------- CHK ERR --------------------- */
-        FSDev_SD_SPI_BSP_SPI.Unlock(unit_nbr);
-        FS_DEV_SD_SPI_ERR_RD_CTR_INC(p_sd_spi_data);
-        FS_TRACE_DBG(("FSDev_SD_SPI_Rd(): Failed to read card.\r\n"));
-       *p_err = FS_ERR_DEV_IO;
-        return;
-    }
-
-    FS_DEV_SD_SPI_STAT_RD_CTR_ADD(p_sd_spi_data, cnt);
-
-
-
-                                                                /* ----------------- RELEASE BUS LOCK ----------------- */
-    FSDev_SD_SPI_BSP_SPI.Unlock(unit_nbr);
-   *p_err = FS_ERR_NONE;
+    vec.BufPtr = p_dest;
+    vec.Cnt    = cnt;
+    FSDev_SD_SPI_RdV(p_dev,                                     /* See Note #1.                                         */
+                    &vec,
+                     1u,
+                     start,
+                     p_err);
 }
 
 
@@ -963,13 +986,7 @@ static  void  FSDev_SD_SPI_Rd (FS_DEV      *p_dev,
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
-*                   called when a device is open.
-*
-*               (2) Standard-capacity devices receive the start byte address as the argument of the write
-*                   command, limiting device access to 4-GB (the range of a 32-bit variable).  To solve
-*                   that problem, high-capacity devices (like SDHC cards) receive the block number as the
-*                   argument of the write command.
+* Note(s)     : (1) The buffer is written as a list of one buffer (see 'FSDev_SD_SPI_WrV()').
 *********************************************************************************************************
 */
 
@@ -980,60 +997,16 @@ static  void  FSDev_SD_SPI_Wr (FS_DEV      *p_dev,
                                FS_SEC_QTY   cnt,
                                FS_ERR      *p_err)
 {
-    CPU_BOOLEAN          ok;
-    CPU_INT32U           start_addr;
-    FS_DEV_SD_INFO      *p_sd_info;
-    FS_DEV_SD_SPI_DATA  *p_sd_spi_data;
-    CPU_INT08U          *p_src_08;
-    FS_QTY               unit_nbr;
-
-
-                                                                /* ------------------ PREPARE FOR WR ------------------ */
-    unit_nbr      =  p_dev->UnitNbr;
-    p_src_08      = (CPU_INT08U         *)p_src;
-    p_sd_spi_data = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
-    p_sd_info     = &p_sd_spi_data->Info;
-                                                                /* See Note #2.                                         */
-    start_addr    = (p_sd_info->HighCapacity == DEF_YES) ? start : (start * FS_DEV_SD_BLK_SIZE);
-
-    FSDev_SD_SPI_BSP_SPI.Lock(unit_nbr);
-
-
-    if (cnt > 1u) {                                             /* ---------------- PERFORM MULTIPLE WR --------------- */
-        ok = FSDev_SD_SPI_WrDataMulti(p_sd_spi_data,            /* Wr data.                                             */
-                                      FS_DEV_SD_CMD_WRITE_MULTIPLE_BLOCK,
-                                      start_addr,
-                                      p_src_08,
-                                      FS_DEV_SD_BLK_SIZE,
-                                      cnt);
-
-
-
-    } else {                                                    /* ----------------- PERFORM SINGLE WR ---------------- */
-        ok = FSDev_SD_SPI_WrData(p_sd_spi_data,                 /* Wr data.                                             */
-                                 FS_DEV_SD_CMD_WRITE_BLOCK,
-                                 start_addr,
-                                 p_src_08,
-                                 FS_DEV_SD_BLK_SIZE);
-    }
-
-
-
-    if (ok != DEF_OK) {                                         /* ---------------------- CHK ERR --------------------- */
-        FSDev_SD_SPI_BSP_SPI.Unlock(unit_nbr);
-        FS_DEV_SD_SPI_ERR_WR_CTR_INC(p_sd_spi_data);
-        FS_TRACE_DBG(("FSDev_SD_SPI_Wr(): Failed to write card.\r\n"));
-       *p_err = FS_ERR_DEV_IO;
-        return;
-    }
-
-    FS_DEV_SD_SPI_STAT_WR_CTR_ADD(p_sd_spi_data, cnt);
+    FS_DEV_IO_VEC  vec;
 
 
-
-                                                                /* ----------------- RELEASE BUS LOCK ----------------- */
-    FSDev_SD_SPI_BSP_SPI.Unlock(unit_nbr);
-   *p_err = FS_ERR_NONE;
+    vec.BufPtr = p_src;
+    vec.Cnt    = cnt;
+    FSDev_SD_SPI_WrV(p_dev,                                     /* See Note #1.                                         */
+                    &vec,
+                     1u,
+                     start,
+                     p_err);
 }
 #endif
 
@@ -1146,8 +1119,13 @@ static  void  FSDev_SD_SPI_Query (FS_DEV       *p_dev,
 *                   (n) FS_DEV_IO_CTRL_SD_QUERY          Get info about SD/MMC card.
 *                   (o) FS_DEV_IO_CTRL_SD_RD_CID         Read SD/MMC card Card ID register.
 *                   (p) FS_DEV_IO_CTRL_SD_RD_CSD         Read SD/MMC card Card-Specific Data register.
+*                   (q) FS_DEV_IO_CTRL_SYNC              Sync device.
 *
 *                           [*] NOT SUPPORTED
+*
+*               (3) Sync returns once the card has finished programming the last write, if the wait was
+*                   deferred (see 'fs_dev_sd_spi.h  Note #2c').  A card remaining busy is reported as a
+*                   device I/O error.
 *********************************************************************************************************
 */
 
@@ -1231,50 +1209,316 @@ static  void  FSDev_SD_SPI_IO_Ctrl (FS_DEV      *p_dev,
              break;
 
 
-        case FS_DEV_IO_CTRL_SD_RD_CSD:                          /* --------- READ CARD-SPECIFIC DATA REGISTER --------- */
-             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
-                *p_err = FS_ERR_NULL_PTR;
-                 return;
-             }
-                                                                /* Validate dev init.                                   */
-             p_sd_spi_data  = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
-             if (p_sd_spi_data->Init == DEF_NO) {
-                 *p_err = FS_ERR_DEV_NOT_PRESENT;
-                  return;
-             }
+        case FS_DEV_IO_CTRL_SD_RD_CSD:                          /* --------- READ CARD-SPECIFIC DATA REGISTER --------- */
+             if (p_data == (void *)0) {                         /* Validate data ptr.                                   */
+                *p_err = FS_ERR_NULL_PTR;
+                 return;
+             }
+                                                                /* Validate dev init.                                   */
+             p_sd_spi_data  = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
+             if (p_sd_spi_data->Init == DEF_NO) {
+                 *p_err = FS_ERR_DEV_NOT_PRESENT;
+                  return;
+             }
+
+                                                                /* Rd CSD reg.                                          */
+             FSDev_SD_SPI_BSP_SPI.Lock(p_sd_spi_data->UnitNbr);
+             ok = FSDev_SD_SPI_SendCSD(              p_sd_spi_data,
+                                       (CPU_INT08U *)p_data);
+             FSDev_SD_SPI_BSP_SPI.Unlock(p_sd_spi_data->UnitNbr);
+
+             if (ok == DEF_NO) {
+                *p_err = FS_ERR_DEV_IO;
+                 return;
+             }
+
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+        case FS_DEV_IO_CTRL_SYNC:                               /* --------------------- SYNC DEV --------------------- */
+             p_sd_spi_data = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
+             if (p_sd_spi_data->Init == DEF_NO) {
+                *p_err = FS_ERR_DEV_NOT_PRESENT;
+                 return;
+             }
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED)
+             if (p_sd_spi_data->BusyPend == DEF_YES) {          /* See Note #3.                                         */
+                 FSDev_SD_SPI_BSP_SPI.Lock(p_sd_spi_data->UnitNbr);
+                 FS_DEV_SD_SPI_ENTER(p_sd_spi_data->UnitNbr);
+                 ok = FSDev_SD_SPI_WaitBusyPend(p_sd_spi_data);
+                 FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);
+                 FSDev_SD_SPI_BSP_SPI.Unlock(p_sd_spi_data->UnitNbr);
+                 if (ok != DEF_OK) {
+                     FS_DEV_SD_SPI_ERR_WR_CTR_INC(p_sd_spi_data);
+                    *p_err = FS_ERR_DEV_IO;
+                     return;
+                 }
+             }
+#endif
+            *p_err = FS_ERR_NONE;
+             break;
+
+
+        case FS_DEV_IO_CTRL_LOW_FMT:                            /* --------------- UNSUPPORTED I/O CTRL --------------- */
+        case FS_DEV_IO_CTRL_LOW_UNMOUNT:
+        case FS_DEV_IO_CTRL_LOW_MOUNT:
+        case FS_DEV_IO_CTRL_LOW_COMPACT:
+        case FS_DEV_IO_CTRL_LOW_DEFRAG:
+        case FS_DEV_IO_CTRL_SEC_RELEASE:
+        case FS_DEV_IO_CTRL_PHY_RD:
+        case FS_DEV_IO_CTRL_PHY_WR:
+        case FS_DEV_IO_CTRL_PHY_WR_PAGE:
+        case FS_DEV_IO_CTRL_PHY_RD_PAGE:
+        case FS_DEV_IO_CTRL_PHY_ERASE_BLK:
+        case FS_DEV_IO_CTRL_PHY_ERASE_CHIP:
+        default:
+            *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+             break;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FSDev_SD_SPI_RdV()
+*
+* Description : Read consecutive sectors from a device into a list of buffers.
+*
+* Argument(s) : p_dev       Pointer to device to read from.
+*
+*               p_vec_tbl   Pointer to table of buffers.
+*
+*               vec_cnt     Number of buffers in table.
+*
+*               start       Start sector of read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                    Sector(s) read.
+*                               FS_ERR_DEV_INVALID_UNIT_NBR    Device unit number is invalid.
+*                               FS_ERR_DEV_NOT_OPEN            Device is not open.
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
+*                   called when a device is open.
+*
+*               (2) Standard-capacity devices receive the start byte address as the argument of the read
+*                   command, limiting device access to 4-GB (the range of a 32-bit variable).  To solve
+*                   that problem, high-capacity devices (like SDHC cards) receive the block number as the
+*                   argument of the read command.
+*
+*               (3) The sectors are read with a single read command, whatever the number of buffers :
+*                   each block received is stored in the buffer it belongs to.
+*********************************************************************************************************
+*/
+
+static  void  FSDev_SD_SPI_RdV (FS_DEV         *p_dev,
+                                FS_DEV_IO_VEC  *p_vec_tbl,
+                                FS_SEC_QTY      vec_cnt,
+                                FS_SEC_NBR      start,
+                                FS_ERR         *p_err)
+{
+    CPU_BOOLEAN          ok;
+    CPU_INT32U           start_addr;
+    FS_SEC_QTY           cnt;
+    FS_SEC_QTY           vec_ix;
+    FS_DEV_SD_INFO      *p_sd_info;
+    FS_DEV_SD_SPI_DATA  *p_sd_spi_data;
+    FS_QTY               unit_nbr;
+
+
+                                                                /* ------------------ PREPARE FOR RD ------------------ */
+    unit_nbr      =  p_dev->UnitNbr;
+    p_sd_spi_data = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
+    p_sd_info     = &p_sd_spi_data->Info;
+                                                                /* See Note #2.                                         */
+    start_addr    = (p_sd_info->HighCapacity == DEF_YES) ? start : (start * FS_DEV_SD_BLK_SIZE);
+
+    cnt = 0u;
+    for (vec_ix = 0u; vec_ix < vec_cnt; vec_ix++) {
+        cnt += p_vec_tbl[vec_ix].Cnt;
+    }
+    if (cnt == 0u) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    FSDev_SD_SPI_BSP_SPI.Lock(unit_nbr);
+
+
+    if (cnt > 1u) {                                             /* ---------------- PERFORM MULTIPLE RD --------------- */
+        ok = FSDev_SD_SPI_RdDataMulti(p_sd_spi_data,            /* Rd data (see Note #3).                               */
+                                      FS_DEV_SD_CMD_READ_MULTIPLE_BLOCK,
+                                      start_addr,
+                                      p_vec_tbl,
+                                      FS_DEV_SD_BLK_SIZE,
+                                      cnt);
+
+
+
+    } else {                                                    /* ----------------- PERFORM SINGLE RD ---------------- */
+        vec_ix = 0u;
+        while (p_vec_tbl[vec_ix].Cnt == 0u) {
+            vec_ix++;
+        }
+        ok = FSDev_SD_SPI_RdData(p_sd_spi_data,                 /* Rd data.                                             */
+                                 FS_DEV_SD_CMD_READ_SINGLE_BLOCK,
+                                 start_addr,
+                                 (CPU_INT08U *)p_vec_tbl[vec_ix].BufPtr,
+                                 FS_DEV_SD_BLK_SIZE);
+    }
+
+
+
+    if (ok != DEF_OK) {                                         /* ---------------------- CHK ERR --------------------- */
+        FSDev_SD_SPI_BSP_SPI.Unlock(unit_nbr);
+        FS_DEV_SD_SPI_ERR_RD_CTR_INC(p_sd_spi_data);
+        FS_TRACE_DBG(("FSDev_SD_SPI_RdV(): Failed to read card.\r\n"));
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
+
+    FS_DEV_SD_SPI_STAT_RD_CTR_ADD(p_sd_spi_data, cnt);
+
+
+
+                                                                /* ----------------- RELEASE BUS LOCK ----------------- */
+    FSDev_SD_SPI_BSP_SPI.Unlock(unit_nbr);
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FSDev_SD_SPI_WrV()
+*
+* Description : Write consecutive sectors to a device from a list of buffers.
+*
+* Argument(s) : p_dev       Pointer to device to write to.
+*
+*               p_vec_tbl   Pointer to table of buffers.
+*
+*               vec_cnt     Number of buffers in table.
+*
+*               start       Start sector of write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                    Sector(s) written.
+*                               FS_ERR_DEV_INVALID_UNIT_NBR    Device unit number is invalid.
+*                               FS_ERR_DEV_NOT_OPEN            Device is not open.
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Tracking whether a device is open is not necessary, because this should ONLY be
+*                   called when a device is open.
+*
+*               (2) Standard-capacity devices receive the start byte address as the argument of the write
+*                   command, limiting device access to 4-GB (the range of a 32-bit variable).  To solve
+*                   that problem, high-capacity devices (like SDHC cards) receive the block number as the
+*                   argument of the write command.
+*
+*               (3) A multiple block write of FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN blocks or more to a SD card
+*                   is preceded by ACMD23, so that the card may erase the blocks before they are written
+*                   (see [Ref 1], Section 4.3.4).  ACMD23 is optional for MMC cards, to which it is not
+*                   sent, & the write is done without it if the card does not accept it.
+*
+*               (4) The sectors are written with a single write command, whatever the number of buffers
+*                   (see 'FSDev_SD_SPI_RdV()  Note #3').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSDev_SD_SPI_WrV (FS_DEV         *p_dev,
+                                FS_DEV_IO_VEC  *p_vec_tbl,
+                                FS_SEC_QTY      vec_cnt,
+                                FS_SEC_NBR      start,
+                                FS_ERR         *p_err)
+{
+    CPU_BOOLEAN          ok;
+    CPU_INT32U           start_addr;
+    FS_SEC_QTY           cnt;
+    FS_SEC_QTY           vec_ix;
+    FS_DEV_SD_INFO      *p_sd_info;
+    FS_DEV_SD_SPI_DATA  *p_sd_spi_data;
+    FS_QTY               unit_nbr;
+
+
+                                                                /* ------------------ PREPARE FOR WR ------------------ */
+    unit_nbr      =  p_dev->UnitNbr;
+    p_sd_spi_data = (FS_DEV_SD_SPI_DATA *)p_dev->DataPtr;
+    p_sd_info     = &p_sd_spi_data->Info;
+                                                                /* See Note #2.                                         */
+    start_addr    = (p_sd_info->HighCapacity == DEF_YES) ? start : (start * FS_DEV_SD_BLK_SIZE);
+
+    cnt = 0u;
+    for (vec_ix = 0u; vec_ix < vec_cnt; vec_ix++) {
+        cnt += p_vec_tbl[vec_ix].Cnt;
+    }
+    if (cnt == 0u) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    FSDev_SD_SPI_BSP_SPI.Lock(unit_nbr);
+
+
+    if (cnt > 1u) {                                             /* ---------------- PERFORM MULTIPLE WR --------------- */
+#if (FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN > 0u)
+        if ((cnt                       >= FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN) &&
+            (p_sd_spi_data->PreEraseEn == DEF_YES)) {
+            FSDev_SD_SPI_PreErase(p_sd_spi_data, cnt);          /* See Note #3.                                         */
+        }
+#endif
+
+        ok = FSDev_SD_SPI_WrDataMulti(p_sd_spi_data,            /* Wr data (see Note #4).                               */
+                                      FS_DEV_SD_CMD_WRITE_MULTIPLE_BLOCK,
+                                      start_addr,
+                                      p_vec_tbl,
+                                      FS_DEV_SD_BLK_SIZE,
+                                      cnt);
+
+
+
+    } else {                                                    /* ----------------- PERFORM SINGLE WR ---------------- */
+        vec_ix = 0u;
+        while (p_vec_tbl[vec_ix].Cnt == 0u) {
+            vec_ix++;
+        }
+        ok = FSDev_SD_SPI_WrData(p_sd_spi_data,                 /* Wr data.                                             */
+                                 FS_DEV_SD_CMD_WRITE_BLOCK,
+                                 start_addr,
+                                 (CPU_INT08U *)p_vec_tbl[vec_ix].BufPtr,
+                                 FS_DEV_SD_BLK_SIZE);
+    }
+
+
 
-                                                                /* Rd CSD reg.                                          */
-             FSDev_SD_SPI_BSP_SPI.Lock(p_sd_spi_data->UnitNbr);
-             ok = FSDev_SD_SPI_SendCSD(              p_sd_spi_data,
-                                       (CPU_INT08U *)p_data);
-             FSDev_SD_SPI_BSP_SPI.Unlock(p_sd_spi_data->UnitNbr);
+    if (ok != DEF_OK) {                                         /* ---------------------- CHK ERR --------------------- */
+        FSDev_SD_SPI_BSP_SPI.Unlock(unit_nbr);
+        FS_DEV_SD_SPI_ERR_WR_CTR_INC(p_sd_spi_data);
+        FS_TRACE_DBG(("FSDev_SD_SPI_WrV(): Failed to write card.\r\n"));
+       *p_err = FS_ERR_DEV_IO;
+        return;
+    }
 
-             if (ok == DEF_NO) {
-                *p_err = FS_ERR_DEV_IO;
-                 return;
-             }
+    FS_DEV_SD_SPI_STAT_WR_CTR_ADD(p_sd_spi_data, cnt);
 
-            *p_err = FS_ERR_NONE;
-             break;
 
 
-        case FS_DEV_IO_CTRL_LOW_FMT:                            /* --------------- UNSUPPORTED I/O CTRL --------------- */
-        case FS_DEV_IO_CTRL_LOW_UNMOUNT:
-        case FS_DEV_IO_CTRL_LOW_MOUNT:
-        case FS_DEV_IO_CTRL_LOW_COMPACT:
-        case FS_DEV_IO_CTRL_LOW_DEFRAG:
-        case FS_DEV_IO_CTRL_SEC_RELEASE:
-        case FS_DEV_IO_CTRL_PHY_RD:
-        case FS_DEV_IO_CTRL_PHY_WR:
-        case FS_DEV_IO_CTRL_PHY_WR_PAGE:
-        case FS_DEV_IO_CTRL_PHY_RD_PAGE:
-        case FS_DEV_IO_CTRL_PHY_ERASE_BLK:
-        case FS_DEV_IO_CTRL_PHY_ERASE_CHIP:
-        default:
-            *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
-             break;
-    }
+                                                                /* ----------------- RELEASE BUS LOCK ----------------- */
+    FSDev_SD_SPI_BSP_SPI.Unlock(unit_nbr);
+   *p_err = FS_ERR_NONE;
 }
+#endif
 
 
 /*
@@ -1401,6 +1645,9 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_Refresh (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
                                                                 /* ---------------------- INIT HW --------------------- */
     init_prev                = p_sd_spi_data->Init;             /* If init'd prev'ly, dev chngd.                        */
     p_sd_spi_data->Init      = DEF_NO;                          /* No longer init'd.                                    */
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED)
+    p_sd_spi_data->BusyPend  = DEF_NO;
+#endif
     FSDev_SD_ClrInfo(p_sd_info);                                /* Clr old info.                                        */
 
     ok = FSDev_SD_SPI_BSP_SPI.Open(unit_nbr);                   /* Init HW.                                             */
@@ -1457,6 +1704,11 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_Refresh (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
 
     p_sd_info->CardType = card_type;
 
+#if (FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN > 0u)                      /* ACMD23 only sent to SD cards.                        */
+    p_sd_spi_data->PreEraseEn = ((card_type == FS_DEV_SD_CARDTYPE_MMC) ||
+                                 (card_type == FS_DEV_SD_CARDTYPE_MMC_HC)) ? DEF_NO : DEF_YES;
+#endif
+
     if ((card_type == FS_DEV_SD_CARDTYPE_SD_V2_0_HC) ||
         (card_type == FS_DEV_SD_CARDTYPE_MMC_HC)) {
         p_sd_info->HighCapacity = DEF_YES;
@@ -1679,7 +1931,9 @@ static  CPU_INT08U  FSDev_SD_SPI_MakeRdy (FS_DEV_SD_SPI_DATA  *p_sd_spi_data)
 *
 * Return(s)   : Command response.
 *
-* Note(s)     : none.
+* Note(s)     : (1) If the card may still be busy programming the last write, the command is sent once it
+*                   is no longer busy (see 'fs_dev_sd_spi.h  Note #2c').  If it remains busy, no command
+*                   is sent & FS_DEV_SD_SPI_RESP_EMPTY is returned, as if it timed out.
 *********************************************************************************************************
 */
 
@@ -1687,10 +1941,20 @@ static  CPU_INT08U  FSDev_SD_SPI_Cmd (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
                                       CPU_INT08U           cmd,
                                       CPU_INT32U           arg)
 {
-    CPU_INT08U  cmd_pkt[6];
-    CPU_INT08U  chk_sum;
-    CPU_INT16U  timeout;
-    CPU_INT08U  resp;
+    CPU_INT08U   cmd_pkt[6];
+    CPU_INT08U   chk_sum;
+    CPU_INT16U   timeout;
+    CPU_INT08U   resp;
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED)
+    CPU_BOOLEAN  ok;
+
+
+    ok = FSDev_SD_SPI_WaitBusyPend(p_sd_spi_data);              /* See Note #1.                                         */
+    if (ok != DEF_OK) {
+        FS_DEV_SD_SPI_ERR_CMD_RESP_TIMEOUT_CTR_INC(p_sd_spi_data);
+        return (FS_DEV_SD_SPI_RESP_EMPTY);
+    }
+#endif
 
 
 
@@ -1923,13 +2187,14 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_RdData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
                                           CPU_INT08U          *p_dest,
                                           CPU_INT32U           size)
 {
-    CPU_INT08U  crc_buf[2];
+    CPU_INT08U   crc_buf[2];
 #if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
-    CPU_INT16U  crc;
-    CPU_INT16U  crc_chk;
+    CPU_INT16U   crc;
+    CPU_INT16U   crc_chk;
 #endif
-    CPU_INT08U  resp_r1;
-    CPU_INT08U  token;
+    CPU_INT08U   resp_r1;
+    CPU_INT08U   token;
+    CPU_BOOLEAN  ok;
 
 
     FS_DEV_SD_SPI_ENTER(p_sd_spi_data->UnitNbr);                /* 'Enter' SPI access.                                  */
@@ -1952,9 +2217,16 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_RdData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
         return (DEF_FAIL);
     }
 
-    FSDev_SD_SPI_BSP_SPI.Rd(p_sd_spi_data->UnitNbr,             /* Rd rest of resp.                                     */
-                            p_dest,
-                            size);
+    FSDev_SD_SPI_DataRdStart(p_sd_spi_data->UnitNbr,            /* Rd rest of resp.                                     */
+                             p_dest,
+                             size);
+
+    ok = FSDev_SD_SPI_DataWait(p_sd_spi_data->UnitNbr);
+    if (ok != DEF_OK) {
+        FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);             /* 'Exit' SPI access.                                   */
+        FS_TRACE_DBG(("FSDev_SD_SPI_RdData(): Failed to rd card: data xfer failed.\r\n"));
+        return (DEF_FAIL);
+    }
 
     FSDev_SD_SPI_BSP_SPI.Rd( p_sd_spi_data->UnitNbr,            /* Rd CRC ...                                           */
                             &crc_buf[0],
@@ -1988,7 +2260,7 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_RdData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
 *
 *               arg             Command argument.
 *
-*               p_dest          Pointer to destination buffer.
+*               p_vec_tbl       Pointer to table of destination buffers.
 *
 *               size            Size of each data block to be read, in octets.
 *
@@ -1997,24 +2269,35 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_RdData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
 * Return(s)   : DEF_OK   if the data was read.
 *               DEF_FAIL otherwise.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The CRC of each block is checked while the next block is received, which overlaps the
+*                   check with the transfer if the BSP transfers data blocks with DMA.  The CRC of the
+*                   last block is checked once the transmission is stopped.
+*
+*               (2) Blocks are stored in the buffers of the table, in order, each buffer receiving as
+*                   many blocks as its count.
 *********************************************************************************************************
 */
 
 static  CPU_BOOLEAN  FSDev_SD_SPI_RdDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
                                                CPU_INT08U           cmd,
                                                CPU_INT32U           arg,
-                                               CPU_INT08U          *p_dest,
+                                               FS_DEV_IO_VEC       *p_vec_tbl,
                                                CPU_INT32U           size,
                                                CPU_INT32U           cnt)
 {
-    CPU_INT08U  crc_buf[2];
+    CPU_INT08U      crc_buf[2];
 #if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
-    CPU_INT16U  crc;
-    CPU_INT16U  crc_chk;
+    CPU_INT16U      crc;
+    CPU_INT16U      crc_prev;
+    CPU_INT16U      crc_chk;
+    CPU_INT08U     *p_dest_prev;
 #endif
-    CPU_INT08U  resp_r1;
-    CPU_INT08U  token;
+    CPU_INT08U     *p_dest;
+    FS_DEV_IO_VEC  *p_vec;
+    FS_SEC_QTY      blk_ix;
+    CPU_INT08U      resp_r1;
+    CPU_INT08U      token;
+    CPU_BOOLEAN     ok;
 
 
     FS_DEV_SD_SPI_ENTER(p_sd_spi_data->UnitNbr);                /* 'Enter' SPI access.                                  */
@@ -2029,7 +2312,19 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_RdDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_dat
         return (DEF_FAIL);
     }
 
+#if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
+    crc_prev    = 0u;
+    p_dest_prev = (CPU_INT08U *)0;
+#endif
+    p_vec  = p_vec_tbl;
+    blk_ix = 0u;
     while (cnt > 0u) {
+        while (blk_ix == p_vec->Cnt) {                          /* Move to next buf (see Note #2).                      */
+            p_vec++;
+            blk_ix = 0u;
+        }
+        p_dest = (CPU_INT08U *)p_vec->BufPtr + (blk_ix * size);
+
                                                                 /* Wait for start token of data block.                  */
         token = FSDev_SD_SPI_WaitForStart(p_sd_spi_data->UnitNbr);
 
@@ -2039,26 +2334,40 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_RdDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_dat
             return (DEF_FAIL);
         }
 
-        FSDev_SD_SPI_BSP_SPI.Rd(p_sd_spi_data->UnitNbr,         /* Rd rest of resp.                                     */
-                                p_dest,
-                                size);
-
-        FSDev_SD_SPI_BSP_SPI.Rd( p_sd_spi_data->UnitNbr,        /* Rd CRC ...                                           */
-                                &crc_buf[0],
-                                 2u);
+        FSDev_SD_SPI_DataRdStart(p_sd_spi_data->UnitNbr,        /* Rd rest of resp.                                     */
+                                 p_dest,
+                                 size);
 
 #if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
-        crc     = MEM_VAL_GET_INT16U_BIG((void *)&crc_buf[0]);
-        crc_chk = FSDev_SD_ChkSumCalc_16Bit(p_dest, size);      /* ... & chk CRC.                                       */
+        if (p_dest_prev != (CPU_INT08U *)0) {                   /* Chk CRC of prev blk during xfer (see Note #1).       */
+            crc_chk = FSDev_SD_ChkSumCalc_16Bit(p_dest_prev, size);
+            if (crc_prev != crc_chk) {
+                (void)FSDev_SD_SPI_DataWait(p_sd_spi_data->UnitNbr);
+                FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);     /* 'Exit' SPI access.                                   */
+                FS_TRACE_DBG(("FSDev_SD_SPI_RdDataMult(): CRC chk failed: %02X != %02X.\r\n", crc_prev, crc_chk));
+                return (DEF_NO);
+            }
+        }
+#endif
 
-        if (crc != crc_chk) {
+        ok = FSDev_SD_SPI_DataWait(p_sd_spi_data->UnitNbr);
+        if (ok != DEF_OK) {
             FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);         /* 'Exit' SPI access.                                   */
-            FS_TRACE_DBG(("FSDev_SD_SPI_RdDataMult(): CRC chk failed: %02X != %02X.\r\n", crc, crc_chk));
-            return (DEF_NO);
+            FS_TRACE_DBG(("FSDev_SD_SPI_RdDataMulti(): Failed to rd card: data xfer failed.\r\n"));
+            return (DEF_FAIL);
         }
+
+        FSDev_SD_SPI_BSP_SPI.Rd( p_sd_spi_data->UnitNbr,        /* Rd CRC.                                              */
+                                &crc_buf[0],
+                                 2u);
+
+#if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
+        crc         = MEM_VAL_GET_INT16U_BIG((void *)&crc_buf[0]);
+        crc_prev    = crc;
+        p_dest_prev = p_dest;
 #endif
 
-        p_dest += size;
+        blk_ix++;
         cnt--;
     }
 
@@ -2068,6 +2377,15 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_RdDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_dat
 
     (void)FSDev_SD_SPI_WaitWhileBusy(p_sd_spi_data->UnitNbr);   /* Wait while busy token rx'd.                          */
     FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);                 /* 'Exit' SPI access.                                   */
+
+#if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
+    crc_chk = FSDev_SD_ChkSumCalc_16Bit(p_dest_prev, size);     /* Chk CRC of last blk.                                 */
+    if (crc_prev != crc_chk) {
+        FS_TRACE_DBG(("FSDev_SD_SPI_RdDataMult(): CRC chk failed: %02X != %02X.\r\n", crc_prev, crc_chk));
+        return (DEF_NO);
+    }
+#endif
+
     return (DEF_OK);
 }
 
@@ -2091,7 +2409,12 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_RdDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_dat
 * Return(s)   : DEF_OK   if the data was read.
 *               DEF_FAIL otherwise.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The CRC of the block is calculated while the block is transmitted, which overlaps the
+*                   calculation with the transfer if the BSP transfers data blocks with DMA.
+*
+*               (2) If FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN is DEF_ENABLED, the function returns once the card
+*                   has accepted the data, without waiting while it programs it (see 'fs_dev_sd_spi.h
+*                   Note #2c').
 *********************************************************************************************************
 */
 
@@ -2103,11 +2426,12 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
                                           CPU_INT32U           size)
 {
 #if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
-    CPU_INT16U  crc;
+    CPU_INT16U   crc;
 #endif
-    CPU_INT08U  crc_buf[2];
-    CPU_INT08U  resp;
-    CPU_INT08U  token;
+    CPU_INT08U   crc_buf[2];
+    CPU_INT08U   resp;
+    CPU_INT08U   token;
+    CPU_BOOLEAN  ok;
 
 
     FS_DEV_SD_SPI_ENTER(p_sd_spi_data->UnitNbr);                /* 'Enter' SPI access.                                  */
@@ -2127,15 +2451,22 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
                             &token,
                              1u);
 
-    FSDev_SD_SPI_BSP_SPI.Wr( p_sd_spi_data->UnitNbr,            /* Wr data.                                             */
+    FSDev_SD_SPI_DataWrStart(p_sd_spi_data->UnitNbr,            /* Wr data.                                             */
                              p_src,
                              size);
 
 #if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
-    crc = FSDev_SD_ChkSumCalc_16Bit(p_src, size);
+    crc = FSDev_SD_ChkSumCalc_16Bit(p_src, size);               /* See Note #1.                                         */
     MEM_VAL_SET_INT16U_BIG((void *)&crc_buf[0], crc);
 #endif
 
+    ok = FSDev_SD_SPI_DataWait(p_sd_spi_data->UnitNbr);
+    if (ok != DEF_OK) {
+        FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);             /* 'Exit' SPI access.                                   */
+        FS_TRACE_DBG(("FSDev_SD_SPI_WrData(): Failed to wr card: data xfer failed.\r\n"));
+        return (DEF_FAIL);
+    }
+
     FSDev_SD_SPI_BSP_SPI.Wr( p_sd_spi_data->UnitNbr,            /* Wr CRC.                                              */
                             &crc_buf[0],
                              2u);
@@ -2154,6 +2485,11 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
         return (DEF_FAIL);
     }
 
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED)
+    p_sd_spi_data->BusyPend = DEF_YES;                          /* See Note #2.                                         */
+    FS_DEV_SD_SPI_STAT_BUSY_DEFER_CTR_INC(p_sd_spi_data);
+    FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);                 /* 'Exit' SPI access.                                   */
+#else
     resp = FSDev_SD_SPI_WaitWhileBusy(p_sd_spi_data->UnitNbr);  /* Wait while busy token rx'd.                          */
     FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);                 /* 'Exit' SPI access.                                   */
 
@@ -2161,6 +2497,7 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
         FS_TRACE_DBG(("FSDev_SD_SPI_WrData(): Failed to wr card: card busy timed out.\r\n"));
         return (DEF_FAIL);
     }
+#endif
 
     return (DEF_OK);
 }
@@ -2179,7 +2516,7 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
 *
 *               arg             Command argument.
 *
-*               p_src           Pointer to source buffer.
+*               p_vec_tbl       Pointer to table of source buffers.
 *
 *               size            Size of each data block to be written, in octets.
 *
@@ -2188,7 +2525,14 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
 * Return(s)   : DEF_OK   if the data was read.
 *               DEF_FAIL otherwise.
 *
-* Note(s)     : none.
+* Note(s)     : (1) See 'FSDev_SD_SPI_WrData()  Note #1'.
+*
+*               (2) The card is busy between blocks while it empties its buffer, then after the stop
+*                   transmission token until every block is programmed.  Only the last wait may be
+*                   deferred (see 'FSDev_SD_SPI_WrData()  Note #2').
+*
+*               (3) Blocks are taken from the buffers of the table, in order, each buffer providing as
+*                   many blocks as its count.
 *********************************************************************************************************
 */
 
@@ -2196,16 +2540,20 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrData (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
 static  CPU_BOOLEAN  FSDev_SD_SPI_WrDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
                                                CPU_INT08U           cmd,
                                                CPU_INT32U           arg,
-                                               CPU_INT08U          *p_src,
+                                               FS_DEV_IO_VEC       *p_vec_tbl,
                                                CPU_INT32U           size,
                                                CPU_INT32U           cnt)
 {
 #if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
-    CPU_INT16U  crc;
+    CPU_INT16U      crc;
 #endif
-    CPU_INT08U  crc_buf[2];
-    CPU_INT08U  resp;
-    CPU_INT08U  token;
+    CPU_INT08U      crc_buf[2];
+    CPU_INT08U     *p_src;
+    FS_DEV_IO_VEC  *p_vec;
+    FS_SEC_QTY      blk_ix;
+    CPU_INT08U      resp;
+    CPU_INT08U      token;
+    CPU_BOOLEAN     ok;
 
 
     FS_DEV_SD_SPI_ENTER(p_sd_spi_data->UnitNbr);                /* 'Enter' SPI access.                                  */
@@ -2220,21 +2568,36 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_dat
         return (DEF_FAIL);
     }
 
+    p_vec  = p_vec_tbl;
+    blk_ix = 0u;
     while (cnt > 0u) {
+        while (blk_ix == p_vec->Cnt) {                          /* Move to next buf (see Note #3).                      */
+            p_vec++;
+            blk_ix = 0u;
+        }
+        p_src = (CPU_INT08U *)p_vec->BufPtr + (blk_ix * size);
+
         token = FS_DEV_SD_SPI_TOKEN_START_BLK_MULT;
         FSDev_SD_SPI_BSP_SPI.Wr( p_sd_spi_data->UnitNbr,        /* Wr token.                                            */
                                 &token,
                                  1u);
 
-        FSDev_SD_SPI_BSP_SPI.Wr( p_sd_spi_data->UnitNbr,        /* Wr data.                                             */
+        FSDev_SD_SPI_DataWrStart(p_sd_spi_data->UnitNbr,        /* Wr data.                                             */
                                  p_src,
                                  size);
 
 #if (FS_DEV_SD_SPI_CFG_CRC_EN == DEF_ENABLED)
-        crc = FSDev_SD_ChkSumCalc_16Bit(p_src, size);
+        crc = FSDev_SD_ChkSumCalc_16Bit(p_src, size);           /* See Note #1.                                         */
         MEM_VAL_SET_INT16U_BIG((void *)&crc_buf[0], crc);
 #endif
 
+        ok = FSDev_SD_SPI_DataWait(p_sd_spi_data->UnitNbr);
+        if (ok != DEF_OK) {
+            FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);         /* 'Exit' SPI access.                                   */
+            FS_TRACE_DBG(("FSDev_SD_SPI_WrDataMulti(): Failed to wr card: data xfer failed.\r\n"));
+            return (DEF_FAIL);
+        }
+
         FSDev_SD_SPI_BSP_SPI.Wr( p_sd_spi_data->UnitNbr,        /* Wr CRC.                                              */
                                 &crc_buf[0],
                                  2u);
@@ -2260,7 +2623,7 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_dat
             return (DEF_FAIL);
         }
 
-        p_src += size;
+        blk_ix++;
         cnt--;
     }
 
@@ -2269,6 +2632,11 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_dat
                             &token,
                              1u);
 
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED)
+    p_sd_spi_data->BusyPend = DEF_YES;                          /* See Note #2.                                         */
+    FS_DEV_SD_SPI_STAT_BUSY_DEFER_CTR_INC(p_sd_spi_data);
+    FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);                 /* 'Exit' SPI access.                                   */
+#else
     resp  = FSDev_SD_SPI_WaitWhileBusy(p_sd_spi_data->UnitNbr); /* Wait while busy token rx'd.                          */
     FS_DEV_SD_SPI_EXIT(p_sd_spi_data->UnitNbr);                 /* 'Exit' SPI access.                                   */
 
@@ -2276,12 +2644,60 @@ static  CPU_BOOLEAN  FSDev_SD_SPI_WrDataMulti (FS_DEV_SD_SPI_DATA  *p_sd_spi_dat
         FS_TRACE_DBG(("FSDev_SD_SPI_WrDataMulti(): Failed to wr card: card busy timed out.\r\n"));
         return (DEF_FAIL);
     }
+#endif
 
     return (DEF_OK);
 }
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                       FSDev_SD_SPI_PreErase()
+*
+* Description : Set number of write blocks to pre-erase before multiple block write.
+*
+* Argument(s) : p_sd_spi_data   Pointer to SD SPI data.
+*
+*               cnt             Number of blocks to be written.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) ACMD23 applies to the next WRITE_MULTIPLE_BLOCK command only (see [Ref 1], Section
+*                   4.3.4).  It is a hint : the blocks are written the same way if it failed.
+*
+*               (2) If the card does not support ACMD23, it is not sent again until the card is
+*                   re-initialized.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+#if (FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN > 0u)
+static  void  FSDev_SD_SPI_PreErase (FS_DEV_SD_SPI_DATA  *p_sd_spi_data,
+                                     CPU_INT32U           cnt)
+{
+    CPU_INT08U  resp_r1;
+
+
+    cnt     = DEF_MIN(cnt, FS_DEV_SD_SPI_PRE_ERASE_CNT_MAX);
+    resp_r1 = FSDev_SD_SPI_AppCmdR1(p_sd_spi_data,              /* Perform ACMD23.                                      */
+                                    FS_DEV_SD_ACMD_SET_WR_BLK_ERASE_COUNT,
+                                    cnt);
+
+    if (resp_r1 != FS_DEV_SD_SPI_R1_NONE) {
+        if (DEF_BIT_IS_SET(resp_r1, FS_DEV_SD_SPI_R1_ILLEGAL_COMMAND) == DEF_YES) {
+            p_sd_spi_data->PreEraseEn = DEF_NO;                 /* See Note #2.                                         */
+        }
+        FS_TRACE_INFO(("FSDev_SD_SPI_PreErase(): Could not set pre-erase cnt: error: %02X.\r\n", resp_r1));
+        return;
+    }
+
+    FS_DEV_SD_SPI_STAT_PRE_ERASE_CTR_INC(p_sd_spi_data);
+}
+#endif
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                       FSDev_SD_SPI_SendCID()
@@ -2495,6 +2911,147 @@ static  CPU_INT08U  FSDev_SD_SPI_WaitWhileBusy (FS_QTY  unit_nbr)
 }
 
 
+/*
+*********************************************************************************************************
+*                                     FSDev_SD_SPI_WaitBusyPend()
+*
+* Description : Wait while card is busy programming the last write, if that wait was deferred.
+*
+* Argument(s) : p_sd_spi_data   Pointer to SD SPI data.
+*
+* Return(s)   : DEF_OK,   if the card is not busy.
+*               DEF_FAIL, if the card remained busy.
+*
+* Note(s)     : (1) The card MUST be selected.  A card deselected while busy drives DO low again once it
+*                   is selected, until it has finished programming (see [Ref 1], Section 7.2.4).
+*********************************************************************************************************
+*/
+
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  FSDev_SD_SPI_WaitBusyPend (FS_DEV_SD_SPI_DATA  *p_sd_spi_data)
+{
+    CPU_INT08U  datum;
+
+
+    if (p_sd_spi_data->BusyPend == DEF_NO) {
+        return (DEF_OK);
+    }
+
+    p_sd_spi_data->BusyPend = DEF_NO;
+    datum = FSDev_SD_SPI_WaitWhileBusy(p_sd_spi_data->UnitNbr); /* Wait while busy token rx'd.                          */
+    if (datum != FS_DEV_SD_SPI_RESP_EMPTY) {
+        FS_TRACE_DBG(("FSDev_SD_SPI_WaitBusyPend(): Card busy timed out.\r\n"));
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     FSDev_SD_SPI_DataRdStart()
+*
+* Description : Start reading data block from card.
+*
+* Argument(s) : unit_nbr    Unit number of device to control.
+*
+*               p_dest      Pointer to destination buffer.
+*
+*               size        Size of data block, in octets.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) If FS_DEV_SD_SPI_CFG_DMA_EN is DEF_ENABLED, the transfer is only started &
+*                   'FSDev_SD_SPI_DataWait()' MUST be called before the SPI is accessed again.  Otherwise,
+*                   the block is read before the function returns.
+*********************************************************************************************************
+*/
+
+static  void  FSDev_SD_SPI_DataRdStart (FS_QTY       unit_nbr,
+                                        CPU_INT08U  *p_dest,
+                                        CPU_INT32U   size)
+{
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)
+    FSDev_SD_SPI_BSP_DMA.RdStart(unit_nbr,                      /* See Note #1.                                         */
+                                 p_dest,
+                                 size);
+#else
+    FSDev_SD_SPI_BSP_SPI.Rd(unit_nbr,
+                            p_dest,
+                            size);
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FSDev_SD_SPI_DataWrStart()
+*
+* Description : Start writing data block to card.
+*
+* Argument(s) : unit_nbr    Unit number of device to control.
+*
+*               p_src       Pointer to source buffer.
+*
+*               size        Size of data block, in octets.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FSDev_SD_SPI_DataRdStart()  Note #1'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSDev_SD_SPI_DataWrStart (FS_QTY       unit_nbr,
+                                        CPU_INT08U  *p_src,
+                                        CPU_INT32U   size)
+{
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)
+    FSDev_SD_SPI_BSP_DMA.WrStart(unit_nbr,                      /* See Note #1.                                         */
+                                 p_src,
+                                 size);
+#else
+    FSDev_SD_SPI_BSP_SPI.Wr(unit_nbr,
+                            p_src,
+                            size);
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FSDev_SD_SPI_DataWait()
+*
+* Description : Wait for end of data block transfer.
+*
+* Argument(s) : unit_nbr    Unit number of device to control.
+*
+* Return(s)   : DEF_OK,   if the data block was transferred.
+*               DEF_FAIL, otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FSDev_SD_SPI_DataWait (FS_QTY  unit_nbr)
+{
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)
+    CPU_BOOLEAN  ok;
+
+
+    ok = FSDev_SD_SPI_BSP_DMA.Wait(unit_nbr);
+    return (ok);
+#else
+    (void)unit_nbr;
+
+    return (DEF_OK);
+#endif
+}
+
+
 /*
 *********************************************************************************************************
 *                                      FSDev_SD_SPI_DataFree()
@@ -2573,10 +3130,18 @@ static  FS_DEV_SD_SPI_DATA  *FSDev_SD_SPI_DataGet (void)
     FSDev_SD_ClrInfo(&p_sd_spi_data->Info);                     /* Clr SD info.                                         */
 
     p_sd_spi_data->Init                    =  DEF_NO;
+#if (FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN        > 0u)
+    p_sd_spi_data->PreEraseEn              =  DEF_NO;
+#endif
+#if (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN        == DEF_ENABLED)
+    p_sd_spi_data->BusyPend                =  DEF_NO;
+#endif
 
 #if (FS_CFG_CTR_STAT_EN                    == DEF_ENABLED)      /* Clr stat ctrs.                                       */
     p_sd_spi_data->StatRdCtr               =  0u;
     p_sd_spi_data->StatWrCtr               =  0u;
+    p_sd_spi_data->StatPreEraseCtr         =  0u;
+    p_sd_spi_data->StatBusyDeferCtr        =  0u;
 #endif
 
 #if (FS_CFG_CTR_ERR_EN                     == DEF_ENABLED)      /* Clr err ctrs.                                        */
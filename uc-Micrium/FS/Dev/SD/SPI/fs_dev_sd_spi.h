@@ -40,6 +40,22 @@
 *                    (e) MMCplus
 *
 *                    It should also work with devices conformant to the relevant SD or MMC specifications.
+*
+*                (2) Optional features, configured in 'fs_cfg.h' :
+*
+*                    (a) FS_DEV_SD_SPI_CFG_DMA_EN : data blocks are transferred through the BSP's DMA
+*                        functions ('FSDev_SD_SPI_BSP_DMA', see 'FS_DEV_SD_SPI_DMA_API  Note #1'), while
+*                        the CRC of a block is calculated or checked.  Commands, tokens & responses are
+*                        still transferred with the SPI functions.
+*
+*                    (b) FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN : multiple block writes of at least this many
+*                        blocks to a SD card are preceded by ACMD23 (SET_WR_BLK_ERASE_COUNT), so that the
+*                        card may pre-erase the blocks.  0 disables pre-erase.
+*
+*                    (c) FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN : a write returns as soon as the card accepted
+*                        the data; the wait for the end of its programming is deferred to the next
+*                        command, device sync or close, so that the caller prepares the next request
+*                        while the card is busy.
 *********************************************************************************************************
 */
 
@@ -82,6 +98,19 @@
 *********************************************************************************************************
 */
 
+                                                                /* Transfer data blks with DMA (see Note #2a).          */
+#ifndef  FS_DEV_SD_SPI_CFG_DMA_EN
+#define  FS_DEV_SD_SPI_CFG_DMA_EN                DEF_DISABLED
+#endif
+
+#ifndef  FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN                        /* Min nbr of blks pre-erased (see Note #2b).           */
+#define  FS_DEV_SD_SPI_CFG_PRE_ERASE_MIN                   0u
+#endif
+                                                                /* Defer wait while busy after wr (see Note #2c).       */
+#ifndef  FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN
+#define  FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN         DEF_DISABLED
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -89,6 +118,40 @@
 *********************************************************************************************************
 */
 
+/*
+*********************************************************************************************************
+*                                      SD SPI DMA API DATA TYPE
+*
+* Note(s) : (1) If FS_DEV_SD_SPI_CFG_DMA_EN is DEF_ENABLED, the BSP MUST also provide DMA functions, which
+*               transfer the data of a block over the SPI opened by 'FSDev_SD_SPI_BSP_SPI', with the chip
+*               select enabled & the bus locked :
+*
+*               (a) 'RdStart()' starts the reception of 'cnt' octets into 'p_dest' & returns at once.
+*                   0xFF MUST be transmitted while the octets are received.
+*
+*               (b) 'WrStart()' starts the transmission of 'cnt' octets from 'p_src' & returns at once.
+*                   Received octets are discarded.
+*
+*               (c) 'Wait()' waits until the transfer started is complete & returns DEF_OK, or DEF_FAIL
+*                   if it failed or timed out.  It may pend on the DMA completion interrupt.
+*
+*               The buffers are sector buffers of the file system; the BSP MUST handle any alignment or
+*               cache maintenance its DMA controller requires.
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_dev_sd_spi_dma_api {
+    void         (*RdStart)          (FS_QTY          unit_nbr,        /* Start rd from SPI.                    */
+                                      void           *p_dest,
+                                      CPU_SIZE_T      cnt);
+
+    void         (*WrStart)          (FS_QTY          unit_nbr,        /* Start wr to SPI.                      */
+                                      void           *p_src,
+                                      CPU_SIZE_T      cnt);
+
+    CPU_BOOLEAN  (*Wait)             (FS_QTY          unit_nbr);       /* Wait for end of xfer.                 */
+} FS_DEV_SD_SPI_DMA_API;
+
 
 /*
 *********************************************************************************************************
@@ -132,10 +195,17 @@ void         FSDev_SD_SPI_RdCSD             (CPU_CHAR        *name_dev,     /* R
 *                               DEFINED IN BSP'S 'bsp_fs_dev_sd_spi.c'
 *
 * Note(s) : (1) SPI functions MUST be gathered into a SPI API structure.
+*
+*           (2) DMA functions MUST be gathered into a DMA API structure, if FS_DEV_SD_SPI_CFG_DMA_EN is
+*               DEF_ENABLED (see 'FS_DEV_SD_SPI_DMA_API  Note #1').
 *********************************************************************************************************
 */
 
-extern  const  FS_DEV_SPI_API  FSDev_SD_SPI_BSP_SPI;
+extern  const  FS_DEV_SPI_API         FSDev_SD_SPI_BSP_SPI;
+
+#if (FS_DEV_SD_SPI_CFG_DMA_EN == DEF_ENABLED)
+extern  const  FS_DEV_SD_SPI_DMA_API  FSDev_SD_SPI_BSP_DMA;
+#endif
 
 
 /*
@@ -165,6 +235,32 @@ extern  const  FS_DEV_SPI_API  FSDev_SD_SPI_BSP_SPI;
 #endif
 
 
+#ifndef  FS_DEV_SD_SPI_CFG_DMA_EN
+#error  "FS_DEV_SD_SPI_CFG_DMA_EN                not #define'd in 'fs_cfg.h'"
+#error  "                                  [MUST be  DEF_DISABLED]          "
+#error  "                                  [     ||  DEF_ENABLED ]          "
+
+#elif  ((FS_DEV_SD_SPI_CFG_DMA_EN  != DEF_DISABLED) && \
+        (FS_DEV_SD_SPI_CFG_DMA_EN  != DEF_ENABLED ))
+#error  "FS_DEV_SD_SPI_CFG_DMA_EN          illegally #define'd in 'fs_cfg.h'"
+#error  "                                  [MUST be  DEF_DISABLED]          "
+#error  "                                  [     ||  DEF_ENABLED ]          "
+#endif
+
+
+#ifndef  FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN
+#error  "FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN         not #define'd in 'fs_cfg.h'"
+#error  "                                  [MUST be  DEF_DISABLED]          "
+#error  "                                  [     ||  DEF_ENABLED ]          "
+
+#elif  ((FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN  != DEF_DISABLED) && \
+        (FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN  != DEF_ENABLED ))
+#error  "FS_DEV_SD_SPI_CFG_BUSY_DEFER_EN   illegally #define'd in 'fs_cfg.h'"
+#error  "                                  [MUST be  DEF_DISABLED]          "
+#error  "                                  [     ||  DEF_ENABLED ]          "
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
@@ -163,6 +163,10 @@
 #define  FS_FAT_FSI_LEADSIG                       0x41615252u
 #define  FS_FAT_FSI_STRUCSIG                      0x61417272u
 #define  FS_FAT_FSI_TRAILSIG                      0xAA550000u
+#define  FS_FAT_FSI_FREE_COUNT_UNKNOWN            0xFFFFFFFFu
+
+                                                                /* ---------------- FAT32 FAT[1] FLAGS ---------------- */
+#define  FS_FAT_FAT32_CLN_SHUT_BIT                0x08000000u   /* Set if vol cleanly unmounted.                        */
 
 
 /*
@@ -305,6 +309,84 @@ static  void  FS_FAT_FileDataInit       (FS_FAT_FILE_DATA  *p_entry_data,   /* I
 
 static  void  FS_FAT_DataClr            (FS_FAT_DATA       *p_fat_data);    /* Clr FAT info struct.                         */
 
+static  void  FS_FAT_VolStateRd         (FS_VOL            *p_vol);         /* Rd FAT32 vol state & FSINFO.                 */
+
+static  CPU_BOOLEAN  FS_FAT_QueryScan   (FS_VOL            *p_vol,          /* Scan FAT for query info.                     */
+                                         FS_BUF            *p_buf,
+                                         FS_FAT_CLUS_NBR    clus_cnt,
+                                         FS_ERR            *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_QueryInfoUpd       (FS_FAT_DATA       *p_fat_data,     /* Upd query info for alloc'd/free'd clus.      */
+                                         FS_FAT_CLUS_NBR    clus,
+                                         CPU_BOOLEAN        clus_free);
+
+static  void  FS_FAT_VolDirtySet        (FS_VOL            *p_vol,          /* Clr FAT32 clean shutdown bit.                */
+                                         FS_BUF            *p_buf,
+                                         FS_ERR            *p_err);
+
+static  void  FS_FAT_VolCleanSet        (FS_VOL            *p_vol);         /* Wr FSINFO & set FAT32 clean shutdown bit.    */
+#endif
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+static  FS_FAT_CLUS_NBR  FS_FAT_ClusFreeRunFind (FS_VOL           *p_vol,   /* Find free clus using free clus map.          */
+                                                 FS_BUF           *p_buf,
+                                                 FS_FAT_CLUS_NBR   clus_hint,
+                                                 FS_FAT_CLUS_NBR   clus_cnt,
+                                                 FS_ERR           *p_err);
+
+static  void             FS_FAT_FreeMapLoad     (FS_VOL           *p_vol,   /* Load free clus map win.                      */
+                                                 FS_BUF           *p_buf,
+                                                 FS_FAT_CLUS_NBR   win_start,
+                                                 FS_ERR           *p_err);
+
+static  FS_FAT_CLUS_NBR  FS_FAT_FreeMapSrch     (FS_FAT_DATA      *p_fat_data,  /* Srch free clus map win.              */
+                                                 FS_FAT_CLUS_NBR   bit_start,
+                                                 FS_FAT_CLUS_NBR   run_len);
+#endif
+#endif
+
+static  void  FS_FAT_DirEntryFind       (FS_VOL            *p_vol,          /* Find entry in dir.                           */
+                                         FS_BUF            *p_buf,
+                                         CPU_CHAR          *name,
+                                         CPU_CHAR         **p_name_next,
+                                         FS_FAT_DIR_POS    *p_dir_start_pos,
+                                         FS_FAT_DIR_POS    *p_dir_end_pos,
+                                         FS_ERR            *p_err);
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+static  FS_FAT_DIR_HASH  *FS_FAT_DirHashFind    (FS_FAT_DATA      *p_fat_data,  /* Find dir name hash index.            */
+                                                 FS_FAT_SEC_NBR    dir_first_sec);
+
+static  FS_FAT_DIR_HASH  *FS_FAT_DirHashGet     (FS_VOL           *p_vol,   /* Get or build dir name hash index.            */
+                                                 FS_BUF           *p_buf,
+                                                 FS_FAT_SEC_NBR    dir_first_sec);
+
+static  void              FS_FAT_DirHashBuild   (FS_VOL           *p_vol,   /* Build dir name hash index.                   */
+                                                 FS_BUF           *p_buf,
+                                                 FS_FAT_DIR_HASH  *p_dir_hash,
+                                                 FS_ERR           *p_err);
+
+static  void              FS_FAT_DirHashSlotAdd (FS_FAT_DIR_HASH  *p_dir_hash,  /* Add slot to dir name hash index.     */
+                                                 CPU_INT32U        hash,
+                                                 FS_FAT_DIR_POS   *p_dir_pos);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void              FS_FAT_DirHashEntryAdd(FS_VOL           *p_vol,   /* Add entry to dir name hash index.            */
+                                                 FS_BUF           *p_buf,
+                                                 FS_FAT_SEC_NBR    dir_first_sec,
+                                                 FS_FAT_DIR_POS   *p_dir_start_pos);
+
+static  void              FS_FAT_DirHashEntryRem(FS_VOL           *p_vol,   /* Rem entry from dir name hash index.          */
+                                                 FS_FAT_SEC_NBR    dir_first_sec,
+                                                 FS_FAT_DIR_POS   *p_dir_start_pos);
+
+static  void              FS_FAT_DirHashDirRem  (FS_VOL           *p_vol,   /* Rem dir name hash index of deleted dir.      */
+                                                 FS_FAT_SEC_NBR    dir_first_sec);
+#endif
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -653,6 +735,85 @@ void  FS_FAT_VolChk (CPU_CHAR  *name_vol,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                       FS_FAT_VolFreeCntScan()
+*
+* Description : Scan part of the FAT of a volume to count its free clusters.
+*
+* Argument(s) : name_vol    Volume name.
+*
+*               clus_cnt    Maximum number of FAT entries to read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              Entries scanned.
+*                               FS_ERR_NAME_NULL         Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_VOL_NOT_OPEN      Volume not open.
+*                               FS_ERR_VOL_NOT_MOUNTED   Volume not mounted.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffers available.
+*                               FS_ERR_DEV               Device error.
+*
+* Return(s)   : DEF_YES, if the free cluster count is known.
+*
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) The free cluster count of a FAT32 volume is taken from its FSINFO sector when the
+*                   volume was cleanly unmounted; otherwise, or for a FAT12/16 volume, it is unknown until
+*                   the whole FAT has been read.  'FSVol_Query()' reads the rest of the FAT at once.
+*
+*               (2) A low-priority application task may instead call this function repeatedly, until it
+*                   returns DEF_YES, to count the free clusters in the background.  The volume lock is only
+*                   held during each call, so that file accesses proceed between calls.  Allocations &
+*                   deletions in the part of the FAT already scanned update the partial count.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  FS_FAT_VolFreeCntScan (CPU_CHAR         *name_vol,
+                                    FS_FAT_CLUS_NBR   clus_cnt,
+                                    FS_ERR           *p_err)
+{
+    FS_BUF       *p_buf;
+    FS_VOL       *p_vol;
+    CPU_BOOLEAN   done;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(DEF_NO);
+    }
+    if (name_vol == (CPU_CHAR *)0) {                            /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return (DEF_NO);
+    }
+#endif
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);
+    (void)p_err;                                               /* Err ignored. Ret val chk'd instead.                  */
+    if (p_vol == (FS_VOL *)0) {
+        return (DEF_NO);
+    }
+
+    p_buf = FSBuf_Get(p_vol);                                   /* Get buf.                                             */
+    if (p_buf == (FS_BUF *)0) {
+        FSVol_ReleaseUnlock(p_vol);
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return (DEF_NO);
+    }
+
+                                                                /* --------------------- SCAN FAT --------------------- */
+    done = FS_FAT_QueryScan(p_vol,                              /* See Note #2.                                         */
+                            p_buf,
+                            clus_cnt,
+                            p_err);
+
+    FSBuf_Free(p_buf);
+    FSVol_ReleaseUnlock(p_vol);
+
+    return (done);
+}
+
+
 /*
 *********************************************************************************************************
 *                                       FS_FAT_ClusChainAlloc()
@@ -693,6 +854,16 @@ void  FS_FAT_VolChk (CPU_CHAR  *name_vol,
 *
 * Note(s)     : (1) Uncompleted allocations are rewinded using reverse deletion. By doing so, we make sure
 *                   deletion can always be completed after a potential failure (even without journaling).
+*
+*               (2) With the free cluster map, a new chain starts at a run of free clusters long enough
+*                   for the whole allocation, if one is found, & a chain continues with the cluster that
+*                   follows its last cluster, if free (see 'FS_FAT_ClusFreeRunFind()  Note #1').
+*
+*               (3) (a) A FAT32 volume is marked dirty before its FAT is first changed (see
+*                       'FS_FAT_VolDirtySet()  Note #1').
+*
+*                   (b) The query info is updated as each cluster is linked into the chain, so that a rewound
+*                       allocation leaves the free cluster count unchanged.
 *********************************************************************************************************
 */
 
@@ -722,17 +893,31 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainAlloc (FS_VOL           *p_vol,
         return (start_clus);                                    /* ... ret successfully.                                */
     }
 
+    FS_FAT_VolDirtySet(p_vol, p_buf, p_err);                    /* Mark vol dirty (see Note #3a).                       */
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
                                                                 /* ----------------- FIND START CLUS ------------------ */
     if (start_clus == 0u) {                                     /* If new chain, find start clus.                       */
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+        start_clus = FS_FAT_ClusFreeRunFind(p_vol,              /* See Note #2.                                         */
+                                            p_buf,
+                                            p_fat_data->NextClusNbr,
+                                            nbr_clus,
+                                            p_err);
+#else
         start_clus = FS_FAT_ClusFreeFind(p_vol,
                                          p_buf,
                                          p_err);
+#endif
         if (*p_err != FS_ERR_NONE) {
             return (0u);
         }
 
         is_new_chain = DEF_YES;
         rem_clus--;
+        FS_FAT_QueryInfoUpd(p_fat_data, start_clus, DEF_NO);
         FS_TRACE_LOG(("FS_FAT_ClusChainAlloc(): The new chain will start with cluster (%08X).\r\n", start_clus));
     }
 
@@ -792,9 +977,17 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainAlloc (FS_VOL           *p_vol,
     cur_clus = start_clus;
     while (rem_clus > 0u) {
 
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+        next_clus = FS_FAT_ClusFreeRunFind(p_vol,               /* Find next clus in chain (see Note #2).               */
+                                           p_buf,
+                                           cur_clus + 1u,
+                                           rem_clus,
+                                           p_err);
+#else
         next_clus = FS_FAT_ClusFreeFind(p_vol,                  /* Find next clus in chain.                             */
                                         p_buf,
                                         p_err);
+#endif
 
                                                                 /* ------- REWIND ALLOC IF NO MORE FREE CLUS'S -------- */
         if (next_clus == cur_clus) {
@@ -825,6 +1018,7 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainAlloc (FS_VOL           *p_vol,
         if (*p_err != FS_ERR_NONE) {
             return (0u);
         }
+        FS_FAT_QueryInfoUpd(p_fat_data, next_clus, DEF_NO);
 
         cur_clus = next_clus;
         rem_clus--;
@@ -843,9 +1037,6 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainAlloc (FS_VOL           *p_vol,
                                                                 /* ------------------- UPDATE & RTN ------------------- */
     FS_TRACE_LOG(("FS_FAT_ClusChainAlloc(): New clus chain alloc'd: %d clusters allocated from start clus %d.\r\n", nbr_clus, start_clus));
     FS_CTR_STAT_INC(p_fat_data->StatAllocClusCtr);
-    if (p_fat_data->QueryInfoValid == DEF_YES) {                /* Update query info.                                   */
-        p_fat_data->QueryFreeClusCnt -= nbr_clus;
-    }
 
    *p_err = FS_ERR_NONE;
     return (start_clus);
@@ -931,6 +1122,18 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainDel (FS_VOL           *p_vol,
     }
 #endif
 
+    FS_FAT_VolDirtySet(p_vol, p_buf, p_err);                    /* Mark vol dirty.                                      */
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+    if (del_first == DEF_YES) {                                 /* If clus chain may be a deleted dir's ...             */
+        FS_FAT_DirHashDirRem(p_vol,                             /* ... discard dir's index.                             */
+                             FS_FAT_CLUS_TO_SEC(p_fat_data, start_clus));
+    }
+#endif
+
                                                                 /* ------------------ JOURNAL ENTER ------------------- */
 #ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
     if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_REPLAY) == DEF_NO) {
@@ -990,9 +1193,7 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainDel (FS_VOL           *p_vol,
                 return (0u);
             }
 
-            if (p_fat_data->QueryInfoValid == DEF_YES) {
-                p_fat_data->QueryFreeClusCnt++;
-            }
+            FS_FAT_QueryInfoUpd(p_fat_data, cur_clus, DEF_YES);
 
             FS_CTR_STAT_INC(p_fat_data->StatFreeClusCtr);
             clus_cnt++;                                         /* Inc del clus cnt.                                    */
@@ -1093,6 +1294,11 @@ void  FS_FAT_ClusChainReverseDel (FS_VOL           *p_vol,
     }
 #endif
 
+    FS_FAT_VolDirtySet(p_vol, p_buf, p_err);                    /* Mark vol dirty.                                      */
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
                                                                 /* ------------------- FREE CLUS'S -------------------- */
     do {
                                                                 /* Find chain end.                                      */
@@ -1125,9 +1331,7 @@ void  FS_FAT_ClusChainReverseDel (FS_VOL           *p_vol,
                 return;
             }
 
-            if (p_fat_data->QueryInfoValid == DEF_YES) {
-                p_fat_data->QueryFreeClusCnt++;
-            }
+            FS_FAT_QueryInfoUpd(p_fat_data, cur_clus, DEF_YES);
 
             FS_CTR_STAT_INC(p_fat_data->StatFreeClusCtr);
 #if (FS_TRACE_LEVEL >= TRACE_LEVEL_LOG)
@@ -1437,6 +1641,9 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainReverseFollow (FS_VOL           *p_vol,
 * Note(s)     : (1) In order for journaling to behave as expected, FAT entry updates must be atomic.
 *                   To ensure this is the case when using FAT12, cross-boundary FAT entries must be
 *                   avoided.
+*
+*               (2) See 'FS_FAT_QueryScan()  Note #2'.  Entries are read up to the end of the FAT, where
+*                   the search wraps, & no further than the number of clusters left to check.
 *********************************************************************************************************
 */
 
@@ -1446,7 +1653,9 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusFreeFind (FS_VOL  *p_vol,
                                       FS_ERR  *p_err)
 {
     FS_FAT_DATA      *p_fat_data;
-    FS_FAT_CLUS_NBR   fat_entry;
+    FS_FAT_CLUS_NBR   fat_entry_tbl[FS_FAT_CLUS_VAL_TBL_SIZE];
+    FS_FAT_CLUS_NBR   rd_cnt;
+    FS_FAT_CLUS_NBR   ix;
     FS_FAT_CLUS_NBR   next_clus;
     FS_FAT_CLUS_NBR   clus_cnt_chkd;
     FS_FAT_CLUS_NBR   max_nbr_clus;
@@ -1470,40 +1679,45 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusFreeFind (FS_VOL  *p_vol,
         }
 
 
-                                                                /* Rd next FAT entry.                                   */
-        fat_entry = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol,
+                                                                /* Rd next FAT entries (see Note #2).                   */
+        rd_cnt = DEF_MIN(p_fat_data->MaxClusNbr - next_clus, max_nbr_clus - clus_cnt_chkd);
+        rd_cnt = p_fat_data->FAT_TypeAPI_Ptr->ClusValRdSec(p_vol,
                                                            p_buf,
                                                            next_clus,
+                                                           DEF_MIN(rd_cnt, FS_FAT_CLUS_VAL_TBL_SIZE),
+                                                          &fat_entry_tbl[0],
                                                            p_err);
         if (*p_err != FS_ERR_NONE) {
             return (0u);
         }
 
 
+        for (ix = 0u; ix < rd_cnt; ix++) {
                                                                 /* ----------------- FREE CLUS FOUND ------------------ */
-        if (fat_entry == p_fat_data->FAT_TypeAPI_Ptr->ClusFree) {   /* Chk if free clus found.                          */
-            clus_ignore = DEF_NO;                                   /* Clus not ignore'd by dflt.                       */
+            if (fat_entry_tbl[ix] == p_fat_data->FAT_TypeAPI_Ptr->ClusFree) {  /* Chk if free clus found.               */
+                clus_ignore = DEF_NO;                           /* Clus not ignore'd by dflt.                           */
 #if ((FS_FAT_CFG_FAT12_EN == DEF_ENABLED) && (FS_FAT_CFG_JOURNAL_EN == DEF_ENABLED))
-            if ((p_fat_data->FAT_Type     == 12u) &&                /* If FAT12 and journal started ...                 */
-                (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START) == DEF_YES)) {
-                fat_offset     = (FS_SEC_SIZE)next_clus + ((FS_SEC_SIZE)next_clus / 2u);
-                fat_sec_offset =  fat_offset & (p_fat_data->SecSize - 1u);
-                if (fat_sec_offset == p_fat_data->SecSize - 1u) {  /* ... avoid sec boundary (see Note #1) ...          */
-                    FS_TRACE_LOG(("FS_FAT_ClusFreeFind(): Sec boundary clus avoided: %d.\r\n", next_clus));
-                    clus_ignore = DEF_YES;
+                if ((p_fat_data->FAT_Type     == 12u) &&            /* If FAT12 and journal started ...                 */
+                    (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START) == DEF_YES)) {
+                    fat_offset     = (FS_SEC_SIZE)next_clus + ((FS_SEC_SIZE)next_clus / 2u);
+                    fat_sec_offset =  fat_offset & (p_fat_data->SecSize - 1u);
+                    if (fat_sec_offset == p_fat_data->SecSize - 1u) {  /* ... avoid sec boundary (see Note #1) ...      */
+                        FS_TRACE_LOG(("FS_FAT_ClusFreeFind(): Sec boundary clus avoided: %d.\r\n", next_clus));
+                        clus_ignore = DEF_YES;
+                    }
                 }
-            }
 #endif
-            if (clus_ignore == DEF_NO) {
-                p_fat_data->NextClusNbr = next_clus + 1u;       /* ... else store next clus ...                         */
-                FS_TRACE_LOG(("FS_FAT_ClusFreeFind(): New FAT clus alloc'd: %d.\r\n", next_clus));
-               *p_err = FS_ERR_NONE;
-                return (next_clus);                             /*                           ... and rtn clus.          */
+                if (clus_ignore == DEF_NO) {
+                    p_fat_data->NextClusNbr = next_clus + 1u;   /* ... else store next clus ...                         */
+                    FS_TRACE_LOG(("FS_FAT_ClusFreeFind(): New FAT clus alloc'd: %d.\r\n", next_clus));
+                   *p_err = FS_ERR_NONE;
+                    return (next_clus);                         /*                           ... and rtn clus.          */
+                }
             }
-        }
 
-        next_clus++;
-        clus_cnt_chkd++;
+            next_clus++;
+            clus_cnt_chkd++;
+        }
     }
 
 
@@ -1515,6 +1729,65 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusFreeFind (FS_VOL  *p_vol,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                     FS_FAT_ClusFreeMapUpdate()
+*
+* Description : Update free cluster map for a FAT entry write.
+*
+* Argument(s) : p_fat_data  Pointer to FAT info.
+*               ----------  Argument validated by caller.
+*
+*               clus        Cluster whose FAT entry is written.
+*
+*               val         Value written into FAT entry.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FAT type API ClusValWr() functions.
+*
+* Note(s)     : (1) Every FAT entry write goes through the FAT type API, so that the map follows cluster
+*                   allocation, deletion & journal replay alike.  Clusters outside the map's window are
+*                   ignored; they are read from the FAT when the window is moved.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+void  FS_FAT_ClusFreeMapUpdate (FS_FAT_DATA      *p_fat_data,
+                                FS_FAT_CLUS_NBR   clus,
+                                FS_FAT_CLUS_NBR   val)
+{
+    FS_FAT_CLUS_NBR   bit;
+    CPU_INT32U        mask;
+    CPU_INT32U       *p_word;
+
+
+    if ((clus <  p_fat_data->FreeMapStart) ||                   /* See Note #1.                                         */
+        (clus >= p_fat_data->FreeMapStart + p_fat_data->FreeMapCnt)) {
+        return;
+    }
+
+    bit    =   clus - p_fat_data->FreeMapStart;
+    p_word = &(p_fat_data->FreeMap[bit >> 5]);
+    mask   =  (CPU_INT32U)1u << (bit & 31u);
+
+    if (val == p_fat_data->FAT_TypeAPI_Ptr->ClusFree) {        /* Clus free'd ...                                      */
+        if (DEF_BIT_IS_SET(*p_word, mask) == DEF_YES) {
+            DEF_BIT_CLR(*p_word, mask);
+            p_fat_data->FreeMapFreeCnt++;
+        }
+    } else {                                                    /* ... or alloc'd.                                      */
+        if (DEF_BIT_IS_CLR(*p_word, mask) == DEF_YES) {
+            DEF_BIT_SET(*p_word, mask);
+            p_fat_data->FreeMapFreeCnt--;
+        }
+    }
+}
+#endif
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                       FS_FAT_ClusNextGet()
@@ -1825,7 +2098,9 @@ FS_FAT_SEC_NBR  FS_FAT_SecNextGetAlloc (FS_VOL          *p_vol,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The counts are cached once the FAT has been scanned, or read from FSINFO at mount (see
+*                   'FS_FAT_VolStateRd()  Note #1').  A scan already started by 'FS_FAT_VolFreeCntScan()'
+*                   is resumed rather than restarted.
 *********************************************************************************************************
 */
 
@@ -1834,10 +2109,6 @@ void  FS_FAT_Query (FS_VOL       *p_vol,
                     FS_SYS_INFO  *p_info,
                     FS_ERR       *p_err)
 {
-    FS_FAT_CLUS_NBR   bad_clus_cnt;
-    FS_FAT_CLUS_NBR   clus;
-    FS_FAT_CLUS_NBR   fat_entry;
-    FS_FAT_CLUS_NBR   free_clus_cnt;
     FS_FAT_CLUS_NBR   used_clus_cnt;
     FS_FAT_DATA      *p_fat_data;
 
@@ -1851,67 +2122,131 @@ void  FS_FAT_Query (FS_VOL       *p_vol,
 
 
 
-                                                                /* ----------------- CHK IF INFO CACHED --------------- */
-    if (p_fat_data->QueryInfoValid == DEF_YES) {
-        p_info->BadSecCnt  = (FS_SEC_QTY)FS_UTIL_MULT_PWR2(p_fat_data->QueryBadClusCnt,  p_fat_data->ClusSizeLog2_sec);
-        p_info->FreeSecCnt = (FS_SEC_QTY)FS_UTIL_MULT_PWR2(p_fat_data->QueryFreeClusCnt, p_fat_data->ClusSizeLog2_sec);
-
-        if (p_fat_data->MaxClusNbr >= (FS_FAT_MIN_CLUS_NBR + p_fat_data->QueryBadClusCnt + p_fat_data->QueryFreeClusCnt)) {
-            used_clus_cnt = ((p_fat_data->MaxClusNbr - FS_FAT_MIN_CLUS_NBR) - p_fat_data->QueryBadClusCnt) - p_fat_data->QueryFreeClusCnt;
-        } else {
-            used_clus_cnt = 0u;
+                                                                /* ---------- CNT NBR OF BAD/FREE/USED CLUS'S --------- */
+    if (p_fat_data->QueryInfoValid == DEF_NO) {                 /* If info not cached, finish FAT scan (see Note #1).   */
+       (void)FS_FAT_QueryScan(p_vol,
+                              p_buf,
+                              p_fat_data->MaxClusNbr,
+                              p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
         }
+    }
 
-        p_info->UsedSecCnt = (FS_SEC_QTY)FS_UTIL_MULT_PWR2(used_clus_cnt, p_fat_data->ClusSizeLog2_sec);
-        p_info->TotSecCnt  =  p_info->BadSecCnt + p_info->FreeSecCnt + p_info->UsedSecCnt;
 
-       *p_err = FS_ERR_NONE;
-        return;
+
+                                                                /* ------------------ CALC SEC CNT'S ------------------ */
+    p_info->BadSecCnt  = (FS_SEC_QTY)FS_UTIL_MULT_PWR2(p_fat_data->QueryBadClusCnt,  p_fat_data->ClusSizeLog2_sec);
+    p_info->FreeSecCnt = (FS_SEC_QTY)FS_UTIL_MULT_PWR2(p_fat_data->QueryFreeClusCnt, p_fat_data->ClusSizeLog2_sec);
+
+    if (p_fat_data->MaxClusNbr >= (FS_FAT_MIN_CLUS_NBR + p_fat_data->QueryBadClusCnt + p_fat_data->QueryFreeClusCnt)) {
+        used_clus_cnt = ((p_fat_data->MaxClusNbr - FS_FAT_MIN_CLUS_NBR) - p_fat_data->QueryBadClusCnt) - p_fat_data->QueryFreeClusCnt;
+    } else {
+        used_clus_cnt = 0u;
     }
 
+    p_info->UsedSecCnt = (FS_SEC_QTY)FS_UTIL_MULT_PWR2(used_clus_cnt, p_fat_data->ClusSizeLog2_sec);
+    p_info->TotSecCnt  =  p_info->BadSecCnt + p_info->FreeSecCnt + p_info->UsedSecCnt;
 
+   *p_err = FS_ERR_NONE;
+}
 
-                                                                /* ---------- CNT NBR OF BAD/FREE/USED CLUS'S --------- */
-    free_clus_cnt = 0u;
-    used_clus_cnt = 0u;
-    bad_clus_cnt  = 0u;
-    clus          = 2u;
-    while (clus < p_fat_data->MaxClusNbr) {
-        fat_entry = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol,
-                                                           p_buf,
-                                                           clus,
-                                                           p_err);
-        if (*p_err != FS_ERR_NONE) {
-            return;
-        }
 
-        if (fat_entry == p_fat_data->FAT_TypeAPI_Ptr->ClusBad) {
-            bad_clus_cnt++;
+/*
+*********************************************************************************************************
+*                                         FS_FAT_DirHashClr()
+*
+* Description : Clear directory name hash indexes of volume.
+*
+* Argument(s) : p_fat_data  Pointer to FAT info.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Called whenever directory entries may have changed without the indexes being updated,
+*                   e.g., after the journal is replayed.
+*********************************************************************************************************
+*/
 
-        } else if (fat_entry == p_fat_data->FAT_TypeAPI_Ptr->ClusFree) {
-            free_clus_cnt++;
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+void  FS_FAT_DirHashClr (FS_FAT_DATA  *p_fat_data)
+{
+    FS_FAT_DIR_HASH  *p_dir_hash;
+    CPU_SIZE_T        ix;
 
-        } else {
-            used_clus_cnt++;
-        }
 
-        clus++;
+    for (ix = 0u; ix < FS_FAT_CFG_DIR_HASH_NBR; ix++) {
+        p_dir_hash              = &p_fat_data->DirHashTbl[ix];
+        p_dir_hash->DirFirstSec =  0u;
+        p_dir_hash->UseCtr      =  0u;
+        p_dir_hash->SlotCnt     =  0u;
+        p_dir_hash->Full        =  DEF_NO;
     }
+    p_fat_data->DirHashUseCtr = 0u;
+}
+#endif
 
 
+/*
+*********************************************************************************************************
+*                                        FS_FAT_DirHashSrch()
+*
+* Description : Search name hash index of directory for a hash.
+*
+* Argument(s) : p_vol           Pointer to volume.
+*               ----------      Argument validated by caller.
+*
+*               dir_first_sec   First sector of the directory.
+*
+*               hash            Name hash.
+*
+*               p_found         Pointer to variable that will receive whether an entry has the hash :
+*               ----------      Argument validated by caller.
+*
+*                                   DEF_NO,  no entry of the directory has the hash.
+*                                   DEF_YES, an entry of the directory MAY have the hash.
+*
+* Return(s)   : DEF_YES, if the directory is indexed ('p_found' set);
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) The index is NOT built : a directory that is not indexed must be searched.
+*********************************************************************************************************
+*/
 
-                                                                /* ------------------ CALC SEC CNT'S ------------------ */
-    p_fat_data->QueryInfoValid   =  DEF_YES;
-    p_fat_data->QueryBadClusCnt  =  bad_clus_cnt;
-    p_fat_data->QueryFreeClusCnt =  free_clus_cnt;
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+CPU_BOOLEAN  FS_FAT_DirHashSrch (FS_VOL          *p_vol,
+                                 FS_FAT_SEC_NBR   dir_first_sec,
+                                 CPU_INT32U       hash,
+                                 CPU_BOOLEAN     *p_found)
+{
+    FS_FAT_DIR_HASH       *p_dir_hash;
+    FS_FAT_DIR_HASH_SLOT  *p_slot;
+    CPU_INT32U             slot_ix;
 
-    p_info->BadSecCnt            = (FS_SEC_QTY)FS_UTIL_MULT_PWR2(bad_clus_cnt,  p_fat_data->ClusSizeLog2_sec);
-    p_info->FreeSecCnt           = (FS_SEC_QTY)FS_UTIL_MULT_PWR2(free_clus_cnt, p_fat_data->ClusSizeLog2_sec);
-    p_info->UsedSecCnt           = (FS_SEC_QTY)FS_UTIL_MULT_PWR2(used_clus_cnt, p_fat_data->ClusSizeLog2_sec);
-    p_info->TotSecCnt            =  p_info->BadSecCnt + p_info->FreeSecCnt + p_info->UsedSecCnt;
 
-   *p_err = FS_ERR_NONE;
+   *p_found    =  DEF_NO;
+    p_dir_hash =  FS_FAT_DirHashFind((FS_FAT_DATA *)p_vol->DataPtr, dir_first_sec);
+    if (p_dir_hash == (FS_FAT_DIR_HASH *)0) {                   /* See Note #1.                                         */
+        return (DEF_NO);
+    }
+    if (p_dir_hash->Full == DEF_YES) {
+        return (DEF_NO);
+    }
+
+    slot_ix =  hash & (FS_FAT_CFG_DIR_HASH_SIZE - 1u);
+    p_slot  = &p_dir_hash->SlotTbl[slot_ix];
+    while (p_slot->Pos.SecNbr != 0u) {
+        if (p_slot->Hash == hash) {
+           *p_found = DEF_YES;
+            break;
+        }
+        slot_ix = (slot_ix + 1u) & (FS_FAT_CFG_DIR_HASH_SIZE - 1u);
+        p_slot  = &p_dir_hash->SlotTbl[slot_ix];
+    }
+
+    return (DEF_YES);
 }
+#endif
 
 
 /*
@@ -2153,6 +2488,13 @@ void  FS_FAT_ModuleInit (FS_QTY   vol_cnt,
 * Return(s)   : none.
 *
 * Note(s)     : (1) The file system lock MUST be held to release the FAT data back to the FAT data pool.
+*
+*               (2) A FAT32 volume changed since mount gets its FSINFO sector updated & is marked clean (see
+*                   'FS_FAT_VolCleanSet()').
+*
+*               (3) Journaled operations not yet committed are committed before the volume is marked clean
+*                   (see 'fs_fat_journal.c  FS_FAT_JournalClrReset() Note #2'), unless the volume is no
+*                   longer mounted on the same media.
 *********************************************************************************************************
 */
 
@@ -2163,6 +2505,18 @@ void  FS_FAT_VolClose (FS_VOL  *p_vol)
     LIB_ERR       pool_err;
 
 
+#ifdef  FS_FAT_JOURNAL_MODULE_PRESENT                           /* ---------------- COMMIT JOURNAL OPS ---------------- */
+    if ((p_vol->State      == FS_VOL_STATE_MOUNTED) &&          /* See Note #3.                                         */
+        (p_vol->RefreshCnt == p_vol->DevPtr->RefreshCnt)) {
+        FS_FAT_JournalSync(p_vol, &err);
+    }
+#endif
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)                         /* ------------------- MARK VOL CLEAN ----------------- */
+    FS_FAT_VolCleanSet(p_vol);                                  /* See Note #2.                                         */
+#endif
+
+
                                                                 /* ----------------- FREE JOURNAL DATA ---------------- */
 #ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
     FS_FAT_JournalExit(p_vol, &err);                            /* Free journal data.                                   */
@@ -3017,6 +3371,10 @@ void  FS_FAT_VolLabelSet (FS_VOL    *p_vol,
     FS_FAT_SFN_LabelSet(p_vol,
                         label_buf,
                         p_err);
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+    FS_FAT_DirHashClr((FS_FAT_DATA *)p_vol->DataPtr);           /* Label entry may have been created in root dir.       */
+#endif
 }
 #endif
 
@@ -3041,6 +3399,10 @@ void  FS_FAT_VolLabelSet (FS_VOL    *p_vol,
 * Return(s)   : none.
 *
 * Note(s)     : (1) The file system lock MUST be held to get the FAT data from the FAT data pool.
+*
+*               (2) The free cluster count of a cleanly unmounted FAT32 volume is read from its FSINFO
+*                   sector rather than counted by scanning the whole FAT.  The volume state is read before
+*                   the journal is replayed, so that replayed changes mark the volume dirty.
 *********************************************************************************************************
 */
 
@@ -3128,6 +3490,8 @@ void  FS_FAT_VolOpen (FS_VOL  *p_vol,
                                                                 /* ------------------ ALLOC FAT DATA ------------------ */
     p_vol->DataPtr = (void *)p_fat_data;                        /* Save FAT data in vol.                                */
 
+    FS_FAT_VolStateRd(p_vol);                                   /* Rd FSINFO, if vol clean (see Note #2).               */
+
 #ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
     FS_FAT_JournalInit(p_vol, p_err);                           /* Init journal info.                                   */
 
@@ -4259,6 +4623,13 @@ void  FS_FAT_LowEntryCreate (FS_VOL            *p_vol,
      p_entry_data->DirEndSec      = dir_end_pos.SecNbr;
      p_entry_data->DirEndSecPos   = dir_end_pos.SecPos;
 
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+     FS_FAT_DirHashEntryAdd( p_vol,                             /* Add entry to dir index.                              */
+                             p_buf,
+                             dir_first_sec,
+                            &dir_start_pos);
+#endif
+
 #if (FS_TRACE_LEVEL >= TRACE_LEVEL_LOG)
      if (is_dir == DEF_YES) {
          FS_TRACE_LOG(("FS_FAT_LowEntryCreate(): Created directory %s\r\n", name_entry));
@@ -4336,6 +4707,14 @@ void  FS_FAT_LowEntryDel (FS_VOL            *p_vol,
         return;
     }
 
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+    dir_start_pos.SecNbr = p_entry_data->DirStartSec;           /* Rem entry from dir index.                            */
+    dir_start_pos.SecPos = p_entry_data->DirStartSecPos;
+    FS_FAT_DirHashEntryRem( p_vol,
+                            p_entry_data->DirFirstSec,
+                           &dir_start_pos);
+#endif
+
 
                                                                 /* ------------------- DEL CLUS CHAIN ----------------- */
     valid = FS_FAT_IS_VALID_CLUS(p_fat_data, p_entry_data->FileFirstClus);
@@ -4433,6 +4812,14 @@ void  FS_FAT_LowEntryRename (FS_VOL            *p_vol,
         if (*p_err != FS_ERR_NONE) {
             return;
         }
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+        dir_start_new.SecNbr = p_entry_data_new->DirStartSec;   /* Rem target entry from dir index.                     */
+        dir_start_new.SecPos = p_entry_data_new->DirStartSecPos;
+        FS_FAT_DirHashEntryRem( p_vol,
+                                p_entry_data_new->DirFirstSec,
+                               &dir_start_new);
+#endif
     } else {
         target_entry_first_clus = 0u;
     }
@@ -4489,6 +4876,14 @@ void  FS_FAT_LowEntryRename (FS_VOL            *p_vol,
         return;
     }
 
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+    dir_start_old.SecNbr = p_entry_data_old->DirStartSec;       /* Rem old entry from dir index.                        */
+    dir_start_old.SecPos = p_entry_data_old->DirStartSecPos;
+    FS_FAT_DirHashEntryRem( p_vol,
+                            p_entry_data_old->DirFirstSec,
+                           &dir_start_old);
+#endif
+
                                                                 /* --------- DEL TARGET CLUS CHAIN IF NEEDED ---------- */
                                                                 /* Clus chain del must be last operation (See Note #?)  */
     if (exists == DEF_YES) {
@@ -5946,13 +6341,13 @@ static  void  FS_FAT_DataSrch (FS_VOL          *p_vol,
         dir_start_pos.SecNbr = dir_first_sec;
         dir_start_pos.SecPos = 0u;
 
-        FS_FAT_FN_API_Active.DirEntryFind( p_vol,
-                                           p_buf,
-                                           name_entry,
-                                          &name_entry_next,
-                                          &dir_start_pos,
-                                          &dir_end_pos,
-                                           p_err);
+        FS_FAT_DirEntryFind( p_vol,
+                             p_buf,
+                             name_entry,
+                            &name_entry_next,
+                            &dir_start_pos,
+                            &dir_end_pos,
+                             p_err);
         if (*p_err != FS_ERR_NAME_INVALID) {
             name_entry = name_entry_next;
         }
@@ -6044,20 +6439,574 @@ static  void  FS_FAT_DataSrch (FS_VOL          *p_vol,
 
 /*
 *********************************************************************************************************
-*                                        FS_FAT_FileDataClr()
+*                                        FS_FAT_DirEntryFind()
 *
-* Description : Clear FAT file data structure
+* Description : Search directory for entry.
 *
-* Argument(s) : p_entry_data    Pointer to FAT entry data.
-*               ----------      Argument validated by caller.
+* Argument(s) : p_vol               Pointer to volume.
+*               ----------          Argument validated by caller.
 *
-* Return(s)   : none.
+*               p_buf               Pointer to temporary buffer.
+*               ----------          Argument validated by caller.
 *
-* Note(s)     : none.
-*********************************************************************************************************
-*/
-
-static  void  FS_FAT_FileDataClr (FS_FAT_FILE_DATA  *p_entry_data)
+*               name                Name of the entry.
+*               ----------          Argument validated by caller.
+*
+*               p_name_next         Pointer to variable that will receive pointer to character following
+*                                   entry name.
+*               ----------          Argument validated by caller.
+*
+*               p_dir_start_pos     Pointer to directory position at which search should start (the first
+*                                   sector of the directory); variable will receive the directory position
+*                                   at which the first entry is located.
+*               ----------          Argument validated by caller.
+*
+*               p_dir_end_pos       Pointer to variable that will receive the directory position at which
+*                                   the final entry is located.
+*               ----------          Argument validated by caller.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*               ----------          Argument validated by caller.
+*
+*                                       FS_ERR_NONE                       Directory entry found.
+*                                       FS_ERR_SYS_DIR_ENTRY_NOT_FOUND    Directory entry not found.
+*
+*                                                                         --- RETURNED BY DirEntryFind() ---
+*                                       FS_ERR_DEV                        Device access error.
+*                                       FS_ERR_NAME_INVALID               Invalid name.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) If the directory has a name hash index, only the entries whose names hash like 'name'
+*                   are compared with it, each by a search starting at the entry.  Since each name a
+*                   search matches has one of these hashes, an entry NOT in the index is NOT in the
+*                   directory : no sector need be read.
+*
+*               (2) Names that cannot be hashed (e.g., invalid names) are searched for without the index,
+*                   so that the same errors are returned.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_DirEntryFind (FS_VOL           *p_vol,
+                                   FS_BUF           *p_buf,
+                                   CPU_CHAR         *name,
+                                   CPU_CHAR        **p_name_next,
+                                   FS_FAT_DIR_POS   *p_dir_start_pos,
+                                   FS_FAT_DIR_POS   *p_dir_end_pos,
+                                   FS_ERR           *p_err)
+{
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+    FS_FAT_DIR_HASH       *p_dir_hash;
+    FS_FAT_DIR_HASH_SLOT  *p_slot;
+    FS_FAT_DIR_POS         dir_start_pos;
+    CPU_INT32U             hash_tbl[FS_FAT_DIR_HASH_NAME_MAX];
+    CPU_INT08U             hash_cnt;
+    CPU_INT08U             hash_ix;
+    CPU_INT32U             slot_ix;
+
+
+    p_dir_hash = FS_FAT_DirHashGet(p_vol,
+                                   p_buf,
+                                   p_dir_start_pos->SecNbr);
+    if (p_dir_hash != (FS_FAT_DIR_HASH *)0) {
+        hash_cnt = FS_FAT_FN_API_Active.NameHashGet( name,
+                                                     p_name_next,
+                                                    &hash_tbl[0],
+                                                     p_err);
+        if (*p_err == FS_ERR_NONE) {                            /* See Note #2.                                         */
+            for (hash_ix = 0u; hash_ix < hash_cnt; hash_ix++) { /* Srch from each entry with same hash (see Note #1).   */
+                slot_ix =  hash_tbl[hash_ix] & (FS_FAT_CFG_DIR_HASH_SIZE - 1u);
+                p_slot  = &p_dir_hash->SlotTbl[slot_ix];
+                while (p_slot->Pos.SecNbr != 0u) {
+                    if (p_slot->Hash == hash_tbl[hash_ix]) {
+                        dir_start_pos.SecNbr = p_slot->Pos.SecNbr;
+                        dir_start_pos.SecPos = p_slot->Pos.SecPos;
+                        FS_FAT_FN_API_Active.DirEntryFind( p_vol,
+                                                           p_buf,
+                                                           name,
+                                                           p_name_next,
+                                                          &dir_start_pos,
+                                                           p_dir_end_pos,
+                                                           p_err);
+                        if (*p_err != FS_ERR_SYS_DIR_ENTRY_NOT_FOUND) {
+                            p_dir_start_pos->SecNbr = dir_start_pos.SecNbr;
+                            p_dir_start_pos->SecPos = dir_start_pos.SecPos;
+                            return;
+                        }
+                    }
+                    slot_ix = (slot_ix + 1u) & (FS_FAT_CFG_DIR_HASH_SIZE - 1u);
+                    p_slot  = &p_dir_hash->SlotTbl[slot_ix];
+                }
+            }
+
+            p_dir_end_pos->SecNbr = 0u;                         /* Entry not in dir.                                    */
+            p_dir_end_pos->SecPos = 0u;
+           *p_err = FS_ERR_SYS_DIR_ENTRY_NOT_FOUND;
+            return;
+        }
+    }
+#endif
+
+    FS_FAT_FN_API_Active.DirEntryFind(p_vol,
+                                      p_buf,
+                                      name,
+                                      p_name_next,
+                                      p_dir_start_pos,
+                                      p_dir_end_pos,
+                                      p_err);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_DirHashFind()
+*
+* Description : Find name hash index of directory.
+*
+* Argument(s) : p_fat_data      Pointer to FAT info.
+*               ----------      Argument validated by caller.
+*
+*               dir_first_sec   First sector of the directory.
+*
+* Return(s)   : Pointer to directory name hash index, if found;
+*               NULL pointer,                          otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+static  FS_FAT_DIR_HASH  *FS_FAT_DirHashFind (FS_FAT_DATA     *p_fat_data,
+                                              FS_FAT_SEC_NBR   dir_first_sec)
+{
+    FS_FAT_DIR_HASH  *p_dir_hash;
+    CPU_SIZE_T        ix;
+
+
+    for (ix = 0u; ix < FS_FAT_CFG_DIR_HASH_NBR; ix++) {
+        p_dir_hash = &p_fat_data->DirHashTbl[ix];
+        if (p_dir_hash->DirFirstSec == dir_first_sec) {
+            return (p_dir_hash);
+        }
+    }
+
+    return ((FS_FAT_DIR_HASH *)0);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_DirHashGet()
+*
+* Description : Get name hash index of directory, building it if needed.
+*
+* Argument(s) : p_vol           Pointer to volume.
+*               ----------      Argument validated by caller.
+*
+*               p_buf           Pointer to temporary buffer.
+*               ----------      Argument validated by caller.
+*
+*               dir_first_sec   First sector of the directory.
+*
+* Return(s)   : Pointer to directory name hash index, if gotten;
+*               NULL pointer,                          otherwise.
+*
+* Note(s)     : (1) The index of the least recently searched directory is evicted to build the index.
+*
+*               (2) Neither an index that could not be built (e.g., because of a device error) nor the
+*                   index of a directory with too many entries is returned : the directory is searched
+*                   without the index, & any error is returned by that search.  The index of a directory
+*                   with too many entries is kept, so that the directory is not read again to build it.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+static  FS_FAT_DIR_HASH  *FS_FAT_DirHashGet (FS_VOL          *p_vol,
+                                             FS_BUF          *p_buf,
+                                             FS_FAT_SEC_NBR   dir_first_sec)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_DIR_HASH  *p_dir_hash;
+    FS_FAT_DIR_HASH  *p_dir_hash_lru;
+    CPU_INT32U        age;
+    CPU_INT32U        age_max;
+    CPU_SIZE_T        ix;
+    FS_ERR            err;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_fat_data->DirHashUseCtr++;
+
+    p_dir_hash = FS_FAT_DirHashFind(p_fat_data, dir_first_sec);
+    if (p_dir_hash == (FS_FAT_DIR_HASH *)0) {
+                                                                /* ------------------ EVICT LRU INDEX ----------------- */
+        p_dir_hash_lru = &p_fat_data->DirHashTbl[0];            /* See Note #1.                                         */
+        age_max        =  0u;
+        for (ix = 0u; ix < FS_FAT_CFG_DIR_HASH_NBR; ix++) {
+            p_dir_hash = &p_fat_data->DirHashTbl[ix];
+            if (p_dir_hash->DirFirstSec == 0u) {                /* Unused index.                                        */
+                p_dir_hash_lru = p_dir_hash;
+                break;
+            }
+            age = p_fat_data->DirHashUseCtr - p_dir_hash->UseCtr;
+            if (age > age_max) {
+                age_max        = age;
+                p_dir_hash_lru = p_dir_hash;
+            }
+        }
+
+                                                                /* -------------------- BUILD INDEX ------------------- */
+        p_dir_hash              = p_dir_hash_lru;
+        p_dir_hash->DirFirstSec = dir_first_sec;
+        FS_FAT_DirHashBuild(p_vol,
+                            p_buf,
+                            p_dir_hash,
+                           &err);
+        if (err != FS_ERR_NONE) {                               /* See Note #2.                                         */
+            p_dir_hash->DirFirstSec = 0u;
+            return ((FS_FAT_DIR_HASH *)0);
+        }
+    }
+
+    p_dir_hash->UseCtr = p_fat_data->DirHashUseCtr;
+    if (p_dir_hash->Full == DEF_YES) {                          /* See Note #2.                                         */
+        return ((FS_FAT_DIR_HASH *)0);
+    }
+
+    return (p_dir_hash);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_DirHashBuild()
+*
+* Description : Build name hash index of directory.
+*
+* Argument(s) : p_vol           Pointer to volume.
+*               ----------      Argument validated by caller.
+*
+*               p_buf           Pointer to temporary buffer.
+*               ----------      Argument validated by caller.
+*
+*               p_dir_hash      Pointer to directory name hash index, with first sector of the directory set.
+*               ----------      Argument validated by caller.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*               ----------      Argument validated by caller.
+*
+*                                   FS_ERR_NONE    Index built (or directory found to have too many entries).
+*
+*                                                  ----- RETURNED BY NextDirEntryHash() -----
+*                                   FS_ERR_DEV     Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Building stops once the directory is found to have too many entries to be indexed.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+static  void  FS_FAT_DirHashBuild (FS_VOL           *p_vol,
+                                   FS_BUF           *p_buf,
+                                   FS_FAT_DIR_HASH  *p_dir_hash,
+                                   FS_ERR           *p_err)
+{
+    FS_FAT_DIR_POS  dir_start_pos;
+    FS_FAT_DIR_POS  dir_end_pos;
+    CPU_INT32U      hash_tbl[FS_FAT_DIR_HASH_NAME_MAX];
+    CPU_INT08U      hash_cnt;
+    CPU_INT08U      hash_ix;
+
+
+    Mem_Clr((void *)&p_dir_hash->SlotTbl[0],
+                     sizeof(p_dir_hash->SlotTbl));
+    p_dir_hash->SlotCnt  = 0u;
+    p_dir_hash->Full     = DEF_NO;
+
+    dir_start_pos.SecNbr = p_dir_hash->DirFirstSec;
+    dir_start_pos.SecPos = 0u;
+
+    while (p_dir_hash->Full == DEF_NO) {                        /* See Note #1.                                         */
+        hash_cnt = FS_FAT_FN_API_Active.NextDirEntryHash( p_vol,
+                                                          p_buf,
+                                                         &hash_tbl[0],
+                                                         &dir_start_pos,
+                                                         &dir_end_pos,
+                                                          p_err);
+        if (*p_err == FS_ERR_EOF) {                             /* All entries indexed.                                 */
+           *p_err = FS_ERR_NONE;
+            return;
+        }
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+
+        for (hash_ix = 0u; hash_ix < hash_cnt; hash_ix++) {
+            FS_FAT_DirHashSlotAdd( p_dir_hash,
+                                   hash_tbl[hash_ix],
+                                  &dir_start_pos);
+        }
+
+        dir_start_pos.SecNbr = dir_end_pos.SecNbr;
+        dir_start_pos.SecPos = dir_end_pos.SecPos + FS_FAT_SIZE_DIR_ENTRY;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_FAT_DirHashSlotAdd()
+*
+* Description : Add slot to name hash index of directory.
+*
+* Argument(s) : p_dir_hash      Pointer to directory name hash index.
+*               ----------      Argument validated by caller.
+*
+*               hash            Name hash.
+*
+*               p_dir_pos       Pointer to directory position of the entry's first directory entry.
+*               ----------      Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) An index whose used slots would exceed FS_FAT_DIR_HASH_SLOT_MAX is marked full, which
+*                   keeps a free slot at the end of every probe sequence (see 'fs_fat.h  FAT DIRECTORY
+*                   HASH INDEX DATA TYPE  Note #1').
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+static  void  FS_FAT_DirHashSlotAdd (FS_FAT_DIR_HASH  *p_dir_hash,
+                                     CPU_INT32U        hash,
+                                     FS_FAT_DIR_POS   *p_dir_pos)
+{
+    FS_FAT_DIR_HASH_SLOT  *p_slot;
+    CPU_INT32U             slot_ix;
+
+
+    if (p_dir_hash->Full == DEF_YES) {
+        return;
+    }
+
+    if (p_dir_hash->SlotCnt >= FS_FAT_DIR_HASH_SLOT_MAX) {     /* See Note #1.                                         */
+        p_dir_hash->Full = DEF_YES;
+        return;
+    }
+
+    slot_ix =  hash & (FS_FAT_CFG_DIR_HASH_SIZE - 1u);
+    p_slot  = &p_dir_hash->SlotTbl[slot_ix];
+    while (p_slot->Pos.SecNbr != 0u) {
+        slot_ix = (slot_ix + 1u) & (FS_FAT_CFG_DIR_HASH_SIZE - 1u);
+        p_slot  = &p_dir_hash->SlotTbl[slot_ix];
+    }
+
+    p_slot->Hash       = hash;
+    p_slot->Pos.SecNbr = p_dir_pos->SecNbr;
+    p_slot->Pos.SecPos = p_dir_pos->SecPos;
+    p_dir_hash->SlotCnt++;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_FAT_DirHashEntryAdd()
+*
+* Description : Add created entry to name hash index of directory, if directory is indexed.
+*
+* Argument(s) : p_vol               Pointer to volume.
+*               ----------          Argument validated by caller.
+*
+*               p_buf               Pointer to temporary buffer.
+*               ----------          Argument validated by caller.
+*
+*               dir_first_sec       First sector of the directory.
+*
+*               p_dir_start_pos     Pointer to directory position of the entry's first directory entry.
+*               ----------          Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The entry is read back as when the index is built, so that its hashes are the same.
+*                   The buffer then holds the entry's final directory entry, as after its creation.
+*
+*               (2) If the entry cannot be read back, the index is discarded.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_DirHashEntryAdd (FS_VOL          *p_vol,
+                                      FS_BUF          *p_buf,
+                                      FS_FAT_SEC_NBR   dir_first_sec,
+                                      FS_FAT_DIR_POS  *p_dir_start_pos)
+{
+    FS_FAT_DIR_HASH  *p_dir_hash;
+    FS_FAT_DIR_POS    dir_start_pos;
+    FS_FAT_DIR_POS    dir_end_pos;
+    CPU_INT32U        hash_tbl[FS_FAT_DIR_HASH_NAME_MAX];
+    CPU_INT08U        hash_cnt;
+    CPU_INT08U        hash_ix;
+    FS_ERR            err;
+
+
+    p_dir_hash = FS_FAT_DirHashFind((FS_FAT_DATA *)p_vol->DataPtr, dir_first_sec);
+    if (p_dir_hash == (FS_FAT_DIR_HASH *)0) {
+        return;
+    }
+    if (p_dir_hash->Full == DEF_YES) {
+        return;
+    }
+
+    dir_start_pos.SecNbr = p_dir_start_pos->SecNbr;             /* See Note #1.                                         */
+    dir_start_pos.SecPos = p_dir_start_pos->SecPos;
+    hash_cnt = FS_FAT_FN_API_Active.NextDirEntryHash( p_vol,
+                                                      p_buf,
+                                                     &hash_tbl[0],
+                                                     &dir_start_pos,
+                                                     &dir_end_pos,
+                                                     &err);
+    if ((err                  != FS_ERR_NONE)                     ||
+        (dir_start_pos.SecNbr != p_dir_start_pos->SecNbr) ||
+        (dir_start_pos.SecPos != p_dir_start_pos->SecPos)) {
+        p_dir_hash->DirFirstSec = 0u;                           /* See Note #2.                                         */
+        return;
+    }
+
+    for (hash_ix = 0u; hash_ix < hash_cnt; hash_ix++) {
+        FS_FAT_DirHashSlotAdd( p_dir_hash,
+                               hash_tbl[hash_ix],
+                              &dir_start_pos);
+    }
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FS_FAT_DirHashEntryRem()
+*
+* Description : Remove deleted entry from name hash index of directory, if directory is indexed.
+*
+* Argument(s) : p_vol               Pointer to volume.
+*               ----------          Argument validated by caller.
+*
+*               dir_first_sec       First sector of the directory.
+*
+*               p_dir_start_pos     Pointer to directory position of the entry's first directory entry.
+*               ----------          Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The entry's name is no longer known, so its slots are found by position.  The slots
+*                   following a removed slot in its probe sequence are added again, to keep each slot
+*                   reachable from its hash; a slot moved back is checked again.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_DirHashEntryRem (FS_VOL          *p_vol,
+                                      FS_FAT_SEC_NBR   dir_first_sec,
+                                      FS_FAT_DIR_POS  *p_dir_start_pos)
+{
+    FS_FAT_DIR_HASH       *p_dir_hash;
+    FS_FAT_DIR_HASH_SLOT  *p_slot;
+    FS_FAT_DIR_HASH_SLOT   slot;
+    CPU_INT32U             slot_ix;
+    CPU_INT32U             slot_ix_next;
+
+
+    p_dir_hash = FS_FAT_DirHashFind((FS_FAT_DATA *)p_vol->DataPtr, dir_first_sec);
+    if (p_dir_hash == (FS_FAT_DIR_HASH *)0) {
+        return;
+    }
+    if (p_dir_hash->Full == DEF_YES) {
+        return;
+    }
+
+    slot_ix = 0u;
+    while (slot_ix < FS_FAT_CFG_DIR_HASH_SIZE) {                /* See Note #1.                                         */
+        p_slot = &p_dir_hash->SlotTbl[slot_ix];
+        if ((p_slot->Pos.SecNbr == p_dir_start_pos->SecNbr) &&
+            (p_slot->Pos.SecPos == p_dir_start_pos->SecPos)) {
+            p_slot->Pos.SecNbr = 0u;
+            p_dir_hash->SlotCnt--;
+
+            slot_ix_next = (slot_ix + 1u) & (FS_FAT_CFG_DIR_HASH_SIZE - 1u);
+            while (p_dir_hash->SlotTbl[slot_ix_next].Pos.SecNbr != 0u) {
+                slot = p_dir_hash->SlotTbl[slot_ix_next];
+                p_dir_hash->SlotTbl[slot_ix_next].Pos.SecNbr = 0u;
+                p_dir_hash->SlotCnt--;
+                FS_FAT_DirHashSlotAdd( p_dir_hash,
+                                       slot.Hash,
+                                      &slot.Pos);
+                slot_ix_next = (slot_ix_next + 1u) & (FS_FAT_CFG_DIR_HASH_SIZE - 1u);
+            }
+        } else {
+            slot_ix++;
+        }
+    }
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_DirHashDirRem()
+*
+* Description : Discard name hash index of deleted directory, if directory is indexed.
+*
+* Argument(s) : p_vol           Pointer to volume.
+*               ----------      Argument validated by caller.
+*
+*               dir_first_sec   First sector of the directory.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_DirHashDirRem (FS_VOL          *p_vol,
+                                    FS_FAT_SEC_NBR   dir_first_sec)
+{
+    FS_FAT_DIR_HASH  *p_dir_hash;
+
+
+    p_dir_hash = FS_FAT_DirHashFind((FS_FAT_DATA *)p_vol->DataPtr, dir_first_sec);
+    if (p_dir_hash != (FS_FAT_DIR_HASH *)0) {
+        p_dir_hash->DirFirstSec = 0u;
+    }
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_FileDataClr()
+*
+* Description : Clear FAT file data structure
+*
+* Argument(s) : p_entry_data    Pointer to FAT entry data.
+*               ----------      Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_FileDataClr (FS_FAT_FILE_DATA  *p_entry_data)
 {
     p_entry_data->FilePos        = 0u;
     p_entry_data->FileSize       = 0u;
@@ -6074,6 +7023,18 @@ static  void  FS_FAT_FileDataClr (FS_FAT_FILE_DATA  *p_entry_data)
     p_entry_data->FileCurSec     = 0u;
     p_entry_data->FileCurSecPos  = 0u;
 
+#if (FS_FAT_CFG_FILE_EXTENT_MAX > 0u)
+    p_entry_data->ExtentCnt      = 0u;
+#endif
+
+#if (FS_FAT_CFG_RD_AHEAD_SEC_MAX > 0u)
+    p_entry_data->RdAheadNextPos = 0u;
+    p_entry_data->RdAheadEndPos  = 0u;
+    p_entry_data->RdAheadLastSec = 0u;
+    p_entry_data->RdAheadWin     = 0u;
+    p_entry_data->RdAheadWinMax  = FS_FAT_CFG_RD_AHEAD_SEC_MAX;
+#endif
+
     p_entry_data->Attrib         = 0u;
     p_entry_data->DateCreate     = 0u;
     p_entry_data->TimeCreate     = 0u;
@@ -6114,6 +7075,335 @@ static  void  FS_FAT_FileDataInit (FS_FAT_FILE_DATA *p_entry_data,
 }
 
 
+/*
+*********************************************************************************************************
+*                                      FS_FAT_ClusFreeRunFind()
+*
+* Description : Find free cluster, preferably at the start of a run of free clusters, using the free
+*               cluster map.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               ----------  Argument validated by caller.
+*
+*               clus_hint   Cluster from which search starts.
+*
+*               clus_cnt    Number of free clusters wanted in run.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE        Cluster found.
+*                               FS_ERR_DEV_FULL    Device is full (no space could be allocated).
+*
+*                                                  --- RETURNED BY FS_FAT_FreeMapLoad() ---
+*                               FS_ERR_DEV         Device access error.
+*
+* Return(s)   : Cluster number, if free cluster found.
+*               0,              otherwise.
+*
+* Note(s)     : (1) The cluster returned is ...
+*
+*                   (a) ... 'clus_hint', if free, so that a chain being extended stays contiguous; else
+*                   (b) ... the first cluster of the first run of 'clus_cnt' free clusters after
+*                           'clus_hint'; else
+*                   (c) ... the first free cluster after 'clus_hint'.
+*
+*                   Runs are searched in one map window at a time; a run crossing windows is not found.
+*
+*               (2) The cluster found is marked in use in the map, so that the next search does not return
+*                   it before its FAT entry is written.
+*
+*               (3) Windows are visited from the one holding 'clus_hint', wrapping at the end of the FAT,
+*                   until the first window has been searched again from its start.  If the map covers the
+*                   whole volume & no free cluster is found, it is reloaded once from the FAT : clusters
+*                   found but never allocated (e.g., after an error) are then marked free again.
+*
+*               (4) See 'FS_FAT_ClusFreeFind()  Note #1'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+static  FS_FAT_CLUS_NBR  FS_FAT_ClusFreeRunFind (FS_VOL           *p_vol,
+                                                 FS_BUF           *p_buf,
+                                                 FS_FAT_CLUS_NBR   clus_hint,
+                                                 FS_FAT_CLUS_NBR   clus_cnt,
+                                                 FS_ERR           *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   win_start;
+    FS_FAT_CLUS_NBR   win_ix;
+    FS_FAT_CLUS_NBR   win_cnt;
+    FS_FAT_CLUS_NBR   bit;
+    FS_FAT_CLUS_NBR   bit_start;
+    FS_FAT_CLUS_NBR   clus;
+    CPU_BOOLEAN       clus_ignore;
+    CPU_BOOLEAN       reloaded;
+#if ((FS_FAT_CFG_FAT12_EN == DEF_ENABLED) && (FS_FAT_CFG_JOURNAL_EN == DEF_ENABLED))
+    FS_SEC_SIZE       fat_offset;
+    FS_SEC_SIZE       fat_sec_offset;
+#endif
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    if (FS_FAT_IS_VALID_CLUS(p_fat_data, clus_hint) == DEF_NO) {
+        clus_hint = FS_FAT_MIN_CLUS_NBR;
+    }
+    win_cnt    = (p_fat_data->MaxClusNbr + FS_FAT_FREE_MAP_CLUS_NBR - 1u) / FS_FAT_FREE_MAP_CLUS_NBR;
+    reloaded   =  DEF_NO;
+
+    while (DEF_ON) {
+        win_start = clus_hint - (clus_hint % FS_FAT_FREE_MAP_CLUS_NBR);
+        bit_start = clus_hint -  win_start;
+        win_ix    = 0u;
+        while (win_ix <= win_cnt) {                             /* See Note #3.                                         */
+                                                                /* ------------------- LOAD WINDOW -------------------- */
+            if ((p_fat_data->FreeMapCnt   == 0u) ||
+                (p_fat_data->FreeMapStart != win_start)) {
+                FS_FAT_FreeMapLoad(p_vol, p_buf, win_start, p_err);
+                if (*p_err != FS_ERR_NONE) {
+                    return (0u);
+                }
+            }
+
+                                                                /* ------------------- SRCH WINDOW -------------------- */
+            bit = p_fat_data->FreeMapCnt;
+            if (p_fat_data->FreeMapFreeCnt > 0u) {
+                if ((win_ix    == 0u) &&                        /* See Note #1a.                                        */
+                    (bit_start <  p_fat_data->FreeMapCnt) &&
+                    (DEF_BIT_IS_CLR(p_fat_data->FreeMap[bit_start >> 5], (CPU_INT32U)1u << (bit_start & 31u)) == DEF_YES)) {
+                    bit = bit_start;
+                } else {
+                    bit = FS_FAT_FreeMapSrch(p_fat_data, bit_start, clus_cnt);
+                }
+            }
+
+            if (bit < p_fat_data->FreeMapCnt) {                 /* ----------------- FREE CLUS FOUND ------------------ */
+                clus = win_start + bit;
+                DEF_BIT_SET(p_fat_data->FreeMap[bit >> 5], (CPU_INT32U)1u << (bit & 31u));
+                p_fat_data->FreeMapFreeCnt--;                   /* See Note #2.                                         */
+
+                clus_ignore = DEF_NO;
+#if ((FS_FAT_CFG_FAT12_EN == DEF_ENABLED) && (FS_FAT_CFG_JOURNAL_EN == DEF_ENABLED))
+                if ((p_fat_data->FAT_Type     == 12u) &&        /* If FAT12 and journal started ...                     */
+                    (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START) == DEF_YES)) {
+                    fat_offset     = (FS_SEC_SIZE)clus + ((FS_SEC_SIZE)clus / 2u);
+                    fat_sec_offset =  fat_offset & (p_fat_data->SecSize - 1u);
+                    if (fat_sec_offset == p_fat_data->SecSize - 1u) {   /* ... avoid sec boundary (see Note #4).        */
+                        FS_TRACE_LOG(("FS_FAT_ClusFreeRunFind(): Sec boundary clus avoided: %d.\r\n", clus));
+                        clus_ignore = DEF_YES;
+                    }
+                }
+#endif
+                if (clus_ignore == DEF_NO) {
+                    p_fat_data->NextClusNbr = clus + 1u;
+                    FS_TRACE_LOG(("FS_FAT_ClusFreeRunFind(): New FAT clus alloc'd: %d.\r\n", clus));
+                   *p_err = FS_ERR_NONE;
+                    return (clus);
+                }
+                bit_start = bit + 1u;                           /* Srch rest of window.                                 */
+
+            } else {                                            /* ------------------- NEXT WINDOW -------------------- */
+                bit_start  = 0u;
+                win_start += FS_FAT_FREE_MAP_CLUS_NBR;
+                if (win_start >= p_fat_data->MaxClusNbr) {
+                    win_start = 0u;
+                }
+                win_ix++;
+            }
+        }
+
+        if ((win_cnt  >  1u) ||                                 /* Reload whole vol map once (see Note #3).             */
+            (reloaded == DEF_YES)) {
+            break;
+        }
+        p_fat_data->FreeMapCnt = 0u;
+        reloaded               = DEF_YES;
+    }
+
+
+                                                                /* ------------------- NO CLUS FOUND ------------------ */
+   *p_err = FS_ERR_DEV_FULL;
+    FS_TRACE_DBG(("FS_FAT_ClusFreeRunFind(): No free FAT clus could be found.\r\n"));
+    return (0u);
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_FreeMapLoad()
+*
+* Description : Load free cluster map window from the FAT.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               ----------  Argument validated by caller.
+*
+*               win_start   First cluster of window (multiple of FS_FAT_FREE_MAP_CLUS_NBR).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE    Window loaded.
+*
+*                                              -- RETURNED BY p_fat_data->FAT_TypeAPI_Ptr->ClusValRdSec() --
+*                               FS_ERR_DEV     Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Bits of clusters 0 & 1 & of the words' bits past the last cluster of the window are set,
+*                   so that searches never return them.
+*
+*               (2) On error, the map is left unloaded.
+*
+*               (3) See 'FS_FAT_QueryScan()  Note #2'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+static  void  FS_FAT_FreeMapLoad (FS_VOL           *p_vol,
+                                  FS_BUF           *p_buf,
+                                  FS_FAT_CLUS_NBR   win_start,
+                                  FS_ERR           *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   clus;
+    FS_FAT_CLUS_NBR   clus_end;
+    FS_FAT_CLUS_NBR   fat_entry_tbl[FS_FAT_CLUS_VAL_TBL_SIZE];
+    FS_FAT_CLUS_NBR   rd_cnt;
+    FS_FAT_CLUS_NBR   ix;
+    FS_FAT_CLUS_NBR   free_cnt;
+    FS_FAT_CLUS_NBR   bit;
+
+
+    p_fat_data             = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_fat_data->FreeMapCnt =  0u;
+    clus_end               =  DEF_MIN(p_fat_data->MaxClusNbr, win_start + FS_FAT_FREE_MAP_CLUS_NBR);
+
+    Mem_Set((void *)&p_fat_data->FreeMap[0],                    /* See Note #1.                                         */
+                     0xFFu,
+                     sizeof(p_fat_data->FreeMap));
+
+    free_cnt = 0u;
+    clus     = DEF_MAX(win_start, FS_FAT_MIN_CLUS_NBR);
+    while (clus < clus_end) {                                   /* Rd entries a FAT sec at a time (see Note #3).        */
+        rd_cnt = p_fat_data->FAT_TypeAPI_Ptr->ClusValRdSec(p_vol,
+                                                           p_buf,
+                                                           clus,
+                                                           DEF_MIN(clus_end - clus, FS_FAT_CLUS_VAL_TBL_SIZE),
+                                                          &fat_entry_tbl[0],
+                                                           p_err);
+        if (*p_err != FS_ERR_NONE) {                            /* See Note #2.                                         */
+            return;
+        }
+
+        bit = clus - win_start;
+        for (ix = 0u; ix < rd_cnt; ix++) {
+            if (fat_entry_tbl[ix] == p_fat_data->FAT_TypeAPI_Ptr->ClusFree) {
+                DEF_BIT_CLR(p_fat_data->FreeMap[bit >> 5], (CPU_INT32U)1u << (bit & 31u));
+                free_cnt++;
+            }
+            bit++;
+        }
+        clus += rd_cnt;
+    }
+
+    p_fat_data->FreeMapStart   = win_start;
+    p_fat_data->FreeMapCnt     = clus_end - win_start;
+    p_fat_data->FreeMapFreeCnt = free_cnt;
+}
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_FreeMapSrch()
+*
+* Description : Search free cluster map window for a run of free clusters.
+*
+* Argument(s) : p_fat_data  Pointer to FAT info.
+*               ----------  Argument validated by caller.
+*
+*               bit_start   Bit of map from which search starts.
+*
+*               run_len     Number of free clusters wanted in run.
+*
+* Return(s)   : Bit of first cluster of the first run of 'run_len' free clusters, if found;
+*               bit of first free cluster,                                         otherwise;
+*               'FreeMapCnt',                                                      if no cluster is free.
+*
+* Note(s)     : (1) The map is scanned a 32-bit word at a time : a word with every bit set holds no free
+*                   cluster, & the first free cluster of any other word is found by counting trailing bits
+*                   set (see 'FS_FAT_FreeMapLoad()  Note #1').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+static  FS_FAT_CLUS_NBR  FS_FAT_FreeMapSrch (FS_FAT_DATA      *p_fat_data,
+                                             FS_FAT_CLUS_NBR   bit_start,
+                                             FS_FAT_CLUS_NBR   run_len)
+{
+    FS_FAT_CLUS_NBR   bit;
+    FS_FAT_CLUS_NBR   bit_end;
+    FS_FAT_CLUS_NBR   bit_first;
+    FS_FAT_CLUS_NBR   len;
+    FS_FAT_CLUS_NBR   len_word;
+    CPU_INT32U        word;
+
+
+    bit_end   = p_fat_data->FreeMapCnt;
+    bit_first = bit_end;
+    bit       = bit_start;
+    while (bit < bit_end) {
+                                                                /* ------------------ FIND FREE CLUS ------------------ */
+        word = p_fat_data->FreeMap[bit >> 5] | (((CPU_INT32U)1u << (bit & 31u)) - 1u);
+        if (word == DEF_INT_32U_MAX_VAL) {                      /* See Note #1.                                         */
+            bit = (bit & ~(FS_FAT_CLUS_NBR)31u) + 32u;
+            continue;
+        }
+        bit = (bit & ~(FS_FAT_CLUS_NBR)31u) + (FS_FAT_CLUS_NBR)CPU_CntTrailZeros32(~word);
+        if (bit >= bit_end) {
+            break;
+        }
+        if (bit_first == bit_end) {
+            bit_first = bit;
+        }
+
+                                                                /* ------------------ MEASURE FREE RUN ---------------- */
+        len = 0u;
+        while ((len < run_len) && (bit + len < bit_end)) {
+            word = p_fat_data->FreeMap[(bit + len) >> 5] >> ((bit + len) & 31u);
+            if (word == 0u) {
+                len_word = 32u - ((bit + len) & 31u);
+            } else {
+                len_word = (FS_FAT_CLUS_NBR)CPU_CntTrailZeros32(word);
+                len     += len_word;
+                break;
+            }
+            len += len_word;
+        }
+        if (len >= run_len) {
+            return (bit);
+        }
+        bit += len;
+    }
+
+    return (bit_first);
+}
+#endif
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                          FS_FAT_DataClr()
@@ -6161,6 +7451,20 @@ static  void  FS_FAT_DataClr (FS_FAT_DATA  *p_fat_data)
     p_fat_data->QueryInfoValid     =  DEF_NO;
     p_fat_data->QueryBadClusCnt    =  0u;
     p_fat_data->QueryFreeClusCnt   =  0u;
+    p_fat_data->QueryScanClusNbr   =  0u;
+    p_fat_data->QueryScanBadCnt    =  0u;
+    p_fat_data->QueryScanFreeCnt   =  0u;
+    p_fat_data->VolClean           =  DEF_NO;                   /* Set at mount if FAT32 vol clean.                     */
+
+#if (FS_FAT_CFG_FREE_MAP_SIZE      >  0u)
+    p_fat_data->FreeMapStart       =  0u;
+    p_fat_data->FreeMapCnt         =  0u;                       /* Map loaded on first alloc.                           */
+    p_fat_data->FreeMapFreeCnt     =  0u;
+#endif
+
+#if (FS_FAT_CFG_DIR_HASH_NBR       >  0u)
+    FS_FAT_DirHashClr(p_fat_data);                              /* No dir indexed.                                      */
+#endif
 
 #if (FS_CFG_CTR_STAT_EN            == DEF_ENABLED)
     p_fat_data->StatAllocClusCtr   =  0u;
@@ -6169,6 +7473,432 @@ static  void  FS_FAT_DataClr (FS_FAT_DATA  *p_fat_data)
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FS_FAT_QueryInfoUpd()
+*
+* Description : Update query info for an allocated or freed cluster.
+*
+* Argument(s) : p_fat_data  Pointer to FAT info.
+*               ----------  Argument validated by caller.
+*
+*               clus        Cluster number.
+*
+*               clus_free   Indicates whether cluster was freed :
+*
+*                               DEF_NO,  if cluster was allocated.
+*                               DEF_YES, if cluster was freed.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) While the FAT is being scanned, only clusters already scanned are counted in the partial
+*                   free cluster count; later clusters will be counted when reached.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_QueryInfoUpd (FS_FAT_DATA      *p_fat_data,
+                                   FS_FAT_CLUS_NBR   clus,
+                                   CPU_BOOLEAN       clus_free)
+{
+    if (p_fat_data->QueryInfoValid == DEF_YES) {
+        if (clus_free == DEF_YES) {
+            p_fat_data->QueryFreeClusCnt++;
+        } else {
+            p_fat_data->QueryFreeClusCnt--;
+        }
+
+    } else if (clus < p_fat_data->QueryScanClusNbr) {           /* See Note #1.                                         */
+        if (clus_free == DEF_YES) {
+            p_fat_data->QueryScanFreeCnt++;
+        } else {
+            p_fat_data->QueryScanFreeCnt--;
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FS_FAT_QueryScan()
+*
+* Description : Scan part of the FAT to count bad & free clusters.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               ----------  Argument validated by caller.
+*
+*               clus_cnt    Maximum number of FAT entries to read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE    Entries scanned.
+*
+*                               ------------RETURNED BY p_fat_data->FAT_TypeAPI_Ptr->ClusValRdSec()------------
+*                               See p_fat_data->FAT_TypeAPI_Ptr->ClusValRdSec() for additional return error codes.
+*
+* Return(s)   : DEF_YES, if the query info is valid.
+*
+*               DEF_NO,  otherwise.
+*
+* Note(s)     : (1) The scan resumes at 'QueryScanClusNbr'.  Once the last entry has been read, the counts
+*                   become the query info.
+*
+*               (2) Entries are decoded from each FAT sector in one call, rather than looked up one at a
+*                   time through 'ClusValRd()'.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  FS_FAT_QueryScan (FS_VOL           *p_vol,
+                                       FS_BUF           *p_buf,
+                                       FS_FAT_CLUS_NBR   clus_cnt,
+                                       FS_ERR           *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   clus;
+    FS_FAT_CLUS_NBR   clus_end;
+    FS_FAT_CLUS_NBR   fat_entry;
+    FS_FAT_CLUS_NBR   fat_entry_tbl[FS_FAT_CLUS_VAL_TBL_SIZE];
+    FS_FAT_CLUS_NBR   rd_cnt;
+    FS_FAT_CLUS_NBR   ix;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+   *p_err      =  FS_ERR_NONE;
+
+    if (p_fat_data->QueryInfoValid == DEF_YES) {
+        return (DEF_YES);
+    }
+
+    clus = p_fat_data->QueryScanClusNbr;                        /* See Note #1.                                         */
+    if (clus < FS_FAT_MIN_CLUS_NBR) {                           /* Start scan.                                          */
+        clus                         = FS_FAT_MIN_CLUS_NBR;
+        p_fat_data->QueryScanBadCnt  = 0u;
+        p_fat_data->QueryScanFreeCnt = 0u;
+    }
+
+    clus_end = p_fat_data->MaxClusNbr;
+    if (clus_end - clus > clus_cnt) {
+        clus_end = clus + clus_cnt;
+    }
+
+                                                                /* ------------- CNT NBR OF BAD/FREE CLUS'S ----------- */
+    while (clus < clus_end) {                                   /* Rd entries a FAT sec at a time (see Note #2).        */
+        rd_cnt = p_fat_data->FAT_TypeAPI_Ptr->ClusValRdSec(p_vol,
+                                                           p_buf,
+                                                           clus,
+                                                           DEF_MIN(clus_end - clus, FS_FAT_CLUS_VAL_TBL_SIZE),
+                                                          &fat_entry_tbl[0],
+                                                           p_err);
+        if (*p_err != FS_ERR_NONE) {
+            p_fat_data->QueryScanClusNbr = clus;
+            return (DEF_NO);
+        }
+
+        for (ix = 0u; ix < rd_cnt; ix++) {
+            fat_entry = fat_entry_tbl[ix];
+            if (fat_entry == p_fat_data->FAT_TypeAPI_Ptr->ClusBad) {
+                p_fat_data->QueryScanBadCnt++;
+
+            } else if (fat_entry == p_fat_data->FAT_TypeAPI_Ptr->ClusFree) {
+                p_fat_data->QueryScanFreeCnt++;
+            }
+        }
+
+        clus += rd_cnt;
+    }
+
+    p_fat_data->QueryScanClusNbr = clus;
+    if (clus < p_fat_data->MaxClusNbr) {
+        return (DEF_NO);
+    }
+
+                                                                /* ------------------- SCAN COMPLETE ------------------ */
+    p_fat_data->QueryInfoValid   = DEF_YES;
+    p_fat_data->QueryBadClusCnt  = p_fat_data->QueryScanBadCnt;
+    p_fat_data->QueryFreeClusCnt = p_fat_data->QueryScanFreeCnt;
+    p_fat_data->QueryScanClusNbr = 0u;
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_VolCleanSet()
+*
+* Description : Update FSINFO sector & set clean shutdown bit of a FAT32 volume.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Nothing is written unless the volume is still mounted on the same media :  a volume
+*                   being formatted, or whose device has changed, is closed in another state.
+*
+*               (2) FSINFO holds the free cluster count, if known (0xFFFFFFFF otherwise), & the next cluster
+*                   to allocate.  The clean shutdown bit is only set once FSINFO has been updated, so that
+*                   a stale count is never trusted at mount (see 'FS_FAT_VolStateRd()').
+*
+*               (3) The sectors written here reach the volume when the volume cache is flushed on close.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_VolCleanSet (FS_VOL  *p_vol)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_BUF           *p_buf;
+    CPU_INT08U       *p_temp_08;
+    CPU_INT32U        free_cnt;
+    FS_FAT_CLUS_NBR   fat_entry;
+    FS_ERR            err;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    if ((p_fat_data->FAT_Type != FS_FAT_FAT_TYPE_FAT32) ||
+        (p_fat_data->VolClean == DEF_YES)) {                    /* Vol unchanged since mount.                           */
+        return;
+    }
+    if ((p_vol->State      != FS_VOL_STATE_MOUNTED) ||          /* See Note #1.                                         */
+        (p_vol->RefreshCnt != p_vol->DevPtr->RefreshCnt)) {
+        return;
+    }
+
+    p_buf = FSBuf_Get(p_vol);
+    if (p_buf == (FS_BUF *)0) {
+        return;
+    }
+
+                                                                /* ------------------- UPDATE FSINFO ------------------ */
+    if ((p_fat_data->FS_InfoStart > 0u) &&
+        (p_fat_data->FS_InfoStart < p_fat_data->RsvdSize)) {
+        FSBuf_Set(p_buf,
+                  p_fat_data->FS_InfoStart,
+                  FS_VOL_SEC_TYPE_MGMT,
+                  DEF_YES,
+                 &err);
+        if (err != FS_ERR_NONE) {
+            FSBuf_Free(p_buf);
+            return;
+        }
+
+        p_temp_08 = (CPU_INT08U *)p_buf->DataPtr;
+        if ((MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_LEADSIG))  == FS_FAT_FSI_LEADSIG)  &&
+            (MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_STRUCSIG)) == FS_FAT_FSI_STRUCSIG) &&
+            (MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_TRAILSIG)) == FS_FAT_FSI_TRAILSIG)) {
+            if (p_fat_data->QueryInfoValid == DEF_YES) {        /* See Note #2.                                         */
+                free_cnt = (CPU_INT32U)p_fat_data->QueryFreeClusCnt;
+            } else {
+                free_cnt = FS_FAT_FSI_FREE_COUNT_UNKNOWN;
+            }
+            MEM_VAL_SET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_FREE_COUNT), free_cnt);
+            MEM_VAL_SET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_NXT_FREE),   p_fat_data->NextClusNbr);
+            FSBuf_MarkDirty(p_buf, &err);
+            if (err != FS_ERR_NONE) {
+                FSBuf_Free(p_buf);
+                return;
+            }
+        }
+    }
+
+                                                                /* ------------- SET CLEAN SHUTDOWN BIT --------------- */
+    fat_entry = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol,
+                                                       p_buf,
+                                                       1u,
+                                                      &err);
+    if (err == FS_ERR_NONE) {
+        DEF_BIT_SET(fat_entry, (FS_FAT_CLUS_NBR)FS_FAT_FAT32_CLN_SHUT_BIT);
+        p_fat_data->FAT_TypeAPI_Ptr->ClusValWr(p_vol,
+                                               p_buf,
+                                               1u,
+                                               fat_entry,
+                                              &err);
+    }
+    if (err == FS_ERR_NONE) {
+        FSBuf_Flush(p_buf, &err);                               /* See Note #3.                                         */
+    }
+    if (err == FS_ERR_NONE) {
+        p_fat_data->VolClean = DEF_YES;
+    }
+
+    FSBuf_Free(p_buf);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_VolDirtySet()
+*
+* Description : Clear clean shutdown bit of a FAT32 volume.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE    Volume marked dirty (or already dirty).
+*
+*                               -------------RETURNED BY p_fat_data->FAT_TypeAPI_Ptr->ClusValRd()--------------
+*                               See p_fat_data->FAT_TypeAPI_Ptr->ClusValRd() for additional return error codes.
+*
+*                               -------------RETURNED BY p_fat_data->FAT_TypeAPI_Ptr->ClusValWr()--------------
+*                               See p_fat_data->FAT_TypeAPI_Ptr->ClusValWr() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The clean shutdown bit (bit 27 of FAT[1]) of a FAT32 volume is cleared before its FAT is
+*                   first changed after mount, & set again when the volume is closed.  If the volume is
+*                   not closed (e.g., power loss), the bit stays clear & the FSINFO free cluster count is not
+*                   trusted at the next mount.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_VolDirtySet (FS_VOL  *p_vol,
+                                  FS_BUF  *p_buf,
+                                  FS_ERR  *p_err)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   fat_entry;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+   *p_err      =  FS_ERR_NONE;
+
+    if (p_fat_data->VolClean == DEF_NO) {                       /* Vol already dirty, or not FAT32.                     */
+        return;
+    }
+
+    fat_entry = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol,   /* See Note #1.                                         */
+                                                       p_buf,
+                                                       1u,
+                                                       p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    DEF_BIT_CLR(fat_entry, (FS_FAT_CLUS_NBR)FS_FAT_FAT32_CLN_SHUT_BIT);
+    p_fat_data->FAT_TypeAPI_Ptr->ClusValWr(p_vol,
+                                           p_buf,
+                                           1u,
+                                           fat_entry,
+                                           p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    p_fat_data->VolClean = DEF_NO;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FS_FAT_VolStateRd()
+*
+* Description : Read clean shutdown bit & FSINFO sector of a FAT32 volume.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) If the volume was cleanly unmounted & its FSINFO sector is valid, the free cluster count
+*                   it holds becomes the query info, so that no FAT scan is needed at mount or on query.
+*                   FSINFO holds no bad cluster count :  bad clusters are then counted as used.
+*
+*               (2) Otherwise, the free cluster count is unknown until the FAT has been scanned (see
+*                   'FS_FAT_VolFreeCntScan()').
+*
+*               (3) The FSINFO next free cluster is only a hint for allocation.
+*
+*               (4) Errors are ignored :  the volume is then handled as if not cleanly unmounted.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_VolStateRd (FS_VOL  *p_vol)
+{
+    FS_FAT_DATA      *p_fat_data;
+    FS_BUF           *p_buf;
+    CPU_INT08U       *p_temp_08;
+    CPU_INT32U        free_cnt;
+    CPU_INT32U        nxt_free;
+    FS_FAT_CLUS_NBR   fat_entry;
+    FS_ERR            err;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+    if (p_fat_data->FAT_Type != FS_FAT_FAT_TYPE_FAT32) {
+        return;
+    }
+
+    p_buf = FSBuf_Get(p_vol);
+    if (p_buf == (FS_BUF *)0) {
+        return;
+    }
+
+                                                                /* -------------- RD CLEAN SHUTDOWN BIT --------------- */
+    fat_entry = p_fat_data->FAT_TypeAPI_Ptr->ClusValRd(p_vol,
+                                                       p_buf,
+                                                       1u,
+                                                      &err);
+    if ((err != FS_ERR_NONE) ||                                 /* See Note #4.                                         */
+        (DEF_BIT_IS_CLR(fat_entry, (FS_FAT_CLUS_NBR)FS_FAT_FAT32_CLN_SHUT_BIT) == DEF_YES)) {
+        FSBuf_Free(p_buf);                                      /* Vol dirty (see Note #2).                             */
+        return;
+    }
+    p_fat_data->VolClean = DEF_YES;
+
+                                                                /* -------------------- RD FSINFO --------------------- */
+    if ((p_fat_data->FS_InfoStart == 0u) ||
+        (p_fat_data->FS_InfoStart >= p_fat_data->RsvdSize)) {
+        FSBuf_Free(p_buf);
+        return;
+    }
+
+    FSBuf_Set(p_buf,
+              p_fat_data->FS_InfoStart,
+              FS_VOL_SEC_TYPE_MGMT,
+              DEF_YES,
+             &err);
+    if (err != FS_ERR_NONE) {
+        FSBuf_Free(p_buf);
+        return;
+    }
+
+    p_temp_08 = (CPU_INT08U *)p_buf->DataPtr;
+    if ((MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_LEADSIG))  == FS_FAT_FSI_LEADSIG)  &&
+        (MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_STRUCSIG)) == FS_FAT_FSI_STRUCSIG) &&
+        (MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_TRAILSIG)) == FS_FAT_FSI_TRAILSIG)) {
+        free_cnt = MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_FREE_COUNT));
+        nxt_free = MEM_VAL_GET_INT32U_LITTLE((void *)(p_temp_08 + FS_FAT_FSI_OFF_NXT_FREE));
+
+        if (free_cnt <= (CPU_INT32U)(p_fat_data->MaxClusNbr - FS_FAT_MIN_CLUS_NBR)) {
+            p_fat_data->QueryInfoValid   = DEF_YES;             /* See Note #1.                                         */
+            p_fat_data->QueryBadClusCnt  = 0u;
+            p_fat_data->QueryFreeClusCnt = (FS_FAT_CLUS_NBR)free_cnt;
+        }
+
+        if (FS_FAT_IS_VALID_CLUS(p_fat_data, nxt_free) == DEF_YES) {
+            p_fat_data->NextClusNbr = (FS_FAT_CLUS_NBR)nxt_free;/* See Note #3.                                         */
+        }
+    }
+
+    FSBuf_Free(p_buf);
+}
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
@@ -89,9 +89,99 @@
 /*
 *********************************************************************************************************
 *                                               DEFINES
+*
+* Note(s) : (1) FS_FAT_CFG_RD_AHEAD_SEC_MAX is the maximum number of sectors read ahead of a file read
+*               sequentially (see 'fs_fat_file.c  FS_FAT_FileRdAhead()').  It may be #define'd in
+*               'fs_cfg.h'; 0 disables read ahead.  Sectors are read ahead into the volume cache, so
+*               read ahead is only performed on volumes with a cache.
+*
+*           (2) FS_FAT_CFG_FILE_EXTENT_MAX is the number of extents (runs of contiguous clusters) of its
+*               cluster chain each open file remembers (see 'fs_fat_file.c  FS_FAT_FileClusGet()').  It
+*               may be #define'd in 'fs_cfg.h'; 0 disables the extent map.  Each extent takes 12 octets
+*               of every open file's FAT data.
+*
+*           (3) FS_FAT_CFG_FREE_MAP_SIZE is the size, in octets, of each volume's free cluster bitmap (see
+*               'fs_fat.c  FS_FAT_ClusFreeRunFind()').  It may be #define'd in 'fs_cfg.h'; 0 disables the
+*               bitmap.  Each octet covers 8 clusters : a bitmap covering fewer clusters than the volume
+*               holds is a window onto the FAT, moved as free clusters are searched.
+*
+*           (4) FS_FAT_CFG_DIR_HASH_NBR is the number of directories whose name hash index each volume
+*               keeps (see 'fs_fat.c  FS_FAT_DirEntryFind()'); the least recently searched directory's
+*               index is evicted to index another.  It may be #define'd in 'fs_cfg.h'; 0 disables the
+*               index.
+*
+*           (5) FS_FAT_CFG_DIR_HASH_SIZE is the number of slots, a power of 2, of each directory's index.
+*               Each slot takes 12 octets of the volume's FAT data & each entry uses one or two slots
+*               (its LFN & its SFN).  A directory needing more than 3/4 of the slots is not indexed.
+*
+*           (6) FS_FAT_CFG_SFN_TAIL_NUM_MAX is the number of numeric tails ('~1' to '~n') tried for the SFN
+*               of a long-named entry before a basis derived from a hash of its LFN is used instead (see
+*               'fs_fat_lfn.c  FS_FAT_LFN_SFN_Alloc()').  It may be #define'd in 'fs_cfg.h' (1 to 999).
+*
+*           (7) FS_FAT_CFG_JOURNAL_GROUP_OP_MAX is the number of journaled operations whose logs are
+*               committed together (see 'fs_fat_journal.c  FS_FAT_JournalClrReset()').  Until the group
+*               is committed, a failure rolls the volume back to the last commit.  It may be #define'd
+*               in 'fs_cfg.h'; 1 commits every operation as it completes.
+*
+*           (8) FS_FAT_CFG_JOURNAL_GROUP_SIZE is the number of journal octets after which a group is
+*               committed even if fewer than FS_FAT_CFG_JOURNAL_GROUP_OP_MAX operations have completed.
+*               It may be #define'd in 'fs_cfg.h' (512 to 8192, i.e., at most half the journal, so that
+*               each operation finds room for its logs).
+*
+*           (9) FS_FAT_CFG_FILE_DIRECT_SIZE_MIN is the size, in octets, from which a file read or write
+*               transfers its whole clusters around the volume cache, as if the file had been opened with
+*               FS_FILE_ACCESS_MODE_DIRECT (see 'fs_fat_file.c  FS_FAT_FileSecRd()').  It may be #define'd
+*               in 'fs_cfg.h'; 0 restricts direct transfers to files opened in that mode.
 *********************************************************************************************************
 */
 
+#ifndef  FS_FAT_CFG_RD_AHEAD_SEC_MAX                            /* See Note #1.                                         */
+#define  FS_FAT_CFG_RD_AHEAD_SEC_MAX                      32u
+#endif
+
+#ifndef  FS_FAT_CFG_FILE_EXTENT_MAX                             /* See Note #2.                                         */
+#define  FS_FAT_CFG_FILE_EXTENT_MAX                        8u
+#endif
+
+#ifndef  FS_FAT_CFG_FREE_MAP_SIZE                               /* See Note #3.                                         */
+#define  FS_FAT_CFG_FREE_MAP_SIZE                       1024u
+#endif
+
+#ifndef  FS_FAT_CFG_DIR_HASH_NBR                                /* See Note #4.                                         */
+#define  FS_FAT_CFG_DIR_HASH_NBR                           0u
+#endif
+
+#ifndef  FS_FAT_CFG_DIR_HASH_SIZE                               /* See Note #5.                                         */
+#define  FS_FAT_CFG_DIR_HASH_SIZE                       1024u
+#endif
+
+#ifndef  FS_FAT_CFG_SFN_TAIL_NUM_MAX                            /* See Note #6.                                         */
+#define  FS_FAT_CFG_SFN_TAIL_NUM_MAX                       4u
+#endif
+
+#ifndef  FS_FAT_CFG_JOURNAL_GROUP_OP_MAX                        /* See Note #7.                                         */
+#define  FS_FAT_CFG_JOURNAL_GROUP_OP_MAX                   1u
+#endif
+
+#ifndef  FS_FAT_CFG_JOURNAL_GROUP_SIZE                          /* See Note #8.                                         */
+#define  FS_FAT_CFG_JOURNAL_GROUP_SIZE                  4096u
+#endif
+
+#ifndef  FS_FAT_CFG_FILE_DIRECT_SIZE_MIN                        /* See Note #9.                                         */
+#define  FS_FAT_CFG_FILE_DIRECT_SIZE_MIN                   0u
+#endif
+
+#define  FS_FAT_RD_AHEAD_SEC_MIN                           2u   /* Initial rd ahead win, in secs.                       */
+
+#define  FS_FAT_FREE_MAP_WORD_NBR         ((FS_FAT_CFG_FREE_MAP_SIZE + 3u) / 4u)
+#define  FS_FAT_FREE_MAP_CLUS_NBR          (FS_FAT_FREE_MAP_WORD_NBR * 32u)
+#define  FS_FAT_DIR_HASH_SLOT_MAX         ((FS_FAT_CFG_DIR_HASH_SIZE / 4u) * 3u)
+
+#define  FS_FAT_DIR_HASH_NAME_MAX                          2u   /* Max nbr of hashes of a name (LFN & SFN).             */
+#define  FS_FAT_DIR_HASH_INIT_LFN                 0x811C9DC5u   /* FNV-1a offset basis for LFN hashes.                  */
+#define  FS_FAT_DIR_HASH_INIT_SFN                 0x050C5D1Fu   /* FNV-1a offset basis for SFN hashes.                  */
+#define  FS_FAT_DIR_HASH_PRIME                    0x01000193u   /* FNV-1a prime.                                        */
+
 #define  FS_FAT_PATH_SEP_CHAR                    FS_CHAR_PATH_SEP
 
 #define  FS_FAT_SIZE_DIR_ENTRY                            32u
@@ -120,6 +210,7 @@
 #define  FS_FAT_MODE_APPEND                      FS_FILE_ACCESS_MODE_APPEND
 #define  FS_FAT_MODE_MUST_CREATE                 FS_FILE_ACCESS_MODE_EXCL
 #define  FS_FAT_MODE_CACHED                      FS_FILE_ACCESS_MODE_CACHED
+#define  FS_FAT_MODE_DIRECT                      FS_FILE_ACCESS_MODE_DIRECT
 #define  FS_FAT_MODE_DEL                         DEF_BIT_07
 #define  FS_FAT_MODE_DIR                         DEF_BIT_08
 #define  FS_FAT_MODE_FILE                        DEF_BIT_09
@@ -129,6 +220,8 @@
 #define  FS_FAT_FAT16_ENTRY_NBR_OCTETS                     2u
 #define  FS_FAT_FAT32_ENTRY_NBR_OCTETS                     4u
 
+#define  FS_FAT_CLUS_VAL_TBL_SIZE                         64u   /* Max nbr of FAT entries rd per ClusValRdSec() call.   */
+
 #define  FS_FAT_VOL_LABEL_LEN                             11u
 
 /*
@@ -315,9 +408,53 @@
 *********************************************************************************************************
 */
 
+/*
+*********************************************************************************************************
+*                                      FAT FILE EXTENT DATA TYPE
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_FILE_EXTENT_MAX > 0u)
+typedef  struct  fs_fat_file_extent {
+    FS_FAT_CLUS_NBR           FileClus;                         /* Ix in file of first clus of extent.                  */
+    FS_FAT_CLUS_NBR           Clus;                             /* Clus nbr of first clus of extent.                    */
+    FS_FAT_CLUS_NBR           Len;                              /* Nbr of contiguous clus in extent.                    */
+} FS_FAT_FILE_EXTENT;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   FAT DIRECTORY HASH INDEX DATA TYPE
+*
+* Note(s) : (1) Each indexed directory entry has a slot for each hash of its name, holding the position
+*               of its first directory entry.  Slots are found by linear probing from the hash; a slot
+*               whose 'Pos.SecNbr' is 0 is free.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+typedef  struct  fs_fat_dir_hash_slot {
+    CPU_INT32U                Hash;                             /* Name hash.                                           */
+    FS_FAT_DIR_POS            Pos;                              /* Pos of entry's first dir entry.                      */
+} FS_FAT_DIR_HASH_SLOT;
+
+typedef  struct  fs_fat_dir_hash {
+    FS_FAT_SEC_NBR            DirFirstSec;                      /* First sec of indexed dir (0 if none).                */
+    CPU_INT32U                UseCtr;                           /* Value of vol's use ctr when last srch'd.             */
+    CPU_INT32U                SlotCnt;                          /* Nbr of used slots.                                   */
+    CPU_BOOLEAN               Full;                             /* Whether dir has too many entries to be indexed.      */
+    FS_FAT_DIR_HASH_SLOT      SlotTbl[FS_FAT_CFG_DIR_HASH_SIZE];/* Hash slots (see Note #1).                            */
+} FS_FAT_DIR_HASH;
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                       FAT FILE DATA DATA TYPE
+*
+* Note(s) : (1) 'ExtentTbl' maps the first clusters of the file's cluster chain, in file order.  Extents
+*               are added as the chain is followed; the map is cleared when the chain is truncated.
 *********************************************************************************************************
 */
 
@@ -337,6 +474,19 @@ struct  fs_fat_file_data {
     FS_FAT_SEC_NBR            FileCurSec;                       /* Sec  nbr of cur   file sec.                          */
     FS_SEC_SIZE               FileCurSecPos;                    /* Pos      of cur   file pos in sec.                   */
 
+#if (FS_FAT_CFG_FILE_EXTENT_MAX > 0u)
+    FS_FAT_FILE_EXTENT        ExtentTbl[FS_FAT_CFG_FILE_EXTENT_MAX];    /* Clus chain extent map (see Note #1).         */
+    FS_FAT_CLUS_NBR           ExtentCnt;                        /* Nbr of extents in map.                               */
+#endif
+
+#if (FS_FAT_CFG_RD_AHEAD_SEC_MAX > 0u)
+    FS_FAT_FILE_SIZE          RdAheadNextPos;                   /* File pos of next sequential rd.                      */
+    FS_FAT_FILE_SIZE          RdAheadEndPos;                    /* File pos of end of secs rd ahead.                    */
+    FS_FAT_SEC_NBR            RdAheadLastSec;                   /* Sec  nbr of last   sec  rd ahead.                    */
+    FS_FAT_SEC_NBR            RdAheadWin;                       /* Rd ahead win, in secs (0 if not sequential).         */
+    FS_FAT_SEC_NBR            RdAheadWinMax;                    /* Max rd ahead win, in secs.                           */
+#endif
+
     FS_FLAGS                  Attrib;                           /* File attrib.                                         */
     FS_FAT_DATE               DateCreate;                       /* File creation date.                                  */
     FS_FAT_TIME               TimeCreate;                       /* File creation time.                                  */
@@ -383,10 +533,27 @@ struct  fs_fat_data {
     CPU_BOOLEAN               QueryInfoValid;                   /* Whether 'QueryClusBadCnt' & 'QueryClusFreeCnt' valid.*/
     FS_FAT_CLUS_NBR           QueryBadClusCnt;                  /* Count of bad  clusters.                              */
     FS_FAT_CLUS_NBR           QueryFreeClusCnt;                 /* Count of free clusters.                              */
+    FS_FAT_CLUS_NBR           QueryScanClusNbr;                 /* Next clus to scan for query info (0 if none scanned).*/
+    FS_FAT_CLUS_NBR           QueryScanBadCnt;                  /* Count of bad  clusters scanned.                      */
+    FS_FAT_CLUS_NBR           QueryScanFreeCnt;                 /* Count of free clusters scanned.                      */
+    CPU_BOOLEAN               VolClean;                         /* Whether FAT32 clean shutdown bit set on vol.         */
+
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+    FS_FAT_CLUS_NBR           FreeMapStart;                     /* First clus covered by free clus map.                 */
+    FS_FAT_CLUS_NBR           FreeMapCnt;                       /* Nbr of clus covered (0 if map not loaded).           */
+    FS_FAT_CLUS_NBR           FreeMapFreeCnt;                   /* Nbr of free clus in map.                             */
+    CPU_INT32U                FreeMap[FS_FAT_FREE_MAP_WORD_NBR];/* Free clus map (bit set if clus not free).            */
+#endif
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+    FS_FAT_DIR_HASH           DirHashTbl[FS_FAT_CFG_DIR_HASH_NBR];      /* Dir name hash indexes.                       */
+    CPU_INT32U                DirHashUseCtr;                    /* Nbr of indexed dir srches.                           */
+#endif
 
 #ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
     CPU_INT08U                JournalState;
     FS_FAT_FILE_DATA         *JournalDataPtr;
+    CPU_INT16U                JournalGroupOpCnt;                /* Nbr of ops not yet committed.                        */
 #endif
 
 #if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
@@ -645,6 +812,24 @@ struct  fs_fat_data {
 #define  FS_FAT_IS_VALID_SEC(p_fat_data, sec_nbr)    ((((sec_nbr) >= (p_fat_data)->RootDirStart) && \
                                                        ((sec_nbr) <= (p_fat_data)->RootDirStart + (p_fat_data)->RootDirSize + (p_fat_data)->DataSize)) ? (DEF_YES) : (DEF_NO))
 
+/*
+*********************************************************************************************************
+*                                       FS_FAT_DIR_HASH_STEP()
+*
+* Description : Add a character to a name hash.
+*
+* Argument(s) : hash        Hash of preceding characters (or FNV-1a offset basis).
+*
+*               val         Character value, case-folded.
+*
+* Return(s)   : Hash.
+*
+* Note(s)     : (1) Names are hashed with 32-bit FNV-1a, one character (not octet) at a time.
+*********************************************************************************************************
+*/
+
+#define  FS_FAT_DIR_HASH_STEP(hash, val)             (((CPU_INT32U)(hash) ^ (CPU_INT32U)(val)) * FS_FAT_DIR_HASH_PRIME)
+
 
 /*
 *********************************************************************************************************
@@ -657,6 +842,10 @@ void             FS_FAT_VolChk                 (CPU_CHAR          *name_vol,
                                                 FS_ERR            *p_err);
 #endif
 
+CPU_BOOLEAN      FS_FAT_VolFreeCntScan         (CPU_CHAR          *name_vol,    /* Scan FAT for free cluster count.     */
+                                                FS_FAT_CLUS_NBR    clus_cnt,
+                                                FS_ERR            *p_err);
+
 /*
 *********************************************************************************************************
 *                                  SYSTEM DRIVER FUNCTION PROTOTYPES
@@ -842,6 +1031,12 @@ FS_FAT_CLUS_NBR  FS_FAT_ClusChainReverseFollow (FS_VOL            *p_vol,
 FS_FAT_CLUS_NBR  FS_FAT_ClusFreeFind           (FS_VOL            *p_vol,       /* Find free cluster.                   */
                                                 FS_BUF            *p_buf,
                                                 FS_ERR            *p_err);
+
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+void             FS_FAT_ClusFreeMapUpdate      (FS_FAT_DATA       *p_fat_data,  /* Update free clus map on FAT entry wr.*/
+                                                FS_FAT_CLUS_NBR    clus,
+                                                FS_FAT_CLUS_NBR    val);
+#endif
 #endif
 
 FS_FAT_CLUS_NBR  FS_FAT_ClusNextGet            (FS_VOL            *p_vol,       /* Get next cluster in chain.           */
@@ -874,6 +1069,15 @@ void             FS_FAT_Query                  (FS_VOL            *p_vol,
                                                 FS_SYS_INFO       *p_info,
                                                 FS_ERR            *p_err);
 
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+void             FS_FAT_DirHashClr             (FS_FAT_DATA       *p_fat_data); /* Clr dir name hash indexes.           */
+
+CPU_BOOLEAN      FS_FAT_DirHashSrch            (FS_VOL            *p_vol,       /* Srch dir name hash index for hash.   */
+                                                FS_FAT_SEC_NBR     dir_first_sec,
+                                                CPU_INT32U         hash,
+                                                CPU_BOOLEAN       *p_found);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -902,6 +1106,38 @@ void             FS_FAT_Query                  (FS_VOL            *p_vol,
 #endif
 
 
+
+#if     (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+#if    ((FS_FAT_CFG_DIR_HASH_SIZE < 4u) || \
+        ((FS_FAT_CFG_DIR_HASH_SIZE & (FS_FAT_CFG_DIR_HASH_SIZE - 1u)) != 0u))
+#error  "FS_FAT_CFG_DIR_HASH_SIZE       illegally #define'd in 'fs_cfg.h'    "
+#error  "                               [MUST be a power of 2,  >= 4       ]"
+#endif
+#endif
+
+
+
+#if    ((FS_FAT_CFG_SFN_TAIL_NUM_MAX < 1u) || \
+        (FS_FAT_CFG_SFN_TAIL_NUM_MAX > 999u))
+#error  "FS_FAT_CFG_SFN_TAIL_NUM_MAX    illegally #define'd in 'fs_cfg.h'    "
+#error  "                               [MUST be  >= 1 && <= 999           ]"
+#endif
+
+
+
+#if    ((FS_FAT_CFG_JOURNAL_GROUP_OP_MAX < 1u) || \
+        (FS_FAT_CFG_JOURNAL_GROUP_OP_MAX > 65535u))
+#error  "FS_FAT_CFG_JOURNAL_GROUP_OP_MAX illegally #define'd in 'fs_cfg.h'   "
+#error  "                               [MUST be  >= 1 && <= 65535         ]"
+#endif
+
+#if    ((FS_FAT_CFG_JOURNAL_GROUP_SIZE < 512u) || \
+        (FS_FAT_CFG_JOURNAL_GROUP_SIZE > 8192u))
+#error  "FS_FAT_CFG_JOURNAL_GROUP_SIZE  illegally #define'd in 'fs_cfg.h'    "
+#error  "                               [MUST be  >= 512 && <= 8192        ]"
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
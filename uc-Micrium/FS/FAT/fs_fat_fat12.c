@@ -129,6 +129,13 @@ static  FS_FAT_CLUS_NBR  FS_FAT_FAT12_ClusValRd       (FS_VOL           *p_vol,
                                                        FS_FAT_CLUS_NBR   clus,
                                                        FS_ERR           *p_err);
 
+static  FS_FAT_CLUS_NBR  FS_FAT_FAT12_ClusValRdSec    (FS_VOL           *p_vol,     /* Read values from clusters.       */
+                                                       FS_BUF           *p_buf,
+                                                       FS_FAT_CLUS_NBR   clus,
+                                                       FS_FAT_CLUS_NBR   clus_cnt,
+                                                       FS_FAT_CLUS_NBR  *p_val_tbl,
+                                                       FS_ERR           *p_err);
+
 
 /*
 *********************************************************************************************************
@@ -141,6 +148,7 @@ const  FS_FAT_TYPE_API  FS_FAT_FAT12_API = {
     FS_FAT_FAT12_ClusValWr,
 #endif
     FS_FAT_FAT12_ClusValRd,
+    FS_FAT_FAT12_ClusValRdSec,
 
     FS_FAT_FAT12_CLUS_BAD,
     FS_FAT_FAT12_CLUS_EOF,
@@ -204,6 +212,9 @@ static  void  FS_FAT_FAT12_ClusValWr (FS_VOL           *p_vol,
 
 
     p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+    FS_FAT_ClusFreeMapUpdate(p_fat_data, clus, val);            /* Keep free clus map cur.                              */
+#endif
 
     fat_start_sec  =  p_fat_data->FAT1_Start;
     fat_offset     = (FS_SEC_SIZE)clus + ((FS_SEC_SIZE)clus / 2u);
@@ -389,6 +400,109 @@ static  FS_FAT_CLUS_NBR  FS_FAT_FAT12_ClusValRd (FS_VOL           *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FS_FAT_FAT12_ClusValRdSec()
+*
+* Description : Read values of consecutive clusters whose entries lie in one FAT sector.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+*               p_buf       Pointer to temporary buffer.
+*
+*               clus        First cluster to read.
+*
+*               clus_cnt    Maximum number of clusters to read.
+*
+*               p_val_tbl   Pointer to table that will receive the cluster values.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE    Clusters read.
+*                               FS_ERR_DEV     Device error.
+*
+* Return(s)   : Number of cluster values read (at least 1, unless an error occurred).
+*
+* Note(s)     : (1) Reading stops before the first entry that does not lie wholly in the FAT sector holding
+*                   the entry of 'clus'.  An entry of 'clus' split between two sectors is read on its own.
+*
+*               (2) Each 3 octets hold 2 entries :  the 1st in the low octet & low nibble of the middle
+*                   octet, the 2nd in the high nibble of the middle octet & the high octet.
+*********************************************************************************************************
+*/
+static  FS_FAT_CLUS_NBR  FS_FAT_FAT12_ClusValRdSec (FS_VOL           *p_vol,
+                                                    FS_BUF           *p_buf,
+                                                    FS_FAT_CLUS_NBR   clus,
+                                                    FS_FAT_CLUS_NBR   clus_cnt,
+                                                    FS_FAT_CLUS_NBR  *p_val_tbl,
+                                                    FS_ERR           *p_err)
+{
+    FS_SEC_SIZE       fat_offset;
+    FS_FAT_SEC_NBR    fat_sec;
+    FS_SEC_SIZE       fat_sec_offset;
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   ix;
+    CPU_INT08U       *p_entry_08;
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    fat_offset     = (FS_SEC_SIZE)clus + ((FS_SEC_SIZE)clus / 2u);
+    fat_sec        =  p_fat_data->FAT1_Start + (FS_FAT_SEC_NBR)FS_UTIL_DIV_PWR2(fat_offset, p_fat_data->SecSizeLog2);
+    fat_sec_offset =  fat_offset & (p_fat_data->SecSize - 1u);
+
+    if (fat_sec_offset == p_fat_data->SecSize - 1u) {           /* ------------------- RD SPLIT ENTRY ----------------- */
+        p_val_tbl[0] = FS_FAT_FAT12_ClusValRd(p_vol,            /* See Note #1.                                         */
+                                              p_buf,
+                                              clus,
+                                              p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (0u);
+        }
+        return (1u);
+    }
+
+    FSBuf_Set(p_buf,
+              fat_sec,
+              FS_VOL_SEC_TYPE_MGMT,
+              DEF_YES,
+              p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+    p_entry_08 = (CPU_INT08U *)p_buf->DataPtr + fat_sec_offset;
+    ix         =  0u;
+    if ((FS_UTIL_IS_ODD(clus) == DEF_YES) && (clus_cnt > 0u)) { /* ----------------- RD ODD 1ST ENTRY ----------------- */
+        p_val_tbl[0]    = ((FS_FAT_CLUS_NBR)p_entry_08[0] >> DEF_NIBBLE_NBR_BITS) |
+                          ((FS_FAT_CLUS_NBR)p_entry_08[1] << DEF_NIBBLE_NBR_BITS);
+        p_entry_08     += 2u;
+        fat_sec_offset += 2u;
+        ix              = 1u;
+    }
+                                                                /* ------------- UNPACK ENTRY PAIRS (Note #2) --------- */
+    while ((ix + 2u <= clus_cnt) &&
+           (fat_sec_offset + 2u < p_fat_data->SecSize)) {
+        p_val_tbl[ix]      =  (FS_FAT_CLUS_NBR)p_entry_08[0] |
+                             (((FS_FAT_CLUS_NBR)p_entry_08[1] & DEF_NIBBLE_MASK) << DEF_OCTET_NBR_BITS);
+        p_val_tbl[ix + 1u] = ((FS_FAT_CLUS_NBR)p_entry_08[1] >> DEF_NIBBLE_NBR_BITS) |
+                              ((FS_FAT_CLUS_NBR)p_entry_08[2] << DEF_NIBBLE_NBR_BITS);
+        p_entry_08        += 3u;
+        fat_sec_offset    += 3u;
+        ix                += 2u;
+    }
+                                                                /* ----------------- RD EVEN LAST ENTRY --------------- */
+    if ((ix < clus_cnt) &&
+        (fat_sec_offset + 1u < p_fat_data->SecSize)) {
+        p_val_tbl[ix] =  (FS_FAT_CLUS_NBR)p_entry_08[0] |
+                        (((FS_FAT_CLUS_NBR)p_entry_08[1] & DEF_NIBBLE_MASK) << DEF_OCTET_NBR_BITS);
+        ix++;
+    }
+
+    return (ix);
+}
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
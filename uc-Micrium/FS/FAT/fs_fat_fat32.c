@@ -130,6 +130,13 @@ static  FS_FAT_CLUS_NBR  FS_FAT_FAT32_ClusValRd       (FS_VOL           *p_vol,
                                                        FS_FAT_CLUS_NBR   clus,
                                                        FS_ERR           *p_err);
 
+static  FS_FAT_CLUS_NBR  FS_FAT_FAT32_ClusValRdSec    (FS_VOL           *p_vol,     /* Read values from clusters.       */
+                                                       FS_BUF           *p_buf,
+                                                       FS_FAT_CLUS_NBR   clus,
+                                                       FS_FAT_CLUS_NBR   clus_cnt,
+                                                       FS_FAT_CLUS_NBR  *p_val_tbl,
+                                                       FS_ERR           *p_err);
+
 
 /*
 *********************************************************************************************************
@@ -142,6 +149,7 @@ const  FS_FAT_TYPE_API  FS_FAT_FAT32_API = {
     FS_FAT_FAT32_ClusValWr,
 #endif
     FS_FAT_FAT32_ClusValRd,
+    FS_FAT_FAT32_ClusValRdSec,
 
     FS_FAT_FAT32_CLUS_BAD,
     FS_FAT_FAT32_CLUS_EOF,
@@ -206,6 +214,9 @@ static  void  FS_FAT_FAT32_ClusValWr (FS_VOL           *p_vol,
 
 
     p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+#if (FS_FAT_CFG_FREE_MAP_SIZE > 0u)
+    FS_FAT_ClusFreeMapUpdate(p_fat_data, clus, val);            /* Keep free clus map cur.                              */
+#endif
 
     fat_start_sec  =  p_fat_data->FAT1_Start;
     fat_offset     = (FS_SEC_SIZE)clus * FS_FAT_FAT32_ENTRY_NBR_OCTETS;
@@ -291,6 +302,82 @@ static  FS_FAT_CLUS_NBR  FS_FAT_FAT32_ClusValRd (FS_VOL           *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                       FS_FAT_FAT32_ClusValRdSec()
+*
+* Description : Read values of consecutive clusters whose entries lie in one FAT sector.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*
+*               p_buf       Pointer to temporary buffer.
+*
+*               clus        First cluster to read.
+*
+*               clus_cnt    Maximum number of clusters to read.
+*
+*               p_val_tbl   Pointer to table that will receive the cluster values.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE    Clusters read.
+*                               FS_ERR_DEV     Device error.
+*
+* Return(s)   : Number of cluster values read (at least 1, unless an error occurred).
+*
+* Note(s)     : (1) Reading stops at the end of the FAT sector holding the entry of 'clus'.  Entries are
+*                   4-octet aligned in the sector buffer & are loaded as words on little-endian CPUs.
+*
+*               (2) See 'FS_FAT_FAT32_ClusValRd()  Note #1'.
+*********************************************************************************************************
+*/
+static  FS_FAT_CLUS_NBR  FS_FAT_FAT32_ClusValRdSec (FS_VOL           *p_vol,
+                                                    FS_BUF           *p_buf,
+                                                    FS_FAT_CLUS_NBR   clus,
+                                                    FS_FAT_CLUS_NBR   clus_cnt,
+                                                    FS_FAT_CLUS_NBR  *p_val_tbl,
+                                                    FS_ERR           *p_err)
+{
+    FS_SEC_SIZE       fat_offset;
+    FS_FAT_SEC_NBR    fat_sec;
+    FS_SEC_SIZE       fat_sec_offset;
+    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_CLUS_NBR   cnt;
+    FS_FAT_CLUS_NBR   ix;
+    CPU_INT32U       *p_entry_32;
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    fat_offset     = (FS_SEC_SIZE)clus * FS_FAT_FAT32_ENTRY_NBR_OCTETS;
+    fat_sec        =  p_fat_data->FAT1_Start + (FS_FAT_SEC_NBR)FS_UTIL_DIV_PWR2(fat_offset, p_fat_data->SecSizeLog2);
+    fat_sec_offset =  fat_offset & (p_fat_data->SecSize - 1u);
+
+    cnt = (FS_FAT_CLUS_NBR)((p_fat_data->SecSize - fat_sec_offset) / FS_FAT_FAT32_ENTRY_NBR_OCTETS);
+    cnt =  DEF_MIN(cnt, clus_cnt);                              /* See Note #1.                                         */
+
+    FSBuf_Set(p_buf,
+              fat_sec,
+              FS_VOL_SEC_TYPE_MGMT,
+              DEF_YES,
+              p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+    p_entry_32 = (CPU_INT32U *)((CPU_INT08U *)p_buf->DataPtr + fat_sec_offset);
+    for (ix = 0u; ix < cnt; ix++) {                             /* See Note #2.                                         */
+#if (CPU_CFG_ENDIAN_TYPE == CPU_ENDIAN_TYPE_LITTLE)
+        p_val_tbl[ix] = p_entry_32[ix] & FS_FAT_FAT32_CLUS_MASK;
+#else
+        p_val_tbl[ix] = MEM_VAL_GET_INT32U_LITTLE((void *)&p_entry_32[ix]) & FS_FAT_FAT32_CLUS_MASK;
+#endif
+    }
+
+    return (cnt);
+}
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
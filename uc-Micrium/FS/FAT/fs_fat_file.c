@@ -69,9 +69,17 @@
 /*
 *********************************************************************************************************
 *                                            LOCAL DEFINES
+*
+* Note(s) : (1) Sectors are read ahead into the volume cache (see 'FS_FAT_FileRdAhead()').
 *********************************************************************************************************
 */
 
+#if ((FS_FAT_CFG_RD_AHEAD_SEC_MAX > 0u) && defined(FS_CACHE_MODULE_PRESENT))
+#define  FS_FAT_FILE_RD_AHEAD_EN                 DEF_ENABLED    /* See Note #1.                                         */
+#else
+#define  FS_FAT_FILE_RD_AHEAD_EN                 DEF_DISABLED
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -116,6 +124,39 @@ static  MEM_POOL  FS_FAT_FileDataPool;
 *********************************************************************************************************
 */
 
+#if (FS_FAT_CFG_FILE_EXTENT_MAX > 0u)
+static  FS_FAT_CLUS_NBR  FS_FAT_FileClusGet (FS_FILE           *p_file,  /* Get clus at ix in file's clus chain.         */
+                                             FS_BUF            *p_buf,
+                                             FS_FAT_CLUS_NBR    clus_ix,
+                                             FS_ERR            *p_err);
+#endif
+
+#if (FS_FAT_FILE_RD_AHEAD_EN == DEF_ENABLED)
+static  void  FS_FAT_FileRdAhead     (FS_FILE           *p_file,        /* Rd secs ahead of sequential file rd.     */
+                                      FS_BUF            *p_buf,
+                                      FS_FAT_FILE_SIZE   pos_rd,
+                                      FS_FAT_SEC_NBR     sec_cur,
+                                      FS_FAT_SEC_NBR     sec_cur_pos);
+
+static  void  FS_FAT_FileRdAheadClr  (FS_FAT_FILE_DATA  *p_fat_file_data);  /* Clr rd ahead state.                   */
+#endif
+
+static  void  FS_FAT_FileSecRd       (FS_FILE           *p_file,        /* Rd run of file secs.                     */
+                                      void              *p_dest,
+                                      FS_FAT_SEC_NBR     sec_start,
+                                      FS_FAT_SEC_NBR     sec_cnt,
+                                      CPU_BOOLEAN        direct,
+                                      FS_ERR            *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_FileSecWr       (FS_FILE           *p_file,        /* Wr run of file secs.                     */
+                                      void              *p_src,
+                                      FS_FAT_SEC_NBR     sec_start,
+                                      FS_FAT_SEC_NBR     sec_cnt,
+                                      CPU_BOOLEAN        direct,
+                                      FS_ERR            *p_err);
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -250,6 +291,179 @@ void  FS_FAT_FileClose  (FS_FILE  *p_file,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FS_FAT_FileMap()
+*
+* Description : Map file data, from the file position, in memory.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               size        Maximum number of octets to map.
+*
+*               pp_data     Pointer to variable that will receive the address of the mapped data.
+*               -------     Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File data mapped, or file position at EOF.
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV_INVALID_IO_CTRL    Device cannot map sectors.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
+*
+* Return(s)   : Number of octets mapped, if file data mapped.
+*               0,                       otherwise.
+*
+* Note(s)     : (1) The octets mapped are the longest run, from the file position, held in contiguous
+*                   sectors of the volume that the device stores contiguously in memory (see
+*                   'FSVol_MapLocked()').  Fewer than 'size' octets may thus be mapped before the end of the
+*                   file; the file position is advanced past the octets mapped, so that the next call maps
+*                   the following run.
+*
+*               (2) See 'FS_FAT_FileRd()  Note #1'.
+*
+*               (3) A sector the device holds no data for (e.g., a NOR sector never written) is not stored
+*                   in memory; the device is reported as unable to map it, so that the caller reads it.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FS_FAT_FileMap (FS_FILE      *p_file,
+                            CPU_SIZE_T    size,
+                            void        **pp_data,
+                            FS_ERR       *p_err)
+{
+    FS_FAT_SEC_NBR     clus_cur_sec_rem;
+    FS_FAT_SEC_NBR     sec_cnt;
+    FS_FAT_SEC_NBR     sec_cnt_rem;
+    FS_FAT_SEC_NBR     sec_cur;
+    FS_FAT_SEC_NBR     sec_cur_pos;
+    FS_FAT_SEC_NBR     sec_next;
+    FS_FAT_SEC_NBR     sec_end;
+    FS_SEC_QTY         map_cnt;
+    CPU_SIZE_T         size_map;
+    CPU_SIZE_T         pos_end;
+    FS_BUF            *p_buf;
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_fat_file_data;
+    CPU_INT08U        *p_data_08;
+
+
+   *pp_data = (void *)0;
+                                                                /* ------------------ PREPARE FOR MAP ----------------- */
+    p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
+    p_fat_data      = (FS_FAT_DATA      *)(p_file->VolPtr->DataPtr);
+
+                                                                /* If first sec zero (no data) or file pos past EOF ... */
+    if ((p_fat_file_data->FileFirstClus == 0u)                        ||
+        (p_fat_file_data->FilePos       >= p_fat_file_data->FileSize)) {
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+                                                                /* Truncate file map to file rem.                       */
+    if (size > (p_fat_file_data->FileSize - p_fat_file_data->FilePos)) {
+        size = (p_fat_file_data->FileSize - p_fat_file_data->FilePos);
+    }
+
+    if (size == 0u) {
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+
+    p_buf = FSBuf_Get(p_file->VolPtr);                          /* Get buf for FAT lookups.                             */
+    if (p_buf == (FS_BUF *)0) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return (0u);
+    }
+
+    sec_cur     = p_fat_file_data->FileCurSec;
+    sec_cur_pos = p_fat_file_data->FileCurSecPos;
+
+    if (sec_cur_pos == p_fat_data->SecSize) {                   /* Sec pos at end of sec (see Note #2).                 */
+        sec_cur_pos = 0u;
+        sec_cur     = FS_FAT_SecNextGet(p_file->VolPtr,
+                                        p_buf,
+                                        sec_cur,
+                                        p_err);
+
+        if (*p_err != FS_ERR_NONE) {
+            if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END) ||
+                (*p_err == FS_ERR_SYS_CLUS_INVALID)) {
+                 *p_err =  FS_ERR_ENTRY_CORRUPT;
+            }
+            FSBuf_Free(p_buf);
+            return (0u);
+        }
+    }
+
+
+
+                                                                /* ---------------- CNT CONTIGUOUS SECS --------------- */
+    pos_end          = sec_cur_pos + size + p_fat_data->SecSize - 1u;
+    sec_cnt_rem      = (FS_FAT_SEC_NBR)FS_UTIL_DIV_PWR2(pos_end, p_fat_data->SecSizeLog2);
+    clus_cur_sec_rem = FS_FAT_CLUS_SEC_REM(p_fat_data, sec_cur);
+    sec_cnt          = 0u;
+    sec_next         = 0u;
+    do {
+        sec_cnt += DEF_MIN(sec_cnt_rem - sec_cnt, clus_cur_sec_rem);
+
+        if ((sec_cnt_rem - sec_cnt) > 0u) {
+            sec_next = FS_FAT_SecNextGet(p_file->VolPtr,
+                                         p_buf,
+                                         sec_cur + sec_cnt - 1u,
+                                         p_err);
+            if (*p_err != FS_ERR_NONE) {
+                if ((*p_err == FS_ERR_SYS_CLUS_CHAIN_END) ||
+                    (*p_err == FS_ERR_SYS_CLUS_INVALID)) {
+                     *p_err =  FS_ERR_ENTRY_CORRUPT;
+                }
+                FSBuf_Free(p_buf);
+                return (0u);
+            }
+
+            clus_cur_sec_rem = p_fat_data->ClusSize_sec;
+        }
+    } while (((sec_cnt_rem - sec_cnt) >   0u) &&
+              (sec_next               == (sec_cur + sec_cnt)));
+
+    FSBuf_Free(p_buf);
+
+
+
+                                                                /* --------------------- MAP SECS --------------------- */
+    p_data_08 = (CPU_INT08U *)FSVol_MapLocked(p_file->VolPtr,
+                                              sec_cur,
+                                              sec_cnt,
+                                             &map_cnt,
+                                              p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+    if (map_cnt == 0u) {                                        /* See Note #3.                                         */
+       *p_err = FS_ERR_DEV_INVALID_IO_CTRL;
+        return (0u);
+    }
+
+    size_map = FS_UTIL_MULT_PWR2((CPU_SIZE_T)map_cnt, p_fat_data->SecSizeLog2) - sec_cur_pos;
+    size_map = DEF_MIN(size_map, size);
+   *pp_data  = (void *)(p_data_08 + sec_cur_pos);
+
+
+
+                                                                /* ----------------- UPDATE FILE INFO ----------------- */
+    pos_end                         =  sec_cur_pos + size_map;  /* Sec holding last octet mapped (see Note #2).         */
+    sec_end                         = (FS_FAT_SEC_NBR)FS_UTIL_DIV_PWR2(pos_end - 1u, p_fat_data->SecSizeLog2);
+    p_fat_file_data->FileCurSec     =  sec_cur + sec_end;
+    p_fat_file_data->FileCurSecPos  = (FS_FAT_SEC_NBR)(pos_end - FS_UTIL_MULT_PWR2(sec_end, p_fat_data->SecSizeLog2));
+    p_fat_file_data->FilePos       += size_map;
+
+   *p_err = FS_ERR_NONE;
+
+    return (size_map);
+}
+
+
 /*
 *********************************************************************************************************
 *                                          FS_FAT_FileOpen()
@@ -438,6 +652,9 @@ void  FS_FAT_FileOpen (FS_FILE   *p_file,
 *               (4) Position can only be set in the existing portion of a file. If the position is set
 *                   after the file size, the code must call FS_FAT_FileWr() instead to correctly
 *                   allocate clusters and fill data region with '0'.
+*
+*               (5) The cluster is looked up in the file's extent map, so that seeking in a large file
+*                   does not read every FAT entry from the start of its cluster chain.
 *********************************************************************************************************
 */
 
@@ -519,12 +736,19 @@ void  FS_FAT_FilePosSet (FS_FILE       *p_file,
 
     } else {                                                    /* ----- POS BEFORE LAST CLUS, NOT FIRST, NOT CUR ----- */
                                                                 /* Move to last known clus.                             */
+#if (FS_FAT_CFG_FILE_EXTENT_MAX > 0u)
+        clus = FS_FAT_FileClusGet(p_file,                       /* See Note #5.                                         */
+                                  p_buf,
+                                 (clus_cnt_new - 1u),
+                                  p_err);
+#else
         clus = FS_FAT_ClusChainFollow(p_file->VolPtr,
                                       p_buf,
                                       p_fat_file_data->FileFirstClus,
                                      (clus_cnt_new - 1u),
                                       DEF_NULL,
                                       p_err);
+#endif
 
         if (*p_err != FS_ERR_NONE) {
              FSBuf_Free(p_buf);
@@ -654,6 +878,13 @@ void  FS_FAT_FileQuery (FS_FILE        *p_file,
 *                   reaches the end of a sector.  In this case, 'FileCurSecPos' will equal the sector
 *                   size; such a condition MUST be checked at the beginning of any file read/write so
 *                   that the current sector number can be determined.
+*
+*               (2) Once the read completes, sectors following it may be read ahead into the volume
+*                   cache; a failed read ahead does not fail the read.
+*
+*               (3) The whole clusters of a read of a file opened with FS_FILE_ACCESS_MODE_DIRECT, or of
+*                   a read of FS_FAT_CFG_FILE_DIRECT_SIZE_MIN octets or more, are read around the volume
+*                   cache (see 'FS_FAT_FileSecRd()'); such a read is not followed by a read ahead.
 *********************************************************************************************************
 */
 
@@ -675,6 +906,10 @@ CPU_SIZE_T  FS_FAT_FileRd (FS_FILE     *p_file,
     FS_FAT_DATA       *p_fat_data;
     FS_FAT_FILE_DATA  *p_fat_file_data;
     CPU_INT08U        *p_temp_08;
+    CPU_BOOLEAN        direct;
+#if (FS_FAT_FILE_RD_AHEAD_EN == DEF_ENABLED)
+    FS_FAT_FILE_SIZE   pos_rd;
+#endif
 
 
                                                                 /* ------------------ PREPARE FOR RD ------------------ */
@@ -706,6 +941,15 @@ CPU_SIZE_T  FS_FAT_FileRd (FS_FILE     *p_file,
     }
 
     size_rem         = size;
+    direct           = DEF_BIT_IS_SET(p_fat_file_data->Mode, FS_FAT_MODE_DIRECT);
+#if (FS_FAT_CFG_FILE_DIRECT_SIZE_MIN > 0u)                      /* See Note #3.                                         */
+    if (size >= FS_FAT_CFG_FILE_DIRECT_SIZE_MIN) {
+        direct = DEF_YES;
+    }
+#endif
+#if (FS_FAT_FILE_RD_AHEAD_EN == DEF_ENABLED)
+    pos_rd           = p_fat_file_data->FilePos;
+#endif
     sec_cur          = p_fat_file_data->FileCurSec;
     sec_cur_pos      = p_fat_file_data->FileCurSecPos;
     clus_cur_sec_rem = FS_FAT_CLUS_SEC_REM(p_fat_data, sec_cur);
@@ -818,11 +1062,11 @@ CPU_SIZE_T  FS_FAT_FileRd (FS_FILE     *p_file,
                       (sec_next                  == (sec_cur + sec_cnt_rd)));
 
 
-            FSVol_RdLockedEx(        p_file->VolPtr,            /* Rd full sec's.                                       */
+            FS_FAT_FileSecRd(        p_file,                    /* Rd full sec's.                                       */
                              (void *)p_dest_08,
                                      sec_cur,
                                      sec_cnt_rd,
-                                     FS_VOL_SEC_TYPE_FILE,
+                                     direct,
                                      p_err);
 
             if (*p_err != FS_ERR_NONE) {
@@ -893,6 +1137,16 @@ CPU_SIZE_T  FS_FAT_FileRd (FS_FILE     *p_file,
     p_fat_file_data->FileCurSecPos  = sec_cur_pos;
     p_fat_file_data->FilePos       += size;
 
+#if (FS_FAT_FILE_RD_AHEAD_EN == DEF_ENABLED)                   /* See Note #2.                                         */
+    if (direct == DEF_NO) {                                     /* See Note #3.                                         */
+        FS_FAT_FileRdAhead(p_file,
+                           p_buf,
+                           pos_rd,
+                           sec_cur,
+                           sec_cur_pos);
+    }
+#endif
+
     FSBuf_Free(p_buf);
 
    *p_err = FS_ERR_NONE;
@@ -901,6 +1155,43 @@ CPU_SIZE_T  FS_FAT_FileRd (FS_FILE     *p_file,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FS_FAT_FileSync()
+*
+* Description : Commit the journaled operations of a file's volume.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              Operations committed.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Journaled operations are committed in groups (see 'fs_fat_journal.c
+*                   FS_FAT_JournalClrReset() Note #2'); a file flush commits the group, so that the
+*                   operations completed before it survive a failure.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FS_FAT_FileSync (FS_FILE  *p_file,
+                       FS_ERR   *p_err)
+{
+#ifdef  FS_FAT_JOURNAL_MODULE_PRESENT
+    FS_FAT_JournalSync(p_file->VolPtr, p_err);                  /* See Note #1.                                         */
+#else
+    (void)p_file;
+   *p_err = FS_ERR_NONE;
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                        FS_FAT_FileTruncate()
@@ -946,6 +1237,12 @@ void  FS_FAT_FileTruncate (FS_FILE       *p_file,
 
                                                                 /* ------------------- SET FILE POS ------------------- */
     p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
+#if (FS_FAT_CFG_FILE_EXTENT_MAX > 0u)
+    p_fat_file_data->ExtentCnt = 0u;                            /* Clus may be freed (see 'fs_fat.h  FAT FILE DATA').   */
+#endif
+#if (FS_FAT_FILE_RD_AHEAD_EN == DEF_ENABLED)
+    FS_FAT_FileRdAheadClr(p_fat_file_data);                     /* Rd ahead secs may be freed.                          */
+#endif
 
     if ((p_fat_file_data->FileFirstClus == 0u) &&               /* If no data clus's assigned to file      ...          */
         (size                           == 0u)) {               /* ... & file should be truncated to 0 len ...          */
@@ -1056,6 +1353,9 @@ void  FS_FAT_FileTruncate (FS_FILE       *p_file,
 *
 *               (4) The chain follow operation will overwrite the data stored in the buffer, so the
 *                   buffer MUST be flushed before this operation is performed.
+*
+*               (5) See 'FS_FAT_FileRd()  Note #3'.  The whole clusters written are written around the
+*                   volume cache (see 'FS_FAT_FileSecWr()').
 *********************************************************************************************************
 */
 
@@ -1088,6 +1388,7 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
     CPU_INT08U        *p_temp_08;
     FS_FAT_DATA       *p_fat_data;
     FS_FAT_FILE_DATA  *p_fat_file_data;
+    CPU_BOOLEAN        direct;
 
 
 
@@ -1100,6 +1401,15 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
     p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
     p_fat_data      = (FS_FAT_DATA      *)(p_file->VolPtr->DataPtr);
     p_src_08        = (CPU_INT08U       *)(p_src);
+    direct          =  DEF_BIT_IS_SET(p_fat_file_data->Mode, FS_FAT_MODE_DIRECT);
+#if (FS_FAT_CFG_FILE_DIRECT_SIZE_MIN > 0u)                      /* See Note #5.                                         */
+    if (size >= FS_FAT_CFG_FILE_DIRECT_SIZE_MIN) {
+        direct = DEF_YES;
+    }
+#endif
+#if (FS_FAT_FILE_RD_AHEAD_EN == DEF_ENABLED)
+    FS_FAT_FileRdAheadClr(p_fat_file_data);                     /* Wr ends sequential rd.                               */
+#endif
 
 
                                                                 /* ----------------- ALLOC CLUS CHAIN ----------------- */
@@ -1314,12 +1624,12 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
                       (sec_next                  == (sec_cur + sec_cnt_wr)));
 
 
-            FSVol_WrLockedEx(        p_file->VolPtr,            /* Wr full sec's.                                       */
-                 (void *)p_src_08,
-                         sec_cur,
-                         sec_cnt_wr,
-                         FS_VOL_SEC_TYPE_FILE,
-                         p_err);
+            FS_FAT_FileSecWr(        p_file,                    /* Wr full sec's.                                       */
+                             (void *)p_src_08,
+                                     sec_cur,
+                                     sec_cnt_wr,
+                                     direct,
+                                     p_err);
 
             if (*p_err != FS_ERR_NONE) {
                 FSBuf_Free(p_buf);
@@ -1444,6 +1754,537 @@ CPU_SIZE_T  FS_FAT_FileWr (FS_FILE     *p_file,
 #endif
 
 
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_FileClusGet()
+*
+* Description : Get cluster at a given index in a file's cluster chain, using the file's extent map.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ----------  Argument validated by caller.
+*
+*               p_buf       Pointer to temporary buffer.
+*               ----------  Argument validated by caller.
+*
+*               clus_ix     Index of cluster in file (0 for the first cluster).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                        Cluster found.
+*
+*                                                                  ---- RETURNED BY FS_FAT_ClusChainFollow() ----
+*                               FS_ERR_SYS_CLUS_CHAIN_END_EARLY    Cluster chain ended early.
+*                               FS_ERR_SYS_CLUS_INVALID            Invalid cluster found.
+*
+* Return(s)   : Cluster number, if found;
+*               0,              otherwise.
+*
+* Note(s)     : (1) A cluster within the map is found by binary search over the extents.  Otherwise, the
+*                   chain is followed from the last mapped cluster & the clusters followed are added to
+*                   the map, the last extent growing while clusters are contiguous.
+*
+*               (2) Once the map is full, clusters past its last extent are still followed from the end
+*                   of the map, but no longer recorded.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_CFG_FILE_EXTENT_MAX > 0u)
+static  FS_FAT_CLUS_NBR  FS_FAT_FileClusGet (FS_FILE          *p_file,
+                                             FS_BUF           *p_buf,
+                                             FS_FAT_CLUS_NBR   clus_ix,
+                                             FS_ERR           *p_err)
+{
+    FS_FAT_FILE_DATA    *p_fat_file_data;
+    FS_FAT_FILE_EXTENT  *p_extent;
+    FS_FAT_CLUS_NBR      clus_cur;
+    FS_FAT_CLUS_NBR      clus_next;
+    FS_FAT_CLUS_NBR      clus_ix_cur;
+    FS_FAT_CLUS_NBR      ix_lo;
+    FS_FAT_CLUS_NBR      ix_hi;
+    FS_FAT_CLUS_NBR      ix_mid;
+
+
+    p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
+
+    if (p_fat_file_data->ExtentCnt == 0u) {                     /* Map starts at first clus.                            */
+        p_extent                   = &p_fat_file_data->ExtentTbl[0];
+        p_extent->FileClus         =  0u;
+        p_extent->Clus             =  p_fat_file_data->FileFirstClus;
+        p_extent->Len              =  1u;
+        p_fat_file_data->ExtentCnt =  1u;
+    }
+
+                                                                /* ------------------ SRCH EXTENT MAP ----------------- */
+    p_extent = &p_fat_file_data->ExtentTbl[p_fat_file_data->ExtentCnt - 1u];
+    if (clus_ix < p_extent->FileClus + p_extent->Len) {         /* See Note #1.                                         */
+        ix_lo = 0u;
+        ix_hi = p_fat_file_data->ExtentCnt - 1u;
+        while (ix_lo < ix_hi) {
+            ix_mid = (ix_lo + ix_hi + 1u) / 2u;
+            if (p_fat_file_data->ExtentTbl[ix_mid].FileClus <= clus_ix) {
+                ix_lo = ix_mid;
+            } else {
+                ix_hi = ix_mid - 1u;
+            }
+        }
+        p_extent = &p_fat_file_data->ExtentTbl[ix_lo];
+       *p_err    =  FS_ERR_NONE;
+        return (p_extent->Clus + (clus_ix - p_extent->FileClus));
+    }
+
+                                                                /* ---------------- FOLLOW & ADD TO MAP --------------- */
+    clus_cur    = p_extent->Clus     + p_extent->Len - 1u;
+    clus_ix_cur = p_extent->FileClus + p_extent->Len - 1u;
+    while (clus_ix_cur < clus_ix) {
+        clus_next = FS_FAT_ClusChainFollow(p_file->VolPtr,
+                                           p_buf,
+                                           clus_cur,
+                                           1u,
+                                           DEF_NULL,
+                                           p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (0u);
+        }
+        clus_ix_cur++;
+
+        if (p_extent != DEF_NULL) {
+            if (clus_next == clus_cur + 1u) {                   /* Grow last extent ...                                 */
+                p_extent->Len++;
+            } else if (p_fat_file_data->ExtentCnt < FS_FAT_CFG_FILE_EXTENT_MAX) {
+                p_extent           = &p_fat_file_data->ExtentTbl[p_fat_file_data->ExtentCnt];
+                p_extent->FileClus =  clus_ix_cur;              /* ... or start new extent ...                          */
+                p_extent->Clus     =  clus_next;
+                p_extent->Len      =  1u;
+                p_fat_file_data->ExtentCnt++;
+            } else {
+                p_extent = DEF_NULL;                            /* ... or stop recording (see Note #2).                 */
+            }
+        }
+        clus_cur = clus_next;
+    }
+
+   *p_err = FS_ERR_NONE;
+    return (clus_cur);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_FileRdAhead()
+*
+* Description : Read sectors ahead of a sequential file read into the volume cache.
+*
+* Argument(s) : p_file          Pointer to a file.
+*               ----------      Argument validated by caller.
+*
+*               p_buf           Pointer to temporary buffer.
+*               ----------      Argument validated by caller.
+*
+*               pos_rd          File position at which the read started.
+*
+*               sec_cur         Sector holding the file position after the read.
+*
+*               sec_cur_pos     Position of the file position in 'sec_cur' (see 'FS_FAT_FileRd()  Note #1').
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) A read starting where the previous one ended is sequential & opens the read ahead
+*                   window at FS_FAT_RD_AHEAD_SEC_MIN sectors; the window then doubles each time sectors
+*                   are read ahead, up to FS_FAT_CFG_RD_AHEAD_SEC_MAX sectors.  Any other read (i.e.,
+*                   after a seek) closes the window, so that random reads cost no extra device access.
+*
+*               (2) New sectors are read ahead only once fewer than half the window remains ahead of the
+*                   file position, so that the device sees few, large requests rather than one request
+*                   per read.  A single device request is issued per call.  The cache reads fewer
+*                   sectors than requested when it cannot hold more (see 'fs_cache.c  FSCache_RdAhead()
+*                   Note #2'); the window is then limited to the sectors it holds.
+*
+*               (3) Read ahead stops at a discontinuity in the cluster chain & at the end of the file.
+*                   Errors are ignored : the sectors will be read, & the error reported, by a later
+*                   read.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_FILE_RD_AHEAD_EN == DEF_ENABLED)
+static  void  FS_FAT_FileRdAhead (FS_FILE           *p_file,
+                                  FS_BUF            *p_buf,
+                                  FS_FAT_FILE_SIZE   pos_rd,
+                                  FS_FAT_SEC_NBR     sec_cur,
+                                  FS_FAT_SEC_NBR     sec_cur_pos)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_fat_file_data;
+    FS_FAT_FILE_SIZE   pos_start;
+    FS_FAT_FILE_SIZE   pos_next;
+    FS_FAT_SEC_NBR     sec_ahead;
+    FS_FAT_SEC_NBR     sec_cnt;
+    FS_FAT_SEC_NBR     sec_first;
+    FS_FAT_SEC_NBR     sec_next;
+    FS_FAT_SEC_NBR     sec_prev;
+    FS_FAT_SEC_NBR     sec_rem;
+    FS_FAT_SEC_NBR     sec_run;
+    FS_SEC_QTY         sec_cnt_ahead;
+    FS_ERR             err;
+
+
+    p_fat_file_data = (FS_FAT_FILE_DATA *)(p_file->DataPtr);
+    p_fat_data      = (FS_FAT_DATA      *)(p_file->VolPtr->DataPtr);
+
+    if (p_file->VolPtr->CacheAPI_Ptr == (FS_VOL_CACHE_API *)0) {
+        return;
+    }
+
+                                                                /* ------------------ ADAPT RD WIN -------------------- */
+    if (pos_rd != p_fat_file_data->RdAheadNextPos) {            /* Seek (see Note #1).                                  */
+        FS_FAT_FileRdAheadClr(p_fat_file_data);
+        p_fat_file_data->RdAheadNextPos = p_fat_file_data->FilePos;
+        return;
+    }
+    p_fat_file_data->RdAheadNextPos = p_fat_file_data->FilePos;
+    if (p_fat_file_data->RdAheadWin == 0u) {
+        p_fat_file_data->RdAheadWin = FS_FAT_RD_AHEAD_SEC_MIN;
+    }
+
+
+                                                                /* ------------------ FIND FIRST SEC ------------------ */
+    pos_next = p_fat_file_data->FilePos - sec_cur_pos + p_fat_data->SecSize;
+    if (p_fat_file_data->RdAheadEndPos > pos_next) {            /* Secs already rd ahead (see Note #2).                 */
+        sec_ahead = (FS_FAT_SEC_NBR)FS_UTIL_DIV_PWR2(p_fat_file_data->RdAheadEndPos - pos_next,
+                                                     p_fat_data->SecSizeLog2);
+        if (sec_ahead >= p_fat_file_data->RdAheadWin / 2u) {
+            return;
+        }
+        pos_start = p_fat_file_data->RdAheadEndPos;
+        sec_prev  = p_fat_file_data->RdAheadLastSec;
+    } else {
+        sec_ahead = 0u;
+        pos_start = pos_next;
+        sec_prev  = sec_cur;
+    }
+
+    if (pos_start >= p_fat_file_data->FileSize) {              /* See Note #3.                                         */
+        return;
+    }
+
+    sec_cnt = p_fat_file_data->RdAheadWin - sec_ahead;
+    sec_rem = (FS_FAT_SEC_NBR)FS_UTIL_DIV_PWR2(p_fat_file_data->FileSize - pos_start - 1u,
+                                               p_fat_data->SecSizeLog2) + 1u;
+    sec_cnt = DEF_MIN(sec_cnt, sec_rem);
+
+    sec_first = FS_FAT_SecNextGet(p_file->VolPtr,
+                                  p_buf,
+                                  sec_prev,
+                                 &err);
+    if (err != FS_ERR_NONE) {
+        return;
+    }
+
+
+                                                                /* ---------------- FIND CONTIGUOUS RUN --------------- */
+    sec_run = 1u;
+    while (sec_run < sec_cnt) {
+        sec_next = FS_FAT_SecNextGet(p_file->VolPtr,
+                                     p_buf,
+                                     sec_first + sec_run - 1u,
+                                    &err);
+        if ((err      != FS_ERR_NONE) ||
+            (sec_next != sec_first + sec_run)) {
+            break;
+        }
+        sec_run++;
+    }
+
+
+                                                                /* --------------------- RD AHEAD --------------------- */
+    sec_cnt_ahead = FSVol_RdAheadLocked(p_file->VolPtr,
+                                        sec_first,
+                                        sec_run,
+                                        FS_VOL_SEC_TYPE_FILE,
+                                       &err);
+
+    if (sec_cnt_ahead < sec_run) {                              /* Cache full : shrink win to what it holds ...         */
+        p_fat_file_data->RdAheadWin    = DEF_MAX(sec_ahead + sec_cnt_ahead, FS_FAT_RD_AHEAD_SEC_MIN);
+        p_fat_file_data->RdAheadWinMax = p_fat_file_data->RdAheadWin;
+    } else {                                                    /* ... else grow win (see Note #1).                     */
+        p_fat_file_data->RdAheadWin    = DEF_MIN(p_fat_file_data->RdAheadWin * 2u, p_fat_file_data->RdAheadWinMax);
+    }
+    if (sec_cnt_ahead == 0u) {
+        return;
+    }
+
+    p_fat_file_data->RdAheadEndPos  = pos_start + FS_UTIL_MULT_PWR2((FS_FAT_FILE_SIZE)sec_cnt_ahead, p_fat_data->SecSizeLog2);
+    p_fat_file_data->RdAheadLastSec = sec_first + sec_cnt_ahead - 1u;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FS_FAT_FileRdAheadClr()
+*
+* Description : Clear read ahead state of a file.
+*
+* Argument(s) : p_fat_file_data     Pointer to FAT file data.
+*               ---------------     Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Sectors already read ahead stay in the volume cache; only the file's view of them is
+*                   forgotten.
+*********************************************************************************************************
+*/
+
+#if (FS_FAT_FILE_RD_AHEAD_EN == DEF_ENABLED)
+static  void  FS_FAT_FileRdAheadClr (FS_FAT_FILE_DATA  *p_fat_file_data)
+{
+    p_fat_file_data->RdAheadEndPos  = 0u;
+    p_fat_file_data->RdAheadLastSec = 0u;
+    p_fat_file_data->RdAheadWin     = 0u;
+    p_fat_file_data->RdAheadWinMax  = FS_FAT_CFG_RD_AHEAD_SEC_MAX;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FS_FAT_FileSecRd()
+*
+* Description : Read a run of contiguous file sectors.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ----------  Argument validated by caller.
+*
+*               p_dest      Pointer to destination buffer.
+*               ----------  Argument validated by caller.
+*
+*               sec_start   First sector of run.
+*
+*               sec_cnt     Number of sectors in run.
+*
+*               direct      Indicates whether whole clusters are read around the volume cache :
+*
+*                               DEF_YES    Read whole clusters around the cache (see Note #1).
+*                               DEF_NO     Read all sectors through the cache.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE    Sectors read.
+*
+*                                              -- RETURNED BY FSVol_RdLockedEx()/FSVol_RdDirectLocked() --
+*                               FS_ERR_DEV     Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The run is split at cluster boundaries : the sectors before the first boundary (head)
+*                   & after the last (tail) are read through the volume cache, while the whole clusters
+*                   between them are read from the device straight into the destination buffer, in one
+*                   request (see 'FSVol_RdDirectLocked()').  A run holding no whole cluster is read
+*                   through the cache.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_FileSecRd (FS_FILE         *p_file,
+                                void            *p_dest,
+                                FS_FAT_SEC_NBR   sec_start,
+                                FS_FAT_SEC_NBR   sec_cnt,
+                                CPU_BOOLEAN      direct,
+                                FS_ERR          *p_err)
+{
+    FS_FAT_DATA     *p_fat_data;
+    CPU_INT08U      *p_dest_08;
+    FS_FAT_SEC_NBR   sec_cnt_head;
+    FS_FAT_SEC_NBR   sec_cnt_body;
+    FS_FAT_SEC_NBR   sec_cnt_tail;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_file->VolPtr->DataPtr;
+    p_dest_08  = (CPU_INT08U  *)p_dest;
+
+    sec_cnt_head = FS_FAT_CLUS_SEC_REM(p_fat_data, sec_start) & (p_fat_data->ClusSize_sec - 1u);
+    sec_cnt_body = 0u;
+    if ((direct       == DEF_YES) &&
+        (sec_cnt_head <  sec_cnt)) {
+        sec_cnt_body = (FS_FAT_SEC_NBR)FS_UTIL_MULT_PWR2(FS_UTIL_DIV_PWR2(sec_cnt - sec_cnt_head, p_fat_data->ClusSizeLog2_sec),
+                                                         p_fat_data->ClusSizeLog2_sec);
+    }
+
+    if (sec_cnt_body == 0u) {                                   /* No whole clus : rd through cache.                    */
+        FSVol_RdLockedEx(p_file->VolPtr,
+                         p_dest,
+                         sec_start,
+                         sec_cnt,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+        return;
+    }
+    sec_cnt_tail = sec_cnt - sec_cnt_head - sec_cnt_body;
+
+                                                                /* ------------------- RD HEAD SECS ------------------- */
+    if (sec_cnt_head > 0u) {
+        FSVol_RdLockedEx(p_file->VolPtr,
+                         p_dest_08,
+                         sec_start,
+                         sec_cnt_head,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+        sec_start += sec_cnt_head;
+        p_dest_08 += FS_UTIL_MULT_PWR2(sec_cnt_head, p_fat_data->SecSizeLog2);
+    }
+
+                                                                /* ------------------- RD WHOLE CLUS ------------------ */
+    FSVol_RdDirectLocked(p_file->VolPtr,                        /* See Note #1.                                         */
+                         p_dest_08,
+                         sec_start,
+                         sec_cnt_body,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+    sec_start += sec_cnt_body;
+    p_dest_08 += FS_UTIL_MULT_PWR2(sec_cnt_body, p_fat_data->SecSizeLog2);
+
+                                                                /* ------------------- RD TAIL SECS ------------------- */
+    if (sec_cnt_tail > 0u) {
+        FSVol_RdLockedEx(p_file->VolPtr,
+                         p_dest_08,
+                         sec_start,
+                         sec_cnt_tail,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_FAT_FileSecWr()
+*
+* Description : Write a run of contiguous file sectors.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ----------  Argument validated by caller.
+*
+*               p_src       Pointer to source buffer.
+*               ----------  Argument validated by caller.
+*
+*               sec_start   First sector of run.
+*
+*               sec_cnt     Number of sectors in run.
+*
+*               direct      Indicates whether whole clusters are written around the volume cache :
+*
+*                               DEF_YES    Write whole clusters around the cache (see Note #1).
+*                               DEF_NO     Write all sectors through the cache.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE    Sectors written.
+*
+*                                              -- RETURNED BY FSVol_WrLockedEx()/FSVol_WrDirectLocked() --
+*                               FS_ERR_DEV     Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FS_FAT_FileSecRd()  Note #1'.  The whole clusters are written from the source buffer
+*                   in one request, & any copy of their sectors in the volume cache is dropped (see
+*                   'FSVol_WrDirectLocked()').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_FileSecWr (FS_FILE         *p_file,
+                                void            *p_src,
+                                FS_FAT_SEC_NBR   sec_start,
+                                FS_FAT_SEC_NBR   sec_cnt,
+                                CPU_BOOLEAN      direct,
+                                FS_ERR          *p_err)
+{
+    FS_FAT_DATA     *p_fat_data;
+    CPU_INT08U      *p_src_08;
+    FS_FAT_SEC_NBR   sec_cnt_head;
+    FS_FAT_SEC_NBR   sec_cnt_body;
+    FS_FAT_SEC_NBR   sec_cnt_tail;
+
+
+    p_fat_data = (FS_FAT_DATA *)p_file->VolPtr->DataPtr;
+    p_src_08   = (CPU_INT08U  *)p_src;
+
+    sec_cnt_head = FS_FAT_CLUS_SEC_REM(p_fat_data, sec_start) & (p_fat_data->ClusSize_sec - 1u);
+    sec_cnt_body = 0u;
+    if ((direct       == DEF_YES) &&
+        (sec_cnt_head <  sec_cnt)) {
+        sec_cnt_body = (FS_FAT_SEC_NBR)FS_UTIL_MULT_PWR2(FS_UTIL_DIV_PWR2(sec_cnt - sec_cnt_head, p_fat_data->ClusSizeLog2_sec),
+                                                         p_fat_data->ClusSizeLog2_sec);
+    }
+
+    if (sec_cnt_body == 0u) {                                   /* No whole clus : wr through cache.                    */
+        FSVol_WrLockedEx(p_file->VolPtr,
+                         p_src,
+                         sec_start,
+                         sec_cnt,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+        return;
+    }
+    sec_cnt_tail = sec_cnt - sec_cnt_head - sec_cnt_body;
+
+                                                                /* ------------------- WR HEAD SECS ------------------- */
+    if (sec_cnt_head > 0u) {
+        FSVol_WrLockedEx(p_file->VolPtr,
+                         p_src_08,
+                         sec_start,
+                         sec_cnt_head,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+        sec_start += sec_cnt_head;
+        p_src_08  += FS_UTIL_MULT_PWR2(sec_cnt_head, p_fat_data->SecSizeLog2);
+    }
+
+                                                                /* ------------------- WR WHOLE CLUS ------------------ */
+    FSVol_WrDirectLocked(p_file->VolPtr,                        /* See Note #1.                                         */
+                         p_src_08,
+                         sec_start,
+                         sec_cnt_body,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+    sec_start += sec_cnt_body;
+    p_src_08  += FS_UTIL_MULT_PWR2(sec_cnt_body, p_fat_data->SecSizeLog2);
+
+                                                                /* ------------------- WR TAIL SECS ------------------- */
+    if (sec_cnt_tail > 0u) {
+        FSVol_WrLockedEx(p_file->VolPtr,
+                         p_src_08,
+                         sec_start,
+                         sec_cnt_tail,
+                         FS_VOL_SEC_TYPE_FILE,
+                         p_err);
+    }
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                             MODULE END
@@ -231,6 +231,10 @@ static  void         FS_FAT_JournalFileCreate          (FS_VOL      *p_vol,
                                                         FS_ERR      *p_err);
 
                                                                                 /* --------- JOURNAL LOG FNCTS -------- */
+static  void         FS_FAT_JournalGroupCommit         (FS_VOL      *p_vol,     /* Clr journal up to cur pos.           */
+                                                        FS_BUF      *p_buf,
+                                                        FS_ERR      *p_err);
+
 static  void         FS_FAT_JournalPeek                (FS_VOL      *p_vol,     /* Peek at next journal log.            */
                                                         FS_BUF      *p_buf,
                                                         void        *p_log,
@@ -617,6 +621,9 @@ void  FS_FAT_JournalStart (CPU_CHAR  *name_vol,
 * Note(s)     : (1) Journaling should never be stopped unless volume is going to be closed. If FAT
 *                   operations are performed after journal is stopped and failure occurs, file system could
 *                   be left in an inconsistent state after volume remounting.
+*
+*               (2) Operations not yet committed (see 'FS_FAT_JournalClrReset() Note #2') are committed
+*                   first, since their logs could otherwise revert later, unjournaled, operations.
 *********************************************************************************************************
 */
 
@@ -656,8 +663,79 @@ void  FS_FAT_JournalStop (CPU_CHAR  *name_vol,
        *p_err = FS_ERR_VOL_JOURNAL_NOT_STARTED;
 
     } else {
-        DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START);
-       *p_err = FS_ERR_NONE;
+        FS_FAT_JournalSync(p_vol, p_err);                       /* See Note #2.                                         */
+        if (*p_err == FS_ERR_NONE) {
+            DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_START);
+        }
+    }
+
+
+                                                                /* ----------------- RELEASE VOL LOCK ----------------- */
+    FSVol_ReleaseUnlock(p_vol);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FS_FAT_JournalCommit()
+*
+* Description : Commit the operations journaled on the specified volume since the last commit.
+*
+* Argument(s) : name_vol    Volume name.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                       Operations committed.
+*                               FS_ERR_NAME_NULL                  Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_VOL_NOT_OPEN               Volume not open.
+*                               FS_ERR_VOL_JOURNAL_NOT_OPEN       Journal not open.
+*
+*                                                                 ---- RETURNED BY FS_FAT_JournalSync() ----
+*                               FS_ERR_BUF_NONE_AVAIL             No buffer available.
+*                               FS_ERR_DEV                        Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Operations are committed in groups (see 'FS_FAT_JournalClrReset() Note #2'); once this
+*                   function returns, those completed survive a failure.  A group is also committed when
+*                   a file is flushed ('fs_fflush()').  The application may call this function
+*                   periodically to bound the time during which completed operations may be lost.
+*********************************************************************************************************
+*/
+
+void  FS_FAT_JournalCommit (CPU_CHAR  *name_vol,
+                            FS_ERR    *p_err)
+{
+    FS_FAT_DATA  *p_fat_data;
+    FS_VOL       *p_vol;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE PTR ------------------- */
+    if (p_err == DEF_NULL) {                                    /* Validate err ptr.                                    */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == DEF_NULL) {                                 /* Validate vol name ptr.                               */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+#endif
+
+
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol may NOT be unmounted.                            */
+    (void)p_err;                                               /* Err ignored. Ret val chk'd instead.                  */
+    if (p_vol == DEF_NULL) {
+        return;
+    }
+
+
+                                                                /* ------------------- COMMIT GROUP ------------------- */
+    p_fat_data = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_NO) {
+       *p_err = FS_ERR_VOL_JOURNAL_NOT_OPEN;
+    } else {
+        FS_FAT_JournalSync(p_vol, p_err);                       /* See Note #1.                                         */
     }
 
 
@@ -754,7 +832,8 @@ void  FS_FAT_JournalInit (FS_VOL  *p_vol,
     DEF_BIT_CLR(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN  |
                                           FS_FAT_JOURNAL_STATE_START |
                                           FS_FAT_JOURNAL_STATE_REPLAY);
-    p_fat_data->JournalDataPtr = DEF_NULL;
+    p_fat_data->JournalDataPtr    = DEF_NULL;
+    p_fat_data->JournalGroupOpCnt = 0u;
 
 
                                                                 /* -------------- ALLOC JOURNAL FILE DATA ------------- */
@@ -990,6 +1069,7 @@ void  FS_FAT_JournalClrAllReset (FS_VOL  *p_vol,
         return;
     }
 
+    p_fat_data->JournalGroupOpCnt = 0u;
                                                                 /* Reset current position.                              */
     FS_FAT_JournalPosSet(p_vol,
                          p_buf,
@@ -1002,7 +1082,8 @@ void  FS_FAT_JournalClrAllReset (FS_VOL  *p_vol,
 *********************************************************************************************************
 *                                        FS_FAT_JournalClrReset()
 *
-* Description : Clear journal up to current position and reset current position.
+* Description : End a journaled operation, clearing journal up to current position and resetting current
+*               position once the group of operations is to be committed.
 *
 * Argument(s) : p_vol   Pointer to volume.
 *
@@ -1010,11 +1091,8 @@ void  FS_FAT_JournalClrAllReset (FS_VOL  *p_vol,
 *
 *               p_err   Pointer to variable that will receive the return error code from this function :
 *
-*                           --------------RETURNED BY FS_FAT_JournalPosSet()-------------
-*                           See FS_FAT_JournalPosSet() for additional return error codes.
-*
-*                           ----------------RETURNED BY FS_FAT_JournalClr()--------------
-*                           See FS_FAT_JournalClr() for additional return error codes..
+*                           -----------RETURNED BY FS_FAT_JournalGroupCommit()-----------
+*                           See FS_FAT_JournalGroupCommit() for additional return error codes.
 *
 * Return(s)   : none.
 *
@@ -1023,6 +1101,17 @@ void  FS_FAT_JournalClrAllReset (FS_VOL  *p_vol,
 *                   mark. If this mark is not present, journal will not be replayed (see
 *                   FS_FAT_JournalReplay() notes).
 *
+*               (2) (a) Up to FS_FAT_CFG_JOURNAL_GROUP_OP_MAX operations accumulate their logs in the
+*                       journal before it is cleared, which saves the journal clear of every operation
+*                       but the last.  The group is also committed once its logs reach
+*                       FS_FAT_CFG_JOURNAL_GROUP_SIZE octets, & by 'FS_FAT_JournalSync()'.
+*
+*                   (b) The logs of each operation are still written before the metadata they protect,
+*                       as before.  Should a failure occur before the group is committed, the journal is
+*                       replayed backwards over the operations of the group, reverting the volume to
+*                       its state at the last commit, unless a cluster chain deletion is met, which is
+*                       completed instead (see 'FS_FAT_JournalReplay() Note #2b').  Either way, the
+*                       volume is left as it was at the boundary of an operation.
 *********************************************************************************************************
 */
 
@@ -1037,21 +1126,78 @@ void  FS_FAT_JournalClrReset(FS_VOL  *p_vol,
     p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
     p_journal_data =  p_fat_data->JournalDataPtr;
 
-                                                                /* Clr journal up to current position (See Note #1).    */
-    FS_FAT_JournalClr(p_vol,
-                      p_buf,
-                      0u,
-                      p_journal_data->FilePos,
-                      p_err);
+                                                                /* Defer clr until group is complete (see Note #2a).    */
+    if ((p_journal_data->FilePos          != 0u) &&
+        (p_fat_data->JournalGroupOpCnt + 1u < FS_FAT_CFG_JOURNAL_GROUP_OP_MAX) &&
+        (p_journal_data->FilePos          <  FS_FAT_CFG_JOURNAL_GROUP_SIZE)) {
+        p_fat_data->JournalGroupOpCnt++;
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    FS_FAT_JournalGroupCommit(p_vol, p_buf, p_err);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FS_FAT_JournalSync()
+*
+* Description : Commit the operations journaled since the last commit.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           FS_ERR_NONE                 Operations committed.
+*                           FS_ERR_BUF_NONE_AVAIL       No buffer available.
+*
+*                           -----------RETURNED BY FS_FAT_JournalGroupCommit()-----------
+*                           See FS_FAT_JournalGroupCommit() for additional return error codes.
+*
+*                           ------------------RETURNED BY FSBuf_Flush()------------------
+*                           See FSBuf_Flush() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The volume lock MUST be held.  Nothing is written unless logs are pending (see
+*                   'FS_FAT_JournalClrReset() Note #2').
+*********************************************************************************************************
+*/
+
+void  FS_FAT_JournalSync (FS_VOL  *p_vol,
+                          FS_ERR  *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+    FS_BUF            *p_buf;
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
+   *p_err          =  FS_ERR_NONE;
+
+    if (DEF_BIT_IS_SET(p_fat_data->JournalState, FS_FAT_JOURNAL_STATE_OPEN) == DEF_NO) {
+        return;
+    }
+    if (p_journal_data->FilePos == 0u) {                        /* See Note #1.                                         */
+        return;
+    }
+
+    p_buf = FSBuf_Get(p_vol);
+    if (p_buf == DEF_NULL) {
+       *p_err = FS_ERR_BUF_NONE_AVAIL;
+        return;
+    }
+
+    FS_FAT_JournalGroupCommit(p_vol, p_buf, p_err);
     if (*p_err != FS_ERR_NONE) {
+        FSBuf_Free(p_buf);
         return;
     }
 
-                                                                /* Reset current position.                              */
-    FS_FAT_JournalPosSet(p_vol,
-                         p_buf,
-                         0u,
-                         p_err);
+    FSBuf_Flush(p_buf, p_err);
+    FSBuf_Free(p_buf);
 }
 
 
@@ -1778,6 +1924,61 @@ static  void  FS_FAT_JournalFileCreate (FS_VOL  *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                     FS_FAT_JournalGroupCommit()
+*
+* Description : Commit group of operations, clearing journal up to current position and resetting current
+*               position.
+*
+* Argument(s) : p_vol   Pointer to volume.
+*
+*               p_buf   Pointer to temporary buffer.
+*
+*               p_err   Pointer to variable that will receive the return error code from this function :
+*
+*                           --------------RETURNED BY FS_FAT_JournalPosSet()-------------
+*                           See FS_FAT_JournalPosSet() for additional return error codes.
+*
+*                           ----------------RETURNED BY FS_FAT_JournalClr()--------------
+*                           See FS_FAT_JournalClr() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FS_FAT_JournalClrReset() Note #1'.
+*********************************************************************************************************
+*/
+
+static  void  FS_FAT_JournalGroupCommit (FS_VOL  *p_vol,
+                                         FS_BUF  *p_buf,
+                                         FS_ERR  *p_err)
+{
+    FS_FAT_DATA       *p_fat_data;
+    FS_FAT_FILE_DATA  *p_journal_data;
+
+
+    p_fat_data     = (FS_FAT_DATA *)p_vol->DataPtr;
+    p_journal_data =  p_fat_data->JournalDataPtr;
+
+                                                                /* Clr journal up to current position (See Note #1).    */
+    FS_FAT_JournalClr(p_vol,
+                      p_buf,
+                      0u,
+                      p_journal_data->FilePos,
+                      p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    p_fat_data->JournalGroupOpCnt = 0u;
+                                                                /* Reset current position.                              */
+    FS_FAT_JournalPosSet(p_vol,
+                         p_buf,
+                         0u,
+                         p_err);
+}
+
+
 /*
 *********************************************************************************************************
 *                                        FS_FAT_JournalPeek()
@@ -1960,7 +2161,9 @@ static  void  FS_FAT_JournalPosSet (FS_VOL      *p_vol,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) A read ending on a sector boundary leaves the current sector at the next sector, as
+*                   'FS_FAT_JournalPosSet()' would; the next read or peek would otherwise start at the
+*                   beginning of the sector just read.
 *********************************************************************************************************
 */
 
@@ -2011,6 +2214,7 @@ static  void  FS_FAT_JournalRd (FS_VOL      *p_vol,
         Mem_Copy((void *)  p_log,
                  (void *)((CPU_INT08U *)p_buf->DataPtr + cur_sec_pos),
                            rd_size);
+        p_log = (void *)((CPU_INT08U *)p_log + rd_size);        /* Log may span sec boundary.                           */
 
                                                                 /* ----------- UPDATE SEC POS AND REM SIZE ------------ */
         cur_sec_pos = (cur_sec_pos + rd_size) & (p_fat_data->SecSize - 1u);
@@ -2018,8 +2222,9 @@ static  void  FS_FAT_JournalRd (FS_VOL      *p_vol,
 
 
                                                                 /* ------------------- GET NEXT SEC ------------------- */
-        if ((cur_sec_pos == 0u) && (rem_size != 0u)) {          /* If we crossed sec boundary amd data rem ...          */
-            cur_sec = FS_FAT_SecNextGet(p_vol,                  /* ... find next sec.                                   */
+        if ((cur_sec_pos == 0u) &&                              /* If we crossed sec boundary & data or journal rem ... */
+           ((rem_size != 0u) || (file_pos_end < FS_FAT_JOURNAL_FILE_LEN))) {
+            cur_sec = FS_FAT_SecNextGet(p_vol,                  /* ... find next sec (see Note #1).                     */
                                         p_buf,
                                         cur_sec,
                                         p_err);
@@ -2129,7 +2334,8 @@ static  CPU_INT32U  FS_FAT_JournalRd_INT32U (FS_VOL  *p_vol,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) See 'FS_FAT_JournalRd() Note #1'.  Logs are written piecewise, so the log following one
+*                   that ends on a sector boundary would otherwise overwrite the start of that sector.
 *********************************************************************************************************
 */
 
@@ -2180,6 +2386,7 @@ static  void  FS_FAT_JournalWr (FS_VOL      *p_vol,
         Mem_Copy((CPU_INT08U *)p_buf->DataPtr + cur_sec_pos,
                  (void *)p_log,
                   wr_size);
+        p_log = (void *)((CPU_INT08U *)p_log + wr_size);        /* Log may span sec boundary.                           */
                                                                 /* Udpate cur sec pos & rem size.                       */
         cur_sec_pos = (cur_sec_pos + wr_size) & (p_fat_data->SecSize - 1u);
         rem_size -= wr_size;
@@ -2190,8 +2397,9 @@ static  void  FS_FAT_JournalWr (FS_VOL      *p_vol,
         }
 
                                                                 /* ------------------- GET NEXT SEC ------------------- */
-        if ((cur_sec_pos == 0u) && (rem_size > 0)) {            /* If we crossed sec boundary and data rem ...          */
-            cur_sec = FS_FAT_SecNextGet(p_vol,                  /* ... get next sec.                                    */
+        if ((cur_sec_pos == 0u) &&                              /* If we crossed sec boundary & data or journal rem ... */
+           ((rem_size > 0) || (file_pos_end < FS_FAT_JOURNAL_FILE_LEN))) {
+            cur_sec = FS_FAT_SecNextGet(p_vol,                  /* ... get next sec (see Note #1).                      */
                                         p_buf,
                                         cur_sec,
                                         p_err);
@@ -2527,6 +2735,9 @@ static  void  FS_FAT_JournalReplay (FS_VOL  *p_vol,
                  break;
         }
     }
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+    FS_FAT_DirHashClr(p_fat_data);                              /* Dir entries may have been reverted.                  */
+#endif
     if (*p_err != FS_ERR_NONE) {
         return;
     }
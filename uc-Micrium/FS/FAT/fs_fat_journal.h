@@ -119,6 +119,9 @@ void             FS_FAT_JournalStart              (CPU_CHAR              *name_v
 void             FS_FAT_JournalStop               (CPU_CHAR              *name_vol,     /* Stop  journaling.            */
                                                    FS_ERR                *p_err);
 
+void             FS_FAT_JournalCommit             (CPU_CHAR              *name_vol,     /* Commit journaled ops.        */
+                                                   FS_ERR                *p_err);
+
 /*
 *********************************************************************************************************
 *                                    INTERNAL FUNCTION PROTOTYPES
@@ -150,6 +153,9 @@ void             FS_FAT_JournalClrReset           (FS_VOL                *p_vol,
                                                    FS_BUF                *p_buf,
                                                    FS_ERR                *p_err);
 
+void             FS_FAT_JournalSync               (FS_VOL                *p_vol,        /* Commit grouped ops.          */
+                                                   FS_ERR                *p_err);
+
                                                                                         /* ------- JOURNAL LOGS ------- */
 void             FS_FAT_JournalEnterClusChainAlloc(FS_VOL                *p_vol,        /* Enter clus chain alloc log.  */
                                                    FS_BUF                *p_buf,
@@ -88,6 +88,11 @@
 #define  FS_FAT_LFN_OFF_FSTCLUSLO                         26u
 #define  FS_FAT_LFN_OFF_NAMETHIRD                         28u
 
+#define  FS_FAT_LFN_SFN_BASIS_NBR                          2u   /* Nbr of basis SFNs chk'd per dir pass.                */
+#define  FS_FAT_LFN_SFN_HASH_PREFIX_LEN                    2u   /* Nbr of basis chars kept in hashed basis SFN.         */
+#define  FS_FAT_LFN_SFN_HASH_TRY_MAX                       8u   /* Max nbr of hashed basis SFNs tried.                  */
+#define  FS_FAT_LFN_SFN_TAIL_MAP_WORD_NBR    ((FS_FAT_CFG_SFN_TAIL_NUM_MAX / 32u) + 1u)
+
 
 /*
 *********************************************************************************************************
@@ -97,6 +102,14 @@
 
 typedef  CPU_INT32U  FS_FAT_SFN_TAIL;
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+typedef  struct  fs_fat_lfn_sfn_basis {                         /* Basis SFN & numeric tails used with it.              */
+    CPU_INT32U        Name_8_3[3];
+    FS_FILE_NAME_LEN  CharCnt;
+    CPU_INT32U        TailMap[FS_FAT_LFN_SFN_TAIL_MAP_WORD_NBR];
+} FS_FAT_LFN_SFN_BASIS;
+#endif
+
 #if (FS_CFG_UTF8_EN == DEF_ENABLED)
 typedef  CPU_WCHAR   FS_FAT_LFN_CHAR;
 #else
@@ -185,6 +198,20 @@ static  void               FS_FAT_LFN_NextDirEntryGet         (FS_VOL
                                                                FS_FAT_DIR_POS         *p_dir_end_pos,
                                                                FS_ERR                 *p_err);
 
+                                                                                        /* Get hashes of name.          */
+static  CPU_INT08U         FS_FAT_LFN_NameHashGet             (CPU_CHAR               *name,
+                                                               CPU_CHAR              **p_name_next,
+                                                               CPU_INT32U              hash_tbl[],
+                                                               FS_ERR                 *p_err);
+
+                                                                                        /* Get hashes of next dir entry.*/
+static  CPU_INT08U         FS_FAT_LFN_NextDirEntryHash        (FS_VOL                 *p_vol,
+                                                               FS_BUF                 *p_buf,
+                                                               CPU_INT32U              hash_tbl[],
+                                                               FS_FAT_DIR_POS         *p_dir_start_pos,
+                                                               FS_FAT_DIR_POS         *p_dir_end_pos,
+                                                               FS_ERR                 *p_err);
+
 
                                                                                         /* -------- LOCAL FNCTS ------- */
                                                                                         /* Check name as LFN.           */
@@ -252,17 +279,23 @@ static  void               FS_FAT_LFN_SFN_FmtTail             (CPU_INT32U
                                                                FS_FILE_NAME_LEN        char_cnt,
                                                                FS_FAT_SFN_TAIL         tail_nbr);
 
-                                                                                        /* Find max tail val.           */
-static  FS_FAT_SFN_TAIL    FS_FAT_LFN_SFN_DirEntryFindMax     (FS_VOL                 *p_vol,
+                                                                                        /* Fmt hashed basis SFN.        */
+static  void               FS_FAT_LFN_SFN_HashFmt             (CPU_INT32U              name_8_3[],
+                                                               FS_FILE_NAME_LEN        char_cnt,
+                                                               CPU_INT32U              hash,
+                                                               FS_FAT_LFN_SFN_BASIS   *p_basis);
+
+                                                                                        /* Find tails used with bases.  */
+static  void               FS_FAT_LFN_SFN_TailMapGet          (FS_VOL                 *p_vol,
                                                                FS_BUF                 *p_buf,
-                                                               CPU_INT32U              name_8_3[],
+                                                               FS_FAT_LFN_SFN_BASIS    basis_tbl[],
                                                                FS_FAT_SEC_NBR          dir_start_sec,
                                                                FS_ERR                 *p_err);
 
-                                                                                        /* Find max tail val in sector. */
-static  FS_FAT_SFN_TAIL    FS_FAT_LFN_SFN_DirEntryFindMaxInSec(void                   *p_temp,
+                                                                                        /* Find tails used in sector.   */
+static  void               FS_FAT_LFN_SFN_TailMapGetInSec     (void                   *p_temp,
                                                                FS_SEC_SIZE             sec_size,
-                                                               CPU_INT32U              name_8_3[],
+                                                               FS_FAT_LFN_SFN_BASIS    basis_tbl[],
                                                                FS_ERR                 *p_err);
 #endif
 
@@ -303,6 +336,8 @@ const  FS_FAT_FN_API  FS_FAT_LFN_API = {
 #endif
     FS_FAT_LFN_DirEntryFind,
     FS_FAT_LFN_NextDirEntryGet,
+    FS_FAT_LFN_NameHashGet,
+    FS_FAT_LFN_NextDirEntryHash,
 };
 
 
@@ -1571,6 +1606,178 @@ static  void  FS_FAT_LFN_NextDirEntryGet (FS_VOL           *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                      FS_FAT_LFN_NameHashGet()
+*
+* Description : Get hashes under which a name is searched in a directory name hash index.
+*
+* Argument(s) : name            Name of the entry.
+*
+*               p_name_next     Pointer to variable that will receive pointer to character following
+*                               entry name.
+*
+*               hash_tbl        Table that will receive the hashes.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE            Hashes gotten.
+*                                   FS_ERR_NAME_INVALID    File name is illegal.
+*
+* Return(s)   : Number of hashes gotten.
+*
+* Note(s)     : (1) The name is checked as by 'FS_FAT_LFN_DirEntryFind()', which compares it with the
+*                   LFN of each entry, ignoring case, & with the SFN of each entry, if it is a valid SFN.
+*                   The first hash is that of the case-folded name, the second that of the formed SFN.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  FS_FAT_LFN_NameHashGet (CPU_CHAR     *name,
+                                            CPU_CHAR    **p_name_next,
+                                            CPU_INT32U    hash_tbl[],
+                                            FS_ERR       *p_err)
+{
+    CPU_BOOLEAN        ext_lower_case;
+    CPU_INT32U         hash;
+    CPU_INT08U         hash_cnt;
+    CPU_INT32U         name_8_3[3];
+    FS_FILE_NAME_LEN   name_len;
+    FS_FILE_NAME_LEN   name_len_octet;
+    CPU_BOOLEAN        name_lower_case;
+    FS_FILE_NAME_LEN   ix;
+    CPU_CHAR          *p_name;
+#if (FS_CFG_UTF8_EN == DEF_ENABLED)
+    CPU_WCHAR          name_char;
+    CPU_SIZE_T         name_char_len;
+#endif
+
+
+    FS_FAT_LFN_Chk( name,                                       /* Chk if valid LFN (see Note #1).                      */
+                   &name_len,
+                   &name_len_octet,
+                    p_err);
+    if (*p_err != FS_ERR_NONE) {
+       *p_name_next = name;
+        return (0u);
+    }
+   *p_name_next = name + name_len_octet;
+
+                                                                /* ------------------- HASH LFN ----------------------- */
+    hash   = FS_FAT_DIR_HASH_INIT_LFN;
+    p_name = name;
+    for (ix = 0u; ix < name_len; ix++) {
+#if (FS_CFG_UTF8_EN == DEF_ENABLED)
+        name_char_len = MB_CharToWC(&name_char,
+                                     p_name,
+                                     MB_MAX_LEN);
+        p_name       += name_char_len;
+        hash          = FS_FAT_DIR_HASH_STEP(hash, WC_CharToCasefold(name_char));
+#else
+        hash          = FS_FAT_DIR_HASH_STEP(hash, ASCII_ToLower(*p_name));
+        p_name++;
+#endif
+    }
+    hash_tbl[0] = hash;
+    hash_cnt    = 1u;
+
+                                                                /* ------------------- HASH SFN ----------------------- */
+    FS_FAT_SFN_Chk(name,
+                  &name_len,
+                   p_err);
+    if (*p_err == FS_ERR_NONE) {
+        FS_FAT_SFN_Create(name,
+                         &name_8_3[0],
+                         &name_lower_case,
+                         &ext_lower_case,
+                          p_err);
+        if ((*p_err == FS_ERR_NONE) ||
+            (*p_err == FS_ERR_NAME_MIXED_CASE)) {
+            hash_tbl[1] = FS_FAT_SFN_Hash((void *)&name_8_3[0]);
+            hash_cnt    = 2u;
+        }
+    }
+
+   *p_err = FS_ERR_NONE;
+    return (hash_cnt);
+}
+
+
+/*
+*********************************************************************************************************
+*                                    FS_FAT_LFN_NextDirEntryHash()
+*
+* Description : Get hashes of next LFN dir entry from dir.
+*
+* Argument(s) : p_vol               Pointer to volume.
+*
+*               p_buf               Pointer to temporary buffer.
+*
+*               hash_tbl            Table that will receive the hashes.
+*
+*               p_dir_start_pos     Pointer to directory position at which search should start; variable
+*                                   will receive the directory position at which the first entry (the
+*                                   first LFN entry or the SFN entry) is located.
+*
+*               p_dir_end_pos       Pointer to variable that will receive the directory position at which
+*                                   the final entry (the SFN entry) is located.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       FS_ERR_NONE    Directory entry hashed.
+*
+*                                                      - RETURNED BY FS_FAT_LFN_NextDirEntryGet() -
+*                                       FS_ERR_DEV     Device access error.
+*                                       FS_ERR_EOF     End of directory reached.
+*
+* Return(s)   : Number of hashes gotten.
+*
+* Note(s)     : (1) The hashes are those of the name gotten, as compared by 'FS_FAT_LFN_DirEntryFind()',
+*                   & of the octets of the SFN entry (see 'FS_FAT_LFN_NameHashGet()  Note #1').
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  FS_FAT_LFN_NextDirEntryHash (FS_VOL           *p_vol,
+                                                 FS_BUF           *p_buf,
+                                                 CPU_INT32U        hash_tbl[],
+                                                 FS_FAT_DIR_POS   *p_dir_start_pos,
+                                                 FS_FAT_DIR_POS   *p_dir_end_pos,
+                                                 FS_ERR           *p_err)
+{
+    CPU_INT32U         hash;
+    FS_FILE_NAME_LEN   name_len;
+    FS_FAT_LFN_CHAR    name_lfn[FS_FAT_MAX_FILE_NAME_LEN + 1u];
+    FS_FILE_NAME_LEN   ix;
+    CPU_INT08U        *p_dir_entry;
+
+
+    FS_FAT_LFN_NextDirEntryGet(         p_vol,
+                                        p_buf,
+                               (void *)&name_lfn[0],
+                                        p_dir_start_pos,
+                                        p_dir_end_pos,
+                                        p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+    hash     = FS_FAT_DIR_HASH_INIT_LFN;                        /* See Note #1.                                         */
+    name_len = FS_FAT_LFN_StrLen_N(name_lfn, FS_FAT_MAX_FILE_NAME_LEN);
+    for (ix = 0u; ix < name_len; ix++) {
+#if (FS_CFG_UTF8_EN == DEF_ENABLED)
+        hash = FS_FAT_DIR_HASH_STEP(hash, WC_CharToCasefold(name_lfn[ix]));
+#else
+        hash = FS_FAT_DIR_HASH_STEP(hash, ASCII_ToLower(name_lfn[ix]));
+#endif
+    }
+    hash_tbl[0] = hash;
+
+    p_dir_entry = (CPU_INT08U *)p_buf->DataPtr + p_dir_end_pos->SecPos;
+    hash_tbl[1] = FS_FAT_SFN_Hash((void *)p_dir_entry);
+
+    return (2u);
+}
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -2343,8 +2550,6 @@ static  void  FS_FAT_LFN_ParseFull (void             *p_dir_entry,
 *
 *               name_8_3        Array that will receive the entry SFN.
 *
-*               p_dir_entry     Pointer to directory entry.
-*
 *               dir_sec         Directory sector in which file will be located.
 *
 *               p_err           Pointer to variable that will receive the return error code from this function :
@@ -2352,10 +2557,11 @@ static  void  FS_FAT_LFN_ParseFull (void             *p_dir_entry,
 *                                   FS_ERR_NONE                 SFN allocated.
 *                                   FS_ERR_SYS_SFN_NOT_AVAIL    No SFN is available.
 *
-*                                                               ---- RETURNED BY FS_FAT_SFN_DirSrch() ---
+*                                                               - RETURNED BY FS_FAT_LFN_SFN_TailMapGet() -
 *                                   FS_ERR_DEV                  Device access error.
+*                                   FS_ERR_ENTRY_CORRUPT        File system entry is corrupt.
 *
-*                                                               ---- RETURNED BY FS_FAT_LFN_SFN_Fmt() ---
+*                                                               ----- RETURNED BY FS_FAT_LFN_SFN_Fmt() ----
 *                                   FS_ERR_NAME_INVALID         LFN name invalid.
 *
 * Return(s)   : none.
@@ -2365,6 +2571,16 @@ static  void  FS_FAT_LFN_ParseFull (void             *p_dir_entry,
 *               (2) The basis SFN is formed according to the rules outlined in [Ref 1] (see
 *                   'FS_FAT_LFN_SFN_Fmt() Note #2'), with the tail generation as outlined therein as well
 *                   (see 'FS_FAT_LFN_SFN_FmtTail() Note #2').
+*
+*               (3) The lowest numeric tail, up to FS_FAT_CFG_SFN_TAIL_NUM_MAX, not used with the basis SFN
+*                   is chosen.  Once these are all used (e.g., for many files whose names begin alike), the
+*                   basis is replaced by its first FS_FAT_LFN_SFN_HASH_PREFIX_LEN characters followed by 4
+*                   hexadecimal digits of a hash of the LFN, as Windows does.  Should that basis be used as
+*                   well, other bases are formed by varying the hash.
+*
+*               (4) The tails used with FS_FAT_LFN_SFN_BASIS_NBR bases are found in a single directory
+*                   pass (see 'FS_FAT_LFN_SFN_TailMapGet()'), the hashed basis being checked along with the
+*                   basis SFN.
 *********************************************************************************************************
 */
 
@@ -2376,87 +2592,90 @@ static  void  FS_FAT_LFN_SFN_Alloc (FS_VOL          *p_vol,
                                     FS_FAT_SEC_NBR   dir_sec,
                                     FS_ERR          *p_err)
 {
-    CPU_INT16U       char_cnt;
-    FS_FAT_DIR_POS   dir_start_pos;
-    FS_FAT_DIR_POS   dir_end_pos;
-    FS_FAT_SFN_TAIL  tail_nbr;
-    FS_FAT_SFN_TAIL  tail_max;
+    FS_FAT_LFN_SFN_BASIS  basis_tbl[FS_FAT_LFN_SFN_BASIS_NBR];
+    FS_FAT_LFN_SFN_BASIS *p_basis;
+    CPU_INT32U            name_8_3_basis[3];
+    FS_FILE_NAME_LEN      char_cnt;
+    CPU_INT32U            hash;
+    CPU_INT08U            hash_try_cnt;
+    CPU_INT08U            basis_ix;
+    FS_FAT_SFN_TAIL       tail_nbr;
+    CPU_CHAR             *p_name;
 
 
 
                                                                 /* ------------------- FMT INIT NAME ------------------ */
-    char_cnt = FS_FAT_LFN_SFN_Fmt(name, name_8_3, p_err);       /* Fmt SFN from LFN.                                    */
+    char_cnt = FS_FAT_LFN_SFN_Fmt(name, name_8_3_basis, p_err); /* Fmt SFN from LFN.                                    */
     if (*p_err != FS_ERR_NONE) {
         return;
     }
 
+    hash   = FS_FAT_DIR_HASH_INIT_LFN;                          /* Hash LFN (see Note #3).                              */
+    p_name = name;
+    while ((*p_name != (CPU_CHAR)ASCII_CHAR_NULL) &&
+           (*p_name != FS_FAT_PATH_SEP_CHAR)) {
+        hash = FS_FAT_DIR_HASH_STEP(hash, (CPU_INT08U)*p_name);
+        p_name++;
+    }
 
+    Mem_Copy((void *)&basis_tbl[0].Name_8_3[0],
+             (void *)&name_8_3_basis[0],
+                      sizeof(basis_tbl[0].Name_8_3));
+    basis_tbl[0].CharCnt = char_cnt;
+    for (basis_ix = 1u; basis_ix < FS_FAT_LFN_SFN_BASIS_NBR; basis_ix++) {
+        FS_FAT_LFN_SFN_HashFmt( name_8_3_basis,
+                                char_cnt,
+                                hash,
+                               &basis_tbl[basis_ix]);
+        hash = FS_FAT_DIR_HASH_STEP(hash, basis_ix);
+    }
+    hash_try_cnt = FS_FAT_LFN_SFN_BASIS_NBR - 1u;
 
-                                                                /* ------------------- FIND MAX SFN ------------------- */
-    tail_max = FS_FAT_LFN_SFN_DirEntryFindMax(p_vol,
-                                              p_buf,
-                                              name_8_3,
-                                              dir_sec,
-                                              p_err);
-    (void)p_err;                                               /* Err ignored. Ret val chk'd instead.                  */
-    if (tail_max == 0u) {
-        tail_nbr =  1u;
-    } else {
-        if (tail_max < 999999u) {
-            tail_nbr = tail_max + 1u;
-
-
-
-        } else {                                                /* -------------- SRCH FOR FREE SFN TAIL -------------- */
-            tail_nbr = 1u;
-
-            while (tail_nbr <= 999999u) {
-                FS_FAT_LFN_SFN_FmtTail(name_8_3, char_cnt, tail_nbr);
 
-                                                                /* Srch dir for SFN.                                    */
-                dir_start_pos.SecNbr = dir_sec;
-                dir_start_pos.SecPos = 0u;
-                FS_FAT_SFN_SFN_Find( p_vol,
-                                     p_buf,
-                                     name_8_3,
-                                    &dir_start_pos,
-                                    &dir_end_pos,
-                                     p_err);
 
-                if (*p_err == FS_ERR_SYS_DIR_ENTRY_NOT_FOUND) {
-                    break;
-                }
-
-                switch (*p_err) {
-                    case FS_ERR_NONE:                           /* SFN found, so collision.                             */
-                         break;
+                                                                /* ---------------- FIND FREE SFN TAIL ---------------- */
+    while (DEF_ON) {
+        FS_FAT_LFN_SFN_TailMapGet(p_vol,                        /* See Note #4.                                         */
+                                  p_buf,
+                                  basis_tbl,
+                                  dir_sec,
+                                  p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
 
-                    case FS_ERR_DEV:
-                         return;
+        for (basis_ix = 0u; basis_ix < FS_FAT_LFN_SFN_BASIS_NBR; basis_ix++) {
+            p_basis = &basis_tbl[basis_ix];
+            for (tail_nbr = 1u; tail_nbr <= FS_FAT_CFG_SFN_TAIL_NUM_MAX; tail_nbr++) {
+                if (DEF_BIT_IS_CLR(p_basis->TailMap[tail_nbr >> 5], (CPU_INT32U)1u << (tail_nbr & 31u)) == DEF_YES) {
+                                                                /* ------------------ SFN TAIL FOUND ------------------ */
+                    name_8_3[0] = p_basis->Name_8_3[0];
+                    name_8_3[1] = p_basis->Name_8_3[1];
+                    name_8_3[2] = p_basis->Name_8_3[2];
+                    FS_FAT_LFN_SFN_FmtTail(name_8_3, p_basis->CharCnt, tail_nbr);
 
-                    default:
-                         FS_TRACE_LOG(("FS_FAT_LFN_SFN_Alloc(): Default case reached.\r\n"));
-                         return;
+                    FS_TRACE_LOG(("FS_FAT_LFN_SFN_Alloc(): SFN %s ASSIGNED TO\r\n", (CPU_CHAR *)name_8_3));
+                    FS_TRACE_LOG(("                            %s\r\n",             (CPU_CHAR *)name));
+                   *p_err = FS_ERR_NONE;
+                    return;
                 }
-
-                tail_nbr++;                                     /* Inc tail nbr.                                        */
             }
+        }
 
-            if (tail_nbr > 999999u) {
-               *p_err = FS_ERR_SYS_SFN_NOT_AVAIL;
-                return;
-            }
+                                                                /* ------------ ALL TAILS USED : REHASH --------------- */
+        if (hash_try_cnt >= FS_FAT_LFN_SFN_HASH_TRY_MAX) {
+           *p_err = FS_ERR_SYS_SFN_NOT_AVAIL;
+            return;
+        }
+        for (basis_ix = 0u; basis_ix < FS_FAT_LFN_SFN_BASIS_NBR; basis_ix++) {
+            FS_FAT_LFN_SFN_HashFmt( name_8_3_basis,
+                                    char_cnt,
+                                    hash,
+                                   &basis_tbl[basis_ix]);
+            hash = FS_FAT_DIR_HASH_STEP(hash, hash_try_cnt);
+            hash_try_cnt++;
         }
     }
-
-
-
-                                                                /* ------------------ SFN TAIL FOUND ------------------ */
-    FS_FAT_LFN_SFN_FmtTail(name_8_3, char_cnt, tail_nbr);       /* Add tail to SFN.                                     */
-
-    FS_TRACE_LOG(("FS_FAT_LFN_SFN_Alloc(): SFN %s ASSIGNED TO\r\n", (CPU_CHAR *)name_8_3));
-    FS_TRACE_LOG(("                            %s\r\n",             (CPU_CHAR *)name));
-   *p_err = FS_ERR_NONE;
 }
 #endif
 
@@ -2891,33 +3110,96 @@ static  void  FS_FAT_LFN_SFN_FmtTail (CPU_INT32U         name_8_3[],
 
 /*
 *********************************************************************************************************
-*                                  FS_FAT_LFN_SFN_DirEntryFindMax()
+*                                      FS_FAT_LFN_SFN_HashFmt()
+*
+* Description : Format hashed basis SFN.
+*
+* Argument(s) : name_8_3    Basis SFN.
+*
+*               char_cnt    Number of characters in basis SFN.
+*
+*               hash        Hash of the LFN.
+*
+*               p_basis     Pointer to basis that will receive the hashed basis SFN.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The hashed basis SFN is made of the first FS_FAT_LFN_SFN_HASH_PREFIX_LEN characters of
+*                   the basis SFN followed by 4 upper-case hexadecimal digits of the folded hash; the
+*                   extension is kept.  For example, 'Long file name 00123.txt' may become 'LOE3A1~1.TXT'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FS_FAT_LFN_SFN_HashFmt (CPU_INT32U             name_8_3[],
+                                      FS_FILE_NAME_LEN       char_cnt,
+                                      CPU_INT32U             hash,
+                                      FS_FAT_LFN_SFN_BASIS  *p_basis)
+{
+    CPU_INT08U        name_8_3_08[12];
+    FS_FILE_NAME_LEN  char_ix;
+    FS_FILE_NAME_LEN  prefix_len;
+    CPU_INT16U        hash_16;
+    CPU_INT08U        hash_dig;
+
+
+    MEM_VAL_SET_INT32U((void *)&name_8_3_08[0], name_8_3[0]);
+    MEM_VAL_SET_INT32U((void *)&name_8_3_08[4], name_8_3[1]);
+    MEM_VAL_SET_INT32U((void *)&name_8_3_08[8], name_8_3[2]);
+
+    prefix_len       = DEF_MIN(char_cnt, FS_FAT_LFN_SFN_HASH_PREFIX_LEN);
+    hash_16          = (CPU_INT16U)((hash ^ (hash >> 16)) & DEF_INT_16_MASK);
+    p_basis->CharCnt = prefix_len + 4u;
+    char_ix          = p_basis->CharCnt;
+    while (char_ix > prefix_len) {                              /* Fmt hash dig's after prefix (see Note #1).           */
+        char_ix--;
+        hash_dig = (CPU_INT08U)(hash_16 & 0x0Fu);
+        if (hash_dig < 10u) {
+            name_8_3_08[char_ix] = hash_dig + (CPU_INT08U)ASCII_CHAR_DIGIT_ZERO;
+        } else {
+            name_8_3_08[char_ix] = (hash_dig - 10u) + (CPU_INT08U)ASCII_CHAR_LATIN_UPPER_A;
+        }
+        hash_16 >>= 4;
+    }
+    for (char_ix = p_basis->CharCnt; char_ix < FS_FAT_SFN_NAME_MAX_NBR_CHAR; char_ix++) {
+        name_8_3_08[char_ix] = (CPU_INT08U)ASCII_CHAR_SPACE;
+    }
+
+    p_basis->Name_8_3[0] = MEM_VAL_GET_INT32U((void *)&name_8_3_08[0]);
+    p_basis->Name_8_3[1] = MEM_VAL_GET_INT32U((void *)&name_8_3_08[4]);
+    p_basis->Name_8_3[2] = MEM_VAL_GET_INT32U((void *)&name_8_3_08[8]);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    FS_FAT_LFN_SFN_TailMapGet()
 *
-* Description : Search directory for find SFN directory entries with the same stem & return max tail
-*               value.
+* Description : Find numeric tails used in directory with basis SFNs.
 *
 * Argument(s) : p_vol           Pointer to volume.
 *
 *               p_buf           Pointer to temporary buffer.
 *
-*               name_8_3        Entry SFN.
+*               basis_tbl       Table of FS_FAT_LFN_SFN_BASIS_NBR basis SFNs whose tail maps will be set.
 *
 *               dir_start_sec   Directory sector at which search should start.
 *
 *               p_err           Pointer to variable that will receive the return error code from this function :
 *
-*                                   FS_ERR_NONE                       Directory entry found.
-*                                   FS_ERR_DEV                        Device access error.
-*                                   FS_ERR_SYS_DIR_ENTRY_NOT_FOUND    Directory entry not found.
+*                                   FS_ERR_NONE             Tail maps set.
+*                                   FS_ERR_DEV              Device access error.
+*                                   FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
 *
-* Return(s)   : Maximum tail value, if any is found.
-*               0,                  otherwise.
+* Return(s)   : none.
 *
-* Note(s)     : (1) (a) The 'p_temp' pointer is 4-byte aligned since all buffers are 4-byte aligned.
+* Note(s)     : (1) If the directory is indexed, each candidate SFN is looked up in the directory name hash
+*                   index (see 'fs_fat.c  FS_FAT_DirHashSrch()').  A miss is exact; a hit may be a collision
+*                   of hashes, so the tail is treated as used.  No directory sector is read.
 *
-*                   (b) All pointers to directory entries are 4-byte aligned since all directory entries
-*                       lie at a offset multiple of 32 (the size of a directory entry) from the beginning
-*                       of a sector.
+*                   Otherwise, the directory is read once & every SFN entry bearing a numeric tail is
+*                   checked against all bases (see 'FS_FAT_LFN_SFN_TailMapGetInSec()').
 *
 *               (2) The sector number gotten from the FAT should be valid.  These checks are effectively
 *                   redundant.
@@ -2925,23 +3207,68 @@ static  void  FS_FAT_LFN_SFN_FmtTail (CPU_INT32U         name_8_3[],
 */
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  FS_FAT_SFN_TAIL  FS_FAT_LFN_SFN_DirEntryFindMax (FS_VOL          *p_vol,
-                                                         FS_BUF          *p_buf,
-                                                         CPU_INT32U       name_8_3[],
-                                                         FS_FAT_SEC_NBR   dir_start_sec,
-                                                         FS_ERR          *p_err)
+static  void  FS_FAT_LFN_SFN_TailMapGet (FS_VOL                *p_vol,
+                                         FS_BUF                *p_buf,
+                                         FS_FAT_LFN_SFN_BASIS   basis_tbl[],
+                                         FS_FAT_SEC_NBR         dir_start_sec,
+                                         FS_ERR                *p_err)
 {
-    FS_FAT_SEC_NBR    dir_cur_sec;
-    CPU_BOOLEAN       dir_sec_valid;
-    FS_FAT_SFN_TAIL   max;
-    FS_FAT_SFN_TAIL   max_temp;
-    FS_FAT_DATA      *p_fat_data;
+    FS_FAT_SEC_NBR         dir_cur_sec;
+    CPU_BOOLEAN            dir_sec_valid;
+    FS_FAT_DATA           *p_fat_data;
+    FS_FAT_LFN_SFN_BASIS  *p_basis;
+    CPU_INT08U             basis_ix;
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)
+    CPU_INT32U             name_8_3[3];
+    FS_FAT_SFN_TAIL        tail_nbr;
+    CPU_BOOLEAN            indexed;
+    CPU_BOOLEAN            found;
+#endif
+
+
+    for (basis_ix = 0u; basis_ix < FS_FAT_LFN_SFN_BASIS_NBR; basis_ix++) {
+        p_basis = &basis_tbl[basis_ix];
+        Mem_Clr((void *)&p_basis->TailMap[0], sizeof(p_basis->TailMap));
+    }
+
+
+#if (FS_FAT_CFG_DIR_HASH_NBR > 0u)                              /* ------------------ SRCH DIR INDEX ------------------ */
+    indexed = DEF_YES;                                          /* See Note #1.                                         */
+    for (basis_ix = 0u; (basis_ix < FS_FAT_LFN_SFN_BASIS_NBR) && (indexed == DEF_YES); basis_ix++) {
+        p_basis  = &basis_tbl[basis_ix];
+        tail_nbr =  1u;
+        while ((tail_nbr <= FS_FAT_CFG_SFN_TAIL_NUM_MAX) && (indexed == DEF_YES)) {
+            name_8_3[0] = p_basis->Name_8_3[0];
+            name_8_3[1] = p_basis->Name_8_3[1];
+            name_8_3[2] = p_basis->Name_8_3[2];
+            FS_FAT_LFN_SFN_FmtTail(name_8_3, p_basis->CharCnt, tail_nbr);
+
+            indexed = FS_FAT_DirHashSrch( p_vol,
+                                          dir_start_sec,
+                                          FS_FAT_SFN_Hash((void *)&name_8_3[0]),
+                                         &found);
+            if (found == DEF_YES) {
+                DEF_BIT_SET(p_basis->TailMap[tail_nbr >> 5], (CPU_INT32U)1u << (tail_nbr & 31u));
+            }
+            tail_nbr++;
+        }
+    }
+    if (indexed == DEF_YES) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    for (basis_ix = 0u; basis_ix < FS_FAT_LFN_SFN_BASIS_NBR; basis_ix++) {
+        p_basis = &basis_tbl[basis_ix];
+        Mem_Clr((void *)&p_basis->TailMap[0], sizeof(p_basis->TailMap));
+    }
+#endif
 
 
+                                                                /* --------------------- SRCH DIR --------------------- */
     p_fat_data    = (FS_FAT_DATA *)p_vol->DataPtr;
     dir_cur_sec   =  dir_start_sec;
     dir_sec_valid =  FS_FAT_IS_VALID_SEC(p_fat_data, dir_cur_sec);
-    max           =  0u;
 
     while (dir_sec_valid == DEF_YES) {                          /* While sec is valid (see Note #2).                    */
         FSBuf_Set(p_buf,
@@ -2950,21 +3277,20 @@ static  FS_FAT_SFN_TAIL  FS_FAT_LFN_SFN_DirEntryFindMax (FS_VOL          *p_vol,
                   DEF_YES,
                   p_err);
         if (*p_err != FS_ERR_NONE) {
-            return (0u);
+            return;
         }
 
-        max_temp = FS_FAT_LFN_SFN_DirEntryFindMaxInSec(p_buf->DataPtr,
-                                                       p_fat_data->SecSize,
-                                                       name_8_3,
-                                                       p_err);
-
-        max      = DEF_MAX(max, max_temp);
+        FS_FAT_LFN_SFN_TailMapGetInSec(p_buf->DataPtr,
+                                       p_fat_data->SecSize,
+                                       basis_tbl,
+                                       p_err);
 
         switch (*p_err) {
-            case FS_ERR_SYS_DIR_ENTRY_NOT_FOUND:                /* No entry with matching name exists.                  */
-                 return (max);
+            case FS_ERR_SYS_DIR_ENTRY_NOT_FOUND:                /* All subsequent entries free.                         */
+                *p_err = FS_ERR_NONE;
+                 return;
 
-            case FS_ERR_SYS_DIR_ENTRY_NOT_FOUND_YET:            /* Entry with matching name MAY exist in later sec.     */
+            case FS_ERR_SYS_DIR_ENTRY_NOT_FOUND_YET:            /* Entries MAY exist in later sec.                      */
                  dir_cur_sec = FS_FAT_SecNextGet(p_vol,
                                                  p_buf,
                                                  dir_cur_sec,
@@ -2980,45 +3306,41 @@ static  FS_FAT_SFN_TAIL  FS_FAT_LFN_SFN_DirEntryFindMax (FS_VOL          *p_vol,
                      case FS_ERR_SYS_CLUS_CHAIN_END:            /* No more secs exist in dir.                           */
                      case FS_ERR_SYS_CLUS_INVALID:
                          *p_err = FS_ERR_NONE;
-                          return (max);
+                          return;
 
 
                      case FS_ERR_DEV:
                      default:
-                          return (0u);
+                          return;
                  }
                  break;
 
-            case FS_ERR_DEV:
-                 return (0u);
-
             default:
-                 FS_TRACE_DBG(("FS_FAT_LFN_SFN_DirEntryFindMax(): Default case reached.\r\n"));
-                 return (0u);
+                 FS_TRACE_DBG(("FS_FAT_LFN_SFN_TailMapGet(): Default case reached.\r\n"));
+                *p_err = FS_ERR_ENTRY_CORRUPT;
+                 return;
         }
     }
 
 
                                                                 /* Invalid sec found (see Note #2).                     */
-    FS_TRACE_DBG(("FS_FAT_LFN_SFN_DirEntryFindMax(): Invalid sec gotten: %d.\r\n", dir_cur_sec));
+    FS_TRACE_DBG(("FS_FAT_LFN_SFN_TailMapGet(): Invalid sec gotten: %d.\r\n", dir_cur_sec));
    *p_err = FS_ERR_ENTRY_CORRUPT;
-    return (0u);
 }
 #endif
 
 
 /*
 *********************************************************************************************************
-*                                FS_FAT_LFN_SFN_DirEntryFindMaxInSec()
+*                                  FS_FAT_LFN_SFN_TailMapGetInSec()
 *
-* Description : Search directory sector to find SFN directory entry with the same stem & return max tail
-*               value.
+* Description : Find numeric tails used in directory sector with basis SFNs.
 *
 * Argument(s) : p_temp      Pointer to buffer of directory sector.
 *
 *               sec_size    Sector size, in octets.
 *
-*               name_8_3    Entry SFN.
+*               basis_tbl   Table of FS_FAT_LFN_SFN_BASIS_NBR basis SFNs whose tail maps will be updated.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
@@ -3026,106 +3348,99 @@ static  FS_FAT_SFN_TAIL  FS_FAT_LFN_SFN_DirEntryFindMax (FS_VOL          *p_vol,
 *                                                                         (so search SHOULD end).
 *                               FS_ERR_SYS_DIR_ENTRY_NOT_FOUND_YET    Non-free subsequent entries may exist.
 *
-* Return(s)   : Maximum tail value, if any is found.
-*               0,                  otherwise.
+* Return(s)   : none.
 *
 * Note(s)     : (1) (a) The 'p_temp' pointer is 4-byte aligned since all sectors are 4-byte aligned.
 *
 *                   (b) All pointers to directory entries are 4-byte aligned since all directory entries
 *                       lie at a offset multiple of 32 (the size of a directory entry) from the beginning
 *                       of a sector.
+*
+*               (2) The tail of an SFN is the '~' followed by decimal digits up to the first space of the
+*                   name.  The tail is only used with a basis if the whole SFN, extension included, is the
+*                   basis with that tail; e.g., 'LONGFI~1.DAT' does not use tail 1 with 'LONGFILE.TXT'.
 *********************************************************************************************************
 */
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  FS_FAT_SFN_TAIL  FS_FAT_LFN_SFN_DirEntryFindMaxInSec (void         *p_temp,
-                                                              FS_SEC_SIZE   sec_size,
-                                                              CPU_INT32U    name_8_3[],
-                                                              FS_ERR       *p_err)
+static  void  FS_FAT_LFN_SFN_TailMapGetInSec (void                  *p_temp,
+                                              FS_SEC_SIZE            sec_size,
+                                              FS_FAT_LFN_SFN_BASIS   basis_tbl[],
+                                              FS_ERR                *p_err)
 {
-    CPU_INT08U        cmp_len;
-    CPU_INT08U        data_08;
-    CPU_BOOLEAN       dig;
-    CPU_BOOLEAN       space;
-    FS_FAT_SFN_TAIL   max;
-    FS_FAT_SFN_TAIL   max_temp;
-    CPU_INT08U        name_char;
-    CPU_INT08U        name_cmp_char;
-    FS_SEC_SIZE       sec_pos;
-    CPU_INT08U       *p_buf_08;
-    CPU_INT08U       *p_name;
-    CPU_INT08U       *p_name_cmp;
-    CPU_INT08U        name_8_3_08[12];
-
+    CPU_INT08U             data_08;
+    CPU_INT08U             name_char;
+    FS_FILE_NAME_LEN       char_ix;
+    FS_FAT_SFN_TAIL        tail_nbr;
+    CPU_BOOLEAN            tail_valid;
+    CPU_INT08U             basis_ix;
+    FS_SEC_SIZE            sec_pos;
+    CPU_INT08U            *p_buf_08;
+    FS_FAT_LFN_SFN_BASIS  *p_basis;
+    CPU_INT32U             name_8_3[3];
+    CPU_BOOLEAN            match;
 
 
-    MEM_VAL_SET_INT32U((void *)&name_8_3_08[0], name_8_3[0]);
-    MEM_VAL_SET_INT32U((void *)&name_8_3_08[4], name_8_3[1]);
-    MEM_VAL_SET_INT32U((void *)&name_8_3_08[8], name_8_3[2]);
 
-    p_name   =  name_8_3_08;
-    max      =  0u;
     sec_pos  =  0u;
     p_buf_08 = (CPU_INT08U *)p_temp;
     while (sec_pos < sec_size) {
         data_08 = *p_buf_08;
 
         if (data_08 == FS_FAT_DIRENT_NAME_FREE) {               /* If dir entry free & all subsequent entries free ...  */
-           *p_err = FS_ERR_SYS_DIR_ENTRY_NOT_FOUND;
-            return (max);                                       /* ... rtn cur max.                                     */
+           *p_err = FS_ERR_SYS_DIR_ENTRY_NOT_FOUND;             /* ... end srch.                                        */
+            return;
         }
 
-        if (data_08 != FS_FAT_DIRENT_NAME_ERASED_AND_FREE) {    /* If dir entry NOT free.                               */
-            p_name_cmp    =  p_buf_08;
-            cmp_len       =  0u;
-            name_cmp_char = *p_name_cmp;
-            name_char     = *p_name;
-            while ((name_cmp_char == name_char) &&              /* Cmp first 6 chars of name & dir entry.               */
-                   ( cmp_len      <  FS_FAT_SFN_MAX_STEM_LEN)) {
-                p_name_cmp   +=  sizeof(CPU_INT08U);
-                p_name       +=  sizeof(CPU_INT08U);
-                cmp_len      +=  sizeof(CPU_INT08U);
-                name_cmp_char = *p_name_cmp;
-                name_char     = *p_name;
+        if ((data_08 != FS_FAT_DIRENT_NAME_ERASED_AND_FREE) &&  /* If dir entry NOT free & NOT LFN entry.               */
+            (p_buf_08[FS_FAT_DIRENT_OFF_ATTR] != FS_FAT_DIRENT_ATTR_LONG_NAME)) {
+                                                                /* ------------------ PARSE TAIL NBR ------------------ */
+            char_ix = 1u;                                       /* See Note #2.                                         */
+            while ((char_ix < FS_FAT_SFN_NAME_MAX_NBR_CHAR) &&
+                   (p_buf_08[char_ix] != (CPU_INT08U)ASCII_CHAR_TILDE)) {
+                char_ix++;
             }
 
-            if (cmp_len > 0u) {                                 /* Matching char(s) found.                              */
-                name_cmp_char = *p_name_cmp;
-                if (name_cmp_char == (CPU_INT08U)ASCII_CHAR_TILDE) {    /* Names match up to tilde.                     */
-                    p_name_cmp++;                                       /* Move past tilde.                             */
-                    max_temp = 0u;
-                    while (cmp_len < FS_FAT_SFN_NAME_MAX_NBR_CHAR - 1u) {
-
-                        name_cmp_char  = *p_name_cmp;
-                                                                        /* Chk if tail char is dig.                     */
-                        dig   = ASCII_IS_DIG((CPU_CHAR)name_cmp_char);
-                        space = ASCII_IS_SPACE((CPU_CHAR)name_cmp_char);
-                        if (dig == DEF_NO) {
-                            if(space == DEF_NO) {
-                                max_temp = 0u;                          /* Invalid tail found.                          */
-                            }
-                            break;
-                        }
+            tail_nbr   = 0u;
+            tail_valid = DEF_NO;
+            char_ix++;
+            while (char_ix < FS_FAT_SFN_NAME_MAX_NBR_CHAR) {
+                name_char = p_buf_08[char_ix];
+                if (ASCII_IS_DIG((CPU_CHAR)name_char) == DEF_NO) {
+                    tail_valid = (name_char == (CPU_INT08U)ASCII_CHAR_SPACE) ? tail_valid : DEF_NO;
+                    break;
+                }
+                tail_nbr   = (tail_nbr * 10u) + ((FS_FAT_SFN_TAIL)name_char - (FS_FAT_SFN_TAIL)ASCII_CHAR_DIGIT_ZERO);
+                tail_valid = DEF_YES;
+                char_ix++;
+            }
 
-                        max_temp   *=  10u;
-                        max_temp   += (FS_FAT_SFN_TAIL)name_cmp_char - (FS_FAT_SFN_TAIL)ASCII_CHAR_DIG_ZERO;
-                        cmp_len    +=  sizeof(CPU_INT08U);
-                        p_name_cmp +=  sizeof(CPU_INT08U);
+            if ((tail_valid == DEF_YES) &&
+                (tail_nbr   >= 1u)      &&
+                (tail_nbr   <= FS_FAT_CFG_SFN_TAIL_NUM_MAX)) {
+                                                                /* ------------------ CMP WITH BASES ------------------ */
+                for (basis_ix = 0u; basis_ix < FS_FAT_LFN_SFN_BASIS_NBR; basis_ix++) {
+                    p_basis     = &basis_tbl[basis_ix];
+                    name_8_3[0] =  p_basis->Name_8_3[0];
+                    name_8_3[1] =  p_basis->Name_8_3[1];
+                    name_8_3[2] =  p_basis->Name_8_3[2];
+                    FS_FAT_LFN_SFN_FmtTail(name_8_3, p_basis->CharCnt, tail_nbr);
+
+                    match = Mem_Cmp((void *)&name_8_3[0],
+                                    (void *) p_buf_08,
+                                             FS_FAT_SFN_NAME_MAX_NBR_CHAR + FS_FAT_SFN_EXT_MAX_NBR_CHAR);
+                    if (match == DEF_YES) {
+                        DEF_BIT_SET(p_basis->TailMap[tail_nbr >> 5], (CPU_INT32U)1u << (tail_nbr & 31u));
                     }
-
-                    max = DEF_MAX(max, max_temp);
                 }
             }
-
-            p_name = name_8_3_08;
         }
 
         p_buf_08 += FS_FAT_SIZE_DIR_ENTRY;
         sec_pos  += FS_FAT_SIZE_DIR_ENTRY;
     }
 
-   *p_err = FS_ERR_SYS_DIR_ENTRY_NOT_FOUND_YET;                 /* If dir entry NOT found ... rtn NULL ptr.             */
-    return (max);
+   *p_err = FS_ERR_SYS_DIR_ENTRY_NOT_FOUND_YET;
 }
 #endif
 
@@ -156,6 +156,18 @@ static  void         FS_FAT_SFN_NextDirEntryGet   (FS_VOL             *p_vol,
                                                    FS_FAT_DIR_POS     *p_dir_end_pos,
                                                    FS_ERR             *p_err);
 
+static  CPU_INT08U   FS_FAT_SFN_NameHashGet       (CPU_CHAR           *name,        /* Get hashes of name.              */
+                                                   CPU_CHAR          **p_name_next,
+                                                   CPU_INT32U          hash_tbl[],
+                                                   FS_ERR             *p_err);
+
+static  CPU_INT08U   FS_FAT_SFN_NextDirEntryHash  (FS_VOL             *p_vol,       /* Get hashes of next dir entry.    */
+                                                   FS_BUF             *p_buf,
+                                                   CPU_INT32U          hash_tbl[],
+                                                   FS_FAT_DIR_POS     *p_dir_start_pos,
+                                                   FS_FAT_DIR_POS     *p_dir_end_pos,
+                                                   FS_ERR             *p_err);
+
 
                                                                                     /* ---------- LOCAL FNCTS --------- */
 static  void         FS_FAT_SFN_Parse             (void               *p_dir_entry, /* Parse SFN.                       */
@@ -205,6 +217,8 @@ const  FS_FAT_FN_API  FS_FAT_SFN_API = {
 #endif
     FS_FAT_SFN_DirEntryFind,
     FS_FAT_SFN_NextDirEntryGet,
+    FS_FAT_SFN_NameHashGet,
+    FS_FAT_SFN_NextDirEntryHash,
 };
 
 
@@ -747,6 +761,38 @@ void  FS_FAT_SFN_SFN_Find (FS_VOL          *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FS_FAT_SFN_Hash()
+*
+* Description : Calculate hash of SFN.
+*
+* Argument(s) : name_8_3    Entry SFN, or pointer to SFN directory entry.
+*
+* Return(s)   : Hash of the 11 name & extension octets.
+*
+* Note(s)     : (1) SFNs are compared octet for octet (see 'FS_FAT_SFN_DirEntryFindInSec()'), so the
+*                   octets are hashed as they are, with a basis distinct from that of LFN hashes.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  FS_FAT_SFN_Hash (void  *name_8_3)
+{
+    CPU_INT08U  *p_name_08;
+    CPU_INT32U   hash;
+    CPU_INT08U   ix;
+
+
+    p_name_08 = (CPU_INT08U *)name_8_3;
+    hash      =  FS_FAT_DIR_HASH_INIT_SFN;                      /* See Note #1.                                         */
+    for (ix = 0u; ix < 11u; ix++) {
+        hash = FS_FAT_DIR_HASH_STEP(hash, p_name_08[ix]);
+    }
+
+    return (hash);
+}
+
+
 /*
 *********************************************************************************************************
 *                                        FS_FAT_SFN_LabelGet()
@@ -1533,6 +1579,200 @@ static  void  FS_FAT_SFN_NextDirEntryGet (FS_VOL          *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                      FS_FAT_SFN_NameHashGet()
+*
+* Description : Get hashes under which a name is searched in a directory name hash index.
+*
+* Argument(s) : name            Name of the entry.
+*
+*               p_name_next     Pointer to variable that will receive pointer to character following
+*                               entry name.
+*
+*               hash_tbl        Table that will receive the hashes.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   FS_ERR_NONE            Hashes gotten.
+*                                   FS_ERR_NAME_INVALID    File name is illegal.
+*
+* Return(s)   : Number of hashes gotten.
+*
+* Note(s)     : (1) The name is checked & formed as by 'FS_FAT_SFN_DirEntryFind()'.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  FS_FAT_SFN_NameHashGet (CPU_CHAR     *name,
+                                            CPU_CHAR    **p_name_next,
+                                            CPU_INT32U    hash_tbl[],
+                                            FS_ERR       *p_err)
+{
+    CPU_BOOLEAN        ext_lower_case;
+    CPU_INT32U         name_8_3[3];
+    FS_FILE_NAME_LEN   name_len;
+    CPU_BOOLEAN        name_lower_case;
+
+
+   *p_name_next = name;
+
+    FS_FAT_SFN_Chk( name,                                       /* Chk if valid SFN (see Note #1).                      */
+                   &name_len,
+                    p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+    FS_FAT_SFN_Create( name,
+                      &name_8_3[0],
+                      &name_lower_case,
+                      &ext_lower_case,
+                       p_err);
+    if ((*p_err != FS_ERR_NONE) &&
+        (*p_err != FS_ERR_NAME_MIXED_CASE)) {
+        return (0u);
+    }
+
+   *p_name_next = name + name_len;
+    hash_tbl[0] = FS_FAT_SFN_Hash((void *)&name_8_3[0]);
+   *p_err       = FS_ERR_NONE;
+    return (1u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                    FS_FAT_SFN_NextDirEntryHash()
+*
+* Description : Get hashes of next SFN dir entry from dir.
+*
+* Argument(s) : p_vol               Pointer to volume.
+*
+*               p_buf               Pointer to temporary buffer.
+*
+*               hash_tbl            Table that will receive the hashes.
+*
+*               p_dir_start_pos     Pointer to directory position at which search should start; variable
+*                                   will receive the directory position at which the entry is located.
+*
+*               p_dir_end_pos       Pointer to variable that will receive the directory position at which
+*                                   the entry is located.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       FS_ERR_NONE             Directory entry hashed.
+*                                       FS_ERR_DEV              Device access error.
+*                                       FS_ERR_EOF              End of directory reached.
+*                                       FS_ERR_ENTRY_CORRUPT    File system entry is corrupt.
+*
+* Return(s)   : Number of hashes gotten.
+*
+* Note(s)     : (1) Every entry that 'FS_FAT_SFN_SFN_Find()' may match is hashed, including the volume
+*                   label.  LFN entries are skipped : a formed SFN never matches one.
+*
+*               (2) The sector number gotten from the FAT should be valid.  These checks are effectively
+*                   redundant.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  FS_FAT_SFN_NextDirEntryHash (FS_VOL          *p_vol,
+                                                 FS_BUF          *p_buf,
+                                                 CPU_INT32U       hash_tbl[],
+                                                 FS_FAT_DIR_POS  *p_dir_start_pos,
+                                                 FS_FAT_DIR_POS  *p_dir_end_pos,
+                                                 FS_ERR          *p_err)
+{
+    CPU_INT08U       data_08;
+    FS_FAT_DIR_POS   dir_cur_pos;
+    FS_FAT_SEC_NBR   dir_next_sec;
+    CPU_BOOLEAN      dir_sec_valid;
+    CPU_INT08U       fat_attrib;
+    FS_FAT_DATA     *p_fat_data;
+    CPU_INT08U      *p_temp_08;
+
+
+    p_dir_end_pos->SecNbr =  0u;                                /* Dflt dir end pos.                                    */
+    p_dir_end_pos->SecPos =  0u;
+
+    p_fat_data            = (FS_FAT_DATA *)p_vol->DataPtr;
+
+    dir_cur_pos.SecNbr    =  p_dir_start_pos->SecNbr;
+    dir_cur_pos.SecPos    =  p_dir_start_pos->SecPos;
+    dir_sec_valid         =  FS_FAT_IS_VALID_SEC(p_fat_data, dir_cur_pos.SecNbr);
+
+    while (dir_sec_valid == DEF_YES) {                          /* While sec is valid (see Note #2).                    */
+        FSBuf_Set(p_buf,
+                  dir_cur_pos.SecNbr,
+                  FS_VOL_SEC_TYPE_DIR,
+                  DEF_YES,
+                  p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return (0u);
+        }
+
+        p_temp_08 = (CPU_INT08U *)p_buf->DataPtr + dir_cur_pos.SecPos;
+
+        while (dir_cur_pos.SecPos < p_fat_data->SecSize) {
+            data_08 = *p_temp_08;
+
+            if (data_08 == FS_FAT_DIRENT_NAME_FREE) {           /* ------------ ALL SUBSEQUENT ENTRIES FREE ----------- */
+                p_dir_end_pos->SecNbr = dir_cur_pos.SecNbr;
+                p_dir_end_pos->SecPos = dir_cur_pos.SecPos;
+               *p_err = FS_ERR_EOF;
+                return (0u);
+            }
+
+            if (data_08 != FS_FAT_DIRENT_NAME_ERASED_AND_FREE) {/* ---------------- DIR ENTRY NOT FREE ---------------- */
+                fat_attrib = MEM_VAL_GET_INT08U_LITTLE((void *)(p_temp_08 + FS_FAT_DIRENT_OFF_ATTR));
+                if (FS_FAT_DIRENT_ATTR_IS_LONG_NAME(fat_attrib) == DEF_NO) {    /* See Note #1.                         */
+                    hash_tbl[0]             = FS_FAT_SFN_Hash((void *)p_temp_08);
+                    p_dir_start_pos->SecNbr = dir_cur_pos.SecNbr;
+                    p_dir_start_pos->SecPos = dir_cur_pos.SecPos;
+                    p_dir_end_pos->SecNbr   = dir_cur_pos.SecNbr;
+                    p_dir_end_pos->SecPos   = dir_cur_pos.SecPos;
+                   *p_err = FS_ERR_NONE;
+                    return (1u);
+                }
+            }
+            p_temp_08          += FS_FAT_SIZE_DIR_ENTRY;
+            dir_cur_pos.SecPos += FS_FAT_SIZE_DIR_ENTRY;
+        }
+
+                                                                /* ------------------ RD NEXT DIR SEC ----------------- */
+        dir_next_sec = FS_FAT_SecNextGet(p_vol,
+                                         p_buf,
+                                         dir_cur_pos.SecNbr,
+                                         p_err);
+
+        switch (*p_err) {
+            case FS_ERR_NONE:
+                 break;
+
+            case FS_ERR_SYS_CLUS_CHAIN_END:
+            case FS_ERR_SYS_CLUS_INVALID:
+            case FS_ERR_DIR_FULL:
+                 p_dir_end_pos->SecNbr = dir_cur_pos.SecNbr;
+                 p_dir_end_pos->SecPos = dir_cur_pos.SecPos;
+                *p_err = FS_ERR_EOF;
+                 return (0u);
+
+            case FS_ERR_DEV:
+            default:
+                 return (0u);
+        }
+
+        dir_sec_valid      = FS_FAT_IS_VALID_SEC(p_fat_data, dir_next_sec);
+        dir_cur_pos.SecNbr = dir_next_sec;
+        dir_cur_pos.SecPos = 0u;
+    }
+
+                                                                /* Invalid sec found (see Note #2).                     */
+    FS_TRACE_DBG(("FS_FAT_SFN_NextDirEntryHash(): Invalid sec gotten: %d.\r\n", dir_cur_pos.SecNbr));
+   *p_err = FS_ERR_ENTRY_CORRUPT;
+    return (0u);
+}
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
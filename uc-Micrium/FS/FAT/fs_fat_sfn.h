@@ -126,6 +126,8 @@ void  FS_FAT_SFN_SFN_Find   (FS_VOL            *p_vol,          /* Srch dir for
                              FS_FAT_DIR_POS    *p_dir_end_pos,
                              FS_ERR            *p_err);
 
+CPU_INT32U  FS_FAT_SFN_Hash (void              *name_8_3);      /* Calc hash of SFN.                                    */
+
 void  FS_FAT_SFN_LabelGet   (FS_VOL            *p_vol,          /* Get volume label.                                    */
                              CPU_CHAR          *label,
                              FS_ERR            *p_err);
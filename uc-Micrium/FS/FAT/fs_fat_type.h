@@ -140,6 +140,13 @@ typedef  struct  fs_fat_type_api {
                                          FS_FAT_CLUS_NBR    clus,
                                          FS_ERR            *p_err);
 
+    FS_FAT_CLUS_NBR  (*ClusValRdSec)    (FS_VOL            *p_vol,
+                                         FS_BUF            *p_buf,
+                                         FS_FAT_CLUS_NBR    clus,
+                                         FS_FAT_CLUS_NBR    clus_cnt,
+                                         FS_FAT_CLUS_NBR   *p_val_tbl,
+                                         FS_ERR            *p_err);
+
     FS_FAT_CLUS_NBR    ClusBad;
     FS_FAT_CLUS_NBR    ClusEOF;
     FS_FAT_CLUS_NBR    ClusFree;
@@ -195,6 +202,18 @@ typedef  struct  fs_fat_fn_api {
                                          FS_FAT_DIR_POS    *p_dir_start_pos,
                                          FS_FAT_DIR_POS    *p_dir_end_pos,
                                          FS_ERR            *p_err);
+
+    CPU_INT08U       (*NameHashGet)     (CPU_CHAR          *name,       /* Get hashes of name.                          */
+                                         CPU_CHAR         **p_name_next,
+                                         CPU_INT32U         hash_tbl[],
+                                         FS_ERR            *p_err);
+
+    CPU_INT08U       (*NextDirEntryHash)(FS_VOL            *p_vol,      /* Get hashes of next dir entry in dir.         */
+                                         FS_BUF            *p_buf,
+                                         CPU_INT32U         hash_tbl[],
+                                         FS_FAT_DIR_POS    *p_dir_start_pos,
+                                         FS_FAT_DIR_POS    *p_dir_end_pos,
+                                         FS_ERR            *p_err);
 } FS_FAT_FN_API;
 
 
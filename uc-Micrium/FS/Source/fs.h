@@ -319,6 +319,35 @@ void         FS_WorkingDirObjFree (CPU_CHAR      *path_buf);        /* Free work
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                          DEVICE I/O HOOKS
+*
+* Note(s) : (1) FS_DEV_IO_HOOK_xx_START() & FS_DEV_IO_HOOK_xx_END() are invoked by FSDev_RdLocked(),
+*               FSDev_WrLocked(), FSDev_RdV_Locked() & FSDev_WrV_Locked() immediately before & after each
+*               device driver access ('cnt' being the total number of sectors of a vectored access).
+*               They MAY be #define'd in 'fs_cfg.h' (e.g. to feed an event trace recorder) & default to
+*               nothing.
+*********************************************************************************************************
+*/
+
+#ifndef  FS_DEV_IO_HOOK_RD_START
+#define  FS_DEV_IO_HOOK_RD_START(p_dev, start, cnt)
+#endif
+
+#ifndef  FS_DEV_IO_HOOK_RD_END
+#define  FS_DEV_IO_HOOK_RD_END(p_dev, start, cnt, err)
+#endif
+
+#ifndef  FS_DEV_IO_HOOK_WR_START
+#define  FS_DEV_IO_HOOK_WR_START(p_dev, start, cnt)
+#endif
+
+#ifndef  FS_DEV_IO_HOOK_WR_END
+#define  FS_DEV_IO_HOOK_WR_END(p_dev, start, cnt, err)
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                         FUNCTION PROTOTYPES
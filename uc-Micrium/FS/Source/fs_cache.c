@@ -66,6 +66,17 @@
 *********************************************************************************************************
 */
 
+#define  FS_CACHE_IX_NONE                 ((FS_SEC_QTY)-1)      /* No buf/slot ix.                                      */
+
+#define  FS_CACHE_LIST_FREE                        0u           /* Buf unused.                                          */
+#define  FS_CACHE_LIST_A1IN                        1u           /* Buf on A1in FIFO (seen once).                        */
+#define  FS_CACHE_LIST_AM                          2u           /* Buf on Am   LRU  (seen more than once).              */
+
+#define  FS_CACHE_HASH_SLOT_EMPTY                  0u
+#define  FS_CACHE_HASH_MULT               2654435761u           /* Knuth multiplicative hash constant.                  */
+
+#define  FS_CACHE_ALIGN(size)           ((((size) + sizeof(CPU_ALIGN) - 1u) / sizeof(CPU_ALIGN)) * sizeof(CPU_ALIGN))
+
 
 /*
 *********************************************************************************************************
@@ -80,21 +91,102 @@
 *********************************************************************************************************
 */
 
+/*
+*********************************************************************************************************
+*                                        CACHE LIST DATA TYPE
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_cache_list {
+    FS_SEC_QTY    Head;                                         /* Ix of most  recently inserted/used buf.              */
+    FS_SEC_QTY    Tail;                                         /* Ix of least recently inserted/used buf.              */
+    FS_SEC_QTY    Cnt;                                          /* Nbr of bufs on list.                                 */
+} FS_CACHE_LIST;
+
+/*
+*********************************************************************************************************
+*                                        CACHE ENTRY DATA TYPE
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_cache_entry {
+    FS_SEC_QTY    Prev;                                         /* Ix of prev buf on list (towards head).               */
+    FS_SEC_QTY    Next;                                         /* Ix of next buf on list (towards tail).               */
+    CPU_INT08U    List;                                         /* List buf is on.                                      */
+    CPU_BOOLEAN   RdAhead;                                      /* Sec rd ahead & not yet accessed.                     */
+    CPU_INT32U    DirtyTick;                                    /* Wr back tick when buf became dirty.                  */
+} FS_CACHE_ENTRY;
+
 /*
 *********************************************************************************************************
 *                                        CACHE DATA DATA TYPE
+*
+* Note(s) : (1) Each sector type (management, directory, file) is cached in its own set of buffers,
+*               replaced according to the 2Q algorithm (T. Johnson & D. Shasha, "2Q: A Low Overhead High
+*               Performance Buffer Management Replacement Algorithm", VLDB 1994) :
+*
+*               (a) A sector read or written for the first time is placed on the A1in FIFO.  A sector
+*                   hit while on A1in is NOT promoted, so that sequential scans (e.g., file data or a
+*                   directory walk) cannot flush the frequently used sectors.
+*
+*               (b) When a buffer must be reclaimed, the tail of A1in is evicted if A1in holds more than
+*                   'A1inSizeMax' buffers; otherwise, the least recently used buffer of Am is evicted.
+*                   The sector number of a buffer evicted from A1in is remembered on the A1out ghost
+*                   ring ('GhostTbl').
+*
+*               (c) A missed sector found on the ghost ring was re-referenced shortly after leaving
+*                   A1in : it is placed directly on the Am LRU list.
+*
+*           (2) Buffers & ghost entries are indexed by sector number in an open-addressing hash table
+*               ('HashTbl', linear probing, backward-shift deletion).  A slot holds :
+*
+*               (a) 0,                                  if the slot is empty;
+*               (b) 1 + buf ix,                         if the slot refers to a buffer;
+*               (c) 1 + 'Size' + ghost ix,              if the slot refers to a ghost entry.
+*
+*               The table has at least twice as many slots as it may hold entries, so that lookups
+*               (which previously scanned every buffer) take a small, bounded number of probes.
 *********************************************************************************************************
 */
 
 typedef  struct  fs_cache_data {
-    FS_SEC_QTY    Size;
-    FS_SEC_QTY    NextBufToUseIx;
-    FS_BUF      **BufUsedPtrs;
+    FS_SEC_QTY        Size;                                     /* Nbr of bufs.                                         */
+    FS_BUF          **BufUsedPtrs;                              /* Bufs.                                                */
+    FS_CACHE_ENTRY   *EntryTbl;                                 /* List links, one per buf.                             */
+
+    FS_CACHE_LIST     ListFree;                                 /* Unused bufs.                                         */
+    FS_CACHE_LIST     ListA1in;                                 /* A1in FIFO (see Note #1a).                            */
+    FS_CACHE_LIST     ListAm;                                   /* Am   LRU  (see Note #1b).                            */
+    FS_SEC_QTY        A1inSizeMax;                              /* Max nbr of bufs kept on A1in when reclaiming.        */
+    FS_SEC_QTY        RdAheadCnt;                               /* Nbr of bufs rd ahead & not yet accessed.             */
+
+    FS_SEC_NBR       *GhostTbl;                                 /* A1out ghost ring (see Note #1b).                     */
+    FS_SEC_QTY        GhostSize;                                /* Nbr of entries in ghost ring.                        */
+    FS_SEC_QTY        GhostIx;                                  /* Ix of oldest ghost entry (next to overwrite).        */
+
+    FS_SEC_QTY       *HashTbl;                                  /* Sec nbr index (see Note #2).                         */
+    FS_SEC_QTY        HashMask;                                 /* Nbr of slots - 1 (nbr of slots is a power of 2).     */
+    CPU_INT08U        HashShift;                                /* 32 - log2(nbr of slots).                             */
 } FS_CACHE_DATA;
 
 /*
 *********************************************************************************************************
 *                                           CACHE DATA TYPE
+*
+* Note(s) : (1) Multi-sector device requests transfer up to 'XferSize' sectors directly from or to the
+*               cache buffers, as vectored requests ('XferVecTbl', see 'fs_dev.h  DEVICE I/O VECTOR DATA
+*               TYPE') :
+*
+*               (a) In write back mode, dirty buffers are written in ascending sector order, each run of
+*                   consecutive sectors being written with a single device request (see
+*                   'FSCache_EntriesFlush()').
+*
+*               (b) Sectors read ahead are read with a single device request into buffers reclaimed
+*                   beforehand ('XferIxTbl'), then indexed (see 'FSCache_RdAhead()').
+*
+*           (2) 'WrBackTick' counts calls to FSCache_WrBack(); the tick at which each buffer became dirty
+*               is kept in its cache entry, so that a background writer can bound how long written
+*               data stays in the cache only.
 *********************************************************************************************************
 */
 
@@ -103,6 +195,12 @@ typedef  struct  fs_cache {
     FS_SEC_SIZE      SecSize;                                   /* Size of sector (in bytes).                           */
     FS_SEC_QTY       Size;                                      /* Size of cache (in bufs).                             */
 
+    FS_BUF         **WrTbl;                                     /* Dirty bufs to wr (see Note #1).                      */
+    FS_DEV_IO_VEC   *XferVecTbl;                                /* Bufs of multi-sec dev req (see Note #1).             */
+    FS_SEC_QTY      *XferIxTbl;                                 /* Ix's of bufs rd ahead (see Note #1b).                */
+    FS_SEC_QTY       XferSize;                                  /* Max nbr of secs per dev req (0 if none).             */
+    CPU_INT32U       WrBackTick;                                /* Dirty age clock (see Note #2).                       */
+
     FS_CACHE_DATA    DataMgmt;                                  /* Mgmt cache data.                                     */
     FS_CACHE_DATA    DataDir;                                   /* Dir  cache data.                                     */
     FS_CACHE_DATA    DataData;                                  /* Data cache data.                                     */
@@ -110,11 +208,14 @@ typedef  struct  fs_cache {
 #if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
     FS_CTR           StatHitCtr;                                /* Nbr hits.                                            */
     FS_CTR           StatMissCtr;                               /* Nbr misses.                                          */
-    FS_CTR           StatRemoveCtr;                             /* Nbr removes.                                         */
+    FS_CTR           StatRemoveCtr;                             /* Nbr bufs evicted.                                    */
     FS_CTR           StatAllocCtr;                              /* Nbr bufs alloc'd.                                    */
     FS_CTR           StatUpdateCtr;                             /* Nbr bufs updated.                                    */
     FS_CTR           StatRdCtr;                                 /* Nbr rds.                                             */
     FS_CTR           StatRdAvoidCtr;                            /* Nbr rds avoided.                                     */
+    FS_CTR           StatRdAheadCtr;                            /* Nbr secs rd ahead.                                   */
+    FS_CTR           StatRdAheadHitCtr;                         /* Nbr secs rd ahead & later accessed.                  */
+    FS_CTR           StatDirectCtr;                             /* Nbr secs xfer'd around cache.                        */
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
     FS_CTR           StatWrCtr;                                 /* Nbr wrs.                                             */
     FS_CTR           StatWrAvoidCtr;                            /* Nbr wrs avoided.                                     */
@@ -183,14 +284,58 @@ static  void            FSCache_Invalidate      (FS_VOL          *p_vol,
 static  void            FSCache_Flush           (FS_VOL          *p_vol,        /* Flush cache.                         */
                                                  FS_ERR          *p_err);
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void            FSCache_WrBack          (FS_VOL          *p_vol,        /* Wr back aged dirty secs.             */
+                                                 CPU_INT32U       age_max,
+                                                 FS_ERR          *p_err);
+#endif
+
+static  FS_SEC_QTY      FSCache_RdAhead         (FS_VOL          *p_vol,        /* Rd secs ahead into cache.            */
+                                                 FS_SEC_NBR       start,
+                                                 FS_SEC_QTY       cnt,
+                                                 FS_FLAGS         sec_type,
+                                                 FS_ERR          *p_err);
+
+static  void            FSCache_RdDirect        (FS_VOL          *p_vol,        /* Rd secs around cache.                */
+                                                 void            *p_dest,
+                                                 FS_SEC_NBR       start,
+                                                 FS_SEC_QTY       cnt,
+                                                 FS_FLAGS         sec_type,
+                                                 FS_ERR          *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void            FSCache_WrDirect        (FS_VOL          *p_vol,        /* Wr secs around cache.                */
+                                                 void            *p_src,
+                                                 FS_SEC_NBR       start,
+                                                 FS_SEC_QTY       cnt,
+                                                 FS_FLAGS         sec_type,
+                                                 FS_ERR          *p_err);
+
+static  void            FSCache_Clean           (FS_VOL          *p_vol,        /* Wr back dirty secs in range.         */
+                                                 FS_SEC_NBR       start,
+                                                 FS_SEC_QTY       cnt,
+                                                 FS_ERR          *p_err);
+#endif
+
+static  void            FSCache_Query           (FS_VOL          *p_vol,        /* Get cache info.                      */
+                                                 FS_VOL_CACHE_INFO *p_info,
+                                                 FS_ERR          *p_err);
+
 
                                                                                 /* ------------ LOCAL FNCTS ----------- */
                                                                                 /* Init Data cache structure            */
 static  void           FSCache_DataInit         (FS_VOL          *p_vol,
                                                  FS_CACHE_DATA   *p_data_cache,
                                                  FS_BUF         **p_buf_ptrs,
+                                                 void            *p_mem,
                                                  FS_SEC_QTY       size);
 
+static  void           FSCache_DataReset        (FS_CACHE_DATA   *p_cache_data);/* Free all bufs & clr index.           */
+
+static  CPU_INT32U     FSCache_DataMemSizeGet   (FS_SEC_QTY       size);        /* Get size of data cache index mem.    */
+
+static  FS_SEC_QTY     FSCache_HashSizeGet      (FS_SEC_QTY       size);        /* Get nbr of hash slots.               */
+
 static  void           FSCache_BufFree          (FS_BUF          *p_buf);       /* Free buf.                            */
 
 
@@ -199,10 +344,28 @@ static  void           FSCache_EntriesInvalidate(FS_CACHE_DATA   *p_cache_data,
                                                  FS_CACHE        *p_cache);
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  void           FSCache_EntriesFlush     (FS_VOL          *p_vol,
-                                                 FS_CACHE_DATA   *p_cache_data, /* Flush entries from cache.            */
-                                                 FS_DEV          *p_dev,
+static  void           FSCache_EntriesFlush     (FS_CACHE        *p_cache,      /* Flush dirty entries in sec order.    */
+                                                 CPU_INT32U       age_min,
+                                                 FS_ERR          *p_err);
+
+static  FS_SEC_QTY     FSCache_EntriesCollect   (FS_CACHE_DATA   *p_cache_data, /* Collect aged dirty entries.          */
+                                                 FS_CACHE        *p_cache,
+                                                 CPU_INT32U       age_min,
+                                                 FS_SEC_QTY       cnt);
+
+static  void           FSCache_EntriesSort      (FS_BUF         **p_buf_tbl,    /* Sort bufs by sec nbr.                */
+                                                 FS_SEC_QTY       cnt);
+
+static  FS_SEC_QTY     FSCache_EntriesGather    (FS_CACHE        *p_cache,      /* Gather dirty run around buf.         */
+                                                 FS_BUF          *p_buf);
+
+static  void           FSCache_EntriesWr        (FS_CACHE        *p_cache,      /* Wr run of consecutive dirty bufs.    */
+                                                 FS_BUF         **p_buf_tbl,
+                                                 FS_SEC_QTY       cnt,
                                                  FS_ERR          *p_err);
+
+static  FS_BUF        *FSCache_DirtyBufGet      (FS_CACHE        *p_cache,      /* Get dirty buf holding sec.           */
+                                                 FS_SEC_NBR       start);
 #endif
 
 static  void           FSCache_EntriesRelease   (FS_CACHE_DATA   *p_cache_data, /* Release entries from cache.          */
@@ -210,14 +373,51 @@ static  void           FSCache_EntriesRelease   (FS_CACHE_DATA   *p_cache_data,
                                                  FS_SEC_NBR       start,
                                                  FS_SEC_QTY       cnt);
 
-static  void           FSCache_EntryFlush       (FS_BUF          *p_buf,        /* Flush cache entry.                   */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void           FSCache_EntriesDirtyCopy (FS_CACHE_DATA   *p_cache_data, /* Copy dirty entries into buf.         */
+                                                 FS_CACHE        *p_cache,
+                                                 CPU_INT08U      *p_dest,
+                                                 FS_SEC_NBR       start,
+                                                 FS_SEC_QTY       cnt);
+#endif
+
+
+static  FS_SEC_QTY     FSCache_EntryFind        (FS_CACHE_DATA   *p_cache_data, /* Find entry in cache.                 */
+                                                 FS_SEC_NBR       start);
+
+static  void           FSCache_EntryDrop        (FS_CACHE_DATA   *p_cache_data, /* Remove buf from cache.               */
+                                                 FS_SEC_QTY       buf_ix,
+                                                 FS_SEC_QTY       slot_ix);
+
+static  void           FSCache_RdAheadClr       (FS_CACHE_DATA   *p_cache_data, /* Clr rd ahead mark of buf.            */
+                                                 FS_SEC_QTY       buf_ix);
+
+static  FS_SEC_QTY     FSCache_BufReclaim       (FS_CACHE        *p_cache,      /* Get buf to store new sec.            */
+                                                 FS_CACHE_DATA   *p_cache_data,
                                                  FS_ERR          *p_err);
 
-static  void           FSCache_UpdateIndex      (FS_CACHE_DATA   *p_cache_data);/* Get next entry in the cache.         */
+static  void           FSCache_GhostAdd         (FS_CACHE_DATA   *p_cache_data, /* Add sec to ghost ring.               */
+                                                 FS_SEC_NBR       sec);
 
+static  FS_SEC_QTY     FSCache_HashHome         (FS_CACHE_DATA   *p_cache_data, /* Get home slot of sec.                */
+                                                 FS_SEC_NBR       sec);
 
-static  FS_BUF       **FSCache_EntryFind        (FS_CACHE_DATA   *p_cache_data, /* Find entry in cache.                 */
-                                                 FS_SEC_NBR       start);
+static  void           FSCache_HashAdd          (FS_CACHE_DATA   *p_cache_data, /* Add entry to index.                  */
+                                                 FS_SEC_NBR       sec,
+                                                 FS_SEC_QTY       val);
+
+static  void           FSCache_HashRemove       (FS_CACHE_DATA   *p_cache_data, /* Remove entry from index.             */
+                                                 FS_SEC_QTY       slot_ix);
+
+static  FS_CACHE_LIST *FSCache_ListGet          (FS_CACHE_DATA   *p_cache_data, /* Get list by id.                      */
+                                                 CPU_INT08U       list_id);
+
+static  void           FSCache_ListInsert       (FS_CACHE_DATA   *p_cache_data, /* Insert buf at head of list.          */
+                                                 CPU_INT08U       list_id,
+                                                 FS_SEC_QTY       buf_ix);
+
+static  void           FSCache_ListRemove       (FS_CACHE_DATA   *p_cache_data, /* Remove buf from its list.            */
+                                                 FS_SEC_QTY       buf_ix);
 
 static  void           FSCache_ObjClr           (FS_CACHE        *p_cache);     /* Clr cache obj.                       */
 
@@ -232,6 +432,15 @@ static  CPU_BOOLEAN    FSCache_SecPut           (FS_CACHE        *p_cache,
                                                  FS_FLAGS         sec_type,
                                                  CPU_BOOLEAN      rd);
 
+static  FS_CACHE_DATA *FSCache_SecFind          (FS_CACHE        *p_cache,      /* Find buf holding sec.                */
+                                                 FS_FLAGS         sec_type,
+                                                 FS_SEC_NBR       start,
+                                                 FS_SEC_QTY      *p_buf_ix);
+
+static  void           FSCache_SecDiscard       (FS_CACHE        *p_cache,      /* Discard sec from other types' cache. */
+                                                 FS_CACHE_DATA   *p_cache_data,
+                                                 FS_SEC_NBR       start);
+
 static  FS_CACHE_DATA *FSCache_GetData          (FS_CACHE        *p_cache,      /* Get Cache data by sector type        */
                                                  FS_FLAGS         sec_type);
 
@@ -250,7 +459,17 @@ const  FS_VOL_CACHE_API  FSCache_Dflt = {
     FSCache_Wr,
 #endif
     FSCache_Invalidate,
-    FSCache_Flush
+    FSCache_Flush,
+    FSCache_Query,
+    FSCache_RdAhead,
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    FSCache_WrBack,
+#endif
+    FSCache_RdDirect,
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    FSCache_WrDirect,
+    FSCache_Clean
+#endif
 };
 
 
@@ -310,7 +529,20 @@ const  FS_VOL_CACHE_API  FSCache_Dflt = {
 *
 * Return(s)   : none.
 *
-* Note(s)     : (1) Write back cache NOT supported.
+* Note(s)     : (1) A write back cache writes dirty sectors when they are evicted, when the cache is
+*                   flushed & when they age past FSVol_CacheWrBack()'s limit (see 'CACHE DATA TYPE
+*                   Note(s)').
+*
+*               (2) Besides the buffers, the cache memory holds, for each sector type, the replacement
+*                   list links, ghost ring & sector index described in 'CACHE DATA DATA TYPE  Note(s)'.
+*                   These take roughly 20 to 40 octets per buffer; the number of buffers is reduced
+*                   until buffers & index fit in 'size' octets.
+*
+*               (3) The cache also holds the transfer tables of multi-sector device requests, which
+*                   span one quarter of the buffers, up to FS_CACHE_CFG_XFER_SEC_MAX sectors (see 'CACHE
+*                   DATA TYPE  Note #1'), & a write back cache a table of buffer pointers used to sort
+*                   dirty buffers.  Caches with fewer than 8 buffers have no transfer tables : they
+*                   neither merge writes nor read ahead.
 *********************************************************************************************************
 */
 
@@ -327,13 +559,18 @@ static  void  FSCache_Create (FS_VOL       *p_vol,
     CPU_INT32U    buf_size;
     FS_CACHE     *p_cache;
     FS_SEC_QTY    cache_size;
-    FS_SEC_QTY    cache_size_max;
     FS_SEC_QTY    cache_size_mgmt;
     FS_SEC_QTY    cache_size_dir;
     FS_SEC_QTY    cache_size_data;
+    FS_SEC_QTY    buf_ix;
     CPU_INT32U    offset;
+    CPU_INT32U    mem_size;
+    FS_SEC_QTY    xfer_size;
     FS_BUF      **p_buf_used_ptrs;
     CPU_INT08U   *p_cache_data_08;
+    CPU_INT08U   *p_mem_mgmt;
+    CPU_INT08U   *p_mem_dir;
+    CPU_INT08U   *p_mem_data;
 
 
 #if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
@@ -382,44 +619,85 @@ static  void  FSCache_Create (FS_VOL       *p_vol,
     }
     buf_size   = sizeof(FS_BUF) + align;
 
-    cache_size_max   =  size / (buf_size + sec_size);
-
-    p_buf_used_ptrs  = (FS_BUF **)p_cache_data_08;             /* Alloc used buf ptr array.                            */
-    offset          +=  sizeof(CPU_ADDR) * cache_size_max;
-    p_cache_data_08 +=  sizeof(CPU_ADDR) * cache_size_max;
+                                                                /* Find nbr of bufs that fit with index (see Note #2).  */
+    cache_size  = size / (buf_size + sec_size);
+    xfer_size   = 0u;
+    while (cache_size > 0u) {
+        cache_size_mgmt = (cache_size * pct_mgmt + (100u - 1u)) / 100u;
+        cache_size_dir  = (cache_size * pct_dir  + (100u - 1u)) / 100u;
 
+        if (cache_size_mgmt + cache_size_dir > cache_size) {
+            cache_size_mgmt--;
+            if (cache_size_mgmt + cache_size_dir > cache_size) {
+                cache_size_dir--;
+            }
+        }
+        cache_size_data = (cache_size - cache_size_mgmt) - cache_size_dir;
+
+        mem_size = offset
+                 + FS_CACHE_ALIGN(sizeof(CPU_ADDR) * cache_size)
+                 + FSCache_DataMemSizeGet(cache_size_mgmt)
+                 + FSCache_DataMemSizeGet(cache_size_dir)
+                 + FSCache_DataMemSizeGet(cache_size_data)
+                 + (buf_size + sec_size) * cache_size;
+
+        xfer_size = cache_size / 4u;                            /* Add xfer tbls (see Note #3).                         */
+        if (xfer_size > FS_CACHE_CFG_XFER_SEC_MAX) {
+            xfer_size = FS_CACHE_CFG_XFER_SEC_MAX;
+        }
+        if (xfer_size < 2u) {
+            xfer_size = 0u;
+        }
+        mem_size += FS_CACHE_ALIGN(sizeof(FS_DEV_IO_VEC) * xfer_size)
+                  + FS_CACHE_ALIGN(sizeof(FS_SEC_QTY)    * xfer_size);
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+        if (mode == FS_VOL_CACHE_MODE_WR_BACK) {                /* Add wr tbl.                                          */
+            mem_size += FS_CACHE_ALIGN(sizeof(CPU_ADDR) * cache_size);
+        }
+#endif
+        if (mem_size <= size) {
+            break;
+        }
+        cache_size--;
+    }
 
-    offset += buf_size + sec_size;
-    if (offset >= size) {                                       /*               ... chk for alloc ovf.                 */
+    if (cache_size == 0u) {                                     /* Chk for alloc ovf.                                   */
        *p_err = FS_ERR_CACHE_TOO_SMALL;
         return;
     }
 
-                                                                /* Clr buf ptrs.                                        */
-    Mem_Clr((void *)p_buf_used_ptrs, sizeof (CPU_ADDR) * cache_size_max);
+    p_buf_used_ptrs  = (FS_BUF **)p_cache_data_08;              /* Alloc used buf ptr array.                            */
+    p_cache_data_08 +=  FS_CACHE_ALIGN(sizeof(CPU_ADDR) * cache_size);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    if (mode == FS_VOL_CACHE_MODE_WR_BACK) {                    /* Alloc wr tbl (see Note #3).                          */
+        p_cache->WrTbl   = (FS_BUF **)p_cache_data_08;
+        p_cache_data_08 +=  FS_CACHE_ALIGN(sizeof(CPU_ADDR) * cache_size);
+    }
+#endif
+
+    p_mem_mgmt       =  p_cache_data_08;                        /* Alloc index mem.                                     */
+    p_cache_data_08 +=  FSCache_DataMemSizeGet(cache_size_mgmt);
+    p_mem_dir        =  p_cache_data_08;
+    p_cache_data_08 +=  FSCache_DataMemSizeGet(cache_size_dir);
+    p_mem_data       =  p_cache_data_08;
+    p_cache_data_08 +=  FSCache_DataMemSizeGet(cache_size_data);
 
 
 
                                                                 /* -------------------- ALLOC BUFS -------------------- */
-    cache_size = 0u;
-    while (offset < size) {
-        p_buf_used_ptrs[cache_size]           = (FS_BUF *)p_cache_data_08;
-        p_cache_data_08                      +=  buf_size;
-        p_buf_used_ptrs[cache_size]->DataPtr  =  p_cache_data_08;
-        p_cache_data_08                      +=  sec_size;
-
-        offset +=  buf_size + sec_size;
-        cache_size++;
+    for (buf_ix = 0u; buf_ix < cache_size; buf_ix++) {
+        p_buf_used_ptrs[buf_ix]           = (FS_BUF *)p_cache_data_08;
+        p_cache_data_08                  +=  buf_size;
+        p_buf_used_ptrs[buf_ix]->DataPtr  =  p_cache_data_08;
+        p_cache_data_08                  +=  sec_size;
     }
 
-    cache_size_mgmt = (cache_size * pct_mgmt + (100u - 1u)) / 100u;
-    cache_size_dir  = (cache_size * pct_dir  + (100u - 1u)) / 100u;
-
-    if (cache_size_mgmt + cache_size_dir > cache_size) {
-        cache_size_mgmt--;
-        if (cache_size_mgmt + cache_size_dir > cache_size) {
-            cache_size_dir--;
-        }
+    if (xfer_size > 0u) {                                       /* Alloc xfer tbls (see Note #3).                       */
+        p_cache->XferVecTbl  = (FS_DEV_IO_VEC *)p_cache_data_08;
+        p_cache_data_08     +=  FS_CACHE_ALIGN(sizeof(FS_DEV_IO_VEC) * xfer_size);
+        p_cache->XferIxTbl   = (FS_SEC_QTY    *)p_cache_data_08;
+        p_cache->XferSize    =  xfer_size;
     }
 
                                                                 /* ------------------ INIT CACHE INFO ----------------- */
@@ -431,19 +709,21 @@ static  void  FSCache_Create (FS_VOL       *p_vol,
     FSCache_DataInit( p_vol,
                      &p_cache->DataMgmt,
                       p_buf_used_ptrs,
+                      p_mem_mgmt,
                       cache_size_mgmt);
                                                                 /* Init Dir cache data.                                 */
     p_buf_used_ptrs += cache_size_mgmt;
     FSCache_DataInit( p_vol,
                      &p_cache->DataDir,
                       p_buf_used_ptrs,
+                      p_mem_dir,
                       cache_size_dir);
                                                                 /* Init Data cache data.                                */
-    cache_size_data  = (cache_size - cache_size_mgmt) - cache_size_dir;
     p_buf_used_ptrs +=  cache_size_dir;
     FSCache_DataInit( p_vol,
                      &p_cache->DataData,
                       p_buf_used_ptrs,
+                      p_mem_data,
                       cache_size_data);
 
     p_vol->CacheDataPtr = (void *)p_cache;
@@ -759,7 +1039,6 @@ static  void  FSCache_Wr (FS_VOL      *p_vol,
     CPU_BOOLEAN     vol_wr;
     FS_SEC_NBR      start_acc;
     FS_SEC_QTY      cnt_acc;
-    FS_CACHE_DATA  *p_cache_data;
 
 
     p_cache = (FS_CACHE *)p_vol->CacheDataPtr;
@@ -784,14 +1063,10 @@ static  void  FSCache_Wr (FS_VOL      *p_vol,
                        start_acc,
                        cnt,
                        p_err);
-                                                                /* Invalidate sects. in the cache for data consistency  */
-        p_cache_data = FSCache_GetData(p_cache, sec_type);
-        if (p_cache_data != (FS_CACHE_DATA *)0) {
-            FSCache_EntriesRelease(p_cache_data,
-                                   p_cache,
-                                   start,
-                                   cnt);
-        }
+                                                                /* Invalidate secs in the cache for data consistency.   */
+        FSCache_EntriesRelease(&p_cache->DataMgmt, p_cache, start, cnt);
+        FSCache_EntriesRelease(&p_cache->DataDir,  p_cache, start, cnt);
+        FSCache_EntriesRelease(&p_cache->DataData, p_cache, start, cnt);
 
        *p_err = FS_ERR_NONE;
         return;
@@ -912,7 +1187,7 @@ static  void  FSCache_Invalidate (FS_VOL  *p_vol,
 *                               FS_ERR_NONE                    Cache flushed.
 *
 *                                                              --- RETURNED BY FSCache_EntriesFlush() ---
-*                               FS_ERR_INVALID_SEC_NBR         Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector start or count invalid.
 *                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
 *                               FS_ERR_DEV_IO                  Device I/O error.
 *                               FS_ERR_DEV_TIMEOUT             Device timeout error.
@@ -946,29 +1221,7 @@ static  void  FSCache_Flush (FS_VOL  *p_vol,
 
 
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)                         /* -------------------- FLUSH CACHE ------------------- */
-    FSCache_EntriesFlush( p_vol,
-                         &p_cache->DataMgmt,                    /* Flush mgmt secs.                                     */
-                          p_vol->DevPtr,
-                          p_err);
-
-    if (*p_err != FS_ERR_NONE) {
-        return;
-    }
-
-    FSCache_EntriesFlush( p_vol,
-                         &p_cache->DataDir,                     /* Flush dir secs.                                      */
-                          p_vol->DevPtr,
-                          p_err);
-
-    if (*p_err != FS_ERR_NONE) {
-        return;
-    }
-
-    FSCache_EntriesFlush( p_vol,
-                         &p_cache->DataData,                    /* Flush data secs.                                     */
-                          p_vol->DevPtr,
-                          p_err);
-
+    FSCache_EntriesFlush(p_cache, 0u, p_err);                   /* Flush all dirty secs.                                */
     if (*p_err != FS_ERR_NONE) {
         return;
     }
@@ -980,370 +1233,1758 @@ static  void  FSCache_Flush (FS_VOL  *p_vol,
 
 /*
 *********************************************************************************************************
-*********************************************************************************************************
-*                                           LOCAL FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
-
-/*
-*********************************************************************************************************
-*                                               FSCache_DataInit()
-*
-* Description : Initialize the data cache structure.
-*
-* Argument(s) : p_vol           Pointer to Volume.
-*               ----------      Argument validated by caller.
+*                                          FSCache_RdAhead()
 *
-*               p_data_cache    Pointer to cache data to initialize.
-*               ----------      Argument validated by caller.
+* Description : Read sectors ahead into the cache.
 *
-*               p_buf_ptrs      Pointer to the start address of cache data buffers
-*               ----------      Argument validated by caller.
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
 *
-*               size            Number of data cache buffer
+*               start       Start sector of read ahead.
 *
-* Return(s)   : none.
+*               cnt         Number of sectors to read ahead.
 *
-* Note(s)     : none.
-*********************************************************************************************************
-*/
-
-static  void  FSCache_DataInit (FS_VOL          *p_vol,
-                                FS_CACHE_DATA   *p_data_cache,
-                                FS_BUF         **p_buf_ptrs,
-                                FS_SEC_QTY       size)
-{
-    CPU_INT32U   i;
-    FS_BUF      *p_buf;
-
-
-    p_data_cache->Size           =  size;
-    p_data_cache->NextBufToUseIx =  0u;
-    p_data_cache->BufUsedPtrs    =  p_buf_ptrs;
-    for (i = 0u; i < size; i++) {
-         p_buf         = p_data_cache->BufUsedPtrs[i];
-         p_buf->State  = FS_BUF_STATE_NONE;
-         p_buf->Start  = (FS_SEC_NBR)(-1);
-         p_buf->VolPtr = p_vol;
-    }
-}
-
-/*
-*********************************************************************************************************
-*                                          FSCache_BufFree()
+*               sec_type    Type of sector(s) :
 *
-* Description : Free buffer by changing its state to FS_BUF_STATE_NONE.
+*                               FS_VOL_SEC_TYPE_MGMT    Management sector.
+*                               FS_VOL_SEC_TYPE_DIR     Directory sector.
+*                               FS_VOL_SEC_TYPE_FILE    File sector.
 *
-* Argument(s) : p_buf       Pointer to buffer.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *               ----------  Argument validated by caller.
 *
-* Return(s)   : none.
+*                               FS_ERR_NONE                   Sector(s) read ahead, or none to read.
 *
-* Note(s)     : none.
-*********************************************************************************************************
-*/
-
-static  void  FSCache_BufFree (FS_BUF  *p_buf)
-{
-    p_buf->State = FS_BUF_STATE_NONE;
-    p_buf->Start = (FS_SEC_NBR)(-1);
-}
-
-
-/*
-*********************************************************************************************************
-*                                     FSCache_EntriesInvalidate()
+*                                                             ------- RETURNED BY FSDev_RdLocked() ------
+*                               FS_ERR_DEV_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
 *
-* Description : Invalidate cache.
+* Return(s)   : Number of sectors, from 'start', now in cache.
 *
-* Argument(s) : p_cache_data    Pointer to cache data.
-*               ----------      Argument validated by caller.
+* Note(s)     : (1) The function caller MUST have acquired a reference to the volume & hold the device lock.
 *
-*               p_cache         Pointer to cache.
-*               ----------      Argument validated by caller.
+*               (2) Sectors already cached are skipped; the run of missing sectors that follows is read
+*                   with a single device request directly into cache buffers (see 'CACHE DATA TYPE  Note
+*                   #1b'), stopping at the next cached sector.  Read ahead sectors enter A1in (see 'CACHE
+*                   DATA DATA TYPE  Note #1a'); no more sectors are read ahead than A1in keeps, so that
+*                   they are not evicted before being read.  Read ahead therefore neither pollutes Am nor
+*                   flushes the cache.
 *
-* Return(s)   : none.
+*               (4) The buffers are all reclaimed before the read, since reclaiming a dirty buffer may
+*                   issue a vectored write through 'XferVecTbl'.  They are indexed once the read
+*                   succeeds, or returned to the free list.
 *
-* Note(s)     : none.
+*               (3) Read ahead sectors are counted as hits when first read (see 'FSCache_SecGet()').
 *********************************************************************************************************
 */
 
-static  void  FSCache_EntriesInvalidate (FS_CACHE_DATA  *p_cache_data,
-                                         FS_CACHE       *p_cache)
+static  FS_SEC_QTY  FSCache_RdAhead (FS_VOL      *p_vol,
+                                     FS_SEC_NBR   start,
+                                     FS_SEC_QTY   cnt,
+                                     FS_FLAGS     sec_type,
+                                     FS_ERR      *p_err)
 {
-    FS_BUF       *p_buf;
-    FS_BUF      **p_buf_ptr;
-    FS_SEC_QTY    buf_ix;
+    FS_CACHE       *p_cache;
+    FS_CACHE_DATA  *p_cache_data;
+    FS_BUF         *p_buf;
+    FS_SEC_NBR      sec;
+    FS_SEC_QTY      cnt_cached;
+    FS_SEC_QTY      cnt_rd;
+    FS_SEC_QTY      buf_ix;
+    FS_SEC_QTY      slot_ix;
+    FS_SEC_QTY      ix;
+    CPU_INT08U      list_id;
 
 
-    (void)p_cache;
+   *p_err = FS_ERR_NONE;
+                                                                /* ------------- VALIDATE CACHE FOR RD AHEAD ---------- */
+    p_cache = (FS_CACHE *)p_vol->CacheDataPtr;
+    if (p_cache == (FS_CACHE *)0) {
+        return (0u);
+    }
+    if (p_cache->XferSize == 0u) {
+        return (0u);
+    }
 
-    if (p_cache_data->Size == 0u) {
-        return;
+    p_cache_data = FSCache_GetData(p_cache, sec_type);
+    if (p_cache_data == (FS_CACHE_DATA *)0) {
+        return (0u);
+    }
+
+    if (cnt > p_cache->XferSize) {                              /* See Note #2.                                         */
+        cnt = p_cache->XferSize;
+    }
+    if (p_cache_data->RdAheadCnt >= p_cache_data->A1inSizeMax) {
+        return (0u);
+    }
+    if (cnt > p_cache_data->A1inSizeMax - p_cache_data->RdAheadCnt) {
+        cnt = p_cache_data->A1inSizeMax - p_cache_data->RdAheadCnt;
+    }
+
+
+
+                                                                /* ------------------ SKIP CACHED SECS ---------------- */
+    cnt_cached = 0u;
+    while ((cnt_cached < cnt) &&
+           (FSCache_SecFind(p_cache, sec_type, start + cnt_cached, &buf_ix) != (FS_CACHE_DATA *)0)) {
+        cnt_cached++;
+    }
+
+    cnt_rd = 0u;
+    while ((cnt_cached + cnt_rd < cnt) &&
+           (FSCache_SecFind(p_cache, sec_type, start + cnt_cached + cnt_rd, &buf_ix) == (FS_CACHE_DATA *)0)) {
+        cnt_rd++;
+    }
+    if (cnt_rd == 0u) {
+        return (cnt_cached);
+    }
+
+
+
+                                                                /* ------------- GET BUFS FOR MISSING SECS ------------ */
+    for (ix = 0u; ix < cnt_rd; ix++) {                          /* See Note #4.                                         */
+        buf_ix = FSCache_BufReclaim(p_cache, p_cache_data, p_err);
+        if (buf_ix == FS_CACHE_IX_NONE) {
+            break;
+        }
+        p_cache->XferIxTbl[ix] = buf_ix;
+    }
+
+    if (ix == cnt_rd) {                                         /* ----------------- RD MISSING SECS ------------------ */
+        for (ix = 0u; ix < cnt_rd; ix++) {
+            p_buf                          = p_cache_data->BufUsedPtrs[p_cache->XferIxTbl[ix]];
+            p_cache->XferVecTbl[ix].BufPtr = p_buf->DataPtr;
+            p_cache->XferVecTbl[ix].Cnt    = 1u;
+        }
+        FSDev_RdV_Locked(p_vol->DevPtr,
+                         p_cache->XferVecTbl,
+                         cnt_rd,
+                         start + cnt_cached + p_vol->PartitionStart,
+                         p_err);
     }
 
-    p_buf_ptr = p_cache_data->BufUsedPtrs;
-    buf_ix    = 0u;
+    if (*p_err != FS_ERR_NONE) {                                /* Free bufs on err.                                    */
+        while (ix > 0u) {
+            ix--;
+            FSCache_ListInsert(p_cache_data, FS_CACHE_LIST_FREE, p_cache->XferIxTbl[ix]);
+        }
+        return (cnt_cached);
+    }
+
+
 
-    while (buf_ix < p_cache_data->Size) {
-        p_buf = *p_buf_ptr;
-        FSCache_BufFree(p_buf);
+                                                                /* ------------------ PUT READ SECS ------------------- */
+    for (ix = 0u; ix < cnt_rd; ix++) {
+        sec     = start + cnt_cached + ix;
+        buf_ix  = p_cache->XferIxTbl[ix];
+        list_id = FS_CACHE_LIST_A1IN;
+        slot_ix = FSCache_EntryFind(p_cache_data, sec);
+        if (slot_ix != FS_CACHE_IX_NONE) {                      /* Sec on ghost ring (see 'FSCache_SecPut()  Note #1'). */
+            p_cache_data->GhostTbl[p_cache_data->HashTbl[slot_ix] - p_cache_data->Size - 1u] = (FS_SEC_NBR)(-1);
+            FSCache_HashRemove(p_cache_data, slot_ix);
+            list_id = FS_CACHE_LIST_AM;
+        }
+
+        p_buf        = p_cache_data->BufUsedPtrs[buf_ix];
+        p_buf->Start = sec;
+        p_buf->State = FS_BUF_STATE_USED;
+        FSCache_HashAdd(p_cache_data, sec, buf_ix + 1u);
+        FSCache_ListInsert(p_cache_data, list_id, buf_ix);
+        FS_CTR_STAT_INC(p_cache->StatAllocCtr);
 
-        buf_ix++;
-        p_buf_ptr++;
+        p_cache_data->EntryTbl[buf_ix].RdAhead = DEF_YES;       /* See Note #3.                                         */
+        p_cache_data->RdAheadCnt++;
     }
 
-    p_cache_data->NextBufToUseIx = 0u;
+    FS_CTR_STAT_ADD(p_cache->StatRdAheadCtr, cnt_rd);
+
+    return (cnt_cached + cnt_rd);
 }
 
 
 /*
 *********************************************************************************************************
-*                                       FSCache_EntriesFlush()
-*
-* Description : Flush cache entries.
+*                                          FSCache_WrBack()
 *
-* Argument(s) : p_cache_data    Pointer to cache data.
-*               ----------      Argument validated by caller.
+* Description : Advance the dirty age clock of a write back cache & write sectors that have been dirty
+*               for 'age_max' ticks or more.
 *
-*               p_dev           Pointer to device.
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               age_max     Maximum age of dirty sectors, in ticks (i.e., calls to this function).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Aged sectors written.
+*
+*                                                              --- RETURNED BY FSCache_EntriesFlush() ---
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'CACHE DATA TYPE  Note #2'.  A sector written to the cache is written to the
+*                   device by the 'age_max'th call following the write, or earlier if it is evicted or
+*                   the cache is flushed.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSCache_WrBack (FS_VOL      *p_vol,
+                              CPU_INT32U   age_max,
+                              FS_ERR      *p_err)
+{
+    FS_CACHE  *p_cache;
+
+
+    p_cache = (FS_CACHE *)p_vol->CacheDataPtr;
+    if (p_cache == (FS_CACHE *)0) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    if (p_cache->Mode != FS_VOL_CACHE_MODE_WR_BACK) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    p_cache->WrBackTick++;                                      /* See Note #1.                                         */
+    FSCache_EntriesFlush(p_cache, age_max, p_err);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FSCache_RdDirect()
+*
+* Description : Read volume sector(s) around the cache.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_dest      Pointer to destination buffer.
+*               ----------  Argument validated by caller.
+*
+*               start       Start sector of read.
+*
+*               cnt         Number of sectors to read.
+*
+*               sec_type    Type of sector(s) :
+*
+*                               FS_VOL_SEC_TYPE_MGMT    Management sector.
+*                               FS_VOL_SEC_TYPE_DIR     Directory sector.
+*                               FS_VOL_SEC_TYPE_FILE    File sector.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Volume sector(s) read.
+*
+*                                                             ------- RETURNED BY FSDev_RdLocked() ------
+*                               FS_ERR_DEV_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The sectors are read from the device in one request, straight into the destination
+*                   buffer, & are NOT put in the cache, so that a large read neither evicts the working set
+*                   nor costs a copy per sector.
+*
+*               (2) Clean cached sectors match the device.  Dirty sectors, which only a write back cache
+*                   holds, are newer than the device & are copied over the sectors read.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_RdDirect (FS_VOL      *p_vol,
+                                void        *p_dest,
+                                FS_SEC_NBR   start,
+                                FS_SEC_QTY   cnt,
+                                FS_FLAGS     sec_type,
+                                FS_ERR      *p_err)
+{
+    FS_CACHE  *p_cache;
+
+
+    (void)sec_type;
+
+    p_cache = (FS_CACHE *)p_vol->CacheDataPtr;
+
+    FSDev_RdLocked(p_vol->DevPtr,                               /* See Note #1.                                         */
+                   p_dest,
+                   start + p_vol->PartitionStart,
+                   cnt,
+                   p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    if (p_cache == (FS_CACHE *)0) {
+        return;
+    }
+
+    FS_CTR_STAT_ADD(p_cache->StatDirectCtr, cnt);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    if (p_cache->Mode == FS_VOL_CACHE_MODE_WR_BACK) {           /* See Note #2.                                         */
+        FSCache_EntriesDirtyCopy(&p_cache->DataMgmt, p_cache, (CPU_INT08U *)p_dest, start, cnt);
+        FSCache_EntriesDirtyCopy(&p_cache->DataDir,  p_cache, (CPU_INT08U *)p_dest, start, cnt);
+        FSCache_EntriesDirtyCopy(&p_cache->DataData, p_cache, (CPU_INT08U *)p_dest, start, cnt);
+    }
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FSCache_WrDirect()
+*
+* Description : Write volume sector(s) around the cache.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_src       Pointer to source buffer.
+*               ----------  Argument validated by caller.
+*
+*               start       Start sector of write.
+*
+*               cnt         Number of sectors to write.
+*
+*               sec_type    Type of sector(s) :
+*
+*                               FS_VOL_SEC_TYPE_MGMT    Management sector.
+*                               FS_VOL_SEC_TYPE_DIR     Directory sector.
+*                               FS_VOL_SEC_TYPE_FILE    File sector.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Volume sector(s) written.
+*
+*                                                             ------- RETURNED BY FSDev_WrLocked() ------
+*                               FS_ERR_DEV_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The sectors are written to the device in one request, straight from the source buffer.
+*
+*               (2) Cached copies of the sectors are dropped, even if the write fails : a dirty copy is
+*                   superseded by the data written & a clean copy may no longer match the device.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSCache_WrDirect (FS_VOL      *p_vol,
+                                void        *p_src,
+                                FS_SEC_NBR   start,
+                                FS_SEC_QTY   cnt,
+                                FS_FLAGS     sec_type,
+                                FS_ERR      *p_err)
+{
+    FS_CACHE  *p_cache;
+
+
+    (void)sec_type;
+
+    p_cache = (FS_CACHE *)p_vol->CacheDataPtr;
+
+    FSDev_WrLocked(p_vol->DevPtr,                               /* See Note #1.                                         */
+                   p_src,
+                   start + p_vol->PartitionStart,
+                   cnt,
+                   p_err);
+
+    if (p_cache == (FS_CACHE *)0) {
+        return;
+    }
+                                                                /* See Note #2.                                         */
+    FSCache_EntriesRelease(&p_cache->DataMgmt, p_cache, start, cnt);
+    FSCache_EntriesRelease(&p_cache->DataDir,  p_cache, start, cnt);
+    FSCache_EntriesRelease(&p_cache->DataData, p_cache, start, cnt);
+
+    if (*p_err == FS_ERR_NONE) {
+        FS_CTR_STAT_ADD(p_cache->StatDirectCtr, cnt);
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           FSCache_Clean()
+*
+* Description : Write back dirty sectors of a range, so that the device holds the current data of the
+*               range.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               start       Start sector of range.
+*
+*               cnt         Number of sectors in range.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    No dirty sector in range, or sectors written.
+*
+*                                                              --- RETURNED BY FSCache_EntriesFlush() ---
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The range is only scanned; if a sector of the range is dirty, all dirty sectors are
+*                   written, in sector order, so that the device sees the same write sequence as on a flush.
+*                   Sectors remain cached (clean).
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSCache_Clean (FS_VOL      *p_vol,
+                             FS_SEC_NBR   start,
+                             FS_SEC_QTY   cnt,
+                             FS_ERR      *p_err)
+{
+    FS_CACHE    *p_cache;
+    FS_SEC_QTY   ix;
+
+
+   *p_err   = FS_ERR_NONE;
+    p_cache = (FS_CACHE *)p_vol->CacheDataPtr;
+    if (p_cache == (FS_CACHE *)0) {
+        return;
+    }
+
+    if (p_cache->Mode != FS_VOL_CACHE_MODE_WR_BACK) {
+        return;
+    }
+
+    for (ix = 0u; ix < cnt; ix++) {                             /* See Note #1.                                         */
+        if (FSCache_DirtyBufGet(p_cache, start + ix) != (FS_BUF *)0) {
+            FSCache_EntriesFlush(p_cache, 0u, p_err);
+            return;
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           FSCache_Query()
+*
+* Description : Get cache information.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               ----------  Argument validated by caller.
+*
+*               p_info      Pointer to structure that will receive cache information.
+*               ----------  Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE    Cache information obtained.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Hit, miss, eviction, read ahead & direct counters are only maintained if
+*                   FS_CFG_CTR_STAT_EN is enabled; otherwise, they are returned as 0.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_Query (FS_VOL             *p_vol,
+                             FS_VOL_CACHE_INFO  *p_info,
+                             FS_ERR             *p_err)
+{
+    FS_CACHE  *p_cache;
+
+
+    p_cache = (FS_CACHE *)p_vol->CacheDataPtr;
+    if (p_cache == (FS_CACHE *)0) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    p_info->Mode     = p_cache->Mode;
+    p_info->Size     = p_cache->Size;
+    p_info->SizeMgmt = p_cache->DataMgmt.Size;
+    p_info->SizeDir  = p_cache->DataDir.Size;
+    p_info->SizeFile = p_cache->DataData.Size;
+#if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)                         /* See Note #1.                                         */
+    p_info->HitCtr        = p_cache->StatHitCtr;
+    p_info->MissCtr       = p_cache->StatMissCtr;
+    p_info->EvictCtr      = p_cache->StatRemoveCtr;
+    p_info->RdAheadCtr    = p_cache->StatRdAheadCtr;
+    p_info->RdAheadHitCtr = p_cache->StatRdAheadHitCtr;
+    p_info->DirectCtr     = p_cache->StatDirectCtr;
+#endif
+
+   *p_err = FS_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                               FSCache_DataInit()
+*
+* Description : Initialize the data cache structure.
+*
+* Argument(s) : p_vol           Pointer to Volume.
+*               ----------      Argument validated by caller.
+*
+*               p_data_cache    Pointer to cache data to initialize.
+*               ----------      Argument validated by caller.
+*
+*               p_buf_ptrs      Pointer to the start address of cache data buffers
+*               ----------      Argument validated by caller.
+*
+*               p_mem           Pointer to index memory, of 'FSCache_DataMemSizeGet(size)' octets.
+*               ----------      Argument validated by caller.
+*
+*               size            Number of data cache buffer
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_DataInit (FS_VOL          *p_vol,
+                                FS_CACHE_DATA   *p_data_cache,
+                                FS_BUF         **p_buf_ptrs,
+                                void            *p_mem,
+                                FS_SEC_QTY       size)
+{
+    CPU_INT32U   i;
+    FS_SEC_QTY   hash_size;
+    CPU_INT08U  *p_mem_08;
+
+
+    p_data_cache->Size        =  size;
+    p_data_cache->BufUsedPtrs =  p_buf_ptrs;
+    for (i = 0u; i < size; i++) {
+         p_data_cache->BufUsedPtrs[i]->VolPtr = p_vol;
+    }
+
+    if (size == 0u) {
+        return;
+    }
+
+                                                                /* ----------------- CARVE INDEX MEM ------------------ */
+    hash_size                   =  FSCache_HashSizeGet(size);
+    p_mem_08                    = (CPU_INT08U *)p_mem;
+
+    p_data_cache->EntryTbl      = (FS_CACHE_ENTRY *)p_mem_08;
+    p_mem_08                   +=  FS_CACHE_ALIGN(sizeof(FS_CACHE_ENTRY) * size);
+
+    p_data_cache->GhostSize     = (size + 1u) / 2u;
+    p_data_cache->GhostTbl      = (FS_SEC_NBR *)p_mem_08;
+    p_mem_08                   +=  FS_CACHE_ALIGN(sizeof(FS_SEC_NBR) * p_data_cache->GhostSize);
+
+    p_data_cache->HashTbl       = (FS_SEC_QTY *)p_mem_08;
+    p_data_cache->HashMask      =  hash_size - 1u;
+    p_data_cache->HashShift     =  32u;
+    while (hash_size > 1u) {
+        p_data_cache->HashShift--;
+        hash_size >>= 1;
+    }
+
+    p_data_cache->A1inSizeMax   = (size + 3u) / 4u;
+
+    FSCache_DataReset(p_data_cache);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FSCache_DataReset()
+*
+* Description : Free all buffers of data cache & clear its index.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_DataReset (FS_CACHE_DATA  *p_cache_data)
+{
+    FS_SEC_QTY  ix;
+
+
+    p_cache_data->ListFree.Head = FS_CACHE_IX_NONE;
+    p_cache_data->ListFree.Tail = FS_CACHE_IX_NONE;
+    p_cache_data->ListFree.Cnt  = 0u;
+    p_cache_data->ListA1in      = p_cache_data->ListFree;
+    p_cache_data->ListAm        = p_cache_data->ListFree;
+
+    for (ix = 0u; ix < p_cache_data->Size; ix++) {
+        FSCache_BufFree(p_cache_data->BufUsedPtrs[ix]);
+        FSCache_ListInsert(p_cache_data, FS_CACHE_LIST_FREE, ix);
+        p_cache_data->EntryTbl[ix].RdAhead = DEF_NO;
+    }
+    p_cache_data->RdAheadCnt = 0u;
+
+    for (ix = 0u; ix < p_cache_data->GhostSize; ix++) {
+        p_cache_data->GhostTbl[ix] = (FS_SEC_NBR)(-1);
+    }
+    p_cache_data->GhostIx = 0u;
+
+    Mem_Clr((void *)p_cache_data->HashTbl, sizeof(FS_SEC_QTY) * (p_cache_data->HashMask + 1u));
+}
+
+
+/*
+*********************************************************************************************************
+*                                       FSCache_DataMemSizeGet()
+*
+* Description : Get size of index memory needed by a data cache.
+*
+* Argument(s) : size        Number of data cache buffers.
+*
+* Return(s)   : Size of index memory, in octets.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  FSCache_DataMemSizeGet (FS_SEC_QTY  size)
+{
+    CPU_INT32U  mem_size;
+
+
+    if (size == 0u) {
+        return (0u);
+    }
+
+    mem_size = FS_CACHE_ALIGN(sizeof(FS_CACHE_ENTRY) * size)
+             + FS_CACHE_ALIGN(sizeof(FS_SEC_NBR)     * ((size + 1u) / 2u))
+             + FS_CACHE_ALIGN(sizeof(FS_SEC_QTY)     * FSCache_HashSizeGet(size));
+
+    return (mem_size);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FSCache_HashSizeGet()
+*
+* Description : Get number of slots of data cache index.
+*
+* Argument(s) : size        Number of data cache buffers.
+*
+* Return(s)   : Number of slots.
+*
+* Note(s)     : (1) The index holds up to 'size' buffers & '(size + 1) / 2' ghost entries; the number of
+*                   slots is the smallest power of 2 at least twice that.
+*********************************************************************************************************
+*/
+
+static  FS_SEC_QTY  FSCache_HashSizeGet (FS_SEC_QTY  size)
+{
+    FS_SEC_QTY  hash_size;
+    FS_SEC_QTY  entry_cnt;
+
+
+    entry_cnt = size + ((size + 1u) / 2u);                      /* See Note #1.                                         */
+    hash_size = 4u;
+    while (hash_size < entry_cnt * 2u) {
+        hash_size <<= 1;
+    }
+
+    return (hash_size);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          FSCache_BufFree()
+*
+* Description : Free buffer by changing its state to FS_BUF_STATE_NONE.
+*
+* Argument(s) : p_buf       Pointer to buffer.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_BufFree (FS_BUF  *p_buf)
+{
+    p_buf->State = FS_BUF_STATE_NONE;
+    p_buf->Start = (FS_SEC_NBR)(-1);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FSCache_EntriesInvalidate()
+*
+* Description : Invalidate cache.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               p_cache         Pointer to cache.
+*               ----------      Argument validated by caller.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_EntriesInvalidate (FS_CACHE_DATA  *p_cache_data,
+                                         FS_CACHE       *p_cache)
+{
+    (void)p_cache;
+
+    if (p_cache_data->Size == 0u) {
+        return;
+    }
+
+    FSCache_DataReset(p_cache_data);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      FSCache_EntriesRelease()
+*
+* Description : Release cache entries.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               p_cache         Pointer to cache.
+*               ----------      Argument validated by caller.
+*
+*               start           Start sector of release.
+*
+*               cnt             Number of sectors to release.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Small releases look up each sector in the index; releases spanning more sectors than
+*                   there are buffers scan the buffers instead.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_EntriesRelease (FS_CACHE_DATA  *p_cache_data,
+                                      FS_CACHE       *p_cache,
+                                      FS_SEC_NBR      start,
+                                      FS_SEC_QTY      cnt)
+{
+    FS_BUF      *p_buf;
+    FS_SEC_QTY   buf_ix;
+    FS_SEC_QTY   slot_ix;
+    FS_SEC_QTY   val;
+
+
+    (void)p_cache;
+
+    if (p_cache_data->Size == 0u) {
+        return;
+    }
+
+    if (cnt <= p_cache_data->Size) {                            /* See Note #1.                                         */
+        while (cnt > 0u) {
+            slot_ix = FSCache_EntryFind(p_cache_data, start);
+            if (slot_ix != FS_CACHE_IX_NONE) {
+                val = p_cache_data->HashTbl[slot_ix];
+                if (val <= p_cache_data->Size) {                /* Ghost entries are left in place.                     */
+                    FSCache_EntryDrop(p_cache_data, val - 1u, slot_ix);
+                }
+            }
+            start++;
+            cnt--;
+        }
+        return;
+    }
+
+    for (buf_ix = 0u; buf_ix < p_cache_data->Size; buf_ix++) {
+        p_buf = p_cache_data->BufUsedPtrs[buf_ix];
+
+        if ((p_cache_data->EntryTbl[buf_ix].List != FS_CACHE_LIST_FREE) &&
+            (p_buf->Start >= start) &&
+            (p_buf->Start <  start + cnt)) {
+            slot_ix = FSCache_EntryFind(p_cache_data, p_buf->Start);
+            FSCache_EntryDrop(p_cache_data, buf_ix, slot_ix);
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                     FSCache_EntriesDirtyCopy()
+*
+* Description : Copy the dirty cache entries of a range of sectors into a buffer.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               p_cache         Pointer to cache.
+*               ----------      Argument validated by caller.
+*
+*               p_dest          Pointer to buffer holding the sectors of the range.
+*               ----------      Argument validated by caller.
+*
+*               start           Start sector of range.
+*
+*               cnt             Number of sectors in range.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FSCache_EntriesRelease()  Note #1'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSCache_EntriesDirtyCopy (FS_CACHE_DATA  *p_cache_data,
+                                        FS_CACHE       *p_cache,
+                                        CPU_INT08U     *p_dest,
+                                        FS_SEC_NBR      start,
+                                        FS_SEC_QTY      cnt)
+{
+    FS_BUF      *p_buf;
+    FS_SEC_QTY   buf_ix;
+    FS_SEC_QTY   slot_ix;
+    FS_SEC_QTY   val;
+    FS_SEC_QTY   ix;
+
+
+    if (p_cache_data->Size == 0u) {
+        return;
+    }
+
+    if (cnt <= p_cache_data->Size) {                            /* See Note #1.                                         */
+        for (ix = 0u; ix < cnt; ix++) {
+            slot_ix = FSCache_EntryFind(p_cache_data, start + ix);
+            if (slot_ix != FS_CACHE_IX_NONE) {
+                val = p_cache_data->HashTbl[slot_ix];
+                if (val <= p_cache_data->Size) {                /* Not a ghost entry.                                   */
+                    p_buf = p_cache_data->BufUsedPtrs[val - 1u];
+                    if (p_buf->State == FS_BUF_STATE_DIRTY) {
+                        Mem_Copy(p_dest + (ix * p_cache->SecSize), p_buf->DataPtr, p_cache->SecSize);
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    for (buf_ix = 0u; buf_ix < p_cache_data->Size; buf_ix++) {
+        p_buf = p_cache_data->BufUsedPtrs[buf_ix];
+
+        if ((p_cache_data->EntryTbl[buf_ix].List != FS_CACHE_LIST_FREE) &&
+            (p_buf->State == FS_BUF_STATE_DIRTY) &&
+            (p_buf->Start >= start) &&
+            (p_buf->Start <  start + cnt)) {
+            Mem_Copy(p_dest + ((p_buf->Start - start) * p_cache->SecSize), p_buf->DataPtr, p_cache->SecSize);
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FSCache_EntriesFlush()
+*
+* Description : Write dirty cache entries, in ascending sector order, merging consecutive sectors.
+*
+* Argument(s) : p_cache     Pointer to cache.
+*               ----------  Argument validated by caller.
+*
+*               age_min     Minimum age, in write back ticks, of entries to write (0 to write all dirty
+*                           entries).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Entries written.
+*
+*                                                             ----- RETURNED BY FSCache_EntriesWr() -----
+*                               FS_ERR_DEV_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'CACHE DATA TYPE  Note #1'.  Dirty entries of all sector types are sorted
+*                   together, so that a run may span, e.g., FAT & directory sectors.
+*
+*               (2) Written entries stay in the cache : their contents now match the volume.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSCache_EntriesFlush (FS_CACHE    *p_cache,
+                                    CPU_INT32U   age_min,
+                                    FS_ERR      *p_err)
+{
+    FS_BUF     **p_buf_tbl;
+    FS_SEC_QTY   cnt;
+    FS_SEC_QTY   ix;
+    FS_SEC_QTY   run_cnt;
+
+
+   *p_err = FS_ERR_NONE;
+    if (p_cache->Mode != FS_VOL_CACHE_MODE_WR_BACK) {
+        return;
+    }
+
+                                                                /* --------------- COLLECT DIRTY ENTRIES -------------- */
+    cnt = 0u;
+    cnt = FSCache_EntriesCollect(&p_cache->DataMgmt, p_cache, age_min, cnt);
+    cnt = FSCache_EntriesCollect(&p_cache->DataDir,  p_cache, age_min, cnt);
+    cnt = FSCache_EntriesCollect(&p_cache->DataData, p_cache, age_min, cnt);
+    if (cnt == 0u) {
+        return;
+    }
+
+    p_buf_tbl = p_cache->WrTbl;
+    FSCache_EntriesSort(p_buf_tbl, cnt);                        /* See Note #1.                                         */
+
+                                                                /* ------------------ WR SEC RUNS --------------------- */
+    ix = 0u;
+    while (ix < cnt) {
+        run_cnt = 1u;
+        while ((ix + run_cnt < cnt)                        &&
+               (run_cnt      < p_cache->XferSize)          &&
+               (p_buf_tbl[ix + run_cnt]->Start == p_buf_tbl[ix + run_cnt - 1u]->Start + 1u)) {
+            run_cnt++;
+        }
+
+        FSCache_EntriesWr(p_cache, &p_buf_tbl[ix], run_cnt, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+        ix += run_cnt;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      FSCache_EntriesCollect()
+*
+* Description : Add dirty entries of a data cache to the cache's write table.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               p_cache         Pointer to cache.
+*               ----------      Argument validated by caller.
+*
+*               age_min         Minimum age, in write back ticks, of entries to collect.
+*
+*               cnt             Number of entries already in write table.
+*
+* Return(s)   : Number of entries in write table.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  FS_SEC_QTY  FSCache_EntriesCollect (FS_CACHE_DATA  *p_cache_data,
+                                            FS_CACHE       *p_cache,
+                                            CPU_INT32U      age_min,
+                                            FS_SEC_QTY      cnt)
+{
+    FS_BUF      *p_buf;
+    FS_SEC_QTY   buf_ix;
+    CPU_INT32U   age;
+
+
+    for (buf_ix = 0u; buf_ix < p_cache_data->Size; buf_ix++) {
+        p_buf = p_cache_data->BufUsedPtrs[buf_ix];
+        if (p_buf->State == FS_BUF_STATE_DIRTY) {
+            age = p_cache->WrBackTick - p_cache_data->EntryTbl[buf_ix].DirtyTick;
+            if (age >= age_min) {
+                p_cache->WrTbl[cnt] = p_buf;
+                cnt++;
+            }
+        }
+    }
+
+    return (cnt);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FSCache_EntriesSort()
+*
+* Description : Sort buffers by sector number.
+*
+* Argument(s) : p_buf_tbl   Pointer to table of buffers.
+*               ----------  Argument validated by caller.
+*
+*               cnt         Number of buffers in table.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Shell sort (gap sequence 1, 4, 13, 40, ...) : in place & without recursion, which
+*                   suits the small tables sorted here.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSCache_EntriesSort (FS_BUF     **p_buf_tbl,
+                                   FS_SEC_QTY   cnt)
+{
+    FS_BUF      *p_buf;
+    FS_SEC_QTY   gap;
+    FS_SEC_QTY   i;
+    FS_SEC_QTY   j;
+
+
+    gap = 1u;                                                   /* See Note #1.                                         */
+    while (gap < cnt / 3u) {
+        gap = (gap * 3u) + 1u;
+    }
+
+    while (gap > 0u) {
+        for (i = gap; i < cnt; i++) {
+            p_buf = p_buf_tbl[i];
+            j     = i;
+            while ((j >= gap) && (p_buf_tbl[j - gap]->Start > p_buf->Start)) {
+                p_buf_tbl[j] = p_buf_tbl[j - gap];
+                j           -= gap;
+            }
+            p_buf_tbl[j] = p_buf;
+        }
+        gap /= 3u;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FSCache_EntriesGather()
+*
+* Description : Gather in the write table the run of consecutive dirty sectors around a dirty buffer.
+*
+* Argument(s) : p_cache     Pointer to cache.
+*               ----------  Argument validated by caller.
+*
+*               p_buf       Pointer to dirty buffer.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : Number of buffers in run (at least 1).
+*
+* Note(s)     : (1) The run holds at most 'XferSize' sectors, preceding sectors being gathered first.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  FS_SEC_QTY  FSCache_EntriesGather (FS_CACHE  *p_cache,
+                                           FS_BUF    *p_buf)
+{
+    FS_SEC_QTY   cnt_max;
+    FS_SEC_QTY   cnt;
+    FS_SEC_NBR   sec_first;
+    FS_SEC_NBR   sec;
+    FS_BUF      *p_buf_run;
+
+
+    cnt_max = p_cache->XferSize;
+    if (cnt_max == 0u) {
+        cnt_max = 1u;
+    }
+
+    sec_first = p_buf->Start;                                   /* Find first sec of run (see Note #1).                 */
+    while ((sec_first > 0u) &&
+           (p_buf->Start - sec_first + 1u < cnt_max)) {
+        if (FSCache_DirtyBufGet(p_cache, sec_first - 1u) == (FS_BUF *)0) {
+            break;
+        }
+        sec_first--;
+    }
+
+    cnt = 0u;
+    sec = sec_first;
+    while (cnt < cnt_max) {
+        if (sec == p_buf->Start) {
+            p_buf_run = p_buf;
+        } else {
+            p_buf_run = FSCache_DirtyBufGet(p_cache, sec);
+            if (p_buf_run == (FS_BUF *)0) {
+                break;
+            }
+        }
+        p_cache->WrTbl[cnt] = p_buf_run;
+        cnt++;
+        sec++;
+    }
+
+    return (cnt);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FSCache_EntriesWr()
+*
+* Description : Write a run of dirty buffers holding consecutive sectors through the device layer.
+*
+* Argument(s) : p_cache     Pointer to cache.
+*               ----------  Argument validated by caller.
+*
+*               p_buf_tbl   Pointer to table of buffers, in ascending sector order.
+*               ----------  Argument validated by caller.
+*
+*               cnt         Number of buffers in run (1 to 'XferSize').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Buffers written.
+*
+*                                                             ------- RETURNED BY FSDev_WrLocked() ------
+*                               FS_ERR_DEV_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) A single buffer is written in place; a longer run is written from the buffers with a
+*                   single vectored request (see 'CACHE DATA TYPE  Note #1a').
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  void  FSCache_EntriesWr (FS_CACHE     *p_cache,
+                                 FS_BUF      **p_buf_tbl,
+                                 FS_SEC_QTY    cnt,
+                                 FS_ERR       *p_err)
+{
+    FS_VOL      *p_vol;
+    FS_SEC_NBR   sec_start;
+    FS_SEC_QTY   ix;
+
+
+    p_vol     = p_buf_tbl[0]->VolPtr;
+    sec_start = p_buf_tbl[0]->Start + p_vol->PartitionStart;
+    if (cnt == 1u) {                                            /* See Note #1.                                         */
+        FSDev_WrLocked(p_vol->DevPtr,
+                       p_buf_tbl[0]->DataPtr,
+                       sec_start,
+                       1u,
+                       p_err);
+    } else {
+        for (ix = 0u; ix < cnt; ix++) {
+            p_cache->XferVecTbl[ix].BufPtr = p_buf_tbl[ix]->DataPtr;
+            p_cache->XferVecTbl[ix].Cnt    = 1u;
+        }
+        FSDev_WrV_Locked(p_vol->DevPtr,
+                         p_cache->XferVecTbl,
+                         cnt,
+                         sec_start,
+                         p_err);
+    }
+    if (*p_err != FS_ERR_NONE) {
+        return;
+    }
+
+    for (ix = 0u; ix < cnt; ix++) {                             /* Bufs now match vol.                                  */
+        p_buf_tbl[ix]->State = FS_BUF_STATE_USED;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        FSCache_DirtyBufGet()
+*
+* Description : Get dirty buffer holding a sector, whatever its sector type.
+*
+* Argument(s) : p_cache     Pointer to cache.
+*               ----------  Argument validated by caller.
+*
+*               start       Sector number.
+*
+* Return(s)   : Pointer to buffer, if the sector is cached & dirty;
+*               NULL pointer,      otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+static  FS_BUF  *FSCache_DirtyBufGet (FS_CACHE    *p_cache,
+                                      FS_SEC_NBR   start)
+{
+    FS_CACHE_DATA  *p_cache_data;
+    FS_BUF         *p_buf;
+    FS_SEC_QTY      buf_ix;
+
+
+    p_cache_data = FSCache_SecFind( p_cache,
+                                    FS_VOL_SEC_TYPE_MGMT,
+                                    start,
+                                   &buf_ix);
+    if (p_cache_data == (FS_CACHE_DATA *)0) {
+        return ((FS_BUF *)0);
+    }
+
+    p_buf = p_cache_data->BufUsedPtrs[buf_ix];
+    if (p_buf->State != FS_BUF_STATE_DIRTY) {
+        return ((FS_BUF *)0);
+    }
+
+    return (p_buf);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         FSCache_EntryFind()
+*
+* Description : Find entry stored in cache.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               start           Start sector.
+*
+* Return(s)   : Index of the index slot holding the sector's buffer or ghost entry, if found;
+*               FS_CACHE_IX_NONE, otherwise.
+*
+* Note(s)     : (1) See 'CACHE DATA DATA TYPE  Note #2' for slot contents.
+*********************************************************************************************************
+*/
+
+static  FS_SEC_QTY  FSCache_EntryFind (FS_CACHE_DATA  *p_cache_data,
+                                       FS_SEC_NBR      start)
+{
+    FS_SEC_QTY  slot_ix;
+    FS_SEC_QTY  val;
+    FS_SEC_NBR  sec;
+
+
+    if (p_cache_data->Size == 0u) {
+        return (FS_CACHE_IX_NONE);
+    }
+
+    slot_ix = FSCache_HashHome(p_cache_data, start);
+    val     = p_cache_data->HashTbl[slot_ix];
+    while (val != FS_CACHE_HASH_SLOT_EMPTY) {                   /* Probe until empty slot.                              */
+        if (val <= p_cache_data->Size) {                        /* See Note #1.                                         */
+            sec = p_cache_data->BufUsedPtrs[val - 1u]->Start;
+        } else {
+            sec = p_cache_data->GhostTbl[val - p_cache_data->Size - 1u];
+        }
+        if (sec == start) {
+            return (slot_ix);
+        }
+
+        slot_ix = (slot_ix + 1u) & p_cache_data->HashMask;
+        val     =  p_cache_data->HashTbl[slot_ix];
+    }
+
+    return (FS_CACHE_IX_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         FSCache_EntryDrop()
+*
+* Description : Remove buffer from cache & put it on the free list.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               buf_ix          Index of buffer.
+*
+*               slot_ix         Index of index slot referring to buffer.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The buffer's contents are discarded, even if dirty.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_EntryDrop (FS_CACHE_DATA  *p_cache_data,
+                                 FS_SEC_QTY      buf_ix,
+                                 FS_SEC_QTY      slot_ix)
+{
+    FSCache_HashRemove(p_cache_data, slot_ix);
+    FSCache_ListRemove(p_cache_data, buf_ix);
+    FSCache_RdAheadClr(p_cache_data, buf_ix);
+    FSCache_BufFree(p_cache_data->BufUsedPtrs[buf_ix]);
+    FSCache_ListInsert(p_cache_data, FS_CACHE_LIST_FREE, buf_ix);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FSCache_RdAheadClr()
+*
+* Description : Clear read ahead mark of a buffer.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               buf_ix          Index of buffer.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_RdAheadClr (FS_CACHE_DATA  *p_cache_data,
+                                  FS_SEC_QTY      buf_ix)
+{
+    if (p_cache_data->EntryTbl[buf_ix].RdAhead == DEF_YES) {
+        p_cache_data->EntryTbl[buf_ix].RdAhead = DEF_NO;
+        p_cache_data->RdAheadCnt--;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FSCache_BufReclaim()
+*
+* Description : Get a buffer to store a new sector, evicting a sector if no buffer is free.
+*
+* Argument(s) : p_cache         Pointer to cache.
+*               ----------      Argument validated by caller.
+*
+*               p_cache_data    Pointer to cache data.
 *               ----------      Argument validated by caller.
 *
 *               p_err           Pointer to variable that will receive the return error code from this function :
 *               ----------      Argument validated by caller.
 *
-*                                   FS_ERR_NONE                   Cache flushed.
+*                                   FS_ERR_NONE                   Buffer obtained.
 *
-*                                                                 ----- RETURNED BY FSDev_WrLocked() ----
-*                                   FS_ERR_INVALID_SEC_NBR        Sector start or count invalid.
+*                                                                 --- RETURNED BY FSCache_EntriesWr() ---
 *                                   FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
 *                                   FS_ERR_DEV_IO                 Device I/O error.
 *                                   FS_ERR_DEV_TIMEOUT            Device timeout error.
 *                                   FS_ERR_DEV_NOT_PRESENT        Device is not present.
 *
-* Return(s)   : none.
+* Return(s)   : Index of buffer,  if a buffer was obtained;
+*               FS_CACHE_IX_NONE, otherwise.
 *
-* Note(s)     : none.
+* Note(s)     : (1) See 'CACHE DATA DATA TYPE  Note #1b'.
+*
+*               (2) The returned buffer is on no list & in no index slot.
+*
+*               (3) A dirty victim is written together with the dirty buffers holding the sectors around
+*                   it, which then stay in the cache, clean.
+*
+*               (4) A sector read ahead but never accessed is not remembered on the ghost ring : it was
+*                   never referenced, so re-reading it does not indicate reuse.
 *********************************************************************************************************
 */
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-static  void  FSCache_EntriesFlush (FS_VOL         *p_vol,
-                                    FS_CACHE_DATA  *p_cache_data,
-                                    FS_DEV         *p_dev,
-                                    FS_ERR         *p_err)
+static  FS_SEC_QTY  FSCache_BufReclaim (FS_CACHE       *p_cache,
+                                        FS_CACHE_DATA  *p_cache_data,
+                                        FS_ERR         *p_err)
 {
-    FS_SEC_QTY    buf_ix;
-    FS_BUF       *p_buf;
-    FS_BUF      **p_buf_ptr;
-
+    FS_BUF      *p_buf;
+    FS_SEC_QTY   buf_ix;
+    FS_SEC_QTY   slot_ix;
+    CPU_INT08U   list_id;
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    FS_SEC_QTY   cnt;
+#endif
 
-    (void)p_vol;
-    (void)p_dev;
 
-    if (p_cache_data->Size == 0u) {
-        return;
+    if (p_cache_data->ListFree.Cnt > 0u) {                      /* ------------------- USE FREE BUF ------------------- */
+        buf_ix = p_cache_data->ListFree.Head;
+        FSCache_ListRemove(p_cache_data, buf_ix);
+       *p_err  = FS_ERR_NONE;
+        return (buf_ix);
     }
 
-    p_buf_ptr = p_cache_data->BufUsedPtrs;
-    p_cache_data->NextBufToUseIx = 0u;
-    buf_ix    = 0u;
-    while (buf_ix < p_cache_data->Size) {
-        p_buf = *p_buf_ptr;
+                                                                /* ------------------- SEL VICTIM --------------------- */
+    if ((p_cache_data->ListA1in.Cnt > p_cache_data->A1inSizeMax) ||
+        (p_cache_data->ListAm.Cnt  == 0u)) {                    /* See Note #1.                                         */
+        buf_ix = p_cache_data->ListA1in.Tail;
+    } else {
+        buf_ix = p_cache_data->ListAm.Tail;
+    }
+    p_buf   = p_cache_data->BufUsedPtrs[buf_ix];
+    list_id = p_cache_data->EntryTbl[buf_ix].List;
 
-        FSCache_EntryFlush(p_buf, p_err);
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    if (p_buf->State == FS_BUF_STATE_DIRTY) {                   /* Wr dirty victim (see Note #3).                       */
+        cnt = FSCache_EntriesGather(p_cache, p_buf);
+        FSCache_EntriesWr(p_cache, p_cache->WrTbl, cnt, p_err);
         if (*p_err != FS_ERR_NONE) {
-            return;
+            return (FS_CACHE_IX_NONE);
         }
+    }
+#endif
 
-        buf_ix++;
-        p_buf_ptr++;
+                                                                /* ------------------- EVICT VICTIM ------------------- */
+    slot_ix = FSCache_EntryFind(p_cache_data, p_buf->Start);
+    if (slot_ix != FS_CACHE_IX_NONE) {
+        FSCache_HashRemove(p_cache_data, slot_ix);
+    }
+    FSCache_ListRemove(p_cache_data, buf_ix);
+    if ((list_id == FS_CACHE_LIST_A1IN) &&                      /* Remember sec evicted from A1in (see Note #4).        */
+        (p_cache_data->EntryTbl[buf_ix].RdAhead == DEF_NO)) {
+        FSCache_GhostAdd(p_cache_data, p_buf->Start);
     }
+    FSCache_RdAheadClr(p_cache_data, buf_ix);
+    FSCache_BufFree(p_buf);
+    FS_CTR_STAT_INC(p_cache->StatRemoveCtr);
 
    *p_err = FS_ERR_NONE;
+    return (buf_ix);
 }
-#endif
-
-
 
 
 /*
 *********************************************************************************************************
-*                                      FSCache_EntriesRelease()
+*                                         FSCache_GhostAdd()
 *
-* Description : Flush cache entries.
+* Description : Add sector to ghost ring, overwriting the oldest ghost entry.
 *
 * Argument(s) : p_cache_data    Pointer to cache data.
 *               ----------      Argument validated by caller.
 *
-*               p_cache         Pointer to cache.
-*               ----------      Argument validated by caller.
+*               sec             Sector number.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) Ghost entries consumed by a hit are set to an invalid sector number & have no index
+*                   slot.
 *********************************************************************************************************
 */
 
-static  void  FSCache_EntriesRelease (FS_CACHE_DATA  *p_cache_data,
-                                      FS_CACHE       *p_cache,
-                                      FS_SEC_NBR      start,
-                                      FS_SEC_QTY      cnt)
+static  void  FSCache_GhostAdd (FS_CACHE_DATA  *p_cache_data,
+                                FS_SEC_NBR      sec)
 {
-    FS_BUF       *p_buf;
-    FS_BUF      **p_buf_ptr;
-    FS_SEC_QTY    buf_ix;
+    FS_SEC_QTY  ghost_ix;
+    FS_SEC_QTY  slot_ix;
 
 
-    (void)p_cache;
+    ghost_ix = p_cache_data->GhostIx;
+    if (p_cache_data->GhostTbl[ghost_ix] != (FS_SEC_NBR)(-1)) { /* Remove oldest entry from index (see Note #1).        */
+        slot_ix = FSCache_EntryFind(p_cache_data, p_cache_data->GhostTbl[ghost_ix]);
+        if (slot_ix != FS_CACHE_IX_NONE) {
+            FSCache_HashRemove(p_cache_data, slot_ix);
+        }
+    }
 
-    if (p_cache_data->Size == 0u) {
-        return;
+    p_cache_data->GhostTbl[ghost_ix] = sec;
+    FSCache_HashAdd(p_cache_data, sec, p_cache_data->Size + ghost_ix + 1u);
+
+    ghost_ix++;
+    if (ghost_ix >= p_cache_data->GhostSize) {
+        ghost_ix = 0u;
     }
+    p_cache_data->GhostIx = ghost_ix;
+}
+
 
-    p_buf_ptr = p_cache_data->BufUsedPtrs;
-    buf_ix    = 0u;
+/*
+*********************************************************************************************************
+*                                         FSCache_HashHome()
+*
+* Description : Get home slot of sector in data cache index.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               sec             Sector number.
+*
+* Return(s)   : Index of home slot.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
 
-    while (buf_ix < p_cache_data->Size) {
-        p_buf = *p_buf_ptr;
+static  FS_SEC_QTY  FSCache_HashHome (FS_CACHE_DATA  *p_cache_data,
+                                      FS_SEC_NBR      sec)
+{
+    CPU_INT32U  hash;
 
-        if ((p_buf->Start >= start) &&
-            (p_buf->Start < start + cnt)) {
-            FSCache_BufFree(p_buf);
-        }
 
-        buf_ix++;
-        p_buf_ptr++;
-    }
+    hash = (CPU_INT32U)sec * FS_CACHE_HASH_MULT;
+    hash = hash >> p_cache_data->HashShift;
 
+    return ((FS_SEC_QTY)hash & p_cache_data->HashMask);
 }
 
 
 /*
 *********************************************************************************************************
-*                                         FSCache_UpdateIndex()
+*                                          FSCache_HashAdd()
 *
-* Description : Get the next cache buffer index where data will be stored in the cache.
+* Description : Add entry to data cache index.
 *
 * Argument(s) : p_cache_data    Pointer to cache data.
 *               ----------      Argument validated by caller.
 *
+*               sec             Sector number.
+*
+*               val             Slot value (see 'CACHE DATA DATA TYPE  Note #2').
+*
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) The sector MUST NOT already be in the index.  The index always has free slots.
 *********************************************************************************************************
 */
 
-static  void  FSCache_UpdateIndex (FS_CACHE_DATA  *p_cache_data)
+static  void  FSCache_HashAdd (FS_CACHE_DATA  *p_cache_data,
+                               FS_SEC_NBR      sec,
+                               FS_SEC_QTY      val)
 {
-    p_cache_data->NextBufToUseIx++;
-    if (p_cache_data->NextBufToUseIx >= p_cache_data->Size) {
-        p_cache_data->NextBufToUseIx = 0u;
+    FS_SEC_QTY  slot_ix;
+
+
+    slot_ix = FSCache_HashHome(p_cache_data, sec);
+    while (p_cache_data->HashTbl[slot_ix] != FS_CACHE_HASH_SLOT_EMPTY) {
+        slot_ix = (slot_ix + 1u) & p_cache_data->HashMask;
     }
+    p_cache_data->HashTbl[slot_ix] = val;
 }
 
 
 /*
 *********************************************************************************************************
-*                                          FSCache_EntryFlush()
+*                                        FSCache_HashRemove()
 *
-* Description : Flush cache buffer through device layer.
+* Description : Remove entry from data cache index.
 *
-* Argument(s) : p_buf       Pointer to a buffer. Must be a cache buffer.
-*               ----------  Argument validated by caller.
-*
-*               p_err       Pointer to variable that will receive the return error code from this function :
-*               ----------  Argument validated by caller.
-*
-*                               FS_ERR_NONE                   Buffer flushed.
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
 *
-*                                                             ------ RETURNED BY FSVol_WrLockedEx() -----
-*                                                             ------ RETURNED BY FSVol_RdLockedEx() -----
-*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
-*                               FS_ERR_DEV_IO                 Device I/O error.
-*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
-*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*               slot_ix         Index of slot to empty.
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) Entries following the emptied slot in the same probe run are shifted back so that
+*                   no tombstones are needed : an entry is moved into the hole unless its home slot lies
+*                   cyclically between the hole (exclusive) & its current slot (inclusive).
 *********************************************************************************************************
 */
 
-static  void  FSCache_EntryFlush(FS_BUF  *p_buf,
-                                 FS_ERR  *p_err)
+static  void  FSCache_HashRemove (FS_CACHE_DATA  *p_cache_data,
+                                  FS_SEC_QTY      slot_ix)
 {
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-    FS_SEC_QTY  sec_start;
-#endif
+    FS_SEC_QTY   hole_ix;
+    FS_SEC_QTY   home_ix;
+    FS_SEC_QTY   val;
+    FS_SEC_NBR   sec;
+    CPU_BOOLEAN  keep;
+
+
+    hole_ix = slot_ix;
+    slot_ix = (slot_ix + 1u) & p_cache_data->HashMask;
+    val     =  p_cache_data->HashTbl[slot_ix];
+    while (val != FS_CACHE_HASH_SLOT_EMPTY) {                   /* See Note #1.                                         */
+        if (val <= p_cache_data->Size) {
+            sec = p_cache_data->BufUsedPtrs[val - 1u]->Start;
+        } else {
+            sec = p_cache_data->GhostTbl[val - p_cache_data->Size - 1u];
+        }
+        home_ix = FSCache_HashHome(p_cache_data, sec);
 
+        if (hole_ix <= slot_ix) {
+            keep = ((home_ix > hole_ix) && (home_ix <= slot_ix)) ? DEF_YES : DEF_NO;
+        } else {
+            keep = ((home_ix > hole_ix) || (home_ix <= slot_ix)) ? DEF_YES : DEF_NO;
+        }
 
-#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
-    if (p_buf->State == FS_BUF_STATE_DIRTY) {                   /* ---------------- FLUSH BUF CONTENTS ---------------- */
-        sec_start = p_buf->Start + p_buf->VolPtr->PartitionStart;
-        FSDev_WrLocked(p_buf->VolPtr->DevPtr,                   /* Wr sec.                                              */
-                       p_buf->DataPtr,
-                       sec_start,
-                       1u,
-                       p_err);
-        if (*p_err != FS_ERR_NONE) {
-            return;
+        if (keep == DEF_NO) {
+            p_cache_data->HashTbl[hole_ix] = val;
+            hole_ix = slot_ix;
         }
-    }
-#endif
 
-    p_buf->State = FS_BUF_STATE_NONE;                           /* Update buf state.                                    */
+        slot_ix = (slot_ix + 1u) & p_cache_data->HashMask;
+        val     =  p_cache_data->HashTbl[slot_ix];
+    }
 
-   *p_err = FS_ERR_NONE;
+    p_cache_data->HashTbl[hole_ix] = FS_CACHE_HASH_SLOT_EMPTY;
 }
 
+
 /*
 *********************************************************************************************************
-*                                         FSCache_EntryFind()
+*                                          FSCache_ListGet()
 *
-* Description : Find entry stored in cache.
+* Description : Get replacement list of data cache.
 *
 * Argument(s) : p_cache_data    Pointer to cache data.
 *               ----------      Argument validated by caller.
 *
-*               start           Start sector.
+*               list_id         List identifier :
 *
-* Return(s)   : pointer to buffer adresses
-*               NULL pointer if not found
+*                                   FS_CACHE_LIST_FREE    Free list.
+*                                   FS_CACHE_LIST_A1IN    A1in FIFO.
+*                                   FS_CACHE_LIST_AM      Am   LRU.
+*
+* Return(s)   : Pointer to list.
 *
 * Note(s)     : none.
 *********************************************************************************************************
 */
 
-static  FS_BUF  **FSCache_EntryFind (FS_CACHE_DATA  *p_cache_data,
-                                     FS_SEC_NBR      start)
+static  FS_CACHE_LIST  *FSCache_ListGet (FS_CACHE_DATA  *p_cache_data,
+                                         CPU_INT08U      list_id)
 {
-    FS_BUF       *p_buf;
-    FS_BUF      **p_buf_ptr;
-    FS_SEC_QTY    buf_ix;
+    FS_CACHE_LIST  *p_list;
 
 
-    if (p_cache_data->Size == 0u) {
-        return ((FS_BUF **)0);
+    switch (list_id) {
+        case FS_CACHE_LIST_A1IN:
+             p_list = &p_cache_data->ListA1in;
+             break;
+
+        case FS_CACHE_LIST_AM:
+             p_list = &p_cache_data->ListAm;
+             break;
+
+        case FS_CACHE_LIST_FREE:
+        default:
+             p_list = &p_cache_data->ListFree;
+             break;
     }
 
-    p_buf_ptr = p_cache_data->BufUsedPtrs;
-    buf_ix    = 0u;
+    return (p_list);
+}
 
-    while (buf_ix < p_cache_data->Size) {
-        p_buf = *p_buf_ptr;
 
-        if (p_buf->Start == start) {
-            p_buf_ptr = &p_cache_data->BufUsedPtrs[buf_ix];
-            return (p_buf_ptr);
-        }
+/*
+*********************************************************************************************************
+*                                        FSCache_ListInsert()
+*
+* Description : Insert buffer at head of replacement list.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               list_id         List identifier (see 'FSCache_ListGet()').
+*
+*               buf_ix          Index of buffer.  Buffer MUST NOT be on any list.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_ListInsert (FS_CACHE_DATA  *p_cache_data,
+                                  CPU_INT08U      list_id,
+                                  FS_SEC_QTY      buf_ix)
+{
+    FS_CACHE_LIST   *p_list;
+    FS_CACHE_ENTRY  *p_entry;
+
 
-        buf_ix++;
-        p_buf_ptr++;
+    p_list         = FSCache_ListGet(p_cache_data, list_id);
+    p_entry        = &p_cache_data->EntryTbl[buf_ix];
+
+    p_entry->List  = list_id;
+    p_entry->Prev  = FS_CACHE_IX_NONE;
+    p_entry->Next  = p_list->Head;
+    if (p_list->Head != FS_CACHE_IX_NONE) {
+        p_cache_data->EntryTbl[p_list->Head].Prev = buf_ix;
+    } else {
+        p_list->Tail = buf_ix;
     }
+    p_list->Head   = buf_ix;
+    p_list->Cnt++;
+}
+
 
-    return ((FS_BUF **)0);
+/*
+*********************************************************************************************************
+*                                        FSCache_ListRemove()
+*
+* Description : Remove buffer from its replacement list.
+*
+* Argument(s) : p_cache_data    Pointer to cache data.
+*               ----------      Argument validated by caller.
+*
+*               buf_ix          Index of buffer.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_ListRemove (FS_CACHE_DATA  *p_cache_data,
+                                  FS_SEC_QTY      buf_ix)
+{
+    FS_CACHE_LIST   *p_list;
+    FS_CACHE_ENTRY  *p_entry;
+
+
+    p_entry = &p_cache_data->EntryTbl[buf_ix];
+    p_list  =  FSCache_ListGet(p_cache_data, p_entry->List);
+
+    if (p_entry->Prev != FS_CACHE_IX_NONE) {
+        p_cache_data->EntryTbl[p_entry->Prev].Next = p_entry->Next;
+    } else {
+        p_list->Head = p_entry->Next;
+    }
+    if (p_entry->Next != FS_CACHE_IX_NONE) {
+        p_cache_data->EntryTbl[p_entry->Next].Prev = p_entry->Prev;
+    } else {
+        p_list->Tail = p_entry->Prev;
+    }
+    p_entry->Prev = FS_CACHE_IX_NONE;
+    p_entry->Next = FS_CACHE_IX_NONE;
+    p_list->Cnt--;
 }
 
 
@@ -1368,17 +3009,15 @@ static  void  FSCache_ObjClr (FS_CACHE  *p_cache)
     p_cache->SecSize                  =  0u;
     p_cache->Size                     =  0u;
 
-    p_cache->DataMgmt.Size            =  0u;
-    p_cache->DataMgmt.NextBufToUseIx  =  0u;
-    p_cache->DataMgmt.BufUsedPtrs     = (FS_BUF **)0;
+    p_cache->WrTbl                    = (FS_BUF       **)0;
+    p_cache->XferVecTbl               = (FS_DEV_IO_VEC *)0;
+    p_cache->XferIxTbl                = (FS_SEC_QTY    *)0;
+    p_cache->XferSize                 =  0u;
+    p_cache->WrBackTick               =  0u;
 
-    p_cache->DataDir.Size             =  0u;
-    p_cache->DataDir.NextBufToUseIx   =  0u;
-    p_cache->DataDir.BufUsedPtrs      = (FS_BUF **)0;
-
-    p_cache->DataData.Size            =  0u;
-    p_cache->DataData.NextBufToUseIx  =  0u;
-    p_cache->DataData.BufUsedPtrs     = (FS_BUF **)0;
+    Mem_Clr((void *)&p_cache->DataMgmt, sizeof(FS_CACHE_DATA));
+    Mem_Clr((void *)&p_cache->DataDir,  sizeof(FS_CACHE_DATA));
+    Mem_Clr((void *)&p_cache->DataData, sizeof(FS_CACHE_DATA));
 
 #if (FS_CFG_CTR_STAT_EN == DEF_ENABLED)
     p_cache->StatHitCtr               =  0u;
@@ -1388,6 +3027,9 @@ static  void  FSCache_ObjClr (FS_CACHE  *p_cache)
     p_cache->StatUpdateCtr            =  0u;
     p_cache->StatRdCtr                =  0u;
     p_cache->StatRdAvoidCtr           =  0u;
+    p_cache->StatRdAheadCtr           =  0u;
+    p_cache->StatRdAheadHitCtr        =  0u;
+    p_cache->StatDirectCtr            =  0u;
 #if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
     p_cache->StatWrCtr                =  0u;
     p_cache->StatWrAvoidCtr           =  0u;
@@ -1419,7 +3061,12 @@ static  void  FSCache_ObjClr (FS_CACHE  *p_cache)
 * Return(s)   : DEF_NO  if the sector is NOT found in cache.
 *               DEF_YES if the sector is     found in cache.
 *
-* Note(s)     : none.
+* Note(s)     : (1) A hit on Am moves the buffer to the head of Am; a hit on A1in does not move the
+*                   buffer (see 'CACHE DATA DATA TYPE  Note #1a').
+*
+*               (2) The same sector may be accessed with different types, e.g. when a cluster freed as
+*                   file data is re-allocated to a directory.  A sector not cached for its own type is
+*                   looked up in the caches of the other types.
 *********************************************************************************************************
 */
 
@@ -1429,31 +3076,31 @@ static  CPU_BOOLEAN  FSCache_SecGet (FS_CACHE    *p_cache,
                                      FS_FLAGS     sec_type)
 {
     FS_BUF          *p_buf;
-    FS_BUF         **p_buf_ptr;
     FS_CACHE_DATA   *p_cache_data;
+    FS_SEC_QTY       buf_ix;
 
 
                                                                 /* ---------------- FIND ENTRY IN CACHE --------------- */
-    p_cache_data = FSCache_GetData(p_cache, sec_type);
+    p_cache_data = FSCache_SecFind( p_cache,                    /* See Note #2.                                         */
+                                    sec_type,
+                                    start,
+                                   &buf_ix);
     if (p_cache_data == (FS_CACHE_DATA *)0) {
-        p_buf_ptr = (FS_BUF **)0;
-    } else {
-        p_buf_ptr = FSCache_EntryFind(p_cache_data, start);
-    }
-
-
-    if (p_buf_ptr == (FS_BUF **)0) {
         FS_CTR_STAT_INC(p_cache->StatMissCtr);
         return (DEF_NO);
     }
 
-    p_buf = *p_buf_ptr;
+    if (p_cache_data->EntryTbl[buf_ix].List == FS_CACHE_LIST_AM) {
+        FSCache_ListRemove(p_cache_data, buf_ix);               /* See Note #1.                                         */
+        FSCache_ListInsert(p_cache_data, FS_CACHE_LIST_AM, buf_ix);
+    }
 
-    if (p_buf->State == FS_BUF_STATE_NONE) {
-        FS_CTR_STAT_INC(p_cache->StatMissCtr);
-        return (DEF_NO);
+    if (p_cache_data->EntryTbl[buf_ix].RdAhead == DEF_YES) {    /* See 'FSCache_RdAhead()  Note #3'.                    */
+        FSCache_RdAheadClr(p_cache_data, buf_ix);
+        FS_CTR_STAT_INC(p_cache->StatRdAheadHitCtr);
     }
 
+    p_buf = p_cache_data->BufUsedPtrs[buf_ix];
     FS_CTR_STAT_INC(p_cache->StatHitCtr);
     Mem_Copy(p_dest, p_buf->DataPtr, p_cache->SecSize);
 
@@ -1490,7 +3137,12 @@ static  CPU_BOOLEAN  FSCache_SecGet (FS_CACHE    *p_cache,
 * Return(s)   : DEF_YES if the volume does     need to be updated.
 *               DEF_NO  if the volume does NOT need to be updated.
 *
-* Note(s)     : none.
+* Note(s)     : (1) A sector not in cache is placed on A1in, unless it is found on the ghost ring, in
+*                   which case it is placed on Am (see 'CACHE DATA DATA TYPE  Note #1').
+*
+*               (2) A written sector is discarded from the caches of the other sector types (see
+*                   'FSCache_SecGet()  Note #2'), which would otherwise return, or write back, stale
+*                   contents.
 *********************************************************************************************************
 */
 
@@ -1502,8 +3154,10 @@ static  CPU_BOOLEAN  FSCache_SecPut (FS_CACHE     *p_cache,
 {
     CPU_BOOLEAN      update;
     FS_BUF          *p_buf;
-    FS_BUF         **p_buf_ptr;
     FS_CACHE_DATA   *p_cache_data;
+    FS_SEC_QTY       slot_ix;
+    FS_SEC_QTY       buf_ix;
+    CPU_INT08U       list_id;
     FS_ERR           err;
 
 
@@ -1512,6 +3166,9 @@ static  CPU_BOOLEAN  FSCache_SecPut (FS_CACHE     *p_cache,
 
                                                                 /* ---------------- FIND ENTRY IN CACHE --------------- */
     p_cache_data = FSCache_GetData(p_cache, sec_type);
+    if (rd == DEF_NO) {                                         /* See Note #2.                                         */
+        FSCache_SecDiscard(p_cache, p_cache_data, start);
+    }
     if (p_cache_data == (FS_CACHE_DATA *)0) {
         return (update);
     }
@@ -1520,25 +3177,41 @@ static  CPU_BOOLEAN  FSCache_SecPut (FS_CACHE     *p_cache,
         return (update);
     }
 
-    p_buf_ptr = FSCache_EntryFind(p_cache_data, start);
+    slot_ix = FSCache_EntryFind(p_cache_data, start);
+    buf_ix  = FS_CACHE_IX_NONE;
+    list_id = FS_CACHE_LIST_A1IN;
+    if (slot_ix != FS_CACHE_IX_NONE) {
+        buf_ix = p_cache_data->HashTbl[slot_ix];
+        if (buf_ix <= p_cache_data->Size) {                     /* Sec in cache.                                        */
+            buf_ix--;
+        } else {                                                /* Sec on ghost ring (see Note #1) ...                  */
+            p_cache_data->GhostTbl[buf_ix - p_cache_data->Size - 1u] = (FS_SEC_NBR)(-1);
+            FSCache_HashRemove(p_cache_data, slot_ix);          /*                   ... consume ghost entry.           */
+            buf_ix  = FS_CACHE_IX_NONE;
+            list_id = FS_CACHE_LIST_AM;
+        }
+    }
 
 
                                                                 /* ------------------- ALLOC NEW BUF ------------------ */
-    if (p_buf_ptr == (FS_BUF **)0) {
-        p_buf = p_cache_data->BufUsedPtrs[p_cache_data->NextBufToUseIx];
-        FS_CTR_STAT_INC(p_cache->StatRemoveCtr);
-        if (p_cache->Mode == FS_VOL_CACHE_MODE_WR_BACK) {
-            FSCache_EntryFlush(p_buf, &err);
-            if (err != FS_ERR_NONE) {
-                return (update);
-            }
+    if (buf_ix == FS_CACHE_IX_NONE) {
+        buf_ix = FSCache_BufReclaim(p_cache, p_cache_data, &err);
+        if (buf_ix == FS_CACHE_IX_NONE) {
+            return (update);
         }
+        p_buf        = p_cache_data->BufUsedPtrs[buf_ix];
         p_buf->Start = start;
         p_buf->State = FS_BUF_STATE_USED;
-        FSCache_UpdateIndex(p_cache_data);                      /* Update the cache entry index.                        */
+        FSCache_HashAdd(p_cache_data, start, buf_ix + 1u);
+        FSCache_ListInsert(p_cache_data, list_id, buf_ix);
+        FS_CTR_STAT_INC(p_cache->StatAllocCtr);
 
-    } else{
-        p_buf = *p_buf_ptr;
+    } else {
+        p_buf = p_cache_data->BufUsedPtrs[buf_ix];
+        if (p_cache_data->EntryTbl[buf_ix].List == FS_CACHE_LIST_AM) {
+            FSCache_ListRemove(p_cache_data, buf_ix);
+            FSCache_ListInsert(p_cache_data, FS_CACHE_LIST_AM, buf_ix);
+        }
         FS_CTR_STAT_INC(p_cache->StatUpdateCtr);
     }
 
@@ -1549,6 +3222,9 @@ static  CPU_BOOLEAN  FSCache_SecPut (FS_CACHE     *p_cache,
 
     if (rd == DEF_NO) {
         if (p_cache->Mode == FS_VOL_CACHE_MODE_WR_BACK) {       /* Mark cache buf as dirty.                             */
+            if (p_buf->State != FS_BUF_STATE_DIRTY) {
+                p_cache_data->EntryTbl[buf_ix].DirtyTick = p_cache->WrBackTick;
+            }
             p_buf->State = FS_BUF_STATE_DIRTY;
             update = DEF_NO;
         }
@@ -1558,6 +3234,105 @@ static  CPU_BOOLEAN  FSCache_SecPut (FS_CACHE     *p_cache,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSCache_SecFind()
+*
+* Description : Find buffer holding a sector, in the cache of its own type first, then in the caches of
+*               the other types.
+*
+* Argument(s) : p_cache     Pointer to cache.
+*               ----------  Argument validated by caller.
+*
+*               sec_type    Type of sector :
+*
+*                               FS_VOL_SEC_TYPE_MGMT    Management sector.
+*                               FS_VOL_SEC_TYPE_DIR     Directory sector.
+*                               FS_VOL_SEC_TYPE_FILE    File sector.
+*
+*               start       Sector number.
+*
+*               p_buf_ix    Pointer to variable that will receive the index of the buffer, if found.
+*               ----------  Argument validated by caller.
+*
+* Return(s)   : Pointer to cache data holding the sector, if found;
+*               NULL pointer, otherwise.
+*
+* Note(s)     : (1) See 'FSCache_SecGet()  Note #2'.
+*********************************************************************************************************
+*/
+
+static  FS_CACHE_DATA  *FSCache_SecFind (FS_CACHE    *p_cache,
+                                         FS_FLAGS     sec_type,
+                                         FS_SEC_NBR   start,
+                                         FS_SEC_QTY  *p_buf_ix)
+{
+    FS_CACHE_DATA  *p_cache_data_tbl[4];
+    FS_CACHE_DATA  *p_cache_data;
+    FS_SEC_QTY      slot_ix;
+    CPU_INT08U      ix;
+
+
+    p_cache_data_tbl[0] =  FSCache_GetData(p_cache, sec_type);  /* Own type first.                                      */
+    p_cache_data_tbl[1] = &p_cache->DataMgmt;
+    p_cache_data_tbl[2] = &p_cache->DataDir;
+    p_cache_data_tbl[3] = &p_cache->DataData;
+
+    for (ix = 0u; ix < 4u; ix++) {
+        p_cache_data = p_cache_data_tbl[ix];
+        if ((p_cache_data == (FS_CACHE_DATA *)0) ||
+            ((ix > 0u) && (p_cache_data == p_cache_data_tbl[0]))) {
+            continue;
+        }
+
+        slot_ix = FSCache_EntryFind(p_cache_data, start);
+        if (slot_ix != FS_CACHE_IX_NONE) {
+            if (p_cache_data->HashTbl[slot_ix] <= p_cache_data->Size) {     /* Not a ghost entry.                       */
+               *p_buf_ix = p_cache_data->HashTbl[slot_ix] - 1u;
+                return (p_cache_data);
+            }
+        }
+    }
+
+    return ((FS_CACHE_DATA *)0);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        FSCache_SecDiscard()
+*
+* Description : Discard a sector from the caches of all types but one.
+*
+* Argument(s) : p_cache         Pointer to cache.
+*               ----------      Argument validated by caller.
+*
+*               p_cache_data    Pointer to cache data to leave untouched (may be NULL).
+*
+*               start           Sector number.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) See 'FSCache_SecPut()  Note #2'.
+*********************************************************************************************************
+*/
+
+static  void  FSCache_SecDiscard (FS_CACHE       *p_cache,
+                                  FS_CACHE_DATA  *p_cache_data,
+                                  FS_SEC_NBR      start)
+{
+    if (p_cache_data != &p_cache->DataMgmt) {
+        FSCache_EntriesRelease(&p_cache->DataMgmt, p_cache, start, 1u);
+    }
+    if (p_cache_data != &p_cache->DataDir) {
+        FSCache_EntriesRelease(&p_cache->DataDir,  p_cache, start, 1u);
+    }
+    if (p_cache_data != &p_cache->DataData) {
+        FSCache_EntriesRelease(&p_cache->DataData, p_cache, start, 1u);
+    }
+}
+
+
 /*
 *********************************************************************************************************
 *                                           FSCache_GetData()
@@ -78,9 +78,18 @@
 /*
 *********************************************************************************************************
 *                                               DEFINES
+*
+* Note(s) : (1) FS_CACHE_CFG_XFER_SEC_MAX is the maximum number of sectors transferred by a single device
+*               request issued by the cache (merged writes of a write back cache, read ahead).  It may
+*               be #define'd in 'fs_cfg.h'; the cache's transfer tables take that many entries of the
+*               cache memory.
 *********************************************************************************************************
 */
 
+#ifndef  FS_CACHE_CFG_XFER_SEC_MAX                              /* See Note #1.                                         */
+#define  FS_CACHE_CFG_XFER_SEC_MAX                        8u
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -133,6 +142,43 @@ struct  fs_vol_cache_api {
 
     void  (*Flush)     (FS_VOL       *p_vol,                    /* Flush cache.                                         */
                         FS_ERR       *p_err);
+
+    void  (*Query)     (FS_VOL             *p_vol,              /* Get cache info (optional, may be NULL).              */
+                        FS_VOL_CACHE_INFO  *p_info,
+                        FS_ERR             *p_err);
+
+    FS_SEC_QTY  (*RdAhead)(FS_VOL    *p_vol,                    /* Rd secs ahead into cache (optional, may be NULL).    */
+                           FS_SEC_NBR  start,
+                           FS_SEC_QTY  cnt,
+                           FS_FLAGS    sec_type,
+                           FS_ERR     *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    void  (*WrBack)    (FS_VOL       *p_vol,                    /* Wr back aged dirty secs (optional, may be NULL).     */
+                        CPU_INT32U    age_max,
+                        FS_ERR       *p_err);
+#endif
+
+    void  (*RdDirect)  (FS_VOL       *p_vol,                    /* Rd secs around cache (optional, may be NULL).        */
+                        void         *p_dest,
+                        FS_SEC_NBR    start,
+                        FS_SEC_QTY    cnt,
+                        FS_FLAGS      sec_type,
+                        FS_ERR       *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    void  (*WrDirect)  (FS_VOL       *p_vol,                    /* Wr secs around cache (optional, may be NULL).        */
+                        void         *p_src,
+                        FS_SEC_NBR    start,
+                        FS_SEC_QTY    cnt,
+                        FS_FLAGS      sec_type,
+                        FS_ERR       *p_err);
+
+    void  (*Clean)     (FS_VOL       *p_vol,                    /* Wr back dirty secs in range (optional, may be NULL). */
+                        FS_SEC_NBR    start,
+                        FS_SEC_QTY    cnt,
+                        FS_ERR       *p_err);
+#endif
 };
 
 
@@ -165,6 +211,11 @@ extern  const  FS_VOL_CACHE_API  FSCache_Dflt;
 *********************************************************************************************************
 */
 
+#if     (FS_CACHE_CFG_XFER_SEC_MAX < 1u)
+#error  "FS_CACHE_CFG_XFER_SEC_MAX              illegally #define'd in 'fs_cfg.h'               "
+#error  "                                       [MUST be  >= 1]                                 "
+#endif
+
 
 /*
 *********************************************************************************************************
@@ -2300,6 +2300,107 @@ void  FSDev_Unlock (FS_DEV  *p_dev)
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSDev_MapLocked()
+*
+* Description : Get address of device sector(s) in addressable memory.
+*
+* Argument(s) : p_dev       Pointer to device.
+*               ----------  Argument validated by caller.
+*
+*               start       Start sector.
+*
+*               cnt         Number of sectors to map.
+*
+*               p_map_cnt   Pointer to variable that will receive the number of sectors stored contiguously
+*               ----------  from the returned address (see Note #2).
+*                           Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Device sector(s) mapped, or none mappable.
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_IO_CTRL     Device sectors cannot be mapped.
+*
+*                                                              ---- RETURNED BY DEV DRV's IO_Ctrl() -----
+*                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*
+* Return(s)   : Pointer to sector 'start', if the sector is mapped.
+*               NULL pointer,              otherwise.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the device & hold the device lock.
+*
+*               (2) See 'fs_dev.h  DEVICE SECTOR MAP DATA TYPE'.  '*p_map_cnt' is 0 if NULL is returned.
+*
+*               (3) Device state change will result from device I/O, not present or timeout error.
+*********************************************************************************************************
+*/
+
+void  *FSDev_MapLocked (FS_DEV      *p_dev,
+                        FS_SEC_NBR   start,
+                        FS_SEC_QTY   cnt,
+                        FS_SEC_QTY  *p_map_cnt,
+                        FS_ERR      *p_err)
+{
+    FS_DEV_SEC_MAP  sec_map;
+    FS_SEC_QTY      size;
+
+
+   *p_map_cnt = 0u;
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+    size = p_dev->Size;
+
+    if (cnt == 0u) {
+       *p_err = FS_ERR_NONE;
+        return ((void *)0);
+    }
+
+    if (start > size) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_NBR;
+        return ((void *)0);
+    }
+
+    if (start + cnt > size) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_NBR;
+        return ((void *)0);
+    }
+
+
+
+                                                                /* --------------------- MAP SECs --------------------- */
+    sec_map.Start   =  start;
+    sec_map.Cnt     =  cnt;
+    sec_map.AddrPtr = (void *)0;
+    p_dev->DevDrvPtr->IO_Ctrl(         p_dev,
+                                       FS_DEV_IO_CTRL_SEC_MAP,
+                              (void *)&sec_map,
+                                       p_err);
+    if (*p_err == FS_ERR_DEV_INVALID_IO_CTRL) {                 /* Dev cannot map secs.                                 */
+        return ((void *)0);
+    }
+
+
+
+                                                                /* -------------------- HANDLE ERR -------------------- */
+    FSDev_HandleErr(p_dev, *p_err);                             /* See Note #3.                                         */
+    if (*p_err != FS_ERR_NONE) {
+        return ((void *)0);
+    }
+
+    if ((sec_map.AddrPtr == (void *)0) ||
+        (sec_map.Cnt     ==  0u)) {
+        return ((void *)0);
+    }
+
+   *p_map_cnt = DEF_MIN(sec_map.Cnt, cnt);
+    return (sec_map.AddrPtr);
+}
+
+
 /*
 *********************************************************************************************************
 *                                         FSDev_QueryLocked()
@@ -2415,11 +2516,13 @@ void  FSDev_RdLocked (FS_DEV      *p_dev,
 
 
                                                                 /* ---------------------- RD DEV ---------------------- */
+    FS_DEV_IO_HOOK_RD_START(p_dev, start, cnt);                 /* See 'fs.h  DEVICE I/O HOOKS'.                        */
     p_dev->DevDrvPtr->Rd(p_dev,
                          p_dest,
                          start,
                          cnt,
                          p_err);
+    FS_DEV_IO_HOOK_RD_END(p_dev, start, cnt, *p_err);
 
 
 
@@ -2433,6 +2536,115 @@ void  FSDev_RdLocked (FS_DEV      *p_dev,
 }
 
 
+/*
+*********************************************************************************************************
+*                                         FSDev_RdV_Locked()
+*
+* Description : Read consecutive device sectors into a list of buffers.
+*
+* Argument(s) : p_dev       Pointer to device.
+*               ----------  Argument validated by caller.
+*
+*               p_vec_tbl   Pointer to table of buffers (see 'fs_dev.h  DEVICE I/O VECTOR DATA TYPE').
+*               ----------  Argument validated by caller.
+*
+*               vec_cnt     Number of buffers in table.
+*
+*               start       Start sector of read.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Device sector(s) read.
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector start or count invalid.
+*
+*                                                              --- RETURNED BY DEV DRV's RdV() / Rd() ---
+*                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the device & hold the device lock.
+*
+*               (2) Device state change will result from device I/O, not present or timeout error.
+*
+*               (3) If the device driver does not provide 'RdV()', each buffer is read with
+*                   'FSDev_RdLocked()' (see 'fs_dev.h  DEVICE DRIVER API DATA TYPE  Note #1').
+*********************************************************************************************************
+*/
+
+void  FSDev_RdV_Locked (FS_DEV         *p_dev,
+                        FS_DEV_IO_VEC  *p_vec_tbl,
+                        FS_SEC_QTY      vec_cnt,
+                        FS_SEC_NBR      start,
+                        FS_ERR         *p_err)
+{
+    FS_SEC_QTY  size;
+    FS_SEC_QTY  cnt;
+    FS_SEC_QTY  vec_ix;
+
+
+
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+    size = p_dev->Size;
+
+    cnt  = 0u;
+    for (vec_ix = 0u; vec_ix < vec_cnt; vec_ix++) {
+        cnt += p_vec_tbl[vec_ix].Cnt;
+    }
+
+    if (cnt == 0u) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    if (start > size) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_NBR;
+        return;
+    }
+
+    if (start + cnt > size) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_NBR;
+        return;
+    }
+
+
+
+                                                                /* ---------------------- RD DEV ---------------------- */
+    if (p_dev->DevDrvPtr->RdV != DEF_NULL) {                    /* See Note #3.                                         */
+        FS_DEV_IO_HOOK_RD_START(p_dev, start, cnt);             /* See 'fs.h  DEVICE I/O HOOKS'.                        */
+        p_dev->DevDrvPtr->RdV(p_dev,
+                              p_vec_tbl,
+                              vec_cnt,
+                              start,
+                              p_err);
+        FS_DEV_IO_HOOK_RD_END(p_dev, start, cnt, *p_err);
+
+        FS_CTR_STAT_ADD(p_dev->StatRdSecCtr, (FS_CTR)cnt);      /* Update dev stats.                                    */
+
+        FSDev_HandleErr(p_dev, *p_err);                         /* See Note #2.                                         */
+        return;
+    }
+
+
+
+                                                                /* ------------------ RD DEV PER BUF ------------------ */
+    for (vec_ix = 0u; vec_ix < vec_cnt; vec_ix++) {
+        FSDev_RdLocked(p_dev,
+                       p_vec_tbl[vec_ix].BufPtr,
+                       start,
+                       p_vec_tbl[vec_ix].Cnt,
+                       p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+        start += p_vec_tbl[vec_ix].Cnt;
+    }
+}
+
+
 /*
 *********************************************************************************************************
 *                                          FSDev_RefreshLocked()
@@ -2810,11 +3022,13 @@ void  FSDev_WrLocked (FS_DEV      *p_dev,
 
 
                                                                 /* ---------------------- WR DEV ---------------------- */
+    FS_DEV_IO_HOOK_WR_START(p_dev, start, cnt);                 /* See 'fs.h  DEVICE I/O HOOKS'.                        */
     p_dev->DevDrvPtr->Wr(p_dev,
                          p_src,
                          start,
                          cnt,
                          p_err);
+    FS_DEV_IO_HOOK_WR_END(p_dev, start, cnt, *p_err);
 
 
 
@@ -2875,6 +3089,119 @@ void  FSDev_WrLocked (FS_DEV      *p_dev,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                         FSDev_WrV_Locked()
+*
+* Description : Write consecutive device sectors from a list of buffers.
+*
+* Argument(s) : p_dev       Pointer to device.
+*               ----------  Argument validated by caller.
+*
+*               p_vec_tbl   Pointer to table of buffers (see 'fs_dev.h  DEVICE I/O VECTOR DATA TYPE').
+*               ----------  Argument validated by caller.
+*
+*               vec_cnt     Number of buffers in table.
+*
+*               start       Start sector of write.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               ----------  Argument validated by caller.
+*
+*                               FS_ERR_NONE                    Device sector(s) written.
+*                               FS_ERR_DEV_INVALID_SEC_NBR     Sector start or count invalid.
+*
+*                                                              --- RETURNED BY DEV DRV's WrV() / Wr() ---
+*                               FS_ERR_DEV_INVALID_LOW_FMT     Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                  Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT             Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT         Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the device & hold the device lock.
+*
+*               (2) Device state change will result from device I/O, not present or timeout error.
+*
+*               (3) If the device driver does not provide 'WrV()', each buffer is written with
+*                   'FSDev_WrLocked()' (see 'fs_dev.h  DEVICE DRIVER API DATA TYPE  Note #1').  So is it
+*                   if written data is verified, which 'FSDev_WrLocked()' does.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSDev_WrV_Locked (FS_DEV         *p_dev,
+                        FS_DEV_IO_VEC  *p_vec_tbl,
+                        FS_SEC_QTY      vec_cnt,
+                        FS_SEC_NBR      start,
+                        FS_ERR         *p_err)
+{
+    FS_SEC_QTY  size;
+    FS_SEC_QTY  cnt;
+    FS_SEC_QTY  vec_ix;
+
+
+
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+    size = p_dev->Size;
+
+    cnt  = 0u;
+    for (vec_ix = 0u; vec_ix < vec_cnt; vec_ix++) {
+        cnt += p_vec_tbl[vec_ix].Cnt;
+    }
+
+    if (cnt == 0u) {
+       *p_err = FS_ERR_NONE;
+        return;
+    }
+
+    if (start > size) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_NBR;
+        return;
+    }
+
+    if (start + cnt > size) {
+       *p_err = FS_ERR_DEV_INVALID_SEC_NBR;
+        return;
+    }
+
+
+
+#if (FS_CFG_DBG_WR_VERIFY_EN == DEF_DISABLED)                   /* ---------------------- WR DEV ---------------------- */
+    if (p_dev->DevDrvPtr->WrV != DEF_NULL) {                    /* See Note #3.                                         */
+        FS_DEV_IO_HOOK_WR_START(p_dev, start, cnt);             /* See 'fs.h  DEVICE I/O HOOKS'.                        */
+        p_dev->DevDrvPtr->WrV(p_dev,
+                              p_vec_tbl,
+                              vec_cnt,
+                              start,
+                              p_err);
+        FS_DEV_IO_HOOK_WR_END(p_dev, start, cnt, *p_err);
+
+        FS_CTR_STAT_ADD(p_dev->StatWrSecCtr, (FS_CTR)cnt);      /* Update dev stats.                                    */
+
+        FSDev_HandleErr(p_dev, *p_err);                         /* See Note #2.                                         */
+        return;
+    }
+#endif
+
+
+
+                                                                /* ------------------ WR DEV PER BUF ------------------ */
+    for (vec_ix = 0u; vec_ix < vec_cnt; vec_ix++) {
+        FSDev_WrLocked(p_dev,
+                       p_vec_tbl[vec_ix].BufPtr,
+                       start,
+                       p_vec_tbl[vec_ix].Cnt,
+                       p_err);
+        if (*p_err != FS_ERR_NONE) {
+            return;
+        }
+        start += p_vec_tbl[vec_ix].Cnt;
+    }
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                            FSDev_VolAdd()
@@ -104,6 +104,7 @@
 #define  FS_DEV_IO_CTRL_WR_SEC                            15u   /* Write physical dev sector.                           */
 #define  FS_DEV_IO_CTRL_SYNC                              16u   /* Sync dev.                                            */
 #define  FS_DEV_IO_CTRL_CHIP_ERASE                        17u   /* Erase all data on phy dev.                           */
+#define  FS_DEV_IO_CTRL_SEC_MAP                           18u   /* Get addr of secs in addressable mem.                 */
 
                                                                 /* ------------ SD-DRIVER SPECIFIC OPTIONS ------------ */
 #define  FS_DEV_IO_CTRL_SD_QUERY                          64u   /* Get info about SD/MMC card.                          */
@@ -113,6 +114,11 @@
                                                                 /* ----------- NAND-DRIVER SPECIFIC OPTIONS ----------- */
 #define  FS_DEV_IO_CTRL_NAND_PARAM_PG_RD                  80u   /* Read parameter-page from ONFI device.                */
 #define  FS_DEV_IO_CTRL_NAND_DUMP                         81u   /* Dump raw NAND dev.                                   */
+#define  FS_DEV_IO_CTRL_NAND_BG_PROC                      82u   /* Perform one step of NAND background processing.      */
+
+                                                                /* ------------ NOR-DRIVER SPECIFIC OPTIONS ----------- */
+#define  FS_DEV_IO_CTRL_NOR_WEAR_INFO                     96u   /* Get NOR erase cnt stats & projected life.            */
+#define  FS_DEV_IO_CTRL_NOR_WEAR_LEVEL                    97u   /* Migrate one cold NOR blk (static wear leveling).     */
 
 /*
 *********************************************************************************************************
@@ -164,9 +170,51 @@ typedef  struct  fs_dev_info {
 } FS_DEV_INFO;
 
 
+/*
+*********************************************************************************************************
+*                                      DEVICE I/O VECTOR DATA TYPE
+*
+* Note(s) : (1) A vectored request transfers consecutive device sectors from or to a list of buffers :
+*               the first 'Cnt' sectors from or to the first buffer, the next ones from or to the second
+*               buffer, etc.
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_dev_io_vec {
+    void          *BufPtr;                                      /* Ptr to buf.                                          */
+    FS_SEC_QTY     Cnt;                                         /* Nbr of secs in buf.                                  */
+} FS_DEV_IO_VEC;
+
+
+/*
+*********************************************************************************************************
+*                                     DEVICE SECTOR MAP DATA TYPE
+*
+* Note(s) : (1) FS_DEV_IO_CTRL_SEC_MAP asks a driver whose storage is directly addressable (e.g., a RAM disk
+*               or a memory-mapped NOR flash) where sectors may be read in place.  The caller sets 'Start'
+*               & 'Cnt'; the driver sets 'AddrPtr' to the address of sector 'Start' & reduces 'Cnt' to the
+*               number of sectors stored contiguously from that address, or to 0 if sector 'Start' cannot
+*               be addressed.  A driver that cannot map sectors returns FS_ERR_DEV_INVALID_IO_CTRL.
+*
+*           (2) The address is only valid until the next write to, or low-level operation on, the device,
+*               which may move or overwrite the sectors.
+*********************************************************************************************************
+*/
+
+typedef  struct  fs_dev_sec_map {
+    FS_SEC_NBR     Start;                                       /* Start sec.                                           */
+    FS_SEC_QTY     Cnt;                                         /* Nbr of secs (see Note #1).                           */
+    void          *AddrPtr;                                     /* Addr of sec 'Start' (see Note #2).                   */
+} FS_DEV_SEC_MAP;
+
+
 /*
 *********************************************************************************************************
 *                                     DEVICE DRIVER API DATA TYPE
+*
+* Note(s) : (1) 'RdV()' & 'WrV()' perform a vectored request (see 'DEVICE I/O VECTOR DATA TYPE  Note #1')
+*               as a single device access.  They are optional : a driver that leaves them NULL is issued
+*               one 'Rd()' or 'Wr()' per buffer.
 *********************************************************************************************************
 */
 
@@ -203,6 +251,20 @@ struct  fs_dev_api {
                                             CPU_INT08U    opt,
                                             void         *p_data,
                                             FS_ERR       *p_err);
+
+    void              (*RdV)               (FS_DEV         *p_dev,        /* Vectored rd  (optional, may be NULL; see Note #1).   */
+                                            FS_DEV_IO_VEC  *p_vec_tbl,
+                                            FS_SEC_QTY      vec_cnt,
+                                            FS_SEC_NBR      start,
+                                            FS_ERR         *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    void              (*WrV)               (FS_DEV         *p_dev,        /* Vectored wr  (optional, may be NULL; see Note #1).   */
+                                            FS_DEV_IO_VEC  *p_vec_tbl,
+                                            FS_SEC_QTY      vec_cnt,
+                                            FS_SEC_NBR      start,
+                                            FS_ERR         *p_err);
+#endif
 };
 
 /*
@@ -379,6 +441,12 @@ void               FSDev_VolRemove       (FS_DEV              *p_dev,       /* R
 
 
                                                                             /* ------------- LOCKED ACCESS ------------ */
+void              *FSDev_MapLocked       (FS_DEV              *p_dev,       /* Get address of device sector(s).         */
+                                          FS_SEC_NBR           start,
+                                          FS_SEC_QTY           cnt,
+                                          FS_SEC_QTY          *p_map_cnt,
+                                          FS_ERR              *p_err);
+
 void               FSDev_QueryLocked     (FS_DEV              *p_dev,       /* Get information about a device.          */
                                           FS_DEV_INFO         *p_info,
                                           FS_ERR              *p_err);
@@ -389,6 +457,12 @@ void               FSDev_RdLocked        (FS_DEV              *p_dev,       /* R
                                           FS_SEC_QTY           cnt,
                                           FS_ERR              *p_err);
 
+void               FSDev_RdV_Locked      (FS_DEV              *p_dev,       /* Read device sectors into buffer list.    */
+                                          FS_DEV_IO_VEC       *p_vec_tbl,
+                                          FS_SEC_QTY           vec_cnt,
+                                          FS_SEC_NBR           start,
+                                          FS_ERR              *p_err);
+
 CPU_BOOLEAN        FSDev_RefreshLocked   (FS_DEV              *p_dev,       /* Refresh device.                          */
                                           FS_ERR              *p_err);
 
@@ -408,6 +482,12 @@ void               FSDev_WrLocked        (FS_DEV              *p_dev,       /* W
                                           FS_SEC_NBR           start,
                                           FS_SEC_QTY           cnt,
                                           FS_ERR              *p_err);
+
+void               FSDev_WrV_Locked      (FS_DEV              *p_dev,       /* Write device sectors from buffer list.   */
+                                          FS_DEV_IO_VEC       *p_vec_tbl,
+                                          FS_SEC_QTY           vec_cnt,
+                                          FS_SEC_NBR           start,
+                                          FS_ERR              *p_err);
 #endif
 
 /*
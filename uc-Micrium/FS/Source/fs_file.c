@@ -328,7 +328,7 @@ void  FSFile_BufAssign (FS_FILE     *p_file,
 *                               FS_ERR_DEV_CHNGD           Device has changed.
 *                               FS_ERR_FILE_NOT_OPEN       File NOT open.
 *
-*                                                          -------- RETURNED BY FSFile_BufEmpty() -------
+*                                                          --- RETURNED BY FSFile_BufEmpty()/FSSys_FileSync() ---
 *                               FS_ERR_BUF_NONE_AVAIL      No buffer available.
 *                               FS_ERR_DEV                 Device access error.
 *                               FS_ERR_DEV_FULL            Device is full (no space could be allocated).
@@ -347,6 +347,9 @@ void  FSFile_BufAssign (FS_FILE     *p_file,
 *
 *               (3) If an error occurred in the previous file access, the error indicator must be
 *                   cleared (with 'FSFile_ClrErr()') before another access will be allowed.
+*
+*               (4) The journaled operations of the file's volume are committed, so that those completed
+*                   before the flush survive a failure (see 'FSSys_FileSync()').
 *********************************************************************************************************
 */
 
@@ -396,6 +399,16 @@ void  FSFile_BufFlush (FS_FILE  *p_file,
 
 
 
+                                                                /* -------------------- COMMIT OPS -------------------- */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    FSSys_FileSync(p_file, p_err);                              /* See Note #4.                                         */
+    if (*p_err != FS_ERR_NONE) {
+        p_file->FlagErr = DEF_YES;
+    }
+#endif
+
+
+
                                                                 /* ----------------- RELEASE FILE LOCK ---------------- */
     FSFile_ReleaseUnlock(p_file);
 }
@@ -683,6 +696,7 @@ CPU_BOOLEAN  FSFile_IsErr (FS_FILE  *p_file,
 *                               FS_FILE_ACCESS_MODE_TRUNCATE    File length is truncated to 0.
 *                               FS_FILE_ACCESS_MODE_APPEND      All writes are performed at EOF.
 *                               FS_FILE_ACCESS_MODE_CACHED      File data is cached.
+*                               FS_FILE_ACCESS_MODE_DIRECT      File data bypasses the volume cache.
 *
 *               p_err       Pointer to variable that will receive the return error code:
 *
@@ -1026,6 +1040,191 @@ void  FSFile_LockSet (FS_FILE  *p_file,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                             FSFile_Map()
+*
+* Description : Get a read-only view of file data, from the file position, in memory.
+*
+* Argument(s) : p_file      Pointer to a file.
+*
+*               p_buf       Pointer to buffer that will receive a copy of the data, if the data cannot be
+*                           mapped (see Note #2), or NULL pointer.
+*
+*               size        Maximum number of octets to map.
+*
+*               pp_data     Pointer to variable that will receive the address of the data.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File data mapped or copied successfully.
+*                               FS_ERR_NULL_PTR               Argument 'p_file'/'pp_data' passed a NULL pointer.
+*                               FS_ERR_INVALID_TYPE           Argument 'p_file's TYPE is invalid or unknown.
+*                               FS_ERR_FILE_ERR               File has error (see 'FSFile_Rd()  Note #5').
+*                               FS_ERR_FILE_INVALID_OP        Invalid operation on file.
+*                               FS_ERR_FILE_INVALID_OP_SEQ    Invalid operation sequence on file.
+*
+*                                                             --- RETURNED BY FSFile_AcquireLockChk() ---
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_FILE_NOT_OPEN          File NOT open.
+*
+*                                                             ------- RETURNED BY FSSys_FileMap() -------
+*                               FS_ERR_DEV_INVALID_IO_CTRL    Device cannot map data & 'p_buf' is NULL.
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
+*
+* Return(s)   : Number of octets at '*pp_data', if no error.
+*               0,                                otherwise.
+*
+* Note(s)     : (1) The data is mapped only where the device stores the volume in addressable memory (a
+*                   RAM disk, or NOR flash mapped in the CPU address space).  The octets mapped are the
+*                   longest run, from the file position, held contiguously in that memory; fewer than
+*                   'size' octets may thus be returned before the end of the file.  The file position is
+*                   advanced past the octets returned, so that repeated calls walk the extents of the
+*                   file.  The end of file is reached when zero octets are returned.
+*
+*               (2) If the device cannot map data, up to 'size' octets are read into 'p_buf' & '*pp_data'
+*                   is set to 'p_buf'.  'p_buf' may be NULL if the caller handles the error itself.
+*
+*               (3) The data MUST NOT be modified.  The address remains valid until the next write to the
+*                   volume or low-level operation on its device (see 'fs_dev.h  DEVICE SECTOR MAP DATA
+*                   TYPE  Note #2'); the file lock does NOT extend to the view.
+*
+*               (4) Data read ahead in the file buffer is discarded & the data mapped from the device.
+*                   A file buffer can no longer be assigned to the file.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FSFile_Map (FS_FILE      *p_file,
+                        void         *p_buf,
+                        CPU_SIZE_T    size,
+                        void        **pp_data,
+                        FS_ERR       *p_err)
+{
+    CPU_SIZE_T  size_map;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(0u);
+    }
+    if (p_file == (FS_FILE *)0) {                               /* Validate file ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+    if (pp_data == (void **)0) {                                /* Validate data ptr.                                   */
+       *p_err = FS_ERR_NULL_PTR;
+        return (0u);
+    }
+#endif
+
+   *pp_data = (void *)0;
+
+                                                                /* ----------------- ACQUIRE FILE LOCK ---------------- */
+    (void)FSFile_AcquireLockChk(p_file, p_err);
+    if (*p_err != FS_ERR_NONE) {
+        return (0u);
+    }
+
+    if (DEF_BIT_IS_CLR(p_file->AccessMode, FS_FILE_ACCESS_MODE_RD) == DEF_YES) {
+        FSFile_ReleaseUnlock(p_file);                           /* Chk file mode.                                       */
+       *p_err = FS_ERR_FILE_INVALID_OP;
+        return (0u);
+    }
+
+    if (p_file->IO_State == FS_FILE_IO_STATE_WR) {              /* Chk state (see 'FSFile_Rd()  Note #2').              */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
+        return (0u);
+    }
+
+    if (p_file->FlagErr == DEF_YES) {                           /* Chk for file err.                                    */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_ERR;
+        return (0u);
+    }
+
+    if (size == 0u) {                                           /* Rtn 0 bytes mapped.                                  */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_NONE;
+        return (0u);
+    }
+
+
+
+                                                                /* ---------------- HANDLE FILE BUFFER ---------------- */
+#if (FS_CFG_FILE_BUF_EN == DEF_ENABLED)
+#if (FS_CFG_RD_ONLY_EN  == DEF_DISABLED)
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_WR) {  /* Chk buf status.                                      */
+        FSFile_ReleaseUnlock(p_file);
+       *p_err = FS_ERR_FILE_INVALID_OP_SEQ;
+        return (0u);
+    }
+#endif
+
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONEMPTY_RD) {  /* Discard rd buf data (see Note #4).                   */
+        FSFile_BufEmpty(p_file, p_err);
+        if (*p_err != FS_ERR_NONE) {
+            FSFile_ReleaseUnlock(p_file);
+            return (0u);
+        }
+    }
+                                                                /* Blk buf assignment.                                  */
+    if (p_file->BufStatus == FS_FILE_BUF_STATUS_NONE) {
+        p_file->BufStatus =  FS_FILE_BUF_STATUS_NEVER;
+    }
+#endif
+
+
+
+                                                                /* --------------------- MAP FILE --------------------- */
+    size_map = FSSys_FileMap(p_file,
+                             size,
+                             pp_data,
+                             p_err);
+
+    if ((*p_err == FS_ERR_DEV_INVALID_IO_CTRL) &&               /* Copy unmappable data (see Note #2).                  */
+        (p_buf  != (void *)0)) {
+        size_map = FSSys_FileRd(p_file,
+                                p_buf,
+                                size,
+                                p_err);
+       *pp_data  = p_buf;
+    }
+
+    p_file->Pos += size_map;
+
+
+                                                                /* ----------------- UPDATE FILE FLAGS ---------------- */
+    switch (*p_err) {
+        case FS_ERR_BUF_NONE_AVAIL:
+        case FS_ERR_DEV_INVALID_IO_CTRL:
+             break;
+
+        case FS_ERR_NONE:
+             if (size_map != 0u) {
+                 p_file->IO_State = FS_FILE_IO_STATE_RD;
+                 p_file->FlagEOF  = DEF_NO;
+             } else {
+                 p_file->FlagEOF  = DEF_YES;                    /* See Note #1.                                         */
+             }
+             break;
+
+        default:                                                /* Update err flag.                                     */
+             p_file->FlagEOF = DEF_NO;
+             p_file->FlagErr = DEF_YES;
+             break;
+    }
+
+
+
+                                                                /* ----------------- RELEASE FILE LOCK ---------------- */
+    FSFile_ReleaseUnlock(p_file);
+    return (size_map);
+}
+
+
 /*
 *********************************************************************************************************
 *                                            FSFile_Open()
@@ -1044,6 +1243,8 @@ void  FSFile_LockSet (FS_FILE  *p_file,
 *                               FS_FILE_ACCESS_MODE_EXCL        File will be opened if & only if it does
 *                                                                   not already exist.
 *                               FS_FILE_ACCESS_MODE_CACHED      File data will be cached.
+*                               FS_FILE_ACCESS_MODE_DIRECT      Whole clusters of file data will bypass
+*                                                                   the volume cache.
 *
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
@@ -1192,7 +1393,7 @@ FS_FILE  *FSFile_Open (CPU_CHAR  *name_full,
                                                                 /* See Note #2a4.                                       */
     if ((mode & (FS_FILE_ACCESS_MODE_RD       | FS_FILE_ACCESS_MODE_WR     | FS_FILE_ACCESS_MODE_APPEND |
                  FS_FILE_ACCESS_MODE_TRUNCATE | FS_FILE_ACCESS_MODE_CREATE | FS_FILE_ACCESS_MODE_EXCL   |
-                 FS_FILE_ACCESS_MODE_CACHED                                                             )) != mode) {
+                 FS_FILE_ACCESS_MODE_CACHED   | FS_FILE_ACCESS_MODE_DIRECT                              )) != mode) {
        *p_err = FS_ERR_FILE_INVALID_ACCESS_MODE;
         return ((FS_FILE *)0);
     }
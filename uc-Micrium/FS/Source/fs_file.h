@@ -108,6 +108,10 @@
 /*
 *********************************************************************************************************
 *                                      FILE ACCESS MODE DEFINES
+*
+* Note(s) : (1) FS_FILE_ACCESS_MODE_DIRECT transfers the whole clusters of large reads & writes between the
+*               device & the application buffer, around the volume cache (see 'fs_fat_file.c
+*               FS_FAT_FileSecRd()').  Bits 7 to 9 are reserved for the file system driver's own modes.
 *********************************************************************************************************
 */
 
@@ -119,6 +123,7 @@
 #define  FS_FILE_ACCESS_MODE_APPEND              DEF_BIT_04     /* Append to file.                                      */
 #define  FS_FILE_ACCESS_MODE_EXCL                DEF_BIT_05     /* File must be created.                                */
 #define  FS_FILE_ACCESS_MODE_CACHED              DEF_BIT_06     /* Defer file metadata updates until close operation.   */
+#define  FS_FILE_ACCESS_MODE_DIRECT              DEF_BIT_10     /* Xfer whole clus around vol cache (see Note #1).      */
 #define  FS_FILE_ACCESS_MODE_RDWR               (FS_FILE_ACCESS_MODE_RD | FS_FILE_ACCESS_MODE_WR)
 
 /*
@@ -252,6 +257,12 @@ void           FSFile_LockSet      (FS_FILE         *p_file,    /* Release task
                                     FS_ERR          *p_err);
 #endif
 
+CPU_SIZE_T     FSFile_Map          (FS_FILE         *p_file,    /* Map file data in memory.                             */
+                                    void            *p_buf,
+                                    CPU_SIZE_T       size,
+                                    void           **pp_data,
+                                    FS_ERR          *p_err);
+
 FS_FILE       *FSFile_Open         (CPU_CHAR        *name_full, /* Open a file.                                         */
                                     FS_FLAGS         mode,
                                     FS_ERR          *p_err);
@@ -405,6 +405,51 @@ void  FSSys_FileClose  (FS_FILE  *p_file,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSSys_FileMap()
+*
+* Description : Map file data, from the file position, in memory.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               size        Maximum number of octets to map.
+*
+*               pp_data     Pointer to variable that will receive the address of the mapped data.
+*               -------     Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   File data mapped, or file position at EOF.
+*                               FS_ERR_BUF_NONE_AVAIL         No buffer available.
+*                               FS_ERR_DEV_INVALID_IO_CTRL    Device cannot map sectors.
+*                               FS_ERR_DEV                    Device access error.
+*                               FS_ERR_ENTRY_CORRUPT          File system entry corrupt.
+*
+* Return(s)   : Number of octets mapped, if file data mapped.
+*               0,                       otherwise.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  FSSys_FileMap (FS_FILE      *p_file,
+                           CPU_SIZE_T    size,
+                           void        **pp_data,
+                           FS_ERR       *p_err)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    CPU_SIZE_T  size_map;
+
+    size_map = FS_FAT_FileMap(p_file, size, pp_data, p_err);
+    return (size_map);
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+
+
 /*
 *********************************************************************************************************
 *                                          FSSys_FileOpen()
@@ -568,6 +613,40 @@ CPU_SIZE_T  FSSys_FileRd (FS_FILE     *p_file,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSSys_FileSync()
+*
+* Description : Commit the journaled operations of a file's volume.
+*
+* Argument(s) : p_file      Pointer to a file.
+*               ------      Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               FS_ERR_NONE              Operations committed.
+*                               FS_ERR_BUF_NONE_AVAIL    No buffer available.
+*                               FS_ERR_DEV               Device access error.
+*
+* Return(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSSys_FileSync (FS_FILE  *p_file,
+                      FS_ERR   *p_err)
+{
+#ifdef FS_FAT_MODULE_PRESENT
+    FS_FAT_FileSync(p_file, p_err);
+#else
+#error  "NO SYS DRIVER PRESENT"                                 /* See 'fs_sys.c  Notes #1'.                            */
+#endif
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                        FSSys_FileTruncate()
@@ -156,6 +156,11 @@ void        FSSys_VolQuery      (FS_VOL         *p_vol,         /* Get info abou
 void        FSSys_FileClose     (FS_FILE        *p_file,        /* Close a file.                                        */
                                  FS_ERR         *p_err);
 
+CPU_SIZE_T  FSSys_FileMap       (FS_FILE        *p_file,        /* Map file data in memory.                             */
+                                 CPU_SIZE_T      size,
+                                 void          **pp_data,
+                                 FS_ERR         *p_err);
+
 void        FSSys_FileOpen      (FS_FILE        *p_file,        /* Open a file.                                         */
                                  CPU_CHAR       *name_file,
                                  FS_ERR         *p_err);
@@ -173,6 +178,11 @@ CPU_SIZE_T  FSSys_FileRd        (FS_FILE        *p_file,        /* Read from a f
                                  CPU_SIZE_T      size,
                                  FS_ERR         *p_err);
 
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void        FSSys_FileSync      (FS_FILE        *p_file,        /* Commit journaled ops of file's vol.                  */
+                                 FS_ERR         *p_err);
+#endif
+
 #if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
 void        FSSys_FileTruncate  (FS_FILE        *p_file,        /* Truncate a file.                                     */
                                  FS_FILE_SIZE    size,
@@ -105,6 +105,8 @@ typedef  struct  fs_vol              FS_VOL;
 
 typedef  struct  fs_vol_cache_api    FS_VOL_CACHE_API;
 
+typedef  struct  fs_vol_cache_info   FS_VOL_CACHE_INFO;
+
 
 /*
 *********************************************************************************************************
@@ -374,6 +374,98 @@ void  FSVol_CacheFlush (CPU_CHAR  *name_vol,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                         FSVol_CacheWrBack()
+*
+* Description : Write back the sectors of a volume cache that have been dirty for too long.
+*
+* Argument(s) : name_vol    Volume name.
+*
+*               age_max     Maximum age of dirty sectors, in calls to this function.
+*
+*               p_err       Pointer to variable that will the receive the return error code from this function :
+*
+*                               FS_ERR_NONE                   Aged sectors written.
+*                               FS_ERR_NAME_NULL              Argument 'name_vol' passed a NULL pointer.
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*                               FS_ERR_VOL_NO_CACHE           No cache assigned to volume.
+*                               FS_ERR_VOL_NOT_OPEN           Volume not open.
+*                               FS_ERR_VOL_NOT_MOUNTED        Volume not mounted.
+*
+*                                                             -------- RETURNED BY CACHE WrBack() -------
+*                               FS_ERR_DEV_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) Intended to be called periodically by a low-priority background writer task : each
+*                   call is one tick of the cache's dirty age clock, & sectors written to a write back
+*                   cache reach the device within 'age_max' calls.  E.g., calling
+*
+*                       FSVol_CacheWrBack("sd:0:", 10u, &err);
+*
+*                   every 100 ms bounds the data held only in the cache to about 1 second of writes,
+*                   while writes coalesced within that window are still merged (see 'fs_cache.c').
+*
+*               (2) Caches that do not support write back (or have no WrBack() function) are ignored.
+*********************************************************************************************************
+*/
+
+#ifdef FS_CACHE_MODULE_PRESENT
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSVol_CacheWrBack (CPU_CHAR    *name_vol,
+                         CPU_INT32U   age_max,
+                         FS_ERR      *p_err)
+{
+    FS_VOL  *p_vol;
+
+
+#if (FS_CFG_ERR_ARG_CHK_EXT_EN == DEF_ENABLED)                  /* ------------------- VALIDATE ARGS ------------------ */
+    if (p_err == (FS_ERR *)0) {                                 /* Validate error ptr.                                  */
+        CPU_SW_EXCEPTION(;);
+    }
+    if (name_vol == (CPU_CHAR *)0) {                            /* Validate name ptr.                                   */
+       *p_err = FS_ERR_NAME_NULL;
+        return;
+    }
+#endif
+
+
+
+                                                                /* ----------------- ACQUIRE VOL LOCK ----------------- */
+    p_vol = FSVol_AcquireLockChk(name_vol, DEF_YES, p_err);     /* Vol MUST be mounted.                                 */
+    if (p_vol == (FS_VOL *)0) {
+        return;
+    }
+
+    if (p_vol->CacheAPI_Ptr == (FS_VOL_CACHE_API *)0) {
+       *p_err = FS_ERR_VOL_NO_CACHE;
+        FSVol_ReleaseUnlock(p_vol);
+        return;
+    }
+
+
+
+                                                                /* ------------------ WR BACK CACHE ------------------- */
+    if (p_vol->CacheAPI_Ptr->WrBack != DEF_NULL) {              /* See Note #2.                                         */
+        p_vol->CacheAPI_Ptr->WrBack(p_vol, age_max, p_err);
+    } else {
+       *p_err = FS_ERR_NONE;
+    }
+
+
+
+                                                                /* ----------------- RELEASE VOL LOCK ----------------- */
+    FSVol_ReleaseUnlock(p_vol);
+}
+#endif
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                            FSVol_Close()
@@ -390,7 +482,8 @@ void  FSVol_CacheFlush (CPU_CHAR  *name_vol,
 *
 * Return(s)   : none.
 *
-* Note(s)     : none.
+* Note(s)     : (1) Sectors left dirty in a write-back cache, including those written by the file system
+*                   driver as the volume is closed, are written to the device before the cache is deleted.
 *********************************************************************************************************
 */
 
@@ -444,6 +537,12 @@ void  FSVol_Close (CPU_CHAR  *name_vol,
         FSSys_VolClose(p_vol);                                  /* Close vol.                                           */
     }
 
+#ifdef FS_CACHE_MODULE_PRESENT                                  /* Flush cache (see Note #1).                           */
+    if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {
+        p_vol->CacheAPI_Ptr->Flush(p_vol, p_err);               /* Err ignored : vol closed regardless.                 */
+    }
+#endif
+
     FSDev_VolRemove(p_vol->DevPtr, p_vol);
     p_vol->State = FS_VOL_STATE_CLOSING;
 
@@ -1203,6 +1302,10 @@ void  FSVol_Query (CPU_CHAR     *name_vol,
     p_info->VolUsedSecCnt = 0u;
     p_info->VolFreeSecCnt = 0u;
     p_info->VolTotSecCnt  = 0u;
+#ifdef FS_CACHE_MODULE_PRESENT
+    Mem_Clr((void *)&p_info->Cache, sizeof(FS_VOL_CACHE_INFO));
+    p_info->Cache.Mode    = FS_VOL_CACHE_MODE_NONE;
+#endif
 
 
 
@@ -1214,6 +1317,18 @@ void  FSVol_Query (CPU_CHAR     *name_vol,
 
 
 
+#ifdef FS_CACHE_MODULE_PRESENT                                  /* ------------------- GET CACHE INFO ----------------- */
+    if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {
+        if (p_vol->CacheAPI_Ptr->Query != DEF_NULL) {
+            p_vol->CacheAPI_Ptr->Query( p_vol,
+                                       &p_info->Cache,
+                                        p_err);
+        }
+    }
+#endif
+
+
+
                                                                 /* -------------------- GET DEV INFO ------------------ */
     p_dev = p_vol->DevPtr;
     if ((p_vol->State == FS_VOL_STATE_PRESENT) ||
@@ -2377,6 +2492,109 @@ static  void  FSVol_OpenLocked (FS_VOL  *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                          FSVol_MapLocked()
+*
+* Description : Get the address of volume sector(s) in addressable memory.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+*               start       Start sector.
+*
+*               cnt         Number of sectors.
+*
+*               p_map_cnt   Pointer to variable that will receive the number of sectors, from 'start', stored
+*               ---------   contiguously at the returned address.
+*                           Argument validated by caller.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Sector(s) mapped.
+*                               FS_ERR_VOL_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*
+*                                                             ----- RETURNED BY FSDev_MapLocked() -----
+*                               FS_ERR_DEV_INVALID_IO_CTRL    Device cannot map sectors.
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+*                                                             ------ RETURNED BY cache flush/clean -----
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*
+* Return(s)   : Pointer to first sector, if the sector is mapped;
+*               NULL pointer,            otherwise.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the volume & hold the device lock.
+*
+*               (2) Dirty cached copies of the sectors are written back first, so that the memory holds the
+*                   current data.  A cache that does not implement cleaning a range is flushed.
+*
+*               (3) See 'fs_dev.h  DEVICE SECTOR MAP DATA TYPE  Note #2' for the validity of the address.
+*********************************************************************************************************
+*/
+
+void  *FSVol_MapLocked (FS_VOL      *p_vol,
+                        FS_SEC_NBR   start,
+                        FS_SEC_QTY   cnt,
+                        FS_SEC_QTY  *p_map_cnt,
+                        FS_ERR      *p_err)
+{
+    void  *p_data;
+
+
+   *p_map_cnt = 0u;
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
+    if (start + cnt > p_vol->PartitionSize) {                   /* Validate start & cnt.                                */
+       *p_err = FS_ERR_VOL_INVALID_SEC_NBR;
+        return ((void *)0);
+    }
+#endif
+
+                                                                /* -------------- CHECK VOLUME VALIDITY --------------- */
+    if (p_vol->RefreshCnt != p_vol->DevPtr->RefreshCnt) {
+       *p_err = FS_ERR_DEV_CHNGD;
+        return ((void *)0);
+    }
+
+
+#ifdef FS_CACHE_MODULE_PRESENT                                  /* ---------------- WR BACK DIRTY SECS ---------------- */
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+    if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {         /* See Note #2.                                         */
+        if (p_vol->CacheAPI_Ptr->Clean != DEF_NULL) {
+            p_vol->CacheAPI_Ptr->Clean(p_vol,
+                                       start,
+                                       cnt,
+                                       p_err);
+        } else {
+            p_vol->CacheAPI_Ptr->Flush(p_vol,
+                                       p_err);
+        }
+        if (*p_err != FS_ERR_NONE) {
+            return ((void *)0);
+        }
+    }
+#endif
+#endif
+
+
+
+                                                                /* --------------------- MAP SECS --------------------- */
+    p_data = FSDev_MapLocked(p_vol->DevPtr,
+                             start + p_vol->PartitionStart,
+                             cnt,
+                             p_map_cnt,
+                             p_err);
+
+    return (p_data);
+}
+
+
 /*
 *********************************************************************************************************
 *                                          FSVol_RdLocked()
@@ -2545,6 +2763,205 @@ void  FSVol_RdLockedEx (FS_VOL      *p_vol,
 }
 
 
+/*
+*********************************************************************************************************
+*                                        FSVol_RdAheadLocked()
+*
+* Description : Read volume sector(s) ahead into the volume cache.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+*               start       Start sector of read ahead.
+*
+*               cnt         Number of sectors to read ahead.
+*
+*               sec_type    Type of sector(s) :
+*
+*                               FS_VOL_SEC_TYPE_MGMT    Management sector.
+*                               FS_VOL_SEC_TYPE_DIR     Directory sector.
+*                               FS_VOL_SEC_TYPE_FILE    File sector.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Sector(s) read ahead, or none to read.
+*                               FS_ERR_VOL_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*
+*                                                             ------- RETURNED BY FSDev_RdLocked() ------
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : Number of sectors, from 'start', in the volume cache.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the volume & hold the device lock.
+*
+*               (2) Read ahead is a hint : nothing is read if the volume has no cache or if its cache
+*                   does not implement read ahead.  Sectors read ahead are NOT counted in the volume's
+*                   read statistics; they are counted when actually read.
+*********************************************************************************************************
+*/
+
+#ifdef FS_CACHE_MODULE_PRESENT
+FS_SEC_QTY  FSVol_RdAheadLocked (FS_VOL      *p_vol,
+                                 FS_SEC_NBR   start,
+                                 FS_SEC_QTY   cnt,
+                                 FS_FLAGS     sec_type,
+                                 FS_ERR      *p_err)
+{
+    FS_SEC_QTY  cnt_ahead;
+
+
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+    if (start >= p_vol->PartitionSize) {
+       *p_err = FS_ERR_VOL_INVALID_SEC_NBR;
+        return (0u);
+    }
+    if (cnt > p_vol->PartitionSize - start) {                   /* Clip to end of vol.                                  */
+        cnt = p_vol->PartitionSize - start;
+    }
+
+                                                                /* -------------- CHECK VOLUME VALIDITY --------------- */
+    if (p_vol->RefreshCnt != p_vol->DevPtr->RefreshCnt) {
+       *p_err = FS_ERR_DEV_CHNGD;
+        return (0u);
+    }
+
+                                                                /* ------------------- RD AHEAD ----------------------- */
+   *p_err = FS_ERR_NONE;
+    if (p_vol->CacheAPI_Ptr == (FS_VOL_CACHE_API *)0) {         /* See Note #2.                                         */
+        return (0u);
+    }
+    if (p_vol->CacheAPI_Ptr->RdAhead == DEF_NULL) {
+        return (0u);
+    }
+
+    cnt_ahead = p_vol->CacheAPI_Ptr->RdAhead(p_vol,
+                                             start,
+                                             cnt,
+                                             sec_type,
+                                             p_err);
+    return (cnt_ahead);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       FSVol_RdDirectLocked()
+*
+* Description : Read data from volume sector(s), bypassing the volume cache.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+*               p_dest      Pointer to destination buffer.
+*               ------      Argument validated by caller.
+*
+*               start       Start sector of read.
+*
+*               cnt         Number of sectors to read.
+*
+*               sec_type    Type of sector(s) :
+*
+*                               FS_VOL_SEC_TYPE_MGMT    Management sector.
+*                               FS_VOL_SEC_TYPE_DIR     Directory sector.
+*                               FS_VOL_SEC_TYPE_FILE    File sector.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Volume sector(s) read.
+*                               FS_ERR_VOL_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*
+*                                                             ------- RETURNED BY FSDev_RdLocked() ------
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the volume & hold the device lock.
+*
+*               (2) The sectors are read from the device in a single request & NOT put in the volume
+*                   cache; the cache supplies the sectors it holds newer data for.  A cache that does not
+*                   implement direct reads is read through, like 'FSVol_RdLockedEx()'.
+*********************************************************************************************************
+*/
+
+void  FSVol_RdDirectLocked (FS_VOL      *p_vol,
+                            void        *p_dest,
+                            FS_SEC_NBR   start,
+                            FS_SEC_QTY   cnt,
+                            FS_FLAGS     sec_type,
+                            FS_ERR      *p_err)
+{
+#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
+    FS_SEC_QTY  size;
+#endif
+
+
+    (void)sec_type;
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
+    size = p_vol->PartitionSize;
+    if (start + cnt > size) {                                   /* Validate start & cnt.                                */
+       *p_err = FS_ERR_VOL_INVALID_SEC_NBR;
+        return;
+    }
+#endif
+
+                                                                /* -------------- CHECK VOLUME VALIDITY --------------- */
+    if (p_vol->RefreshCnt != p_vol->DevPtr->RefreshCnt) {
+       *p_err = FS_ERR_DEV_CHNGD;
+        return;
+    }
+
+
+#ifdef FS_CACHE_MODULE_PRESENT                                  /* ----------------- RD AROUND CACHE ------------------ */
+    if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {         /* See Note #2.                                         */
+        if (p_vol->CacheAPI_Ptr->RdDirect != DEF_NULL) {
+            p_vol->CacheAPI_Ptr->RdDirect(p_vol,
+                                          p_dest,
+                                          start,
+                                          cnt,
+                                          sec_type,
+                                          p_err);
+        } else {
+            p_vol->CacheAPI_Ptr->Rd(p_vol,
+                                    p_dest,
+                                    start,
+                                    cnt,
+                                    sec_type,
+                                    p_err);
+        }
+        FS_CTR_STAT_ADD(p_vol->StatRdSecCtr, (FS_CTR)cnt);
+        return;
+    }
+#endif
+
+
+
+                                                                /* ---------------------- RD DEV ---------------------- */
+    start += p_vol->PartitionStart;
+    FSDev_RdLocked(p_vol->DevPtr,
+                   p_dest,
+                   start,
+                   cnt,
+                   p_err);
+
+
+
+                                                                /* ----------------- UPDATE VOL STATS ----------------- */
+    FS_CTR_STAT_ADD(p_vol->StatRdSecCtr, (FS_CTR)cnt);
+}
+
+
 /*
 *********************************************************************************************************
 *                                          FSVol_RefreshLocked()
@@ -2893,6 +3310,121 @@ void  FSVol_WrLockedEx (FS_VOL      *p_vol,
 #endif
 
 
+/*
+*********************************************************************************************************
+*                                       FSVol_WrDirectLocked()
+*
+* Description : Write data to volume sector(s), bypassing the volume cache.
+*
+* Argument(s) : p_vol       Pointer to volume.
+*               -----       Argument validated by caller.
+*
+*               p_src       Pointer to source buffer.
+*               -----       Argument validated by caller.
+*
+*               start       Start sector of write.
+*
+*               cnt         Number of sectors to write.
+*
+*               sec_type    Type of sector(s) :
+*
+*                               FS_VOL_SEC_TYPE_MGMT    Management sector.
+*                               FS_VOL_SEC_TYPE_DIR     Directory sector.
+*                               FS_VOL_SEC_TYPE_FILE    File sector.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*               -----       Argument validated by caller.
+*
+*                               FS_ERR_NONE                   Volume sector(s) written.
+*                               FS_ERR_VOL_INVALID_SEC_NBR    Sector start or count invalid.
+*                               FS_ERR_DEV_CHNGD              Device has changed.
+*
+*                                                             ------- RETURNED BY FSDev_WrLocked() ------
+*                               FS_ERR_DEV_INVALID_LOW_FMT    Device needs to be low-level formatted.
+*                               FS_ERR_DEV_IO                 Device I/O error.
+*                               FS_ERR_DEV_TIMEOUT            Device timeout error.
+*                               FS_ERR_DEV_NOT_PRESENT        Device is not present.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The function caller MUST have acquired a reference to the volume & hold the device lock.
+*
+*               (2) The sectors are written to the device in a single request; the copies the volume cache
+*                   holds, dirty or not, are dropped.  A cache that does not implement direct writes is
+*                   written through, like 'FSVol_WrLockedEx()'.
+*********************************************************************************************************
+*/
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void  FSVol_WrDirectLocked (FS_VOL      *p_vol,
+                            void        *p_src,
+                            FS_SEC_NBR   start,
+                            FS_SEC_QTY   cnt,
+                            FS_FLAGS     sec_type,
+                            FS_ERR      *p_err)
+{
+#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
+    FS_SEC_QTY  size;
+#endif
+
+
+    (void)sec_type;
+                                                                /* ------------------ VALIDATE ARGS ------------------- */
+#if (FS_CFG_ERR_ARG_CHK_DBG_EN == DEF_ENABLED)
+    size = p_vol->PartitionSize;
+    if (start + cnt > size) {                                   /* Validate start & cnt.                                */
+       *p_err = FS_ERR_VOL_INVALID_SEC_NBR;
+        return;
+    }
+#endif
+
+                                                                /* -------------- CHECK VOLUME VALIDITY --------------- */
+    if (p_vol->RefreshCnt != p_vol->DevPtr->RefreshCnt) {
+       *p_err = FS_ERR_DEV_CHNGD;
+        return;
+    }
+
+
+#ifdef FS_CACHE_MODULE_PRESENT                                  /* ----------------- WR AROUND CACHE ------------------ */
+    if (p_vol->CacheAPI_Ptr != (FS_VOL_CACHE_API *)0) {         /* See Note #2.                                         */
+        if (p_vol->CacheAPI_Ptr->WrDirect != DEF_NULL) {
+            p_vol->CacheAPI_Ptr->WrDirect(p_vol,
+                                          p_src,
+                                          start,
+                                          cnt,
+                                          sec_type,
+                                          p_err);
+        } else {
+            p_vol->CacheAPI_Ptr->Wr(p_vol,
+                                    p_src,
+                                    start,
+                                    cnt,
+                                    sec_type,
+                                    p_err);
+        }
+        FS_CTR_STAT_ADD(p_vol->StatWrSecCtr, (FS_CTR)cnt);
+        return;
+    }
+#endif
+
+
+
+                                                                /* ---------------------- WR DEV ---------------------- */
+    start += p_vol->PartitionStart;
+    FSDev_WrLocked(p_vol->DevPtr,
+                   p_src,
+                   start,
+                   cnt,
+                   p_err);
+
+
+
+                                                                /* ----------------- UPDATE VOL STATS ----------------- */
+    FS_CTR_STAT_ADD(p_vol->StatWrSecCtr, (FS_CTR)cnt);
+}
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                           FSVol_DirAdd()
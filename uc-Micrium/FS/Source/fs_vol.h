@@ -162,6 +162,29 @@ struct  fs_vol {
 };
 
 
+/*
+*********************************************************************************************************
+*                                     VOLUME CACHE INFO DATA TYPE
+*
+* Note(s) : (1) Counters are maintained only if FS_CFG_CTR_STAT_EN is enabled.
+*********************************************************************************************************
+*/
+
+struct  fs_vol_cache_info {
+    FS_FLAGS           Mode;                                    /* Cache mode (FS_VOL_CACHE_MODE_NONE if no cache).     */
+    FS_SEC_QTY         Size;                                    /* Nbr of cache bufs.                                   */
+    FS_SEC_QTY         SizeMgmt;                                /* Nbr of cache bufs for mgmt secs.                     */
+    FS_SEC_QTY         SizeDir;                                 /* Nbr of cache bufs for dir  secs.                     */
+    FS_SEC_QTY         SizeFile;                                /* Nbr of cache bufs for file secs.                     */
+    FS_CTR             HitCtr;                                  /* Nbr of secs found in cache     (see Note #1).        */
+    FS_CTR             MissCtr;                                 /* Nbr of secs NOT found in cache (see Note #1).        */
+    FS_CTR             EvictCtr;                                /* Nbr of secs evicted from cache (see Note #1).        */
+    FS_CTR             RdAheadCtr;                              /* Nbr of secs rd ahead           (see Note #1).        */
+    FS_CTR             RdAheadHitCtr;                           /* Nbr of secs rd ahead & then rd (see Note #1).        */
+    FS_CTR             DirectCtr;                               /* Nbr of secs xfer'd around cache (see Note #1).       */
+};
+
+
 /*
 *********************************************************************************************************
 *                                        VOLUME INFO DATA TYPE
@@ -178,6 +201,9 @@ typedef  struct  fs_vol_info {
     FS_SEC_QTY         VolFreeSecCnt;                           /* Number of free  data sectors on vol.                 */
     FS_SEC_QTY         VolUsedSecCnt;                           /* Number of used  data sectors on vol.                 */
     FS_SEC_QTY         VolTotSecCnt;                            /* Number of total data sectors on vol.                 */
+#ifdef FS_CACHE_MODULE_PRESENT
+    FS_VOL_CACHE_INFO  Cache;                                   /* Cache info.                                          */
+#endif
 } FS_VOL_INFO;
 
 
@@ -209,6 +235,12 @@ void          FSVol_CacheInvalidate(CPU_CHAR          *name_vol,    /* Invalidat
 
 void          FSVol_CacheFlush     (CPU_CHAR          *name_vol,    /* Flush cache on a volume.                         */
                                     FS_ERR            *p_err);
+
+#if (FS_CFG_RD_ONLY_EN == DEF_DISABLED)
+void          FSVol_CacheWrBack    (CPU_CHAR          *name_vol,    /* Wr back aged dirty secs of a volume cache.       */
+                                    CPU_INT32U         age_max,
+                                    FS_ERR            *p_err);
+#endif
 #endif
 
 void          FSVol_Close          (CPU_CHAR          *name_vol,    /* Close (unmount) a volume.                        */
@@ -326,6 +358,12 @@ void          FSVol_FileRemove     (FS_VOL            *p_vol,        /* Remove f
 
 
                                                                     /* ----------------- LOCKED ACCESS ---------------- */
+void         *FSVol_MapLocked      (FS_VOL            *p_vol,       /* Get addr of volume sector(s) in memory.          */
+                                    FS_SEC_NBR         start,
+                                    FS_SEC_QTY         cnt,
+                                    FS_SEC_QTY        *p_map_cnt,
+                                    FS_ERR            *p_err);
+
 void          FSVol_RdLocked       (FS_VOL            *p_vol,       /* Read data from volume sector(s).                 */
                                     void              *p_dest,
                                     FS_SEC_NBR         start,
@@ -339,6 +377,21 @@ void          FSVol_RdLockedEx     (FS_VOL            *p_vol,       /* Read data
                                     FS_FLAGS           sec_type,
                                     FS_ERR            *p_err);
 
+#ifdef FS_CACHE_MODULE_PRESENT
+FS_SEC_QTY    FSVol_RdAheadLocked  (FS_VOL            *p_vol,       /* Read volume sector(s) ahead into cache.          */
+                                    FS_SEC_NBR         start,
+                                    FS_SEC_QTY         cnt,
+                                    FS_FLAGS           sec_type,
+                                    FS_ERR            *p_err);
+#endif
+
+void          FSVol_RdDirectLocked (FS_VOL            *p_vol,       /* Read volume sector(s), bypassing cache.          */
+                                    void              *p_dest,
+                                    FS_SEC_NBR         start,
+                                    FS_SEC_QTY         cnt,
+                                    FS_FLAGS           sec_type,
+                                    FS_ERR            *p_err);
+
 CPU_BOOLEAN   FSVol_RefreshLocked  (FS_VOL            *p_vol,       /* Refresh volume.                                  */
                                     FS_ERR            *p_err);
 
@@ -362,6 +415,13 @@ void          FSVol_WrLockedEx     (FS_VOL            *p_vol,       /* Write dat
                                     FS_SEC_QTY         cnt,
                                     FS_FLAGS           sec_type,
                                     FS_ERR            *p_err);
+
+void          FSVol_WrDirectLocked (FS_VOL            *p_vol,       /* Write volume sector(s), bypassing cache.         */
+                                    void              *p_src,
+                                    FS_SEC_NBR         start,
+                                    FS_SEC_QTY         cnt,
+                                    FS_FLAGS           sec_type,
+                                    FS_ERR            *p_err);
 #endif
 
 
@@ -69,6 +69,8 @@
 #include "shell.h"
 #include "sh_shell.h"
 
+#include "trace.h"
+
 
 
 /* Definitions for USART1_Send */
@@ -169,6 +171,7 @@ HAL_StatusTypeDef GPU_tx_and_rx_hand(void         *pbuf,
 
     for (sendCnt =0; sendCnt <= 3u; sendCnt ++) {
         
+        TRACE_EVT(TRACE_EVT_GPU_TX, sendCnt, buf_len);
         GPU_TFT_send_byte(pbuf, buf_len);           /// 发送数据
         
         Mem_Set((void     *)&Rx1_Buffer[0],                           /* Clr cur working dir path.                            */
@@ -180,13 +183,16 @@ HAL_StatusTypeDef GPU_tx_and_rx_hand(void         *pbuf,
 
         if ( osOK == stat) {        
             if (( Mem_Cmp(GPU_RETURN_OK, Rx1_Buffer, 2) == DEF_YES)) {
+                TRACE_EVT(TRACE_EVT_GPU_DONE, sendCnt, HAL_OK);
                 return ( HAL_OK );          // 正常退出.
              }
         } else {                        // 清除本次接收,再进行下一次接收
             HAL_UART_AbortReceive_IT(&GPU_TFT_USART_PORT);          // 接收未成功中止接收数据
         }
+        TRACE_EVT(TRACE_EVT_GPU_RETRY, sendCnt, stat);
         
     }
+    TRACE_EVT(TRACE_EVT_GPU_DONE, sendCnt, reStat);
     return( reStat );               // 错误 退出.
 }
 
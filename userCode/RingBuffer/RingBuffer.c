@@ -236,7 +236,7 @@ CPU_BOOLEAN RingBufWr(RING_BUF   *p_ring_buf,
   }
 
 //  CORE_EXIT_ATOMIC();
-  taskENTER_CRITICAL();
+  taskEXIT_CRITICAL();
 
   return (ret_val);
 }
@@ -269,7 +269,7 @@ CPU_BOOLEAN RingBufDataIsAvail(RING_BUF *p_ring_buf)
     ret_val = DEF_YES;
   }
 //  CORE_EXIT_ATOMIC();
-  taskENTER_CRITICAL();
+  taskEXIT_CRITICAL();
 
 
   return (ret_val);
@@ -309,7 +309,7 @@ CPU_BOOLEAN RingBufRdStart(RING_BUF *p_ring_buf)
 
 end:
 //  CORE_EXIT_ATOMIC();
-  taskENTER_CRITICAL();
+  taskEXIT_CRITICAL();
 
   return (ret_val);
 }
@@ -359,7 +359,7 @@ void *RingBufRd(RING_BUF   *p_ring_buf,
   ret_val = &p_ring_buf->StartPtr[p_ring_buf->RdIx];
 
 //  CORE_EXIT_ATOMIC();
-  taskENTER_CRITICAL();
+  taskEXIT_CRITICAL();
 
   return (ret_val);
 }
@@ -0,0 +1,690 @@
+/*
+*********************************************************************************************************
+*                                          TASK STATISTICS
+*
+* Filename : task_stat.c
+*
+* Note(s)  : (1) CPU usage is computed from the FreeRTOS run time counters, which are clocked by the
+*                Cortex-M DWT cycle counter (see 'TaskStat_TmrInit()').  Each sample records the run
+*                time consumed by every task since the previous sample; the CPU usage reported for a
+*                task is the sum of its last TASK_STAT_CFG_WIN_SAMPLE_NBR deltas divided by the sum of
+*                the total run time deltas over the same window.
+*
+*            (2) All arithmetic on run time counters is done on unsigned deltas, so wrap-around of the
+*                32-bit counters is harmless as long as the sampling period is shorter than one cycle
+*                counter period (~59 s @ 72 MHz).
+*
+*            (3) Samples are taken from the FreeRTOS timer service task; no dedicated task (& stack) is
+*                created.  'uxTaskGetSystemState()' suspends the scheduler while the task list is
+*                walked, so the sampling cost is bounded by TASK_STAT_CFG_TASK_NBR_MAX.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "task_stat.h"
+
+#include  "FreeRTOS.h"
+#include  "task.h"
+#include  "cmsis_os.h"
+#include  "main.h"
+
+#include  <lib_ascii.h>
+#include  <lib_mem.h>
+#include  <lib_str.h>
+
+#include  "shell.h"
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  TASK_STAT_IX_MASK                      (TASK_STAT_CFG_TASK_NBR_MAX - 1u)
+
+#define  TASK_STAT_NEW_LINE                     (CPU_CHAR *)"\r\n"
+#define  TASK_STAT_STR_HELP                     (CPU_CHAR *)"-h"
+#define  TASK_STAT_STR_RESET                    (CPU_CHAR *)"-r"
+
+#define  TASK_STAT_LINE_LEN_MAX                          80u
+
+
+/*
+*********************************************************************************************************
+*                                       ARGUMENT ERROR MESSAGES
+*********************************************************************************************************
+*/
+
+#define  TASK_STAT_ARG_ERR_STAT                 (CPU_CHAR *)"task_stat: usage: task_stat [-r]"
+
+
+/*
+*********************************************************************************************************
+*                                    COMMAND EXPLANATION MESSAGES
+*********************************************************************************************************
+*/
+
+#define  TASK_STAT_CMD_EXP_STAT                 (CPU_CHAR *)"                List per-task CPU usage, stack high-water mark & context switches.\r\n" \
+                                                            "                -r resets peak CPU usage & context switch counters."
+
+#define  TASK_STAT_HDR                          (CPU_CHAR *)"Name             Prio   CPU %   Max %  StkFree    CtxSw"
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL CONFIGURATION ERRORS
+*********************************************************************************************************
+*/
+
+#if     ((TASK_STAT_CFG_TASK_NBR_MAX & TASK_STAT_IX_MASK) != 0u)
+#error  "TASK_STAT_CFG_TASK_NBR_MAX  illegally #define'd in 'task_stat.h'  [MUST be a power of 2]"
+#endif
+
+#if     (TASK_STAT_CFG_TASK_NBR_MAX > 32u)
+#error  "TASK_STAT_CFG_TASK_NBR_MAX  illegally #define'd in 'task_stat.h'  [MUST be <= 32]"
+#endif
+
+#if     (TASK_STAT_CFG_WIN_SAMPLE_NBR < 1u)
+#error  "TASK_STAT_CFG_WIN_SAMPLE_NBR  illegally #define'd in 'task_stat.h'  [MUST be >= 1]"
+#endif
+
+#if     (configGENERATE_RUN_TIME_STATS != 1)
+#error  "configGENERATE_RUN_TIME_STATS  illegally #define'd in 'FreeRTOSConfig.h'  [MUST be 1]"
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+volatile  TASK_STAT_ENTRY  TaskStat_Tbl[TASK_STAT_CFG_TASK_NBR_MAX];
+volatile  uint32_t         TaskStat_TaskNbr;
+volatile  uint16_t         TaskStat_CPU_UsageTot;
+volatile  uint32_t         TaskStat_CtxSwCtrTot;
+volatile  uint32_t         TaskStat_SampleCtr;
+
+
+/*
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+static  TaskStatus_t       TaskStat_StatusTbl[TASK_STAT_CFG_TASK_NBR_MAX];
+static  volatile  uint32_t TaskStat_CtxSwTbl[TASK_STAT_CFG_TASK_NBR_MAX];        /* Updated from ctx switch hook.    */
+static  uint32_t           TaskStat_CtxSwBaseTbl[TASK_STAT_CFG_TASK_NBR_MAX];
+static  uint32_t           TaskStat_RunTimeTotPrev;
+static  uint32_t           TaskStat_RunTimeTotWin[TASK_STAT_CFG_WIN_SAMPLE_NBR];
+static  uint32_t           TaskStat_WinIx;
+
+static  osTimerId_t        TaskStat_TmrHandle;
+
+static  const  osTimerAttr_t  TaskStat_TmrAttr = {
+    .name = "TaskStat"
+};
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  void        TaskStat_Sample  (void             *p_arg);
+
+static  uint32_t    TaskStat_SlotFind(uint32_t          task_nbr);
+
+static  uint32_t    TaskStat_SlotGet (uint32_t          task_nbr);
+
+static  CPU_INT16S  TaskStat_Cmd     (CPU_INT16U        argc,
+                                      CPU_CHAR         *argv[],
+                                      SHELL_OUT_FNCT    out_fnct,
+                                      SHELL_CMD_PARAM  *pcmd_param);
+
+static  CPU_CHAR   *TaskStat_FmtUsage(CPU_INT16U        usage,
+                                      CPU_CHAR         *p_str);
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL TABLES
+*********************************************************************************************************
+*/
+
+static  SHELL_CMD  TaskStat_CmdTbl[] =
+{
+    {"task_stat", TaskStat_Cmd},
+    {0,           0           }
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           TaskStat_Init()
+*
+* Description : Initialize task statistics & start periodic sampling.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : MX_FREERTOS_Init().
+*
+* Note(s)     : (1) MUST be called before the scheduler is started so that the first sample covers the
+*                   whole run time of the application tasks.
+*********************************************************************************************************
+*/
+
+void  TaskStat_Init (void)
+{
+    Mem_Clr((void     *)TaskStat_Tbl,          sizeof(TaskStat_Tbl));
+    Mem_Clr((void     *)TaskStat_CtxSwTbl,     sizeof(TaskStat_CtxSwTbl));
+    Mem_Clr((void     *)TaskStat_CtxSwBaseTbl, sizeof(TaskStat_CtxSwBaseTbl));
+    Mem_Clr((void     *)TaskStat_RunTimeTotWin, sizeof(TaskStat_RunTimeTotWin));
+
+    TaskStat_TaskNbr        = 0u;
+    TaskStat_CPU_UsageTot   = 0u;
+    TaskStat_CtxSwCtrTot    = 0u;
+    TaskStat_SampleCtr      = 0u;
+    TaskStat_RunTimeTotPrev = 0u;
+    TaskStat_WinIx          = 0u;
+
+    TaskStat_TmrHandle = osTimerNew(TaskStat_Sample, osTimerPeriodic, DEF_NULL, &TaskStat_TmrAttr);
+    if (TaskStat_TmrHandle != DEF_NULL) {
+        (void)osTimerStart(TaskStat_TmrHandle, pdMS_TO_TICKS(TASK_STAT_CFG_SAMPLE_PERIOD_MS));
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TaskStat_CmdInit()
+*
+* Description : Add task statistics commands to uC/Shell.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_OK,   if task statistics commands were added.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) MUST be called after Shell_Init().
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TaskStat_CmdInit (void)
+{
+    SHELL_ERR    err;
+    CPU_BOOLEAN  ok;
+
+
+    Shell_CmdTblAdd((CPU_CHAR *)"task", TaskStat_CmdTbl, &err);
+
+    ok = (err == SHELL_ERR_NONE) ? DEF_OK : DEF_FAIL;
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TaskStat_Reset()
+*
+* Description : Reset peak CPU usage & context switch counters of all tasks.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TaskStat_Cmd(),
+*               Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TaskStat_Reset (void)
+{
+    uint32_t  ix;
+
+
+    vTaskSuspendAll();                                          /* Prevent sampling while resetting.                    */
+    for (ix = 0u; ix < TASK_STAT_CFG_TASK_NBR_MAX; ix++) {
+        TaskStat_Tbl[ix].CPU_UsageMax = TaskStat_Tbl[ix].CPU_Usage;
+        TaskStat_Tbl[ix].CtxSwCtr     = 0u;
+        TaskStat_CtxSwBaseTbl[ix]     = TaskStat_CtxSwTbl[ix];
+    }
+    TaskStat_CtxSwCtrTot = 0u;
+    (void)xTaskResumeAll();
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TaskStat_TmrInit()
+*
+* Description : Initialize & start the run time stats timer.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : portCONFIGURE_TIMER_FOR_RUN_TIME_STATS().
+*
+* Note(s)     : (1) The DWT cycle counter is used : it is free-running, needs no interrupt & gives the
+*                   best possible resolution for short task activations (e.g. UART ISR handoffs).
+*********************************************************************************************************
+*/
+
+void  TaskStat_TmrInit (void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;             /* En trace unit (see Note #1).                         */
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;                 /* Ctr is NOT rst : it may be shared w/ other users.    */
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TaskStat_TmrRd()
+*
+* Description : Get current run time stats timer count.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Cycle counter value.
+*
+* Caller(s)   : portGET_RUN_TIME_COUNTER_VALUE().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+uint32_t  TaskStat_TmrRd (void)
+{
+    return (DWT->CYCCNT);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TaskStat_CtxSwHook()
+*
+* Description : Count a context switch to a task.
+*
+* Argument(s) : task_nbr    FreeRTOS task number of the task being switched in.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : traceTASK_SWITCHED_IN().
+*
+* Note(s)     : (1) Called from the kernel's context switch path with interrupts masked; MUST remain
+*                   minimal.  The task's entry is normally found on the first probe.
+*
+*               (2) Switches to a task that has no entry yet (i.e. created since the last sample) are
+*                   only counted in the total.
+*********************************************************************************************************
+*/
+
+void  TaskStat_CtxSwHook (uint32_t  task_nbr)
+{
+    uint32_t  slot;
+
+
+    slot = TaskStat_SlotFind(task_nbr);
+    if (slot < TASK_STAT_CFG_TASK_NBR_MAX) {                    /* See Note #2.                                         */
+        TaskStat_CtxSwTbl[slot]++;
+    }
+    TaskStat_CtxSwCtrTot++;
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          TaskStat_Sample()
+*
+* Description : Take one statistics sample & update 'TaskStat_Tbl[]'.
+*
+* Argument(s) : p_arg       Argument passed by the timer (unused).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : FreeRTOS timer service task.
+*
+* Note(s)     : (1) If more than TASK_STAT_CFG_TASK_NBR_MAX tasks exist, 'uxTaskGetSystemState()'
+*                   returns 0 & the sample is discarded.
+*
+*               (2) Entries whose task was not reported by the sample belong to deleted tasks & are
+*                   released BEFORE new tasks are given an entry, so that a new task never fails to get
+*                   an entry while stale entries remain.  A new task starts from a zeroed entry.
+*********************************************************************************************************
+*/
+
+static  void  TaskStat_Sample (void  *p_arg)
+{
+    volatile  TASK_STAT_ENTRY  *p_entry;
+              TaskStatus_t     *p_status;
+              TaskHandle_t      idle_handle;
+              uint32_t          run_time_tot;
+              uint32_t          win_tot;
+              uint32_t          win_task;
+              uint32_t          delta;
+              uint32_t          task_qty;
+              uint32_t          seen;
+              uint32_t          slot;
+              uint32_t          ix;
+              uint32_t          win_ix;
+              uint32_t          jx;
+              CPU_INT64U        usage;
+              uint16_t          usage_idle;
+
+
+    (void)p_arg;
+
+    task_qty = (uint32_t)uxTaskGetSystemState(TaskStat_StatusTbl,
+                                              TASK_STAT_CFG_TASK_NBR_MAX,
+                                             &run_time_tot);
+    if (task_qty == 0u) {                                       /* See Note #1.                                         */
+        return;
+    }
+
+    win_ix                         = TaskStat_WinIx;
+    TaskStat_RunTimeTotWin[win_ix] = run_time_tot - TaskStat_RunTimeTotPrev;
+    TaskStat_RunTimeTotPrev        = run_time_tot;
+
+    win_tot = 0u;
+    for (ix = 0u; ix < TASK_STAT_CFG_WIN_SAMPLE_NBR; ix++) {
+        win_tot += TaskStat_RunTimeTotWin[ix];
+    }
+
+    seen = 0u;
+    for (ix = 0u; ix < task_qty; ix++) {                        /* Find entries of existing tasks ...                   */
+        slot = TaskStat_SlotFind((uint32_t)TaskStat_StatusTbl[ix].xTaskNumber);
+        if (slot < TASK_STAT_CFG_TASK_NBR_MAX) {
+            seen |= DEF_BIT(slot);
+        }
+    }
+
+    for (ix = 0u; ix < TASK_STAT_CFG_TASK_NBR_MAX; ix++) {      /* ... & release entries of deleted tasks (Note #2).    */
+        if (DEF_BIT_IS_CLR(seen, DEF_BIT(ix)) == DEF_YES) {
+            TaskStat_Tbl[ix].Used = DEF_NO;
+        }
+    }
+
+    idle_handle = xTaskGetIdleTaskHandle();
+    usage_idle  = 0u;
+
+    for (ix = 0u; ix < task_qty; ix++) {
+        p_status = &TaskStat_StatusTbl[ix];
+        slot     = TaskStat_SlotFind((uint32_t)p_status->xTaskNumber);
+        if (slot >= TASK_STAT_CFG_TASK_NBR_MAX) {               /* New task (see Note #2).                              */
+            slot    = TaskStat_SlotGet((uint32_t)p_status->xTaskNumber);
+            p_entry = &TaskStat_Tbl[slot];
+            Mem_Clr((void *)p_entry, sizeof(TASK_STAT_ENTRY));
+            Str_Copy_N((CPU_CHAR *)p_entry->Name,
+                       (CPU_CHAR *)p_status->pcTaskName,
+                                   sizeof(p_entry->Name) - 1u);
+            p_entry->TaskNbr            = (uint32_t)p_status->xTaskNumber;
+            TaskStat_CtxSwBaseTbl[slot] = TaskStat_CtxSwTbl[slot];
+            p_entry->Used               = DEF_YES;              /* Set last : entry is now visible to ctx sw hook.      */
+        }
+        p_entry = &TaskStat_Tbl[slot];
+
+        delta                        = p_status->ulRunTimeCounter - p_entry->RunTimePrev;
+        p_entry->RunTimePrev         = p_status->ulRunTimeCounter;
+        p_entry->RunTimeWin[win_ix]  = delta;
+
+        win_task = 0u;
+        for (jx = 0u; jx < TASK_STAT_CFG_WIN_SAMPLE_NBR; jx++) {
+            win_task += p_entry->RunTimeWin[jx];
+        }
+
+        usage = 0u;
+        if (win_tot > 0u) {
+            usage = ((CPU_INT64U)win_task * TASK_STAT_CPU_USAGE_FULL) / win_tot;
+            usage = DEF_MIN(usage, TASK_STAT_CPU_USAGE_FULL);
+        }
+
+        p_entry->CPU_Usage    = (uint16_t)usage;
+        p_entry->CPU_UsageMax = DEF_MAX(p_entry->CPU_UsageMax, p_entry->CPU_Usage);
+        p_entry->Prio         = (uint32_t)p_status->uxCurrentPriority;
+        p_entry->StkFreeMin   = (uint32_t)p_status->usStackHighWaterMark * sizeof(StackType_t);
+        p_entry->CtxSwCtr     = TaskStat_CtxSwTbl[slot] - TaskStat_CtxSwBaseTbl[slot];
+
+        if (p_status->xHandle == idle_handle) {
+            usage_idle = p_entry->CPU_Usage;
+        }
+    }
+
+    TaskStat_CPU_UsageTot = TASK_STAT_CPU_USAGE_FULL - usage_idle;
+    TaskStat_TaskNbr      = task_qty;
+    TaskStat_WinIx        = (win_ix + 1u) % TASK_STAT_CFG_WIN_SAMPLE_NBR;
+    TaskStat_SampleCtr++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TaskStat_SlotFind()
+*
+* Description : Find the 'TaskStat_Tbl[]' entry of a task.
+*
+* Argument(s) : task_nbr    FreeRTOS task number.
+*
+* Return(s)   : Index of the task's entry,   if found.
+*               TASK_STAT_CFG_TASK_NBR_MAX, otherwise.
+*
+* Caller(s)   : TaskStat_CtxSwHook(),
+*               TaskStat_Sample().
+*
+* Note(s)     : (1) Entries are placed by linear probing from the task nbr's home slot (see
+*                   'TaskStat_SlotGet()').  Since released entries are NOT tombstoned, the probe cannot
+*                   stop on a free entry & visits the whole table when the task has no entry.
+*********************************************************************************************************
+*/
+
+static  uint32_t  TaskStat_SlotFind (uint32_t  task_nbr)
+{
+    uint32_t  slot;
+    uint32_t  ix;
+
+
+    slot = task_nbr & TASK_STAT_IX_MASK;
+    for (ix = 0u; ix < TASK_STAT_CFG_TASK_NBR_MAX; ix++) {      /* See Note #1.                                         */
+        if ((TaskStat_Tbl[slot].Used    == DEF_YES) &&
+            (TaskStat_Tbl[slot].TaskNbr == task_nbr)) {
+            return (slot);
+        }
+        slot = (slot + 1u) & TASK_STAT_IX_MASK;
+    }
+
+    return (TASK_STAT_CFG_TASK_NBR_MAX);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TaskStat_SlotGet()
+*
+* Description : Get a free 'TaskStat_Tbl[]' entry for a new task.
+*
+* Argument(s) : task_nbr    FreeRTOS task number.
+*
+* Return(s)   : Index of the first free entry at or after the task nbr's home slot.
+*
+* Caller(s)   : TaskStat_Sample().
+*
+* Note(s)     : (1) A free entry always exists : at most TASK_STAT_CFG_TASK_NBR_MAX tasks are reported
+*                   by a sample & entries of deleted tasks are released before new tasks get an entry.
+*********************************************************************************************************
+*/
+
+static  uint32_t  TaskStat_SlotGet (uint32_t  task_nbr)
+{
+    uint32_t  slot;
+    uint32_t  ix;
+
+
+    slot = task_nbr & TASK_STAT_IX_MASK;
+    for (ix = 0u; ix < TASK_STAT_CFG_TASK_NBR_MAX; ix++) {      /* See Note #1.                                         */
+        if (TaskStat_Tbl[slot].Used == DEF_NO) {
+            break;
+        }
+        slot = (slot + 1u) & TASK_STAT_IX_MASK;
+    }
+
+    return (slot);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TaskStat_Cmd()
+*
+* Description : Output per-task statistics.
+*
+* Argument(s) : argc            The number of arguments.
+*
+*               argv            Array of arguments.
+*
+*               out_fnct        The output function.
+*
+*               pcmd_param      Pointer to the command parameters.
+*
+* Return(s)   : SHELL_EXEC_ERR, if an error is encountered.
+*               SHELL_ERR_NONE, otherwise.
+*
+* Caller(s)   : Shell, in response to command execution.
+*
+* Note(s)     : (1) The table is copied with the scheduler suspended so that each line is consistent
+*                   with a single sample.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16S  TaskStat_Cmd (CPU_INT16U        argc,
+                                  CPU_CHAR         *argv[],
+                                  SHELL_OUT_FNCT    out_fnct,
+                                  SHELL_CMD_PARAM  *pcmd_param)
+{
+    TASK_STAT_ENTRY  entry;
+    CPU_CHAR         line[TASK_STAT_LINE_LEN_MAX];
+    CPU_CHAR        *p_str;
+    CPU_SIZE_T       len;
+    CPU_INT16U       usage_tot;
+    uint32_t         ix;
+
+
+    if (argc == 2u) {
+        if (Str_Cmp(argv[1], TASK_STAT_STR_HELP) == 0) {
+            (void)out_fnct(TASK_STAT_ARG_ERR_STAT, (CPU_INT16U)Str_Len(TASK_STAT_ARG_ERR_STAT), pcmd_param->pout_opt);
+            (void)out_fnct(TASK_STAT_NEW_LINE,     2u,                                           pcmd_param->pout_opt);
+            (void)out_fnct(TASK_STAT_CMD_EXP_STAT, (CPU_INT16U)Str_Len(TASK_STAT_CMD_EXP_STAT), pcmd_param->pout_opt);
+            (void)out_fnct(TASK_STAT_NEW_LINE,     2u,                                           pcmd_param->pout_opt);
+            return (SHELL_ERR_NONE);
+        }
+        if (Str_Cmp(argv[1], TASK_STAT_STR_RESET) == 0) {
+            TaskStat_Reset();
+            return (SHELL_ERR_NONE);
+        }
+    }
+
+    if (argc != 1u) {
+        (void)out_fnct(TASK_STAT_ARG_ERR_STAT, (CPU_INT16U)Str_Len(TASK_STAT_ARG_ERR_STAT), pcmd_param->pout_opt);
+        (void)out_fnct(TASK_STAT_NEW_LINE,     2u,                                           pcmd_param->pout_opt);
+        return (SHELL_EXEC_ERR);
+    }
+
+    (void)out_fnct(TASK_STAT_HDR,      (CPU_INT16U)Str_Len(TASK_STAT_HDR), pcmd_param->pout_opt);
+    (void)out_fnct(TASK_STAT_NEW_LINE, 2u,                                 pcmd_param->pout_opt);
+
+    for (ix = 0u; ix < TASK_STAT_CFG_TASK_NBR_MAX; ix++) {
+        vTaskSuspendAll();                                      /* See Note #1.                                         */
+        Mem_Copy((void *)&entry, (void *)&TaskStat_Tbl[ix], sizeof(entry));
+        (void)xTaskResumeAll();
+
+        if (entry.Used == DEF_NO) {
+            continue;
+        }
+
+        Mem_Set((void *)line, (CPU_INT08U)ASCII_CHAR_SPACE, sizeof(line));
+        len = Str_Len_N(entry.Name, sizeof(entry.Name));
+        Mem_Copy((void *)line, (void *)entry.Name, len);        /* Name, left aligned in 16 chars.                      */
+
+        p_str = &line[16];
+        (void)Str_FmtNbr_Int32U(entry.Prio, 5u, DEF_NBR_BASE_DEC, ASCII_CHAR_SPACE, DEF_NO, DEF_NO, p_str);
+        p_str += 6;
+        (void)TaskStat_FmtUsage(entry.CPU_Usage,    p_str);
+        p_str += 8;
+        (void)TaskStat_FmtUsage(entry.CPU_UsageMax, p_str);
+        p_str += 8;
+        (void)Str_FmtNbr_Int32U(entry.StkFreeMin, 8u, DEF_NBR_BASE_DEC, ASCII_CHAR_SPACE, DEF_NO, DEF_NO, p_str);
+        p_str += 9;
+        (void)Str_FmtNbr_Int32U(entry.CtxSwCtr,   8u, DEF_NBR_BASE_DEC, ASCII_CHAR_SPACE, DEF_NO, DEF_YES, p_str);
+
+        (void)out_fnct(line,               (CPU_INT16U)Str_Len(line), pcmd_param->pout_opt);
+        (void)out_fnct(TASK_STAT_NEW_LINE, 2u,                        pcmd_param->pout_opt);
+    }
+
+    usage_tot = TaskStat_CPU_UsageTot;
+    Str_Copy(line, (CPU_CHAR *)"CPU total     :");
+    (void)TaskStat_FmtUsage(usage_tot, &line[15]);
+    line[22] = ASCII_CHAR_SPACE;
+    line[23] = ASCII_CHAR_PERCENTAGE_SIGN;
+    line[24] = ASCII_CHAR_NULL;
+    (void)out_fnct(line,               (CPU_INT16U)Str_Len(line), pcmd_param->pout_opt);
+    (void)out_fnct(TASK_STAT_NEW_LINE, 2u,                        pcmd_param->pout_opt);
+
+    return (SHELL_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TaskStat_FmtUsage()
+*
+* Description : Format a CPU usage as 'ddd.dd', right aligned in 7 characters, without NULL terminator.
+*
+* Argument(s) : usage       CPU usage, in 0.01 %.
+*
+*               p_str       Pointer to string buffer (at least 7 characters).
+*
+* Return(s)   : Pointer to formatted string.
+*
+* Caller(s)   : TaskStat_Cmd().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR  *TaskStat_FmtUsage (CPU_INT16U   usage,
+                                      CPU_CHAR    *p_str)
+{
+    (void)Str_FmtNbr_Int32U((CPU_INT32U)(usage / 100u), 4u, DEF_NBR_BASE_DEC, ASCII_CHAR_SPACE, DEF_NO, DEF_NO, &p_str[0]);
+    p_str[4] = ASCII_CHAR_FULL_STOP;
+    (void)Str_FmtNbr_Int32U((CPU_INT32U)(usage % 100u), 2u, DEF_NBR_BASE_DEC, ASCII_CHAR_DIGIT_ZERO, DEF_NO, DEF_NO, &p_str[5]);
+
+    return (p_str);
+}
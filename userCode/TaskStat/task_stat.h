@@ -0,0 +1,132 @@
+/*
+*********************************************************************************************************
+*                                          TASK STATISTICS
+*
+* Filename : task_stat.h
+*
+* Note(s)  : (1) Per-task CPU usage, stack high-water mark & context switch profiling for the FreeRTOS
+*                tasks created in 'freertos.c'.  Statistics are sampled periodically from a software
+*                timer & published in 'TaskStat_Tbl[]', which is read directly by uC/Probe.
+*
+*            (2) The following MUST be configured in 'FreeRTOSConfig.h' :
+*
+*                    configGENERATE_RUN_TIME_STATS           1
+*                    configUSE_TRACE_FACILITY                1
+*                    INCLUDE_uxTaskGetStackHighWaterMark     1
+*                    INCLUDE_xTaskGetIdleTaskHandle          1
+*                    portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    TaskStat_TmrInit()
+*                    portGET_RUN_TIME_COUNTER_VALUE()            TaskStat_TmrRd()
+*                    traceTASK_SWITCHED_IN()                     TaskStat_CtxSwHook(pxCurrentTCB->uxTCBNumber)
+*********************************************************************************************************
+*/
+
+#ifndef  TASK_STAT_H
+#define  TASK_STAT_H
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <stdint.h>
+#include  "FreeRTOS.h"
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                        CONFIGURATION DEFINES
+*********************************************************************************************************
+*/
+
+#ifndef  TASK_STAT_CFG_TASK_NBR_MAX
+#define  TASK_STAT_CFG_TASK_NBR_MAX                        16u  /* Max nbr of tasks tracked (power of 2, <= 32).        */
+#endif
+
+#ifndef  TASK_STAT_CFG_SAMPLE_PERIOD_MS
+#define  TASK_STAT_CFG_SAMPLE_PERIOD_MS                   250u  /* Sampling period, in ms.                              */
+#endif
+
+#ifndef  TASK_STAT_CFG_WIN_SAMPLE_NBR
+#define  TASK_STAT_CFG_WIN_SAMPLE_NBR                       8u  /* Nbr of samples in CPU usage sliding window.          */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  TASK_STAT_CPU_USAGE_FULL                       10000u  /* CPU usage is expressed in 0.01 % units.              */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  task_stat_entry {
+    char      Name[configMAX_TASK_NAME_LEN];                    /* Task name.                                           */
+    uint32_t  TaskNbr;                                          /* FreeRTOS task nbr (TCB nbr).                         */
+    uint32_t  Prio;                                             /* Cur prio.                                            */
+    uint32_t  StkFreeMin;                                       /* Stk high-water mark: min free stk ever, in bytes.    */
+    uint32_t  CtxSwCtr;                                         /* Nbr of times task was switched in.                   */
+    uint16_t  CPU_Usage;                                        /* CPU usage over sliding window, in 0.01 %.            */
+    uint16_t  CPU_UsageMax;                                     /* Peak CPU usage over sliding window, in 0.01 %.       */
+    uint32_t  RunTimePrev;                                      /* Run time ctr at prev sample.                         */
+    uint32_t  RunTimeWin[TASK_STAT_CFG_WIN_SAMPLE_NBR];         /* Run time deltas of samples in window.                */
+    uint8_t   Used;                                             /* Entry in use.                                        */
+} TASK_STAT_ENTRY;
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*
+* Note(s) : (1) These variables are intentionally global so uC/Probe can resolve them from the ELF/map
+*               file.
+*
+*           (2) A task's entry in 'TaskStat_Tbl[]' is found by linear probing from its FreeRTOS task nbr,
+*               modulo 'TASK_STAT_CFG_TASK_NBR_MAX'.  Check 'TaskNbr' rather than the index to identify a
+*               task.
+*********************************************************************************************************
+*/
+
+extern  volatile  TASK_STAT_ENTRY  TaskStat_Tbl[TASK_STAT_CFG_TASK_NBR_MAX];
+extern  volatile  uint32_t         TaskStat_TaskNbr;            /* Nbr of entries used in 'TaskStat_Tbl[]'.             */
+extern  volatile  uint16_t         TaskStat_CPU_UsageTot;       /* Total non-idle CPU usage, in 0.01 %.                 */
+extern  volatile  uint32_t         TaskStat_CtxSwCtrTot;        /* Total nbr of ctx switches.                           */
+extern  volatile  uint32_t         TaskStat_SampleCtr;          /* Nbr of samples taken.                                */
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         TaskStat_Init     (void);
+
+CPU_BOOLEAN  TaskStat_CmdInit  (void);
+
+void         TaskStat_Reset    (void);
+
+void         TaskStat_TmrInit  (void);                          /* Run time stats hooks (see Note #2).                  */
+
+uint32_t     TaskStat_TmrRd    (void);
+
+void         TaskStat_CtxSwHook(uint32_t  task_nbr);
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""
+Convert an event trace recorded by userCode/Trace/trace.c to Chrome trace
+(chrome://tracing) / Perfetto JSON.
+
+Input is either a trace file written by Trace_FileSave() (starts with a
+TRACE_FILE_HDR) or, with --raw, a bare dump of TRACE_REC records such as the
+bytes returned by Trace_Rd() over a serial/probe link.
+
+    trace2json.py trace.bin -o trace.json
+    trace2json.py --raw --freq 72000000 dump.bin -o trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_FILE_MAGIC = 0x45435254
+TRACE_FILE_VER = 1
+
+HDR_FMT = "<IHHIHH"                 # TRACE_FILE_HDR.
+REC_FMT = "<IBBHI"                  # TRACE_REC.
+REC_SIZE = struct.calcsize(REC_FMT)
+
+EVT_TASK_SWITCHED_IN = 1
+EVT_ISR_ENTER = 2
+EVT_ISR_EXIT = 3
+EVT_Q_SEND = 4
+EVT_Q_SEND_ISR = 5
+EVT_Q_SEND_FAIL = 6
+EVT_Q_RECV = 7
+EVT_Q_RECV_ISR = 8
+EVT_Q_RECV_BLOCK = 9
+EVT_Q_RECV_FAIL = 10
+EVT_GPU_TX = 11
+EVT_GPU_RETRY = 12
+EVT_GPU_DONE = 13
+EVT_FS_DEV_RD_START = 14
+EVT_FS_DEV_RD_END = 15
+EVT_FS_DEV_WR_START = 16
+EVT_FS_DEV_WR_END = 17
+EVT_USER = 128
+
+NAME_TYPE_TASK = 1
+NAME_TYPE_OBJ = 2
+
+Q_EVT_NAMES = {
+    EVT_Q_SEND: "give",
+    EVT_Q_SEND_ISR: "give (ISR)",
+    EVT_Q_SEND_FAIL: "give failed",
+    EVT_Q_RECV: "take",
+    EVT_Q_RECV_ISR: "take (ISR)",
+    EVT_Q_RECV_BLOCK: "take blocked",
+    EVT_Q_RECV_FAIL: "take timeout",
+}
+
+Q_TYPE_NAMES = {0: "queue", 1: "mutex", 2: "counting sem", 3: "binary sem", 4: "recursive mutex"}
+
+PID = 1
+TID_ISR_BASE = 1000                 # ISR tracks: TID_ISR_BASE + IRQ nbr.
+TID_FS_DEV = 2000
+
+
+def parse(data, raw, freq):
+    """Return (ts_freq, names{(type, id): name}, records[(ts, id, ctx, arg16, arg32)])."""
+    names = {}
+    off = 0
+    if not raw:
+        magic, ver, rec_size, freq, name_nbr, name_size = struct.unpack_from(HDR_FMT, data, 0)
+        if magic != TRACE_FILE_MAGIC:
+            sys.exit("not a trace file (bad magic); use --raw for record dumps")
+        if ver != TRACE_FILE_VER or rec_size != REC_SIZE:
+            sys.exit("unsupported trace file version %u / record size %u" % (ver, rec_size))
+        off = struct.calcsize(HDR_FMT)
+        for _ in range(name_nbr):
+            ident, typ = struct.unpack_from("<IB", data, off)
+            name = data[off + 5:off + name_size].split(b"\0", 1)[0].decode("ascii", "replace")
+            if typ != 0:
+                names[(typ, ident)] = name
+            off += name_size
+    if not freq:
+        sys.exit("timestamp frequency unknown; pass --freq")
+
+    recs = []
+    for pos in range(off, len(data) - REC_SIZE + 1, REC_SIZE):
+        rec = struct.unpack_from(REC_FMT, data, pos)
+        if rec[1] != 0:
+            recs.append(rec)
+    return freq, names, recs
+
+
+def unwrap(recs):
+    """Extend 32-bit cycle counter timestamps to a monotonic 64-bit count."""
+    out = []
+    hi = 0
+    prev = None
+    for ts, evt, ctx, arg16, arg32 in recs:
+        if prev is not None and ts < prev:
+            hi += 1 << 32
+        prev = ts
+        out.append((hi + ts, evt, ctx, arg16, arg32))
+    return out
+
+
+def convert(freq, names, recs):
+    us_per_cnt = 1e6 / freq
+    events = []
+    task_name = lambda nbr: names.get((NAME_TYPE_TASK, nbr), "task %u" % nbr)
+    obj_name = lambda addr: names.get((NAME_TYPE_OBJ, addr), "0x%08X" % addr)
+
+    def meta(tid, name, sort):
+        events.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_name", "args": {"name": name}})
+        events.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_sort_index", "args": {"sort_index": sort}})
+
+    seen_tids = set()
+
+    def track(tid, name, sort):
+        if tid not in seen_tids:
+            seen_tids.add(tid)
+            meta(tid, name, sort)
+
+    running = None                  # (task nbr, start ts).
+    isr_open = {}
+    for ts, evt, ctx, arg16, arg32 in recs:
+        t = ts * us_per_cnt
+        if evt == EVT_TASK_SWITCHED_IN:
+            if running is not None:
+                nbr, start = running
+                track(nbr, task_name(nbr), nbr)
+                events.append({"ph": "X", "pid": PID, "tid": nbr, "name": task_name(nbr),
+                               "ts": start, "dur": t - start})
+            running = (arg16, t)
+
+        elif evt in (EVT_ISR_ENTER, EVT_ISR_EXIT):
+            tid = TID_ISR_BASE + arg16
+            track(tid, "IRQ %u" % arg16, tid)
+            if evt == EVT_ISR_ENTER:
+                isr_open[arg16] = t
+            elif arg16 in isr_open:
+                start = isr_open.pop(arg16)
+                events.append({"ph": "X", "pid": PID, "tid": tid, "name": "IRQ %u" % arg16,
+                               "ts": start, "dur": t - start})
+
+        elif evt in Q_EVT_NAMES:
+            track(ctx, task_name(ctx), ctx)
+            events.append({"ph": "i", "s": "t", "pid": PID, "tid": ctx, "ts": t,
+                           "name": "%s %s" % (obj_name(arg32), Q_EVT_NAMES[evt]),
+                           "args": {"type": Q_TYPE_NAMES.get(arg16, str(arg16))}})
+
+        elif evt in (EVT_GPU_TX, EVT_GPU_RETRY, EVT_GPU_DONE):
+            track(ctx, task_name(ctx), ctx)
+            label = {EVT_GPU_TX: "GPU tx", EVT_GPU_RETRY: "GPU retry", EVT_GPU_DONE: "GPU done"}[evt]
+            key = {EVT_GPU_TX: "len", EVT_GPU_RETRY: "os_status", EVT_GPU_DONE: "hal_status"}[evt]
+            events.append({"ph": "i", "s": "t", "pid": PID, "tid": ctx, "ts": t, "name": label,
+                           "args": {"attempt": arg16, key: arg32}})
+
+        elif evt in (EVT_FS_DEV_RD_START, EVT_FS_DEV_WR_START):
+            track(TID_FS_DEV, "FS dev I/O", TID_FS_DEV)
+            events.append({"ph": "B", "pid": PID, "tid": TID_FS_DEV, "ts": t,
+                           "name": "rd" if evt == EVT_FS_DEV_RD_START else "wr",
+                           "args": {"start": arg32, "cnt": arg16, "task": task_name(ctx)}})
+
+        elif evt in (EVT_FS_DEV_RD_END, EVT_FS_DEV_WR_END):
+            track(TID_FS_DEV, "FS dev I/O", TID_FS_DEV)
+            events.append({"ph": "E", "pid": PID, "tid": TID_FS_DEV, "ts": t, "args": {"err": arg32}})
+
+        else:
+            track(ctx, task_name(ctx), ctx)
+            events.append({"ph": "i", "s": "t", "pid": PID, "tid": ctx, "ts": t, "name": "evt %u" % evt,
+                           "args": {"arg16": arg16, "arg32": arg32}})
+
+    if running is not None and recs:
+        nbr, start = running
+        track(nbr, task_name(nbr), nbr)
+        events.append({"ph": "X", "pid": PID, "tid": nbr, "name": task_name(nbr),
+                       "ts": start, "dur": recs[-1][0] * us_per_cnt - start})
+
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input", help="trace file or raw record dump")
+    ap.add_argument("-o", "--output", help="output JSON file (default: stdout)")
+    ap.add_argument("--raw", action="store_true", help="input is a bare TRACE_REC dump (no header)")
+    ap.add_argument("--freq", type=int, default=0, help="timestamp frequency in Hz (required with --raw)")
+    args = ap.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    freq, names, recs = parse(data, args.raw, args.freq)
+    doc = convert(freq, names, unwrap(recs))
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    json.dump(doc, out)
+    if args.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,775 @@
+/*
+*********************************************************************************************************
+*                                           EVENT TRACE RECORDER
+*
+* Filename : trace.c
+*
+* Note(s)  : (1) A record is written in three steps :
+*
+*                (a) A slot is reserved by incrementing the ring's head index with LDREX/STREX.  The
+*                    timestamp is read between the exclusive load & store, so that slots are reserved
+*                    in timestamp order even when an ISR preempts a task inside Trace_Evt() (exception
+*                    entry clears the exclusive monitor & forces the task to retry).
+*
+*                (b) The record payload is written.
+*
+*                (c) The event id is written last, after a memory barrier, to commit the record.
+*
+*                The drain side (Trace_Rd()) stops at the first uncommitted record & clears the id of
+*                each record it consumes.  There MUST be a single drain context.
+*
+*            (2) Records overwritten by writers while the ring is full are counted in 'LostCtr'.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  "trace.h"
+
+#include  "FreeRTOS.h"
+#include  "task.h"
+#include  "main.h"
+
+#include  <lib_ascii.h>
+#include  <lib_mem.h>
+#include  <lib_str.h>
+
+#include  "shell.h"
+
+#if (TRACE_CFG_FS_EN == DEF_ENABLED)
+#include  <fs_file.h>
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*/
+
+#define  TRACE_IX_MASK                          (TRACE_CFG_REC_NBR - 1u)
+
+#define  TRACE_RD_CHUNK_REC_NBR                          16u    /* Nbr of recs drained per file wr.                     */
+
+#define  TRACE_NEW_LINE                         (CPU_CHAR *)"\r\n"
+#define  TRACE_STR_HELP                         (CPU_CHAR *)"-h"
+#define  TRACE_STR_ON                           (CPU_CHAR *)"on"
+#define  TRACE_STR_OFF                          (CPU_CHAR *)"off"
+#define  TRACE_STR_CLR                          (CPU_CHAR *)"clr"
+
+
+/*
+*********************************************************************************************************
+*                                       ARGUMENT ERROR MESSAGES
+*********************************************************************************************************
+*/
+
+#define  TRACE_ARG_ERR_CTRL                     (CPU_CHAR *)"trace_ctrl: usage: trace_ctrl [on|off|clr]"
+#define  TRACE_ARG_ERR_SAVE                     (CPU_CHAR *)"trace_save: usage: trace_save [file]"
+
+
+/*
+*********************************************************************************************************
+*                                    COMMAND EXPLANATION MESSAGES
+*********************************************************************************************************
+*/
+
+#define  TRACE_CMD_EXP_CTRL                     (CPU_CHAR *)"                Start, stop or clear the event trace recorder; show ring state."
+#define  TRACE_CMD_EXP_SAVE                     (CPU_CHAR *)"                Drain the event trace to a file."
+
+#define  TRACE_MSG_FAIL                         (CPU_CHAR *)"Failed."
+
+
+/*
+*********************************************************************************************************
+*                                        LOCAL CONFIGURATION ERRORS
+*********************************************************************************************************
+*/
+
+#if     ((TRACE_CFG_REC_NBR & TRACE_IX_MASK) != 0u)
+#error  "TRACE_CFG_REC_NBR  illegally #define'd in 'trace.h'  [MUST be a power of 2]"
+#endif
+
+#if     (TRACE_CFG_CORE_NBR < 1u)
+#error  "TRACE_CFG_CORE_NBR  illegally #define'd in 'trace.h'  [MUST be >= 1]"
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+TRACE_RING          Trace_RingTbl[TRACE_CFG_CORE_NBR];
+TRACE_NAME          Trace_NameTbl[TRACE_CFG_NAME_NBR];
+volatile  uint8_t   Trace_En;
+volatile  uint8_t   Trace_CtxCur;
+
+
+/*
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+static  uint32_t    Trace_IxReserve(TRACE_RING       *p_ring,
+                                    uint32_t         *p_ts);
+
+static  CPU_INT16S  Trace_CmdCtrl  (CPU_INT16U        argc,
+                                    CPU_CHAR         *argv[],
+                                    SHELL_OUT_FNCT    out_fnct,
+                                    SHELL_CMD_PARAM  *pcmd_param);
+
+#if (TRACE_CFG_FS_EN == DEF_ENABLED)
+static  CPU_INT16S  Trace_CmdSave  (CPU_INT16U        argc,
+                                    CPU_CHAR         *argv[],
+                                    SHELL_OUT_FNCT    out_fnct,
+                                    SHELL_CMD_PARAM  *pcmd_param);
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            LOCAL TABLES
+*********************************************************************************************************
+*/
+
+static  SHELL_CMD  Trace_CmdTbl[] =
+{
+    {"trace_ctrl", Trace_CmdCtrl},
+#if (TRACE_CFG_FS_EN == DEF_ENABLED)
+    {"trace_save", Trace_CmdSave},
+#endif
+    {0,            0            }
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                             Trace_Init()
+*
+* Description : Initialize the event trace recorder & start recording.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : MX_FREERTOS_Init().
+*
+* Note(s)     : (1) Names registered by the trace macros before this call (e.g. tasks created earlier)
+*                   are preserved.
+*********************************************************************************************************
+*/
+
+void  Trace_Init (void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;             /* En DWT cycle ctr used for timestamps.                */
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    Trace_Clr();
+    Trace_Start();
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Trace_Start() / Trace_Stop()
+*
+* Description : Start/stop recording events.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Trace_Init(),
+*               Trace_CmdCtrl(),
+*               Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Trace_Start (void)
+{
+    Trace_En = DEF_YES;
+}
+
+
+void  Trace_Stop (void)
+{
+    Trace_En = DEF_NO;
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Trace_Clr()
+*
+* Description : Discard all recorded events.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Trace_Init(),
+*               Trace_CmdCtrl(),
+*               Application.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Trace_Clr (void)
+{
+    TRACE_RING   *p_ring;
+    CPU_INT08U    core;
+    CPU_SR_ALLOC();
+
+
+    for (core = 0u; core < TRACE_CFG_CORE_NBR; core++) {
+        p_ring = &Trace_RingTbl[core];
+        CPU_CRITICAL_ENTER();
+        Mem_Clr((void *)p_ring->RecTbl, sizeof(p_ring->RecTbl));
+        p_ring->TailIx  = p_ring->HeadIx;
+        p_ring->LostCtr = 0u;
+        CPU_CRITICAL_EXIT();
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Trace_Evt()
+*
+* Description : Record an event.
+*
+* Argument(s) : id          Event id (see 'trace.h  EVENT IDS').
+*
+*               arg16       Event-specific 16-bit argument.
+*
+*               arg32       Event-specific 32-bit argument.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TRACE_EVT(),
+*               Application.
+*
+* Note(s)     : (1) May be called from any task or ISR; see 'trace.c  Note #1'.
+*********************************************************************************************************
+*/
+
+void  Trace_Evt (uint8_t   id,
+                 uint16_t  arg16,
+                 uint32_t  arg32)
+{
+    TRACE_RING  *p_ring;
+    TRACE_REC   *p_rec;
+    uint32_t     ix;
+    uint32_t     ts;
+
+
+    if (id == TRACE_EVT_NONE) {
+        return;
+    }
+
+    p_ring = &Trace_RingTbl[TRACE_CORE_ID_GET()];
+    ix     =  Trace_IxReserve(p_ring, &ts);                     /* See Note #1a.                                        */
+    p_rec  = &p_ring->RecTbl[ix & TRACE_IX_MASK];
+
+    p_rec->Id    = TRACE_EVT_NONE;                              /* See Note #1b.                                        */
+    p_rec->TS    = ts;
+    p_rec->Ctx   = Trace_CtxCur;
+    p_rec->Arg16 = arg16;
+    p_rec->Arg32 = arg32;
+    __DMB();
+    p_rec->Id    = id;                                          /* See Note #1c.                                        */
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Trace_NameAdd()
+*
+* Description : Register the name of a task or kernel object so the host tool can label its events.
+*
+* Argument(s) : type        Name type :
+*
+*                               TRACE_NAME_TYPE_TASK    'id' is a task nbr.
+*                               TRACE_NAME_TYPE_OBJ     'id' is an object address.
+*
+*               id          Task nbr or object address.
+*
+*               p_name      Pointer to name; truncated to TRACE_CFG_NAME_LEN - 1 characters.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : traceTASK_CREATE(),
+*               traceQUEUE_REGISTRY_ADD(),
+*               Application.
+*
+* Note(s)     : (1) An existing entry with the same type & id is renamed.  Names are dropped silently
+*                   once the table is full.
+*********************************************************************************************************
+*/
+
+void  Trace_NameAdd (uint8_t       type,
+                     uint32_t      id,
+                     const  char  *p_name)
+{
+    TRACE_NAME  *p_entry;
+    TRACE_NAME  *p_free;
+    CPU_INT16U   ix;
+    CPU_SR_ALLOC();
+
+
+    if (p_name == DEF_NULL) {
+        return;
+    }
+
+    p_free = DEF_NULL;
+    CPU_CRITICAL_ENTER();
+    for (ix = 0u; ix < TRACE_CFG_NAME_NBR; ix++) {
+        p_entry = &Trace_NameTbl[ix];
+        if ((p_entry->Type == type) &&
+            (p_entry->Id   == id)) {
+            p_free = p_entry;
+            break;
+        }
+        if ((p_entry->Type == TRACE_NAME_TYPE_NONE) &&
+            (p_free        == DEF_NULL)) {
+            p_free = p_entry;
+        }
+    }
+
+    if (p_free != DEF_NULL) {                                   /* See Note #1.                                         */
+        p_free->Id   = id;
+        p_free->Type = type;
+        (void)Str_Copy_N((CPU_CHAR *)p_free->Name, (CPU_CHAR *)p_name, TRACE_CFG_NAME_LEN - 1u);
+        p_free->Name[TRACE_CFG_NAME_LEN - 1u] = ASCII_CHAR_NULL;
+    }
+    CPU_CRITICAL_EXIT();
+}
+
+
+/*
+*********************************************************************************************************
+*                                              Trace_Rd()
+*
+* Description : Drain committed records from the rings.
+*
+* Argument(s) : p_dest      Pointer to destination buffer.
+*
+*               size        Size of destination buffer, in octets.
+*
+* Return(s)   : Number of octets copied (a multiple of sizeof(TRACE_REC)).
+*
+* Caller(s)   : Trace_FileSave(),
+*               Application (e.g. probe or serial link drain).
+*
+* Note(s)     : (1) Rings are drained one after the other; records of different cores are NOT merged
+*                   by timestamp.  The host tool sorts records per core.
+*
+*               (2) See 'trace.c  Note #1' & 'trace.c  Note #2'.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  Trace_Rd (void        *p_dest,
+                      CPU_SIZE_T   size)
+{
+    TRACE_RING  *p_ring;
+    TRACE_REC   *p_rec;
+    TRACE_REC   *p_dest_rec;
+    CPU_SIZE_T   rec_nbr;
+    CPU_SIZE_T   rec_max;
+    uint32_t     head;
+    uint32_t     tail;
+    CPU_INT08U   core;
+
+
+    if (p_dest == DEF_NULL) {
+        return (0u);
+    }
+
+    p_dest_rec = (TRACE_REC *)p_dest;
+    rec_max    =  size / sizeof(TRACE_REC);
+    rec_nbr    =  0u;
+
+    for (core = 0u; core < TRACE_CFG_CORE_NBR; core++) {        /* See Note #1.                                         */
+        p_ring = &Trace_RingTbl[core];
+        head   =  p_ring->HeadIx;
+        tail   =  p_ring->TailIx;
+
+        if ((head - tail) > TRACE_CFG_REC_NBR) {                /* Skip overwritten recs (see Note #2).                 */
+            p_ring->LostCtr += (head - tail) - TRACE_CFG_REC_NBR;
+            tail             =  head - TRACE_CFG_REC_NBR;
+        }
+
+        while ((tail    != head) &&
+               (rec_nbr <  rec_max)) {
+            p_rec = &p_ring->RecTbl[tail & TRACE_IX_MASK];
+            if (p_rec->Id == TRACE_EVT_NONE) {                  /* Stop at first uncommitted rec.                       */
+                break;
+            }
+
+            Mem_Copy((void *)&p_dest_rec[rec_nbr], (void *)p_rec, sizeof(TRACE_REC));
+            p_rec->Id = TRACE_EVT_NONE;
+            rec_nbr++;
+            tail++;
+        }
+
+        p_ring->TailIx = tail;
+    }
+
+    return (rec_nbr * sizeof(TRACE_REC));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Trace_FileSave()
+*
+* Description : Drain the trace to a file.
+*
+* Argument(s) : p_name_full     Name of the file.
+*
+* Return(s)   : DEF_OK,   if the trace was saved.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Trace_CmdSave(),
+*               Application.
+*
+* Note(s)     : (1) The file consists of a 'TRACE_FILE_HDR', followed by the name table & the records.
+*
+*               (2) Recording is NOT stopped while the file is written; file system device I/O issued
+*                   by this function is itself recorded & drained last.
+*********************************************************************************************************
+*/
+
+#if (TRACE_CFG_FS_EN == DEF_ENABLED)
+CPU_BOOLEAN  Trace_FileSave (CPU_CHAR  *p_name_full)
+{
+    FS_FILE         *p_file;
+    FS_ERR           err;
+    FS_ERR           err_close;
+    TRACE_FILE_HDR   hdr;
+    TRACE_REC        rec_tbl[TRACE_RD_CHUNK_REC_NBR];
+    CPU_SIZE_T       size;
+
+
+    p_file = FSFile_Open(p_name_full,
+                        (FS_FILE_ACCESS_MODE_WR | FS_FILE_ACCESS_MODE_CREATE | FS_FILE_ACCESS_MODE_TRUNCATE),
+                        &err);
+    if (err != FS_ERR_NONE) {
+        return (DEF_FAIL);
+    }
+
+    hdr.Magic    = TRACE_FILE_MAGIC;                            /* See Note #1.                                         */
+    hdr.Ver      = TRACE_FILE_VER;
+    hdr.RecSize  = sizeof(TRACE_REC);
+    hdr.TS_Freq  = SystemCoreClock;
+    hdr.NameNbr  = TRACE_CFG_NAME_NBR;
+    hdr.NameSize = sizeof(TRACE_NAME);
+
+    (void)FSFile_Wr(p_file, (void *)&hdr, sizeof(hdr), &err);
+    if (err == FS_ERR_NONE) {
+        (void)FSFile_Wr(p_file, (void *)Trace_NameTbl, sizeof(Trace_NameTbl), &err);
+    }
+
+    while (err == FS_ERR_NONE) {
+        size = Trace_Rd((void *)rec_tbl, sizeof(rec_tbl));
+        if (size == 0u) {
+            break;
+        }
+        (void)FSFile_Wr(p_file, (void *)rec_tbl, size, &err);
+    }
+
+    FSFile_Close(p_file, &err_close);
+
+    return (((err == FS_ERR_NONE) && (err_close == FS_ERR_NONE)) ? DEF_OK : DEF_FAIL);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           Trace_CmdInit()
+*
+* Description : Add event trace commands to uC/Shell.
+*
+* Argument(s) : none.
+*
+* Return(s)   : DEF_OK,   if event trace commands were added.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+* Note(s)     : (1) MUST be called after Shell_Init().
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Trace_CmdInit (void)
+{
+    SHELL_ERR    err;
+    CPU_BOOLEAN  ok;
+
+
+    Shell_CmdTblAdd((CPU_CHAR *)"trace", Trace_CmdTbl, &err);
+
+    ok = (err == SHELL_ERR_NONE) ? DEF_OK : DEF_FAIL;
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Trace_TaskSwitchedIn()
+*
+* Description : Record a context switch.
+*
+* Argument(s) : task_nbr    FreeRTOS task number of the task being switched in.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : traceTASK_SWITCHED_IN().
+*
+* Note(s)     : (1) The current task number is kept even while recording is stopped, so that the
+*                   context of the first events recorded after Trace_Start() is correct.
+*********************************************************************************************************
+*/
+
+void  Trace_TaskSwitchedIn (uint32_t  task_nbr)
+{
+    Trace_CtxCur = (uint8_t)task_nbr;                           /* See Note #1.                                         */
+    TRACE_EVT(TRACE_EVT_TASK_SWITCHED_IN, task_nbr, 0u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Trace_QEvt()
+*
+* Description : Record a queue, semaphore or mutex operation.
+*
+* Argument(s) : id          Event id (TRACE_EVT_Q_xxx).
+*
+*               p_q         Pointer to the queue.
+*
+*               q_type      FreeRTOS queue type ('ucQueueType').
+*
+* Return(s)   : none.
+*
+* Caller(s)   : traceQUEUE_xxx() macros.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  Trace_QEvt (uint8_t   id,
+                  void     *p_q,
+                  uint8_t   q_type)
+{
+    TRACE_EVT(id, q_type, (CPU_ADDR)p_q);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Trace_IxReserve()
+*
+* Description : Reserve a record slot & read its timestamp.
+*
+* Argument(s) : p_ring      Pointer to ring.
+*
+*               p_ts        Pointer to variable that will receive the timestamp.
+*
+* Return(s)   : Free-running index of reserved slot.
+*
+* Caller(s)   : Trace_Evt().
+*
+* Note(s)     : (1) See 'trace.c  Note #1a'.  Cores without exclusive access instructions fall back to
+*                   a critical section.
+*********************************************************************************************************
+*/
+
+static  uint32_t  Trace_IxReserve (TRACE_RING  *p_ring,
+                                   uint32_t    *p_ts)
+{
+    uint32_t  ix;
+#if (__CORTEX_M < 3u)
+    CPU_SR_ALLOC();
+
+
+    CPU_CRITICAL_ENTER();
+    ix             = p_ring->HeadIx;
+   *p_ts           = DWT->CYCCNT;
+    p_ring->HeadIx = ix + 1u;
+    CPU_CRITICAL_EXIT();
+#else
+    do {
+        ix    = __LDREXW(&p_ring->HeadIx);
+       *p_ts  = DWT->CYCCNT;
+    } while (__STREXW(ix + 1u, &p_ring->HeadIx) != 0u);
+#endif
+
+    return (ix);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Trace_CmdCtrl()
+*
+* Description : Start, stop or clear the recorder & output the ring state.
+*
+* Argument(s) : argc            The number of arguments.
+*
+*               argv            Array of arguments.
+*
+*               out_fnct        The output function.
+*
+*               pcmd_param      Pointer to the command parameters.
+*
+* Return(s)   : SHELL_EXEC_ERR, if an error is encountered.
+*               SHELL_ERR_NONE, otherwise.
+*
+* Caller(s)   : Shell, in response to command execution.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16S  Trace_CmdCtrl (CPU_INT16U        argc,
+                                   CPU_CHAR         *argv[],
+                                   SHELL_OUT_FNCT    out_fnct,
+                                   SHELL_CMD_PARAM  *pcmd_param)
+{
+    CPU_CHAR     line[64];
+    TRACE_RING  *p_ring;
+    CPU_INT08U   core;
+
+
+    if (argc == 2u) {
+        if (Str_Cmp(argv[1], TRACE_STR_HELP) == 0) {
+            (void)out_fnct(TRACE_ARG_ERR_CTRL, (CPU_INT16U)Str_Len(TRACE_ARG_ERR_CTRL), pcmd_param->pout_opt);
+            (void)out_fnct(TRACE_NEW_LINE,     2u,                                       pcmd_param->pout_opt);
+            (void)out_fnct(TRACE_CMD_EXP_CTRL, (CPU_INT16U)Str_Len(TRACE_CMD_EXP_CTRL), pcmd_param->pout_opt);
+            (void)out_fnct(TRACE_NEW_LINE,     2u,                                       pcmd_param->pout_opt);
+            return (SHELL_ERR_NONE);
+
+        } else if (Str_Cmp(argv[1], TRACE_STR_ON) == 0) {
+            Trace_Start();
+
+        } else if (Str_Cmp(argv[1], TRACE_STR_OFF) == 0) {
+            Trace_Stop();
+
+        } else if (Str_Cmp(argv[1], TRACE_STR_CLR) == 0) {
+            Trace_Clr();
+
+        } else {
+            argc = 0u;                                          /* Force usage err below.                               */
+        }
+    }
+
+    if ((argc != 1u) && (argc != 2u)) {
+        (void)out_fnct(TRACE_ARG_ERR_CTRL, (CPU_INT16U)Str_Len(TRACE_ARG_ERR_CTRL), pcmd_param->pout_opt);
+        (void)out_fnct(TRACE_NEW_LINE,     2u,                                       pcmd_param->pout_opt);
+        return (SHELL_EXEC_ERR);
+    }
+
+    for (core = 0u; core < TRACE_CFG_CORE_NBR; core++) {
+        p_ring = &Trace_RingTbl[core];
+
+        Str_Copy(line, (Trace_En != 0u) ? (CPU_CHAR *)"on   pending " : (CPU_CHAR *)"off  pending ");
+        (void)Str_FmtNbr_Int32U(DEF_MIN(p_ring->HeadIx - p_ring->TailIx, TRACE_CFG_REC_NBR),
+                                10u, DEF_NBR_BASE_DEC, ASCII_CHAR_SPACE, DEF_NO, DEF_YES, &line[13]);
+        Str_Cat(line, (CPU_CHAR *)"  lost ");
+        (void)Str_FmtNbr_Int32U(p_ring->LostCtr,
+                                10u, DEF_NBR_BASE_DEC, ASCII_CHAR_SPACE, DEF_NO, DEF_YES, &line[Str_Len(line)]);
+
+        (void)out_fnct(line,           (CPU_INT16U)Str_Len(line), pcmd_param->pout_opt);
+        (void)out_fnct(TRACE_NEW_LINE, 2u,                        pcmd_param->pout_opt);
+    }
+
+    return (SHELL_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Trace_CmdSave()
+*
+* Description : Drain the event trace to a file.
+*
+* Argument(s) : argc            The number of arguments.
+*
+*               argv            Array of arguments.
+*
+*               out_fnct        The output function.
+*
+*               pcmd_param      Pointer to the command parameters.
+*
+* Return(s)   : SHELL_EXEC_ERR, if an error is encountered.
+*               SHELL_ERR_NONE, otherwise.
+*
+* Caller(s)   : Shell, in response to command execution.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TRACE_CFG_FS_EN == DEF_ENABLED)
+static  CPU_INT16S  Trace_CmdSave (CPU_INT16U        argc,
+                                   CPU_CHAR         *argv[],
+                                   SHELL_OUT_FNCT    out_fnct,
+                                   SHELL_CMD_PARAM  *pcmd_param)
+{
+    CPU_BOOLEAN  ok;
+
+
+    if (argc == 2u) {
+        if (Str_Cmp(argv[1], TRACE_STR_HELP) == 0) {
+            (void)out_fnct(TRACE_ARG_ERR_SAVE, (CPU_INT16U)Str_Len(TRACE_ARG_ERR_SAVE), pcmd_param->pout_opt);
+            (void)out_fnct(TRACE_NEW_LINE,     2u,                                       pcmd_param->pout_opt);
+            (void)out_fnct(TRACE_CMD_EXP_SAVE, (CPU_INT16U)Str_Len(TRACE_CMD_EXP_SAVE), pcmd_param->pout_opt);
+            (void)out_fnct(TRACE_NEW_LINE,     2u,                                       pcmd_param->pout_opt);
+            return (SHELL_ERR_NONE);
+        }
+    }
+
+    if (argc != 2u) {
+        (void)out_fnct(TRACE_ARG_ERR_SAVE, (CPU_INT16U)Str_Len(TRACE_ARG_ERR_SAVE), pcmd_param->pout_opt);
+        (void)out_fnct(TRACE_NEW_LINE,     2u,                                       pcmd_param->pout_opt);
+        return (SHELL_EXEC_ERR);
+    }
+
+    ok = Trace_FileSave(argv[1]);
+    if (ok != DEF_OK) {
+        (void)out_fnct(TRACE_MSG_FAIL, (CPU_INT16U)Str_Len(TRACE_MSG_FAIL), pcmd_param->pout_opt);
+        (void)out_fnct(TRACE_NEW_LINE, 2u,                                   pcmd_param->pout_opt);
+        return (SHELL_EXEC_ERR);
+    }
+
+    return (SHELL_ERR_NONE);
+}
+#endif
@@ -0,0 +1,220 @@
+/*
+*********************************************************************************************************
+*                                           EVENT TRACE RECORDER
+*
+* Filename : trace.h
+*
+* Note(s)  : (1) Compact binary event recorder used to find latency spikes between UART ISRs, semaphore
+*                gives/takes, GPU command retries & file system device I/O.  Each event is a fixed
+*                12-octet record (see 'TRACE_REC') time-stamped with the Cortex-M DWT cycle counter.
+*
+*            (2) Events are written to a per-core ring (see 'TRACE_RING') without locking : a slot is
+*                reserved with an exclusive load/store on the head index & committed by writing the
+*                event id last.  The ring works in flight-recorder mode : when it is full, the oldest
+*                events are overwritten.
+*
+*            (3) Recorded events are drained either
+*                (a) Directly by uC/Probe, which reads 'Trace_RingTbl[]' from target RAM;
+*                (b) Through Trace_Rd(), for any other link;
+*                (c) To a uC/FS file through Trace_FileSave(), if TRACE_CFG_FS_EN is enabled.
+*
+*                'Tools/trace2json.py' converts a trace file (or raw record dump) to Chrome trace /
+*                Perfetto JSON.
+*
+*            (4) The FreeRTOS trace macros & FS device I/O hooks that feed the recorder are #define'd
+*                in 'FreeRTOSConfig.h' & 'fs_cfg.h'.
+*********************************************************************************************************
+*/
+
+#ifndef  TRACE_H
+#define  TRACE_H
+
+
+/*
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*/
+
+#include  <stdint.h>
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                        CONFIGURATION DEFINES
+*********************************************************************************************************
+*/
+
+#ifndef  TRACE_CFG_REC_NBR
+#define  TRACE_CFG_REC_NBR                                256u  /* Nbr of recs per ring (must be a power of 2).         */
+#endif
+
+#ifndef  TRACE_CFG_CORE_NBR
+#define  TRACE_CFG_CORE_NBR                                 1u  /* Nbr of cores (one ring per core).                    */
+#endif
+
+#ifndef  TRACE_CORE_ID_GET
+#define  TRACE_CORE_ID_GET()                                0u  /* Id of core executing caller.                         */
+#endif
+
+#ifndef  TRACE_CFG_NAME_NBR
+#define  TRACE_CFG_NAME_NBR                                16u  /* Nbr of task/object names kept for decoding.          */
+#endif
+
+#ifndef  TRACE_CFG_NAME_LEN
+#define  TRACE_CFG_NAME_LEN                                16u
+#endif
+
+#ifndef  TRACE_CFG_FS_EN
+#define  TRACE_CFG_FS_EN                         DEF_DISABLED  /* En Trace_FileSave() (requires uC/FS).                */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  TRACE_FILE_MAGIC                         0x45435254u  /* "TRCE", little-endian.                               */
+#define  TRACE_FILE_VER                                     1u
+
+                                                                /* ------------------- EVENT IDS ---------------------- */
+#define  TRACE_EVT_NONE                                     0u  /* Slot reserved but not committed.                     */
+#define  TRACE_EVT_TASK_SWITCHED_IN                         1u  /* Arg16 = task nbr.                                    */
+#define  TRACE_EVT_ISR_ENTER                                2u  /* Arg16 = IRQ nbr.                                     */
+#define  TRACE_EVT_ISR_EXIT                                 3u  /* Arg16 = IRQ nbr.                                     */
+#define  TRACE_EVT_Q_SEND                                   4u  /* Arg16 = Q type, Arg32 = Q addr (sem give).           */
+#define  TRACE_EVT_Q_SEND_ISR                               5u
+#define  TRACE_EVT_Q_SEND_FAIL                              6u
+#define  TRACE_EVT_Q_RECV                                   7u  /* Arg16 = Q type, Arg32 = Q addr (sem take).           */
+#define  TRACE_EVT_Q_RECV_ISR                               8u
+#define  TRACE_EVT_Q_RECV_BLOCK                             9u
+#define  TRACE_EVT_Q_RECV_FAIL                             10u
+#define  TRACE_EVT_GPU_TX                                  11u  /* Arg16 = attempt nbr, Arg32 = len.                    */
+#define  TRACE_EVT_GPU_RETRY                               12u  /* Arg16 = attempt nbr, Arg32 = osStatus_t.             */
+#define  TRACE_EVT_GPU_DONE                                13u  /* Arg16 = attempt nbr, Arg32 = HAL_StatusTypeDef.      */
+#define  TRACE_EVT_FS_DEV_RD_START                         14u  /* Arg16 = sec cnt, Arg32 = start sec.                  */
+#define  TRACE_EVT_FS_DEV_RD_END                           15u  /* Arg16 = sec cnt, Arg32 = FS_ERR.                     */
+#define  TRACE_EVT_FS_DEV_WR_START                         16u
+#define  TRACE_EVT_FS_DEV_WR_END                           17u
+#define  TRACE_EVT_USER                                   128u  /* First app-defined evt id.                            */
+
+                                                                /* ------------------- NAME TYPES --------------------- */
+#define  TRACE_NAME_TYPE_NONE                               0u
+#define  TRACE_NAME_TYPE_TASK                               1u  /* Id = task nbr.                                       */
+#define  TRACE_NAME_TYPE_OBJ                                2u  /* Id = obj addr (Q, sem, mutex).                       */
+
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*
+* Note(s) : (1) 'TRACE_REC' is written to files & read by the host tool as-is; its layout (little-endian,
+*               no padding) MUST NOT change without incrementing TRACE_FILE_VER.
+*********************************************************************************************************
+*/
+
+typedef  struct  trace_rec {                                    /* See Note #1.                                         */
+    uint32_t           TS;                                      /* Cycle ctr timestamp.                                 */
+    volatile  uint8_t  Id;                                      /* Evt id, written last to commit rec.                  */
+    uint8_t            Ctx;                                     /* Nbr of task running when evt was recorded.           */
+    uint16_t           Arg16;
+    uint32_t           Arg32;
+} TRACE_REC;
+
+typedef  struct  trace_ring {
+    volatile  uint32_t  HeadIx;                                 /* Ix of next rec to reserve (free-running).            */
+    volatile  uint32_t  TailIx;                                 /* Ix of next rec to drain   (free-running).            */
+    volatile  uint32_t  LostCtr;                                /* Nbr of recs overwritten before being drained.        */
+    TRACE_REC           RecTbl[TRACE_CFG_REC_NBR];
+} TRACE_RING;
+
+typedef  struct  trace_name {
+    uint32_t  Id;
+    uint8_t   Type;
+    char      Name[TRACE_CFG_NAME_LEN];
+} TRACE_NAME;
+
+typedef  struct  trace_file_hdr {                               /* See Note #1.                                         */
+    uint32_t  Magic;
+    uint16_t  Ver;
+    uint16_t  RecSize;
+    uint32_t  TS_Freq;                                          /* Timestamp freq, in Hz.                               */
+    uint16_t  NameNbr;                                          /* Nbr of TRACE_NAME following hdr.                     */
+    uint16_t  NameSize;                                         /* Size of each TRACE_NAME, in octets.                  */
+} TRACE_FILE_HDR;
+
+
+/*
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+extern  TRACE_RING          Trace_RingTbl[TRACE_CFG_CORE_NBR];  /* Read by uC/Probe (see Note #3a).                     */
+extern  TRACE_NAME          Trace_NameTbl[TRACE_CFG_NAME_NBR];
+extern  volatile  uint8_t   Trace_En;
+extern  volatile  uint8_t   Trace_CtxCur;
+
+
+/*
+*********************************************************************************************************
+*                                                MACROS
+*********************************************************************************************************
+*/
+
+#define  TRACE_EVT(id, arg16, arg32)             do { if (Trace_En != 0u) { Trace_Evt((id), (uint16_t)(arg16), (uint32_t)(arg32)); } } while (0)
+
+#define  TRACE_ISR_ENTER(irq_nbr)                TRACE_EVT(TRACE_EVT_ISR_ENTER, (irq_nbr), 0u)
+#define  TRACE_ISR_EXIT(irq_nbr)                 TRACE_EVT(TRACE_EVT_ISR_EXIT,  (irq_nbr), 0u)
+
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         Trace_Init         (void);
+
+void         Trace_Start        (void);
+
+void         Trace_Stop         (void);
+
+void         Trace_Clr          (void);
+
+void         Trace_Evt          (uint8_t       id,
+                                 uint16_t      arg16,
+                                 uint32_t      arg32);
+
+void         Trace_NameAdd      (uint8_t       type,
+                                 uint32_t      id,
+                                 const  char  *p_name);
+
+CPU_SIZE_T   Trace_Rd           (void         *p_dest,
+                                 CPU_SIZE_T    size);
+
+#if (TRACE_CFG_FS_EN == DEF_ENABLED)
+CPU_BOOLEAN  Trace_FileSave     (CPU_CHAR     *p_name_full);
+#endif
+
+CPU_BOOLEAN  Trace_CmdInit      (void);
+
+                                                                /* ------------- FREERTOS TRACE MACRO HOOKS ----------- */
+void         Trace_TaskSwitchedIn(uint32_t     task_nbr);
+
+void         Trace_QEvt         (uint8_t       id,
+                                 void         *p_q,
+                                 uint8_t       q_type);
+
+
+/*
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*/
+
+#endif
@@ -68,6 +68,9 @@
 #include "shell.h"
 #include "sh_shell.h"
 
+#include "task_stat.h"
+#include "trace.h"
+
 
 
 #define sbiSTREAM_BUFFER_LENGTH_BYTES		    ( ( size_t ) 64 )
@@ -113,6 +116,8 @@ static const char ShShell_Init_err[] = "ShShell_Init is Err.\r\n";
 static const char ShShell_Init_done[] =  "ShShell_Init is Done.\r\n";
 static const char userShell_Init_Done[] = "User shell init is done.\r\n";
 static const char userShell_Init_Err[] = "User shell init is error.\r\n";
+static const char TaskStat_Init_Err[] = "task_stat cmd init is error.\r\n";
+static const char Trace_Init_Err[] = "trace cmd init is error.\r\n";
 
 /* The string to task is looking for, which must be a substring of
 pcStringToSend. */
@@ -176,6 +181,16 @@ void vStartStreamBufferInterruptInit( void )
         TerminalSerial_Wr((void *)ShShell_Init_err, sizeof( ShShell_Init_err ));
     }
     TerminalSerial_Wr((void *)ShShell_Init_done, sizeof( ShShell_Init_done ));
+
+    if (TaskStat_CmdInit() != DEF_OK)
+    {
+        TerminalSerial_Wr((void *)TaskStat_Init_Err, sizeof( TaskStat_Init_Err ));
+    }
+
+    if (Trace_CmdInit() != DEF_OK)
+    {
+        TerminalSerial_Wr((void *)Trace_Init_Err, sizeof( Trace_Init_Err ));
+    }
     
 
 